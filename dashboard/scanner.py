@@ -2,29 +2,18 @@
 import asyncio
 from bleak import BleakScanner
 from model import DeviceState
+import adv_schema
 
-APP_ID = 0x3412
-MANUFACTURER_ID = 0xFFFF
+APP_ID = adv_schema.APP_ID
+MANUFACTURER_ID = adv_schema.COMPANY_ID
 
 devices = {}
 
 def parse_manufacturer_data(md):
+    # payload 格式在 adv_schema.py（firmware/ble_app_work/tools/adv_payload_gen.py 產生）
     if MANUFACTURER_ID not in md:
         return None
-    data = md[MANUFACTURER_ID]
-    if len(data) < 2:
-        return None
-
-    app_id = data[0] | (data[1] << 8)   # little-endian
-    if app_id != APP_ID:
-        return None
-
-    device__id = data[2] | (data[3] << 8)   # little-endian
- 
-    status = data[4]
-    motion = data[5]
-
-    return status  # status
+    return adv_schema.decode(md[MANUFACTURER_ID])
 
 async def scan_loop():
     def detection_callback(device, advertisement_data):
@@ -33,14 +22,14 @@ async def scan_loop():
         if not device.name.startswith("BLE Badge"):
             return
 
-        status = parse_manufacturer_data(advertisement_data.manufacturer_data)
-        if status is None:
+        adv = parse_manufacturer_data(advertisement_data.manufacturer_data)
+        if adv is None:
             return
 
         if device.address not in devices:
             devices[device.address] = DeviceState(device.address, device.name)
 
-        devices[device.address].update(status, advertisement_data.rssi)
+        devices[device.address].update(adv.event, advertisement_data.rssi, adv.flags)
 
     scanner = BleakScanner(detection_callback)
     await scanner.start()
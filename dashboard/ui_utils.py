@@ -1,10 +1,13 @@
 # ui_utils.py
 from rich.text import Text
+import adv_schema
 
 STATUS_MAP = {
-    0x01: ("BOOT", "cyan"),
-    0x02: ("HEARTBEAT", "green"),
-    0x03: ("INTERRUPT", "yellow"),
+    adv_schema.EVENT_BOOT: ("BOOT", "cyan"),
+    adv_schema.EVENT_HEARTBEAT: ("HEARTBEAT", "green"),
+    adv_schema.EVENT_BUTTON: ("INTERRUPT", "yellow"),
+    adv_schema.EVENT_POSTURE: ("POSTURE", "magenta"),
+    adv_schema.EVENT_ALARM: ("ALARM", "bold red"),
 }
 
 def format_status(status):
@@ -1,5 +1,8 @@
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 
 #include "nrf_log.h"
 #include "nrf_log_ctrl.h"
@@ -254,28 +257,93 @@ void bleadv_dump_packet(bleadv_packet_t* pkt)
     bleadv_dump_data(pkt->data, pkt->data_len);
 }
 
-bleadv_manufacturer_data backup;
+adv_payload_t backup;
 
-void bleadv_packet_manufacture(bleadv_manufacturer_data* manu,bleadv_format_data* format )
+// value = company_id + payload（adv_payload.h）。v0（沒有版本 byte 的舊 badge）也換成 v1 的欄位
+void bleadv_packet_manufacture(uint8_t *value, uint8_t value_len, bleadv_format_data* format )
 {
-    format->company_id = manu->company_id;
-    format->app_id = manu->app_id;
-    format->device_id = manu->device_id;
-    format->event = manu->event;
-
-//    SEGGER_RTT_printf(0, "-> ax %d\n", manu->x);   
-//    SEGGER_RTT_printf(0, "-> ay %d\n", manu->y);  
-//    SEGGER_RTT_printf(0, "-> az %d\n", manu->z); 
-//    SEGGER_RTT_printf(0, "-> bat %d\n", manu->bat);                 
-
-    format->ax = manu_imu_to_float( manu->x );
-    format->ay = manu_imu_to_float( manu->y );  
-    format->az = manu_imu_to_float( manu->z );
+    if (value_len < 2)
+        return;
+
+    format->company_id = value[0] | (value[1] << 8);
+
+    uint8_t *payload = &value[2];
+    uint8_t payload_len = value_len - 2;
+    int ver = adv_payload_version(payload, payload_len);
+
+    if (ver == ADV_PAYLOAD_INVALID)
+        return;                         // app_id 維持 0，main 會丟掉
+
+    if (ver == 0)
+    {
+        const adv_payload_v0_t *v0 = (const adv_payload_v0_t *) payload;
+
+        backup.app_id = v0->app_id;
+        backup.device_id = v0->device_id;
+        backup.seq = v0->event;         // v0 的 event 是姿勢變化的計數
+        backup.event = EVENT_POSTURE;
+        backup.flags = (v0->one == 1) ? ADV_FLAG_FALLEN : 0;
+        backup.x = v0->x;
+        backup.y = v0->y;
+        backup.z = v0->z;
+        backup.bat = v0->bat;
+    }
+    else
+    {
+        // 較新的版本只在後面加欄位，前面的 v1 照樣讀
+        memcpy(&backup, payload, sizeof(backup));
+    }
+    backup.ver = (uint8_t) ver;
+
+    format->app_id = backup.app_id;
+    format->ver = backup.ver;
+    format->device_id = backup.device_id;
+    format->seq = backup.seq;
+    format->event = backup.event;
+    format->flags = backup.flags;
+
+//    SEGGER_RTT_printf(0, "-> ax %d\n", backup.x);   
+//    SEGGER_RTT_printf(0, "-> ay %d\n", backup.y);  
+//    SEGGER_RTT_printf(0, "-> az %d\n", backup.z); 
+//    SEGGER_RTT_printf(0, "-> bat %d\n", backup.bat);                 
+
+    format->ax = manu_imu_to_float( backup.x );
+    format->ay = manu_imu_to_float( backup.y );  
+    format->az = manu_imu_to_float( backup.z );
     format->gx = manu_imu_to_float( 0 );
     format->gy = manu_imu_to_float( 0 );
     format->gz = manu_imu_to_float( 0 );
 
-    format->battery = manu_bat_to_float(manu->bat);
+    format->battery = manu_bat_to_float(backup.bat);
+}
+
+// scan callback 用：只看 manufacturer data 的 event，不做 format（名稱 / 位址字串都不做）
+bool bleadv_packet_is_alarm(const bleadv_packet_t* packet)
+{
+    uint16_t i = 0;
+
+    while (i + 1 < packet->data_len)
+    {
+        uint8_t field_len = packet->data[i];
+        if (field_len == 0 || i + 1 + field_len > packet->data_len)
+            break;
+
+        if (packet->data[i + 1] == AD_TYPE_MANUFACTURER_SPECIFIC)
+        {
+            const uint8_t *value = &packet->data[i + 2];
+            uint8_t value_len = field_len - 1;
+
+            if (value_len < 2 || (uint16_t)(value[0] | (value[1] << 8)) != COMPANY_ID)
+                return false;
+
+            // v0 沒有警報；較新的版本 v1 的部分照樣讀
+            int ver = adv_payload_version(&value[2], value_len - 2);
+            return ver >= 1 && value[2 + offsetof(adv_payload_v1_t, event)] == EVENT_ALARM;
+        }
+
+        i += field_len + 1;
+    }
+    return false;
 }
 
 void bleadv_packet_format(bleadv_packet_t* packet,bleadv_format_data* format )
@@ -312,8 +380,7 @@ void bleadv_packet_format(bleadv_packet_t* packet,bleadv_format_data* format )
                 make_c_string(format->device_name, sizeof(format->device_name), value, value_len );        
             break;
         case AD_TYPE_MANUFACTURER_SPECIFIC:
-            memcpy(&backup,value, sizeof(backup) );
-            bleadv_packet_manufacture( (bleadv_manufacturer_data*) value, format);
+            bleadv_packet_manufacture(value, value_len, format);
             break;
 
         case AD_TYPE_FLAGS:
@@ -334,9 +401,11 @@ void bleadv_packet_output(bleadv_format_data* format, char* buffer, int size)
     int ay = (int)(format->ay * 100); 
     int az = (int)(format->az * 100); 
 
-    snprintf(buffer,size,"$$$index=%d&x=%d&y=%d&z=%d&gx=%d&gy=%d&gz=%d&bt_addr=%s&user_id=%04x&upload_time=%s&battery=%d###",
+    // rssi / seq / flags / ver / gw_ms 給 host 的 serial ingest（webdash/serial_ingest.py）用，server 端不認得的 key 會忽略
+    snprintf(buffer,size,"$$$index=%d&x=%d&y=%d&z=%d&gx=%d&gy=%d&gz=%d&bt_addr=%s&user_id=%04x&upload_time=%s&battery=%d&rssi=%d&seq=%u&flags=%u&ver=%u&gw_ms=%lu###",
            format->event,
-        ax,ay,az,0,0,0,format->bt_addr,format->device_id, "2026-01-22T10:30" , voltage);   
+        ax,ay,az,0,0,0,format->bt_addr,format->device_id, "2026-01-22T10:30" , voltage, format->rssi,
+        format->seq, format->flags, format->ver, (unsigned long)format->gw_ms);   
 }
 
 void bleadv_packet_print(bleadv_packet_t* packet)
@@ -25,6 +25,10 @@ typedef struct __attribute__((packed))
     uint16_t app_id; 
     uint16_t device_id;
     uint16_t event;
+    uint8_t ver;                // adv_payload.h 的版本（0: 舊 badge）
+    uint8_t seq;                // 同一個 seq 是重複的廣播
+    uint8_t flags;              // ADV_FLAG_*
+    uint32_t gw_ms;             // 送出時 gateway 的時間（開機後 ms，host 估計各段延遲用）
     float   ax;
     float   ay;
     float   az;
@@ -44,6 +48,9 @@ void bleadv_packet_print(bleadv_packet_t* packet);
 //void bleadv_packet_format(bleadv_packet_t* packet,bleadv_format_data* format );
 void bleadv_packet_format(bleadv_packet_t* packet,bleadv_format_data* format );
 
+/* scan callback 用：EVENT_ALARM 的 badge 廣播（bleadv_queue_push_alarm 的判斷） */
+bool bleadv_packet_is_alarm(const bleadv_packet_t* packet);
+
 void bleadv_packet_output(bleadv_format_data* format, char* buffer, int size);
 
 
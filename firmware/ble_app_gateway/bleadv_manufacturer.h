@@ -4,18 +4,22 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "adv_payload.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#define COMPANY_ID          0xFFFF
-#define APP_ID              0x3412
+#define COMPANY_ID          ADV_COMPANY_ID
+#define APP_ID              ADV_APP_ID
 #define DEVICE_ID           0x0180
 
-#define EVENT_ERROR        0x00
-#define EVENT_BOOT         0x01
-#define EVENT_HEARTBEAT    0x02
-#define EVENT_BUTTON       0x03
+#define EVENT_ERROR        ADV_EVENT_ERROR
+#define EVENT_BOOT         ADV_EVENT_BOOT
+#define EVENT_HEARTBEAT    ADV_EVENT_HEARTBEAT
+#define EVENT_BUTTON       ADV_EVENT_BUTTON
+#define EVENT_POSTURE      ADV_EVENT_POSTURE
+#define EVENT_ALARM        ADV_EVENT_ALARM
 
 #define BAT_FLOAT_MAX       (4.2)
 #define BAT_FLOAT_MIN       (0.0)
@@ -27,24 +31,7 @@ extern "C" {
 #define IMU_INT8_MAX       (127)
 #define IMU_INT8_MIN       (-128)
 
-typedef struct __attribute__((packed))
-{
-    uint16_t  company_id;       // 
-    uint16_t  app_id;       // 
-    uint16_t  device_id;    // 
-    uint8_t  event;       // 
-
-    int8_t  x;
-    int8_t  y;
-    int8_t  z;
-    uint8_t  bat;
-
-    uint8_t  one;
-    uint8_t  two;
-    uint8_t  three; 
-    uint8_t  four;         
-
-} bleadv_manufacturer_data;
+// payload 的格式在 adv_payload.h（ble_app_work/tools/adv_payload_gen.py 產生）
 
 float manu_bat_to_float(uint8_t bat);
 uint8_t manu_bat_to_uint8(float bat);
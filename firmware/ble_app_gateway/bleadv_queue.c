@@ -1,54 +1,79 @@
 #include "bleadv_queue.h"
 #include <string.h>
 
-static bleadv_packet_t m_queue[ADV_QUEUE_SIZE];
-static volatile uint8_t m_head = 0;
-static volatile uint8_t m_tail = 0;
-static volatile uint8_t m_count = 0;
-
-void bleadv_queue_init(void)
+typedef struct
 {
-    m_head = 0;
-    m_tail = 0;
-    m_count = 0;
-}
+    bleadv_packet_t * p_buf;
+    uint8_t           size;
+    volatile uint8_t  head;
+    volatile uint8_t  tail;
+    volatile uint8_t  count;
+} adv_ring_t;
 
-bool bleadv_queue_is_full(void)
-{
-    return (m_count >= ADV_QUEUE_SIZE);
-}
+static bleadv_packet_t m_queue[ADV_QUEUE_SIZE];
+static bleadv_packet_t m_alarm_queue[ADV_ALARM_QUEUE_SIZE];
 
-bool bleadv_queue_is_empty(void)
-{
-    return (m_count == 0);
-}
+static adv_ring_t m_ring       = { m_queue, ADV_QUEUE_SIZE, 0, 0, 0 };
+static adv_ring_t m_alarm_ring = { m_alarm_queue, ADV_ALARM_QUEUE_SIZE, 0, 0, 0 };
 
-bool bleadv_queue_push(const bleadv_packet_t * pkt)
+static bool ring_push(adv_ring_t * r, const bleadv_packet_t * pkt)
 {
-    if (bleadv_queue_is_full())
+    if (r->count >= r->size)
     {
-        return false;  
+        return false;
     }
 
-    memcpy(&m_queue[m_head], pkt, sizeof(bleadv_packet_t));
+    memcpy(&r->p_buf[r->head], pkt, sizeof(bleadv_packet_t));
 
-    m_head = (m_head + 1) % ADV_QUEUE_SIZE;
-    m_count++;
+    r->head = (r->head + 1) % r->size;
+    r->count++;
 
     return true;
 }
 
-bool bleadv_queue_pop(bleadv_packet_t * pkt)
+static bool ring_pop(adv_ring_t * r, bleadv_packet_t * pkt)
 {
-    if (bleadv_queue_is_empty())
+    if (r->count == 0)
     {
         return false;
     }
 
-    memcpy(pkt, &m_queue[m_tail], sizeof(bleadv_packet_t));
+    memcpy(pkt, &r->p_buf[r->tail], sizeof(bleadv_packet_t));
 
-    m_tail = (m_tail + 1) % ADV_QUEUE_SIZE;
-    m_count--;
+    r->tail = (r->tail + 1) % r->size;
+    r->count--;
 
     return true;
-}
\ No newline at end of file
+}
+
+void bleadv_queue_init(void)
+{
+    m_ring.head = m_ring.tail = m_ring.count = 0;
+    m_alarm_ring.head = m_alarm_ring.tail = m_alarm_ring.count = 0;
+}
+
+bool bleadv_queue_is_full(void)
+{
+    return (m_ring.count >= ADV_QUEUE_SIZE);
+}
+
+bool bleadv_queue_is_empty(void)
+{
+    return (m_ring.count == 0 && m_alarm_ring.count == 0);
+}
+
+bool bleadv_queue_push(const bleadv_packet_t * pkt)
+{
+    return ring_push(&m_ring, pkt);
+}
+
+bool bleadv_queue_push_alarm(const bleadv_packet_t * pkt)
+{
+    // 警報專用的位置滿了才和一般的排在一起
+    return ring_push(&m_alarm_ring, pkt) || ring_push(&m_ring, pkt);
+}
+
+bool bleadv_queue_pop(bleadv_packet_t * pkt)
+{
+    return ring_pop(&m_alarm_ring, pkt) || ring_pop(&m_ring, pkt);
+}
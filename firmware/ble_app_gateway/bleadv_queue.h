@@ -6,13 +6,15 @@
 #include "bleadv_packet.h"
 
 #define ADV_QUEUE_SIZE 16   // 可依需求調整（2 的次方最好）
+#define ADV_ALARM_QUEUE_SIZE 4   // 警報（EVENT_ALARM）專用，一般的滿了也收得進來
 
 void bleadv_queue_init(void);
 
 /* ISR / scan callback 使用 */
 bool bleadv_queue_push(const bleadv_packet_t * pkt);
+bool bleadv_queue_push_alarm(const bleadv_packet_t * pkt);
 
-/* main loop 使用 */
+/* main loop 使用：警報先出 */
 bool bleadv_queue_pop(bleadv_packet_t * pkt);
 
 bool bleadv_queue_is_empty(void);
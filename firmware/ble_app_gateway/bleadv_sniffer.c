@@ -38,6 +38,7 @@
 #include "bleadv_queue.h"
 
 #include "led_status.h"
+#include "lib_token_log.h"
 
 /* ================= Configuration ================= */
 #define APP_BLE_CONN_CFG_TAG    1
@@ -59,7 +60,8 @@ void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
 {
     (void)p_context;
 
-    SEGGER_RTT_printf(0, "%s\n", __FUNCTION__);  
+    /* Runs for every ADV report: log tokens only, never format here. */
+    TOKEN_LOG1(TL_GW_BLE_EVT, p_ble_evt->header.evt_id);
     ret_code_t err;
 
     switch (p_ble_evt->header.evt_id)
@@ -67,9 +69,9 @@ void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
         case BLE_GAP_EVT_ADV_REPORT:
         {
             led_blink_adv();
-            SEGGER_RTT_printf(0, "BLE_GAP_EVT_ADV_REPORT\n");          
             const ble_gap_evt_adv_report_t * r =
             &p_ble_evt->evt.gap_evt.params.adv_report;
+            TOKEN_LOG2(TL_GW_ADV_REPORT, r->rssi, r->data.len);
 
             bleadv_packet_t pkt;
 
@@ -82,7 +84,11 @@ void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
                 pkt.data_len = ADV_DATA_MAX_LEN;
 
             memcpy(pkt.data, r->data.p_data, pkt.data_len);
-            bleadv_queue_push(&pkt);
+            // 警報走專用的 queue，main loop 先處理
+            if (bleadv_packet_is_alarm(&pkt))
+                bleadv_queue_push_alarm(&pkt);
+            else
+                bleadv_queue_push(&pkt);
 
 //                bleadv_data_formater(r->data.p_data,r->data.len);
             /* IMPORTANT:
@@ -93,7 +99,7 @@ void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
 
             err = sd_ble_gap_scan_start(NULL, &m_scan_buffer);
             if (err != NRF_SUCCESS && err != NRF_ERROR_INVALID_STATE)
-                SEGGER_RTT_printf(0, "scan restart err=0x%x\n", err);
+                TOKEN_LOG1(TL_GW_SCAN_RESTART_ERR, err);
         }
         break;
 
@@ -0,0 +1,35 @@
+/**
+  ******************************************************************************************
+  * @file    SEGGER_RTT.h
+  * @author  k.tashiro
+  * @version 1.1
+  * @date    2026/10/19
+  * @brief   Gateway Host Build用 SEGGER_RTT.h (計測対象外の表示関数だけが使う)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         ble_app_work/bench/host_incから移動
+  ******************************************************************************************
+*/
+
+#ifndef SEGGER_RTT_H_
+#define SEGGER_RTT_H_
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief 何も出力しない (引数は評価する)
+ * @param channel RTT Channel
+ * @param format Specify format
+ * @retval 出力したByte数 (常に0)
+ */
+static inline int SEGGER_RTT_printf( unsigned channel, const char *format, ... )
+{
+	(void)channel;
+	(void)format;
+
+	return 0;
+}
+
+#endif
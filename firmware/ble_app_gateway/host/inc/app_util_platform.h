@@ -0,0 +1,19 @@
+#pragma once
+#include <stdint.h>
+
+/*
+ * uarte_pusher.c 的測試（src/uarte_pusher_test.c）用的 app_util_platform.h：
+ * 與 SDK 相同的巨集，enter / exit 由測試實作（UARTE 的 IRQ 在 enter 之前插進來）。
+ */
+
+#define CRITICAL_REGION_ENTER()                                 \
+    {                                                           \
+        uint8_t __CR_NESTED = 0;                                \
+        app_util_critical_region_enter(&__CR_NESTED);
+
+#define CRITICAL_REGION_EXIT()                                  \
+        app_util_critical_region_exit(__CR_NESTED);             \
+    }
+
+void app_util_critical_region_enter(uint8_t * p_nested);
+void app_util_critical_region_exit(uint8_t nested);
@@ -0,0 +1,38 @@
+/**
+  ******************************************************************************************
+  * @file    nrf_log.h
+  * @author  k.tashiro
+  * @version 1.1
+  * @date    2026/10/19
+  * @brief   Gateway Host Build用 nrf_log.h (ble_app_gateway/bleadv_formater.cの出力を空にする)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         ble_app_work/bench/host_incから移動
+  ******************************************************************************************
+*/
+
+#ifndef NRF_LOG_H_
+#define NRF_LOG_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Definition ------------------------------------------------------------*/
+#define NRF_LOG_INFO( ... )						nrf_log_none( __VA_ARGS__ )
+#define NRF_LOG_ERROR( ... )					nrf_log_none( __VA_ARGS__ )
+#define NRF_LOG_HEXDUMP_INFO( p_data, len )		do { (void)(p_data); (void)(len); } while(0)
+
+/**
+ * @brief 何も出力しない (引数は評価する)
+ * @param format Specify format
+ * @retval None
+ */
+static inline void nrf_log_none( const char *format, ... )
+{
+	(void)format;
+}
+
+#endif
@@ -0,0 +1,22 @@
+/**
+  ******************************************************************************************
+  * @file    nrf_log_ctrl.h
+  * @author  k.tashiro
+  * @version 1.1
+  * @date    2026/10/19
+  * @brief   Gateway Host Build用 nrf_log_ctrl.h
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         ble_app_work/bench/host_incから移動
+  ******************************************************************************************
+*/
+
+#ifndef NRF_LOG_CTRL_H_
+#define NRF_LOG_CTRL_H_
+
+#include "nrf_log.h"
+
+#endif
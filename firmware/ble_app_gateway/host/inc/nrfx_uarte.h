@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * uarte_pusher.c 的測試（src/uarte_pusher_test.c）用的 nrfx_uarte.h：
+ * nrfx_uarte_tx 只記下 DMA 的位置與長度，TX_DONE 由測試決定什麼時候發生。
+ */
+
+#define NRF_UARTE_HWFC_DISABLED     0
+#define NRF_UARTE_BAUDRATE_115200   115200
+#define NRF_UARTE_BAUDRATE_921600   921600
+
+#define NRFX_UARTE_INSTANCE(id)     { .drv_inst_idx = (id) }
+
+#define NRFX_UARTE_DEFAULT_CONFIG   { 0 }
+
+typedef struct
+{
+    uint8_t drv_inst_idx;
+} nrfx_uarte_t;
+
+typedef struct
+{
+    uint32_t pseltxd;
+    uint32_t pselrxd;
+    uint32_t hwfc;
+    uint32_t baudrate;
+    uint8_t  interrupt_priority;
+} nrfx_uarte_config_t;
+
+#define NRFX_SUCCESS    0
+
+typedef enum
+{
+    NRFX_UARTE_EVT_TX_DONE,
+    NRFX_UARTE_EVT_RX_DONE,
+    NRFX_UARTE_EVT_ERROR,
+} nrfx_uarte_evt_type_t;
+
+typedef struct
+{
+    nrfx_uarte_evt_type_t type;
+} nrfx_uarte_event_t;
+
+typedef void (* nrfx_uarte_event_handler_t)(nrfx_uarte_event_t const * p_event, void * p_context);
+
+uint32_t nrfx_uarte_init(nrfx_uarte_t const * p_instance, nrfx_uarte_config_t const * p_config,
+                         nrfx_uarte_event_handler_t event_handler);
+uint32_t nrfx_uarte_tx(nrfx_uarte_t const * p_instance, uint8_t const * p_data, size_t length);
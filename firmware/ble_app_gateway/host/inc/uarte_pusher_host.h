@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * uarte_pusher.h 的 host 版（src/uarte_pusher_host.c）：同樣 512 bytes 的 ring 與警報的位置，
+ * 依 gateway 時間以 baud 的速度送出（警報先送）；push 成功的資料直接寫進 out。
+ */
+
+/* baud = 0: 不限速（ring 不會滿） */
+void uarte_pusher_host_config(FILE * out, uint32_t baud);
+
+/* gateway 時間前進到 now_us（ring 依 baud 送出） */
+void uarte_pusher_host_advance(uint64_t now_us);
+
+/* 因 ring 滿而丟掉的次數 / bytes */
+uint32_t uarte_pusher_host_dropped(void);
+uint32_t uarte_pusher_host_dropped_bytes(void);
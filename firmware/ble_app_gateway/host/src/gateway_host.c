@@ -0,0 +1,243 @@
+/**
+ * Gateway main loop (main.c) on the host, fed with raw bleadv_packet_t reports
+ * instead of the SoftDevice sniffer.
+ *
+ * Input (stdin or a file) is a stream of fixed 44-byte records, as written by
+ * webdash/fleet_sim.py --mode raw:
+ *
+ *     uint32_t t_ms (little endian, gateway clock) + bleadv_packet_t (40 bytes)
+ *
+ * Every report goes through bleadv_queue, bleadv_packet_format, the company /
+ * app / name filter, seq_tracker_accept and bleadv_packet_output as in main.c.
+ * Alarm reports (bleadv_packet_is_alarm) take the alarm lane of the queue and
+ * the alarm slot of the UART as in bleadv_sniffer.c and main.c.
+ * The lines are pushed into a model of uarte_pusher (src/uarte_pusher_host.c:
+ * the same ring, 512 bytes plus the alarm reserve, drained at -b baud in
+ * gateway time) and written to stdout when accepted, so the stream can be
+ * piped into serial_ingest.py.
+ *
+ *     make -C host
+ *     ./host/_build/gateway_host reports.bin > uart.bin
+ *     ./host/_build/gateway_host -b 0 -l 40 < reports.bin > /dev/null
+ *
+ * -l models the main loop time per report in gateway time; reports that arrive
+ * while ADV_QUEUE_SIZE of them are waiting are lost as on the target.
+ * The SUMMARY line on stderr counts every stage.
+ */
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bleadv_packet.h"
+#include "bleadv_queue.h"
+#include "bleadv_formater.h"
+#include "bleadv_manufacturer.h"
+#include "seq_tracker.h"
+#include "uarte_pusher.h"
+#include "uarte_pusher_host.h"
+
+#define RECORD_SIZE             (4 + sizeof(bleadv_packet_t))                   /**< t_ms + bleadv_packet_t. */
+#define RECORD_CHUNK            256                                             /**< Max records per read() (stdout is flushed after each). */
+#define UART_BAUD_DEFAULT       115200                                          /**< NRF_UARTE_BAUDRATE_115200 in uarte_pusher.c. */
+#define OUTPUT_SIZE             192                                             /**< Same as the buffer in main.c. */
+
+typedef struct
+{
+    uint32_t in;                // reports read
+    uint32_t queue_full;        // bleadv_queue_push() failed
+    uint32_t foreign;           // company_id / app_id of another product
+    uint32_t no_name;           // no local name
+    uint32_t duplicate;         // seq_tracker_accept() == false
+    uint32_t out;               // lines pushed into the UART
+    uint64_t out_bytes;
+    uint32_t alarm_in;          // reports that took the alarm lane
+    uint32_t alarm_out;         // alarm lines pushed into the UART
+    uint32_t alarm_drop;        // alarm lines lost to a full UART (the next copy is retried)
+} gateway_stats_t;
+
+static gateway_stats_t m_stats;
+static uint64_t m_loop_us;                                                     // -l
+static uint64_t m_busy_until_us;                                               // main loop busy with the previous report
+
+static void usage(const char * p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-b baud] [-l us] [reports.bin]\n"
+            "  reports.bin  44-byte records: uint32 t_ms (LE) + bleadv_packet_t (default stdin)\n"
+            "  -b baud      UART speed, 0 = unlimited (default %u)\n"
+            "  -l us        main loop time per report in gateway time (default 0)\n",
+            p_name, UART_BAUD_DEFAULT);
+}
+
+/* One iteration of the main.c loop for a popped report. */
+static void gateway_process(bleadv_packet_t * p_pkt, uint32_t now_ms)
+{
+    bleadv_format_data format;
+    char buffer[OUTPUT_SIZE];
+
+    memset(&format, 0, sizeof(bleadv_format_data));
+    bleadv_packet_format(p_pkt, &format);
+
+    if (format.company_id != COMPANY_ID || format.app_id != APP_ID)
+    {
+        m_stats.foreign++;
+        return;
+    }
+    if (strlen(format.device_name) == 0)
+    {
+        m_stats.no_name++;
+        return;
+    }
+    format.gw_ms = now_ms;
+    if (!seq_tracker_accept(format.device_id, format.seq, now_ms))
+    {
+        m_stats.duplicate++;
+        return;
+    }
+
+    bleadv_packet_output(&format, buffer, sizeof(buffer));
+    if (format.event == EVENT_ALARM)
+    {
+        if (!uarte_pusher_push_alarm((uint8_t *)buffer, strlen(buffer)))
+        {
+            seq_tracker_forget(format.device_id);
+            m_stats.alarm_drop++;
+            return;
+        }
+        m_stats.alarm_out++;
+    }
+    else if (!uarte_pusher_push((uint8_t *)buffer, strlen(buffer)))
+    {
+        return;
+    }
+    m_stats.out++;
+    m_stats.out_bytes += strlen(buffer);
+}
+
+/* Run the main loop until now_us: pop while it is not busy. */
+static void gateway_run_until(uint64_t now_us)
+{
+    bleadv_packet_t pkt;
+
+    while (m_busy_until_us <= now_us && bleadv_queue_pop(&pkt))
+    {
+        uarte_pusher_host_advance(m_busy_until_us);
+        gateway_process(&pkt, (uint32_t)(m_busy_until_us / 1000));
+        m_busy_until_us += m_loop_us;
+    }
+    if (m_busy_until_us < now_us)
+    {
+        m_busy_until_us = now_us;
+    }
+    uarte_pusher_host_advance(now_us);
+}
+
+int main(int argc, char ** argv)
+{
+    static uint8_t chunk[RECORD_CHUNK * RECORD_SIZE];
+    uint32_t baud = UART_BAUD_DEFAULT;
+    int fd = STDIN_FILENO;
+    size_t have = 0;
+    ssize_t got;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:l:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'b':
+            baud = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            m_loop_us = strtoull(optarg, NULL, 0);
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (optind < argc)
+    {
+        fd = open(argv[optind], O_RDONLY);
+        if (fd < 0)
+        {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+
+    bleadv_queue_init();
+    seq_tracker_reset();
+    uarte_pusher_init();
+    uarte_pusher_host_config(stdout, baud);
+
+    clock_t cpu = clock();
+    uint64_t now_us = 0;
+
+    // read() returns what the pipe has, so a live generator sees its lines
+    // come back without waiting for a full chunk.
+    while ((got = read(fd, chunk + have, sizeof(chunk) - have)) > 0)
+    {
+        uint8_t * p_rec = chunk;
+
+        have += (size_t)got;
+        for (; have >= RECORD_SIZE; have -= RECORD_SIZE, p_rec += RECORD_SIZE)
+        {
+            bleadv_packet_t pkt;
+            uint32_t t_ms = (uint32_t)p_rec[0] | ((uint32_t)p_rec[1] << 8) | ((uint32_t)p_rec[2] << 16) | ((uint32_t)p_rec[3] << 24);
+
+            memcpy(&pkt, p_rec + 4, sizeof(pkt));
+            if (pkt.data_len > ADV_DATA_MAX_LEN)
+            {
+                pkt.data_len = ADV_DATA_MAX_LEN;
+            }
+            now_us = (uint64_t)t_ms * 1000;
+            m_stats.in++;
+
+            gateway_run_until(now_us);
+            // the sniffer callback side
+            bool pushed;
+            if (bleadv_packet_is_alarm(&pkt))
+            {
+                m_stats.alarm_in++;
+                pushed = bleadv_queue_push_alarm(&pkt);
+            }
+            else
+            {
+                pushed = bleadv_queue_push(&pkt);
+            }
+            if (!pushed)
+            {
+                m_stats.queue_full++;
+            }
+            gateway_run_until(now_us);
+        }
+        memmove(chunk, p_rec, have);
+        fflush(stdout);
+    }
+    // end of input: let the main loop drain the queue
+    while (!bleadv_queue_is_empty())
+    {
+        gateway_run_until(m_busy_until_us);
+    }
+    fflush(stdout);
+
+    double cpu_s = (double)(clock() - cpu) / CLOCKS_PER_SEC;
+    fprintf(stderr, "SUMMARY time_ms=%llu in=%u queue_full=%u foreign=%u no_name=%u duplicate=%u "
+            "uart_drop=%u out=%u out_bytes=%llu alarm_in=%u alarm_out=%u alarm_drop=%u\n",
+            (unsigned long long)(now_us / 1000), m_stats.in, m_stats.queue_full, m_stats.foreign, m_stats.no_name,
+            m_stats.duplicate, uarte_pusher_host_dropped(), m_stats.out, (unsigned long long)m_stats.out_bytes,
+            m_stats.alarm_in, m_stats.alarm_out, m_stats.alarm_drop);
+    fprintf(stderr, "host cpu %.3f s, %.0f ns per report\n", cpu_s, m_stats.in ? cpu_s * 1e9 / m_stats.in : 0.0);
+
+    if (fd != STDIN_FILENO)
+    {
+        close(fd);
+    }
+    return 0;
+}
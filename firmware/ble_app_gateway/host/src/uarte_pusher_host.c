@@ -0,0 +1,113 @@
+#include "uarte_pusher.h"
+#include "uarte_pusher_host.h"
+
+#define UARTE_PUSHER_BUF_SIZE (512 + UARTE_PUSHER_ALARM_MAX)   // uarte_pusher.c 相同
+
+static FILE *   m_out;
+static uint32_t m_baud;
+static size_t   m_used;             // ring 內還沒送完的 bytes
+static size_t   m_alarm_used;       // 警報位置還沒送完的 bytes（比 ring 先送）
+static uint64_t m_last_us;
+static uint64_t m_credit;           // 不足 1 byte 的送出時間 [us * baud]
+static uint32_t m_dropped;
+static uint32_t m_dropped_bytes;
+
+void uarte_pusher_host_config(FILE * out, uint32_t baud)
+{
+    m_out  = out;
+    m_baud = baud;
+}
+
+void uarte_pusher_host_advance(uint64_t now_us)
+{
+    if (now_us <= m_last_us)
+        return;
+
+    // 1 byte = 10 bit（start + 8 + stop）
+    m_credit += (now_us - m_last_us) * m_baud;
+    m_last_us = now_us;
+
+    uint64_t sent = m_credit / (10ULL * 1000000ULL);
+    m_credit -= sent * 10ULL * 1000000ULL;
+    if (sent >= m_alarm_used)
+    {
+        sent -= m_alarm_used;
+        m_alarm_used = 0;
+    }
+    else
+    {
+        m_alarm_used -= (size_t)sent;
+        sent = 0;
+    }
+    if (sent >= m_used)
+    {
+        m_used = 0;
+        if (m_alarm_used == 0)
+            m_credit = 0;           // 閒置中的時間不能存起來
+    }
+    else
+    {
+        m_used -= (size_t)sent;
+    }
+}
+
+uint32_t uarte_pusher_host_dropped(void)
+{
+    return m_dropped;
+}
+
+uint32_t uarte_pusher_host_dropped_bytes(void)
+{
+    return m_dropped_bytes;
+}
+
+void uarte_pusher_init(void)
+{
+    m_used = 0;
+    m_alarm_used = 0;
+    m_credit = 0;
+    m_last_us = 0;
+}
+
+static bool ring_push(const uint8_t * data, size_t len, size_t reserve)
+{
+    if (m_baud != 0 && len + reserve > uarte_pusher_bytes_free())
+    {
+        m_dropped++;
+        m_dropped_bytes += len;
+        return false;   // overflow → 丟
+    }
+
+    if (m_baud != 0)
+        m_used += len;
+    if (m_out != NULL)
+        fwrite(data, 1, len, m_out);
+    return true;
+}
+
+bool uarte_pusher_push(const uint8_t * data, size_t len)
+{
+    return ring_push(data, len, UARTE_PUSHER_ALARM_MAX);
+}
+
+// 行的邊界才插隊這一點不模擬：警報位置的 bytes 一律比 ring 先送
+bool uarte_pusher_push_alarm(const uint8_t * data, size_t len)
+{
+    if (m_baud == 0 || m_alarm_used != 0 || len > UARTE_PUSHER_ALARM_MAX)
+        return ring_push(data, len, 0);
+
+    m_alarm_used = len;
+    if (m_out != NULL)
+        fwrite(data, 1, len, m_out);
+    return true;
+}
+
+bool uarte_pusher_is_busy(void)
+{
+    return m_used != 0 || m_alarm_used != 0;
+}
+
+size_t uarte_pusher_bytes_free(void)
+{
+    return (UARTE_PUSHER_BUF_SIZE - 1) - m_used;
+}
@@ -0,0 +1,257 @@
+/**
+ * uarte_pusher.c (the real ring, not the src/uarte_pusher_host.c model) with a
+ * fake UARTE whose TX_DONE interrupt the test fires by hand.
+ *
+ * The main loop pushes numbered lines and alarms; the TX_DONE interrupt is
+ * fired at random points, including the window inside ring_push() after the
+ * line is copied and before interrupts are masked (the start of
+ * CRITICAL_REGION_ENTER). Every byte the fake DMA sends is collected and the
+ * stream must be whole lines only: no alarm inside a line, no line sent
+ * before it was completely pushed, every accepted line exactly once and the
+ * normal lines in push order. The UART also stalls now and then (no TX_DONE
+ * for several pushes) so the ring fills up behind a long DMA, and the bytes
+ * of a DMA must not change between nrfx_uarte_tx and its TX_DONE.
+ *
+ *     make -C host test
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nrfx_uarte.h"
+#include "app_util_platform.h"
+#include "uarte_pusher.h"
+
+#define TEST_ROUNDS         200
+#define TEST_PUSHES         400
+#define TEST_LINE_MAX       120
+#define TEST_STREAM_MAX     (TEST_PUSHES * (TEST_LINE_MAX + 1))
+
+static nrfx_uarte_event_handler_t m_handler;
+static const uint8_t *            m_dma_data;   // 送出中的 DMA（NULL: 閒置）
+static size_t                     m_dma_len;
+static uint8_t                    m_dma_copy[UARTE_PUSHER_ALARM_MAX + 1024];  // nrfx_uarte_tx 時的內容
+static uint32_t                   m_dma_max;
+static bool                       m_masked;     // CRITICAL_REGION 中（IRQ 不會發生）
+static bool                       m_irq_in_window;
+static uint32_t                   m_irq_window_fired;
+
+static char     m_stream[TEST_STREAM_MAX];
+static size_t   m_stream_len;
+
+static uint32_t m_rand = 1;
+
+static uint32_t test_rand(void)
+{
+    m_rand = m_rand * 1103515245u + 12345u;
+    return (m_rand >> 16) & 0x7FFF;
+}
+
+uint32_t nrfx_uarte_init(nrfx_uarte_t const * p_instance, nrfx_uarte_config_t const * p_config,
+                         nrfx_uarte_event_handler_t event_handler)
+{
+    m_handler = event_handler;
+    return NRFX_SUCCESS;
+}
+
+uint32_t nrfx_uarte_tx(nrfx_uarte_t const * p_instance, uint8_t const * p_data, size_t length)
+{
+    if (m_dma_data != NULL || length == 0)
+    {
+        fprintf(stderr, "FAIL nrfx_uarte_tx while busy (len %zu)\n", length);
+        exit(1);
+    }
+    if (length > sizeof(m_dma_copy))
+    {
+        fprintf(stderr, "FAIL nrfx_uarte_tx len %zu\n", length);
+        exit(1);
+    }
+    m_dma_data = p_data;
+    m_dma_len  = length;
+    memcpy(m_dma_copy, p_data, length);
+    if (length > m_dma_max)
+        m_dma_max = (uint32_t)length;
+    return NRFX_SUCCESS;
+}
+
+/**@brief TX_DONE: EasyDMA 讀完 buffer 才算送出，所以在完成時才收集（送出中被覆寫就會錯）
+ */
+static void test_tx_done(void)
+{
+    if (m_dma_data == NULL || m_masked)
+        return;
+
+    if (m_stream_len + m_dma_len > sizeof(m_stream))
+    {
+        fprintf(stderr, "FAIL stream overflow\n");
+        exit(1);
+    }
+    if (memcmp(m_dma_data, m_dma_copy, m_dma_len) != 0)
+    {
+        fprintf(stderr, "FAIL DMA buffer (%zu bytes) overwritten before TX_DONE\n", m_dma_len);
+        exit(1);
+    }
+    memcpy(&m_stream[m_stream_len], m_dma_data, m_dma_len);
+    m_stream_len += m_dma_len;
+    m_dma_data = NULL;
+
+    nrfx_uarte_event_t evt = { .type = NRFX_UARTE_EVT_TX_DONE };
+    m_handler(&evt, NULL);
+}
+
+void app_util_critical_region_enter(uint8_t * p_nested)
+{
+    // ring_push 已經複製好、還沒更新 m_head 的時間點：IRQ 在這裡插進來
+    if (m_irq_in_window && m_dma_data != NULL)
+    {
+        m_irq_window_fired++;
+        test_tx_done();
+    }
+    *p_nested = 0;
+    m_masked = true;
+}
+
+void app_util_critical_region_exit(uint8_t nested)
+{
+    m_masked = false;
+}
+
+/**@brief "L<seq>:" / "A<seq>:" + seq 決定的長度與內容 + "\n"
+ */
+static size_t test_line(char * p_buf, char kind, uint32_t seq)
+{
+    int    n   = sprintf(p_buf, "%c%u:", kind, seq);
+    size_t len = (size_t)n + (seq * 7u) % (TEST_LINE_MAX - 16);
+
+    for (size_t i = (size_t)n; i < len; i++)
+    {
+        p_buf[i] = (char)('a' + (seq + i) % 26);
+    }
+    p_buf[len++] = '\n';
+    return len;
+}
+
+static bool test_check(uint32_t round, const bool * p_accepted, const char * p_kind)
+{
+    char     expect[TEST_LINE_MAX + 1];
+    bool     seen[TEST_PUSHES] = { false };
+    uint32_t last_line = 0;
+    bool     have_line = false;
+    size_t   pos = 0;
+
+    while (pos < m_stream_len)
+    {
+        char *   p_end = memchr(&m_stream[pos], '\n', m_stream_len - pos);
+        char     kind;
+        unsigned seq;
+
+        if (p_end == NULL || sscanf(&m_stream[pos], "%c%u:", &kind, &seq) != 2 || seq >= TEST_PUSHES)
+        {
+            fprintf(stderr, "FAIL round %u: broken line at byte %zu\n", round, pos);
+            return false;
+        }
+        size_t len = (size_t)(p_end - &m_stream[pos]) + 1;
+        if (kind != p_kind[seq] || len != test_line(expect, kind, seq) ||
+            memcmp(&m_stream[pos], expect, len) != 0)
+        {
+            fprintf(stderr, "FAIL round %u: line %c%u is torn or mixed with another line\n", round, kind, seq);
+            return false;
+        }
+        if (!p_accepted[seq] || seen[seq])
+        {
+            fprintf(stderr, "FAIL round %u: line %c%u sent twice or not accepted\n", round, kind, seq);
+            return false;
+        }
+        if (kind == 'L')
+        {
+            if (have_line && seq < last_line)
+            {
+                fprintf(stderr, "FAIL round %u: line L%u after L%u\n", round, seq, last_line);
+                return false;
+            }
+            last_line = seq;
+            have_line = true;
+        }
+        seen[seq] = true;
+        pos += len;
+    }
+
+    for (uint32_t seq = 0; seq < TEST_PUSHES; seq++)
+    {
+        if (p_accepted[seq] && !seen[seq])
+        {
+            fprintf(stderr, "FAIL round %u: line %c%u accepted but never sent\n", round, p_kind[seq], seq);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(void)
+{
+    static bool accepted[TEST_PUSHES];
+    static char kind[TEST_PUSHES];
+    char        line[TEST_LINE_MAX + 1];
+    uint32_t    pushed = 0;
+    uint32_t    alarms = 0;
+    uint32_t    dropped = 0;
+    uint32_t    stall = 0;      // 剩下幾次 push 沒有 TX_DONE
+    uint32_t    stalls = 0;
+
+    uarte_pusher_init();
+
+    for (uint32_t round = 0; round < TEST_ROUNDS; round++)
+    {
+        m_stream_len = 0;
+
+        for (uint32_t seq = 0; seq < TEST_PUSHES; seq++)
+        {
+            // 1/8 是警報；IRQ 大約一半的 push 在複製後的空檔插進來
+            kind[seq] = (test_rand() % 8 == 0) ? 'A' : 'L';
+            m_irq_in_window = (stall == 0) && (test_rand() % 2) == 0;
+
+            size_t len = test_line(line, kind[seq], seq);
+            accepted[seq] = (kind[seq] == 'A') ? uarte_pusher_push_alarm((uint8_t *)line, len)
+                                               : uarte_pusher_push((uint8_t *)line, len);
+            memset(line, '#', sizeof(line));    // push 之後 caller 的 buffer 可以再用
+
+            pushed++;
+            alarms  += (kind[seq] == 'A');
+            dropped += !accepted[seq];
+
+            // 主迴圈之間也會有 0〜2 次 TX_DONE（ring 偶爾會滿）；偶爾 UART 停一陣子，ring 在長的 DMA 後面塞滿
+            if (stall > 0)
+            {
+                stall--;
+            }
+            else if (test_rand() % 32 == 0)
+            {
+                stall = 4 + test_rand() % 16;
+                stalls++;
+            }
+            else
+            {
+                for (uint32_t n = test_rand() % 5; n > 2; n--)
+                {
+                    test_tx_done();
+                }
+            }
+        }
+
+        m_irq_in_window = false;
+        while (m_dma_data != NULL)
+        {
+            test_tx_done();
+        }
+
+        if (!test_check(round, accepted, kind))
+            return 1;
+    }
+
+    printf("uarte_pusher pushes=%u alarms=%u dropped=%u irq_in_window=%u stalls=%u dma_max=%u\n",
+           pushed, alarms, dropped, m_irq_window_fired, stalls, m_dma_max);
+    printf("PASS\n");
+    return 0;
+}
@@ -89,12 +89,23 @@
 #include "seq_tracker.h"
 
 #include "led_status.h"
+#include "lib_token_log.h"
+
+#if BENCH_ENABLED
+#include "bench.h"
+#endif
 
 #define TEST_UART_DIRECT    0
 #define TEST_BLE_SCAN       0
 
 #define TRACE_ADV_INFO      1
 
+/* Binary token log frames go to their own RTT channel (tools/token_log_decode.py). */
+#define TOKEN_LOG_RTT_CHANNEL       1
+#define TOKEN_LOG_RTT_BUFFER_SIZE   1024
+
+static uint8_t m_token_log_rtt_buffer[TOKEN_LOG_RTT_BUFFER_SIZE];
+
 /*
 nrfjprog --memrd 0x10001208
 0xFFFFFFFE NFC OFF
@@ -118,6 +129,33 @@ static void nfc_pin_check(void)
     }
 }
 
+static void token_log_rtt_write(const uint8_t * p_data, uint16_t length)
+{
+    (void)SEGGER_RTT_Write(TOKEN_LOG_RTT_CHANNEL, p_data, length);
+}
+
+static void token_log_init(void)
+{
+    (void)SEGGER_RTT_ConfigUpBuffer(TOKEN_LOG_RTT_CHANNEL, "TokenLog",
+                                    m_token_log_rtt_buffer, sizeof(m_token_log_rtt_buffer),
+                                    SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    TokenLogInit(token_log_rtt_write);
+}
+
+// seq_tracker 的 keepalive 用（app_timer 的 RTC1 counter 每 512 秒繞一圈，這裡累加成 ms）
+static uint64_t m_time_ticks;
+static uint32_t m_time_last_tick;
+
+static uint32_t gateway_time_ms(void)
+{
+    uint32_t now = app_timer_cnt_get();
+
+    m_time_ticks += app_timer_cnt_diff_compute(now, m_time_last_tick);
+    m_time_last_tick = now;
+
+    return (uint32_t)((m_time_ticks * 1000) / APP_TIMER_CLOCK_FREQ);
+}
+
 static void timers_init(void)
 {
     ret_code_t err = app_timer_init();
@@ -135,7 +173,19 @@ static void power_management_init(void)
 int main(void)
 {
     SEGGER_RTT_Init();
+
+#if BENCH_ENABLED
+    // Microbenchmark build (armgcc BENCH=1): measure before the SoftDevice
+    // starts scanning, report over RTT and stop.
+    BenchTargetRun(BenchSuiteGateway());
+    for (;;)
+    {
+        __WFE();
+    }
+#endif
+
     SEGGER_RTT_printf(0, "RTT Gateway!\n");    
+    token_log_init();
 
     bleadv_sniffer_stack_init();
 
@@ -201,7 +251,7 @@ int main(void)
         bleadv_packet_t pkt;
         bleadv_format_data format;
 
-        char buffer[128];
+        char buffer[192];   // 最長 186 bytes（含 rssi / seq / flags / ver / gw_ms），太小會截掉結尾的 ###
 
        if (bleadv_queue_pop(&pkt))
         {
@@ -228,13 +278,24 @@ int main(void)
             if (strlen(format.device_name) == 0 )
                 continue;            
 
-//            if (! seq_tracker_accept(format.device_id, format.event))
-//               continue;
+            // badge 沒有變化時一直廣播同一個 payload（同一個 seq），UART 只送新的與 keepalive
+            format.gw_ms = gateway_time_ms();
+            if (! seq_tracker_accept(format.device_id, format.seq, format.gw_ms))
+               continue;
 
             bleadv_packet_output(&format, buffer, sizeof(buffer));
 
 //            uarte_tx_send((uint8_t *)buffer, strlen(buffer));
+            if (format.event == EVENT_ALARM)
+            {
+                // 警報插隊送出；還是送不出去就讓 alarm burst 的下一個 copy 再試
+                if (! uarte_pusher_push_alarm((uint8_t *)buffer, strlen(buffer)))
+                    seq_tracker_forget(format.device_id);
+            }
+            else
+            {
                 uarte_pusher_push((uint8_t *)buffer, strlen(buffer));
+            }
                 led_blink_uart();
 
 
@@ -246,6 +307,8 @@ int main(void)
             // 3. pusher_push(pkt)
         }
 
+        (void)TokenLogProcess();
+
         if (NRF_LOG_PROCESS() == false)
         {
             __WFE();
@@ -9,6 +9,8 @@ typedef struct
     uint16_t device_id;
     uint8_t  last_seq;
     bool     valid;
+    uint32_t last_ms;       // 最後一次送出的時間
+    uint32_t heard_ms;      // 最後一次收到的時間（重複的也算）
 } seq_track_entry_t;
 
 static seq_track_entry_t m_table[SEQ_TRACK_MAX_DEVICES];
@@ -19,10 +21,22 @@ void seq_tracker_reset(void)
         m_table[i].valid = false;
 }
 
+void seq_tracker_forget(uint16_t device_id)
+{
+    for (int i = 0; i < SEQ_TRACK_MAX_DEVICES; i++)
+    {
+        if (m_table[i].valid && m_table[i].device_id == device_id)
+        {
+            m_table[i].valid = false;
+            return;
+        }
+    }
+}
+
 /* 回傳 true = 接受（新資料） */
-bool seq_tracker_accept(uint16_t device_id, uint8_t seq)
+bool seq_tracker_accept(uint16_t device_id, uint8_t seq, uint32_t now_ms)
 {
-    seq_track_entry_t * free_slot = NULL;
+    seq_track_entry_t * slot = NULL;
 
     for (int i = 0; i < SEQ_TRACK_MAX_DEVICES; i++)
     {
@@ -30,34 +44,40 @@ bool seq_tracker_accept(uint16_t device_id, uint8_t seq)
         {
             if (m_table[i].device_id == device_id)
             {
-                int8_t diff = (int8_t)(seq - m_table[i].last_seq);
-
-                if (diff <= 0)
+                /* badge 重開後 seq 從 0 開始，所以只有「相同」才算重複 */
+                if (m_table[i].last_seq == seq &&
+                    (uint32_t)(now_ms - m_table[i].last_ms) < SEQ_TRACK_KEEPALIVE_MS)
                 {
-                    /* duplicate or old */
+                    /* duplicate：警報的 burst 期間不會被換掉 */
+                    m_table[i].heard_ms = now_ms;
                     return false;
                 }
 
-                /* new */
+                /* new / keepalive */
                 m_table[i].last_seq = seq;
+                m_table[i].last_ms  = now_ms;
+                m_table[i].heard_ms = now_ms;
                 return true;
             }
+
+            /* table full 時換掉最久沒收到的 */
+            if (slot == NULL ||
+                (slot->valid && (uint32_t)(now_ms - m_table[i].heard_ms) > (uint32_t)(now_ms - slot->heard_ms)))
+            {
+                slot = &m_table[i];
+            }
         }
-        else if (!free_slot)
+        else if (slot == NULL || slot->valid)
         {
-            free_slot = &m_table[i];
+            slot = &m_table[i];
         }
     }
 
-    /* 新 device */
-    if (free_slot)
-    {
-        free_slot->device_id = device_id;
-        free_slot->last_seq  = seq;
-        free_slot->valid     = true;
-        return true;
-    }
-
-    /* table full → 保守策略：丟 */
-    return false;
+    /* 新 device（或換掉的 entry）：不丟資料 */
+    slot->device_id = device_id;
+    slot->last_seq  = seq;
+    slot->last_ms   = now_ms;
+    slot->heard_ms  = now_ms;
+    slot->valid     = true;
+    return true;
 }
@@ -4,10 +4,16 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-/* 回傳 true = 新資料，false = 重複 / 舊資料 */
-bool seq_tracker_accept(uint16_t device_id, uint8_t seq);
+/* 同一個 seq 的重複廣播也每隔這麼久送一筆，host 端才能判斷 online */
+#define SEQ_TRACK_KEEPALIVE_MS  5000
+
+/* 回傳 true = 新資料（或 keepalive），false = 重複 */
+bool seq_tracker_accept(uint16_t device_id, uint8_t seq, uint32_t now_ms);
+
+/* 接受了卻送不出去（UART 滿）時：下一個 copy 不當作重複 */
+void seq_tracker_forget(uint16_t device_id);
 
 /* optional */
 void seq_tracker_reset(void);
 
-#endif
\ No newline at end of file
+#endif
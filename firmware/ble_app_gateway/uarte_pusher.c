@@ -1,5 +1,6 @@
 #include "uarte_pusher.h"
 #include "nrfx_uarte.h"
+#include "app_util_platform.h"
 #include <string.h>
 
 /* ---------- Config ---------- */
@@ -13,7 +14,7 @@
 #define UARTE_RX_PIN  11
 #endif
 
-#define UARTE_PUSHER_BUF_SIZE 512
+#define UARTE_PUSHER_BUF_SIZE (512 + UARTE_PUSHER_ALARM_MAX)   // 一般的資料仍有 512 bytes
 
 /* ---------- Static ---------- */
 
@@ -21,9 +22,15 @@ static nrfx_uarte_t m_uarte = NRFX_UARTE_INSTANCE(0);
 
 static uint8_t  m_buf[UARTE_PUSHER_BUF_SIZE];
 static volatile size_t m_head = 0;
-static volatile size_t m_tail = 0;
+static volatile size_t m_tail = 0;              // DMA 送出中的 bytes 也還在 m_tail 之後（TX_DONE 才釋放）
+static volatile size_t m_inflight = 0;          // 送出中的 ring bytes（0: 警報或閒置）
 static volatile bool   m_tx_busy = false;
 
+static uint8_t  m_alarm_buf[UARTE_PUSHER_ALARM_MAX];
+static volatile size_t m_alarm_len = 0;         // 等待 / 送出中的警報（0: 空）
+static volatile bool   m_alarm_tx = false;      // 目前的 DMA 是警報
+static volatile bool   m_ring_split = false;    // ring 的上一段在 buffer 尾端切斷（行的中間）
+
 /* ---------- Helpers ---------- */
 
 static size_t buf_used(void)
@@ -34,6 +41,7 @@ static size_t buf_used(void)
         return UARTE_PUSHER_BUF_SIZE - (m_tail - m_head);
 }
 
+// buf_used() 含送出中的 bytes：EasyDMA 還在讀的區域不會被 push 覆寫
 static size_t buf_free(void)
 {
     return (UARTE_PUSHER_BUF_SIZE - 1) - buf_used();
@@ -41,13 +49,27 @@ static size_t buf_free(void)
 
 static void kick_tx(void);
 
+/* DMA 結束（送完或中止）：送出中的區域才還給 ring */
+static void tx_release(void)
+{
+    if (m_alarm_tx)
+    {
+        m_alarm_tx = false;
+        m_alarm_len = 0;
+    }
+    m_tail = (m_tail + m_inflight) % UARTE_PUSHER_BUF_SIZE;
+    m_inflight = 0;
+    m_tx_busy = false;
+}
+
 /* ---------- IRQ handler ---------- */
 
 static void uarte_evt_handler(nrfx_uarte_event_t const * p_evt, void * p_ctx)
 {
+    // nrfx_uarte_tx_abort 也是 TX_DONE（送了一部分）；那一段就丟掉
     if (p_evt->type == NRFX_UARTE_EVT_TX_DONE)
     {
-        m_tx_busy = false;
+        tx_release();
         kick_tx();
     }
 }
@@ -74,34 +96,72 @@ static void kick_tx(void)
     if (m_tx_busy)
         return;
 
+    // 警報只在行的邊界插隊（ring 的一行分成兩段送的時候等後半段送完）
+    if (m_alarm_len != 0 && !m_ring_split)
+    {
+        m_tx_busy = true;
+        m_alarm_tx = true;
+        if (nrfx_uarte_tx(&m_uarte, m_alarm_buf, m_alarm_len) != NRFX_SUCCESS)
+            tx_release();   // 不會有 TX_DONE：警報丟掉，ring 下次 kick 再送
+        return;
+    }
+
     size_t used = buf_used();
     if (used == 0)
         return;
 
     size_t len;
-    if (m_head > m_tail)
+    bool wrap = !(m_head > m_tail);
+    if (!wrap)
         len = m_head - m_tail;
     else
         len = UARTE_PUSHER_BUF_SIZE - m_tail;
 
     m_tx_busy = true;
-    nrfx_uarte_tx(&m_uarte, &m_buf[m_tail], len);
+    m_inflight = len;
+    m_ring_split = wrap && m_head != 0;
+    if (nrfx_uarte_tx(&m_uarte, &m_buf[m_tail], len) != NRFX_SUCCESS)
+    {
+        tx_release();       // 不會有 TX_DONE：這一段丟掉
+    }
+}
 
-    m_tail = (m_tail + len) % UARTE_PUSHER_BUF_SIZE;
+static bool ring_push(const uint8_t * data, size_t len, size_t reserve)
+{
+    if (len + reserve > buf_free())
+        return false;   // overflow → 丟
+
+    // 先複製完整的一行，再一次更新 m_head：TX_DONE 的 IRQ 不會送出寫到一半的行
+    size_t head  = m_head;
+    size_t first = UARTE_PUSHER_BUF_SIZE - head;
+    if (first > len)
+        first = len;
+    memcpy(&m_buf[head], data, first);
+    memcpy(m_buf, data + first, len - first);
+
+    CRITICAL_REGION_ENTER();
+    m_head = (head + len) % UARTE_PUSHER_BUF_SIZE;
+    kick_tx();
+    CRITICAL_REGION_EXIT();
+    return true;
 }
 
 bool uarte_pusher_push(const uint8_t * data, size_t len)
 {
-    if (len > buf_free())
-        return false;   // overflow → 丟
+    return ring_push(data, len, UARTE_PUSHER_ALARM_MAX);
+}
 
-    for (size_t i = 0; i < len; i++)
-    {
-        m_buf[m_head] = data[i];
-        m_head = (m_head + 1) % UARTE_PUSHER_BUF_SIZE;
-    }
+bool uarte_pusher_push_alarm(const uint8_t * data, size_t len)
+{
+    if (m_alarm_len != 0 || len > sizeof(m_alarm_buf))
+        return ring_push(data, len, 0);
+
+    memcpy(m_alarm_buf, data, len);
 
+    CRITICAL_REGION_ENTER();
+    m_alarm_len = len;
     kick_tx();
+    CRITICAL_REGION_EXIT();
     return true;
 }
 
@@ -3,11 +3,16 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#define UARTE_PUSHER_ALARM_MAX      192     // 警報一筆的上限（main.c 的 buffer）；ring 也保留這麼多給警報
+
 void uarte_pusher_init(void);
 
-/* 非阻塞：丟資料進 buffer */
+/* 非阻塞：丟資料進 buffer（保留 UARTE_PUSHER_ALARM_MAX 給警報） */
 bool uarte_pusher_push(const uint8_t * data, size_t len);
 
+/* 非阻塞：警報。在行的邊界插隊（下一個 DMA 就送），位置已被占用時放進 ring 的保留空間 */
+bool uarte_pusher_push_alarm(const uint8_t * data, size_t len);
+
 /* 狀態 */
 bool uarte_pusher_is_busy(void);
 size_t uarte_pusher_bytes_free(void);
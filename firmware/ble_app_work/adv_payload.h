@@ -0,0 +1,94 @@
+/**
+  ******************************************************************************************
+  * @file    adv_payload.h
+  * @brief   BadgeのManufacturer Specific Data (tools/adv_payload_gen.pyで生成. 手で編集しない)
+  ******************************************************************************************
+*/
+
+#ifndef ADV_PAYLOAD_H_
+#define ADV_PAYLOAD_H_
+
+#include <stdint.h>
+
+#define ADV_COMPANY_ID			(0xFFFF)
+#define ADV_APP_ID				(0x3412)
+#define ADV_PAYLOAD_VERSION		(1)
+#define ADV_PAYLOAD_INVALID		(-1)
+
+/* event */
+#define ADV_EVENT_ERROR         (0)		/* error */
+#define ADV_EVENT_BOOT          (1)		/* boot */
+#define ADV_EVENT_HEARTBEAT     (2)		/* heartbeat */
+#define ADV_EVENT_BUTTON        (3)		/* button */
+#define ADV_EVENT_POSTURE       (4)		/* posture change */
+#define ADV_EVENT_ALARM         (5)		/* fall/tilt alarm (sent in the alarm burst; POSTURE without FALLEN clears it) */
+
+/* flags (bit) */
+#define ADV_FLAG_FALLEN         (0x01)	/* tilted or fallen (tilt detector) */
+
+/* v1: company_idの後 12 bytes. Later versions only append fields, so a receiver decodes the v1 prefix of any newer version. */
+typedef struct __attribute__((packed))
+{
+	uint16_t  app_id;       /* APP_ID */
+	uint8_t   ver;          /* payload version */
+	uint16_t  device_id;    /* FICR based id */
+	uint8_t   seq;          /* +1 for every new payload; a repeat of the same seq is a duplicate */
+	uint8_t   event;        /* EVENT_* */
+	uint8_t   flags;        /* FLAG_* */
+	int8_t    x;            /* acc [-2 g, 2 g] */
+	int8_t    y;            /* acc [-2 g, 2 g] */
+	int8_t    z;            /* acc [-2 g, 2 g] */
+	uint8_t   bat;          /* battery [0 V, 4.2 V] */
+} adv_payload_v1_t;
+
+#define ADV_PAYLOAD_V1_SIZE		(12)
+typedef char adv_payload_v1_size_check[ ( sizeof( adv_payload_v1_t ) == ADV_PAYLOAD_V1_SIZE ) ? 1 : -1 ];
+
+/* v0: company_idの後 13 bytes. Before the version byte (13 bytes, told apart by its length). event counted posture changes; one was the posture. */
+typedef struct __attribute__((packed))
+{
+	uint16_t  app_id;       /* APP_ID */
+	uint16_t  device_id;    /* FICR based id */
+	uint8_t   event;        /* posture change counter */
+	int8_t    x;            /* acc [-2 g, 2 g] */
+	int8_t    y;            /* acc [-2 g, 2 g] */
+	int8_t    z;            /* acc [-2 g, 2 g] */
+	uint8_t   bat;          /* battery [0 V, 4.2 V] */
+	uint8_t   one;          /* 0: none, 1: fallen */
+	uint8_t   two;          /* unused */
+	uint8_t   three;        /* unused */
+	uint8_t   four;         /* unused */
+} adv_payload_v0_t;
+
+#define ADV_PAYLOAD_V0_SIZE		(13)
+typedef char adv_payload_v0_size_check[ ( sizeof( adv_payload_v0_t ) == ADV_PAYLOAD_V0_SIZE ) ? 1 : -1 ];
+
+/* 送信する版 */
+typedef adv_payload_v1_t adv_payload_t;
+
+/**
+ * @brief company_idの後のpayloadの版を返す
+ * @param p_data payload (company_idの後)
+ * @param len payload長
+ * @retval 版 (ADV_PAYLOAD_INVALID: Badgeではない)
+ */
+static inline int adv_payload_version( const uint8_t *p_data, uint8_t len )
+{
+	if ( len < 2 || (uint16_t)( p_data[0] | ( p_data[1] << 8 ) ) != ADV_APP_ID )
+	{
+		return ADV_PAYLOAD_INVALID;
+	}
+	if ( len == ADV_PAYLOAD_V0_SIZE )
+	{
+		return 0;
+	}
+	/* 新しい版は後ろにfieldを足すだけ (v1部分はそのまま読める) */
+	if ( ( p_data[2] == ADV_PAYLOAD_VERSION && len == ADV_PAYLOAD_V1_SIZE ) ||
+		 ( p_data[2] > ADV_PAYLOAD_VERSION && len > ADV_PAYLOAD_V1_SIZE ) )
+	{
+		return p_data[2];
+	}
+	return ADV_PAYLOAD_INVALID;
+}
+
+#endif /* ADV_PAYLOAD_H_ */
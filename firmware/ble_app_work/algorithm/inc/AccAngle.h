@@ -10,6 +10,10 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2022/05/16       akiteru           create new
+  * 1.1            2026/10/19       k.tashiro         calc_acc_rot_blockを追加
+  * 1.2            2026/10/19       k.tashiro         clac_acc_angleを静止判定付きの逐次平均に変更
+  * 1.3            2026/10/19       k.tashiro         角度調整情報の保持先の関数を宣言
+  * 1.4            2026/10/19       k.tashiro         calc_acc_rot_blockを削除
   ******************************************************************************************
 */
 
@@ -90,8 +94,10 @@ uint32_t angle_deg2rad( ACC_ANGLE *deg, ACC_ANGLE *rad );
  * @param x ACC_X
  * @param y ACC_Y
  * @param z ACC_Z
+ * @remark 静止した状態が1s (25 Sample x 4窓) 続いた時点で算出する. 動いている間は算出しない
  * @retval ret 姿勢角度[unit rad]
  *			cmpl: true 計算完了, false:計算中
+ * @retval NRF_ERROR_INVALID_DATA 計算中
  */
 uint32_t clac_acc_angle( int16_t x, int16_t y, int16_t z, ACC_ANGLE *result_rad );
 
@@ -128,5 +134,39 @@ void SetupAngleAdjust( void );
 void SaveAngleAdjust( void );
 /* 2022.05.18 Add Flashからデータを読み出し設定する -- */
 
+/* 2026.10.19 Add 角度調整情報の保持先 ++ */
+/*
+ * SetupAngleAdjust/SaveAngleAdjustが呼び出す. AccAngle.cを組み込むApplicationで実装する
+ * (Shoes: firmware/src/mode_manager.c, Badge: main.c)
+ */
+/**
+ * @brief 角度調整情報設定
+ * @param angle_info 角度調整情報
+ * @retval None
+ */
+void SetAngleAdjustInfo( ACC_ANGLE *angle_info );
+
+/**
+ * @brief 角度調整情報取得
+ * @param angle_info 角度調整情報
+ * @retval None
+ */
+void GetAngleAdjustInfo( ACC_ANGLE *angle_info );
+
+/**
+ * @brief 角度調整状態変更
+ * @param state 角度調整状態
+ * @retval None
+ */
+void ChangeAngleAdjustState( uint8_t state );
+
+/**
+ * @brief 角度調整状態取得
+ * @param state 角度調整状態
+ * @retval None
+ */
+void GetAngleAdjustState( uint8_t *state );
+/* 2026.10.19 Add 角度調整情報の保持先 -- */
+
 #endif /* ACCANGLE_H_ */
 
@@ -0,0 +1,121 @@
+/**
+  ******************************************************************************************
+  * @file    activity_algo.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Activity Classifier (3軸の特徴量 + 固定小数点の決定木)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+#ifndef ACTIVITY_ALGO_H_
+#define ACTIVITY_ALGO_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+#include "walk_algo.h"
+
+/* Definition ------------------------------------------------------------*/
+#define ACTIVITY_WINDOW				STRAGE2SEC	/* 1判定のSample数 (GetWalkResultと同じ2s窓) */
+#define ACTIVITY_AXIS_NUM			(3)
+#define ACTIVITY_GRAVITY_MG			(1000)		/* 1g [mg] */
+#define ACTIVITY_ZC_HYST_MG			(50)		/* ゼロ交差のHysteresis [mg] (静止時のNoiseを数えない) */
+#define ACTIVITY_PEAK_MG			(200)		/* |a|のPeakとみなす1gからの増加 [mg] */
+#define ACTIVITY_NODE_LEAF			(-1)		/* ACTIVITY_NODE.feature: 葉 */
+
+/* 特徴量 (窓毎. 単位はmg, dps, Sample数) */
+typedef enum
+{
+	ACT_FEAT_X_MEAN = 0,		/* 平均 [mg] */
+	ACT_FEAT_Y_MEAN,
+	ACT_FEAT_Z_MEAN,
+	ACT_FEAT_X_SD,				/* 標準偏差 [mg] */
+	ACT_FEAT_Y_SD,
+	ACT_FEAT_Z_SD,
+	ACT_FEAT_X_ZC,				/* 前の窓の平均に対するゼロ交差数 */
+	ACT_FEAT_Y_ZC,
+	ACT_FEAT_Z_ZC,
+	ACT_FEAT_MAG_SD,			/* |a|の標準偏差 [mg] */
+	ACT_FEAT_ENERGY,			/* |a| - 1gの実効値 [mg] */
+	ACT_FEAT_PEAK_NUM,			/* |a|のPeak数 */
+	ACT_FEAT_PEAK_INTERVAL,		/* |a|のPeak間隔の平均 [Sample] (Peakが2個未満なら0) */
+	ACT_FEAT_GYRO_SD,			/* |ω|の標準偏差 [dps] (Gyroなしは0) */
+	ACT_FEAT_NUM
+} ACTIVITY_FEATURE;
+
+/* 判定結果 */
+typedef enum
+{
+	ACTIVITY_STILL = 0,
+	ACTIVITY_WALK,
+	ACTIVITY_RUN,
+	ACTIVITY_DASH,
+	ACTIVITY_JUMP,
+	ACTIVITY_CLASS_NUM
+} ACTIVITY_CLASS;
+
+/* Struct ----------------------------------------------------------------*/
+/* 決定木のNode (前順に並べる. 左の子は次の要素) */
+typedef struct _activity_node_
+{
+	int8_t		feature;		/* 比較する特徴量 (ACTIVITY_NODE_LEAF: 葉) */
+	uint8_t		next;			/* 特徴量 > thresholdの時に進むNode (葉: ACTIVITY_CLASS) */
+	int16_t		threshold;		/* 特徴量 <= thresholdなら左の子 */
+} ACTIVITY_NODE;
+
+typedef struct _activity_result_
+{
+	int16_t		feature[ACT_FEAT_NUM];
+	uint8_t		class_id;		/* ACTIVITY_CLASS */
+} ACTIVITY_RESULT;
+
+/* 使用量 (Cycle数はbench/のActivityAddSample, ActivityClassifyで計る) */
+typedef struct _activity_size_
+{
+	uint16_t	ram_size;		/* 集計中の状態 [byte] */
+	uint16_t	model_size;		/* 決定木 (Flash) [byte] */
+	uint16_t	node_num;
+	uint8_t		depth;			/* 1回の判定の最大比較回数 */
+} ACTIVITY_SIZE;
+
+/* Function prototypes ---------------------------------------------------*/
+/**
+ * @brief Activity Classifierの初期化
+ * @param None
+ * @retval None
+ */
+void ActivityReset( void );
+
+/**
+ * @brief 1 Sample投入し, 窓が埋まったら特徴量を算出して判定する
+ * @param x ACC X [mg]
+ * @param y ACC Y [mg]
+ * @param z ACC Z [mg]
+ * @param p_gyro Gyro X/Y/Z [dps] (Gyroを使わない場合はNULL)
+ * @param p_result 判定結果 (ALGO_SUCCESSの時に設定する)
+ * @retval ALGO_SUCCESS 判定完了
+ * @retval ALGO_DATACHARGE 窓が埋まっていない
+ * @retval ALGO_ERROR 引数異常
+ */
+int8_t ActivityAddSample( int16_t x, int16_t y, int16_t z, const int16_t *p_gyro, ACTIVITY_RESULT *p_result );
+
+/**
+ * @brief 特徴量から判定する (決定木)
+ * @param p_feature 特徴量 (ACT_FEAT_NUM個)
+ * @retval ACTIVITY_CLASS
+ */
+uint8_t ActivityClassify( const int16_t *p_feature );
+
+/**
+ * @brief RAM/ROMの使用量
+ * @param p_size 使用量
+ * @retval None
+ */
+void ActivityGetSize( ACTIVITY_SIZE *p_size );
+
+#endif /* ACTIVITY_ALGO_H_ */
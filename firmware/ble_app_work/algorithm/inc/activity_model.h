@@ -0,0 +1,36 @@
+/**
+  ******************************************************************************************
+  * @file    activity_model.h
+  * @brief   Activity Classifierの決定木 (tools/activity_train.pyで生成. 手で編集しない)
+  ******************************************************************************************
+*/
+
+/*
+ * 24 sessions, 485 labelled windows, acc only
+ * depth 4 (max 5), min leaf 4, training accuracy 100.0 %
+ * hold-out (every 4th session): test accuracy 92.6 %
+ */
+
+#ifndef ACTIVITY_MODEL_H_
+#define ACTIVITY_MODEL_H_
+
+#include "activity_algo.h"
+
+#define ACTIVITY_MODEL_NODE_NUM		(9)
+#define ACTIVITY_MODEL_DEPTH		(4)
+
+/* feature, next (葉: class), threshold */
+static const ACTIVITY_NODE g_activity_model[ACTIVITY_MODEL_NODE_NUM] =
+{
+	{ 3, 8, 569 },                              /*   0: x_sd <= 569 */
+	{ 3, 3, 51 },                               /*   1: x_sd <= 51 */
+	{ ACTIVITY_NODE_LEAF, ACTIVITY_STILL, 0 },  /*   2: still */
+	{ 9, 5, 548 },                              /*   3: mag_sd <= 548 */
+	{ ACTIVITY_NODE_LEAF, ACTIVITY_WALK, 0 },   /*   4: walk */
+	{ 3, 7, 129 },                              /*   5: x_sd <= 129 */
+	{ ACTIVITY_NODE_LEAF, ACTIVITY_JUMP, 0 },   /*   6: jump */
+	{ ACTIVITY_NODE_LEAF, ACTIVITY_RUN, 0 },    /*   7: run */
+	{ ACTIVITY_NODE_LEAF, ACTIVITY_DASH, 0 },   /*   8: dash */
+};
+
+#endif /* ACTIVITY_MODEL_H_ */
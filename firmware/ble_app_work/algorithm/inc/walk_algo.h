@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/25       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         GetWalkResultのModeを公開
   ******************************************************************************************
 */
 
@@ -74,6 +75,19 @@
 //MODULO coeff.
 #define MODULO						65536
 
+/* 2026.10.19 Add GetWalkResultのMode (walk_algo_daliy.cから移動) ++ */
+#define DAILY						0			//Acc Y data
+#define TAP							1			//not use
+#define RADDER						2			//not use
+#define START_REACTION				3			//Acc Y data
+#define JUMP						4			//not use
+#define SKYJUMP						5			//Acc Z data
+#define SPEED_RAC					6			//not use
+#define TELEPORTATION				7			//Acc Y data
+#define SIDEAGILITY					8			//Acc Z data
+#define DASH10						9			//not use
+/* 2026.10.19 Add GetWalkResultのMode (walk_algo_daliy.cから移動) -- */
+
 #define ALGO_SUCCESS				1
 #define ALGO_DATACHARGE				2
 #define ALGO_ERROR					0
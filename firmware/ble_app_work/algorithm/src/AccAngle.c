@@ -10,6 +10,12 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2022/05/16       akiteru           create new
+  * 1.1            2026/10/19       k.tashiro         角度調整情報のLogをToken Logに変更
+  * 1.2            2026/10/19       k.tashiro         math.hのM_PIと重複しないようにする
+  * 1.3            2026/10/19       k.tashiro         補正を固定小数点(SMLAD)に変更, 角度計算を単精度に変更
+  * 1.4            2026/10/19       k.tashiro         角度算出を静止判定付きの逐次平均に変更 (200 Sampleのバッファを廃止)
+  * 1.5            2026/10/19       k.tashiro         mode_manager.h/ble_manager.hに依存しないようにする (Badgeの転倒検出で使う)
+  * 1.6            2026/10/19       k.tashiro         calc_acc_rot_blockを削除 (FIFOは1 Packet毎に補正するため呼び出し元がない)
   ******************************************************************************************
 */
 
@@ -17,25 +23,74 @@
 #include "AccAngle.h"
 #include <string.h>
 
-#include "mode_manager.h"
+/* 2026.10.19 Modify 角度調整情報の保持先はAccAngle.hで宣言する (BadgeはShoesのmode_manager.hを持たない) */
 #include "lib_angle_flash.h"
-#include "ble_manager.h"
+#include "lib_token_log.h"
+
+/* 2026.10.19 Add Cortex-M4のDSP命令 (SMLAD) ++ */
+#if defined( __ARM_FEATURE_DSP ) && ( __ARM_FEATURE_DSP == 1 )
+#include "nrf.h"
+#define ROT_USE_SMLAD	(1)
+#else
+#define ROT_USE_SMLAD	(0)
+#endif
+/* 2026.10.19 Add Cortex-M4のDSP命令 (SMLAD) -- */
 
 /* Definition ------------------------------------------------------------*/
-#define ACC_BUF_SIZE	200   /* 回転行列算出用加速度データバッファサイズ */
-
+/* 2026.10.19 Modify 200 Sampleのバッファ -> 窓毎の静止判定と逐次平均 ++ */
+#define ANGLE_CALIB_WINDOW		(25)		/* 静止判定の窓 [Sample] (100Hzで250ms) */
+#define ANGLE_CALIB_WINDOW_NUM	(4)			/* 角度算出に必要な連続した静止窓の数 (100 Sample = 1s) */
+#define ANGLE_STILL_VAR_MAX		(400.0f)	/* 静止とみなす窓内の|a|の分散 [mg^2] (標準偏差20mg) */
+#define ANGLE_GRAVITY_MG		(1000.0f)	/* 1g [mg] (AccGyroCalcDataでmgに変換済み) */
+#define ANGLE_GRAVITY_TOL		(100.0f)	/* 窓の平均|a|と1gの差の許容 [mg] */
+#define ANGLE_DRIFT_MAX			(30)		/* 採用済みの平均と窓の平均の差の許容 (軸毎) [mg]. |a|が変わらない傾きの検出 */
+/* 2026.10.19 Modify 200 Sampleのバッファ -> 窓毎の静止判定と逐次平均 -- */
+
+#undef M_PI						/* 2026.10.19 Add math.hの定義 (GCC) と値を揃えるため置き換える */
 #define M_PI			3.141593		/* 円周率 */
 
+/* 2026.10.19 Add 固定小数点の回転行列 ++ */
+#define ROT_Q			(14)			/* 回転行列の小数部Bit数 (Q14. Q15では1.0を表せないため) */
+#define ROT_ONE			(1 << ROT_Q)
+#define ROT_ROUND		(1 << ( ROT_Q - 1 ))
+/* 2026.10.19 Add 固定小数点の回転行列 -- */
+
+/* Struct ----------------------------------------------------------------*/
+/* 2026.10.19 Add 静止判定の窓 */
+typedef struct _acc_calib_window_
+{
+	int32_t sum[3];			/* 軸毎の合計 [mg] */
+	float mag_ref;			/* 窓の先頭Sampleの|a| (分散計算の桁落ちを防ぐ基準値) [mg] */
+	float mag_sum;			/* |a| - mag_refの合計 */
+	float mag_sq_sum;		/* (|a| - mag_ref)^2の合計 */
+	uint16_t count;			/* 窓内のSample数 */
+}ACC_CALIB_WINDOW;
+
+/* 2026.10.19 Add 取付角度算出の途中経過 (RAMはSample数によらず一定) */
+typedef struct _acc_calib_
+{
+	ACC_CALIB_WINDOW win;	/* 集計中の窓 */
+	int32_t total[3];		/* 採用した窓の軸毎の合計 [mg] */
+	uint16_t total_count;	/* 採用した窓のSample数 */
+	uint8_t still_num;		/* 連続して採用した窓の数 */
+}ACC_CALIB;
+
 /* Private variables -----------------------------------------------------*/
-static ACC_BUF g_acc_buf[ACC_BUF_SIZE];
-static uint16_t g_buf_count = 0;
+/* 2026.10.19 Modify g_acc_buf[200], g_buf_count -> g_acc_calib */
+static ACC_CALIB g_acc_calib;
 
 static float g_rot[3][3];   /* 加速度データ補正用回転行列バッファ */
+/* 2026.10.19 Add g_rotのQ14版. 行毎に (m0 | m1 << 16), (m2) の2 wordに詰める (SMLADの入力) */
+static uint32_t g_rot_q14[3][2];
 
 static ROM_ANGLE_INFO g_angle_info = {0};		/* ROMデータ */
 
 /* Private function prototypes -------------------------------------------*/
-static void matrix_product3x3(float pA[3][3], float pB[3][3], float pAns[3][3]);
+/* 2026.10.19 Modify 行列積は展開したためmatrix_product3x3を削除 */
+static void rot_matrix_fix( void );
+static void rot_apply( const ACC_BUF *p_in, ACC_RESULT *p_out );
+static bool calib_window_still( const ACC_CALIB_WINDOW *p_win );
+static bool calib_window_drift( const ACC_CALIB *p_calib );
 
 /**
  * @brief Clear ACC Buffer
@@ -44,8 +99,7 @@ static void matrix_product3x3(float pA[3][3], float pB[3][3], float pAns[3][3]);
  */
 void clear_acc_buf(void)
 {
-	memset(g_acc_buf, 0, sizeof(g_acc_buf));
-	g_buf_count = 0;
+	memset(&g_acc_calib, 0, sizeof(g_acc_calib));
 }
 
 /**
@@ -59,6 +113,7 @@ void clear_rot_matrix(void)
 	g_rot[0][0] = 1.0;
 	g_rot[1][1] = 1.0;
 	g_rot[2][2] = 1.0;
+	rot_matrix_fix();		/* 2026.10.19 Add */
 }
 
 /**
@@ -123,15 +178,19 @@ uint32_t angle_deg2rad( ACC_ANGLE *deg, ACC_ANGLE *rad )
  * @param x ACC_X
  * @param y ACC_Y
  * @param z ACC_Z
+ * @remark ANGLE_CALIB_WINDOW Sample毎に静止判定し, 静止した窓がANGLE_CALIB_WINDOW_NUM個続いた時点の平均で算出する
+ *         動いた窓は捨てて最初からやり直す. 算出後は次の呼び出しから再び集計する
  * @retval ret 姿勢角度[unit rad]
  *			cmpl: true 計算完了, false:計算中
  */
 uint32_t clac_acc_angle( int16_t x, int16_t y, int16_t z, ACC_ANGLE *result_rad )
 {
-	uint16_t i;
-	int32_t total_x = 0;
-	int32_t total_y = 0;
-	int32_t total_z = 0;
+	ACC_CALIB_WINDOW *p_win = &g_acc_calib.win;
+	int32_t total_x;
+	int32_t total_y;
+	int32_t total_z;
+	float mag;
+	uint8_t i;
 
 	if ( result_rad == NULL )
 	{
@@ -140,45 +199,77 @@ uint32_t clac_acc_angle( int16_t x, int16_t y, int16_t z, ACC_ANGLE *result_rad
 	/* 結果格納 */
 	result_rad->cmpl = false;
 
-	g_acc_buf[g_buf_count].x = x;
-	g_acc_buf[g_buf_count].y = y;
-	g_acc_buf[g_buf_count].z = z;
-	g_buf_count++;
+	/* 2026.10.19 Modify Bufferに溜めずに窓毎に集計する ++ */
+	mag = sqrtf( ( (float)x * (float)x ) + ( (float)y * (float)y ) + ( (float)z * (float)z ) );
+	if ( p_win->count == 0 )
+	{
+		p_win->mag_ref = mag;
+	}
+	mag -= p_win->mag_ref;
+	p_win->sum[0]		+= x;
+	p_win->sum[1]		+= y;
+	p_win->sum[2]		+= z;
+	p_win->mag_sum		+= mag;
+	p_win->mag_sq_sum	+= mag * mag;
+	p_win->count++;
+
+	if ( p_win->count < ANGLE_CALIB_WINDOW )
+	{
+		return NRF_ERROR_INVALID_DATA;
+	}
 
-	if(g_buf_count < ACC_BUF_SIZE)
+	if ( calib_window_still( p_win ) == false )
 	{
+		/* 動いている窓は捨てて最初からやり直す */
+		clear_acc_buf();
 		return NRF_ERROR_INVALID_DATA;
 	}
+	if ( calib_window_drift( &g_acc_calib ) == true )
+	{
+		/* 静止しているが姿勢が変わった. この窓から数え直す */
+		memset( g_acc_calib.total, 0, sizeof( g_acc_calib.total ) );
+		g_acc_calib.total_count	= 0;
+		g_acc_calib.still_num	= 0;
+	}
 
-	for(i = 0; i < ACC_BUF_SIZE; i++)
+	for ( i = 0; i < 3; i++ )
 	{
-		total_x += g_acc_buf[i].x;
-		total_y += g_acc_buf[i].y;
-		total_z += g_acc_buf[i].z;
+		g_acc_calib.total[i] += p_win->sum[i];
 	}
+	g_acc_calib.total_count += p_win->count;
+	g_acc_calib.still_num++;
+	memset( p_win, 0, sizeof( ACC_CALIB_WINDOW ) );
 
-	total_x = total_x / ACC_BUF_SIZE;
-	total_y = total_y / ACC_BUF_SIZE;
-	total_z = total_z / ACC_BUF_SIZE;
+	if ( g_acc_calib.still_num < ANGLE_CALIB_WINDOW_NUM )
+	{
+		return NRF_ERROR_INVALID_DATA;
+	}
+
+	total_x = g_acc_calib.total[0] / g_acc_calib.total_count;
+	total_y = g_acc_calib.total[1] / g_acc_calib.total_count;
+	total_z = g_acc_calib.total[2] / g_acc_calib.total_count;
+	clear_acc_buf();
+	/* 2026.10.19 Modify Bufferに溜めずに窓毎に集計する -- */
 
 	/* 角度計算 */
+	/* 2026.10.19 Modify double -> float (M4FのFPUは単精度のみ. doubleはSoftware演算になる) */
 
 	/*roll*/
-	double roll = atan2((double)(total_y),(double)(total_z));
+	float roll = atan2f((float)(total_y),(float)(total_z));
 
 	/*pitch*/
-	double sq = (double)(total_y)*(double)(total_y) + (double)(total_z)*(double)(total_z);
-	if(sq < 1e-12)
+	float sq = (float)(total_y)*(float)(total_y) + (float)(total_z)*(float)(total_z);
+	if(sq < 1e-12f)
 	{
 		return NRF_ERROR_INVALID_DATA;
 	}
 
-	sq = sqrt(sq);
-	double pitch = atan2((double)(-total_x), sq);
+	sq = sqrtf(sq);
+	float pitch = atan2f((float)(-total_x), sq);
 
 	result_rad->cmpl	= true;
-	result_rad->roll	= (float)(roll);	/* unit: rad */
-	result_rad->pitch	= (float)(pitch);	/* unit: rad */
+	result_rad->roll	= roll;				/* unit: rad */
+	result_rad->pitch	= pitch;			/* unit: rad */
 	result_rad->yaw		= 0.0;				/* 加速度センサだけではYaw角度算出不可。そのため0固定とする */
 
 	clac_rot_matrix( result_rad );
@@ -193,62 +284,41 @@ uint32_t clac_acc_angle( int16_t x, int16_t y, int16_t z, ACC_ANGLE *result_rad
  */
 void clac_rot_matrix( ACC_ANGLE *angle_raw )
 {
-	float Z[3][3];
-	float Y[3][3];
-	float X[3][3];
+	float cy, sy, cp, sp, cr, sr;
 
 	if ( angle_raw == NULL )
 	{
 		return ;
 	}
 
-	Z[0][0] = cos( angle_raw->yaw );
-	Z[0][1] = -sin( angle_raw->yaw );
-	Z[0][2] = 0.0;
-
-	Z[1][0] = sin( angle_raw->yaw );
-	Z[1][1] = cos( angle_raw->yaw );
-	Z[1][2] = 0.0;
-
-	Z[2][0] = 0.0;
-	Z[2][1] = 0.0;
-	Z[2][2] = 1.0;
-
-	Y[0][0] = cos( angle_raw->pitch );
-	Y[0][1] = 0.0;
-	Y[0][2] = sin( angle_raw->pitch );
-
-	Y[1][0] = 0.0;
-	Y[1][1] = 1.0;
-	Y[1][2] = 0.0;
-
-	Y[2][0] = -sin( angle_raw->pitch );
-	Y[2][1] = 0.0;
-	Y[2][2] = cos( angle_raw->pitch );
-
-	X[0][0] = 1.0;
-	X[0][1] = 0.0;
-	X[0][2] = 0.0;
-
-	X[1][0] = 0.0;
-	X[1][1] = cos( angle_raw->roll );
-	X[1][2] = -sin( angle_raw->roll );
-
-	X[2][0] = 0.0;
-	X[2][1] = sin( angle_raw->roll );
-	X[2][2] = cos( angle_raw->roll );
-
-	float ans_1[3][3];
+	/* 2026.10.19 Modify sin/cosは単精度で1回ずつ, Z * Y * Xは展開して計算する ++ */
+	cy = cosf( angle_raw->yaw );
+	sy = sinf( angle_raw->yaw );
+	cp = cosf( angle_raw->pitch );
+	sp = sinf( angle_raw->pitch );
+	cr = cosf( angle_raw->roll );
+	sr = sinf( angle_raw->roll );
 
 	/*
 	 * 補正行列 A = Z * Y * X
+	 *   Z = | cy -sy 0 |  Y = |  cp 0 sp |  X = | 1  0   0  |
+	 *       | sy  cy 0 |      |  0  1 0  |      | 0  cr -sr |
+	 *       | 0   0  1 |      | -sp 0 cp |      | 0  sr  cr |
 	 * */
+	g_rot[0][0] = cy * cp;
+	g_rot[0][1] = ( cy * sp * sr ) - ( sy * cr );
+	g_rot[0][2] = ( cy * sp * cr ) + ( sy * sr );
+
+	g_rot[1][0] = sy * cp;
+	g_rot[1][1] = ( sy * sp * sr ) + ( cy * cr );
+	g_rot[1][2] = ( sy * sp * cr ) - ( cy * sr );
 
-	/* tempA = Z * Y */
-	matrix_product3x3( Z, Y, ans_1 );
+	g_rot[2][0] = -sp;
+	g_rot[2][1] = cp * sr;
+	g_rot[2][2] = cp * cr;
 
-	/* A = tempA * X */
-	matrix_product3x3( ans_1, X, g_rot );  /*g_rotに補正用回転行列数値を格納*/
+	rot_matrix_fix();
+	/* 2026.10.19 Modify sin/cosは単精度で1回ずつ, Z * Y * Xは展開して計算する -- */
 }
 
 /* 2022.05.18 Add Flashからデータを読み出し設定する ++ */
@@ -268,11 +338,8 @@ void SetupAngleAdjust( void )
 	{
 		if ( memcmp( &g_angle_info.signiture[0], signiture, ANGLE_ADJUST_SIG_SIZE ) == 0 )
 		{
-#if 1
-			uint8_t buffer[128] = {0};
-			sprintf( (char *)buffer, "state: %d roll: %f, pitch: %f", g_angle_info.state, g_angle_info.x_angle, g_angle_info.y_angle );
-			DEBUG_LOG( LOG_INFO, "%s", buffer );
-#endif
+			/* 2026.10.19 Modify sprintf(%f)をToken Logに変更 */
+			TOKEN_LOG3( TL_ACC_ANGLE_STATE, g_angle_info.state, TOKEN_LOG_FLOAT( g_angle_info.x_angle ), TOKEN_LOG_FLOAT( g_angle_info.y_angle ) );
 			/* signiture一致 */
 			angle_data.cmpl		= false;
 			angle_data.roll		= g_angle_info.x_angle;	/* unit: rad */
@@ -333,37 +400,142 @@ void SaveAngleAdjust( void )
  */
 void calc_acc_rot( int16_t x, int16_t y, int16_t z, ACC_RESULT *calib_data )
 {
+	ACC_BUF in;
+
 	if ( calib_data != NULL )
 	{
-		calib_data->x = x * g_rot[0][0] + y * g_rot[0][1] + z * g_rot[0][2];
-		calib_data->y = x * g_rot[1][0] + y * g_rot[1][1] + z * g_rot[1][2];
-		calib_data->z = x * g_rot[2][0] + y * g_rot[2][1] + z * g_rot[2][2];
+		/* 2026.10.19 Modify floatの行列積 -> Q14の積和 (四捨五入, int16で飽和) */
+		in.x = x;
+		in.y = y;
+		in.z = z;
+		rot_apply( &in, calib_data );
 	}
 }
 
+/* 2026.10.19 Add 取付角度算出の静止判定 ++ */
 /**
- * @brief 3x3行列 行列積計算関数
- * @remark この関数は3x3行列にしか対応していない事に注意
- * @param pA 3x3行列
- * @param pB 3x3行列
- * @param pAns pA x pBの行列積
+ * @brief 窓が静止しているか (|a|の分散が小さく, 平均が1gに近い)
+ * @param p_win 集計済みの窓
+ * @retval true 静止
+ * @retval false 動いている
+ */
+static bool calib_window_still( const ACC_CALIB_WINDOW *p_win )
+{
+	float mean = p_win->mag_sum / (float)p_win->count;
+	float var = ( p_win->mag_sq_sum / (float)p_win->count ) - ( mean * mean );
+
+	if ( var > ANGLE_STILL_VAR_MAX )
+	{
+		return false;
+	}
+	if ( fabsf( p_win->mag_ref + mean - ANGLE_GRAVITY_MG ) > ANGLE_GRAVITY_TOL )
+	{
+		/* 一定の加速度が掛かっている (乗り物など) */
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief 窓の平均が採用済みの平均から離れているか (|a|が変わらないまま傾いた)
+ * @param p_calib 途中経過 (winは集計済み)
+ * @retval true 離れている
+ * @retval false 同じ姿勢 (または採用済みの窓がない)
+ */
+static bool calib_window_drift( const ACC_CALIB *p_calib )
+{
+	int32_t diff;
+	uint8_t i;
+
+	if ( p_calib->total_count == 0 )
+	{
+		return false;
+	}
+
+	for ( i = 0; i < 3; i++ )
+	{
+		diff = ( p_calib->win.sum[i] / (int32_t)p_calib->win.count ) - ( p_calib->total[i] / (int32_t)p_calib->total_count );
+		if ( ( diff > ANGLE_DRIFT_MAX ) || ( diff < -ANGLE_DRIFT_MAX ) )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+/* 2026.10.19 Add 取付角度算出の静止判定 -- */
+
+/* 2026.10.19 Add 固定小数点の回転行列 ++ */
+/**
+ * @brief g_rotからQ14の回転行列を作る
+ * @remark g_rotを変更したら必ず呼ぶ
+ * @param None
  * @retval None
  */
-static void matrix_product3x3(float pA[3][3], float pB[3][3], float pAns[3][3])
+static void rot_matrix_fix( void )
 {
-	uint16_t i,j,k;
-	float term = 0.0;
+	int32_t q[3];
+	uint8_t i, j;
 
-	for(i = 0; i < 3; i++)
+	for ( i = 0; i < 3; i++ )
 	{
-		for(j = 0; j < 3; j++)
+		for ( j = 0; j < 3; j++ )
 		{
-			term = 0.0;
-			for(k = 0; k < 3; k++)
+			/* 回転行列の要素は-1.0 - 1.0 */
+			q[j] = (int32_t)lrintf( g_rot[i][j] * (float)ROT_ONE );
+			if ( q[j] > INT16_MAX )
+			{
+				q[j] = INT16_MAX;
+			}
+			else if ( q[j] < INT16_MIN )
 			{
-				term = term + pA[i][k] * pB[k][j];
+				q[j] = INT16_MIN;
 			}
-			pAns[i][j] = term;
+		}
+		g_rot_q14[i][0] = (uint16_t)q[0] | ( (uint32_t)(uint16_t)q[1] << 16 );
+		g_rot_q14[i][1] = (uint16_t)q[2];
+	}
+}
+
+/**
+ * @brief 1 Sampleを補正する (p_inとp_outは同じでもよい)
+ * @param p_in 加速度データ
+ * @param p_out 姿勢補正後加速度データ
+ * @retval None
+ */
+static void rot_apply( const ACC_BUF *p_in, ACC_RESULT *p_out )
+{
+	uint32_t xy = (uint16_t)p_in->x | ( (uint32_t)(uint16_t)p_in->y << 16 );
+	uint32_t z = (uint16_t)p_in->z;
+	int32_t acc[3];
+	uint8_t i;
+
+	for ( i = 0; i < 3; i++ )
+	{
+#if ROT_USE_SMLAD
+		/* m0 * x + m1 * y と m2 * z をそれぞれ1命令で積和する */
+		acc[i] = (int32_t)__SMLAD( g_rot_q14[i][0], xy, ROT_ROUND );
+		acc[i] = (int32_t)__SMLAD( g_rot_q14[i][1], z, (uint32_t)acc[i] );
+#else
+		acc[i] = ROT_ROUND
+			   + ( (int32_t)(int16_t)( g_rot_q14[i][0] & 0xFFFF ) * (int16_t)( xy & 0xFFFF ) )
+			   + ( (int32_t)(int16_t)( g_rot_q14[i][0] >> 16 ) * (int16_t)( xy >> 16 ) )
+			   + ( (int32_t)(int16_t)( g_rot_q14[i][1] & 0xFFFF ) * (int16_t)( z & 0xFFFF ) );
+#endif
+		acc[i] >>= ROT_Q;
+		if ( acc[i] > INT16_MAX )
+		{
+			acc[i] = INT16_MAX;
+		}
+		else if ( acc[i] < INT16_MIN )
+		{
+			acc[i] = INT16_MIN;
 		}
 	}
+
+	p_out->x = (int16_t)acc[0];
+	p_out->y = (int16_t)acc[1];
+	p_out->z = (int16_t)acc[2];
 }
+/* 2026.10.19 Add 固定小数点の回転行列 -- */
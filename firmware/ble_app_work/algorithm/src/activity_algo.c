@@ -0,0 +1,312 @@
+/**
+  ******************************************************************************************
+  * @file    activity_algo.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Activity Classifier (3軸の特徴量 + 固定小数点の決定木)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+/*
+ * GetWalkResultはModeによってX軸かZ軸の1軸だけを使い, walk_algo.hの閾値で判定する.
+ * ここでは同じ2s窓 (STRAGE2SEC) で3軸 (+Gyro) の特徴量を逐次集計し,
+ * 窓の終わりに決定木 (activity_model.h) で判定する.
+ *  - RAMは窓のSample数によらず一定 (Sampleを溜めない)
+ *  - 決定木は整数の比較だけ (閾値はint16. 特徴量と同じ単位)
+ *  - activity_model.hはtools/activity_train.pyが記録Sessionから生成する
+ */
+
+/* Includes --------------------------------------------------------------*/
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "activity_algo.h"
+#include "activity_model.h"
+
+/* Struct ----------------------------------------------------------------*/
+typedef struct _activity_state_
+{
+	int32_t		sum[ACTIVITY_AXIS_NUM];				/* 合計 [mg] */
+	int64_t		sq_sum[ACTIVITY_AXIS_NUM];			/* (値 - ref)^2の合計 */
+	int16_t		ref[ACTIVITY_AXIS_NUM];				/* 窓の先頭Sample (分散計算の基準値) */
+	int16_t		center[ACTIVITY_AXIS_NUM];			/* ゼロ交差の基準 (前の窓の平均) */
+	int8_t		sign[ACTIVITY_AXIS_NUM];			/* centerに対する現在の符号 (0: 未確定) */
+	uint8_t		zc[ACTIVITY_AXIS_NUM];				/* ゼロ交差数 */
+	float		mag_sum;							/* |a| - 1gの合計 */
+	float		mag_sq_sum;							/* (|a| - 1g)^2の合計 */
+	float		gyro_sum;							/* |ω|の合計 */
+	float		gyro_sq_sum;						/* |ω|^2の合計 */
+	uint16_t	gyro_count;
+	uint16_t	peak_num;
+	uint16_t	peak_last;							/* 最後のPeakのSample番号 */
+	uint16_t	peak_interval_sum;
+	uint16_t	count;								/* 窓内のSample数 */
+	bool		peak_armed;							/* 前のPeakの後, |a|が1gを下回った */
+	bool		center_valid;
+} ACTIVITY_STATE;
+
+/* Private variables -----------------------------------------------------*/
+static ACTIVITY_STATE g_activity;
+
+/* Private function prototypes -------------------------------------------*/
+static void activity_window_clear( void );
+static void activity_window_feature( int16_t *p_feature );
+static int16_t activity_sat16( float value );
+
+/**
+ * @brief Activity Classifierの初期化
+ * @param None
+ * @retval None
+ */
+void ActivityReset( void )
+{
+	memset( &g_activity, 0, sizeof( g_activity ) );
+	activity_window_clear();
+}
+
+/**
+ * @brief 1 Sample投入し, 窓が埋まったら特徴量を算出して判定する
+ * @param x ACC X [mg]
+ * @param y ACC Y [mg]
+ * @param z ACC Z [mg]
+ * @param p_gyro Gyro X/Y/Z [dps] (Gyroを使わない場合はNULL)
+ * @param p_result 判定結果 (ALGO_SUCCESSの時に設定する)
+ * @retval ALGO_SUCCESS 判定完了
+ * @retval ALGO_DATACHARGE 窓が埋まっていない
+ * @retval ALGO_ERROR 引数異常
+ */
+int8_t ActivityAddSample( int16_t x, int16_t y, int16_t z, const int16_t *p_gyro, ACTIVITY_RESULT *p_result )
+{
+	ACTIVITY_STATE *p_st = &g_activity;
+	const int16_t acc[ACTIVITY_AXIS_NUM] = { x, y, z };
+	int32_t diff;
+	int8_t sign;
+	float mag;
+	uint8_t i;
+
+	if ( p_result == NULL )
+	{
+		return ALGO_ERROR;
+	}
+
+	if ( p_st->count == 0 )
+	{
+		memcpy( p_st->ref, acc, sizeof( p_st->ref ) );
+		if ( p_st->center_valid == false )
+		{
+			/* 最初の窓は先頭Sampleを基準にする */
+			memcpy( p_st->center, acc, sizeof( p_st->center ) );
+		}
+	}
+
+	/* 軸毎: 平均, 分散, ゼロ交差 */
+	for ( i = 0; i < ACTIVITY_AXIS_NUM; i++ )
+	{
+		p_st->sum[i] += acc[i];
+		diff = (int32_t)acc[i] - p_st->ref[i];
+		p_st->sq_sum[i] += (int64_t)diff * diff;
+
+		diff = (int32_t)acc[i] - p_st->center[i];
+		sign = p_st->sign[i];
+		if ( diff > ACTIVITY_ZC_HYST_MG )
+		{
+			sign = 1;
+		}
+		else if ( diff < -ACTIVITY_ZC_HYST_MG )
+		{
+			sign = -1;
+		}
+		if ( ( p_st->sign[i] != 0 ) && ( sign != p_st->sign[i] ) && ( p_st->zc[i] < UINT8_MAX ) )
+		{
+			p_st->zc[i]++;
+		}
+		p_st->sign[i] = sign;
+	}
+
+	/* |a|: 分散, 実効値, Peak間隔 */
+	mag = sqrtf( ( (float)x * (float)x ) + ( (float)y * (float)y ) + ( (float)z * (float)z ) ) - (float)ACTIVITY_GRAVITY_MG;
+	p_st->mag_sum		+= mag;
+	p_st->mag_sq_sum	+= mag * mag;
+	if ( ( p_st->peak_armed == true ) && ( mag > (float)ACTIVITY_PEAK_MG ) )
+	{
+		if ( p_st->peak_num > 0 )
+		{
+			p_st->peak_interval_sum += p_st->count - p_st->peak_last;
+		}
+		p_st->peak_num++;
+		p_st->peak_last = p_st->count;
+		p_st->peak_armed = false;
+	}
+	else if ( mag < 0.0f )
+	{
+		p_st->peak_armed = true;
+	}
+
+	/* |ω| */
+	if ( p_gyro != NULL )
+	{
+		mag = sqrtf( ( (float)p_gyro[0] * (float)p_gyro[0] ) + ( (float)p_gyro[1] * (float)p_gyro[1] ) + ( (float)p_gyro[2] * (float)p_gyro[2] ) );
+		p_st->gyro_sum		+= mag;
+		p_st->gyro_sq_sum	+= mag * mag;
+		p_st->gyro_count++;
+	}
+
+	p_st->count++;
+	if ( p_st->count < ACTIVITY_WINDOW )
+	{
+		return ALGO_DATACHARGE;
+	}
+
+	activity_window_feature( p_result->feature );
+	p_result->class_id = ActivityClassify( p_result->feature );
+
+	/* 次の窓のゼロ交差はこの窓の平均を基準にする */
+	p_st->center[0] = p_result->feature[ACT_FEAT_X_MEAN];
+	p_st->center[1] = p_result->feature[ACT_FEAT_Y_MEAN];
+	p_st->center[2] = p_result->feature[ACT_FEAT_Z_MEAN];
+	p_st->center_valid = true;
+	activity_window_clear();
+
+	return ALGO_SUCCESS;
+}
+
+/**
+ * @brief 特徴量から判定する (決定木)
+ * @param p_feature 特徴量 (ACT_FEAT_NUM個)
+ * @retval ACTIVITY_CLASS
+ */
+uint8_t ActivityClassify( const int16_t *p_feature )
+{
+	const ACTIVITY_NODE *p_node;
+	uint16_t idx = 0;
+	uint16_t step;
+
+	/* 壊れたModelでも止まらないよう, Node数より多くは辿らない */
+	for ( step = 0; step < ACTIVITY_MODEL_NODE_NUM; step++ )
+	{
+		p_node = &g_activity_model[idx];
+		if ( p_node->feature == ACTIVITY_NODE_LEAF )
+		{
+			return p_node->next;
+		}
+		if ( p_feature[p_node->feature] <= p_node->threshold )
+		{
+			idx++;
+		}
+		else
+		{
+			idx = p_node->next;
+		}
+		if ( idx >= ACTIVITY_MODEL_NODE_NUM )
+		{
+			break;
+		}
+	}
+
+	return ACTIVITY_STILL;
+}
+
+/**
+ * @brief RAM/ROMの使用量
+ * @param p_size 使用量
+ * @retval None
+ */
+void ActivityGetSize( ACTIVITY_SIZE *p_size )
+{
+	if ( p_size != NULL )
+	{
+		p_size->ram_size	= (uint16_t)sizeof( g_activity );
+		p_size->model_size	= (uint16_t)sizeof( g_activity_model );
+		p_size->node_num	= ACTIVITY_MODEL_NODE_NUM;
+		p_size->depth		= ACTIVITY_MODEL_DEPTH;
+	}
+}
+
+/**
+ * @brief 窓の集計をクリアする (ゼロ交差の基準は残す)
+ * @param None
+ * @retval None
+ */
+static void activity_window_clear( void )
+{
+	ACTIVITY_STATE *p_st = &g_activity;
+
+	memset( p_st->sum, 0, sizeof( p_st->sum ) );
+	memset( p_st->sq_sum, 0, sizeof( p_st->sq_sum ) );
+	memset( p_st->sign, 0, sizeof( p_st->sign ) );
+	memset( p_st->zc, 0, sizeof( p_st->zc ) );
+	p_st->mag_sum			= 0.0f;
+	p_st->mag_sq_sum		= 0.0f;
+	p_st->gyro_sum			= 0.0f;
+	p_st->gyro_sq_sum		= 0.0f;
+	p_st->gyro_count		= 0;
+	p_st->peak_num			= 0;
+	p_st->peak_last			= 0;
+	p_st->peak_interval_sum	= 0;
+	p_st->count				= 0;
+	p_st->peak_armed		= true;
+}
+
+/**
+ * @brief 集計した窓から特徴量を算出する
+ * @param p_feature 特徴量 (ACT_FEAT_NUM個)
+ * @retval None
+ */
+static void activity_window_feature( int16_t *p_feature )
+{
+	const ACTIVITY_STATE *p_st = &g_activity;
+	const int64_t num = p_st->count;
+	int64_t shift;
+	int64_t var;
+	float mean;
+	uint8_t i;
+
+	for ( i = 0; i < ACTIVITY_AXIS_NUM; i++ )
+	{
+		p_feature[ACT_FEAT_X_MEAN + i] = (int16_t)( p_st->sum[i] / (int32_t)num );
+		/* Σ(x - ref)^2 - (Σ(x - ref))^2 / N を整数のまま計算する */
+		shift = (int64_t)p_st->sum[i] - ( num * p_st->ref[i] );
+		var = ( ( p_st->sq_sum[i] * num ) - ( shift * shift ) ) / ( num * num );
+		p_feature[ACT_FEAT_X_SD + i] = activity_sat16( sqrtf( (float)var ) );
+		p_feature[ACT_FEAT_X_ZC + i] = p_st->zc[i];
+	}
+
+	mean = p_st->mag_sum / (float)num;
+	p_feature[ACT_FEAT_MAG_SD]	= activity_sat16( sqrtf( fmaxf( ( p_st->mag_sq_sum / (float)num ) - ( mean * mean ), 0.0f ) ) );
+	p_feature[ACT_FEAT_ENERGY]	= activity_sat16( sqrtf( p_st->mag_sq_sum / (float)num ) );
+
+	p_feature[ACT_FEAT_PEAK_NUM]		= (int16_t)p_st->peak_num;
+	p_feature[ACT_FEAT_PEAK_INTERVAL]	= ( p_st->peak_num >= 2 ) ? (int16_t)( p_st->peak_interval_sum / ( p_st->peak_num - 1 ) ) : 0;
+
+	p_feature[ACT_FEAT_GYRO_SD] = 0;
+	if ( p_st->gyro_count > 1 )
+	{
+		mean = p_st->gyro_sum / (float)p_st->gyro_count;
+		p_feature[ACT_FEAT_GYRO_SD] = activity_sat16( sqrtf( fmaxf( ( p_st->gyro_sq_sum / (float)p_st->gyro_count ) - ( mean * mean ), 0.0f ) ) );
+	}
+}
+
+/**
+ * @brief int16に丸めて飽和する
+ * @param value 値
+ * @retval int16の値
+ */
+static int16_t activity_sat16( float value )
+{
+	if ( value >= (float)INT16_MAX )
+	{
+		return INT16_MAX;
+	}
+	if ( value <= (float)INT16_MIN )
+	{
+		return INT16_MIN;
+	}
+
+	return (int16_t)lrintf( value );
+}
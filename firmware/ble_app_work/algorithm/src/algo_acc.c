@@ -10,14 +10,16 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/25       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Sleep区間をEnergy Profilerに通知
+  * 1.2            2026/10/19       k.tashiro         GPIO (ACC/RTC割込み) をlib_halに変更
   ******************************************************************************************
 */
 
 /* Includes --------------------------------------------------------------*/
 #include "nordic_common.h"
-#include "nrf_gpio.h"
-#include "nrfx_gpiote.h"
 #include "lib_common.h"
+#include "lib_hal.h"
+#include "pin_config.h"
 #include "state_control.h"
 #include "mode_manager.h"
 #include "lib_ram_retain.h"
@@ -31,6 +33,7 @@
 #include "algo_acc.h"
 #include "lib_wdt.h"
 #include "lib_trace_log.h"
+#include "lib_energy_prof.h"
 
 /* Definition ------------------------------------------------------------*/
 #define WALKUP_ACC_VALUE    (int16_t)3000
@@ -56,7 +59,9 @@ void EnterSleep(void)
 	/* 2022.04.07 Add FPU Disable -- */
 	
 	PreSleepUart();
+	EnergyProfSleepEnter();		/* 2026.10.19 Add */
 	err_code = sd_app_evt_wait();
+	EnergyProfSleepExit();		/* 2026.10.19 Add */
 	WakeUpUart();
 	LIB_ERR_CHECK(err_code, SLEEP_ERROR, __LINE__);
 }
@@ -82,8 +87,10 @@ uint32_t EnterDeepSleep(PEVT_ST pEvent)
 	//nrfx_gpiote_in_event_disable(RTC_INT_PIN);
 	//ex_device_err = ExRtcAlarmDisableClear(UTC_SUCCESS);
 	/* 2022.05.16 Delete 自動接続対応 -- */
-	nrfx_gpiote_in_event_disable(ACC_INT1_PIN);
-	nrfx_gpiote_in_event_disable(ACC_INT2_PIN);
+	/* 2026.10.19 Modify lib_hal ++ */
+	HalGpioIntDisable(ACC_INT1_PIN);
+	HalGpioIntDisable(ACC_INT2_PIN);
+	/* 2026.10.19 Modify lib_hal -- */
 	GpioteLatchClear();
 	/* 2022.05.16 Add 自動接続対応 ++ */
 	ex_device_err  = ExRtcWakeUpSetting();
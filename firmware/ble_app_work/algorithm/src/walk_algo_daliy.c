@@ -10,6 +10,9 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/25       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Sample毎のLogをToken Logに変更
+  * 1.2            2026/10/19       k.tashiro         Mode定義をwalk_algo.hに移動, Tableのずらし処理をmemmoveに変更
+  * 1.3            2026/10/19       k.tashiro         Z軸coeffの未初期化警告を修正
   ******************************************************************************************
 */
 
@@ -17,20 +20,12 @@
 #include "walk_algo.h"
 #include "lib_common.h"
 #include "lib_combsort.h"
+#include "lib_token_log.h"
 
 /* Definition ------------------------------------------------------------*/
 #define POINTBOX			30
 
-#define DAILY				0			//Acc Y data
-#define TAP					1			//not use
-#define RADDER				2			//not use
-#define START_REACTION		3			//Acc Y data
-#define JUMP				4			//not use
-#define SKYJUMP				5			//Acc Z data
-#define SPEED_RAC			6			//not use
-#define TELEPORTATION		7			//Acc Y data
-#define SIDEAGILITY			8			//Acc Z data
-#define DASH10				9			//not use
+/* 2026.10.19 Modify Mode定義はwalk_algo.hに移動 */
 
 /* Private variables -----------------------------------------------------*/
 static STORAGE g_storage[STRAGE2SEC];
@@ -139,7 +134,7 @@ int8_t GetWalkResult(short XData, short ZData, unsigned short SID,short Mode, sh
 			return ALGO_DATACHARGE;
 		}
 	}else{
-		memcpy(&g_MedianTable[0],&g_MedianTable[1],sizeof(AVRAXES3)*(MEDIAN_NUM - 1));
+		memmove(&g_MedianTable[0],&g_MedianTable[1],sizeof(AVRAXES3)*(MEDIAN_NUM - 1));	/* 2026.10.19 Modify 領域が重なるためmemmove */
 		g_MedianTable[MEDIAN_NUM - 1].sAccData = tmpAccdata;
 		g_MedianTable[MEDIAN_NUM - 1].sid = SID;
 		MedianFilter(&g_MedianTable[0], &g_MedianResult);
@@ -157,7 +152,7 @@ int8_t GetWalkResult(short XData, short ZData, unsigned short SID,short Mode, sh
 			return ALGO_DATACHARGE;
 		}
 	}else{
-		memcpy(&g_MavrTable[0], &g_MavrTable[1], (sizeof(AVRAXES3) * (AVRDIM - 1)));
+		memmove(&g_MavrTable[0], &g_MavrTable[1], (sizeof(AVRAXES3) * (AVRDIM - 1)));	/* 2026.10.19 Modify 領域が重なるためmemmove */
 		g_MavrTable[AVRDIM-1].sAccData = g_MedianResult.sAccData;
 		g_MavrTable[AVRDIM-1].sid = g_MedianResult.sid;
 		AvrSGFilter(&g_MavrTable[0],&g_fMavrTable);
@@ -169,11 +164,11 @@ int8_t GetWalkResult(short XData, short ZData, unsigned short SID,short Mode, sh
 		if(g_iStrage2secSampleflag == 0){
 			if(Mode == TELEPORTATION)
 			{
-				DEBUG_LOG(LOG_INFO,"telep %u, afacc %d, acc %d",g_fMavrTable.sid,(int)g_fMavrTable.fAccData, tmpAccdata);
+				TOKEN_LOG3( TL_WALK_TELEP_SAMPLE, g_fMavrTable.sid, (int)g_fMavrTable.fAccData, tmpAccdata );	/* 2026.10.19 Modify Token Log */
 			}
 			else if(Mode == SIDEAGILITY)
 			{
-				DEBUG_LOG(LOG_INFO,"side  %u, afacc %d, acc %d",g_fMavrTable.sid,(int)g_fMavrTable.fAccData, tmpAccdata);
+				TOKEN_LOG3( TL_WALK_SIDE_SAMPLE, g_fMavrTable.sid, (int)g_fMavrTable.fAccData, tmpAccdata );	/* 2026.10.19 Modify Token Log */
 			}
 			/*debug*/
 			else if(Mode == DAILY)
@@ -182,13 +177,13 @@ int8_t GetWalkResult(short XData, short ZData, unsigned short SID,short Mode, sh
 				/*debug*/
 				if(gDaily_display == (uint8_t)0)
 				{
-					DEBUG_LOG(LOG_INFO,"daily  %u, afacc %d, acc %d",g_fMavrTable.sid,(int)g_fMavrTable.fAccData, tmpAccdata);
+					TOKEN_LOG3( TL_WALK_DAILY_SAMPLE, g_fMavrTable.sid, (int)g_fMavrTable.fAccData, tmpAccdata );	/* 2026.10.19 Modify Token Log */
 				}
 #endif
 			}
 			else if(Mode != DAILY)
 			{
-				DEBUG_LOG(LOG_INFO,"mode %u, sid %u, afacc %d, acc %d",Mode,g_fMavrTable.sid,(int)g_fMavrTable.fAccData, tmpAccdata);
+				TOKEN_LOG4( TL_WALK_MODE_SAMPLE, Mode, g_fMavrTable.sid, (int)g_fMavrTable.fAccData, tmpAccdata );	/* 2026.10.19 Modify Token Log */
 			}
 			
 			g_istNoSamples = iAdd200Samples(&g_storage[0],g_fMavrTable.fAccData, g_fMavrTable.sid, g_istNoSamples);
@@ -203,11 +198,11 @@ int8_t GetWalkResult(short XData, short ZData, unsigned short SID,short Mode, sh
 		if((g_istNoSamples < STRAGE2SEC) && (g_iStrage2secSampleflag == 1)){	
 			if(Mode == TELEPORTATION)
 			{
-				DEBUG_LOG(LOG_INFO,"telep %u, afacc %d, acc %d",g_fMavrTable.sid,(int)g_fMavrTable.fAccData, tmpAccdata);
+				TOKEN_LOG3( TL_WALK_TELEP_SAMPLE, g_fMavrTable.sid, (int)g_fMavrTable.fAccData, tmpAccdata );	/* 2026.10.19 Modify Token Log */
 			}
 			else if(Mode == SIDEAGILITY)
 			{
-				DEBUG_LOG(LOG_INFO,"side  %u, afacc %d, acc %d",g_fMavrTable.sid,(int)g_fMavrTable.fAccData, tmpAccdata);
+				TOKEN_LOG3( TL_WALK_SIDE_SAMPLE, g_fMavrTable.sid, (int)g_fMavrTable.fAccData, tmpAccdata );	/* 2026.10.19 Modify Token Log */
 			}
 			/*debug*/
 			else if(Mode == DAILY)
@@ -216,14 +211,14 @@ int8_t GetWalkResult(short XData, short ZData, unsigned short SID,short Mode, sh
 				/*debug*/
 				if(gDaily_display == (uint8_t)0)
 				{
-					DEBUG_LOG(LOG_INFO,"daily  %u, afacc %d, acc %d",g_fMavrTable.sid,(int)g_fMavrTable.fAccData, tmpAccdata);
+					TOKEN_LOG3( TL_WALK_DAILY_SAMPLE, g_fMavrTable.sid, (int)g_fMavrTable.fAccData, tmpAccdata );	/* 2026.10.19 Modify Token Log */
 				}
 #endif
 			}
 
 			else if(Mode != DAILY)
 			{
-				DEBUG_LOG(LOG_INFO,"mode %u, sid %u, afacc %d, acc %d",Mode,g_fMavrTable.sid,(int)g_fMavrTable.fAccData, tmpAccdata);
+				TOKEN_LOG4( TL_WALK_MODE_SAMPLE, Mode, g_fMavrTable.sid, (int)g_fMavrTable.fAccData, tmpAccdata );	/* 2026.10.19 Modify Token Log */
 			}
 			
 			g_istNoSamples = iAdd200Samples(&g_storage[0],g_fMavrTable.fAccData, g_fMavrTable.sid, g_istNoSamples);
@@ -297,7 +292,7 @@ int8_t GetWalkResult(short XData, short ZData, unsigned short SID,short Mode, sh
 				if((Mode == JUMP)|| (Mode == SPEED_RAC) || (Mode == SKYJUMP)) {
 					low_coeff = HIGH_COEFF_LOW;
 					high_coeff = HIGH_COEFF_HIGH;
-				} else if(Mode == SIDEAGILITY) {
+				} else {	/* 2026.10.19 Modify ModeはSIDEAGILITYしか残らない (未初期化のcoeffを使わない) */
 					low_coeff = SIDE_COEFF_LOW;
 					high_coeff = SIDE_COEFF_HIGH;
 				}
@@ -597,7 +592,7 @@ int8_t GetWalkResult(short XData, short ZData, unsigned short SID,short Mode, sh
 	// 100 strage 1 sec
 	}else if((Mode == TAP) || (Mode == RADDER)){
 		if(g_iStrage2secSampleflag == 0){
-			DEBUG_LOG(LOG_INFO,"tap sid %u, afacc %d, acc %d",g_fMavrTable.sid,(int)g_fMavrTable.fAccData, tmpAccdata);
+			TOKEN_LOG3( TL_WALK_TAP_SAMPLE, g_fMavrTable.sid, (int)g_fMavrTable.fAccData, tmpAccdata );	/* 2026.10.19 Modify Token Log */
 			g_istNoSamples = iAdd200Samples(&g_storage[0],g_fMavrTable.fAccData, g_fMavrTable.sid,g_istNoSamples);
 			*currentsample = g_istNoSamples;	
 			if(g_istNoSamples == STRAGE1SEC){
@@ -607,7 +602,7 @@ int8_t GetWalkResult(short XData, short ZData, unsigned short SID,short Mode, sh
 			}
 		}
 		if((g_istNoSamples < STRAGE1SEC)&&(g_iStrage2secSampleflag == 1)){
-			DEBUG_LOG(LOG_INFO,"tap sid %u, afacc %d, acc %d",g_fMavrTable.sid,(int)g_fMavrTable.fAccData, tmpAccdata);
+			TOKEN_LOG3( TL_WALK_TAP_SAMPLE, g_fMavrTable.sid, (int)g_fMavrTable.fAccData, tmpAccdata );	/* 2026.10.19 Modify Token Log */
 			g_istNoSamples = iAdd200Samples(&g_storage[0],g_fMavrTable.fAccData, g_fMavrTable.sid, g_istNoSamples);
 			*currentsample = g_istNoSamples;
 		}
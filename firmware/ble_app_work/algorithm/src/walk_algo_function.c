@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/25       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         未初期化変数 (y_start, minuspeak, tmpPlus_i) を修正
   ******************************************************************************************
 */
 
@@ -1086,7 +1087,7 @@ short StartReacCheck(WALKPEAK walkpoint[],DAILYCOUNT walkcount,STORAGE ystorage[
 	short totalCount = 0;
 	short j;
 	unsigned short i;
-	unsigned short y_start;
+	unsigned short y_start = 0;		/* 2026.10.19 Modify plus_seqが見つからない場合は先頭から探す */
 	short start_time = 0;
 	//short old_start_time = 0;
 	float start_reac_pTh = 0;
@@ -1257,7 +1258,7 @@ short RadderForwardBackPtopCheck(WALKPEAK walkpoint[],PEAK Data[], PRELASTWALKPE
 {
 	PEAK prePlusPeak;
 	PEAK pluspeak;
-	PEAK minuspeak;
+	PEAK minuspeak = {0};		/* 2026.10.19 Modify flagの遷移によっては未設定のまま参照されるため0で初期化 */
 	float ptop_value;
 	short tmpMinusFlag = -1;
 	short tmpPlusFlag = -1;
@@ -1266,7 +1267,7 @@ short RadderForwardBackPtopCheck(WALKPEAK walkpoint[],PEAK Data[], PRELASTWALKPE
 	short radder_count = 0;
 	short outcount = 0;
 	unsigned short ptop_time;
-	unsigned short tmpPlus_i;
+	unsigned short tmpPlus_i = 0;		/* 2026.10.19 Modify minus peakから始まる場合の未初期化を修正 */
 	
 	for (short i = 0; i < count; i++) {
 		switch(flag) {
@@ -0,0 +1,149 @@
+/**
+  ******************************************************************************************
+  * @file    bench.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Microbenchmark (Host/Target共通)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*
+ * SDKに依存しない. 計測と出力だけをBENCH_PORTで切り替える
+ *   bench_posix.c : Linux   (clock_gettime, ns, 標準出力)
+ *   bench_nrf.c   : nRF52   (DWT CYCCNT, cycles, RTT)
+ * 入力Dataは整数演算だけで生成するため, Host/Targetで同じ値になる.
+ * 結果は1 Case 1行のJSON (JSON Lines) で出力し, tools/bench_compare.pyで比較する
+ */
+
+/* Definition ------------------------------------------------------------*/
+#define BENCH_SAMPLE_MAX			(64)		/* 1 Caseの計測回数の上限 */
+#define BENCH_SAMPLE_DEFAULT		(32)		/* 1 Caseの計測回数 (初期値) */
+#define BENCH_LINE_SIZE				(256)		/* 出力1行の最大Byte数 */
+
+#define BENCH_INPUT_NUM				(1024)		/* 入力波形のSample数 (100Hz) */
+#define BENCH_AXIS_X				(0)
+#define BENCH_AXIS_Y				(1)
+#define BENCH_AXIS_Z				(2)
+
+#ifndef BENCH_REV
+#define BENCH_REV					"unknown"	/* Source Revision (Makefileで指定) */
+#endif
+
+/* Typedef ---------------------------------------------------------------*/
+typedef void (*BENCH_SETUP)( uint32_t arg );
+typedef uint32_t (*BENCH_EXEC)( uint32_t arg, uint32_t iter );
+
+/* Struct ----------------------------------------------------------------*/
+/* 計測Case */
+typedef struct _bench_case
+{
+	const char *name;			/* Case名 (Suite内で一意) */
+	BENCH_SETUP setup;			/* 計測前の初期化 (NULL可) */
+	BENCH_EXEC exec;			/* 計測対象を1回呼び出す. 戻り値は結果のDigest */
+	uint32_t arg;				/* setup/execに渡す値 (Modeなど) */
+	uint16_t batch;				/* 1 Sampleで呼び出す回数 (計測の分解能が足りない処理用) */
+} BENCH_CASE, *PBENCH_CASE;
+
+/* Suite (Applicationごと) */
+typedef struct _bench_suite
+{
+	const char *name;
+	const BENCH_CASE *p_case;
+	uint16_t num;
+} BENCH_SUITE, *PBENCH_SUITE;
+
+/* 実行環境 */
+typedef struct _bench_port
+{
+	const char *target;						/* 実行環境名 */
+	const char *unit;						/* 計測単位 */
+	uint32_t hz;							/* 1秒あたりの計測単位数 */
+	uint32_t (*now)( void );				/* 現在の計測値 (一周してよい) */
+	void (*output)( const char *p_line );	/* 1行出力 (改行込み) */
+} BENCH_PORT, *PBENCH_PORT;
+
+/* 実行Option */
+typedef struct _bench_option
+{
+	uint16_t samples;			/* 計測回数 (BENCH_SAMPLE_MAX以下) */
+	const char *p_filter;		/* Case名にこの文字列を含むものだけ実行 (NULL:全て) */
+} BENCH_OPTION, *PBENCH_OPTION;
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief Suiteを実行して結果を出力する (先頭にmeta行, 最後にdone行)
+ * @param p_port 実行環境
+ * @param p_suite Suiteの配列
+ * @param suite_num Suite数
+ * @param p_option 実行Option
+ * @retval 実行したCase数
+ */
+uint32_t BenchRun( const BENCH_PORT *p_port, const BENCH_SUITE * const *p_suite, uint8_t suite_num, const BENCH_OPTION *p_option );
+
+/**
+ * @brief 疑似乱数 (xorshift32)
+ * @param p_state 状態 (0以外)
+ * @retval 乱数
+ */
+uint32_t BenchRand( uint32_t *p_state );
+
+/**
+ * @brief 入力波形 (100Hz, 約1.8Hzの歩行 + Noise) [mg]
+ * @param idx Sample番号 (BENCH_INPUT_NUMで一周)
+ * @param axis BENCH_AXIS_X/Y/Z
+ * @retval 加速度 [mg]
+ */
+int16_t BenchInputAcc( uint32_t idx, uint8_t axis );
+
+/**
+ * @brief Digestの更新 (FNV-1a)
+ * @param digest 現在の値
+ * @param p_data Data
+ * @param len Byte数
+ * @retval 更新後の値
+ */
+uint32_t BenchDigest( uint32_t digest, const void *p_data, uint32_t len );
+
+/**
+ * @brief Badge (ble_app_work) のSuite
+ * @param None
+ * @retval Suite
+ */
+const BENCH_SUITE *BenchSuiteBadge( void );
+
+/**
+ * @brief Gateway (ble_app_gateway) のSuite
+ * @param None
+ * @retval Suite
+ */
+const BENCH_SUITE *BenchSuiteGateway( void );
+
+/**
+ * @brief Targetで実行する (DWT初期化, RTT出力). SoftDevice有効化前に呼ぶ
+ * @param p_suite Suite
+ * @retval None
+ */
+void BenchTargetRun( const BENCH_SUITE *p_suite );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,493 @@
+/**
+  ******************************************************************************************
+  * @file    bench_badge.c
+  * @author  k.tashiro
+  * @version 1.4
+  * @date    2026/10/19
+  * @brief   Microbenchmark Badge (ble_app_work) のCase
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         clac_acc_angleを静止/歩行の2 Caseに分ける
+  * 1.2            2026/10/19       k.tashiro         Activity ClassifierのCaseを追加
+  * 1.3            2026/10/19       k.tashiro         BccCreateのCaseを追加
+  * 1.4            2026/10/19       k.tashiro         calc_acc_rot_blockのCaseを削除 (calc_acc_rot_blockを削除したため)
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include <string.h>
+#include <stdarg.h>
+#include "bench.h"
+#include "walk_algo.h"
+#include "AccAngle.h"
+#include "activity_algo.h"
+#include "lib_combsort.h"
+#include "lib_bcc.h"
+#include "definition.h"
+#include "lib_icm42607_fifo.h"
+#include "lib_debug_uart.h"
+
+/* Definition ------------------------------------------------------------*/
+#define BENCH_WALK_PREFEED			(STRAGE2SEC + MEDIAN_NUM + AVRDIM)	/* GetWalkResultの事前投入Sample数 (判定が動き始めるまで) */
+#define BENCH_ANGLE_NUM				(200)		/* clac_acc_angleに投入する最大Sample数 (静止なら100 Sampleで算出する) */
+#define BENCH_ANGLE_STILL			(0)			/* 静止 (傾けて置いた状態) */
+#define BENCH_ANGLE_WALK			(1)			/* 歩行中 (全ての窓を捨てる) */
+#define BENCH_ANGLE_NOISE_MG		(8)			/* 静止時のNoise [mg] */
+#define BENCH_SORT_NUM				(STRAGE2SEC)
+#define BENCH_FIFO_NUM				(64)		/* FIFO Packet数 */
+#define BENCH_ROT_NUM				(64)		/* calc_acc_rotの入力数 */
+
+/* PeakPointDetect1Axisの閾値 (GetWalkResultと同じ係数. 歩行波形の振幅600mgに対して) */
+#define BENCH_PEAK_HIGH				(600.0f * HIGH_COEFF_HIGH)
+#define BENCH_PEAK_LOW				(600.0f * HIGH_COEFF_LOW)
+
+/* Private variables -----------------------------------------------------*/
+static AVRAXES3 g_bench_avr[BENCH_INPUT_NUM];
+static STORAGE g_bench_storage[BENCH_INPUT_NUM];
+static PEAK g_bench_peak[STRAGE2SEC];
+static float g_bench_sort_src[BENCH_INPUT_NUM];
+static float g_bench_sort[BENCH_SORT_NUM];
+static uint8_t g_bench_fifo[BENCH_FIFO_NUM][ACC_GYRO_FIFO_PACKET_SIZE];
+static ACC_BUF g_bench_rot_src[BENCH_ROT_NUM];
+static char g_bench_log[DEBUG_UART_BUFFER_SIZE];
+static uint8_t g_bench_raw[RAW_DATA_SIZE];
+static ACTIVITY_RESULT g_bench_activity;
+
+/* Private function prototypes -------------------------------------------*/
+static void setup_walk( uint32_t mode );
+static uint32_t exec_walk( uint32_t mode, uint32_t iter );
+static void setup_input( uint32_t axis );
+static uint32_t exec_median( uint32_t arg, uint32_t iter );
+static uint32_t exec_avr_sg( uint32_t arg, uint32_t iter );
+static uint32_t exec_comb_sort( uint32_t arg, uint32_t iter );
+static uint32_t exec_peak( uint32_t flag, uint32_t iter );
+static int16_t still_acc( uint32_t idx, uint8_t axis );
+static uint32_t exec_acc_angle( uint32_t input, uint32_t iter );
+static void setup_acc_rot( uint32_t arg );
+static uint32_t exec_acc_rot( uint32_t arg, uint32_t iter );
+static void setup_fifo( uint32_t mode );
+static uint32_t exec_fifo( uint32_t mode, uint32_t iter );
+static uint32_t exec_bcc( uint32_t arg, uint32_t iter );
+static uint32_t exec_debug_log( uint32_t arg, uint32_t iter );
+static void setup_activity( uint32_t arg );
+static uint32_t exec_activity( uint32_t arg, uint32_t iter );
+static uint32_t exec_activity_classify( uint32_t arg, uint32_t iter );
+static uint32_t debug_log_format( char *buffer, const char *format, ... );
+
+/* Case ------------------------------------------------------------------*/
+static const BENCH_CASE g_bench_badge_case[] =
+{
+	/* name							setup			exec			arg						batch */
+	{ "GetWalkResult/DAILY",			setup_walk,		exec_walk,		DAILY,					100 },
+	{ "GetWalkResult/TAP",				setup_walk,		exec_walk,		TAP,					100 },
+	{ "GetWalkResult/RADDER",			setup_walk,		exec_walk,		RADDER,					100 },
+	{ "GetWalkResult/START_REACTION",	setup_walk,		exec_walk,		START_REACTION,			100 },
+	{ "GetWalkResult/JUMP",				setup_walk,		exec_walk,		JUMP,					100 },
+	{ "GetWalkResult/SKYJUMP",			setup_walk,		exec_walk,		SKYJUMP,				100 },
+	{ "GetWalkResult/SPEED_RAC",		setup_walk,		exec_walk,		SPEED_RAC,				100 },
+	{ "GetWalkResult/TELEPORTATION",	setup_walk,		exec_walk,		TELEPORTATION,			100 },
+	{ "GetWalkResult/SIDEAGILITY",		setup_walk,		exec_walk,		SIDEAGILITY,			100 },
+	{ "GetWalkResult/DASH10",			setup_walk,		exec_walk,		DASH10,					100 },
+	{ "MedianFilter",					setup_input,	exec_median,	BENCH_AXIS_X,			100 },
+	{ "AvrSGFilter",					setup_input,	exec_avr_sg,	BENCH_AXIS_X,			100 },
+	{ "CombSort/200",					setup_input,	exec_comb_sort,	BENCH_AXIS_X,			10 },
+	{ "PeakPointDetect1Axis/x",			setup_input,	exec_peak,		PEAK_DETECT_X_AXIS,		10 },
+	{ "PeakPointDetect1Axis/z",			setup_input,	exec_peak,		PEAK_DETECT_Z_AXIS,		10 },
+	{ "clac_acc_angle/still",			NULL,			exec_acc_angle,	BENCH_ANGLE_STILL,		4 },
+	{ "clac_acc_angle/walk",			NULL,			exec_acc_angle,	BENCH_ANGLE_WALK,		4 },
+	{ "calc_acc_rot",					setup_acc_rot,	exec_acc_rot,	0,						100 },
+	{ "AccGyroFifoDecode/acc",			setup_fifo,		exec_fifo,		MODE_ACC_ONLY,			100 },
+	{ "AccGyroFifoDecode/both",			setup_fifo,		exec_fifo,		MODE_BOTH,				100 },
+	{ "BccCreate/RAW_DATA",				NULL,			exec_bcc,		0,						100 },
+	{ "DebugLogVFormat",				NULL,			exec_debug_log,	0,						10 },
+	{ "ActivityAddSample/200",			setup_activity,	exec_activity,	0,						4 },
+	{ "ActivityClassify",				setup_activity,	exec_activity_classify,	0,				100 },
+};
+
+static const BENCH_SUITE g_bench_badge_suite =
+{
+	"badge",
+	g_bench_badge_case,
+	sizeof( g_bench_badge_case ) / sizeof( g_bench_badge_case[0] ),
+};
+
+/**
+ * @brief Badge (ble_app_work) のSuite
+ * @param None
+ * @retval Suite
+ */
+const BENCH_SUITE *BenchSuiteBadge( void )
+{
+	return &g_bench_badge_suite;
+}
+
+/**
+ * @brief GetWalkResultの初期化 (判定が動き始めるまで事前に投入する)
+ * @param mode GetWalkResultのMode
+ * @retval None
+ */
+static void setup_walk( uint32_t mode )
+{
+	uint8_t pm[16];
+	short current = 0;
+	uint32_t i;
+
+	StorageReset();
+	for ( i = 0; i < BENCH_WALK_PREFEED; i++ )
+	{
+		(void)GetWalkResult( BenchInputAcc( i, BENCH_AXIS_X ), BenchInputAcc( i, BENCH_AXIS_Z ), (unsigned short)i, (short)mode, &current, pm );
+	}
+}
+
+/**
+ * @brief GetWalkResultを1 Sample分呼び出す (mode_manager.cと同じ呼び出し方)
+ * @param mode GetWalkResultのMode
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_walk( uint32_t mode, uint32_t iter )
+{
+	uint8_t pm[16] = { 0 };		/* DAILYCOUNT/ALTCOUNT/SKYJUMPCOUNTの最大Size以上 */
+	short current = 0;
+	uint32_t idx = BENCH_WALK_PREFEED + iter;
+	int8_t ret;
+	uint32_t digest;
+
+	ret = GetWalkResult( BenchInputAcc( idx, BENCH_AXIS_X ), BenchInputAcc( idx, BENCH_AXIS_Z ), (unsigned short)idx, (short)mode, &current, pm );
+	digest = BenchDigest( 0, &ret, sizeof( ret ) );
+	if ( ret == ALGO_SUCCESS )
+	{
+		digest = BenchDigest( digest, pm, sizeof( pm ) );
+	}
+
+	return digest;
+}
+
+/**
+ * @brief Filter/Sort/Peak検出の入力を作る
+ * @param axis 軸
+ * @retval None
+ */
+static void setup_input( uint32_t axis )
+{
+	uint32_t i;
+
+	for ( i = 0; i < BENCH_INPUT_NUM; i++ )
+	{
+		g_bench_avr[i].sAccData			= BenchInputAcc( i, (uint8_t)axis );
+		g_bench_avr[i].sid				= (unsigned short)i;
+		g_bench_storage[i].AccData		= (float)g_bench_avr[i].sAccData;
+		g_bench_storage[i].index		= (unsigned short)i;
+		g_bench_sort_src[i]				= (float)g_bench_avr[i].sAccData;
+	}
+}
+
+/**
+ * @brief MedianFilter (7 Sample)
+ * @param arg 未使用
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_median( uint32_t arg, uint32_t iter )
+{
+	AVRAXES3 result;
+
+	MedianFilter( &g_bench_avr[iter % ( BENCH_INPUT_NUM - MEDIAN_NUM )], &result );
+
+	return BenchDigest( BenchDigest( 0, &result.sAccData, sizeof( result.sAccData ) ), &result.sid, sizeof( result.sid ) );
+}
+
+/**
+ * @brief AvrSGFilter (AVRDIM Sampleの平均)
+ * @param arg 未使用
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_avr_sg( uint32_t arg, uint32_t iter )
+{
+	FAVRAXES3 result;
+
+	AvrSGFilter( &g_bench_avr[iter % ( BENCH_INPUT_NUM - AVRDIM )], &result );
+
+	return BenchDigest( BenchDigest( 0, &result.fAccData, sizeof( result.fAccData ) ), &result.sid, sizeof( result.sid ) );
+}
+
+/**
+ * @brief CombSort (2秒分. 入力のCopyを含む)
+ * @param arg 未使用
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_comb_sort( uint32_t arg, uint32_t iter )
+{
+	memcpy( g_bench_sort, &g_bench_sort_src[iter % ( BENCH_INPUT_NUM - BENCH_SORT_NUM )], sizeof( g_bench_sort ) );
+	CombSort( g_bench_sort, BENCH_SORT_NUM, COMB_SORT_ELEVEN );
+
+	return BenchDigest( 0, g_bench_sort, sizeof( g_bench_sort ) );
+}
+
+/**
+ * @brief PeakPointDetect1Axis (2秒分)
+ * @param flag PEAK_DETECT_X_AXIS/PEAK_DETECT_Z_AXIS
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_peak( uint32_t flag, uint32_t iter )
+{
+	THRESHOLD threshold;
+	short count;
+	short i;
+	uint32_t digest;
+
+	threshold.xp_high	= BENCH_PEAK_HIGH;
+	threshold.xp_low	= BENCH_PEAK_LOW;
+	threshold.xn_high	= -BENCH_PEAK_LOW;
+	threshold.xn_low	= -BENCH_PEAK_HIGH;
+	threshold.zp_high	= BENCH_PEAK_HIGH / 2;
+	threshold.zp_low	= BENCH_PEAK_LOW / 2;
+	threshold.zn_high	= -BENCH_PEAK_LOW / 2;
+	threshold.zn_low	= -BENCH_PEAK_HIGH / 2;
+
+	count = PeakPointDetect1Axis( &g_bench_storage[iter % ( BENCH_INPUT_NUM - STRAGE2SEC )], g_bench_peak, (short)flag, threshold, STRAGE2SEC );
+	digest = BenchDigest( 0, &count, sizeof( count ) );
+	for ( i = 0; i < count; i++ )
+	{
+		digest = BenchDigest( digest, &g_bench_peak[i].peak, sizeof( g_bench_peak[i].peak ) );
+		digest = BenchDigest( digest, &g_bench_peak[i].indexnum, sizeof( g_bench_peak[i].indexnum ) );
+	}
+
+	return digest;
+}
+
+/**
+ * @brief 傾けて置いた状態の加速度 (Roll約-77deg, Pitch約9deg + Noise)
+ * @param idx Sample番号
+ * @param axis BENCH_AXIS_X/Y/Z
+ * @retval 加速度 [mg]
+ */
+static int16_t still_acc( uint32_t idx, uint8_t axis )
+{
+	static const int16_t pose[3] = { -150, -960, 230 };
+	uint32_t state = ( idx * 3 ) + axis + 1;
+
+	return (int16_t)( pose[axis] + (int32_t)( BenchRand( &state ) % ( ( BENCH_ANGLE_NOISE_MG * 2 ) + 1 ) ) - BENCH_ANGLE_NOISE_MG );
+}
+
+/**
+ * @brief clac_acc_angle (取付角度の算出1回分. 算出できるまでSampleを投入し回転行列を算出する)
+ * @param input BENCH_ANGLE_STILL: 静止, BENCH_ANGLE_WALK: 歩行 (BENCH_ANGLE_NUM Sample投入しても算出しない)
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_acc_angle( uint32_t input, uint32_t iter )
+{
+	ACC_ANGLE angle;
+	uint32_t ret = NRF_ERROR_INVALID_DATA;
+	uint32_t idx;
+	uint32_t i;
+
+	memset( &angle, 0, sizeof( angle ) );
+	clear_acc_buf();
+	for ( i = 0; ( i < BENCH_ANGLE_NUM ) && ( ret != NRF_SUCCESS ); i++ )
+	{
+		idx = ( iter * BENCH_ANGLE_NUM ) + i;
+		if ( input == BENCH_ANGLE_STILL )
+		{
+			ret = clac_acc_angle( still_acc( idx, BENCH_AXIS_X ), still_acc( idx, BENCH_AXIS_Y ), still_acc( idx, BENCH_AXIS_Z ), &angle );
+		}
+		else
+		{
+			ret = clac_acc_angle( BenchInputAcc( idx, BENCH_AXIS_X ), BenchInputAcc( idx, BENCH_AXIS_Y ), BenchInputAcc( idx, BENCH_AXIS_Z ), &angle );
+		}
+	}
+
+	return BenchDigest( BenchDigest( BenchDigest( 0, &ret, sizeof( ret ) ), &angle.roll, sizeof( angle.roll ) ), &angle.pitch, sizeof( angle.pitch ) );
+}
+
+/**
+ * @brief calc_acc_rotの初期化 (回転行列を算出し, 入力を作っておく)
+ * @param arg 未使用
+ * @retval None
+ */
+static void setup_acc_rot( uint32_t arg )
+{
+	uint32_t i;
+
+	(void)exec_acc_angle( BENCH_ANGLE_STILL, 0 );
+	for ( i = 0; i < BENCH_ROT_NUM; i++ )
+	{
+		g_bench_rot_src[i].x = BenchInputAcc( i, BENCH_AXIS_X );
+		g_bench_rot_src[i].y = BenchInputAcc( i, BENCH_AXIS_Y );
+		g_bench_rot_src[i].z = BenchInputAcc( i, BENCH_AXIS_Z );
+	}
+}
+
+/**
+ * @brief calc_acc_rot (1 Sample分の取付角度補正)
+ * @param arg 未使用
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_acc_rot( uint32_t arg, uint32_t iter )
+{
+	const ACC_BUF *p_in = &g_bench_rot_src[iter % BENCH_ROT_NUM];
+	ACC_RESULT result;
+
+	calc_acc_rot( p_in->x, p_in->y, p_in->z, &result );
+
+	return BenchDigest( 0, &result, sizeof( result ) );
+}
+
+/**
+ * @brief FIFO Packetを作る (lib_icm42607.cが読み出すLayout)
+ * @param mode 動作モード
+ * @retval None
+ */
+static void setup_fifo( uint32_t mode )
+{
+	int16_t value[6];
+	uint32_t i;
+	uint8_t j;
+
+	for ( i = 0; i < BENCH_FIFO_NUM; i++ )
+	{
+		value[0] = BenchInputAcc( i, BENCH_AXIS_X );
+		value[1] = BenchInputAcc( i, BENCH_AXIS_Y );
+		value[2] = BenchInputAcc( i, BENCH_AXIS_Z );
+		value[3] = ( mode == MODE_BOTH ) ? value[2] : GYRO_INVALID_DATA;
+		value[4] = ( mode == MODE_BOTH ) ? value[0] : GYRO_INVALID_DATA;
+		value[5] = ( mode == MODE_BOTH ) ? value[1] : GYRO_INVALID_DATA;
+
+		g_bench_fifo[i][0] = ( mode == MODE_BOTH ) ? HEADER_ACC_GYRO : HEADER_ACC_DATA;
+		for ( j = 0; j < 6; j++ )
+		{
+			g_bench_fifo[i][1 + ( j * 2 )] = (uint8_t)( value[j] & 0xFF );
+			g_bench_fifo[i][2 + ( j * 2 )] = (uint8_t)( ( (uint16_t)value[j] >> 8 ) & 0xFF );
+		}
+		g_bench_fifo[i][13] = 25;
+		g_bench_fifo[i][14] = (uint8_t)( i & 0xFF );
+		g_bench_fifo[i][15] = (uint8_t)( ( i >> 8 ) & 0xFF );
+	}
+}
+
+/**
+ * @brief AccGyroFifoDecode (1 Packet分)
+ * @param mode 動作モード
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_fifo( uint32_t mode, uint32_t iter )
+{
+	ACC_GYRO_DATA_INFO info;
+	uint32_t ret;
+	uint32_t digest;
+
+	ret = AccGyroFifoDecode( g_bench_fifo[iter % BENCH_FIFO_NUM], (uint8_t)mode, &info );
+	digest = BenchDigest( 0, &ret, sizeof( ret ) );
+	digest = BenchDigest( digest, &info.acc_x_data, sizeof( int16_t ) * 6 );
+	digest = BenchDigest( digest, &info.timestamp, sizeof( info.timestamp ) );
+
+	return digest;
+}
+
+/**
+ * @brief BccCreate (Raw Data 1 Packet分. 送信データの作成を含む)
+ * @param arg 未使用
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_bcc( uint32_t arg, uint32_t iter )
+{
+	uint32_t i;
+
+	for ( i = 0; i < ( RAW_DATA_SIZE - 1 ); i++ )
+	{
+		g_bench_raw[i] = (uint8_t)BenchInputAcc( ( iter * RAW_DATA_SIZE ) + i, (uint8_t)( i % 3 ) );
+	}
+	g_bench_raw[RAW_DATA_SIZE - 1] = BccCreate( g_bench_raw, RAW_DATA_SIZE - 1 );
+
+	return BenchDigest( 0, g_bench_raw, RAW_DATA_SIZE );
+}
+
+/**
+ * @brief DebugLogの書式化 (DEBUG_LOGと同じ書式. UART出力は含まない)
+ * @param arg 未使用
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_debug_log( uint32_t arg, uint32_t iter )
+{
+	uint32_t len;
+
+	len = debug_log_format( g_bench_log, "[%s:%d] pHigh th %d, pLow th %d, nHigh th %d, nLow th %d, sid 0x%X%s",
+							"GetWalkResult", 274, (int)BENCH_PEAK_HIGH, (int)BENCH_PEAK_LOW, -(int)BENCH_PEAK_LOW, -(int)BENCH_PEAK_HIGH, iter, "" );
+
+	return BenchDigest( 0, g_bench_log, len );
+}
+
+/**
+ * @brief DebugLogVFormatを可変引数で呼び出す
+ * @param buffer 格納先
+ * @param format Specify format
+ * @retval 書式化したByte数
+ */
+static uint32_t debug_log_format( char *buffer, const char *format, ... )
+{
+	va_list va;
+	uint32_t len;
+
+	va_start( va, format );
+	len = DebugLogVFormat( LOG_INFO, buffer, format, va );
+	va_end( va );
+
+	return len;
+}
+
+/**
+ * @brief Activity Classifierの初期化 (ActivityClassify用に1窓分の特徴量を作っておく)
+ * @param arg 未使用
+ * @retval None
+ */
+static void setup_activity( uint32_t arg )
+{
+	(void)exec_activity( 0, 0 );
+}
+
+/**
+ * @brief ActivityAddSample (1窓 = 2s分の投入と判定. 窓1個あたりのCycle数)
+ * @param arg 未使用
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_activity( uint32_t arg, uint32_t iter )
+{
+	uint32_t idx;
+	uint32_t i;
+	int8_t ret = ALGO_ERROR;
+
+	ActivityReset();
+	for ( i = 0; i < ACTIVITY_WINDOW; i++ )
+	{
+		idx = ( iter * ACTIVITY_WINDOW ) + i;
+		ret = ActivityAddSample( BenchInputAcc( idx, BENCH_AXIS_X ), BenchInputAcc( idx, BENCH_AXIS_Y ), BenchInputAcc( idx, BENCH_AXIS_Z ), NULL, &g_bench_activity );
+	}
+
+	return BenchDigest( BenchDigest( BenchDigest( 0, &ret, sizeof( ret ) ), g_bench_activity.feature, sizeof( g_bench_activity.feature ) ),
+						&g_bench_activity.class_id, sizeof( g_bench_activity.class_id ) );
+}
+
+/**
+ * @brief ActivityClassify (決定木の判定1回)
+ * @param arg 未使用
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_activity_classify( uint32_t arg, uint32_t iter )
+{
+	uint8_t class_id = ActivityClassify( g_bench_activity.feature );
+
+	return BenchDigest( 0, &class_id, sizeof( class_id ) );
+}
@@ -0,0 +1,339 @@
+/**
+  ******************************************************************************************
+  * @file    bench_core.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Microbenchmark (計測, 集計, 入力Data生成)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+
+/* Definition ------------------------------------------------------------*/
+#define BENCH_OVERHEAD_LOOP			(16)		/* 計測Overhead算出の回数 */
+#define BENCH_DIGEST_INIT			(0x811C9DC5U)
+#define BENCH_DIGEST_PRIME			(0x01000193U)
+
+/* 入力波形 */
+#define BENCH_WALK_PERIOD			(56)		/* 歩行の周期 [sample] (約1.8Hz) */
+#define BENCH_RUN_PERIOD			(36)		/* 走行の周期 [sample] (約2.8Hz) */
+#define BENCH_RUN_START				(512)		/* 走行区間 [sample] */
+#define BENCH_RUN_END				(768)
+#define BENCH_NOISE_MG				(32)		/* Noise振幅 [mg] */
+
+/* Struct ----------------------------------------------------------------*/
+/* 1 Caseの集計結果 */
+typedef struct _bench_result
+{
+	uint32_t min;
+	uint32_t median;
+	uint32_t mean;
+	uint32_t max;
+	uint32_t check;
+} BENCH_RESULT;
+
+/* Private variables -----------------------------------------------------*/
+static uint32_t g_bench_sample[BENCH_SAMPLE_MAX];
+static char g_bench_line[BENCH_LINE_SIZE];
+
+/* Private function prototypes -------------------------------------------*/
+static uint32_t bench_overhead( const BENCH_PORT *p_port );
+static void bench_sort( uint32_t *p_value, uint16_t num );
+static void bench_case_run( const BENCH_PORT *p_port, const BENCH_CASE *p_case, uint16_t samples, uint32_t overhead, BENCH_RESULT *p_result );
+static int16_t bench_wave( uint32_t phase, uint32_t period, int16_t amplitude );
+static uint32_t bench_hash( uint32_t value );
+
+/**
+ * @brief Suiteを実行して結果を出力する (先頭にmeta行, 最後にdone行)
+ * @param p_port 実行環境
+ * @param p_suite Suiteの配列
+ * @param suite_num Suite数
+ * @param p_option 実行Option
+ * @retval 実行したCase数
+ */
+uint32_t BenchRun( const BENCH_PORT *p_port, const BENCH_SUITE * const *p_suite, uint8_t suite_num, const BENCH_OPTION *p_option )
+{
+	BENCH_RESULT result;
+	const BENCH_CASE *p_case;
+	uint32_t overhead;
+	uint32_t count = 0;
+	uint16_t samples;
+	uint8_t s;
+	uint16_t c;
+
+	if ( ( p_port == NULL ) || ( p_suite == NULL ) || ( p_option == NULL ) )
+	{
+		return 0;
+	}
+
+	samples = p_option->samples;
+	if ( ( samples == 0 ) || ( samples > BENCH_SAMPLE_MAX ) )
+	{
+		samples = BENCH_SAMPLE_DEFAULT;
+	}
+
+	/* now()を2回呼ぶだけの時間は各Sampleから差し引く */
+	overhead = bench_overhead( p_port );
+	snprintf( g_bench_line, sizeof( g_bench_line ),
+			  "{\"meta\":\"start\",\"target\":\"%s\",\"unit\":\"%s\",\"hz\":%lu,\"rev\":\"%s\",\"samples\":%u,\"overhead\":%lu}\n",
+			  p_port->target, p_port->unit, (unsigned long)p_port->hz, BENCH_REV, samples, (unsigned long)overhead );
+	p_port->output( g_bench_line );
+
+	for ( s = 0; s < suite_num; s++ )
+	{
+		for ( c = 0; c < p_suite[s]->num; c++ )
+		{
+			p_case = &p_suite[s]->p_case[c];
+			if ( ( p_option->p_filter != NULL ) && ( strstr( p_case->name, p_option->p_filter ) == NULL ) )
+			{
+				continue;
+			}
+
+			bench_case_run( p_port, p_case, samples, overhead, &result );
+			snprintf( g_bench_line, sizeof( g_bench_line ),
+					  "{\"suite\":\"%s\",\"case\":\"%s\",\"target\":\"%s\",\"unit\":\"%s\",\"batch\":%u,\"samples\":%u,"
+					  "\"min\":%lu,\"median\":%lu,\"mean\":%lu,\"max\":%lu,\"check\":\"%08lx\"}\n",
+					  p_suite[s]->name, p_case->name, p_port->target, p_port->unit, p_case->batch, samples,
+					  (unsigned long)result.min, (unsigned long)result.median, (unsigned long)result.mean,
+					  (unsigned long)result.max, (unsigned long)result.check );
+			p_port->output( g_bench_line );
+			count++;
+		}
+	}
+
+	snprintf( g_bench_line, sizeof( g_bench_line ), "{\"meta\":\"done\",\"cases\":%lu}\n", (unsigned long)count );
+	p_port->output( g_bench_line );
+
+	return count;
+}
+
+/**
+ * @brief 疑似乱数 (xorshift32)
+ * @param p_state 状態 (0以外)
+ * @retval 乱数
+ */
+uint32_t BenchRand( uint32_t *p_state )
+{
+	uint32_t x = *p_state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*p_state = x;
+
+	return x;
+}
+
+/**
+ * @brief 入力波形 (100Hz, 約1.8Hzの歩行 + Noise) [mg]
+ * @param idx Sample番号 (BENCH_INPUT_NUMで一周)
+ * @param axis BENCH_AXIS_X/Y/Z
+ * @retval 加速度 [mg]
+ */
+int16_t BenchInputAcc( uint32_t idx, uint8_t axis )
+{
+	uint32_t period = BENCH_WALK_PERIOD;
+	int16_t amplitude = 600;
+	int32_t value;
+	int32_t noise;
+
+	idx %= BENCH_INPUT_NUM;
+	if ( ( idx >= BENCH_RUN_START ) && ( idx < BENCH_RUN_END ) )
+	{
+		/* 走行区間は周期が短く振幅が大きい */
+		period = BENCH_RUN_PERIOD;
+		amplitude = 1400;
+	}
+
+	switch ( axis )
+	{
+	case BENCH_AXIS_X:		/* 前後 */
+		value = bench_wave( idx, period, amplitude );
+		break;
+	case BENCH_AXIS_Y:		/* 上下 (重力 + 着地) */
+		value = -1000 + bench_wave( idx + ( period / 4 ), period, amplitude + ( amplitude / 2 ) );
+		break;
+	default:				/* 左右 (歩行の半分の周期) */
+		value = bench_wave( idx, period * 2, amplitude / 2 );
+		break;
+	}
+
+	noise = (int32_t)( bench_hash( ( idx * 3 ) + axis ) % ( ( BENCH_NOISE_MG * 2 ) + 1 ) ) - BENCH_NOISE_MG;
+
+	return (int16_t)( value + noise );
+}
+
+/**
+ * @brief Digestの更新 (FNV-1a)
+ * @param digest 現在の値
+ * @param p_data Data
+ * @param len Byte数
+ * @retval 更新後の値
+ */
+uint32_t BenchDigest( uint32_t digest, const void *p_data, uint32_t len )
+{
+	const uint8_t *p_byte = (const uint8_t *)p_data;
+	uint32_t i;
+
+	for ( i = 0; i < len; i++ )
+	{
+		digest ^= p_byte[i];
+		digest *= BENCH_DIGEST_PRIME;
+	}
+
+	return digest;
+}
+
+/**
+ * @brief 計測Overhead (now()を2回呼ぶ時間の最小値)
+ * @param p_port 実行環境
+ * @retval Overhead
+ */
+static uint32_t bench_overhead( const BENCH_PORT *p_port )
+{
+	uint32_t min = UINT32_MAX;
+	uint32_t start;
+	uint32_t elapsed;
+	uint8_t i;
+
+	for ( i = 0; i < BENCH_OVERHEAD_LOOP; i++ )
+	{
+		start = p_port->now();
+		elapsed = p_port->now() - start;
+		if ( elapsed < min )
+		{
+			min = elapsed;
+		}
+	}
+
+	return min;
+}
+
+/**
+ * @brief 昇順に並べる (挿入Sort, BENCH_SAMPLE_MAX個程度)
+ * @param p_value 配列
+ * @param num 要素数
+ * @retval None
+ */
+static void bench_sort( uint32_t *p_value, uint16_t num )
+{
+	uint32_t value;
+	uint16_t i;
+	uint16_t j;
+
+	for ( i = 1; i < num; i++ )
+	{
+		value = p_value[i];
+		for ( j = i; ( j > 0 ) && ( p_value[j - 1] > value ); j-- )
+		{
+			p_value[j] = p_value[j - 1];
+		}
+		p_value[j] = value;
+	}
+}
+
+/**
+ * @brief 1 Caseを計測する
+ * @param p_port 実行環境
+ * @param p_case Case
+ * @param samples 計測回数
+ * @param overhead 計測Overhead
+ * @param p_result 集計結果 (1回の呼び出しあたり)
+ * @retval None
+ */
+static void bench_case_run( const BENCH_PORT *p_port, const BENCH_CASE *p_case, uint16_t samples, uint32_t overhead, BENCH_RESULT *p_result )
+{
+	uint16_t batch = ( p_case->batch == 0 ) ? 1 : p_case->batch;
+	volatile uint32_t sink = 0;
+	uint64_t total = 0;
+	uint32_t iter = 0;
+	uint32_t digest = BENCH_DIGEST_INIT;
+	uint32_t start;
+	uint32_t elapsed;
+	uint32_t value;
+	uint16_t s;
+	uint16_t b;
+
+	if ( p_case->setup != NULL )
+	{
+		p_case->setup( p_case->arg );
+	}
+
+	/* 最初の1 Batchは計測しない (Cache/分岐予測のWarm Up). 結果のDigestはここで取る */
+	for ( b = 0; b < batch; b++ )
+	{
+		value = p_case->exec( p_case->arg, iter++ );
+		digest = BenchDigest( digest, &value, sizeof( value ) );
+	}
+	p_result->check = digest;
+
+	for ( s = 0; s < samples; s++ )
+	{
+		start = p_port->now();
+		for ( b = 0; b < batch; b++ )
+		{
+			sink += p_case->exec( p_case->arg, iter++ );
+		}
+		elapsed = p_port->now() - start;
+		elapsed = ( elapsed > overhead ) ? ( elapsed - overhead ) : 0;
+		g_bench_sample[s] = ( elapsed + ( batch / 2 ) ) / batch;
+		total += g_bench_sample[s];
+	}
+	(void)sink;
+
+	bench_sort( g_bench_sample, samples );
+	p_result->min		= g_bench_sample[0];
+	p_result->median	= g_bench_sample[samples / 2];
+	p_result->max		= g_bench_sample[samples - 1];
+	p_result->mean		= (uint32_t)( ( total + ( samples / 2 ) ) / samples );
+}
+
+/**
+ * @brief 正弦波の近似 (放物線, 整数演算)
+ * @param phase 位相 [sample]
+ * @param period 周期 [sample]
+ * @param amplitude 振幅
+ * @retval 値
+ */
+static int16_t bench_wave( uint32_t phase, uint32_t period, int16_t amplitude )
+{
+	int32_t half = (int32_t)( period / 2 );
+	int32_t p = (int32_t)( phase % period );
+	int32_t sign = 1;
+	int32_t value;
+
+	if ( p >= half )
+	{
+		p -= half;
+		sign = -1;
+	}
+	/* 4 * p * (half - p) / half^2 は 0 - 1 */
+	value = ( 4 * amplitude * p * ( half - p ) ) / ( half * half );
+
+	return (int16_t)( sign * value );
+}
+
+/**
+ * @brief 整数Hash (Noise生成用)
+ * @param value 値
+ * @retval Hash
+ */
+static uint32_t bench_hash( uint32_t value )
+{
+	value ^= value >> 16;
+	value *= 0x7FEB352DU;
+	value ^= value >> 15;
+	value *= 0x846CA68BU;
+	value ^= value >> 16;
+
+	return value;
+}
@@ -0,0 +1,152 @@
+/**
+  ******************************************************************************************
+  * @file    bench_gateway.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Microbenchmark Gateway (ble_app_gateway) のCase
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include <string.h>
+#include "bench.h"
+#include "bleadv_packet.h"
+#include "bleadv_manufacturer.h"
+#include "bleadv_formater.h"
+
+/* Definition ------------------------------------------------------------*/
+#define BENCH_ADV_NUM				(16)		/* Adv Packet数 */
+#define BENCH_ADV_NAME				"B51"		/* ble_app_workのDEVICE_NAME */
+#define BENCH_OUTPUT_SIZE			(192)		/* main.cの送信Bufferと同じ */
+
+#define BENCH_AD_TYPE_FLAGS			(0x01)
+#define BENCH_AD_TYPE_NAME			(0x09)
+#define BENCH_AD_TYPE_MANUFACTURER	(0xFF)
+
+/* Private variables -----------------------------------------------------*/
+static bleadv_packet_t g_bench_adv[BENCH_ADV_NUM];
+static bleadv_format_data g_bench_format[BENCH_ADV_NUM];
+static char g_bench_output[BENCH_OUTPUT_SIZE];
+
+/* Private function prototypes -------------------------------------------*/
+static void setup_adv( uint32_t arg );
+static uint32_t exec_format( uint32_t arg, uint32_t iter );
+static uint32_t exec_output( uint32_t arg, uint32_t iter );
+
+/* Case ------------------------------------------------------------------*/
+static const BENCH_CASE g_bench_gateway_case[] =
+{
+	/* name							setup			exec			arg		batch */
+	{ "bleadv_packet_format",			setup_adv,		exec_format,	0,		100 },
+	{ "bleadv_packet_output",			setup_adv,		exec_output,	0,		10 },
+};
+
+static const BENCH_SUITE g_bench_gateway_suite =
+{
+	"gateway",
+	g_bench_gateway_case,
+	sizeof( g_bench_gateway_case ) / sizeof( g_bench_gateway_case[0] ),
+};
+
+/**
+ * @brief Gateway (ble_app_gateway) のSuite
+ * @param None
+ * @retval Suite
+ */
+const BENCH_SUITE *BenchSuiteGateway( void )
+{
+	return &g_bench_gateway_suite;
+}
+
+/**
+ * @brief Badgeが送信するAdv Packet (Flags, Name, Manufacturer Data) を作る
+ * @param arg 未使用
+ * @retval None
+ */
+static void setup_adv( uint32_t arg )
+{
+	adv_payload_t manu;
+	bleadv_packet_t *p_adv;
+	uint8_t len;
+	uint32_t i;
+
+	for ( i = 0; i < BENCH_ADV_NUM; i++ )
+	{
+		p_adv = &g_bench_adv[i];
+		memset( p_adv, 0, sizeof( bleadv_packet_t ) );
+		p_adv->rssi			= (int8_t)( -40 - (int8_t)i );
+		p_adv->addr_type	= 1;
+		p_adv->addr[0]		= (uint8_t)i;
+		p_adv->addr[1]		= 0x80;
+		p_adv->addr[2]		= 0x01;
+		p_adv->addr[3]		= 0xA4;
+		p_adv->addr[4]		= 0x3F;
+		p_adv->addr[5]		= 0xC2;
+
+		memset( &manu, 0, sizeof( manu ) );
+		manu.app_id		= APP_ID;
+		manu.ver		= ADV_PAYLOAD_VERSION;
+		manu.device_id	= DEVICE_ID;
+		manu.seq		= (uint8_t)i;
+		manu.event		= EVENT_HEARTBEAT;
+		manu.x			= (int8_t)( BenchInputAcc( i * 7, BENCH_AXIS_X ) / 16 );
+		manu.y			= (int8_t)( BenchInputAcc( i * 7, BENCH_AXIS_Y ) / 16 );
+		manu.z			= (int8_t)( BenchInputAcc( i * 7, BENCH_AXIS_Z ) / 16 );
+		manu.bat		= (uint8_t)( 200 - i );
+
+		/* Flags */
+		len = 0;
+		p_adv->data[len++] = 2;
+		p_adv->data[len++] = BENCH_AD_TYPE_FLAGS;
+		p_adv->data[len++] = 0x06;
+		/* Complete Local Name */
+		p_adv->data[len++] = (uint8_t)( sizeof( BENCH_ADV_NAME ) - 1 + 1 );
+		p_adv->data[len++] = BENCH_AD_TYPE_NAME;
+		memcpy( &p_adv->data[len], BENCH_ADV_NAME, sizeof( BENCH_ADV_NAME ) - 1 );
+		len += sizeof( BENCH_ADV_NAME ) - 1;
+		/* Manufacturer Specific Data */
+		p_adv->data[len++] = (uint8_t)( 2 + sizeof( manu ) + 1 );
+		p_adv->data[len++] = BENCH_AD_TYPE_MANUFACTURER;
+		p_adv->data[len++] = (uint8_t)( COMPANY_ID & 0xFF );
+		p_adv->data[len++] = (uint8_t)( COMPANY_ID >> 8 );
+		memcpy( &p_adv->data[len], &manu, sizeof( manu ) );
+		len += sizeof( manu );
+		p_adv->data_len = len;
+
+		bleadv_packet_format( p_adv, &g_bench_format[i] );
+	}
+}
+
+/**
+ * @brief bleadv_packet_format (Adv Packet 1個の解析)
+ * @param arg 未使用
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_format( uint32_t arg, uint32_t iter )
+{
+	bleadv_format_data format;
+
+	bleadv_packet_format( &g_bench_adv[iter % BENCH_ADV_NUM], &format );
+
+	return BenchDigest( 0, &format, sizeof( format ) );
+}
+
+/**
+ * @brief bleadv_packet_output (UART送信する1行の書式化)
+ * @param arg 未使用
+ * @param iter 呼び出し回数
+ * @retval 結果のDigest
+ */
+static uint32_t exec_output( uint32_t arg, uint32_t iter )
+{
+	bleadv_packet_output( &g_bench_format[iter % BENCH_ADV_NUM], g_bench_output, sizeof( g_bench_output ) );
+
+	return BenchDigest( 0, g_bench_output, strlen( g_bench_output ) );
+}
@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************************
+  * @file    bench_nrf.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Microbenchmark nRF52実行環境 (DWT CYCCNT, RTT出力)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include <string.h>
+
+#include "nrf.h"
+#include "SEGGER_RTT.h"
+#include "bench.h"
+
+/* Definition ------------------------------------------------------------*/
+#define BENCH_RTT_CHANNEL			(0)
+#define BENCH_CPU_HZ				(64000000UL)	/* nRF52832 HFCLK */
+
+/* Private function prototypes -------------------------------------------*/
+static uint32_t nrf_now( void );
+static void nrf_output( const char *p_line );
+
+/* Private variables -----------------------------------------------------*/
+static const BENCH_PORT g_bench_nrf_port =
+{
+	"nrf52832",
+	"cycles",
+	BENCH_CPU_HZ,
+	nrf_now,
+	nrf_output,
+};
+
+/**
+ * @brief Targetで実行する (DWT初期化, RTT出力). SoftDevice有効化前に呼ぶ
+ * @param p_suite Suite
+ * @retval None
+ */
+void BenchTargetRun( const BENCH_SUITE *p_suite )
+{
+	const BENCH_SUITE * const suite[1] = { p_suite };
+	BENCH_OPTION option;
+
+	/* SoftDeviceの割り込みが入らないうちに計測する */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	/* 結果を取りこぼさないよう, RTTが一杯の時はHostの読み出しを待つ (J-Link接続が前提) */
+	(void)SEGGER_RTT_SetFlagsUpBuffer( BENCH_RTT_CHANNEL, SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL );
+
+	memset( &option, 0, sizeof( option ) );
+	option.samples = BENCH_SAMPLE_DEFAULT;
+	(void)BenchRun( &g_bench_nrf_port, suite, 1, &option );
+}
+
+/**
+ * @brief 現在のCycle数
+ * @param None
+ * @retval DWT CYCCNT
+ */
+static uint32_t nrf_now( void )
+{
+	return DWT->CYCCNT;
+}
+
+/**
+ * @brief 1行出力 (RTT Channel 0)
+ * @param p_line 出力文字列
+ * @retval None
+ */
+static void nrf_output( const char *p_line )
+{
+	(void)SEGGER_RTT_WriteString( BENCH_RTT_CHANNEL, p_line );
+}
@@ -0,0 +1,143 @@
+/**
+ * Badge/gateway microbenchmarks on Linux (bench/inc/bench.h).
+ *
+ * Times the same cases with the same generated input as the nRF52 build
+ * (bench_nrf.c), in nanoseconds from CLOCK_MONOTONIC. Output is one JSON
+ * object per line on stdout (or -o file); compare two runs with
+ * tools/bench_compare.py.
+ *
+ *     make -C bench run
+ *     ./bench/_build/badge_bench -n 64 -c GetWalkResult -o before.jsonl
+ *     ./bench/_build/badge_bench -s gateway
+ */
+#define _GNU_SOURCE                                                             // clock_gettime
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "SEGGER_RTT.h"
+
+#define BENCH_SUITE_NUM                 2
+
+static FILE * m_output;
+
+static uint32_t posix_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);   // wraps every 4.3 s, only differences are used
+}
+
+static void posix_output(const char * p_line)
+{
+    fputs(p_line, m_output);
+    fflush(m_output);
+}
+
+static const BENCH_PORT m_port =
+{
+    .target = "posix",
+    .unit   = "ns",
+    .hz     = 1000000000UL,
+    .now    = posix_now,
+    .output = posix_output,
+};
+
+/**@brief RTT output of the gateway formatter (bleadv_formater.c); not timed, so discarded.
+ */
+int SEGGER_RTT_printf(unsigned buffer_index, const char * p_format, ...)
+{
+    (void)buffer_index;
+    (void)p_format;
+
+    return 0;
+}
+
+static void usage(const char * p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-n samples] [-c case] [-s suite] [-o out.jsonl]\n"
+            "  -n         timed samples per case (1-%u, default %u)\n"
+            "  -c         only run cases whose name contains this string\n"
+            "  -s         only run this suite (badge, gateway)\n"
+            "  -o         write the JSON lines to this file instead of stdout\n",
+            p_name, BENCH_SAMPLE_MAX, BENCH_SAMPLE_DEFAULT);
+}
+
+int main(int argc, char * argv[])
+{
+    const BENCH_SUITE * suite[BENCH_SUITE_NUM];
+    const char *        p_suite = NULL;
+    BENCH_OPTION        option;
+    uint8_t             suite_num = 0;
+    uint32_t            count;
+    int                 opt;
+
+    memset(&option, 0, sizeof(option));
+    option.samples = BENCH_SAMPLE_DEFAULT;
+    m_output       = stdout;
+
+    while ((opt = getopt(argc, argv, "n:c:s:o:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                option.samples = (uint16_t)strtoul(optarg, NULL, 0);
+                if ((option.samples == 0) || (option.samples > BENCH_SAMPLE_MAX))
+                {
+                    usage(argv[0]);
+                    return 2;
+                }
+                break;
+
+            case 'c':
+                option.p_filter = optarg;
+                break;
+
+            case 's':
+                p_suite = optarg;
+                break;
+
+            case 'o':
+                m_output = fopen(optarg, "w");
+                if (m_output == NULL)
+                {
+                    perror(optarg);
+                    return 1;
+                }
+                break;
+
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+
+    if ((p_suite == NULL) || (strcmp(p_suite, BenchSuiteBadge()->name) == 0))
+    {
+        suite[suite_num++] = BenchSuiteBadge();
+    }
+    if ((p_suite == NULL) || (strcmp(p_suite, BenchSuiteGateway()->name) == 0))
+    {
+        suite[suite_num++] = BenchSuiteGateway();
+    }
+    if (suite_num == 0)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    count = BenchRun(&m_port, suite, suite_num, &option);
+
+    if (m_output != stdout)
+    {
+        fclose(m_output);
+    }
+
+    return (count == 0) ? 1 : 0;
+}
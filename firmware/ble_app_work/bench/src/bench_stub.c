@@ -0,0 +1,93 @@
+/**
+  ******************************************************************************************
+  * @file    bench_stub.c
+  * @author  k.tashiro
+  * @version 1.1
+  * @date    2026/10/19
+  * @brief   Microbenchmark用 AccAngle.cの接続先 (mode_manager, lib_angle_flash)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         角度調整情報の関数はAccAngle.hで宣言する
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include <string.h>
+#include "AccAngle.h"
+#include "lib_angle_flash.h"
+
+/*
+ * 計測するのはclac_acc_angle/calc_acc_rotだけなので,
+ * SetupAngleAdjust/SaveAngleAdjustの接続先はRAMに保持するだけにする
+ */
+
+/* Private variables -----------------------------------------------------*/
+static ACC_ANGLE g_bench_angle;
+static uint8_t g_bench_angle_state = ANGLE_ADJUST_DISABLE;
+
+/**
+ * @brief 角度調整情報設定
+ * @param angle_info 角度調整情報
+ * @retval None
+ */
+void SetAngleAdjustInfo( ACC_ANGLE *angle_info )
+{
+	g_bench_angle = *angle_info;
+}
+
+/**
+ * @brief 角度調整情報取得
+ * @param angle_info 角度調整情報
+ * @retval None
+ */
+void GetAngleAdjustInfo( ACC_ANGLE *angle_info )
+{
+	*angle_info = g_bench_angle;
+}
+
+/**
+ * @brief 角度調整状態変更
+ * @param state 角度調整状態
+ * @retval None
+ */
+void ChangeAngleAdjustState( uint8_t state )
+{
+	g_bench_angle_state = state;
+}
+
+/**
+ * @brief 角度調整状態取得
+ * @param state 角度調整状態
+ * @retval None
+ */
+void GetAngleAdjustState( uint8_t *state )
+{
+	*state = g_bench_angle_state;
+}
+
+/**
+ * @brief Read Angle Adjust Info
+ * @remark Flashを持たないため常に未保存として返す
+ * @param angle_rom_data Flashから読み出したデータ
+ * @retval NRF_ERROR_NOT_FOUND 未保存
+ */
+uint32_t ReadAngleAdjust( ROM_ANGLE_INFO *angle_rom_data )
+{
+	memset( angle_rom_data, 0, sizeof( ROM_ANGLE_INFO ) );
+
+	return NRF_ERROR_NOT_FOUND;
+}
+
+/**
+ * @brief Write Angle Adjust Info
+ * @remark 書き込まずに成功を返す
+ * @param angle_rom_data Flashに書き込むデータ
+ * @retval NRF_SUCCESS Success
+ */
+uint32_t WriteAngleAdjust( ROM_ANGLE_INFO *angle_rom_data )
+{
+	return NRF_SUCCESS;
+}
@@ -0,0 +1,304 @@
+#include <string.h>
+
+#include "ble_adv_scheduler.h"
+#include "ble_gap.h"
+#include "nrf_sdh_ble.h"
+#include "app_error.h"
+#include "app_util_platform.h"
+#include "sdk_common.h"
+
+#define BLE_ADV_SCHED_OBSERVER_PRIO     BLE_ADV_BLE_OBSERVER_PRIO
+#define MANUF_COMPANY_ID_SIZE           2
+
+APP_TIMER_DEF(m_adv_sched_timer);
+
+static uint8_t  m_adv_handle = BLE_GAP_ADV_SET_HANDLE_NOT_SET;
+static uint8_t  m_enc_advdata[2][BLE_GAP_ADV_SET_DATA_SIZE_MAX];   // SoftDevice needs a new buffer for each update while advertising
+static uint8_t  m_enc_idx;
+static uint16_t m_enc_len;
+static uint16_t m_payload_offset;
+static uint8_t const * m_p_payload;
+static uint16_t m_payload_len;
+static uint8_t  m_conn_cfg_tag;
+static bool     m_connected;
+static ble_adv_sched_status_t m_status;
+
+static ble_gap_adv_data_t adv_data_get(uint8_t idx)
+{
+    ble_gap_adv_data_t adv_data;
+
+    memset(&adv_data, 0, sizeof(adv_data));
+    adv_data.adv_data.p_data = m_enc_advdata[idx];
+    adv_data.adv_data.len    = m_enc_len;
+
+    return adv_data;
+}
+
+// Locate the manufacturer payload (after the company ID) in the encoded AD structures.
+static ret_code_t payload_offset_find(void)
+{
+    uint16_t i = 0;
+
+    while ((i + 1) < m_enc_len)
+    {
+        uint8_t field_len = m_enc_advdata[0][i];
+
+        if (field_len == 0)
+        {
+            break;
+        }
+        if (m_enc_advdata[0][i + 1] == BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA)
+        {
+            if ((field_len - 1 - MANUF_COMPANY_ID_SIZE) != m_payload_len)
+            {
+                return NRF_ERROR_DATA_SIZE;
+            }
+            m_payload_offset = i + 2 + MANUF_COMPANY_ID_SIZE;
+            return NRF_SUCCESS;
+        }
+        i += field_len + 1;
+    }
+
+    return NRF_ERROR_NOT_FOUND;
+}
+
+static ret_code_t adv_configure(uint16_t interval)
+{
+    ble_gap_adv_params_t adv_params;
+    ble_gap_adv_data_t   adv_data = adv_data_get(m_enc_idx);
+
+    memset(&adv_params, 0, sizeof(adv_params));
+    adv_params.properties.type = BLE_GAP_ADV_TYPE_CONNECTABLE_SCANNABLE_UNDIRECTED;
+    adv_params.p_peer_addr     = NULL;
+    adv_params.filter_policy   = BLE_GAP_ADV_FP_ANY;
+    adv_params.interval        = interval;
+    adv_params.duration        = BLE_GAP_ADV_TIMEOUT_GENERAL_UNLIMITED;
+    adv_params.primary_phy     = BLE_GAP_PHY_1MBPS;
+
+    return sd_ble_gap_adv_set_configure(&m_adv_handle, &adv_data, &adv_params);
+}
+
+// Changing the interval needs stop/configure/start; payload updates do not.
+static ret_code_t interval_apply(uint16_t interval)
+{
+    ret_code_t err_code;
+
+    if (m_connected)
+    {
+        // Applied by the next start after the link is gone.
+        m_status.interval = interval;
+        return NRF_SUCCESS;
+    }
+    if (m_status.advertising && (m_status.interval == interval))
+    {
+        return NRF_SUCCESS;
+    }
+
+    if (m_status.advertising)
+    {
+        err_code = sd_ble_gap_adv_stop(m_adv_handle);
+        if ((err_code != NRF_SUCCESS) && (err_code != NRF_ERROR_INVALID_STATE))
+        {
+            return err_code;
+        }
+        m_status.advertising = false;
+    }
+
+    m_status.interval = interval;
+    err_code = adv_configure(interval);
+    VERIFY_SUCCESS(err_code);
+
+    err_code = sd_ble_gap_adv_start(m_adv_handle, m_conn_cfg_tag);
+    if (err_code == NRF_SUCCESS)
+    {
+        m_status.advertising = true;
+        m_status.reconfig_cnt++;
+    }
+
+    return err_code;
+}
+
+// Called from the main context and from the level timer: one caller must not
+// stop or configure the set between the other's configure and start.
+static ret_code_t interval_set(uint16_t interval)
+{
+    ret_code_t err_code;
+
+    CRITICAL_REGION_ENTER();
+    err_code = interval_apply(interval);
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+}
+
+static void level_timer_start(uint32_t ticks)
+{
+    ret_code_t err_code;
+
+    (void)app_timer_stop(m_adv_sched_timer);
+    err_code = app_timer_start(m_adv_sched_timer, ticks, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+static void interval_check(ret_code_t err_code)
+{
+    // CONN_COUNT: a central connected between the event and the restart.
+    if ((err_code != NRF_ERROR_INVALID_STATE) && (err_code != NRF_ERROR_CONN_COUNT))
+    {
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+static void sched_timeout_handler(void * p_context)
+{
+    uint16_t next;
+
+    UNUSED_PARAMETER(p_context);
+
+    if (m_status.burst)
+    {
+        m_status.burst = false;
+        next = BLE_ADV_SCHED_BASE_INTERVAL;
+    }
+    else
+    {
+        next = MIN((uint32_t)m_status.interval * 2, BLE_ADV_SCHED_MAX_INTERVAL);
+    }
+
+    interval_check(interval_set(next));
+
+    if (!m_connected && (next < BLE_ADV_SCHED_MAX_INTERVAL))
+    {
+        level_timer_start(BLE_ADV_SCHED_STEP_DURATION);
+    }
+}
+
+static void on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+            // Connectable advertising stops when a central connects.
+            m_connected          = true;
+            m_status.advertising = false;
+            m_status.burst       = false;
+            (void)app_timer_stop(m_adv_sched_timer);
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            m_connected = false;
+            interval_check(ble_adv_sched_start());
+            break;
+
+        case BLE_GAP_EVT_ADV_SET_TERMINATED:
+            m_status.advertising = false;
+            break;
+
+        default:
+            break;
+    }
+}
+
+NRF_SDH_BLE_OBSERVER(m_adv_sched_obs, BLE_ADV_SCHED_OBSERVER_PRIO, on_ble_evt, NULL);
+
+ret_code_t ble_adv_sched_init(ble_advdata_t const * p_advdata, uint8_t conn_cfg_tag)
+{
+    ret_code_t err_code;
+
+    VERIFY_PARAM_NOT_NULL(p_advdata);
+    VERIFY_PARAM_NOT_NULL(p_advdata->p_manuf_specific_data);
+
+    memset(&m_status, 0, sizeof(m_status));
+    m_conn_cfg_tag = conn_cfg_tag;
+    m_connected    = false;
+    m_enc_idx      = 0;
+    m_p_payload    = p_advdata->p_manuf_specific_data->data.p_data;
+    m_payload_len  = p_advdata->p_manuf_specific_data->data.size;
+
+    m_enc_len = sizeof(m_enc_advdata[0]);
+    err_code = ble_advdata_encode(p_advdata, m_enc_advdata[0], &m_enc_len);
+    VERIFY_SUCCESS(err_code);
+
+    err_code = payload_offset_find();
+    VERIFY_SUCCESS(err_code);
+
+    err_code = app_timer_create(&m_adv_sched_timer, APP_TIMER_MODE_SINGLE_SHOT, sched_timeout_handler);
+    VERIFY_SUCCESS(err_code);
+
+    m_status.interval = BLE_ADV_SCHED_BASE_INTERVAL;
+
+    return adv_configure(m_status.interval);
+}
+
+ret_code_t ble_adv_sched_start(void)
+{
+    ret_code_t err_code;
+
+    if (m_connected)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    m_status.burst = false;
+    err_code = interval_set(BLE_ADV_SCHED_BASE_INTERVAL);
+    VERIFY_SUCCESS(err_code);
+
+    level_timer_start(BLE_ADV_SCHED_STEP_DURATION);
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t ble_adv_sched_payload_update(bool alarm)
+{
+    ret_code_t         err_code = NRF_SUCCESS;
+    ble_gap_adv_data_t adv_data;
+    uint8_t            next;
+
+    // The level timer runs at a higher priority and also configures the set.
+    CRITICAL_REGION_ENTER();
+    next = m_enc_idx ^ 1;
+    memcpy(m_enc_advdata[next], m_enc_advdata[m_enc_idx], m_enc_len);
+    memcpy(&m_enc_advdata[next][m_payload_offset], m_p_payload, m_payload_len);
+    if (m_status.advertising)
+    {
+        adv_data = adv_data_get(next);
+        err_code = sd_ble_gap_adv_set_configure(&m_adv_handle, &adv_data, NULL);
+    }
+    if (err_code == NRF_SUCCESS)
+    {
+        m_enc_idx = next;
+        m_status.update_cnt++;
+    }
+    CRITICAL_REGION_EXIT();
+    VERIFY_SUCCESS(err_code);
+
+    if (m_connected)
+    {
+        return NRF_SUCCESS;
+    }
+
+    if (alarm)
+    {
+        m_status.burst = true;
+        err_code = interval_set(BLE_ADV_SCHED_BURST_INTERVAL);
+        level_timer_start(BLE_ADV_SCHED_BURST_DURATION);
+    }
+    else if (!m_status.burst)
+    {
+        // A plain change must not cut an alarm burst short.
+        err_code = interval_set(BLE_ADV_SCHED_BASE_INTERVAL);
+        level_timer_start(BLE_ADV_SCHED_STEP_DURATION);
+    }
+
+    return err_code;
+}
+
+void ble_adv_sched_status_get(ble_adv_sched_status_t * p_status)
+{
+    if (p_status != NULL)
+    {
+        *p_status = m_status;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef BLE_ADV_SCHEDULER_H__
+#define BLE_ADV_SCHEDULER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_advdata.h"
+#include "app_timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Advertising policy (tools/adv_sched_model.py models the same timing):
+ *
+ *   alarm   : BURST interval for BURST_DURATION, then BASE
+ *   change  : BASE
+ *   idle    : the interval doubles every STEP_DURATION up to MAX
+ *
+ * The AD structure is encoded once. A payload update copies the encoded
+ * data to the spare buffer, patches only the manufacturer payload bytes and
+ * hands the new buffer to the SoftDevice, so the interval is only changed
+ * when the policy level changes.
+ */
+#define BLE_ADV_SCHED_BURST_INTERVAL        MSEC_TO_UNITS(20, UNIT_0_625_MS)    /**< Interval right after an alarm. */
+#define BLE_ADV_SCHED_BURST_DURATION        APP_TIMER_TICKS(1000)               /**< Length of the alarm burst. */
+#define BLE_ADV_SCHED_BASE_INTERVAL         MSEC_TO_UNITS(100, UNIT_0_625_MS)   /**< Interval after a payload change. */
+#define BLE_ADV_SCHED_MAX_INTERVAL          MSEC_TO_UNITS(2000, UNIT_0_625_MS)  /**< Back-off limit when nothing changes. */
+#define BLE_ADV_SCHED_STEP_DURATION         APP_TIMER_TICKS(10000)              /**< Time spent at each back-off level. */
+
+/**@brief Current advertising level, for logging and the power model. */
+typedef struct
+{
+    uint16_t interval;          /**< Current interval (0.625 ms units). */
+    bool     burst;             /**< true while the alarm burst runs. */
+    bool     advertising;       /**< false while connected or stopped. */
+    uint32_t update_cnt;        /**< In-place payload updates. */
+    uint32_t reconfig_cnt;      /**< Interval changes (stop/configure/start). */
+} ble_adv_sched_status_t;
+
+/**@brief Encode the advertising data once and prepare the payload patch.
+ *
+ * @param[in] p_advdata     Advertising data. Must contain manufacturer specific data;
+ *                          its p_data buffer is re-read on every update.
+ * @param[in] conn_cfg_tag  Connection configuration tag.
+ *
+ * @retval NRF_SUCCESS, or an error from ble_advdata_encode / sd_ble_gap_adv_set_configure.
+ */
+ret_code_t ble_adv_sched_init(ble_advdata_t const * p_advdata, uint8_t conn_cfg_tag);
+
+/**@brief Start connectable advertising at the base interval. */
+ret_code_t ble_adv_sched_start(void);
+
+/**@brief Patch the manufacturer payload into the advertised data.
+ *
+ * @param[in] alarm  true starts the alarm burst, false drops back to the base interval.
+ */
+ret_code_t ble_adv_sched_payload_update(bool alarm);
+
+/**@brief Get the current advertising level. */
+void ble_adv_sched_status_get(ble_adv_sched_status_t * p_status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLE_ADV_SCHEDULER_H__
@@ -1,5 +1,6 @@
 #include "ble_motion_service.h"
 #include "sdk_common.h"
+#include "lib_notify_queue.h"
 
 #define DEVICE_ID_VALUE  26  // 先固定，之後可換成 FICR/自訂ID
 
@@ -51,6 +52,25 @@ static uint32_t status_char_add(ble_motion_t * p_motion)
     return err_code;
 }
 
+static uint32_t energy_char_add(ble_motion_t * p_motion)
+{
+    ble_add_char_params_t add_char_params;
+
+    memset(&add_char_params, 0, sizeof(add_char_params));
+    add_char_params.uuid                = MOTION_UUID_ENERGY_CHAR;
+    add_char_params.uuid_type           = p_motion->uuid_type;
+    add_char_params.init_len            = 0;
+    add_char_params.max_len             = MOTION_ENERGY_MAX_LEN;
+    add_char_params.is_var_len          = true;
+    add_char_params.char_props.read     = 1;
+    add_char_params.read_access         = SEC_OPEN;
+    add_char_params.write_access        = SEC_NO_ACCESS;
+
+    return characteristic_add(p_motion->service_handle,
+                              &add_char_params,
+                              &p_motion->energy_handles);
+}
+
 uint32_t ble_motion_init(ble_motion_t * p_motion)
 {
     if (p_motion == NULL) return NRF_ERROR_NULL;
@@ -78,6 +98,9 @@ uint32_t ble_motion_init(ble_motion_t * p_motion)
     err_code = status_char_add(p_motion);
     VERIFY_SUCCESS(err_code);
 
+    err_code = energy_char_add(p_motion);
+    VERIFY_SUCCESS(err_code);
+
     return NRF_SUCCESS;
 }
 
@@ -94,6 +117,12 @@ void ble_motion_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
 
         case BLE_GAP_EVT_DISCONNECTED:
             p_motion->conn_handle = BLE_CONN_HANDLE_INVALID;
+            NotifyQueueClear();
+            break;
+
+        case BLE_GATTS_EVT_HVN_TX_COMPLETE:
+            // Queued notifications go out as the SoftDevice queue frees up.
+            NotifyQueueDrain(p_ble_evt->evt.gatts_evt.params.hvn_tx_complete.count);
             break;
 
         default:
@@ -101,19 +130,41 @@ void ble_motion_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
     }
 }
 
+// Status notifications go through the notify queue (lib_notify_queue), so a full
+// SoftDevice queue holds them until BLE_GATTS_EVT_HVN_TX_COMPLETE instead of failing.
 uint32_t ble_motion_status_notify(ble_motion_t * p_motion, uint8_t status)
 {
     if (p_motion == NULL) return NRF_ERROR_NULL;
     if (p_motion->conn_handle == BLE_CONN_HANDLE_INVALID) return NRF_ERROR_INVALID_STATE;
 
-    uint16_t len = sizeof(status);
-    ble_gatts_hvx_params_t hvx_params;
-    memset(&hvx_params, 0, sizeof(hvx_params));
+    return NotifyQueueSend(p_motion->status_handles.value_handle, &status, sizeof(status));
+}
+
+// A status that only matters while it is the newest one (heartbeat): one still
+// waiting in the queue is replaced instead of sending both.
+uint32_t ble_motion_status_update(ble_motion_t * p_motion, uint8_t status)
+{
+    if (p_motion == NULL) return NRF_ERROR_NULL;
+    if (p_motion->conn_handle == BLE_CONN_HANDLE_INVALID) return NRF_ERROR_INVALID_STATE;
+
+    return NotifyQueueSendLatest(p_motion->status_handles.value_handle, &status, sizeof(status));
+}
+
+// The value is kept in the SoftDevice attribute table, so it can be updated
+// without a connection and is read by the central whenever it wants.
+uint32_t ble_motion_energy_set(ble_motion_t * p_motion, uint8_t const * p_data, uint16_t len)
+{
+    if (p_motion == NULL || p_data == NULL) return NRF_ERROR_NULL;
+    if (len > MOTION_ENERGY_MAX_LEN) return NRF_ERROR_DATA_SIZE;
+
+    ble_gatts_value_t gatts_value;
+    memset(&gatts_value, 0, sizeof(gatts_value));
 
-    hvx_params.handle = p_motion->status_handles.value_handle;
-    hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
-    hvx_params.p_len  = &len;
-    hvx_params.p_data = &status;
+    gatts_value.len     = len;
+    gatts_value.offset  = 0;
+    gatts_value.p_value = (uint8_t *)p_data;
 
-    return sd_ble_gatts_hvx(p_motion->conn_handle, &hvx_params);
+    return sd_ble_gatts_value_set(BLE_CONN_HANDLE_INVALID,
+                                  p_motion->energy_handles.value_handle,
+                                  &gatts_value);
 }
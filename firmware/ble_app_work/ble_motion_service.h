@@ -20,6 +20,9 @@ extern "C" {
 #define MOTION_UUID_SERVICE     0x1520
 #define MOTION_UUID_DEV_ID_CHAR 0x1521
 #define MOTION_UUID_STATUS_CHAR 0x1522
+#define MOTION_UUID_ENERGY_CHAR 0x1523
+
+#define MOTION_ENERGY_MAX_LEN   96      // energy profile report (lib_energy_prof.h), read with Read Blob
 
 typedef struct ble_motion_s ble_motion_t;
 
@@ -30,6 +33,7 @@ struct ble_motion_s
     uint16_t                 service_handle;
     ble_gatts_char_handles_t dev_id_handles;
     ble_gatts_char_handles_t status_handles;
+    ble_gatts_char_handles_t energy_handles;
     uint8_t                  uuid_type;
 
     uint16_t                 conn_handle;
@@ -39,6 +43,8 @@ uint32_t ble_motion_init(ble_motion_t * p_motion);
 void     ble_motion_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context);
 
 uint32_t ble_motion_status_notify(ble_motion_t * p_motion, uint8_t status);
+uint32_t ble_motion_status_update(ble_motion_t * p_motion, uint8_t status);
+uint32_t ble_motion_energy_set(ble_motion_t * p_motion, uint8_t const * p_data, uint16_t len);
 
 #ifdef __cplusplus
 }
@@ -10,6 +10,9 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/24       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Notify送信をNotify Queue経由に変更
+  * 1.2            2026/10/19       k.tashiro         Connection ParameterをBLE Profileから取得
+  * 1.3            2026/10/19       k.tashiro         retrycountを初期化 (Host Build -Werror)
   ******************************************************************************************
 */
 
@@ -28,6 +31,8 @@
 #include "flash_operation.h"
 #include "lib_trace_log.h"
 #include "AccAngle.h"
+#include "lib_notify_queue.h"
+#include "lib_ble_profile.h"
 
 /* Private variables -----------------------------------------------------*/
 volatile ble_gap_conn_params_t m_conn_params;
@@ -74,6 +79,18 @@ static const uint8_t gfw_version[] = {4,1,8};
 static ANGLE_ADJUST_INFO g_angle_adjust_info = {0};
 /* 2022.05.19 Add 角度調整 -- */
 
+/* 2026.10.19 Add BLE Profile ++ */
+static uint32_t ble_profile_tx_bytes(void);
+
+static const BLE_PROFILE_CONFIG g_ble_profile_config =
+{
+	.get_conn_handle    = GetBleCntHandle,
+	.mtu_update         = UpdateMtuSize,
+	.bulk_timer_restart = RestartBleProfileBulkTimer,
+	.get_tx_bytes       = ble_profile_tx_bytes,
+};
+/* 2026.10.19 Add BLE Profile -- */
+
 /* Private function prototypes -------------------------------------------*/
 /**
  * @brief connection param update error check
@@ -154,10 +171,13 @@ static bool cnt_param_check(void)
 {
 	volatile bool bret;
 	volatile CON_PARAM currConparam;
+	ble_gap_conn_params_t con_para;
 	
 	bret = true;
 	//connection parameter get
 	GetConParam( (void *)&currConparam );
+	/* 2026.10.19 Modify 現在のBLE Profileと比較 */
+	GetBleProfileConnParam( false, &con_para );
 
 	if((uint16_t)MAX_CONN_INTERVAL < currConparam.max_con_param)
 	{
@@ -175,12 +195,12 @@ static bool cnt_param_check(void)
 		}
 	}
 
-	if(currConparam.slave_param != (uint16_t)SLAVE_LATENCY)
+	if(currConparam.slave_param != con_para.slave_latency)
 	{
 		bret = false;
 	}
 	
-	if(currConparam.sup_time != (uint16_t)CONN_SUP_TIMEOUT)
+	if(currConparam.sup_time != con_para.conn_sup_timeout)
 	{
 		bret = false;
 	}
@@ -206,10 +226,13 @@ static bool check_flash_op_cnt_pamam(void)
 {
 	volatile bool bret;
 	volatile CON_PARAM currConparam;
+	ble_gap_conn_params_t con_para;
 	
 	bret = true;
 	//connection parameter check
 	GetConParam( (void *)&currConparam );
+	/* 2026.10.19 Modify 現在のBLE Profileと比較 */
+	GetBleProfileConnParam( true, &con_para );
 
 	if((uint16_t)MAX_CONN_INTERVAL < currConparam.max_con_param)
 	{
@@ -227,12 +250,12 @@ static bool check_flash_op_cnt_pamam(void)
 		}
 	}
 	
-	if(currConparam.slave_param != (uint16_t)FLASH_SLAVE_LATENCY)
+	if(currConparam.slave_param != con_para.slave_latency)
 	{
 		bret = false;
 	}
 	
-	if(currConparam.sup_time != (uint16_t)CONN_SUP_TIMEOUT)
+	if(currConparam.sup_time != con_para.conn_sup_timeout)
 	{
 		bret = false;
 	}
@@ -271,6 +294,19 @@ static void set_fw_version_to_ble(void)
 	BleSetValueErrProcess(err);
 }
 
+/**
+ * @brief Notify送信Payloadの合計を取得 (BLE Profileの統計用)
+ * @param None
+ * @retval 送信Byte数
+ */
+static uint32_t ble_profile_tx_bytes(void)
+{
+	NOTIFY_QUEUE_STATS notify_stats;
+
+	NotifyQueueGetStats(&notify_stats);
+	return notify_stats.send_bytes;
+}
+
 /**
  * @brief Get first send param update retry count
  * @param pRetryCount retry count
@@ -508,17 +544,15 @@ uint32_t UpdateParamCheck(PEVT_ST pEvent)
 {
 	ret_code_t err_code;
 	EVT_ST event;
-	uint8_t retrycount;
+	uint8_t retrycount = 0;		/* 2026.10.19 Modify 初期化 */
 	bool bParamCheck;
 	uint16_t cnt_handle = BLE_CONN_HANDLE_INVALID;
 	uint8_t flash_op;
 	EVT_ST sleepevent;
 	ble_gap_conn_params_t con_para;
 	
-	con_para.slave_latency     = SLAVE_LATENCY;
-	con_para.min_conn_interval = MIN_CONN_INTERVAL;
-	con_para.max_conn_interval = MAX_CONN_INTERVAL;
-	con_para.conn_sup_timeout  = CONN_SUP_TIMEOUT;
+	/* 2026.10.19 Modify BLE Profileから取得 */
+	GetBleProfileConnParam( false, &con_para );
 	
 	DEBUG_LOG(LOG_INFO, "conncetion param update slave latecy zero enter");
 	//update param check.
@@ -535,6 +569,8 @@ uint32_t UpdateParamCheck(PEVT_ST pEvent)
 		// retry count
 		ParamUpdateRetryCountClear();
 		UpdateRetryCountClear();
+		/* 2026.10.19 Add PHY/Data Length/MTUを反映 */
+		BleProfileReady( false );
 		//connection update cmpl. state change connect
 		event.evt_id = EVT_CNT_PARAM_UPDATE_CMPL;
 		err_code = PushFifo(&event);
@@ -644,7 +680,7 @@ uint32_t BleForceDisconnect(PEVT_ST pEvent)
 uint32_t ChangeCntParamSlaveLetencyOne(PEVT_ST pEvent)
 {
 	volatile ret_code_t err_code;
-	uint8_t retrycount;
+	uint8_t retrycount = 0;		/* 2026.10.19 Modify 初期化 */
 	bool bret;
 	EVT_ST event;
 	ble_gap_conn_params_t con_para;
@@ -653,10 +689,8 @@ uint32_t ChangeCntParamSlaveLetencyOne(PEVT_ST pEvent)
 	uint8_t flash_op;
 	EVT_ST sleepevent;
 	
-	con_para.slave_latency     = FLASH_SLAVE_LATENCY;
-	con_para.min_conn_interval = MIN_CONN_INTERVAL;
-	con_para.max_conn_interval = MAX_CONN_INTERVAL;
-	con_para.conn_sup_timeout  = CONN_SUP_TIMEOUT;
+	/* 2026.10.19 Modify BLE Profileから取得 (Slave LatencyはFLASH_SLAVE_LATENCY以上) */
+	GetBleProfileConnParam( true, &con_para );
 	
 	/* Check Flash Operation */
 	bret = check_flash_op_cnt_pamam();
@@ -668,6 +702,8 @@ uint32_t ChangeCntParamSlaveLetencyOne(PEVT_ST pEvent)
 		ParamUpdateRetryCountClear();
 		
 		DEBUG_LOG(LOG_INFO,"conection param update success. change SL 1");
+		/* 2026.10.19 Add Flash Operation中のBLE Profile */
+		BleProfileReady( true );
 		//connection update cmpl. state change connect
 		event.evt_id = EVT_CNT_PARAM_UPDATE_CMPL;
 		fifo_err_code = PushFifo(&event);
@@ -762,6 +798,8 @@ void BleGattsGapSetup(void)
 	BleGapSetting();
 	set_fw_version_to_ble();
 	SetCurrentMode((uint8_t)DAILY_MODE);
+	/* 2026.10.19 Add BLE Profile */
+	BleProfileInit(&g_ble_profile_config);
 	SetBleErrReadCmd((uint8_t)UTC_BLE_SUCCESS);
 }
 
@@ -816,10 +854,9 @@ uint32_t BleSlaveLatencyZeroChange(PEVT_ST pEvent)
 	EVT_ST replyevent;
 	
 	
-	con_para.slave_latency     = SLAVE_LATENCY;
-	con_para.min_conn_interval = MIN_CONN_INTERVAL;
-	con_para.max_conn_interval = MAX_CONN_INTERVAL;
-	con_para.conn_sup_timeout  = CONN_SUP_TIMEOUT;
+	/* 2026.10.19 Modify BLE Profileから取得 */
+	GetBleProfileConnParam( false, &con_para );
+	BleProfileFlashOp( false );
 	
 
 	
@@ -892,10 +929,9 @@ uint32_t BleSlaveLatencyOneChange(PEVT_ST pEvent)
 	EVT_ST sleepevent;
 	EVT_ST replyevent;
 
-	con_para.slave_latency     = FLASH_SLAVE_LATENCY;
-	con_para.min_conn_interval = MIN_CONN_INTERVAL;
-	con_para.max_conn_interval = MAX_CONN_INTERVAL;
-	con_para.conn_sup_timeout  = CONN_SUP_TIMEOUT;
+	/* 2026.10.19 Modify BLE Profileから取得 (Slave LatencyはFLASH_SLAVE_LATENCY以上) */
+	GetBleProfileConnParam( true, &con_para );
+	BleProfileFlashOp( true );
 	
 	GetFlashOperatoinMode(&flash_op);
 	if(flash_op != FLASH_RTC_INT)
@@ -957,7 +993,6 @@ ret_code_t RawResSetBleNotifyCmd(uint8_t *pSignal, uint16_t size)
 	ret_code_t err_code;
 	ble_gatts_hvx_params_t notify_param;
 	uint16_t dataSize;
-	uint16_t cnt_handle = BLE_CONN_HANDLE_INVALID;
 	uint16_t notify_id;
 	
 	dataSize = size;
@@ -969,8 +1004,8 @@ ret_code_t RawResSetBleNotifyCmd(uint8_t *pSignal, uint16_t size)
 	notify_param.p_len  = &dataSize;
 	
 	//DEBUG_LOG(LOG_INFO,"ble notfy up. handler 0x%x. size %u",notify_id, size);
-	GetBleCntHandle(&cnt_handle);
-	err_code = sd_ble_gatts_hvx(cnt_handle,&notify_param);
+	/* 2026.10.19 Modify Notify Queue経由で送信 */
+	err_code = NotifyQueueSendParam(&notify_param);
 
 	return err_code;
 
@@ -1048,7 +1083,7 @@ uint32_t UpdateParamCheckGuest(PEVT_ST pEvent)
 {
 	ret_code_t err_code;
 	EVT_ST event;
-	uint8_t retrycount;
+	uint8_t retrycount = 0;		/* 2026.10.19 Modify 初期化 */
 	bool bParamCheck;
 	uint16_t cnt_handle = BLE_CONN_HANDLE_INVALID;
 	uint8_t flash_op;
@@ -1060,10 +1095,10 @@ uint32_t UpdateParamCheckGuest(PEVT_ST pEvent)
 	
 	int rand_id = GetRndId();
 	
-	con_para.slave_latency     = SLAVE_LATENCY;
+	/* 2026.10.19 Modify Slave Latency/Supervision TimeoutはBLE Profileから取得 */
+	GetBleProfileConnParam( false, &con_para );
 	con_para.min_conn_interval = RANDOM_MIN[rand_id];//MIN_CONN_INTERVAL;
 	con_para.max_conn_interval = RANDOM_MAX[rand_id];//MAX_CONN_INTERVAL;
-	con_para.conn_sup_timeout  = CONN_SUP_TIMEOUT;
 	
 	
 	bool isGuest = GetGuestModeState();
@@ -1086,6 +1121,8 @@ uint32_t UpdateParamCheckGuest(PEVT_ST pEvent)
 			// retry count
 			ParamUpdateRetryCountClear();
 			UpdateRetryCountClear();
+			/* 2026.10.19 Add PHY/Data Length/MTUを反映 */
+			BleProfileReady( false );
 			//connection update cmpl. state change connect
 			event.evt_id = EVT_CNT_PARAM_UPDATE_CMPL;
 			err_code = PushFifo(&event);
@@ -10,6 +10,8 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/25       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Notify送信をNotify Queue経由に変更
+  * 1.2            2026/10/19       k.tashiro         Daily Log転送中はBulk Profileを使用
   ******************************************************************************************
 */
 
@@ -32,6 +34,8 @@
 #include "lib_ram_retain.h"
 #include "ble_definition.h"
 #include "lib_trace_log.h"
+#include "lib_notify_queue.h"
+#include "lib_ble_profile.h"
 
 /* Definition ------------------------------------------------------------*/
 /* Flash Data*/
@@ -198,11 +202,12 @@ uint32_t SendDailyLog(PEVT_ST pEvent)
 	Daily_t daily_data;
 	ble_gatts_hvx_params_t notify_data;
 	static uint8_t retrycount = 0;
-	uint16_t cnt_handle = BLE_CONN_HANDLE_INVALID;
 	EVT_ST replyEvent;
 	EVT_ST endEvent;
 
 	GetGattsCharHandleValueID(&daily_log_id_value_handle,DAILY_LOG_ID);
+	/* 2026.10.19 Add 転送中はBulk Profileを使用 */
+	BleProfileBulkKick();
 	
 	notify_size           = sizeof(daily_data);
 	count                 = 0;
@@ -298,8 +303,8 @@ uint32_t SendDailyLog(PEVT_ST pEvent)
 				/* Set Send Data*/
 				notify_data.p_data = (uint8_t*)&daily_data;
 				notify_data.p_len  = &notify_size;
-				GetBleCntHandle(&cnt_handle);
-				ble_err_code = sd_ble_gatts_hvx(cnt_handle, &notify_data);
+				/* 2026.10.19 Modify Notify Queue経由で送信 (Queue Full時は従来のRetryで再送) */
+				ble_err_code = NotifyQueueSendParam(&notify_data);
 				DEBUG_LOG(LOG_DEBUG,"continue send daily continue w %u, r %u, d %u, sid %u",daily_data.walk,daily_data.run,daily_data.dash,daily_data.sid);
 				DEBUG_LOG(LOG_DEBUG,"e");
 				if(ble_err_code != NRF_SUCCESS)
@@ -378,8 +383,8 @@ uint32_t SendDailyLog(PEVT_ST pEvent)
 			/* Set Send Data*/
 			notify_data.p_data = (uint8_t*)&daily_data;
 			notify_data.p_len  = &notify_size;
-			GetBleCntHandle(&cnt_handle);
-			ble_err_code = sd_ble_gatts_hvx(cnt_handle, &notify_data);
+			/* 2026.10.19 Modify Notify Queue経由で送信 (Queue Full時は従来のRetryで再送) */
+			ble_err_code = NotifyQueueSendParam(&notify_data);
 			DEBUG_LOG(LOG_INFO,"send continue end w %u, r %u, d %u, sid %u",daily_data.walk,daily_data.run,daily_data.dash,daily_data.sid);
 			if(ble_err_code != NRF_SUCCESS)
 			{
@@ -470,12 +475,13 @@ uint32_t SendSingleDailyLog(PEVT_ST pEvent)
 	uint16_t notify_size;
 	ble_gatts_hvx_params_t notify_data;
 	static uint8_t retrycount = 0;
-	uint16_t cnt_handle = BLE_CONN_HANDLE_INVALID;
 	EVT_ST sleepEvent;
 	EVT_ST replyEvent;
 	
 	send_end_data = false;
 	GetGattsCharHandleValueID(&daily_log_id_value_handle,DAILY_LOG_ID);
+	/* 2026.10.19 Add 転送中はBulk Profileを使用 */
+	BleProfileBulkKick();
 	
 	notify_size           = sizeof(daily_data);
 	notify_data.handle    = daily_log_id_value_handle;
@@ -566,9 +572,9 @@ uint32_t SendSingleDailyLog(PEVT_ST pEvent)
 					/* Set Send Data*/
 					notify_data.p_data = (uint8_t*)&daily_data;
 					notify_data.p_len  = &notify_size ;
-					GetBleCntHandle(&cnt_handle);
 					DEBUG_LOG(LOG_DEBUG,"single day log send w %u, r %u, d %u, sid %u",daily_data.walk,daily_data.run,daily_data.dash,daily_data.sid);
-					ble_err_code = sd_ble_gatts_hvx(cnt_handle,&notify_data);
+					/* 2026.10.19 Modify Notify Queue経由で送信 (Queue Full時は従来のRetryで再送) */
+					ble_err_code = NotifyQueueSendParam(&notify_data);
 					if(ble_err_code != NRF_SUCCESS)
 					{
 						/* Retry Event Setting*/
@@ -631,8 +637,8 @@ uint32_t SendSingleDailyLog(PEVT_ST pEvent)
 			/* Set Send Data*/
 			notify_data.p_data = (uint8_t*)&daily_data;
 			notify_data.p_len  = &notify_size;
-			GetBleCntHandle(&cnt_handle);
-			ble_err_code = sd_ble_gatts_hvx(cnt_handle,&notify_data);
+			/* 2026.10.19 Modify Notify Queue経由で送信 (Queue Full時は従来のRetryで再送) */
+			ble_err_code = NotifyQueueSendParam(&notify_data);
 			DEBUG_LOG(LOG_INFO,"single daily log end data w %u, r %u, d %u, sid %u",daily_data.walk,daily_data.run,daily_data.dash,daily_data.sid);
 			if(ble_err_code != NRF_SUCCESS)
 			{
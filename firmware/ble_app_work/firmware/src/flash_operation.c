@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/17       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         init_wait_writeのsid/checkTimeを初期化 (RTC取得失敗時は未設定)
   ******************************************************************************************
 */
 
@@ -712,8 +713,10 @@ static uint32_t init_wait_write(PEVT_ST pEvent)
 	uint32_t fifo_err;
 	EVT_ST event;
 #endif
-	uint16_t sid;
-	bool checkTime;
+	/* 2026.10.19 Modify 初期化 (daily_log_erase_prepareはRTC取得失敗時に設定しない) ++ */
+	uint16_t sid = 0;
+	bool checkTime = false;
+	/* 2026.10.19 Modify 初期化 -- */
 	
 	p_fs_api = &nrf_fstorage_sd;
 	
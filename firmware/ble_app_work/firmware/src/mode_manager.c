@@ -10,6 +10,14 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/24       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Raw Data/RSSIの送信をNotify Queue経由に変更
+  * 1.2            2026/10/19       k.tashiro         Mode変更時にBLE Profileを切り替え
+  * 1.3            2026/10/19       k.tashiro         RunAlgoのsprintf LogをToken Logに変更
+  * 1.4            2026/10/19       k.tashiro         RunAlgoの処理時間をEnergy Profilerで計測
+  * 1.5            2026/10/19       k.tashiro         DAILY ModeでActivity Classifierを並行して動かす
+  * 1.6            2026/10/19       k.tashiro         walk_algo.hのInclude名を実Fileに合わせる (Host Build)
+  * 1.7            2026/10/19       k.tashiro         bcc_createをlib_bccに移動 (Microbenchmark対応)
+  * 1.8            2026/10/19       k.tashiro         Ultimate ResultのBuffer超過を修正, 未初期化変数を修正 (Host Build -Werror)
   ******************************************************************************************
 */
 
@@ -28,15 +36,21 @@
 #include "lib_bat.h"
 #include "lib_ex_rtc.h"
 #include "algo_acc.h"
-#include "Walk_Algo.h"
+#include "walk_algo.h"
 #include "daily_log.h"
 #include "definition.h"
+#include "lib_notify_queue.h"
+#include "lib_ble_profile.h"
+#include "lib_energy_prof.h"
 #include "nrf_fstorage.h"
 #include "nrf_fstorage_sd.h"
 #include "flash_operation.h"
 #include "lib_trace_log.h"
+#include "lib_token_log.h"
 #include "nrf_delay.h"
 #include "lib_angle_flash.h"
+#include "activity_algo.h"		/* 2026.10.19 Add */
+#include "lib_bcc.h"				/* 2026.10.19 Add */
 
 #include "time.h"
 
@@ -112,7 +126,6 @@ volatile static uint16_t g_current_raw_mode = RAW_MODE;
 /* 2020.10.28 Add Raw Mode追加 -- */
 
 /* 2020.12.08 Add BLE再送処理 ++ */
-volatile static bool g_notify_failed = false;
 volatile static uint16_t g_fifo_clear_sid = 0;
 /* 2020.12.08 Add BLE再送処理 -- */
 
@@ -155,7 +168,7 @@ static uint32_t end_trigger_timeout_func(PEVT_ST pEvent);
 static uint32_t erase_log_one(PEVT_ST pEvent);
 static void init_offset_cal_global_var(void);
 static void clear_tmp_acc_offset(void);
-static uint8_t bcc_create(uint8_t *str, uint32_t len);	//raw data bcc
+/* 2026.10.19 Delete bcc_createはlib_bccに移動 */
 /* 2022.01.26 Add RawData送信中のRTC処理 ++ */
 static uint32_t raw_data_sending_rtc_proc( PEVT_ST pEvent );
 /* 2022.01.26 Add RawData送信中のRTC処理 -- */
@@ -462,6 +475,33 @@ static void pin_code_check_flag_get(bool *pPincodeCheckFlag)
 	}
 }
 
+/* 2026.10.19 Add BLE Profile ++ */
+/**
+ * @brief 現在のModeに合わせてBLE Profileを切り替え
+ * @param None
+ * @retval None
+ */
+static void ble_profile_mode_update(void)
+{
+	BLE_PROFILE_ID profile;
+
+	switch(gpCurrOPmode->currOP_id)
+	{
+	case DAILY_MODE:
+		profile = BLE_PROFILE_LOW_POWER;
+		break;
+	case RAW_MODE:
+		profile = BLE_PROFILE_BULK;
+		break;
+	default:
+		/* Ult Mode / Calibration */
+		profile = BLE_PROFILE_REALTIME;
+		break;
+	}
+	BleProfileChange(profile);
+}
+/* 2026.10.19 Add BLE Profile -- */
+
 /**
  * @brief operation mode change.
  * @param pEvent Event Information
@@ -505,7 +545,6 @@ static uint32_t operation_mode_change(PEVT_ST pEvent)
 			/* Raw Modeはどのモードの場合も同様のモードにする */
 			mode = RAW_MODE;
 			/* 2020.12.08 Add 送信データの初期化を追加 ++ */
-			g_notify_failed = false;
 			memset( (void *)&gRawData, 0, sizeof( gRawData ) );
 			/* 2020.12.08 Add 送信データの初期化を追加 -- */
 			/* 2020.12.08 Add BLE Tx Complete時の処理を有効に設定 ++ */
@@ -701,6 +740,8 @@ static uint32_t operation_mode_change(PEVT_ST pEvent)
 		//the five hour timeout restart.
 		RestartForceDisconTimer();
 	}
+	/* 2026.10.19 Add BLE Profile */
+	ble_profile_mode_update();
 	
 	return 0;
 }
@@ -968,6 +1009,7 @@ static uint32_t recieve_ult_trriger(PEVT_ST pEvent)
 
 	//curr trigger send
 	gpCurrOPmode->currTrigger = pEvent->DATA.modeTrigger.trigger;
+	mode = gpCurrOPmode->currOP_id;		/* 2026.10.19 Modify END Trigger以外のRAW_MODE判定でも使う */
 	if(pEvent->DATA.modeTrigger.trigger == ULT_END_TRIGGER)
 	{
 		//FW 9.00 version
@@ -1034,7 +1076,8 @@ static uint32_t recieve_ult_trriger(PEVT_ST pEvent)
 		else
 		{
 			resultdata[0] = gpCurrOPmode->currOP_id;
-			memcpy(&resultdata[1], &(gpCurrOPmode->RESULTDATA), sizeof(gpCurrOPmode->RESULTDATA));
+			/* 2026.10.19 Modify RESULTDATAはRAW_DATAを含むUnion(16byte). Resultは先頭のULT_DATA_SIZE分 */
+			memcpy(&resultdata[1], &(gpCurrOPmode->RESULTDATA), sizeof(resultdata) - 1);
 		
 			GetGattsCharHandleValueID(&gatts_value_handle,MODE_RESULT_ID);
 			SetBleNotifyCmd(gatts_value_handle, resultdata,sizeof(resultdata));
@@ -1525,6 +1568,8 @@ void ForceChangeDailyMode(void)
 			{
 				//nothing to do
 			}
+			/* 2026.10.19 Add BLE Profile */
+			ble_profile_mode_update();
 		}
 	}
 }
@@ -1810,11 +1855,8 @@ uint32_t RunAlgo(PEVT_ST pEvent)
 	SKYJUMPCOUNT ultTimeRes;
 	DAILYCOUNT walkCount;
 	uint8_t walk_result[WALK_COUNT_DATA_SIZE];
-	ble_gatts_hvx_params_t notify_data;
 	/*test raw data*/
 	uint32_t err_code;
-	uint16_t cnt_handle = BLE_CONN_HANDLE_INVALID;
-	uint16_t notify_size;
 	uint16_t id_handle;
 	static bool display_log = false;
 	/* 2022.05.19 Add 角度調整 ++ */
@@ -1822,6 +1864,7 @@ uint32_t RunAlgo(PEVT_ST pEvent)
 	ACC_RESULT acc_angle_result = {0};
 	uint8_t notify_signal;
 	/* 2022.05.19 Add 角度調整 -- */
+	ACTIVITY_RESULT activity_result;		/* 2026.10.19 Add */
 #ifdef TEST_FIFO_COUNT_NOTIFY
 	uint16_t fifo_index = 0;
 #endif
@@ -1830,39 +1873,16 @@ uint32_t RunAlgo(PEVT_ST pEvent)
 #if LOG_LEVEL_MODE_MGR <= LOG_LEVEL		/* 2020.10.26 Add LOG_LEVELで出力するかどうかを決定する */
 	uint8_t buffer[64] = {0};
 #endif
+	ENERGY_PROF_ENTER( EP_SUB_ALGO );		/* 2026.10.19 Add FIFO読み出しを含めてAlgorithmとして計測 */
+
 	/* 2020.12.09 Add FIFO Countが0以上の場合FIFOをクリアする ++ */
 	AccGyroValidateClearFifo();
 	/* 2020.12.09 Add FIFO Countが0以上の場合FIFOをクリアする -- */
 	
-	/* 2020.12.08 Add 再送処理修正 ++ */
-	if ( ( g_notify_failed == true ) && ( gpCurrOPmode->currOP_id == RAW_MODE ) )
-	{
-		/*Notify up*/
-		/*retry proccess nashi*/
-		GetBleCntHandle( &cnt_handle );
-		/*notify up*/
-		GetGattsCharHandleValueID( &id_handle, RAW_DATA_ID );
-		
-		notify_size = sizeof( gRawData );
-		notify_data.handle	= id_handle;
-		notify_data.type	= BLE_GATT_HVX_NOTIFICATION;
-		notify_data.offset	= BLE_NOTIFY_OFFSET;
-		notify_data.p_len	= &notify_size;
-		notify_data.p_data	= (uint8_t *)&gRawData;
-		
-		err_code = sd_ble_gatts_hvx( cnt_handle, &notify_data );
-		if( ( err_code == NRF_ERROR_BUSY ) || ( err_code == NRF_ERROR_RESOURCES ) )
-		{
-			/* 失敗した場合はすぐに抜ける */
-			return 0;
-		}
-		g_notify_failed = false;
-		memset( (void *)&gRawData, 0, sizeof( gRawData ) );
-	}
-	/* 2020.12.08 Add 再送処理修正 -- */
-	
 	gpResult = &walk_result;
-	for(i = 0; (NRF_ERROR_NULL != AccGyroPopFifo(&acc_gyro_data)); i++)
+	/* 2026.10.19 Modify 再送はNotify Queueで行う. RAW ModeでQueue Fullの間はSensor FIFOに残しTX Complete後に処理する */
+	for(i = 0; ( ( gpCurrOPmode->currOP_id != RAW_MODE ) || ( NotifyQueueIsFull() == false ) ) &&
+		( NRF_ERROR_NULL != AccGyroPopFifo(&acc_gyro_data) ); i++)
 	{
 		if(gpCurrOPmode->currOP_id == CALIB_MEAS_MODE)
 		{
@@ -1906,9 +1926,6 @@ uint32_t RunAlgo(PEVT_ST pEvent)
 				g_send_sid_init = true;
 				/* 2022.03.17 Add 送信SID処理を変更 -- */
 			}
-			/* 2020.12.08 Add BLE再送処理追加 ++ */
-			g_notify_failed = false;
-			/* 2020.12.08 Add BLE再送処理追加 -- */
 			display_log = false;
 			/* 2020.10.28 Modify RAW Data送信処理を修正 ++ */
 			/* Timestamp */
@@ -1944,7 +1961,7 @@ uint32_t RunAlgo(PEVT_ST pEvent)
 			 */
 			memcpy( (void *)&gRawData[3], (void *)&gRawBox, sizeof( gRawData ) - 4 );
 			/*bcc create*/
-			gRawData[RAW_DATA_SIZE - 1] = bcc_create( (void *)&gRawData[0], sizeof( gRawData ) - 1 );;
+			gRawData[RAW_DATA_SIZE - 1] = BccCreate( (void *)&gRawData[0], sizeof( gRawData ) - 1 );	/* 2026.10.19 Modify lib_bcc */
 			/* 2020.10.28 Modify RAW Data送信処理を修正 -- */
 #if 0
 			sprintf( (char *)buffer, "%x,%x,%x,%x,%x,%x,%x,%x,%x,%x,%x,%x,%x,%x,%x,%x,%x,%x,%x,%x\r\n",
@@ -1955,27 +1972,16 @@ uint32_t RunAlgo(PEVT_ST pEvent)
 			DEBUG_LOG_DIRECT( (char *)buffer, strlen( (char *)buffer ) );
 #endif
 			/*Notify up*/
-			/*retry proccess nashi*/
-			GetBleCntHandle( &cnt_handle );
-			/*notify up*/
 			GetGattsCharHandleValueID( &id_handle, RAW_DATA_ID );
-			
-			notify_size = sizeof( gRawData );
-			notify_data.handle	= id_handle;
-			notify_data.type	= BLE_GATT_HVX_NOTIFICATION;
-			notify_data.offset	= BLE_NOTIFY_OFFSET;
-			notify_data.p_len	= &notify_size;
-			notify_data.p_data	= (uint8_t *)&gRawData;
-
-			/* 2020.12.08 Add 再送処理修正 ++ */
-			err_code = sd_ble_gatts_hvx( cnt_handle, &notify_data );
-			if( ( err_code == NRF_ERROR_BUSY ) || ( err_code == NRF_ERROR_RESOURCES ) )
+
+			/* 2026.10.19 Modify Notify Queue経由で送信 (Payloadはコピーされる) ++ */
+			err_code = NotifyQueueSend( id_handle, (uint8_t *)&gRawData, sizeof( gRawData ) );
+			if ( err_code != NRF_SUCCESS )
 			{
-				/* 送信がエラーの場合、gRawDataをクリアせずに抜ける */
-				g_notify_failed = true;
-				break;
+				/* Queue Full判定後のため通常は来ない. 破棄数はNotify Queueでカウント */
+				DEBUG_LOG( LOG_ERROR, "raw notify drop 0x%x", err_code );
 			}
-			/* 2020.12.08 Add 再送処理修正 -- */
+			/* 2026.10.19 Modify Notify Queue経由で送信 (Payloadはコピーされる) -- */
 			memset( (void *)&gRawData, 0, sizeof( gRawData ) );
 		}
 		else
@@ -1991,11 +1997,9 @@ uint32_t RunAlgo(PEVT_ST pEvent)
 					{
 						/* 補正データ保存 */
 						SetAngleAdjustInfo( &acc_angle_info );
-#if 1
-						uint8_t buffer[128] = {0};
-						sprintf( (char *)buffer, "roll: %f, pitch: %f, yaw: %f", acc_angle_info.roll, acc_angle_info.pitch, acc_angle_info.yaw );
-						DEBUG_LOG( LOG_INFO, "%s", buffer );
-#endif
+						/* 2026.10.19 Modify sprintf(%f)をToken Logに変更 */
+						TOKEN_LOG3( TL_ALGO_ANGLE_ADJUST, TOKEN_LOG_FLOAT( acc_angle_info.roll ),
+									TOKEN_LOG_FLOAT( acc_angle_info.pitch ), TOKEN_LOG_FLOAT( acc_angle_info.yaw ) );
 						/* Disableに変更 */
 						ChangeAngleAdjustState( ANGLE_ADJUST_STOP );
 						
@@ -2035,13 +2039,25 @@ uint32_t RunAlgo(PEVT_ST pEvent)
 			/* 2022.05.19 Add 角度調整 -- */
 
 #if LOG_LEVEL_MODE_MGR <= LOG_LEVEL		/* 2020.10.26 Add LOG_LEVELで出力するかどうかを決定する */
-			sprintf( (char *)buffer, "acc data %d, x %d, y %d, z %d\r\n", i, (acc_gyro_data.acc_x_data - gAccXoffset),(acc_gyro_data.acc_y_data - gAccYoffset),(acc_gyro_data.acc_z_data - gAccZoffset) );
-			DEBUG_LOG_DIRECT( (char *)buffer, strlen( (char *)buffer ) );
+			/* 2026.10.19 Modify sprintfをToken Logに変更 */
+			TOKEN_LOG4( TL_ALGO_ACC_DATA, i, (acc_gyro_data.acc_x_data - gAccXoffset), (acc_gyro_data.acc_y_data - gAccYoffset), (acc_gyro_data.acc_z_data - gAccZoffset) );
 			//DEBUG_LOG(LOG_DEBUG,"acc data %u, x %d, y %d, z %d", i, (acc_gyro_data.acc_gyro_x_data - gAccXoffset),(acc_gyro_data.acc_gyro_y_data - gAccYoffset),(acc_gyro_data.acc_gyro_z_data - gAccZoffset));
 #endif
 			/* 2020.11.26 Add ACCデータのX,Y Axisが反転しているため-1をかけてアルゴリズムへ渡すように修正 ++ */
 			algo_ret = GetWalkResult((acc_gyro_data.acc_x_data - gAccXoffset) * -1, (acc_gyro_data.acc_z_data - gAccZoffset), gAlgoSid, gpCurrOPmode->currOP_id, &retainNo, gpResult);
 			/* 2020.11.26 Add ACCデータのX,Y Axisが反転しているため-1をかけてアルゴリズムへ渡すように修正 -- */
+			/* 2026.10.19 Add 3軸のActivity Classifierを同じ2s窓で並行して動かす (結果はToken Logのみ) ++ */
+			if ( gpCurrOPmode->currOP_id == DAILY_MODE )
+			{
+				/* 学習Session (TL_ALGO_ACC_DATA) と同じくOffset補正のみで渡す */
+				if ( ActivityAddSample( (acc_gyro_data.acc_x_data - gAccXoffset), (acc_gyro_data.acc_y_data - gAccYoffset),
+										(acc_gyro_data.acc_z_data - gAccZoffset), NULL, &activity_result ) == ALGO_SUCCESS )
+				{
+					TOKEN_LOG4( TL_ALGO_ACTIVITY, gAlgoSid, activity_result.class_id,
+								activity_result.feature[ACT_FEAT_ENERGY], activity_result.feature[ACT_FEAT_PEAK_INTERVAL] );
+				}
+			}
+			/* 2026.10.19 Add 3軸のActivity Classifierを同じ2s窓で並行して動かす (結果はToken Logのみ) -- */
 			gAlgoSid++;
 			if(1 == algo_ret)
 			{
@@ -2127,6 +2143,7 @@ uint32_t RunAlgo(PEVT_ST pEvent)
 	//AccGyroEnableGpioInt( ACC_INT1_PIN );
 	/* 2020.10.26 Add ACC/Gyro Interrupt Enable -- */
 
+	ENERGY_PROF_EXIT();						/* 2026.10.19 Add */
 	return 0;
 }
 
@@ -2140,6 +2157,7 @@ void AlgoDataReset(void)
 	gAlgoSid = 0;
 	g_temp_sid = 0;
 	StorageReset();
+	ActivityReset();		/* 2026.10.19 Add */
 }
 
 /**
@@ -2210,8 +2228,8 @@ uint32_t RunAlgoPreDeepSleep(PEVT_ST pEvent)
 		/* 2022.03.18 Add ADV判定処理追加 -- */
 
 #if LOG_LEVEL_MODE_MGR <= LOG_LEVEL		/* 2020.10.26 Add LOG_LEVELで出力するかどうかを決定する */
-		sprintf( (char *)buffer, "acc data %u, x %d, y %d, z %d, %u\r\n", i, (acc_gyro_data.acc_x_data - gAccXoffset),(acc_gyro_data.acc_y_data - gAccYoffset),(acc_gyro_data.acc_z_data - gAccZoffset), gAlgoSid );
-		DEBUG_LOG_DIRECT( (char *)buffer, strlen( (char *)buffer ) );
+		/* 2026.10.19 Modify sprintfをToken Logに変更 */
+		TOKEN_LOG5( TL_ALGO_PRE_SLEEP_ACC, i, (acc_gyro_data.acc_x_data - gAccXoffset), (acc_gyro_data.acc_y_data - gAccYoffset), (acc_gyro_data.acc_z_data - gAccZoffset), gAlgoSid );
 		//DEBUG_LOG(LOG_DEBUG,"acc data %u, x %d, y %d, z %d, %u ", i, (acc_gyro_data.acc_gyro_x_data - gAccXoffset),(acc_gyro_data.acc_gyro_y_data - gAccYoffset),(acc_gyro_data.acc_gyro_z_data - gAccZoffset), gAlgoSid);
 #endif
 		/* 2020.11.26 Add ACCデータのX,Y Axisが反転しているため-1をかけてアルゴリズムへ渡すように修正 ++ */
@@ -2305,9 +2323,9 @@ uint32_t RunAlgoAdv(PEVT_ST pEvent)
 		time_tmep_result = acc_gyro_data.timestamp - time_proc;
 		time_result = time_tmep_result * 16;
 		time_proc = acc_gyro_data.timestamp;
-		sprintf( (char *)buffer, "acc data %u, tm %x, x %d, y %d, z %d, %u\r\n", i, acc_gyro_data.timestamp, (acc_gyro_data.acc_x_data - gAccXoffset), (acc_gyro_data.acc_y_data - gAccYoffset),(acc_gyro_data.acc_z_data - gAccZoffset), gAlgoSid );
+		/* 2026.10.19 Modify sprintfをToken Logに変更 */
+		TOKEN_LOG6( TL_ALGO_ADV_ACC, i, acc_gyro_data.timestamp, (acc_gyro_data.acc_x_data - gAccXoffset), (acc_gyro_data.acc_y_data - gAccYoffset), (acc_gyro_data.acc_z_data - gAccZoffset), gAlgoSid );
 		//sprintf( (char *)buffer, "time: %d timestamp: %d, %d\r\n", time_result, acc_gyro_data.timestamp, time_tmep_result );
-		DEBUG_LOG_DIRECT( (char *)buffer, strlen( (char *)buffer ) );
 		//DEBUG_LOG(LOG_DEBUG,"acc data %u, x %d, y %d, z %d, %u ", i, (acc_gyro_data.acc_gyro_x_data - gAccXoffset),(acc_gyro_data.acc_gyro_y_data - gAccYoffset),(acc_gyro_data.acc_gyro_z_data - gAccZoffset), gAlgoSid);
 #endif
 		/* 2020.11.26 Add ACCデータのX,Y Axisが反転しているため-1をかけてアルゴリズムへ渡すように修正 ++ */
@@ -2504,24 +2522,6 @@ static void clear_tmp_acc_offset(void)
 	gZOffset = DEFAULT_SENSOR_OFFSET;	
 }
 
-/**
- * @brief BCC Create
- * @param str 計算するデータ
- * @param len 計算するデータ長
- * @retval BCC_Val XORデータ
- */
-static uint8_t bcc_create(uint8_t *str, uint32_t len)
-{
-	uint8_t BCC_Val = 0;
-
-	while(len--)
-	{
-		BCC_Val ^= *str;
-		str++;
-	}
-	return BCC_Val;
-}
-
 /**
  * @brief Y Axis ADV
  * @param pEvent Event Information
@@ -2541,7 +2541,7 @@ uint16_t GetClearSid( void )
 {
 	uint32_t err;
 	uint8_t clear_sid_sec;
-	uint16_t sid;
+	uint16_t sid = 0;		/* 2026.10.19 Modify 初期化 */
 	
 	err = sd_nvic_critical_region_enter(&clear_sid_sec);
 	if(err == NRF_SUCCESS)
@@ -2707,25 +2707,17 @@ static uint32_t get_rssi_notify( PEVT_ST pEvent )
 {
 	uint32_t err_code;
 	uint16_t cnt_handle = BLE_CONN_HANDLE_INVALID;
-	uint16_t notify_size = 2;
 	uint16_t id_handle;
 	int16_t rssi = 0;
-	ble_gatts_hvx_params_t notify_data;
 
 	GetRssiValue( &rssi );
 
-	/*retry proccess nashi*/
-	GetBleCntHandle( &cnt_handle );
 	/* notify */
 	GetGattsCharHandleValueID( &id_handle, RSSI_NOTIFY_ID );
 	
-	notify_data.handle	= id_handle;
-	notify_data.type	= BLE_GATT_HVX_NOTIFICATION;
-	notify_data.offset	= BLE_NOTIFY_OFFSET;
-	notify_data.p_len	= &notify_size;
-	notify_data.p_data	= (uint8_t *)&rssi;
-	err_code = sd_ble_gatts_hvx( cnt_handle, &notify_data );
-	if ( ( err_code == NRF_ERROR_TIMEOUT ) || ( err_code == NRF_ERROR_RESOURCES ) )
+	/* 2026.10.19 Modify Notify Queue経由で送信. Queue Full(NO_MEM)が続く場合も切断対象 */
+	err_code = NotifyQueueSend( id_handle, (uint8_t *)&rssi, sizeof( rssi ) );
+	if ( ( err_code == NRF_ERROR_TIMEOUT ) || ( err_code == NRF_ERROR_RESOURCES ) || ( err_code == NRF_ERROR_NO_MEM ) )
 	{
 		g_force_disconnect_count++;
 		/* 3回失敗した際に強制切断を実行(5秒 x 3 = 15秒) */
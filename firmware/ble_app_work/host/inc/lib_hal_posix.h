@@ -0,0 +1,107 @@
+/**
+  ******************************************************************************************
+  * @file    lib_hal_posix.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Hardware Abstraction Layer (Linux実装) の設定/統計
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         RTC割込みでの起動を追加, HalPosixTraceLogをTrace ID番号の出力に変更
+  ******************************************************************************************
+*/
+
+#ifndef LIB_HAL_POSIX_H_
+#define LIB_HAL_POSIX_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include "lib_hal.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*
+ * 時間は仮想時間で, HalWaitEventが次のEvent (Timer/IMUのODR) まで一気に進める.
+ * IMU (ICM-42607) : SPIのRegister Model. 加速度はTrace (CSV: t_ms,ax_mg,ay_mg,az_mg) を
+ *                   ODR毎にSample & Holdで読み出し, WOM (差分) でACC_INT1_PINの割込みを起こす
+ * RTC (BL5372)    : TWIのRegister Model. 時刻はrtc_start + 仮想時間
+ * Flash           : HAL_FLASH_START_ADDR - HAL_FLASH_END_ADDRをFileに保存 (消去状態は0xFF)
+ * Notify/Adv      : 標準出力に1行ずつ出力
+ */
+
+/* Definition ------------------------------------------------------------*/
+#define HAL_POSIX_TAIL_MS			(5000)		/* Trace終了後に動かす時間 [ms] (初期値) */
+
+/* Struct ----------------------------------------------------------------*/
+/* 設定 */
+typedef struct _hal_posix_config
+{
+	const char *trace_path;		/* IMU Trace (CSV) */
+	const char *flash_path;		/* Flash File (NULL:保存しない) */
+	time_t rtc_start;			/* 再生開始時のRTC時刻 (UTC) */
+	bool rtc_wakeup;			/* true:RTC割込みでSystem OFFから起動 (false:電源投入. RTCは初期値に戻される) */
+	uint32_t tail_ms;			/* Trace終了後に動かす時間 [ms] */
+	bool verbose;				/* true:SPI/TWI/Timerも出力 */
+} HAL_POSIX_CONFIG, *PHAL_POSIX_CONFIG;
+
+/* 統計 (回帰試験で比較する) */
+typedef struct _hal_posix_stats
+{
+	uint64_t time_ms;			/* 経過した仮想時間 [ms] */
+	uint32_t wake;				/* HalWaitEventから戻った回数 */
+	uint32_t timer_fire;		/* Timer Handler呼び出し回数 */
+	uint32_t gpio_int;			/* GPIO割込み回数 */
+	uint32_t spi_xfer;			/* SPI転送回数 */
+	uint32_t spi_bytes;			/* SPI転送Byte数 */
+	uint32_t twi_xfer;			/* TWI転送回数 */
+	uint32_t flash_write_bytes;	/* Flash書き込みByte数 */
+	uint32_t flash_erase;		/* Flash消去Page数 */
+	uint32_t notify;			/* Notify回数 */
+	uint32_t adv_update;		/* Advertising更新回数 */
+	uint32_t adv_alarm;			/* うちAlarm */
+	uint32_t trace_log;			/* TRACE_LOG回数 */
+} HAL_POSIX_STATS, *PHAL_POSIX_STATS;
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief Linux実装の初期化 (Traceの読み込み, Flash Fileを開く)
+ * @param p_config 設定
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalPosixInit( const HAL_POSIX_CONFIG *p_config );
+
+/**
+ * @brief Linux実装の終了 (Flash Fileに書き戻す)
+ * @param None
+ * @retval None
+ */
+void HalPosixUninit( void );
+
+/**
+ * @brief 統計を取得
+ * @param p_stats 格納先
+ * @retval None
+ */
+void HalPosixGetStats( HAL_POSIX_STATS *p_stats );
+
+/**
+ * @brief TRACE_LOGの出力先 (host/src/lib_trace_log_posix.c)
+ * @param func_no Function Number
+ * @param param Parameter
+ * @retval None
+ */
+void HalPosixTraceLog( uint16_t func_no, uint16_t param );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
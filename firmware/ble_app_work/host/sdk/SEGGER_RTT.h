@@ -0,0 +1,22 @@
+/**
+  ******************************************************************************************
+  * @file    SEGGER_RTT.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Host Build用 SEGGER_RTT.h (定義はsdk_host.h)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+#ifndef SEGGER_RTT_H_
+#define SEGGER_RTT_H_
+
+/* Includes --------------------------------------------------------------*/
+#include "sdk_host.h"
+
+#endif
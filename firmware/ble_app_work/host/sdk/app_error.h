@@ -0,0 +1,22 @@
+/**
+  ******************************************************************************************
+  * @file    app_error.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Host Build用 app_error.h (定義はsdk_host.h)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+#ifndef APP_ERROR_H_
+#define APP_ERROR_H_
+
+/* Includes --------------------------------------------------------------*/
+#include "sdk_host.h"
+
+#endif
@@ -0,0 +1,22 @@
+/**
+  ******************************************************************************************
+  * @file    app_fifo.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Host Build用 app_fifo.h (定義はsdk_host.h)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+#ifndef APP_FIFO_H_
+#define APP_FIFO_H_
+
+/* Includes --------------------------------------------------------------*/
+#include "sdk_host.h"
+
+#endif
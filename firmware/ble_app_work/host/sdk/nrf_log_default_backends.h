@@ -0,0 +1,22 @@
+/**
+  ******************************************************************************************
+  * @file    nrf_log_default_backends.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Host Build用 nrf_log_default_backends.h (定義はsdk_host.h)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+#ifndef NRF_LOG_DEFAULT_BACKENDS_H_
+#define NRF_LOG_DEFAULT_BACKENDS_H_
+
+/* Includes --------------------------------------------------------------*/
+#include "sdk_host.h"
+
+#endif
@@ -0,0 +1,22 @@
+/**
+  ******************************************************************************************
+  * @file    peer_manager_handler.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Host Build用 peer_manager_handler.h (定義はsdk_host.h)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+#ifndef PEER_MANAGER_HANDLER_H_
+#define PEER_MANAGER_HANDLER_H_
+
+/* Includes --------------------------------------------------------------*/
+#include "sdk_host.h"
+
+#endif
@@ -0,0 +1,976 @@
+/**
+  ******************************************************************************************
+  * @file    sdk_host.h
+  * @author  k.tashiro
+  * @version 1.3
+  * @date    2026/10/19
+  * @brief   nRF5 SDK / SoftDevice (Host Build用). host/sdk/のSDK Header名はすべてこれをIncludeする
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         current_int_priority_get, app_error_fault_handler, NVIC_SystemResetを追加 (Fault時のTraceFlush)
+  * 1.2            2026/10/19       k.tashiro         Data Length, Radio Notification, Connection Parameter Update eventを追加 (lib_ble_profile)
+  * 1.3            2026/10/19       k.tashiro         HVN TX Complete eventを追加 (lib_notify_queue)
+  ******************************************************************************************
+*/
+
+#ifndef SDK_HOST_H_
+#define SDK_HOST_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "sdk_config.h"
+#include "lib_hal.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*
+ * main.c, library/, firmware/src/, algorithm/src/をそのままBuildするためのSDKの代わり.
+ * 型/Macroは使われている分だけをSDKと同じ名前で宣言する. 実装はhost/src/sdk_host.c
+ *   app_timer      : HalTimerCreate/Start/Stop (Counterは仮想時間)
+ *   nrf_delay      : HalDelayUs/Ms
+ *   nrf_pwr_mgmt   : HalWaitEvent (Traceが終わったらhost/src/sdk_host.cで終了する)
+ *   SEGGER_RTT     : Channel 0を標準Errorに出力
+ *   NRF_LOG        : 出力しない (引数は評価する)
+ *   SoftDevice/BLE : 何もせずNRF_SUCCESSを返す. Advertisingの内容はHalAdvInit/HalAdvUpdate
+ * 割込みは起きないためCritical Section/排他命令は何もしない
+ */
+
+/* Definition ------------------------------------------------------------*/
+/* nrf_error.h (lib_hal.hのHAL_xxxと共通の値) */
+#define NRF_ERROR_BASE_NUM			(0x0)
+#define NRF_ERROR_SDM_BASE_NUM		(0x1000)
+#define NRF_ERROR_SOC_BASE_NUM		(0x2000)
+#define NRF_ERROR_STK_BASE_NUM		(0x3000)
+#define NRF_SUCCESS					HAL_SUCCESS
+#define NRF_ERROR_SVC_HANDLER_MISSING	(1)
+#define NRF_ERROR_SOFTDEVICE_NOT_ENABLED	(2)
+#define NRF_ERROR_INTERNAL			HAL_ERROR_INTERNAL
+#define NRF_ERROR_NO_MEM			HAL_ERROR_NO_MEM
+#define NRF_ERROR_NOT_FOUND			HAL_ERROR_NOT_FOUND
+#define NRF_ERROR_NOT_SUPPORTED		(6)
+#define NRF_ERROR_INVALID_PARAM		HAL_ERROR_INVALID_PARAM
+#define NRF_ERROR_INVALID_STATE		HAL_ERROR_INVALID_STATE
+#define NRF_ERROR_INVALID_LENGTH	HAL_ERROR_INVALID_LENGTH
+#define NRF_ERROR_INVALID_FLAGS		(10)
+#define NRF_ERROR_INVALID_DATA		(11)
+#define NRF_ERROR_DATA_SIZE			(12)
+#define NRF_ERROR_TIMEOUT			HAL_ERROR_TIMEOUT
+#define NRF_ERROR_NULL				(14)
+#define NRF_ERROR_FORBIDDEN			(15)
+#define NRF_ERROR_INVALID_ADDR		HAL_ERROR_INVALID_ADDR
+#define NRF_ERROR_BUSY				HAL_ERROR_BUSY
+#define NRF_ERROR_CONN_COUNT		(18)
+#define NRF_ERROR_RESOURCES			(19)
+#define NRF_ERROR_MODULE_NOT_INITIALIZED	(0x8000)
+#define BLE_ERROR_INVALID_CONN_HANDLE	(NRF_ERROR_STK_BASE_NUM + 0x002)
+#define BLE_ERROR_GATTS_SYS_ATTR_MISSING	(NRF_ERROR_STK_BASE_NUM + 0x401)
+
+/* nordic_common.h / app_util.h */
+#define UNUSED_PARAMETER( X )		(void)(X)
+#define UNUSED_VARIABLE( X )		(void)(X)
+#define UNUSED_RETURN_VALUE( X )	(void)(X)
+#ifndef MIN
+#define MIN( a, b )					( ( (a) < (b) ) ? (a) : (b) )
+#endif
+#ifndef MAX
+#define MAX( a, b )					( ( (a) < (b) ) ? (b) : (a) )
+#endif
+#define ROUNDED_DIV( A, B )			( ( (A) + ( (B) / 2 ) ) / (B) )
+#define CEIL_DIV( A, B )			( ( (A) + (B) - 1 ) / (B) )
+#define ARRAY_SIZE( arr )			( sizeof( arr ) / sizeof( (arr)[0] ) )
+#define STATIC_ASSERT( EXPR, ... )	_Static_assert( (EXPR), "static assert" )
+#define LSB_16( a )					( (uint8_t)( (a) & 0x00FF ) )
+#define MSB_16( a )					( (uint8_t)( ( (a) & 0xFF00 ) >> 8 ) )
+#define UNIT_0_625_MS				(625)
+#define UNIT_1_25_MS				(1250)
+#define UNIT_10_MS					(10000)
+#define MSEC_TO_UNITS( TIME, RESOLUTION )	( ( (TIME) * 1000 ) / (RESOLUTION) )
+#define __STATIC_INLINE				static inline
+#define __ALIGN( n )				__attribute__(( aligned( n ) ))
+#define __WFE()						do { } while(0)
+#define __WFI()						do { } while(0)
+#define __SEV()						do { } while(0)
+#define __DMB()						__sync_synchronize()
+#define __DSB()						__sync_synchronize()
+#define __ISB()						__sync_synchronize()
+#define __NOP()						do { } while(0)
+
+/* sdk_common.h */
+#define VERIFY_SUCCESS( err_code )	\
+	do { if ( (err_code) != NRF_SUCCESS ) { return (err_code); } } while(0)
+#define VERIFY_PARAM_NOT_NULL( p )	\
+	do { if ( (p) == NULL ) { return NRF_ERROR_NULL; } } while(0)
+#define VERIFY_FALSE( statement, err_code )	\
+	do { if ( (statement) ) { return (err_code); } } while(0)
+#define VERIFY_TRUE( statement, err_code )	\
+	do { if ( !(statement) ) { return (err_code); } } while(0)
+
+/* app_error.h */
+#define APP_ERROR_HANDLER( ERR_CODE )	app_error_handler( (ERR_CODE), __LINE__, (const uint8_t *)__FILE__ )
+#define APP_ERROR_CHECK( ERR_CODE )	\
+	do { const uint32_t _err = (ERR_CODE); if ( _err != NRF_SUCCESS ) { APP_ERROR_HANDLER( _err ); } } while(0)
+#define APP_ERROR_CHECK_BOOL( BOOL )	\
+	do { if ( !(BOOL) ) { APP_ERROR_HANDLER( 0 ); } } while(0)
+#define NRF_FAULT_ID_SDK_ERROR		(0x4001)
+
+/* app_util_platform.h */
+#define CRITICAL_REGION_ENTER()		{ uint8_t __CR_NESTED = 0; HalCriticalEnter( &__CR_NESTED );
+#define CRITICAL_REGION_EXIT()		HalCriticalExit( __CR_NESTED ); }
+#define APP_IRQ_PRIORITY_HIGH		(2)
+#define APP_IRQ_PRIORITY_LOW		(6)
+#define APP_IRQ_PRIORITY_THREAD		(15)
+#define current_int_priority_get()	(APP_IRQ_PRIORITY_THREAD)	/* 割込みがないため常にThread */
+
+/* nrf_log.h */
+#define NRF_LOG_INFO( ... )			nrf_log_none( __VA_ARGS__ )
+#define NRF_LOG_DEBUG( ... )		nrf_log_none( __VA_ARGS__ )
+#define NRF_LOG_WARNING( ... )		nrf_log_none( __VA_ARGS__ )
+#define NRF_LOG_ERROR( ... )		nrf_log_none( __VA_ARGS__ )
+#define NRF_LOG_RAW_INFO( ... )		nrf_log_none( __VA_ARGS__ )
+#define NRF_LOG_HEXDUMP_INFO( p_data, len )		do { (void)(p_data); (void)(len); } while(0)
+#define NRF_LOG_HEXDUMP_DEBUG( p_data, len )	do { (void)(p_data); (void)(len); } while(0)
+#define NRF_LOG_FLOAT_MARKER		"%s%d.%02d"
+#define NRF_LOG_FLOAT( val )		"", (int32_t)(val), (int32_t)( ( (val) - (int32_t)(val) ) * 100 )
+#define NRF_LOG_PUSH( str )			(str)
+#define NRF_LOG_FLUSH()				do { } while(0)
+#define NRF_LOG_FINAL_FLUSH()		do { } while(0)
+#define NRF_LOG_PROCESS()			false
+#define NRF_LOG_INIT( timestamp_func )	NRF_SUCCESS
+#define NRF_LOG_DEFAULT_BACKENDS_INIT()	do { } while(0)
+
+/* SEGGER_RTT.h */
+#define SEGGER_RTT_MODE_NO_BLOCK_SKIP	(0)
+#define SEGGER_RTT_MODE_NO_BLOCK_TRIM	(1)
+
+/* app_timer.h (RTC1 32768Hz, Prescaler 0, 24bit Counter) */
+#define APP_TIMER_CLOCK_FREQ		(32768)
+#define APP_TIMER_MAX_CNT_VAL		(0x00FFFFFF)
+#define APP_TIMER_TICKS( MS )		( (uint32_t)ROUNDED_DIV( (MS) * (uint64_t)APP_TIMER_CLOCK_FREQ, 1000 ) )
+#define APP_TIMER_MIN_TIMEOUT_TICKS	(5)
+#define APP_TIMER_DEF( timer_id )	\
+	static app_timer_t timer_id##_data = { 0 };	\
+	static const app_timer_id_t timer_id = &timer_id##_data
+
+/* nrf_sdh.h / nrf_sdh_ble.h / nrf_sdh_soc.h (Observerは登録するだけで呼ばれない) */
+#define NRF_SDH_BLE_OBSERVER( _name, _prio, _handler, _context )	\
+	static const nrf_sdh_ble_evt_observer_t _name __attribute__(( used )) = { .handler = (_handler), .p_context = (_context) }
+#define NRF_SDH_SOC_OBSERVER( _name, _prio, _handler, _context )	\
+	static const nrf_sdh_soc_evt_observer_t _name __attribute__(( used )) = { .handler = (_handler), .p_context = (_context) }
+
+/* ble_gap.h / ble_gatt.h / ble_hci.h / ble_types.h */
+#define BLE_CONN_HANDLE_INVALID		(0xFFFF)
+#define BLE_CONN_HANDLE_ALL			(0xFFFE)
+#define BLE_GATT_HANDLE_INVALID		(0x0000)
+#define BLE_UUID_TYPE_UNKNOWN		(0x00)
+#define BLE_UUID_TYPE_BLE			(0x01)
+#define BLE_UUID_TYPE_VENDOR_BEGIN	(0x02)
+#define BLE_GATTS_SRVC_TYPE_PRIMARY	(0x01)
+#define BLE_GATTS_VLOC_STACK		(0x01)
+#define BLE_GATT_HVX_NOTIFICATION	(0x01)
+#define BLE_GATT_HVX_INDICATION		(0x02)
+#define BLE_GATT_ATT_MTU_DEFAULT	(23)
+#define BLE_GAP_IO_CAPS_NONE		(0x03)
+#define BLE_GAP_PHY_AUTO			(0x00)
+#define BLE_GAP_PHY_1MBPS			(0x01)
+#define BLE_GAP_PHY_2MBPS			(0x02)
+#define BLE_GAP_DATA_LENGTH_AUTO	(0)
+#define BLE_GAP_DATA_LENGTH_DEFAULT	(27)
+#define NRF_RADIO_NOTIFICATION_DISTANCE_800US	(1)
+#define BLE_GAP_ADV_SET_HANDLE_NOT_SET	(0xFF)
+#define BLE_GAP_ADV_SET_DATA_SIZE_MAX	(31)
+#define BLE_GAP_ADV_TYPE_CONNECTABLE_SCANNABLE_UNDIRECTED	(0x01)
+#define BLE_GAP_ADV_TYPE_NONCONNECTABLE_NONSCANNABLE_UNDIRECTED	(0x03)
+#define BLE_GAP_ADV_FP_ANY			(0x00)
+#define BLE_GAP_ADV_TIMEOUT_GENERAL_UNLIMITED	(0)
+#define BLE_GAP_ADV_FLAG_LE_GENERAL_DISC_MODE	(0x02)
+#define BLE_GAP_ADV_FLAG_BR_EDR_NOT_SUPPORTED	(0x04)
+#define BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE	( BLE_GAP_ADV_FLAG_LE_GENERAL_DISC_MODE | BLE_GAP_ADV_FLAG_BR_EDR_NOT_SUPPORTED )
+#define BLE_GAP_AD_TYPE_FLAGS		(0x01)
+#define BLE_GAP_AD_TYPE_SHORT_LOCAL_NAME	(0x08)
+#define BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME	(0x09)
+#define BLE_GAP_AD_TYPE_APPEARANCE	(0x19)
+#define BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA	(0xFF)
+#define BLE_GAP_DEVNAME_MAX_LEN		(31)
+#define BLE_GAP_CONN_SEC_MODE_SET_OPEN( ptr )	do { (ptr)->sm = 1; (ptr)->lv = 1; } while(0)
+#define BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION	(0x13)
+#define BLE_HCI_CONN_INTERVAL_UNACCEPTABLE	(0x3B)
+#define BLE_GATTS_AUTHORIZE_TYPE_INVALID	(0x00)
+#define BLE_GATTS_AUTHORIZE_TYPE_READ	(0x01)
+#define BLE_GATTS_AUTHORIZE_TYPE_WRITE	(0x02)
+#define BLE_GATT_STATUS_SUCCESS		(0x0000)
+
+/* Event ID */
+#define BLE_GAP_EVT_CONNECTED		(0x10)
+#define BLE_GAP_EVT_DISCONNECTED	(0x11)
+#define BLE_GAP_EVT_CONN_PARAM_UPDATE	(0x12)
+#define BLE_GAP_EVT_SEC_PARAMS_REQUEST	(0x13)
+#define BLE_GAP_EVT_PHY_UPDATE_REQUEST	(0x21)
+#define BLE_GAP_EVT_ADV_SET_TERMINATED	(0x26)
+#define BLE_GAP_EVT_DATA_LENGTH_UPDATE_REQUEST	(0x23)
+#define BLE_GATTC_EVT_TIMEOUT		(0x3A)
+#define BLE_GATTS_EVT_WRITE			(0x50)
+#define BLE_GATTS_EVT_SYS_ATTR_MISSING	(0x52)
+#define BLE_GATTS_EVT_HVC			(0x53)
+#define BLE_GATTS_EVT_TIMEOUT		(0x55)
+#define BLE_GATTS_EVT_HVN_TX_COMPLETE	(0x57)
+
+/* ble_srv_common.h / Service定義 (Instanceを置くだけ) */
+#define BLE_BAS_DEF( _name )		static ble_bas_t _name
+#define NRF_BLE_GATT_DEF( _name )	static nrf_ble_gatt_t _name
+#define NRF_BLE_QWR_DEF( _name )	static nrf_ble_qwr_t _name
+
+/* nrf_fstorage.h */
+#define NRF_FSTORAGE_DEF( inst )	inst
+
+/* nrf.h (IRQ番号) */
+#define UARTE0_UART0_IRQn			(2)
+#define FPU_IRQn					(38)
+
+/* bsp.h */
+#define BSP_INIT_NONE				(0)
+#define BSP_INIT_LEDS				(1 << 0)
+#define BSP_INIT_BUTTONS			(1 << 1)
+
+/* Enum ------------------------------------------------------------------*/
+/* app_timer.h */
+typedef enum
+{
+	APP_TIMER_MODE_SINGLE_SHOT,
+	APP_TIMER_MODE_REPEATED,
+} app_timer_mode_t;
+
+/* ble_advdata.h */
+typedef enum
+{
+	BLE_ADVDATA_NO_NAME,
+	BLE_ADVDATA_SHORT_NAME,
+	BLE_ADVDATA_FULL_NAME,
+} ble_advdata_name_type_t;
+
+/* ble_srv_common.h */
+typedef enum
+{
+	SEC_NO_ACCESS = 0,
+	SEC_OPEN = 1,
+	SEC_JUST_WORKS = 2,
+	SEC_MITM = 3,
+} security_req_t;
+
+/* ble_conn_params.h */
+typedef enum
+{
+	BLE_CONN_PARAMS_EVT_FAILED,
+	BLE_CONN_PARAMS_EVT_SUCCEEDED,
+} ble_conn_params_evt_type_t;
+
+/* bsp.h */
+typedef enum
+{
+	BSP_EVENT_NOTHING = 0,
+	BSP_EVENT_DEFAULT,
+	BSP_EVENT_CLEAR_BONDING_DATA,
+	BSP_EVENT_CLEAR_ALERT,
+	BSP_EVENT_DISCONNECT,
+	BSP_EVENT_ADVERTISING_START,
+	BSP_EVENT_ADVERTISING_STOP,
+	BSP_EVENT_WHITELIST_OFF,
+	BSP_EVENT_BOND,
+	BSP_EVENT_RESET,
+	BSP_EVENT_SLEEP,
+	BSP_EVENT_WAKEUP,
+	BSP_EVENT_SYSOFF,
+	BSP_EVENT_DFU,
+} bsp_event_t;
+
+typedef enum
+{
+	BSP_INDICATE_IDLE,
+	BSP_INDICATE_SCANNING,
+	BSP_INDICATE_ADVERTISING,
+	BSP_INDICATE_ADVERTISING_WHITELIST,
+	BSP_INDICATE_ADVERTISING_SLOW,
+	BSP_INDICATE_ADVERTISING_DIRECTED,
+	BSP_INDICATE_BONDING,
+	BSP_INDICATE_CONNECTED,
+	BSP_INDICATE_SENT_OK,
+	BSP_INDICATE_SEND_ERROR,
+	BSP_INDICATE_RCV_OK,
+	BSP_INDICATE_RCV_ERROR,
+	BSP_INDICATE_FATAL_ERROR,
+	BSP_INDICATE_ALERT_0,
+	BSP_INDICATE_ALERT_OFF,
+	BSP_INDICATE_USER_STATE_OFF,
+	BSP_INDICATE_USER_STATE_ON,
+} bsp_indication_t;
+
+/* peer_manager_types.h */
+typedef enum
+{
+	PM_EVT_BONDED_PEER_CONNECTED,
+	PM_EVT_CONN_SEC_START,
+	PM_EVT_CONN_SEC_SUCCEEDED,
+	PM_EVT_CONN_SEC_FAILED,
+	PM_EVT_PEERS_DELETE_SUCCEEDED,
+	PM_EVT_PEERS_DELETE_FAILED,
+} pm_evt_id_t;
+
+/* Typedef ---------------------------------------------------------------*/
+typedef uint32_t ret_code_t;
+typedef uint32_t nrfx_err_t;
+
+/* app_timer.h */
+typedef void (*app_timer_timeout_handler_t)( void *p_context );
+
+typedef struct
+{
+	uint8_t id;					/* HalTimerCreateのTimer ID */
+	bool created;
+} app_timer_t;
+
+typedef app_timer_t *app_timer_id_t;
+
+/* ble_types.h */
+typedef struct
+{
+	uint16_t uuid;
+	uint8_t type;
+} ble_uuid_t;
+
+typedef struct
+{
+	uint8_t uuid128[16];
+} ble_uuid128_t;
+
+typedef int32_t IRQn_Type;
+
+/* ble_gap.h */
+typedef struct
+{
+	uint8_t sm : 4;
+	uint8_t lv : 4;
+} ble_gap_conn_sec_mode_t;
+
+typedef struct
+{
+	uint16_t min_conn_interval;
+	uint16_t max_conn_interval;
+	uint16_t slave_latency;
+	uint16_t conn_sup_timeout;
+} ble_gap_conn_params_t;
+
+typedef struct
+{
+	uint8_t tx_phys;
+	uint8_t rx_phys;
+} ble_gap_phys_t;
+
+typedef struct
+{
+	uint16_t max_tx_octets;
+	uint16_t max_rx_octets;
+	uint16_t max_tx_time_us;
+	uint16_t max_rx_time_us;
+} ble_gap_data_length_params_t;
+
+typedef struct
+{
+	uint16_t tx_payload_limited_octets;
+	uint16_t rx_payload_limited_octets;
+	uint16_t tx_rx_time_limited_us;
+} ble_gap_data_length_limitation_t;
+
+typedef struct
+{
+	uint8_t enc : 1;
+	uint8_t id : 1;
+	uint8_t sign : 1;
+	uint8_t link : 1;
+} ble_gap_sec_kdist_t;
+
+typedef struct
+{
+	uint8_t bond : 1;
+	uint8_t mitm : 1;
+	uint8_t lesc : 1;
+	uint8_t keypress : 1;
+	uint8_t io_caps : 3;
+	uint8_t oob : 1;
+	uint8_t min_key_size;
+	uint8_t max_key_size;
+	ble_gap_sec_kdist_t kdist_own;
+	ble_gap_sec_kdist_t kdist_peer;
+} ble_gap_sec_params_t;
+
+typedef struct
+{
+	uint8_t *p_data;
+	uint16_t len;
+} ble_data_t;
+
+typedef struct
+{
+	ble_data_t adv_data;
+	ble_data_t scan_rsp_data;
+} ble_gap_adv_data_t;
+
+typedef struct
+{
+	uint8_t type;
+	uint8_t anonymous : 1;
+	uint8_t include_tx_power : 1;
+} ble_gap_adv_properties_t;
+
+typedef struct
+{
+	ble_gap_adv_properties_t properties;
+	const void *p_peer_addr;
+	uint32_t interval;
+	uint16_t duration;
+	uint8_t max_adv_evts;
+	uint8_t channel_mask[5];
+	uint8_t filter_policy;
+	uint8_t primary_phy;
+	uint8_t secondary_phy;
+} ble_gap_adv_params_t;
+
+/* ble_gatts.h */
+typedef struct
+{
+	uint16_t value_handle;
+	uint16_t user_desc_handle;
+	uint16_t cccd_handle;
+	uint16_t sccd_handle;
+} ble_gatts_char_handles_t;
+
+typedef struct
+{
+	uint8_t broadcast : 1;
+	uint8_t read : 1;
+	uint8_t write_wo_resp : 1;
+	uint8_t write : 1;
+	uint8_t notify : 1;
+	uint8_t indicate : 1;
+	uint8_t auth_signed_wr : 1;
+} ble_gatt_char_props_t;
+
+typedef struct
+{
+	uint8_t reliable_wr : 1;
+	uint8_t wr_aux : 1;
+} ble_gatt_char_ext_props_t;
+
+typedef struct
+{
+	ble_gap_conn_sec_mode_t read_perm;
+	ble_gap_conn_sec_mode_t write_perm;
+	uint8_t vlen : 1;
+	uint8_t vloc : 2;
+	uint8_t rd_auth : 1;
+	uint8_t wr_auth : 1;
+} ble_gatts_attr_md_t;
+
+typedef struct
+{
+	const ble_uuid_t *p_uuid;
+	const ble_gatts_attr_md_t *p_attr_md;
+	uint16_t init_len;
+	uint16_t init_offs;
+	uint16_t max_len;
+	uint8_t *p_value;
+} ble_gatts_attr_t;
+
+typedef struct
+{
+	ble_gatt_char_props_t char_props;
+	ble_gatt_char_ext_props_t char_ext_props;
+	const uint8_t *p_char_user_desc;
+	uint16_t char_user_desc_max_size;
+	uint16_t char_user_desc_size;
+	const void *p_char_pf;
+	const ble_gatts_attr_md_t *p_user_desc_md;
+	const ble_gatts_attr_md_t *p_cccd_md;
+	const ble_gatts_attr_md_t *p_sccd_md;
+} ble_gatts_char_md_t;
+
+typedef struct
+{
+	uint16_t len;
+	uint16_t offset;
+	uint8_t *p_value;
+} ble_gatts_value_t;
+
+typedef struct
+{
+	uint16_t handle;
+	uint8_t type;
+	uint16_t offset;
+	uint16_t *p_len;
+	const uint8_t *p_data;
+} ble_gatts_hvx_params_t;
+
+/* ble_srv_common.h */
+typedef struct
+{
+	uint16_t uuid;
+	uint8_t uuid_type;
+	uint16_t max_len;
+	uint16_t init_len;
+	uint8_t *p_init_value;
+	bool is_var_len;
+	ble_gatt_char_props_t char_props;
+	ble_gatt_char_ext_props_t char_ext_props;
+	bool is_defered_read;
+	bool is_defered_write;
+	security_req_t read_access;
+	security_req_t write_access;
+	security_req_t cccd_write_access;
+	bool is_value_user;
+} ble_add_char_params_t;
+
+/* ble_gatts.h (Authorize) */
+typedef struct
+{
+	uint16_t gatt_status;
+	uint8_t update : 1;
+	uint16_t offset;
+	uint16_t len;
+	const uint8_t *p_data;
+} ble_gatts_authorize_params_t;
+
+typedef struct
+{
+	uint8_t type;
+	union
+	{
+		ble_gatts_authorize_params_t read;
+		ble_gatts_authorize_params_t write;
+	} params;
+} ble_gatts_rw_authorize_reply_params_t;
+
+/* ble.h (Event) */
+typedef struct
+{
+	uint16_t evt_id;
+	uint16_t evt_len;
+} ble_evt_hdr_t;
+
+typedef struct
+{
+	uint16_t handle;
+	ble_uuid_t uuid;
+	uint8_t op;
+	uint8_t auth_required;
+	uint16_t offset;
+	uint16_t len;
+	uint8_t data[1];
+} ble_gatts_evt_write_t;
+
+typedef struct
+{
+	uint8_t count;
+} ble_gatts_evt_hvn_tx_complete_t;
+
+typedef struct
+{
+	uint16_t conn_handle;
+	union
+	{
+		ble_gatts_evt_write_t write;
+		ble_gatts_evt_hvn_tx_complete_t hvn_tx_complete;
+	} params;
+} ble_gatts_evt_t;
+
+typedef struct
+{
+	uint16_t conn_handle;
+} ble_gattc_evt_t;
+
+typedef struct
+{
+	ble_gap_conn_params_t conn_params;
+} ble_gap_evt_conn_param_update_t;
+
+typedef struct
+{
+	uint16_t conn_handle;
+	union
+	{
+		ble_gap_evt_conn_param_update_t conn_param_update;
+	} params;
+} ble_gap_evt_t;
+
+typedef struct
+{
+	ble_evt_hdr_t header;
+	union
+	{
+		ble_gap_evt_t gap_evt;
+		ble_gattc_evt_t gattc_evt;
+		ble_gatts_evt_t gatts_evt;
+	} evt;
+} ble_evt_t;
+
+/* nrf_sdh_ble.h / nrf_sdh_soc.h */
+typedef void (*nrf_sdh_ble_evt_handler_t)( const ble_evt_t *p_ble_evt, void *p_context );
+typedef void (*nrf_sdh_soc_evt_handler_t)( uint32_t evt_id, void *p_context );
+
+typedef struct
+{
+	nrf_sdh_ble_evt_handler_t handler;
+	void *p_context;
+} nrf_sdh_ble_evt_observer_t;
+
+typedef struct
+{
+	nrf_sdh_soc_evt_handler_t handler;
+	void *p_context;
+} nrf_sdh_soc_evt_observer_t;
+
+/* nrf_fstorage.h (Flashの操作はlib_halを使うModuleだけがHost上で動く) */
+typedef enum
+{
+	NRF_FSTORAGE_EVT_READ_RESULT,
+	NRF_FSTORAGE_EVT_WRITE_RESULT,
+	NRF_FSTORAGE_EVT_ERASE_RESULT,
+} nrf_fstorage_evt_id_t;
+
+typedef struct
+{
+	nrf_fstorage_evt_id_t id;
+	ret_code_t result;
+	uint32_t addr;
+	const void *p_src;
+	uint32_t len;
+	void *p_param;
+} nrf_fstorage_evt_t;
+
+typedef void (*nrf_fstorage_evt_handler_t)( nrf_fstorage_evt_t *p_evt );
+
+typedef struct
+{
+	uint32_t dummy;
+} nrf_fstorage_api_t;
+
+typedef struct
+{
+	const nrf_fstorage_api_t *p_api;
+	const void *p_flash_info;
+	nrf_fstorage_evt_handler_t evt_handler;
+	uint32_t start_addr;
+	uint32_t end_addr;
+} nrf_fstorage_t;
+
+extern nrf_fstorage_api_t nrf_fstorage_sd;
+
+/* ble_advdata.h */
+typedef struct
+{
+	uint16_t size;
+	uint8_t *p_data;
+} uint8_array_t;
+
+typedef struct
+{
+	uint16_t company_identifier;
+	uint8_array_t data;
+} ble_advdata_manuf_data_t;
+
+typedef struct
+{
+	ble_advdata_name_type_t name_type;
+	uint8_t short_name_len;
+	bool include_appearance;
+	uint8_t flags;
+	int8_t *p_tx_power_level;
+	uint16_t uuids_complete_cnt;
+	ble_uuid_t *p_uuids_complete;
+	ble_advdata_manuf_data_t *p_manuf_specific_data;
+} ble_advdata_t;
+
+/* nrf_ble_gatt.h / nrf_ble_qwr.h */
+typedef struct
+{
+	uint16_t att_mtu_desired_periph;
+} nrf_ble_gatt_t;
+
+typedef void (*nrf_ble_gatt_evt_handler_t)( nrf_ble_gatt_t *p_gatt, const void *p_evt );
+
+/* ble_radio_notification.h */
+typedef void (*ble_radio_notification_evt_handler_t)( bool radio_active );
+
+typedef void (*nrf_ble_qwr_error_handler_t)( uint32_t nrf_error );
+
+typedef struct
+{
+	uint16_t conn_handle;
+} nrf_ble_qwr_t;
+
+typedef struct
+{
+	nrf_ble_qwr_error_handler_t error_handler;
+} nrf_ble_qwr_init_t;
+
+/* ble_bas.h */
+typedef struct
+{
+	uint8_t battery_level_last;
+} ble_bas_t;
+
+typedef struct
+{
+	void *evt_handler;
+	bool support_notification;
+	void *p_report_ref;
+	uint8_t initial_batt_level;
+	security_req_t bl_rd_sec;
+	security_req_t bl_cccd_wr_sec;
+	security_req_t bl_report_rd_sec;
+} ble_bas_init_t;
+
+/* ble_conn_params.h */
+typedef struct
+{
+	ble_conn_params_evt_type_t evt_type;
+	uint16_t conn_handle;
+} ble_conn_params_evt_t;
+
+typedef void (*ble_conn_params_evt_handler_t)( ble_conn_params_evt_t *p_evt );
+typedef void (*ble_srv_error_handler_t)( uint32_t nrf_error );
+
+typedef struct
+{
+	ble_gap_conn_params_t *p_conn_params;
+	uint32_t first_conn_params_update_delay;
+	uint32_t next_conn_params_update_delay;
+	uint8_t max_conn_params_update_count;
+	uint16_t start_on_notify_cccd_handle;
+	bool disconnect_on_fail;
+	ble_conn_params_evt_handler_t evt_handler;
+	ble_srv_error_handler_t error_handler;
+} ble_conn_params_init_t;
+
+/* bsp.h / bsp_btn_ble.h */
+typedef void (*bsp_event_callback_t)( bsp_event_t event );
+typedef void (*bsp_btn_ble_error_handler_t)( uint32_t nrf_error );
+
+/* peer_manager.h */
+typedef struct
+{
+	pm_evt_id_t evt_id;
+	uint16_t peer_id;
+	uint16_t conn_handle;
+} pm_evt_t;
+
+typedef void (*pm_evt_handler_t)( const pm_evt_t *p_event );
+
+/* nrf.h (CMSIS Register. Host上のRAMに置く) */
+typedef struct
+{
+	uint32_t DEVICEID[2];
+	uint32_t DEVICEADDR[2];
+} NRF_FICR_Type;
+
+typedef struct
+{
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+	volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk		(1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk	(1UL << 24)
+
+extern NRF_FICR_Type g_sdk_host_ficr;
+extern DWT_Type g_sdk_host_dwt;
+extern CoreDebug_Type g_sdk_host_core_debug;
+
+#define NRF_FICR					( &g_sdk_host_ficr )
+#define DWT							( &g_sdk_host_dwt )
+#define CoreDebug					( &g_sdk_host_core_debug )
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief 何も出力しない (引数は評価する)
+ * @param format Specify format
+ * @retval None
+ */
+static inline void nrf_log_none( const char *format, ... )
+{
+	(void)format;
+}
+
+/* CMSIS (FPU/NVIC. 割込みがないため何もしない) */
+static inline uint32_t __get_FPSCR( void )
+{
+	return 0;
+}
+
+static inline void __set_FPSCR( uint32_t fpscr )
+{
+	(void)fpscr;
+}
+
+static inline void NVIC_ClearPendingIRQ( IRQn_Type irq )
+{
+	(void)irq;
+}
+
+static inline void NVIC_SetPriority( IRQn_Type irq, uint32_t priority )
+{
+	(void)irq;
+	(void)priority;
+}
+
+static inline void NVIC_EnableIRQ( IRQn_Type irq )
+{
+	(void)irq;
+}
+
+static inline void NVIC_DisableIRQ( IRQn_Type irq )
+{
+	(void)irq;
+}
+
+/* 排他命令 (割込みがないため常に成功する) */
+static inline uint32_t __LDREXW( volatile uint32_t *p_addr )
+{
+	return *p_addr;
+}
+
+static inline uint32_t __STREXW( uint32_t value, volatile uint32_t *p_addr )
+{
+	*p_addr = value;
+	return 0;
+}
+
+static inline void __CLREX( void )
+{
+}
+
+/* app_error.h */
+void app_error_handler( uint32_t error_code, uint32_t line_num, const uint8_t *p_file_name );
+void app_error_fault_handler( uint32_t id, uint32_t pc, uint32_t info );
+void NVIC_SystemReset( void );
+
+/* SEGGER_RTT.h */
+void SEGGER_RTT_Init( void );
+int SEGGER_RTT_printf( unsigned buffer_index, const char *p_format, ... );
+unsigned SEGGER_RTT_Write( unsigned buffer_index, const void *p_buffer, unsigned num_bytes );
+int SEGGER_RTT_ConfigUpBuffer( unsigned buffer_index, const char *p_name, void *p_buffer, unsigned buffer_size, unsigned flags );
+
+/* app_timer.h */
+ret_code_t app_timer_init( void );
+ret_code_t app_timer_create( const app_timer_id_t *p_timer_id, app_timer_mode_t mode, app_timer_timeout_handler_t timeout_handler );
+ret_code_t app_timer_start( app_timer_id_t timer_id, uint32_t timeout_ticks, void *p_context );
+ret_code_t app_timer_stop( app_timer_id_t timer_id );
+uint32_t app_timer_cnt_get( void );
+uint32_t app_timer_cnt_diff_compute( uint32_t ticks_to, uint32_t ticks_from );
+
+/* nrf_delay.h */
+void nrf_delay_us( uint32_t us );
+void nrf_delay_ms( uint32_t ms );
+
+/* nrf_pwr_mgmt.h */
+ret_code_t nrf_pwr_mgmt_init( void );
+void nrf_pwr_mgmt_run( void );
+
+/* nrf_nvic.h */
+uint32_t sd_nvic_critical_region_enter( uint8_t *p_is_nested_critical_region );
+uint32_t sd_nvic_critical_region_exit( uint8_t is_nested_critical_region );
+
+/* nrf_sdh.h / nrf_sdh_ble.h */
+bool nrf_sdh_is_enabled( void );
+ret_code_t nrf_sdh_enable_request( void );
+ret_code_t nrf_sdh_disable_request( void );
+ret_code_t nrf_sdh_ble_default_cfg_set( uint8_t conn_cfg_tag, uint32_t *p_ram_start );
+ret_code_t nrf_sdh_ble_enable( uint32_t *p_app_ram_start );
+
+/* SoftDevice (ble_gap.h / ble_gatts.h / nrf_soc.h) */
+uint32_t sd_ble_gap_device_name_set( const ble_gap_conn_sec_mode_t *p_write_perm, const uint8_t *p_dev_name, uint16_t len );
+uint32_t sd_ble_gap_ppcp_set( const ble_gap_conn_params_t *p_conn_params );
+uint32_t sd_ble_gap_disconnect( uint16_t conn_handle, uint8_t hci_status_code );
+uint32_t sd_ble_gap_phy_update( uint16_t conn_handle, const ble_gap_phys_t *p_gap_phys );
+uint32_t sd_ble_gap_data_length_update( uint16_t conn_handle, const ble_gap_data_length_params_t *p_dl_params, ble_gap_data_length_limitation_t *p_dl_limitation );
+uint32_t sd_ble_gap_adv_set_configure( uint8_t *p_adv_handle, const ble_gap_adv_data_t *p_adv_data, const ble_gap_adv_params_t *p_adv_params );
+uint32_t sd_ble_gap_adv_start( uint8_t adv_handle, uint8_t conn_cfg_tag );
+uint32_t sd_ble_gap_adv_stop( uint8_t adv_handle );
+uint32_t sd_ble_uuid_vs_add( const ble_uuid128_t *p_vs_uuid, uint8_t *p_uuid_type );
+uint32_t sd_ble_gatts_service_add( uint8_t type, const ble_uuid_t *p_uuid, uint16_t *p_handle );
+uint32_t sd_ble_gatts_characteristic_add( uint16_t service_handle, const ble_gatts_char_md_t *p_char_md, const ble_gatts_attr_t *p_attr_char_value, ble_gatts_char_handles_t *p_handles );
+uint32_t sd_ble_gatts_hvx( uint16_t conn_handle, const ble_gatts_hvx_params_t *p_hvx_params );
+uint32_t sd_ble_gatts_value_set( uint16_t conn_handle, uint16_t handle, ble_gatts_value_t *p_value );
+uint32_t sd_ble_gap_conn_param_update( uint16_t conn_handle, const ble_gap_conn_params_t *p_conn_params );
+uint32_t sd_ble_gatts_rw_authorize_reply( uint16_t conn_handle, const ble_gatts_rw_authorize_reply_params_t *p_rw_authorize_reply_params );
+uint32_t sd_power_system_off( void );
+uint32_t sd_app_evt_wait( void );
+uint32_t sd_nvic_SystemReset( void );
+
+/* nrf_fstorage.h */
+ret_code_t nrf_fstorage_init( nrf_fstorage_t *p_fs, const nrf_fstorage_api_t *p_api, void *p_param );
+ret_code_t nrf_fstorage_uninit( nrf_fstorage_t *p_fs, void *p_param );
+ret_code_t nrf_fstorage_read( const nrf_fstorage_t *p_fs, uint32_t src, void *p_dest, uint32_t len );
+ret_code_t nrf_fstorage_write( const nrf_fstorage_t *p_fs, uint32_t dest, const void *p_src, uint32_t len, void *p_param );
+ret_code_t nrf_fstorage_erase( const nrf_fstorage_t *p_fs, uint32_t page_addr, uint32_t len, void *p_param );
+bool nrf_fstorage_is_busy( const nrf_fstorage_t *p_fs );
+
+/* ble_srv_common.h */
+uint32_t characteristic_add( uint16_t service_handle, ble_add_char_params_t *p_char_props, ble_gatts_char_handles_t *p_char_handle );
+
+/* ble_advdata.h */
+ret_code_t ble_advdata_encode( const ble_advdata_t *p_advdata, uint8_t *p_encoded_data, uint16_t *p_len );
+
+/* nrf_ble_gatt.h / nrf_ble_qwr.h / ble_bas.h / ble_conn_params.h */
+ret_code_t nrf_ble_gatt_init( nrf_ble_gatt_t *p_gatt, nrf_ble_gatt_evt_handler_t evt_handler );
+ret_code_t nrf_ble_gatt_att_mtu_periph_set( nrf_ble_gatt_t *p_gatt, uint16_t desired_mtu );
+ret_code_t nrf_ble_qwr_init( nrf_ble_qwr_t *p_qwr, const nrf_ble_qwr_init_t *p_qwr_init );
+ret_code_t nrf_ble_qwr_conn_handle_assign( nrf_ble_qwr_t *p_qwr, uint16_t conn_handle );
+ret_code_t ble_bas_init( ble_bas_t *p_bas, const ble_bas_init_t *p_bas_init );
+ret_code_t ble_bas_battery_level_update( ble_bas_t *p_bas, uint8_t battery_level, uint16_t conn_handle );
+ret_code_t ble_conn_params_init( const ble_conn_params_init_t *p_init );
+ret_code_t ble_conn_params_change_conn_params( uint16_t conn_handle, ble_gap_conn_params_t *p_new_params );
+
+/* ble_radio_notification.h */
+uint32_t ble_radio_notification_init( uint32_t irq_priority, uint8_t distance, ble_radio_notification_evt_handler_t evt_handler );
+
+/* bsp.h / bsp_btn_ble.h */
+uint32_t bsp_init( uint32_t type, bsp_event_callback_t callback );
+uint32_t bsp_indication_set( bsp_indication_t indicate );
+ret_code_t bsp_btn_ble_init( bsp_btn_ble_error_handler_t error_handler, bsp_event_t *p_startup_bsp_evt );
+ret_code_t bsp_btn_ble_sleep_mode_prepare( void );
+
+/* peer_manager.h / peer_manager_handler.h */
+ret_code_t pm_init( void );
+ret_code_t pm_sec_params_set( ble_gap_sec_params_t *p_sec_params );
+ret_code_t pm_register( pm_evt_handler_t event_handler );
+ret_code_t pm_peers_delete( void );
+void pm_handler_on_pm_evt( const pm_evt_t *p_pm_evt );
+void pm_handler_disconnect_on_sec_failure( const pm_evt_t *p_pm_evt );
+void pm_handler_flash_clean( const pm_evt_t *p_pm_evt );
+
+/* Host Build */
+/**
+ * @brief Traceの再生が終わった (nrf_pwr_mgmt_run/sd_app_evt_waitから呼ばれ, 戻らない)
+ * @remark 実装は実行File毎に用意する (host/src/badge_host.c)
+ * @param None
+ * @retval None
+ */
+void SdkHostEnd( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,205 @@
+/**
+ * Fixed-point mounting correction (calc_acc_rot() in algorithm/src/AccAngle.c)
+ * against the same rotation computed in double precision.
+ *
+ * For every roll/pitch on a 5 degree grid (and a few yaw values) the rotation
+ * matrix is set with clac_rot_matrix() and corner, full-scale random and
+ * +-4 g random samples are corrected. The Q14 result may differ from the
+ * rounded and int16-saturated double result by at most
+ *
+ *     0.5 + (|x| + |y| + |z|) * (0.5 / 2^14 + ROT_HOST_FLOAT_ERR)  [LSB]
+ *
+ * (output rounding plus the quantisation of each matrix element, with a
+ * margin for the single-precision sin/cos the matrix is built from), which is
+ * at most 1 LSB for samples within +-4 g (mg, as mode_manager.c feeds it).
+ *
+ *     make -C host rot
+ *     ./host/_build/acc_rot_host -n 256 -s 3
+ *
+ * The process exits with 1 on the first sample outside the bound.
+ */
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "AccAngle.h"
+
+#define ROT_HOST_Q_ERR                  (0.5 / 16384.0)                         /**< Rounding of one Q14 matrix element. */
+#define ROT_HOST_FLOAT_ERR              4e-7                                    /**< Single-precision sin/cos and products of clac_rot_matrix(). */
+#define ROT_HOST_STEP_DEG               5
+#define ROT_HOST_SAMPLES_DEFAULT        64                                      /**< Random samples of each kind per angle. */
+#define ROT_HOST_4G_MG                  4000
+#define ROT_HOST_4G_MAX_LSB             1.0
+
+static const int m_yaw_deg[] = { 0, 30, -120 };                                 /**< clac_acc_angle() always sets 0; the others check Z * Y * X. */
+
+static uint32_t m_rand = 1;
+static double   m_max_err;                                                      /**< Largest difference seen [LSB]. */
+static double   m_max_err_4g;                                                   /**< Largest difference within +-4 g [LSB]. */
+static uint32_t m_sample_count;
+
+static uint32_t test_rand(void)
+{
+    m_rand = m_rand * 1103515245u + 12345u;
+    return (m_rand >> 16) & 0x7FFF;
+}
+
+static int16_t test_rand_acc(int32_t range)
+{
+    uint32_t r = (test_rand() << 15) | test_rand();
+
+    return (int16_t)((int32_t)(r % (uint32_t)(2 * range + 1)) - range);
+}
+
+static double saturate(double value)
+{
+    return (value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : value;
+}
+
+/**@brief Correct one sample both ways and check the difference of every axis.
+ */
+static bool check_sample(const double rot[3][3], int16_t x, int16_t y, int16_t z)
+{
+    ACC_RESULT result;
+    int16_t    out[3];
+    double     bound = 0.5 + (fabs((double)x) + fabs((double)y) + fabs((double)z)) * (ROT_HOST_Q_ERR + ROT_HOST_FLOAT_ERR);
+    bool       in_4g = (abs(x) <= ROT_HOST_4G_MG) && (abs(y) <= ROT_HOST_4G_MG) && (abs(z) <= ROT_HOST_4G_MG);
+
+    calc_acc_rot(x, y, z, &result);
+    out[0] = result.x;
+    out[1] = result.y;
+    out[2] = result.z;
+    m_sample_count++;
+
+    for (int i = 0; i < 3; i++)
+    {
+        double ref = saturate(rot[i][0] * x + rot[i][1] * y + rot[i][2] * z);
+        double err = fabs(out[i] - ref);
+
+        if (err > m_max_err)
+        {
+            m_max_err = err;
+        }
+        if (in_4g && (err > m_max_err_4g))
+        {
+            m_max_err_4g = err;
+        }
+        if (err > bound)
+        {
+            fprintf(stderr, "FAIL (%d,%d,%d) axis %d: q14 %d double %.3f (bound %.3f)\n",
+                    x, y, z, i, out[i], ref, bound);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**@brief Same Z * Y * X as clac_rot_matrix(), in double.
+ */
+static void rot_matrix_double(double roll, double pitch, double yaw, double rot[3][3])
+{
+    double cy = cos(yaw), sy = sin(yaw);
+    double cp = cos(pitch), sp = sin(pitch);
+    double cr = cos(roll), sr = sin(roll);
+
+    rot[0][0] = cy * cp;
+    rot[0][1] = (cy * sp * sr) - (sy * cr);
+    rot[0][2] = (cy * sp * cr) + (sy * sr);
+    rot[1][0] = sy * cp;
+    rot[1][1] = (sy * sp * sr) + (cy * cr);
+    rot[1][2] = (sy * sp * cr) - (cy * sr);
+    rot[2][0] = -sp;
+    rot[2][1] = cp * sr;
+    rot[2][2] = cp * cr;
+}
+
+static bool check_angle(int roll_deg, int pitch_deg, int yaw_deg, uint32_t samples)
+{
+    static const int16_t corner[] = { INT16_MIN, INT16_MAX };
+    ACC_ANGLE            angle;
+    double               rot[3][3];
+
+    angle.cmpl  = true;
+    angle.roll  = (float)(roll_deg * M_PI / 180.0);
+    angle.pitch = (float)(pitch_deg * M_PI / 180.0);
+    angle.yaw   = (float)(yaw_deg * M_PI / 180.0);
+    clac_rot_matrix(&angle);
+    // The reference uses the same (float) angles the firmware was given.
+    rot_matrix_double(angle.roll, angle.pitch, angle.yaw, rot);
+
+    for (int i = 0; i < 8; i++)
+    {
+        if (!check_sample(rot, corner[i & 1], corner[(i >> 1) & 1], corner[(i >> 2) & 1]))
+            return false;
+    }
+    for (uint32_t n = 0; n < samples; n++)
+    {
+        if (!check_sample(rot, test_rand_acc(32767), test_rand_acc(32767), test_rand_acc(32767)) ||
+            !check_sample(rot, test_rand_acc(ROT_HOST_4G_MG), test_rand_acc(ROT_HOST_4G_MG), test_rand_acc(ROT_HOST_4G_MG)))
+            return false;
+    }
+    return true;
+}
+
+static void usage(const char * p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-n samples] [-s seed]\n"
+            "  -n  random samples of each kind per angle (default %u)\n"
+            "  -s  random seed (default 1)\n",
+            p_name, ROT_HOST_SAMPLES_DEFAULT);
+}
+
+int main(int argc, char * argv[])
+{
+    uint32_t samples = ROT_HOST_SAMPLES_DEFAULT;
+    uint32_t angles = 0;
+    int      opt;
+
+    while ((opt = getopt(argc, argv, "n:s:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                samples = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                m_rand = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+
+    for (size_t k = 0; k < sizeof(m_yaw_deg) / sizeof(m_yaw_deg[0]); k++)
+    {
+        for (int roll = -180; roll <= 180; roll += ROT_HOST_STEP_DEG)
+        {
+            for (int pitch = -180; pitch <= 180; pitch += ROT_HOST_STEP_DEG)
+            {
+                if (!check_angle(roll, pitch, m_yaw_deg[k], samples))
+                {
+                    fprintf(stderr, "  roll %d pitch %d yaw %d deg\n", roll, pitch, m_yaw_deg[k]);
+                    return 1;
+                }
+                angles++;
+            }
+        }
+    }
+
+    printf("calc_acc_rot angles=%u samples=%u max_err_lsb=%.3f max_err_4g_lsb=%.3f\n",
+           angles, m_sample_count, m_max_err, m_max_err_4g);
+    if (m_max_err_4g > ROT_HOST_4G_MAX_LSB)
+    {
+        fprintf(stderr, "FAIL error within +-4 g above %.1f LSB\n", ROT_HOST_4G_MAX_LSB);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
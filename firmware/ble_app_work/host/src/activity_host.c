@@ -0,0 +1,263 @@
+/**
+ * Activity classifier (algorithm/src/activity_algo.c) replayed against
+ * labelled sessions.
+ *
+ * A session is the trace format of badge_host with optional gyro columns and
+ * a label per sample:
+ *
+ *     t_ms,ax_mg,ay_mg,az_mg[,gx_dps,gy_dps,gz_dps][,label]
+ *
+ * label is one of still/walk/run/dash/jump. Samples go through
+ * ActivityAddSample() exactly as on the target. Every 2 s window gets the
+ * majority label of its samples. Windows where no label reaches 80 % are
+ * transitions: they are not scored and not used for training.
+ *
+ *     make -C host activity
+ *     ./host/_build/activity_host still.csv walk.csv mixed.csv
+ *     ./host/_build/activity_host -f walk.csv run.csv > features.csv    # tools/activity_train.py
+ *     ./host/_build/activity_host -a session.csv                        # accel only, as in DAILY mode
+ *
+ * The default output is a confusion matrix, the accuracy and a BUDGET line
+ * (state RAM, model flash, tree size). Cycle counts come from the
+ * ActivityAddSample/ActivityClassify cases of bench/.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "activity_algo.h"
+
+#define LABEL_NONE                      ACTIVITY_CLASS_NUM                      /**< Unlabelled sample or transition window. */
+#define LABEL_MAJORITY_PERCENT          80
+
+static const char * const m_class_name[ACTIVITY_CLASS_NUM] = { "still", "walk", "run", "dash", "jump" };
+
+static const char * const m_feature_name[ACT_FEAT_NUM] =
+{
+    "x_mean", "y_mean", "z_mean", "x_sd", "y_sd", "z_sd", "x_zc", "y_zc", "z_zc",
+    "mag_sd", "energy", "peak_num", "peak_interval", "gyro_sd",
+};
+
+static uint32_t m_confusion[ACTIVITY_CLASS_NUM][ACTIVITY_CLASS_NUM];           // [label][class]
+static uint32_t m_transition;
+
+static void usage(const char * p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-f] [-a] session.csv...\n"
+            "  session.csv  t_ms,ax_mg,ay_mg,az_mg[,gx_dps,gy_dps,gz_dps][,label] per line\n"
+            "  -f           print one CSV row of features per labelled window (training input)\n"
+            "  -a           ignore the gyro columns\n",
+            p_name);
+}
+
+static uint8_t label_parse(const char * p_label)
+{
+    uint8_t i;
+
+    for (i = 0; i < ACTIVITY_CLASS_NUM; i++)
+    {
+        if (strcmp(p_label, m_class_name[i]) == 0)
+        {
+            return i;
+        }
+    }
+    return LABEL_NONE;
+}
+
+static uint8_t label_majority(const uint16_t count[ACTIVITY_CLASS_NUM + 1])
+{
+    uint8_t best = 0;
+    uint8_t i;
+
+    for (i = 1; i < ACTIVITY_CLASS_NUM; i++)
+    {
+        if (count[i] > count[best])
+        {
+            best = i;
+        }
+    }
+    if ((uint32_t)count[best] * 100 < (uint32_t)ACTIVITY_WINDOW * LABEL_MAJORITY_PERCENT)
+    {
+        return LABEL_NONE;
+    }
+    return best;
+}
+
+static void window_print(const char * p_path, uint32_t t_ms, uint8_t label, const ACTIVITY_RESULT * p_result)
+{
+    uint8_t i;
+
+    printf("%s,%u,%s", p_path, t_ms, m_class_name[label]);
+    for (i = 0; i < ACT_FEAT_NUM; i++)
+    {
+        printf(",%d", p_result->feature[i]);
+    }
+    printf(",%s\n", m_class_name[p_result->class_id]);
+}
+
+static int session_run(const char * p_path, bool features, bool use_gyro)
+{
+    FILE *          p_file;
+    char            line[160];
+    char *          p_field[9];
+    uint16_t        label_count[ACTIVITY_CLASS_NUM + 1] = {0};
+    ACTIVITY_RESULT result;
+    int16_t         gyro[3];
+    uint32_t        t_ms;
+    uint8_t         field_num;
+    uint8_t         label;
+    char *          p_tok;
+
+    p_file = fopen(p_path, "r");
+    if (p_file == NULL)
+    {
+        perror(p_path);
+        return 1;
+    }
+
+    ActivityReset();
+    while (fgets(line, sizeof(line), p_file) != NULL)
+    {
+        if (line[0] == '#')
+        {
+            continue;
+        }
+        line[strcspn(line, "\r\n")] = '\0';
+        field_num = 0;
+        for (p_tok = strtok(line, ","); (p_tok != NULL) && (field_num < 9); p_tok = strtok(NULL, ","))
+        {
+            p_field[field_num++] = p_tok;
+        }
+        if (field_num < 4)
+        {
+            continue;
+        }
+
+        label = LABEL_NONE;
+        if ((field_num == 5) || (field_num == 8))
+        {
+            label = label_parse(p_field[--field_num]);
+        }
+        t_ms = (uint32_t)strtoul(p_field[0], NULL, 10);
+        if (field_num == 7)
+        {
+            gyro[0] = (int16_t)atoi(p_field[4]);
+            gyro[1] = (int16_t)atoi(p_field[5]);
+            gyro[2] = (int16_t)atoi(p_field[6]);
+        }
+        label_count[label]++;
+
+        if (ActivityAddSample((int16_t)atoi(p_field[1]), (int16_t)atoi(p_field[2]), (int16_t)atoi(p_field[3]),
+                              ((field_num == 7) && use_gyro) ? gyro : NULL, &result) != ALGO_SUCCESS)
+        {
+            continue;
+        }
+
+        label = label_majority(label_count);
+        memset(label_count, 0, sizeof(label_count));
+        if (label == LABEL_NONE)
+        {
+            m_transition++;
+            continue;
+        }
+        if (features)
+        {
+            window_print(p_path, t_ms, label, &result);
+        }
+        m_confusion[label][result.class_id]++;
+    }
+
+    fclose(p_file);
+    return 0;
+}
+
+static void report_print(void)
+{
+    ACTIVITY_SIZE size;
+    uint32_t      total = 0;
+    uint32_t      correct = 0;
+    uint8_t       i, j;
+
+    printf("%-8s", "label");
+    for (j = 0; j < ACTIVITY_CLASS_NUM; j++)
+    {
+        printf(" %6s", m_class_name[j]);
+    }
+    printf("\n");
+    for (i = 0; i < ACTIVITY_CLASS_NUM; i++)
+    {
+        printf("%-8s", m_class_name[i]);
+        for (j = 0; j < ACTIVITY_CLASS_NUM; j++)
+        {
+            printf(" %6u", m_confusion[i][j]);
+            total += m_confusion[i][j];
+        }
+        correct += m_confusion[i][i];
+        printf("\n");
+    }
+
+    ActivityGetSize(&size);
+    printf("ACTIVITY windows=%u correct=%u accuracy=%.1f%% transition=%u\n",
+           total, correct, (total > 0) ? (correct * 100.0) / total : 0.0, m_transition);
+    printf("BUDGET state_ram=%u model_flash=%u nodes=%u depth=%u window=%u\n",
+           size.ram_size, size.model_size, size.node_num, size.depth, ACTIVITY_WINDOW);
+}
+
+int main(int argc, char * argv[])
+{
+    bool features = false;
+    bool use_gyro = true;
+    int  opt;
+    int  i;
+
+    while ((opt = getopt(argc, argv, "fah")) != -1)
+    {
+        switch (opt)
+        {
+            case 'f':
+                features = true;
+                break;
+
+            case 'a':
+                use_gyro = false;
+                break;
+
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if (optind >= argc)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (features)
+    {
+        printf("session,t_ms,label");
+        for (i = 0; i < ACT_FEAT_NUM; i++)
+        {
+            printf(",%s", m_feature_name[i]);
+        }
+        printf(",class\n");
+    }
+
+    for (i = optind; i < argc; i++)
+    {
+        if (session_run(argv[i], features, use_gyro) != 0)
+        {
+            return 1;
+        }
+    }
+
+    if (!features)
+    {
+        report_print();
+    }
+    return 0;
+}
@@ -0,0 +1,272 @@
+/**
+ * Badge application (main.c) on the POSIX HAL (host/src/lib_hal_posix.c).
+ *
+ * main.c, the drivers under library/ and ble_adv_scheduler.c are built
+ * unchanged against the SDK stand-ins in host/sdk (implemented by
+ * host/src/sdk_host.c); main.c's main() is renamed app_main() and called from
+ * here. The ICM-42607 and BL5372 register models replay a recorded trace and
+ * virtual time jumps from event to event, so an hour of trace runs in a
+ * fraction of a second. The run ends when the firmware idles after the trace.
+ *
+ *     make -C host
+ *     ./host/_build/badge_host host/traces/tilt_fall.csv
+ *     ./host/_build/badge_host -f flash.bin -t "2026-10-19 09:00:00" trace.csv
+ *
+ * Every ADV/TRACE line and the SUMMARY line are deterministic for a given
+ * trace, so two runs can be diffed for regression testing.
+ *
+ * A "# expect fall=<n> tilt=<n> ..." comment in the trace (keys: tilt, stand,
+ * fall, alarm) is checked against the SUMMARY counts; a mismatch prints FAIL
+ * and exits 1, so "make run" fails.
+ */
+#define _GNU_SOURCE                                                             // strptime, timegm
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sdk_host.h"
+#include "lib_hal.h"
+#include "lib_hal_posix.h"
+#include "lib_tilt_detect.h"
+#include "ble_adv_scheduler.h"
+
+#define BADGE_HOST_RTC_START            1792400400                              /**< 2026-10-19 09:00:00 UTC. */
+
+int app_main(void);                                                             /**< main() of main.c (built with -Dmain=app_main). */
+
+// Originals of the functions wrapped with -Wl,--wrap (see Makefile).
+TILT_EVT   __real_TiltDetectInput(int16_t x, int16_t y, int16_t z, uint32_t time_ms);
+ret_code_t __real_ble_adv_sched_init(ble_advdata_t const * p_advdata, uint8_t conn_cfg_tag);
+ret_code_t __real_ble_adv_sched_payload_update(bool alarm);
+
+typedef struct
+{
+    const char * p_key;
+    bool         given;
+    uint32_t     value;
+} expect_t;
+
+enum { EXPECT_TILT, EXPECT_STAND, EXPECT_FALL, EXPECT_ALARM, EXPECT_NUM };
+
+static clock_t  m_cpu_start;
+static uint32_t m_sample_count;
+static uint32_t m_evt_count[TILT_EVT_FALL + 1];
+static expect_t m_expect[EXPECT_NUM] = { { .p_key = "tilt" }, { .p_key = "stand" }, { .p_key = "fall" }, { .p_key = "alarm" } };
+
+/**@brief Count the samples and posture events main.c feeds to / gets from the detector.
+ */
+TILT_EVT __wrap_TiltDetectInput(int16_t x, int16_t y, int16_t z, uint32_t time_ms)
+{
+    TILT_EVT evt = __real_TiltDetectInput(x, y, z, time_ms);
+
+    m_sample_count++;
+    if (evt <= TILT_EVT_FALL)
+    {
+        m_evt_count[evt]++;
+    }
+    return evt;
+}
+
+/**@brief Point the host advertising output at the manufacturer payload main.c advertises.
+ */
+ret_code_t __wrap_ble_adv_sched_init(ble_advdata_t const * p_advdata, uint8_t conn_cfg_tag)
+{
+    ret_code_t err_code = __real_ble_adv_sched_init(p_advdata, conn_cfg_tag);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = HalAdvInit(p_advdata->p_manuf_specific_data->data.p_data,
+                              p_advdata->p_manuf_specific_data->data.size);
+    }
+    return err_code;
+}
+
+/**@brief Print every payload the scheduler accepted (ADV line).
+ */
+ret_code_t __wrap_ble_adv_sched_payload_update(bool alarm)
+{
+    ret_code_t err_code = __real_ble_adv_sched_payload_update(alarm);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = HalAdvUpdate(alarm);
+    }
+    return err_code;
+}
+
+/**@brief Read the "# expect key=value ..." lines of the trace.
+ */
+static bool expect_load(const char * p_path)
+{
+    FILE * fp = fopen(p_path, "r");
+    char   line[256];
+
+    if (fp == NULL)
+    {
+        fprintf(stderr, "%s: cannot open\n", p_path);
+        return false;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if (strncmp(line, "# expect ", 9) != 0)
+        {
+            continue;
+        }
+        for (char * p_tok = strtok(&line[9], " \t\r\n"); p_tok != NULL; p_tok = strtok(NULL, " \t\r\n"))
+        {
+            char *   p_eq = strchr(p_tok, '=');
+            uint32_t i;
+
+            for (i = 0; i < EXPECT_NUM; i++)
+            {
+                if ((p_eq != NULL) && (strncmp(p_tok, m_expect[i].p_key, (size_t)(p_eq - p_tok)) == 0) &&
+                    (m_expect[i].p_key[p_eq - p_tok] == '\0'))
+                {
+                    break;
+                }
+            }
+            if (i == EXPECT_NUM)
+            {
+                fprintf(stderr, "%s: unknown expect \"%s\"\n", p_path, p_tok);
+                fclose(fp);
+                return false;
+            }
+            m_expect[i].given = true;
+            m_expect[i].value = (uint32_t)strtoul(p_eq + 1, NULL, 0);
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+/**@brief Compare the counts with the expect lines; print every mismatch.
+ */
+static bool expect_check(uint32_t const * p_count)
+{
+    bool ok = true;
+
+    for (uint32_t i = 0; i < EXPECT_NUM; i++)
+    {
+        if (m_expect[i].given && (p_count[i] != m_expect[i].value))
+        {
+            printf("FAIL %s=%u, expected %u\n", m_expect[i].p_key, p_count[i], m_expect[i].value);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/**@brief End of the trace: print the summary, check it and stop (called from nrf_pwr_mgmt_run()).
+ */
+void SdkHostEnd(void)
+{
+    HAL_POSIX_STATS stats;
+    double          cpu_s;
+    uint32_t        count[EXPECT_NUM];
+    bool            ok;
+
+    cpu_s = (double)(clock() - m_cpu_start) / CLOCKS_PER_SEC;
+    HalPosixGetStats(&stats);
+    HalPosixUninit();
+
+    printf("SUMMARY time_ms=%llu samples=%u tilt=%u stand=%u fall=%u adv=%u alarm=%u "
+           "wake=%u timer=%u gpio_int=%u spi=%u spi_bytes=%u twi=%u flash_bytes=%u flash_erase=%u trace_log=%u\n",
+           (unsigned long long)stats.time_ms, m_sample_count,
+           m_evt_count[TILT_EVT_TILT], m_evt_count[TILT_EVT_STAND], m_evt_count[TILT_EVT_FALL],
+           stats.adv_update, stats.adv_alarm, stats.wake, stats.timer_fire, stats.gpio_int,
+           stats.spi_xfer, stats.spi_bytes, stats.twi_xfer, stats.flash_write_bytes, stats.flash_erase, stats.trace_log);
+    fprintf(stderr, "host cpu %.3f s for %.1f s of device time (x%.0f)\n",
+            cpu_s, stats.time_ms / 1000.0, (cpu_s > 0.0) ? (stats.time_ms / 1000.0) / cpu_s : 0.0);
+
+    count[EXPECT_TILT]  = m_evt_count[TILT_EVT_TILT];
+    count[EXPECT_STAND] = m_evt_count[TILT_EVT_STAND];
+    count[EXPECT_FALL]  = m_evt_count[TILT_EVT_FALL];
+    count[EXPECT_ALARM] = stats.adv_alarm;
+    ok = expect_check(count);
+    fflush(stdout);
+
+    exit(ok ? 0 : 1);
+}
+
+static void usage(const char * p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-f flash.bin] [-t \"YYYY-MM-DD hh:mm:ss\"] [-e tail_ms] [-v] trace.csv\n"
+            "  trace.csv  t_ms,ax_mg,ay_mg,az_mg per line; \"# expect fall=1 tilt=2 ...\" lines are\n"
+            "             checked against the SUMMARY (exit 1 on a mismatch)\n"
+            "  -f         keep the flash area in this file between runs\n"
+            "  -t         RTC time (UTC) at the start of the trace; boots as an RTC wake-up from\n"
+            "             System OFF so the firmware keeps it (a power-on boot resets the RTC)\n"
+            "  -e         run this long after the last sample (default %u ms)\n"
+            "  -v         also print SPI/TWI transfers and timer expiries\n",
+            p_name, HAL_POSIX_TAIL_MS);
+}
+
+int main(int argc, char * argv[])
+{
+    HAL_POSIX_CONFIG config;
+    struct tm        tm_start;
+    int              opt;
+
+    memset(&config, 0, sizeof(config));
+    config.rtc_start = BADGE_HOST_RTC_START;
+    config.tail_ms   = HAL_POSIX_TAIL_MS;
+
+    while ((opt = getopt(argc, argv, "f:t:e:vh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'f':
+                config.flash_path = optarg;
+                break;
+
+            case 't':
+                memset(&tm_start, 0, sizeof(tm_start));
+                if (strptime(optarg, "%Y-%m-%d %H:%M:%S", &tm_start) == NULL)
+                {
+                    usage(argv[0]);
+                    return 2;
+                }
+                config.rtc_start  = timegm(&tm_start);
+                config.rtc_wakeup = true;
+                break;
+
+            case 'e':
+                config.tail_ms = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'v':
+                config.verbose = true;
+                break;
+
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if (optind != (argc - 1))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    config.trace_path = argv[optind];
+    if (!expect_load(config.trace_path))
+    {
+        return 2;
+    }
+
+    if (HalPosixInit(&config) != HAL_SUCCESS)
+    {
+        return 1;
+    }
+    m_cpu_start = clock();
+
+    // Returns only through SdkHostEnd() or app_error_handler().
+    (void)app_main();
+
+    return 1;
+}
@@ -0,0 +1,176 @@
+/**
+ * Mounting-angle calibration (clac_acc_angle() in algorithm/src/AccAngle.c)
+ * replayed against a recorded calibration session.
+ *
+ * The session is the trace format of badge_host (t_ms,ax_mg,ay_mg,az_mg, mg as
+ * delivered by AccGyroCalcData()). Samples are fed one by one, as mode_manager.c
+ * does while the angle adjust state is ANGLE_ADJUST_START, until the estimator
+ * reports a result. The mean of the first 200 samples - what the previous
+ * buffered implementation returned - is printed next to it for comparison.
+ *
+ *     make -C host calib
+ *     ./host/_build/calib_host host/calib/still_tilted.csv
+ *     ./host/_build/calib_host -e 0.5 session.csv
+ *
+ * A "# expect roll=<deg> pitch=<deg>" or "# expect none" comment in the session
+ * makes the run fail when the result is further than -e degrees from it (or
+ * when a session that should never calibrate does).
+ */
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "AccAngle.h"
+
+#define CALIB_LEGACY_SAMPLES            200                                     /**< ACC_BUF_SIZE of AccAngle.c before the streaming estimator. */
+#define CALIB_TOLERANCE_DEG             1.0f
+#define RAD2DEG(rad)                    ((rad) * (180.0f / 3.14159265f))
+
+typedef enum
+{
+    EXPECT_NOTHING,
+    EXPECT_ANGLE,
+    EXPECT_NONE,
+} expect_t;
+
+static void usage(const char * p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-e tolerance_deg] session.csv\n"
+            "  session.csv  t_ms,ax_mg,ay_mg,az_mg per line\n"
+            "  -e           allowed difference from the \"# expect\" line (default %.1f deg)\n",
+            p_name, CALIB_TOLERANCE_DEG);
+}
+
+static void angle_from_mean(const int32_t sum[3], uint32_t count, float * p_roll, float * p_pitch)
+{
+    float x = (float)(sum[0] / (int32_t)count);
+    float y = (float)(sum[1] / (int32_t)count);
+    float z = (float)(sum[2] / (int32_t)count);
+
+    *p_roll  = atan2f(y, z);
+    *p_pitch = atan2f(-x, sqrtf(y * y + z * z));
+}
+
+int main(int argc, char * argv[])
+{
+    FILE *    p_file;
+    char      line[128];
+    expect_t  expect = EXPECT_NOTHING;
+    float     expect_roll = 0.0f;
+    float     expect_pitch = 0.0f;
+    float     tolerance = CALIB_TOLERANCE_DEG;
+    ACC_ANGLE angle;
+    int32_t   legacy_sum[3] = {0};
+    uint32_t  samples = 0;
+    uint32_t  done_samples = 0;
+    uint32_t  done_ms = 0;
+    uint32_t  t_ms;
+    int       x, y, z;
+    bool      done = false;
+    bool      ok = true;
+    float     roll, pitch;
+    int       opt;
+
+    while ((opt = getopt(argc, argv, "e:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'e':
+                tolerance = strtof(optarg, NULL);
+                break;
+
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if (optind != (argc - 1))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    p_file = fopen(argv[optind], "r");
+    if (p_file == NULL)
+    {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    acc_angle_reset();
+    memset(&angle, 0, sizeof(angle));
+
+    while (fgets(line, sizeof(line), p_file) != NULL)
+    {
+        if (line[0] == '#')
+        {
+            if (sscanf(line, "# expect roll=%f pitch=%f", &expect_roll, &expect_pitch) == 2)
+            {
+                expect = EXPECT_ANGLE;
+            }
+            else if (strncmp(line, "# expect none", 13) == 0)
+            {
+                expect = EXPECT_NONE;
+            }
+            continue;
+        }
+        if (sscanf(line, "%u,%d,%d,%d", &t_ms, &x, &y, &z) != 4)
+        {
+            continue;
+        }
+        samples++;
+
+        if (samples <= CALIB_LEGACY_SAMPLES)
+        {
+            legacy_sum[0] += x;
+            legacy_sum[1] += y;
+            legacy_sum[2] += z;
+        }
+        if (!done && (clac_acc_angle((int16_t)x, (int16_t)y, (int16_t)z, &angle) == NRF_SUCCESS) && angle.cmpl)
+        {
+            done         = true;
+            done_samples = samples;
+            done_ms      = t_ms;
+        }
+    }
+    fclose(p_file);
+
+    if (samples >= CALIB_LEGACY_SAMPLES)
+    {
+        angle_from_mean(legacy_sum, CALIB_LEGACY_SAMPLES, &roll, &pitch);
+        printf("legacy samples=%u roll_deg=%.2f pitch_deg=%.2f\n", CALIB_LEGACY_SAMPLES, RAD2DEG(roll), RAD2DEG(pitch));
+    }
+
+    if (done)
+    {
+        roll  = RAD2DEG(angle.roll);
+        pitch = RAD2DEG(angle.pitch);
+        printf("CALIB done t_ms=%u samples=%u roll_deg=%.2f pitch_deg=%.2f\n", done_ms, done_samples, roll, pitch);
+        if (expect == EXPECT_NONE)
+        {
+            ok = false;
+        }
+        else if ((expect == EXPECT_ANGLE) &&
+                 ((fabsf(roll - expect_roll) > tolerance) || (fabsf(pitch - expect_pitch) > tolerance)))
+        {
+            ok = false;
+        }
+    }
+    else
+    {
+        printf("CALIB none samples=%u\n", samples);
+        ok = (expect != EXPECT_ANGLE);
+    }
+
+    if (!ok)
+    {
+        fprintf(stderr, "%s: result does not match the expect line\n", argv[optind]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,516 @@
+/**
+ * Event scheduler (library/src/lib_evt_sched.c) under synthetic event storms.
+ *
+ * The core is built with EVT_SCHED_HOST_BUILD (no critical region) and driven
+ * by a main loop model: every tick a random burst of events is pushed, as the
+ * interrupt handlers would, and one event is popped and "handled". Time is
+ * counted in pops, so latencies are in units of handled events.
+ *
+ *     make -C host sched
+ *     ./host/_build/evt_sched_host -n 200000 -s 7
+ *
+ * Checked for every storm:
+ *  - fairness: a class that stays non-empty is skipped at most
+ *    EVT_SCHED_STARVE_LIMIT + EVT_SCHED_CLASS_NUM - 2 pops in a row (it starves
+ *    after STARVE_LIMIT skips, and only the starving classes above it can still
+ *    go first);
+ *  - latency: an event with p events of its class ahead of it is popped within
+ *    (p + 1) * (EVT_SCHED_STARVE_LIMIT + EVT_SCHED_CLASS_NUM - 1) pops;
+ *  - coalescing: a storm of one coalescing event occupies a single slot and
+ *    the event is never lost once the pending one has been popped;
+ *  - nothing is popped out of order within a class, and every push is either
+ *    popped, coalesced or counted as a drop.
+ *
+ * The storms use no EVT_SCHED_ORDERED events (the bounds above are for the
+ * class order alone). The ordering cases use m_order_table, which mirrors the
+ * ORDERED entries of g_evt_class_table (library/src/lib_fifo.c):
+ *  - connection: a connect/disconnect (CRITICAL) never overtakes a BLE command
+ *    (NORMAL) or a log read (BULK) queued before it, and commands of the next
+ *    connection stay behind it;
+ *  - flash: a write/erase complete and the status check behind it (both
+ *    NORMAL) pop in push order, whichever is pushed first;
+ *  - random: ORDERED events pop in push order under random push/pop, and the
+ *    queue always drains.
+ * The process exits with 1 on the first violated check.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lib_evt_sched.h"
+
+#define SCHED_CRITICAL_SIZE             8                                       /**< Same split as EVT_FIFO_*_SIZE (definition.h). */
+#define SCHED_NORMAL_SIZE               24
+#define SCHED_BULK_SIZE                 8
+
+// Event IDs of the model (the class of each one is in m_class_table).
+#define SCHED_EVT_CONNECT               0                                       /**< EVT_CNT_CMPL and the other state transitions. */
+#define SCHED_EVT_TIMEOUT               1                                       /**< EVT_ADV_TO, EVT_BLE_ACK_TO, ... */
+#define SCHED_EVT_BLE_CMD               2                                       /**< EVT_BLE_CMD_xxx */
+#define SCHED_EVT_ACC_FIFO              3                                       /**< EVT_ACC_FIFO_INT (coalesced) */
+#define SCHED_EVT_RTC                   4                                       /**< EVT_RTC_INT */
+#define SCHED_EVT_READ_LOG              5                                       /**< EVT_BLE_CMD_READ_LOG */
+#define SCHED_EVT_RSSI                  6                                       /**< EVT_RSSI_NOTIFY (coalesced) */
+#define SCHED_EVT_NUM                   7
+
+#define SCHED_STEPS_DEFAULT             100000
+
+// Event IDs of the ordering cases (the class of each one is in m_order_table).
+#define ORDER_EVT_CONNECT               0                                       /**< EVT_CNT_CMPL */
+#define ORDER_EVT_DISCONNECT            1                                       /**< EVT_DISCNT_SUCCESS */
+#define ORDER_EVT_TIMEOUT               2                                       /**< EVT_BLE_ACK_TO */
+#define ORDER_EVT_BLE_CMD               3                                       /**< EVT_BLE_CMD_GET_TIME */
+#define ORDER_EVT_RTC                   4                                       /**< EVT_RTC_INT */
+#define ORDER_EVT_FLASH_CMPL            5                                       /**< EVT_FLASH_DATA_WRITE_CMPL / ERASE_CMPL */
+#define ORDER_EVT_FLASH_CHECK           6                                       /**< EVT_FLASH_OP_STATUS_CHECK */
+#define ORDER_EVT_READ_LOG              7                                       /**< EVT_BLE_CMD_READ_LOG */
+#define ORDER_EVT_NUM                   8
+
+typedef struct
+{
+    uint32_t seq;                                                               /**< Push order of this event. */
+    uint32_t tick;                                                              /**< Tick of the push. */
+    uint16_t ahead;                                                             /**< Events of the same class queued before it. */
+    uint8_t  evt_id;
+} sched_item_t;
+
+typedef struct
+{
+    const char * p_name;
+    uint16_t     rate[SCHED_EVT_NUM];                                           /**< Pushes per 1000 ticks. */
+    uint8_t      burst;                                                         /**< Events per push (interrupt storm). */
+} storm_t;
+
+static const uint8_t m_class_table[SCHED_EVT_NUM] =
+{
+    [SCHED_EVT_CONNECT]  = EVT_SCHED_CLASS_CRITICAL,
+    [SCHED_EVT_TIMEOUT]  = EVT_SCHED_CLASS_CRITICAL,
+    [SCHED_EVT_BLE_CMD]  = EVT_SCHED_CLASS_NORMAL,
+    [SCHED_EVT_ACC_FIFO] = EVT_SCHED_CLASS_NORMAL | EVT_SCHED_COALESCE,
+    [SCHED_EVT_RTC]      = EVT_SCHED_CLASS_NORMAL,
+    [SCHED_EVT_READ_LOG] = EVT_SCHED_CLASS_BULK,
+    [SCHED_EVT_RSSI]     = EVT_SCHED_CLASS_BULK | EVT_SCHED_COALESCE,
+};
+
+static const uint8_t m_order_table[ORDER_EVT_NUM] =
+{
+    [ORDER_EVT_CONNECT]     = EVT_SCHED_CLASS_CRITICAL | EVT_SCHED_ORDERED,
+    [ORDER_EVT_DISCONNECT]  = EVT_SCHED_CLASS_CRITICAL | EVT_SCHED_ORDERED,
+    [ORDER_EVT_TIMEOUT]     = EVT_SCHED_CLASS_CRITICAL,
+    [ORDER_EVT_BLE_CMD]     = EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+    [ORDER_EVT_RTC]         = EVT_SCHED_CLASS_NORMAL,
+    [ORDER_EVT_FLASH_CMPL]  = EVT_SCHED_CLASS_NORMAL,
+    [ORDER_EVT_FLASH_CHECK] = EVT_SCHED_CLASS_NORMAL,
+    [ORDER_EVT_READ_LOG]    = EVT_SCHED_CLASS_BULK | EVT_SCHED_ORDERED,
+};
+
+static const storm_t m_storms[] =
+{
+    // Everything below the service rate: no drops, latency close to 1.
+    { "idle",        {  20,  20,  50, 100,  10,  50,  20 }, 1 },
+    // Sensor interrupts much faster than the loop: ACC FIFO must coalesce.
+    { "acc_storm",   {  10,  10,  50, 900,  10,  50,  20 }, 4 },
+    // Daily log download with RSSI notifies while commands keep coming.
+    { "bulk_storm",  {  10,  10, 200, 100,  10, 800, 500 }, 2 },
+    // Connection churn: the critical class alone exceeds the service rate.
+    { "crit_storm",  { 600, 600, 100, 300,  10, 200, 100 }, 2 },
+    // All classes saturated at once.
+    { "saturate",    { 900, 900, 900, 900, 900, 900, 900 }, 3 },
+};
+
+static sched_item_t   m_item[EVT_SCHED_CLASS_NUM][SCHED_NORMAL_SIZE];
+static EVT_SCHED_SLOT m_slot[EVT_SCHED_CLASS_NUM][SCHED_NORMAL_SIZE];
+static EVT_SCHED      m_sched;
+static uint32_t       m_tick;
+static uint32_t       m_rand_state;
+
+static uint32_t sched_get_tick(void)
+{
+    return m_tick;
+}
+
+static uint32_t rand_next(void)
+{
+    // xorshift32: the same storm for the same seed on every host.
+    m_rand_state ^= m_rand_state << 13;
+    m_rand_state ^= m_rand_state >> 17;
+    m_rand_state ^= m_rand_state << 5;
+    return m_rand_state;
+}
+
+#define SCHED_GAP_MAX                   (EVT_SCHED_STARVE_LIMIT + EVT_SCHED_CLASS_NUM - 2)
+
+static uint32_t latency_bound(uint32_t ahead)
+{
+    return (ahead + 1) * (SCHED_GAP_MAX + 1);
+}
+
+#define CHECK(cond, ...)                                                                    \
+    do                                                                                      \
+    {                                                                                       \
+        if (!(cond))                                                                        \
+        {                                                                                   \
+            fprintf(stderr, "FAIL %s tick %u: ", p_storm->p_name, m_tick);                  \
+            fprintf(stderr, __VA_ARGS__);                                                   \
+            fputc('\n', stderr);                                                            \
+            return false;                                                                   \
+        }                                                                                   \
+    } while (0)
+
+static bool sched_init(const uint8_t * p_class_table, uint8_t evt_num)
+{
+    EVT_SCHED_CONFIG config;
+
+    memset(&config, 0, sizeof(config));
+    config.p_item[EVT_SCHED_CLASS_CRITICAL] = (uint8_t *)m_item[EVT_SCHED_CLASS_CRITICAL];
+    config.p_item[EVT_SCHED_CLASS_NORMAL]   = (uint8_t *)m_item[EVT_SCHED_CLASS_NORMAL];
+    config.p_item[EVT_SCHED_CLASS_BULK]     = (uint8_t *)m_item[EVT_SCHED_CLASS_BULK];
+    config.p_slot[EVT_SCHED_CLASS_CRITICAL] = m_slot[EVT_SCHED_CLASS_CRITICAL];
+    config.p_slot[EVT_SCHED_CLASS_NORMAL]   = m_slot[EVT_SCHED_CLASS_NORMAL];
+    config.p_slot[EVT_SCHED_CLASS_BULK]     = m_slot[EVT_SCHED_CLASS_BULK];
+    config.size[EVT_SCHED_CLASS_CRITICAL]   = SCHED_CRITICAL_SIZE;
+    config.size[EVT_SCHED_CLASS_NORMAL]     = SCHED_NORMAL_SIZE;
+    config.size[EVT_SCHED_CLASS_BULK]       = SCHED_BULK_SIZE;
+    config.item_size     = sizeof(sched_item_t);
+    config.p_class_table = p_class_table;
+    config.evt_num       = evt_num;
+    config.get_tick      = sched_get_tick;
+    config.tick_mask     = UINT32_MAX;
+    return (EvtSchedInit(&m_sched, &config) == EVT_SCHED_SUCCESS);
+}
+
+static bool storm_run(const storm_t * p_storm, uint32_t steps)
+{
+    EVT_SCHED_STATS  stats[EVT_SCHED_CLASS_NUM];
+    sched_item_t     item;
+    uint32_t         last_seq[EVT_SCHED_CLASS_NUM];
+    uint32_t         gap[EVT_SCHED_CLASS_NUM] = {0};
+    uint32_t         gap_max[EVT_SCHED_CLASS_NUM] = {0};
+    uint32_t         over_bound = 0;
+    uint32_t         pushed = 0;
+    uint32_t         coalesced = 0;
+    uint32_t         dropped = 0;
+    uint32_t         popped = 0;
+    uint32_t         seq = 0;
+    uint32_t         ret;
+    uint32_t         acc_queued = 0;
+    uint8_t          class_id;
+    uint8_t          evt_id;
+    uint8_t          n;
+
+    if (!sched_init(m_class_table, SCHED_EVT_NUM))
+    {
+        fprintf(stderr, "FAIL %s: EvtSchedInit\n", p_storm->p_name);
+        return false;
+    }
+    memset(last_seq, 0xFF, sizeof(last_seq));
+
+    for (m_tick = 0; m_tick < steps; m_tick++)
+    {
+        // Interrupts of this tick.
+        for (evt_id = 0; evt_id < SCHED_EVT_NUM; evt_id++)
+        {
+            if ((rand_next() % 1000) >= p_storm->rate[evt_id])
+            {
+                continue;
+            }
+            class_id = m_class_table[evt_id] & EVT_SCHED_CLASS_MASK;
+            for (n = 0; n < p_storm->burst; n++)
+            {
+                item.seq    = seq++;
+                item.tick   = m_tick;
+                item.ahead  = (uint16_t)m_sched.queue[class_id].count;
+                item.evt_id = evt_id;
+                ret = EvtSchedPush(&m_sched, evt_id, &item);
+                if (ret == EVT_SCHED_SUCCESS)
+                {
+                    pushed++;
+                    if (evt_id == SCHED_EVT_ACC_FIFO)
+                    {
+                        acc_queued++;
+                        CHECK(acc_queued == 1, "ACC FIFO queued %u times", acc_queued);
+                    }
+                }
+                else if (ret == EVT_SCHED_COALESCED)
+                {
+                    coalesced++;
+                    CHECK((acc_queued != 0) || (evt_id != SCHED_EVT_ACC_FIFO), "ACC FIFO coalesced with nothing queued");
+                }
+                else
+                {
+                    CHECK(ret == EVT_SCHED_NO_MEM, "push returned %u", ret);
+                    dropped++;
+                }
+            }
+        }
+
+        // Fairness: how long has each non-empty class waited.
+        for (class_id = 0; class_id < EVT_SCHED_CLASS_NUM; class_id++)
+        {
+            if (m_sched.queue[class_id].count == 0)
+            {
+                gap[class_id] = 0;
+            }
+        }
+
+        // The main loop handles one event.
+        ret = EvtSchedPop(&m_sched, &item);
+        if (ret == EVT_SCHED_EMPTY)
+        {
+            continue;
+        }
+        CHECK(ret == EVT_SCHED_SUCCESS, "pop returned %u", ret);
+        popped++;
+        class_id = m_class_table[item.evt_id] & EVT_SCHED_CLASS_MASK;
+
+        CHECK((last_seq[class_id] == UINT32_MAX) || (item.seq > last_seq[class_id]),
+              "class %u popped seq %u after %u", class_id, item.seq, last_seq[class_id]);
+        last_seq[class_id] = item.seq;
+
+        if ((m_tick - item.tick + 1) > latency_bound(item.ahead))
+        {
+            over_bound++;
+            CHECK(false, "evt %u waited %u pops with %u ahead (bound %u)",
+                  item.evt_id, m_tick - item.tick + 1, item.ahead, latency_bound(item.ahead));
+        }
+        if (item.evt_id == SCHED_EVT_ACC_FIFO)
+        {
+            // Popped: the next interrupt must queue a new drain.
+            acc_queued--;
+        }
+
+        for (n = 0; n < EVT_SCHED_CLASS_NUM; n++)
+        {
+            if (n == class_id)
+            {
+                gap[n] = 0;
+            }
+            else if (m_sched.queue[n].count != 0)
+            {
+                gap[n]++;
+                if (gap[n] > gap_max[n])
+                {
+                    gap_max[n] = gap[n];
+                }
+                CHECK(gap[n] <= SCHED_GAP_MAX,
+                      "class %u not served for %u pops", n, gap[n]);
+            }
+        }
+    }
+
+    // Every accepted push is popped or still queued, and the counters agree.
+    CHECK(pushed == popped + EvtSchedDepth(&m_sched), "pushed %u popped %u queued %u",
+          pushed, popped, EvtSchedDepth(&m_sched));
+    for (class_id = 0; class_id < EVT_SCHED_CLASS_NUM; class_id++)
+    {
+        EvtSchedGetStats(&m_sched, class_id, &stats[class_id]);
+    }
+    CHECK(stats[0].coalesce_count + stats[1].coalesce_count + stats[2].coalesce_count == coalesced,
+          "coalesce counters");
+    CHECK(stats[0].drop_count + stats[1].drop_count + stats[2].drop_count == dropped, "drop counters");
+    CHECK(stats[EVT_SCHED_CLASS_NORMAL].depth_max <= SCHED_NORMAL_SIZE, "normal depth_max");
+
+    printf("%-11s push=%u coalesce=%u drop=%u pop=%u", p_storm->p_name, pushed, coalesced, dropped, popped);
+    for (class_id = 0; class_id < EVT_SCHED_CLASS_NUM; class_id++)
+    {
+        printf(" | c%u depth_max=%u lat_avg=%.1f lat_max=%u gap_max=%u", class_id,
+               stats[class_id].depth_max,
+               stats[class_id].pop_count ? (double)stats[class_id].latency_sum / stats[class_id].pop_count : 0.0,
+               stats[class_id].latency_max, gap_max[class_id]);
+    }
+    printf("\n");
+    return (over_bound == 0);
+}
+
+/**@brief Push the events of p_push, pop everything and compare with p_expect.
+ */
+static bool order_run(const storm_t * p_storm, const uint8_t * p_push, uint8_t push_num,
+                      const uint8_t * p_expect)
+{
+    sched_item_t item;
+    uint8_t      n;
+
+    CHECK(sched_init(m_order_table, ORDER_EVT_NUM), "EvtSchedInit");
+    m_tick = 0;
+    for (n = 0; n < push_num; n++)
+    {
+        item.seq    = n;
+        item.tick   = 0;
+        item.ahead  = 0;
+        item.evt_id = p_push[n];
+        CHECK(EvtSchedPush(&m_sched, p_push[n], &item) == EVT_SCHED_SUCCESS, "push %u", n);
+    }
+    for (n = 0; n < push_num; n++)
+    {
+        CHECK(EvtSchedPop(&m_sched, &item) == EVT_SCHED_SUCCESS, "pop %u", n);
+        CHECK(item.evt_id == p_expect[n], "pop %u: evt %u (push %u), expected evt %u",
+              n, item.evt_id, item.seq, p_expect[n]);
+    }
+    CHECK(EvtSchedPop(&m_sched, &item) == EVT_SCHED_EMPTY, "events left");
+    return true;
+}
+
+static bool order_connection(void)
+{
+    static const storm_t p_storm[1] = { { "order_conn", { 0 }, 0 } };
+    // Commands and a log read of the first connection, the disconnect, then the
+    // next connection and its command. The RTC and the timeout are unordered.
+    static const uint8_t push[] =
+    {
+        ORDER_EVT_BLE_CMD, ORDER_EVT_READ_LOG, ORDER_EVT_RTC, ORDER_EVT_BLE_CMD,
+        ORDER_EVT_DISCONNECT, ORDER_EVT_TIMEOUT, ORDER_EVT_CONNECT, ORDER_EVT_BLE_CMD,
+    };
+    static const uint8_t expect[] =
+    {
+        ORDER_EVT_BLE_CMD, ORDER_EVT_READ_LOG, ORDER_EVT_RTC, ORDER_EVT_BLE_CMD,
+        ORDER_EVT_DISCONNECT, ORDER_EVT_TIMEOUT, ORDER_EVT_CONNECT, ORDER_EVT_BLE_CMD,
+    };
+    // Nothing ordered queued before it: the connect still goes ahead of
+    // NORMAL/BULK, and the later command stays behind the earlier log read.
+    static const uint8_t push_first[] =
+    {
+        ORDER_EVT_CONNECT, ORDER_EVT_RTC, ORDER_EVT_READ_LOG, ORDER_EVT_TIMEOUT, ORDER_EVT_BLE_CMD,
+    };
+    static const uint8_t expect_first[] =
+    {
+        ORDER_EVT_CONNECT, ORDER_EVT_TIMEOUT, ORDER_EVT_RTC, ORDER_EVT_READ_LOG, ORDER_EVT_BLE_CMD,
+    };
+
+    return order_run(p_storm, push, sizeof(push), expect) &&
+           order_run(p_storm, push_first, sizeof(push_first), expect_first);
+}
+
+static bool order_flash(void)
+{
+    static const storm_t p_storm[1] = { { "order_flash", { 0 }, 0 } };
+    static const uint8_t push_cmpl[] =
+    {
+        ORDER_EVT_FLASH_CMPL, ORDER_EVT_RTC, ORDER_EVT_FLASH_CHECK, ORDER_EVT_TIMEOUT,
+    };
+    static const uint8_t expect_cmpl[] =
+    {
+        ORDER_EVT_TIMEOUT, ORDER_EVT_FLASH_CMPL, ORDER_EVT_RTC, ORDER_EVT_FLASH_CHECK,
+    };
+    static const uint8_t push_check[] =
+    {
+        ORDER_EVT_FLASH_CHECK, ORDER_EVT_RTC, ORDER_EVT_FLASH_CMPL, ORDER_EVT_TIMEOUT,
+    };
+    static const uint8_t expect_check[] =
+    {
+        ORDER_EVT_TIMEOUT, ORDER_EVT_FLASH_CHECK, ORDER_EVT_RTC, ORDER_EVT_FLASH_CMPL,
+    };
+
+    return order_run(p_storm, push_cmpl, sizeof(push_cmpl), expect_cmpl) &&
+           order_run(p_storm, push_check, sizeof(push_check), expect_check);
+}
+
+/**@brief Random pushes and pops of m_order_table events: ORDERED events pop in
+ *        push order, each class pops in push order, and the queue drains.
+ */
+static bool order_random(uint32_t steps)
+{
+    static const storm_t p_storm[1] = { { "order_rand", { 0 }, 0 } };
+    sched_item_t item;
+    uint32_t     last_seq[EVT_SCHED_CLASS_NUM];
+    uint32_t     last_ordered = UINT32_MAX;
+    uint32_t     seq = 0;
+    uint32_t     pushed = 0;
+    uint32_t     popped = 0;
+    uint32_t     ordered = 0;
+    uint8_t      class_id;
+    uint8_t      evt_id;
+    uint8_t      n;
+
+    CHECK(sched_init(m_order_table, ORDER_EVT_NUM), "EvtSchedInit");
+    memset(last_seq, 0xFF, sizeof(last_seq));
+
+    for (m_tick = 0; m_tick < steps + SCHED_CRITICAL_SIZE + SCHED_NORMAL_SIZE + SCHED_BULK_SIZE; m_tick++)
+    {
+        // Bursts of up to 3 pushes per pop while steps last, then drain.
+        for (n = (m_tick < steps) ? (uint8_t)(rand_next() % 4) : 0; n > 0; n--)
+        {
+            evt_id      = (uint8_t)(rand_next() % ORDER_EVT_NUM);
+            item.seq    = seq++;
+            item.tick   = m_tick;
+            item.ahead  = 0;
+            item.evt_id = evt_id;
+            if (EvtSchedPush(&m_sched, evt_id, &item) == EVT_SCHED_SUCCESS)
+            {
+                pushed++;
+            }
+        }
+
+        if (EvtSchedPop(&m_sched, &item) != EVT_SCHED_SUCCESS)
+        {
+            continue;
+        }
+        popped++;
+        class_id = m_order_table[item.evt_id] & EVT_SCHED_CLASS_MASK;
+        CHECK((last_seq[class_id] == UINT32_MAX) || (item.seq > last_seq[class_id]),
+              "class %u popped seq %u after %u", class_id, item.seq, last_seq[class_id]);
+        last_seq[class_id] = item.seq;
+        if ((m_order_table[item.evt_id] & EVT_SCHED_ORDERED) != 0)
+        {
+            CHECK((last_ordered == UINT32_MAX) || (item.seq > last_ordered),
+                  "ordered evt %u popped seq %u after %u", item.evt_id, item.seq, last_ordered);
+            last_ordered = item.seq;
+            ordered++;
+        }
+    }
+    CHECK(EvtSchedDepth(&m_sched) == 0, "%u events left", EvtSchedDepth(&m_sched));
+    CHECK(pushed == popped, "pushed %u popped %u", pushed, popped);
+
+    printf("%-11s push=%u pop=%u ordered=%u\n", p_storm->p_name, pushed, popped, ordered);
+    return true;
+}
+
+static void usage(const char * p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-n steps] [-s seed]\n"
+            "  -n  ticks per storm (default %u)\n"
+            "  -s  random seed (default 1)\n",
+            p_name, SCHED_STEPS_DEFAULT);
+}
+
+int main(int argc, char * argv[])
+{
+    uint32_t steps = SCHED_STEPS_DEFAULT;
+    uint32_t seed = 1;
+    bool     ok = true;
+    size_t   i;
+    int      opt;
+
+    while ((opt = getopt(argc, argv, "n:s:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                steps = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+
+    for (i = 0; i < sizeof(m_storms) / sizeof(m_storms[0]); i++)
+    {
+        m_rand_state = seed ? seed : 1;
+        ok = storm_run(&m_storms[i], steps) && ok;
+    }
+    ok = order_connection() && ok;
+    ok = order_flash() && ok;
+    m_rand_state = seed ? seed : 1;
+    ok = order_random(steps) && ok;
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+/**
+  ******************************************************************************************
+  * @file    lib_adc_posix.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   SAADC Control (Host Build用. library/src/lib_adc.cの代わりにLinkする)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include "lib_adc.h"
+#include "lib_hal.h"
+
+/*
+ * SAADC/RTC2/PPIはHost上にないため, 電池電圧はHOST_BAT_MV固定とする.
+ * lib_adc.cと同じく, 監視開始から最初のDMA転送 (周期 x BAT_MON_SAMPLES) までは未取得を返す
+ */
+
+/* Definition ------------------------------------------------------------*/
+#define HOST_BAT_MV				(3000)		/* 電池電圧 [mV] */
+#define HOST_BAT_SOC			(100)		/* HOST_BAT_MVの残量 (lib_adc.cの残量推定Table) [%] */
+
+/* private variables -----------------------------------------------------*/
+static bool g_bat_mon_running = false;
+static uint32_t g_bat_mon_ready_ms = 0;		/* 最初の値が取れる時刻 [ms] */
+
+/* private functions -----------------------------------------------------*/
+/**
+ * @brief 最初の値が取れたか
+ * @param None
+ * @retval true 取得済み
+ */
+static bool analog_monitor_ready( void )
+{
+	return ( g_bat_mon_running == true ) && ( (int32_t)( HalTimeMs() - g_bat_mon_ready_ms ) >= 0 );
+}
+
+/* public functions ------------------------------------------------------*/
+/**
+ * @brief SAADC Sampling Start
+ * @param None
+ * @retval None
+ */
+void StartADC( void )
+{
+}
+
+/**
+ * @brief SAADC Initialize
+ * @param None
+ * @retval None
+ */
+void AnalogInitialize( void )
+{
+}
+
+/**
+ * @brief SAADC Uninitialize
+ * @param None
+ * @retval None
+ */
+void AnalogUninit( void )
+{
+}
+
+/**
+ * @brief 起動時の電圧チェック
+ * @param None
+ * @retval NRF_SUCCESS Success
+ */
+ret_code_t AnalogStartUpCheck( void )
+{
+	return NRF_SUCCESS;
+}
+
+/**
+ * @brief 電池電圧を取得
+ * @param None
+ * @retval 電池電圧 [V]
+ */
+float AnalogVoltageOneshot( void )
+{
+	return (float)HOST_BAT_MV / 1000.0f;
+}
+
+/**
+ * @brief 電池電圧の監視開始
+ * @param period_ms Sampling周期 [ms]
+ * @retval NRF_SUCCESS Success
+ * @retval NRF_ERROR_INVALID_PARAM period_msが0
+ */
+ret_code_t AnalogMonitorStart( uint32_t period_ms )
+{
+	if ( period_ms == 0 )
+	{
+		return NRF_ERROR_INVALID_PARAM;
+	}
+
+	g_bat_mon_ready_ms = HalTimeMs() + ( period_ms * BAT_MON_SAMPLES );
+	g_bat_mon_running = true;
+
+	return NRF_SUCCESS;
+}
+
+/**
+ * @brief 電池電圧の監視停止
+ * @param None
+ * @retval None
+ */
+void AnalogMonitorStop( void )
+{
+	g_bat_mon_running = false;
+}
+
+/**
+ * @brief Filter後の電池電圧を取得
+ * @param None
+ * @retval 電池電圧 [mV] (BAT_MON_INVALID_MV:未取得)
+ */
+uint16_t AnalogGetBatteryMv( void )
+{
+	return ( analog_monitor_ready() == true ) ? HOST_BAT_MV : BAT_MON_INVALID_MV;
+}
+
+/**
+ * @brief 電池残量の推定値を取得
+ * @param None
+ * @retval 電池残量 [%] (未取得の場合は0)
+ */
+uint8_t AnalogGetBatterySoc( void )
+{
+	return ( analog_monitor_ready() == true ) ? HOST_BAT_SOC : 0;
+}
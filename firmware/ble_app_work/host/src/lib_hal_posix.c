@@ -0,0 +1,1323 @@
+/**
+  ******************************************************************************************
+  * @file    lib_hal_posix.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Hardware Abstraction Layer (Linux実装: 仮想時間, Trace再生, File Flash)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Debug UARTを追加 (標準Errorに出力)
+  * 1.2            2026/10/19       k.tashiro         GPIO Pull/WakeUp/出力, Delayを追加, HalWaitEventで時間を戻さない
+  * 1.3            2026/10/19       k.tashiro         HalPosixTraceLogをTrace ID番号の出力に変更
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#define _DEFAULT_SOURCE				/* timegm */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lib_hal.h"
+#include "lib_hal_posix.h"
+
+#include "pin_config.h"
+
+/* Definition ------------------------------------------------------------*/
+/* ICM-42607 (lib_icm42607.hと同値) */
+#define IMU_REG_ACCEL_DATA_X1		(0x0B)
+#define IMU_REG_PWR_MGMT0			(0x1F)
+#define IMU_REG_ACC_CONFIG0			(0x21)
+#define IMU_REG_WOM_CONFIG			(0x27)
+#define IMU_REG_INT_SOURCE1			(0x2C)
+#define IMU_REG_SIGNAL_PATH_RESET	(0x02)
+#define IMU_REG_INT_STATUS2			(0x3B)
+#define IMU_REG_WHO_AM_I			(0x75)
+#define IMU_REG_BLK_SEL_W			(0x79)
+#define IMU_REG_MADDR_W				(0x7A)
+#define IMU_REG_M_W					(0x7B)
+#define IMU_REG_MADDR_R				(0x7D)
+#define IMU_REG_M_R					(0x7E)
+#define IMU_MREG1_WOM_X_THR			(0x4B)
+#define IMU_DEVICE_ID				(0x68)
+#define IMU_SOFT_RESET				(0x10)
+#define IMU_ACC_MODE_MASK			(0x03)
+#define IMU_ACC_MODE_LP				(0x02)
+#define IMU_ODR_MASK				(0x0F)
+#define IMU_FSS_POS					(5)
+#define IMU_FSS_MASK				(0x03)
+#define IMU_WOM_EN					(0x01)
+#define IMU_WOM_DIFF				(0x02)
+#define IMU_INT_WOM_MASK			(0x07)
+#define IMU_WOM_X					(0x04)		/* INT_STATUS2 */
+#define IMU_WOM_Y					(0x02)
+#define IMU_WOM_Z					(0x01)
+#define IMU_INVALID_DATA			(0x8000)
+#define IMU_READ_BIT				(0x80)
+
+/* BL5372 (lib_ex_rtc.hと同値) */
+#define RTC_SLAVE_ADDR				(0x32)
+#define RTC_REG_NUM					(16)
+#define RTC_TIME_REG_NUM			(7)			/* 秒/分/時/曜日/日/月/年 */
+
+#define HAL_GPIO_INT_MAX			(4)
+#define HAL_FLASH_SIZE				( HAL_FLASH_END_ADDR - HAL_FLASH_START_ADDR )
+#define HAL_TRACE_LINE_MAX			(128)
+
+/* Struct ----------------------------------------------------------------*/
+/* Traceの1 Sample */
+typedef struct _hal_trace_sample
+{
+	uint32_t t_ms;
+	int16_t mg[3];
+} HAL_TRACE_SAMPLE;
+
+/* Timer */
+typedef struct _hal_timer
+{
+	HAL_TIMER_HANDLER handler;
+	void *p_context;
+	uint64_t due_ms;
+	uint32_t period_ms;
+	bool repeated;
+	bool running;
+} HAL_TIMER;
+
+/* GPIO割込み */
+typedef struct _hal_gpio_int
+{
+	uint32_t pin;
+	HAL_GPIO_EDGE edge;
+	HAL_GPIO_HANDLER handler;
+	bool enable;
+} HAL_GPIO_INT;
+
+/* ICM-42607 Register Model */
+typedef struct _hal_imu_model
+{
+	uint8_t reg[256];
+	uint8_t mreg1[256];
+	int16_t last_mg[3];			/* WOM差分判定用 */
+	bool last_valid;
+	uint64_t next_odr_ms;
+	uint32_t trace_pos;
+	bool int1_level;
+} HAL_IMU_MODEL;
+
+/* BL5372 Register Model */
+typedef struct _hal_rtc_model
+{
+	uint8_t reg[RTC_REG_NUM];
+	time_t base;				/* 仮想時間0での時刻 */
+	uint8_t pointer;			/* 次に読み出すRegister */
+} HAL_RTC_MODEL;
+
+/* Private variables -----------------------------------------------------*/
+static HAL_POSIX_CONFIG g_hal_config;
+static HAL_POSIX_STATS g_hal_stats;
+static uint64_t g_hal_now_ms = 0;
+static uint64_t g_hal_end_ms = 0;
+static uint32_t g_hal_delay_us = 0;			/* 1ms未満のDelay (HalDelayUsの端数) */
+
+static HAL_TRACE_SAMPLE *g_hal_trace = NULL;
+static uint32_t g_hal_trace_num = 0;
+
+static HAL_TIMER g_hal_timer[HAL_TIMER_MAX];
+static uint8_t g_hal_timer_num = 0;
+
+static HAL_GPIO_INT g_hal_gpio_int[HAL_GPIO_INT_MAX];
+static uint8_t g_hal_gpio_int_num = 0;
+
+static HAL_IMU_MODEL g_hal_imu;
+static HAL_RTC_MODEL g_hal_rtc;
+
+static uint8_t g_hal_flash[HAL_FLASH_SIZE];
+
+static bool g_hal_debug_init = false;
+
+static const uint8_t *g_hal_adv_payload = NULL;
+static uint16_t g_hal_adv_len = 0;
+
+/**
+ * @brief 仮想時間を出力 (行頭)
+ * @param p_tag 種類
+ * @retval None
+ */
+static void hal_print_head( const char *p_tag )
+{
+	printf( "%8llu.%03llu %-6s", (unsigned long long)( g_hal_now_ms / 1000 ), (unsigned long long)( g_hal_now_ms % 1000 ), p_tag );
+}
+
+/**
+ * @brief Byte列をHexで出力
+ * @param p_data Data
+ * @param len Byte数
+ * @retval None
+ */
+static void hal_print_hex( const uint8_t *p_data, uint16_t len )
+{
+	uint16_t i;
+
+	for ( i = 0; i < len; i++ )
+	{
+		printf( "%02x", p_data[i] );
+	}
+}
+
+/**
+ * @brief IMU Trace (CSV) の読み込み
+ * @param p_path File Path
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+static uint32_t hal_trace_load( const char *p_path )
+{
+	FILE *fp;
+	char line[HAL_TRACE_LINE_MAX];
+	uint32_t cap = 0;
+	unsigned long t;
+	int ax, ay, az;
+	HAL_TRACE_SAMPLE *p_new;
+
+	fp = fopen( p_path, "r" );
+	if ( fp == NULL )
+	{
+		return HAL_ERROR_NOT_FOUND;
+	}
+
+	while ( fgets( line, sizeof( line ), fp ) != NULL )
+	{
+		/* Comment/Header行は読み飛ばす */
+		if ( sscanf( line, "%lu,%d,%d,%d", &t, &ax, &ay, &az ) != 4 )
+		{
+			continue;
+		}
+		if ( ( g_hal_trace_num > 0 ) && ( t < g_hal_trace[g_hal_trace_num - 1].t_ms ) )
+		{
+			fprintf( stderr, "%s: time goes back at %lu ms\n", p_path, t );
+			fclose( fp );
+			return HAL_ERROR_INVALID_PARAM;
+		}
+		if ( g_hal_trace_num >= cap )
+		{
+			cap = ( cap == 0 ) ? 1024 : ( cap * 2 );
+			p_new = realloc( g_hal_trace, cap * sizeof( HAL_TRACE_SAMPLE ) );
+			if ( p_new == NULL )
+			{
+				fclose( fp );
+				return HAL_ERROR_NO_MEM;
+			}
+			g_hal_trace = p_new;
+		}
+		g_hal_trace[g_hal_trace_num].t_ms = (uint32_t)t;
+		g_hal_trace[g_hal_trace_num].mg[0] = (int16_t)ax;
+		g_hal_trace[g_hal_trace_num].mg[1] = (int16_t)ay;
+		g_hal_trace[g_hal_trace_num].mg[2] = (int16_t)az;
+		g_hal_trace_num++;
+	}
+	fclose( fp );
+
+	return ( g_hal_trace_num > 0 ) ? HAL_SUCCESS : HAL_ERROR_NOT_FOUND;
+}
+
+/**
+ * @brief ODR設定から1 Sampleの周期を取得
+ * @param None
+ * @retval 周期 [ms]
+ */
+static uint32_t hal_imu_odr_ms( void )
+{
+	/* ACC_ODR_1_6KHZ(0x05) - ACC_ODR_1_5625HZ(0x0F) */
+	static const uint16_t odr_ms[16] = { 20, 20, 20, 20, 20, 1, 1, 3, 5, 10, 20, 40, 80, 160, 320, 640 };
+
+	return odr_ms[g_hal_imu.reg[IMU_REG_ACC_CONFIG0] & IMU_ODR_MASK];
+}
+
+/**
+ * @brief 加速度が有効か (Low Power/Low Noise)
+ * @param None
+ * @retval true 有効
+ */
+static bool hal_imu_acc_on( void )
+{
+	return ( g_hal_imu.reg[IMU_REG_PWR_MGMT0] & IMU_ACC_MODE_MASK ) >= IMU_ACC_MODE_LP;
+}
+
+/**
+ * @brief IMU Registerを初期値にする (Power On / Software Reset)
+ * @param None
+ * @retval None
+ */
+static void hal_imu_reset( void )
+{
+	uint32_t trace_pos = g_hal_imu.trace_pos;
+
+	memset( &g_hal_imu, 0, sizeof( g_hal_imu ) );
+	g_hal_imu.trace_pos = trace_pos;
+	g_hal_imu.reg[IMU_REG_WHO_AM_I] = IMU_DEVICE_ID;
+	g_hal_imu.reg[IMU_REG_ACC_CONFIG0] = 0x06;
+	g_hal_imu.reg[IMU_REG_ACCEL_DATA_X1 + 0] = IMU_INVALID_DATA >> 8;
+	g_hal_imu.reg[IMU_REG_ACCEL_DATA_X1 + 2] = IMU_INVALID_DATA >> 8;
+	g_hal_imu.reg[IMU_REG_ACCEL_DATA_X1 + 4] = IMU_INVALID_DATA >> 8;
+}
+
+/**
+ * @brief GPIOの変化を割込みHandlerに通知
+ * @param pin Pin番号
+ * @param level 変化後のLevel
+ * @retval None
+ */
+static void hal_gpio_edge( uint32_t pin, bool level )
+{
+	uint8_t i;
+
+	for ( i = 0; i < g_hal_gpio_int_num; i++ )
+	{
+		if ( ( g_hal_gpio_int[i].pin != pin ) || ( g_hal_gpio_int[i].enable == false ) )
+		{
+			continue;
+		}
+		if ( ( g_hal_gpio_int[i].edge == HAL_GPIO_EDGE_TOGGLE ) ||
+			 ( ( g_hal_gpio_int[i].edge == HAL_GPIO_EDGE_RISE ) && ( level == true ) ) ||
+			 ( ( g_hal_gpio_int[i].edge == HAL_GPIO_EDGE_FALL ) && ( level == false ) ) )
+		{
+			g_hal_stats.gpio_int++;
+			g_hal_gpio_int[i].handler( pin );
+		}
+	}
+}
+
+/**
+ * @brief IMUの1 Sample (ODR毎): TraceからData Registerを更新してWOMを判定する
+ * @param None
+ * @retval None
+ */
+static void hal_imu_odr_tick( void )
+{
+	const HAL_TRACE_SAMPLE *p_sample;
+	uint8_t fss;
+	int32_t lsb_per_g;
+	int32_t thr_mg;
+	int32_t raw;
+	uint8_t wom = 0;
+	uint8_t axis;
+	static const uint8_t wom_bit[3] = { IMU_WOM_X, IMU_WOM_Y, IMU_WOM_Z };
+
+	while ( ( ( g_hal_imu.trace_pos + 1 ) < g_hal_trace_num ) && ( g_hal_trace[g_hal_imu.trace_pos + 1].t_ms <= g_hal_now_ms ) )
+	{
+		g_hal_imu.trace_pos++;
+	}
+	p_sample = &g_hal_trace[g_hal_imu.trace_pos];
+
+	/* ACC_FS_SEL_16G(0) : 2048 LSB/g, ACC_FS_SEL_2G(3) : 16384 LSB/g */
+	fss = ( g_hal_imu.reg[IMU_REG_ACC_CONFIG0] >> IMU_FSS_POS ) & IMU_FSS_MASK;
+	lsb_per_g = 2048 << fss;
+
+	for ( axis = 0; axis < 3; axis++ )
+	{
+		raw = ( (int32_t)p_sample->mg[axis] * lsb_per_g ) / 1000;
+		if ( raw > INT16_MAX )
+		{
+			raw = INT16_MAX;
+		}
+		if ( raw < -INT16_MAX )
+		{
+			raw = -INT16_MAX;
+		}
+		/* Big Endian */
+		g_hal_imu.reg[IMU_REG_ACCEL_DATA_X1 + ( axis * 2 )] = (uint8_t)( (uint16_t)raw >> 8 );
+		g_hal_imu.reg[IMU_REG_ACCEL_DATA_X1 + ( axis * 2 ) + 1] = (uint8_t)raw;
+
+		/* WOM (しきい値 1g/256) */
+		thr_mg = ( (int32_t)g_hal_imu.mreg1[IMU_MREG1_WOM_X_THR + axis] * 1000 ) / 256;
+		if ( ( g_hal_imu.reg[IMU_REG_WOM_CONFIG] & IMU_WOM_DIFF ) == 0 )
+		{
+			raw = p_sample->mg[axis];
+		}
+		else if ( g_hal_imu.last_valid == true )
+		{
+			raw = p_sample->mg[axis] - g_hal_imu.last_mg[axis];
+		}
+		else
+		{
+			raw = 0;
+		}
+		if ( abs( raw ) > thr_mg )
+		{
+			wom |= wom_bit[axis];
+		}
+		g_hal_imu.last_mg[axis] = p_sample->mg[axis];
+	}
+	g_hal_imu.last_valid = true;
+
+	if ( ( g_hal_imu.reg[IMU_REG_WOM_CONFIG] & IMU_WOM_EN ) == 0 )
+	{
+		return;
+	}
+	g_hal_imu.reg[IMU_REG_INT_STATUS2] |= wom;
+
+	/* INT1はINT_STATUS2を読むまでHigh (Latch) */
+	if ( ( g_hal_imu.reg[IMU_REG_INT_STATUS2] != 0 ) && ( g_hal_imu.reg[IMU_REG_INT_SOURCE1] & IMU_INT_WOM_MASK ) && ( g_hal_imu.int1_level == false ) )
+	{
+		g_hal_imu.int1_level = true;
+		hal_gpio_edge( ACC_INT1_PIN, true );
+	}
+}
+
+/**
+ * @brief IMU Register読み出し (読み出しでクリアされるRegisterを含む)
+ * @param addr Register
+ * @retval 値
+ */
+static uint8_t hal_imu_reg_read( uint8_t addr )
+{
+	uint8_t value;
+
+	if ( addr == IMU_REG_M_R )
+	{
+		return g_hal_imu.mreg1[g_hal_imu.reg[IMU_REG_MADDR_R]];
+	}
+
+	value = g_hal_imu.reg[addr];
+	if ( addr == IMU_REG_INT_STATUS2 )
+	{
+		g_hal_imu.reg[addr] = 0;
+		if ( g_hal_imu.int1_level == true )
+		{
+			g_hal_imu.int1_level = false;
+			hal_gpio_edge( ACC_INT1_PIN, false );
+		}
+	}
+
+	return value;
+}
+
+/**
+ * @brief IMU Register書き込み
+ * @param addr Register
+ * @param value 値
+ * @retval None
+ */
+static void hal_imu_reg_write( uint8_t addr, uint8_t value )
+{
+	bool acc_on = hal_imu_acc_on();
+
+	switch ( addr )
+	{
+	case IMU_REG_WHO_AM_I:
+	case IMU_REG_INT_STATUS2:
+		/* Read Only */
+		return;
+
+	case IMU_REG_SIGNAL_PATH_RESET:
+		if ( value & IMU_SOFT_RESET )
+		{
+			hal_imu_reset();
+		}
+		return;
+
+	case IMU_REG_M_W:
+		g_hal_imu.mreg1[g_hal_imu.reg[IMU_REG_MADDR_W]] = value;
+		return;
+
+	default:
+		g_hal_imu.reg[addr] = value;
+		break;
+	}
+
+	if ( ( addr == IMU_REG_PWR_MGMT0 ) && ( acc_on == false ) && hal_imu_acc_on() )
+	{
+		/* 加速度開始: 最初のSampleは1周期後 */
+		g_hal_imu.next_odr_ms = g_hal_now_ms + hal_imu_odr_ms();
+		g_hal_imu.last_valid = false;
+	}
+}
+
+/**
+ * @brief 10進 -> BCD
+ * @param value 10進
+ * @retval BCD
+ */
+static uint8_t hal_bcd( int value )
+{
+	return (uint8_t)( ( ( value / 10 ) << 4 ) | ( value % 10 ) );
+}
+
+/**
+ * @brief BCD -> 10進
+ * @param value BCD
+ * @retval 10進
+ */
+static int hal_dec( uint8_t value )
+{
+	return ( ( value >> 4 ) * 10 ) + ( value & 0x0F );
+}
+
+/**
+ * @brief RTCの時刻Registerを現在時刻にする
+ * @param None
+ * @retval None
+ */
+static void hal_rtc_update( void )
+{
+	time_t now = g_hal_rtc.base + (time_t)( g_hal_now_ms / 1000 );
+	struct tm tm_now;
+
+	gmtime_r( &now, &tm_now );
+	g_hal_rtc.reg[0] = hal_bcd( tm_now.tm_sec );
+	g_hal_rtc.reg[1] = hal_bcd( tm_now.tm_min );
+	g_hal_rtc.reg[2] = hal_bcd( tm_now.tm_hour );
+	g_hal_rtc.reg[3] = (uint8_t)tm_now.tm_wday;
+	g_hal_rtc.reg[4] = hal_bcd( tm_now.tm_mday );
+	g_hal_rtc.reg[5] = hal_bcd( tm_now.tm_mon + 1 );
+	g_hal_rtc.reg[6] = hal_bcd( tm_now.tm_year % 100 );
+}
+
+/**
+ * @brief RTCの時刻Registerへの書き込みを反映
+ * @param None
+ * @retval None
+ */
+static void hal_rtc_set( void )
+{
+	struct tm tm_set;
+
+	memset( &tm_set, 0, sizeof( tm_set ) );
+	tm_set.tm_sec	= hal_dec( g_hal_rtc.reg[0] & 0x7F );
+	tm_set.tm_min	= hal_dec( g_hal_rtc.reg[1] & 0x7F );
+	tm_set.tm_hour	= hal_dec( g_hal_rtc.reg[2] & 0x3F );
+	tm_set.tm_mday	= hal_dec( g_hal_rtc.reg[4] & 0x3F );
+	tm_set.tm_mon	= hal_dec( g_hal_rtc.reg[5] & 0x1F ) - 1;
+	tm_set.tm_year	= hal_dec( g_hal_rtc.reg[6] ) + 100;
+	g_hal_rtc.base = timegm( &tm_set ) - (time_t)( g_hal_now_ms / 1000 );
+}
+
+/**
+ * @brief Flash Addressの範囲確認
+ * @param addr Address
+ * @param len Byte数
+ * @retval true 範囲内
+ */
+static bool hal_flash_range( uint32_t addr, uint32_t len )
+{
+	return ( addr >= HAL_FLASH_START_ADDR ) && ( len <= HAL_FLASH_SIZE ) && ( ( addr - HAL_FLASH_START_ADDR ) <= ( HAL_FLASH_SIZE - len ) );
+}
+
+/**
+ * @brief Flash Fileに書き戻す (HalPosixUninitで1回だけ)
+ * @param None
+ * @retval None
+ */
+static void hal_flash_save( void )
+{
+	FILE *fp;
+
+	if ( g_hal_config.flash_path == NULL )
+	{
+		return;
+	}
+	fp = fopen( g_hal_config.flash_path, "wb" );
+	if ( fp == NULL )
+	{
+		fprintf( stderr, "%s: cannot write\n", g_hal_config.flash_path );
+		return;
+	}
+	(void)fwrite( g_hal_flash, 1, sizeof( g_hal_flash ), fp );
+	fclose( fp );
+}
+
+/**
+ * @brief 次のEventの時間
+ * @param None
+ * @retval 時間 [ms]
+ */
+static uint64_t hal_next_event_ms( void )
+{
+	uint64_t next = g_hal_end_ms + 1;
+	uint8_t i;
+
+	for ( i = 0; i < g_hal_timer_num; i++ )
+	{
+		if ( ( g_hal_timer[i].running == true ) && ( g_hal_timer[i].due_ms < next ) )
+		{
+			next = g_hal_timer[i].due_ms;
+		}
+	}
+	if ( hal_imu_acc_on() && ( g_hal_imu.next_odr_ms < next ) )
+	{
+		next = g_hal_imu.next_odr_ms;
+	}
+
+	return next;
+}
+
+/**
+ * @brief Linux実装の初期化 (Traceの読み込み, Flash Fileを開く)
+ * @param p_config 設定
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalPosixInit( const HAL_POSIX_CONFIG *p_config )
+{
+	FILE *fp;
+	uint32_t ret;
+
+	if ( ( p_config == NULL ) || ( p_config->trace_path == NULL ) )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	g_hal_config = *p_config;
+	memset( &g_hal_stats, 0, sizeof( g_hal_stats ) );
+	g_hal_now_ms = 0;
+	g_hal_delay_us = 0;
+
+	ret = hal_trace_load( p_config->trace_path );
+	if ( ret != HAL_SUCCESS )
+	{
+		fprintf( stderr, "%s: no samples (t_ms,ax_mg,ay_mg,az_mg)\n", p_config->trace_path );
+		return ret;
+	}
+	g_hal_end_ms = (uint64_t)g_hal_trace[g_hal_trace_num - 1].t_ms + p_config->tail_ms;
+
+	/* Flash (Fileがなければ消去状態) */
+	memset( g_hal_flash, 0xFF, sizeof( g_hal_flash ) );
+	if ( p_config->flash_path != NULL )
+	{
+		fp = fopen( p_config->flash_path, "rb" );
+		if ( fp != NULL )
+		{
+			(void)fread( g_hal_flash, 1, sizeof( g_hal_flash ), fp );
+			fclose( fp );
+		}
+	}
+
+	hal_imu_reset();
+	memset( &g_hal_rtc, 0, sizeof( g_hal_rtc ) );
+	g_hal_rtc.base = p_config->rtc_start;
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Linux実装の終了 (Flash Fileに書き戻す)
+ * @param None
+ * @retval None
+ */
+void HalPosixUninit( void )
+{
+	hal_flash_save();
+	free( g_hal_trace );
+	g_hal_trace = NULL;
+	g_hal_trace_num = 0;
+}
+
+/**
+ * @brief 統計を取得
+ * @param p_stats 格納先
+ * @retval None
+ */
+void HalPosixGetStats( HAL_POSIX_STATS *p_stats )
+{
+	if ( p_stats != NULL )
+	{
+		*p_stats = g_hal_stats;
+		p_stats->time_ms = g_hal_now_ms;
+	}
+}
+
+/**
+ * @brief TRACE_LOGの出力先 (host/src/lib_trace_log_posix.c)
+ * @param func_no Function Number
+ * @param param Parameter
+ * @retval None
+ */
+void HalPosixTraceLog( uint16_t func_no, uint16_t param )
+{
+	g_hal_stats.trace_log++;
+	hal_print_head( "TRACE" );
+	printf( "0x%04x %u\n", func_no, param );
+}
+
+/**
+ * @brief Critical Section開始
+ * @param p_nested 入れ子状態の格納先 (HalCriticalExitに渡す)
+ * @retval None
+ */
+void HalCriticalEnter( uint8_t *p_nested )
+{
+	/* Handlerは全てHalWaitEventから呼ぶため排他は不要 */
+	*p_nested = 0;
+}
+
+/**
+ * @brief Critical Section終了
+ * @param nested HalCriticalEnterで取得した値
+ * @retval None
+ */
+void HalCriticalExit( uint8_t nested )
+{
+	(void)nested;
+}
+
+/**
+ * @brief SPI Initialize (Pin設定 + CS Inactive)
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalSpiInit( void )
+{
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief SPI Uninitialize
+ * @param None
+ * @retval None
+ */
+void HalSpiUninit( void )
+{
+}
+
+/**
+ * @brief SPI転送 (CS Active -> 転送 -> CS Inactive)
+ * @param p_tx 送信Data
+ * @param tx_len 送信Byte数
+ * @param p_rx 受信Data格納先 (NULL:受信しない)
+ * @param rx_len 受信Byte数 (送信と同時に受信した分を含む)
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalSpiTransfer( const uint8_t *p_tx, uint8_t tx_len, uint8_t *p_rx, uint8_t rx_len )
+{
+	uint8_t addr;
+	uint8_t i;
+
+	if ( ( p_tx == NULL ) || ( tx_len == 0 ) || ( tx_len > HAL_SPI_XFER_MAX ) || ( rx_len > HAL_SPI_XFER_MAX ) )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	g_hal_stats.spi_xfer++;
+	g_hal_stats.spi_bytes += ( tx_len > rx_len ) ? tx_len : rx_len;
+	addr = p_tx[0] & (uint8_t)~IMU_READ_BIT;
+
+	if ( p_tx[0] & IMU_READ_BIT )
+	{
+		/* 1Byte目はAddress送信中 */
+		if ( ( p_rx != NULL ) && ( rx_len > 0 ) )
+		{
+			p_rx[0] = 0;
+			for ( i = 1; i < rx_len; i++ )
+			{
+				p_rx[i] = hal_imu_reg_read( (uint8_t)( addr + i - 1 ) );
+			}
+		}
+	}
+	else
+	{
+		for ( i = 1; i < tx_len; i++ )
+		{
+			hal_imu_reg_write( (uint8_t)( addr + i - 1 ), p_tx[i] );
+		}
+	}
+
+	if ( g_hal_config.verbose == true )
+	{
+		hal_print_head( "SPI" );
+		printf( "%s 0x%02x len %u\n", ( p_tx[0] & IMU_READ_BIT ) ? "R" : "W", addr, ( p_tx[0] & IMU_READ_BIT ) ? rx_len - 1 : tx_len - 1 );
+	}
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief TWI Initialize
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTwiInit( void )
+{
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief TWI Uninitialize
+ * @param None
+ * @retval None
+ */
+void HalTwiUninit( void )
+{
+}
+
+/**
+ * @brief TWI書き込み (完了まで待つ)
+ * @param addr Slave Address
+ * @param p_data 書き込むData
+ * @param len Byte数
+ * @param no_stop true:STOPを出さない (続けてHalTwiReadする場合)
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTwiWrite( uint8_t addr, const uint8_t *p_data, uint8_t len, bool no_stop )
+{
+	uint8_t reg;
+	uint8_t i;
+	bool time_set = false;
+
+	(void)no_stop;
+	if ( addr != RTC_SLAVE_ADDR )
+	{
+		/* Address NACK */
+		return HAL_ERROR_NOT_FOUND;
+	}
+	if ( ( p_data == NULL ) || ( len == 0 ) )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	g_hal_stats.twi_xfer++;
+	/* BL5372は上位4bitがRegister */
+	reg = p_data[0] >> 4;
+	g_hal_rtc.pointer = reg;
+	if ( len > 1 )
+	{
+		hal_rtc_update();
+		for ( i = 1; i < len; i++ )
+		{
+			g_hal_rtc.reg[( reg + i - 1 ) % RTC_REG_NUM] = p_data[i];
+			if ( ( reg + i - 1 ) < RTC_TIME_REG_NUM )
+			{
+				time_set = true;
+			}
+		}
+		if ( time_set == true )
+		{
+			hal_rtc_set();
+		}
+	}
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief TWI読み出し (完了まで待つ)
+ * @param addr Slave Address
+ * @param p_data 格納先
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTwiRead( uint8_t addr, uint8_t *p_data, uint8_t len )
+{
+	uint8_t i;
+
+	if ( addr != RTC_SLAVE_ADDR )
+	{
+		return HAL_ERROR_NOT_FOUND;
+	}
+	if ( p_data == NULL )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	g_hal_stats.twi_xfer++;
+	hal_rtc_update();
+	for ( i = 0; i < len; i++ )
+	{
+		p_data[i] = g_hal_rtc.reg[( g_hal_rtc.pointer + i ) % RTC_REG_NUM];
+	}
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief GPIO割込みの登録を探す
+ * @param pin Pin番号
+ * @retval 登録位置 (未登録の場合はg_hal_gpio_int_num)
+ */
+static uint8_t hal_gpio_int_find( uint32_t pin )
+{
+	uint8_t i;
+
+	for ( i = 0; i < g_hal_gpio_int_num; i++ )
+	{
+		if ( g_hal_gpio_int[i].pin == pin )
+		{
+			break;
+		}
+	}
+
+	return i;
+}
+
+/**
+ * @brief GPIO割込み設定 (入力, 設定後は無効. 設定済みのPinはHandlerごと設定し直す)
+ * @param pin Pin番号
+ * @param edge 検出Edge
+ * @param pull Pull設定 (Hostでは未使用)
+ * @param handler 割込みHandler
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalGpioIntInit( uint32_t pin, HAL_GPIO_EDGE edge, HAL_GPIO_PULL pull, HAL_GPIO_HANDLER handler )
+{
+	uint8_t idx;
+
+	(void)pull;
+	if ( handler == NULL )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+	idx = hal_gpio_int_find( pin );
+	if ( idx >= HAL_GPIO_INT_MAX )
+	{
+		return HAL_ERROR_NO_MEM;
+	}
+
+	g_hal_gpio_int[idx].pin = pin;
+	g_hal_gpio_int[idx].edge = edge;
+	g_hal_gpio_int[idx].handler = handler;
+	g_hal_gpio_int[idx].enable = false;
+	if ( idx == g_hal_gpio_int_num )
+	{
+		g_hal_gpio_int_num++;
+	}
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief GPIO割込み有効
+ * @param pin Pin番号
+ * @retval None
+ */
+void HalGpioIntEnable( uint32_t pin )
+{
+	uint8_t idx = hal_gpio_int_find( pin );
+
+	if ( idx < g_hal_gpio_int_num )
+	{
+		g_hal_gpio_int[idx].enable = true;
+	}
+}
+
+/**
+ * @brief GPIO割込み無効
+ * @param pin Pin番号
+ * @retval None
+ */
+void HalGpioIntDisable( uint32_t pin )
+{
+	uint8_t idx = hal_gpio_int_find( pin );
+
+	if ( idx < g_hal_gpio_int_num )
+	{
+		g_hal_gpio_int[idx].enable = false;
+	}
+}
+
+/**
+ * @brief System OFFからの起動要因に設定 (GPIO割込みは解除する. HostではSystem OFFしない)
+ * @param pin Pin番号
+ * @param pull Pull設定
+ * @param high true:High Levelで起動, false:Low Levelで起動
+ * @retval None
+ */
+void HalGpioWakeUpSet( uint32_t pin, HAL_GPIO_PULL pull, bool high )
+{
+	uint8_t idx = hal_gpio_int_find( pin );
+
+	(void)pull;
+	(void)high;
+	if ( idx < g_hal_gpio_int_num )
+	{
+		g_hal_gpio_int_num--;
+		memmove( &g_hal_gpio_int[idx], &g_hal_gpio_int[idx + 1], ( g_hal_gpio_int_num - idx ) * sizeof( HAL_GPIO_INT ) );
+	}
+}
+
+/**
+ * @brief System OFFからの起動要因か
+ * @remark HAL_POSIX_CONFIGのrtc_wakeupがtrueの場合はRTC割込みで起動したことにする (RTCの時刻を保持する)
+ * @param pin Pin番号
+ * @retval true このPinで起動した
+ * @retval false このPinではない
+ */
+bool HalGpioWakeUpCheck( uint32_t pin )
+{
+	return ( g_hal_config.rtc_wakeup == true ) && ( pin == RTC_INT_PIN );
+}
+
+/**
+ * @brief GPIO出力
+ * @param pin Pin番号
+ * @param high true:High, false:Low
+ * @retval None
+ */
+void HalGpioWrite( uint32_t pin, bool high )
+{
+	if ( g_hal_config.verbose == true )
+	{
+		hal_print_head( "GPIO" );
+		printf( "%u %u\n", pin, high ? 1 : 0 );
+	}
+}
+
+/**
+ * @brief 待ち (仮想時間を進める. Handlerは次のHalWaitEventで呼ぶ)
+ * @param us 時間 [us]
+ * @retval None
+ */
+void HalDelayUs( uint32_t us )
+{
+	g_hal_delay_us += us;
+	g_hal_now_ms += g_hal_delay_us / 1000;
+	g_hal_delay_us %= 1000;
+}
+
+/**
+ * @brief 待ち (仮想時間を進める. Handlerは次のHalWaitEventで呼ぶ)
+ * @param ms 時間 [ms]
+ * @retval None
+ */
+void HalDelayMs( uint32_t ms )
+{
+	g_hal_now_ms += ms;
+}
+
+/**
+ * @brief Flash Initialize
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashInit( void )
+{
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Flash読み出し
+ * @param addr 読み出すAddress
+ * @param p_data 格納先
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashRead( uint32_t addr, void *p_data, uint32_t len )
+{
+	if ( ( p_data == NULL ) || !hal_flash_range( addr, len ) )
+	{
+		return HAL_ERROR_INVALID_ADDR;
+	}
+
+	memcpy( p_data, &g_hal_flash[addr - HAL_FLASH_START_ADDR], len );
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Flash書き込み (完了まで待つ, 4Byte単位)
+ * @param addr 書き込むAddress
+ * @param p_data 書き込むData (完了まで保持する)
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashWrite( uint32_t addr, const void *p_data, uint32_t len )
+{
+	const uint8_t *p_src = (const uint8_t *)p_data;
+	uint8_t *p_dst;
+	uint32_t i;
+
+	if ( ( p_data == NULL ) || !hal_flash_range( addr, len ) )
+	{
+		return HAL_ERROR_INVALID_ADDR;
+	}
+	if ( ( ( addr % 4 ) != 0 ) || ( ( len % 4 ) != 0 ) )
+	{
+		return HAL_ERROR_INVALID_LENGTH;
+	}
+
+	/* Flashは1 -> 0にしか書けない */
+	p_dst = &g_hal_flash[addr - HAL_FLASH_START_ADDR];
+	for ( i = 0; i < len; i++ )
+	{
+		p_dst[i] &= p_src[i];
+	}
+	g_hal_stats.flash_write_bytes += len;
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Flash消去 (完了まで待つ)
+ * @param addr 消去するPageの先頭Address
+ * @param pages Page数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashErase( uint32_t addr, uint32_t pages )
+{
+	if ( ( ( addr % HAL_FLASH_PAGE_SIZE ) != 0 ) || !hal_flash_range( addr, pages * HAL_FLASH_PAGE_SIZE ) )
+	{
+		return HAL_ERROR_INVALID_ADDR;
+	}
+
+	memset( &g_hal_flash[addr - HAL_FLASH_START_ADDR], 0xFF, pages * HAL_FLASH_PAGE_SIZE );
+	g_hal_stats.flash_erase += pages;
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Timer作成
+ * @param p_id 作成したTimerのID格納先
+ * @param repeated true:周期, false:One Shot
+ * @param handler Timeout Handler
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_ERROR_NO_MEM HAL_TIMER_MAX個作成済み
+ */
+uint32_t HalTimerCreate( uint8_t *p_id, bool repeated, HAL_TIMER_HANDLER handler )
+{
+	if ( ( p_id == NULL ) || ( handler == NULL ) )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+	if ( g_hal_timer_num >= HAL_TIMER_MAX )
+	{
+		return HAL_ERROR_NO_MEM;
+	}
+
+	memset( &g_hal_timer[g_hal_timer_num], 0, sizeof( HAL_TIMER ) );
+	g_hal_timer[g_hal_timer_num].handler = handler;
+	g_hal_timer[g_hal_timer_num].repeated = repeated;
+	*p_id = g_hal_timer_num;
+	g_hal_timer_num++;
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Timer開始 (動作中ならやり直す)
+ * @param id Timer ID
+ * @param ms 周期 [ms]
+ * @param p_context Handlerに渡す値
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTimerStart( uint8_t id, uint32_t ms, void *p_context )
+{
+	if ( ( id >= g_hal_timer_num ) || ( ms == 0 ) )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	g_hal_timer[id].period_ms = ms;
+	g_hal_timer[id].due_ms = g_hal_now_ms + ms;
+	g_hal_timer[id].p_context = p_context;
+	g_hal_timer[id].running = true;
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Timer停止
+ * @param id Timer ID
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTimerStop( uint8_t id )
+{
+	if ( id >= g_hal_timer_num )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	g_hal_timer[id].running = false;
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief 起動からの時間
+ * @param None
+ * @retval 時間 [ms] (約49日で一周, nRFではRTC1が一周する512秒以内に1回以上呼ぶ)
+ */
+uint32_t HalTimeMs( void )
+{
+	return (uint32_t)g_hal_now_ms;
+}
+
+/**
+ * @brief Debug UART Initialize
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalDebugInit( void )
+{
+	g_hal_debug_init = true;
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Debug UART出力 (Blocking)
+ * @param p_data 送信Data
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_ERROR_INVALID_STATE 未初期化 (出力しない)
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalDebugWrite( const char *p_data, uint16_t len )
+{
+	if ( !g_hal_debug_init )
+	{
+		return HAL_ERROR_INVALID_STATE;
+	}
+	if ( p_data == NULL )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	(void)fwrite( p_data, 1, len, stderr );
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Notify送信
+ * @param conn_handle Connection Handle
+ * @param value_handle Characteristic Value Handle
+ * @param p_data 送信Data
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed (未接続/Notify無効/送信Buffer不足)
+ */
+uint32_t HalNotify( uint16_t conn_handle, uint16_t value_handle, const uint8_t *p_data, uint16_t len )
+{
+	if ( p_data == NULL )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	g_hal_stats.notify++;
+	hal_print_head( "NOTIFY" );
+	printf( "conn %u handle 0x%04x ", conn_handle, value_handle );
+	hal_print_hex( p_data, len );
+	printf( "\n" );
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Advertising Payloadの登録 (nRFではadvertising_init()でble_adv_schedに登録済みのため確認のみ)
+ * @param p_payload Manufacturer Specific Data (Company IDを除く)
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalAdvInit( const uint8_t *p_payload, uint16_t len )
+{
+	if ( ( p_payload == NULL ) || ( len == 0 ) )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	g_hal_adv_payload = p_payload;
+	g_hal_adv_len = len;
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Advertising Payloadの更新を反映
+ * @param alarm true:Alarm (短い間隔で送信する)
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalAdvUpdate( bool alarm )
+{
+	if ( g_hal_adv_payload == NULL )
+	{
+		return HAL_ERROR_INVALID_STATE;
+	}
+
+	g_hal_stats.adv_update++;
+	if ( alarm == true )
+	{
+		g_hal_stats.adv_alarm++;
+	}
+	hal_print_head( "ADV" );
+	printf( "%s ", ( alarm == true ) ? "alarm " : "change" );
+	hal_print_hex( g_hal_adv_payload, g_hal_adv_len );
+	printf( "\n" );
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief 次のEventまで待つ (nRF:Sleep, Host:仮想時間を進めてHandlerを呼ぶ)
+ * @param None
+ * @retval true 継続
+ * @retval false 終了 (HostでTraceの再生が終わった)
+ */
+bool HalWaitEvent( void )
+{
+	uint64_t next = hal_next_event_ms();
+	uint8_t i;
+
+	if ( next > g_hal_end_ms )
+	{
+		if ( g_hal_now_ms < g_hal_end_ms )
+		{
+			g_hal_now_ms = g_hal_end_ms;
+		}
+		return false;
+	}
+	/* HalDelayで既に過ぎたEventはすぐに処理する (時間は戻さない) */
+	if ( next > g_hal_now_ms )
+	{
+		g_hal_now_ms = next;
+	}
+	g_hal_stats.wake++;
+
+	/* IMUのSampleを先に更新してからTimer Handlerを呼ぶ */
+	if ( hal_imu_acc_on() && ( g_hal_imu.next_odr_ms <= g_hal_now_ms ) )
+	{
+		g_hal_imu.next_odr_ms = g_hal_now_ms + hal_imu_odr_ms();
+		hal_imu_odr_tick();
+	}
+
+	for ( i = 0; i < g_hal_timer_num; i++ )
+	{
+		if ( ( g_hal_timer[i].running == false ) || ( g_hal_timer[i].due_ms > g_hal_now_ms ) )
+		{
+			continue;
+		}
+		if ( g_hal_timer[i].repeated == true )
+		{
+			g_hal_timer[i].due_ms += g_hal_timer[i].period_ms;
+		}
+		else
+		{
+			g_hal_timer[i].running = false;
+		}
+		g_hal_stats.timer_fire++;
+		if ( g_hal_config.verbose == true )
+		{
+			hal_print_head( "TIMER" );
+			printf( "%u\n", i );
+		}
+		g_hal_timer[i].handler( g_hal_timer[i].p_context );
+	}
+
+	return true;
+}
@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************************
+  * @file    lib_trace_log_posix.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Trace Log (Host Build用. library/src/lib_trace_log.cの代わりにLinkする)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include "lib_common.h"
+#include "lib_trace_log.h"
+#include "lib_hal_posix.h"
+
+/*
+ * lib_trace_log.cはTrace LogをRetained RAM (TRACE_LOG_BASE_ADDR) に置くためHost上では動かない.
+ * Trace LogはHalPosixTraceLogで標準出力へ出し, Flush/Reset ReasonはFlashに書かない
+ */
+
+/* public functions ------------------------------------------------------*/
+/**
+ * @brief Trace Log Initialize
+ * @param None
+ * @retval None
+ */
+void TraceLogInit( void )
+{
+}
+
+/**
+ * @brief Trace Log Save
+ * @param func_no Function Number
+ * @param param Parameter
+ * @retval None
+ */
+void TraceLog( uint16_t func_no, uint16_t param )
+{
+	HalPosixTraceLog( func_no, param );
+}
+
+/**
+ * @brief Trace Log Flush
+ * @param None
+ * @retval NRF_SUCCESS Success
+ */
+ret_code_t TraceFlush( void )
+{
+	return NRF_SUCCESS;
+}
+
+/**
+ * @brief Set Reset Reason
+ * @param reason Reset Reason
+ * @retval NRF_SUCCESS Success
+ */
+ret_code_t SetResetReason( uint32_t reason )
+{
+	UNUSED_PARAMETER( reason );
+	return NRF_SUCCESS;
+}
@@ -0,0 +1,452 @@
+/**
+ * Notify queue (library/src/lib_notify_queue.c) against a model of the
+ * SoftDevice notification queue.
+ *
+ * sd_ble_gatts_hvx() is faked: it accepts up to NOTIFY_HVN_TX_QUEUE_SIZE
+ * notifications (hvn_tx_queue_size, what the queue is sized to) and answers
+ * NRF_ERROR_RESOURCES until the test completes some of them with
+ * NotifyQueueDrain(), as BLE_GATTS_EVT_HVN_TX_COMPLETE does on the device.
+ * Every payload carries a unique sequence number.
+ *
+ *     make -C host notify
+ *     ./host/_build/notify_queue_host -n 200000 -s 7
+ *
+ * The fixed cases cover the immediate send, enqueue behind a full SoftDevice
+ * queue, drain on TX complete, the full queue (NRF_ERROR_NO_MEM and no
+ * reset), coalescing of NotifyQueueSendLatest(), a hard hvx error while
+ * draining and the clear on disconnect. The random run then checks for every
+ * step that notifications reach the air in send order, and at the end that
+ * every accepted send was either sent or replaced by a newer latest value.
+ * The process exits with 1 on the first violated check.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lib_notify_queue.h"
+#include "lib_common.h"
+#include "definition.h"
+
+#define NQ_HOST_HANDLE_EVENT            0x0010                                  /**< Sent with NotifyQueueSend() (kept in order). */
+#define NQ_HOST_HANDLE_STATE            0x0020                                  /**< Sent with NotifyQueueSendLatest() (newest value only). */
+#define NQ_HOST_HANDLE_RAW              0x0030                                  /**< Full-size payloads with NotifyQueueSend(). */
+#define NQ_HOST_SD_SIZE                 NOTIFY_HVN_TX_QUEUE_SIZE
+#define NQ_HOST_LOG_SIZE                64
+#define NQ_HOST_STEPS_DEFAULT           100000
+
+typedef struct
+{
+    uint16_t handle;
+    uint16_t len;
+    uint32_t seq;
+} nq_host_sent_t;
+
+static uint16_t       m_conn_handle = BLE_CONN_HANDLE_INVALID;
+static uint32_t       m_sd_inflight;                                            /**< Notifications the fake SoftDevice holds. */
+static uint32_t       m_hvx_err = NRF_SUCCESS;                                  /**< Returned once by the next hvx that has room. */
+static nq_host_sent_t m_sent[NQ_HOST_LOG_SIZE];                                 /**< Last notifications handed to the SoftDevice. */
+static uint32_t       m_sent_count;
+static uint32_t       m_sent_last_seq;
+static bool           m_sent_out_of_order;
+static uint32_t       m_trace_notify_err;
+static uint32_t       m_seq;
+static uint32_t       m_rand = 1;
+
+static uint32_t test_rand(void)
+{
+    m_rand = m_rand * 1103515245u + 12345u;
+    return (m_rand >> 16) & 0x7FFF;
+}
+
+static void test_conn_handle_get(uint16_t * p_conn_handle)
+{
+    *p_conn_handle = m_conn_handle;
+}
+
+/**@brief Fake SoftDevice: a bounded queue that frees up on test_tx_complete().
+ */
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, const ble_gatts_hvx_params_t * p_hvx_params)
+{
+    nq_host_sent_t * p_sent;
+    uint32_t         seq;
+    uint32_t         err;
+
+    if (conn_handle == BLE_CONN_HANDLE_INVALID)
+    {
+        return BLE_ERROR_INVALID_CONN_HANDLE;
+    }
+    if (m_sd_inflight >= NQ_HOST_SD_SIZE)
+    {
+        return NRF_ERROR_RESOURCES;
+    }
+    if (m_hvx_err != NRF_SUCCESS)
+    {
+        err = m_hvx_err;
+        m_hvx_err = NRF_SUCCESS;
+        return err;
+    }
+
+    memcpy(&seq, p_hvx_params->p_data, sizeof(seq));
+    if ((m_sent_count != 0) && (seq <= m_sent_last_seq))
+    {
+        m_sent_out_of_order = true;
+    }
+    m_sent_last_seq = seq;
+
+    p_sent = &m_sent[m_sent_count % NQ_HOST_LOG_SIZE];
+    p_sent->handle = p_hvx_params->handle;
+    p_sent->len    = *p_hvx_params->p_len;
+    p_sent->seq    = seq;
+    m_sent_count++;
+    m_sd_inflight++;
+    return NRF_SUCCESS;
+}
+
+void TraceLog(uint16_t func_no, uint16_t param)
+{
+    if (func_no == TR_NOTIFY_ERROR)
+    {
+        m_trace_notify_err++;
+    }
+}
+
+/**@brief BLE_GATTS_EVT_HVN_TX_COMPLETE for up to count notifications.
+ */
+static void test_tx_complete(uint32_t count)
+{
+    if (count > m_sd_inflight)
+    {
+        count = m_sd_inflight;
+    }
+    m_sd_inflight -= count;
+    NotifyQueueDrain((uint8_t)count);
+}
+
+static uint32_t test_send(uint16_t handle, bool latest, uint16_t len, uint32_t * p_seq)
+{
+    uint8_t data[NOTIFY_QUEUE_DATA_MAX];
+
+    memset(data, (int)handle, sizeof(data));
+    *p_seq = ++m_seq;
+    memcpy(data, p_seq, sizeof(*p_seq));
+    return latest ? NotifyQueueSendLatest(handle, data, len) : NotifyQueueSend(handle, data, len);
+}
+
+static const nq_host_sent_t * test_sent(uint32_t n)
+{
+    return &m_sent[n % NQ_HOST_LOG_SIZE];
+}
+
+static void test_reset(void)
+{
+    m_conn_handle = 1;
+    m_sd_inflight = 0;
+    m_hvx_err = NRF_SUCCESS;
+    m_sent_count = 0;
+    m_sent_last_seq = 0;
+    m_sent_out_of_order = false;
+    m_trace_notify_err = 0;
+    NotifyQueueInit(test_conn_handle_get);
+}
+
+static uint8_t test_depth(void)
+{
+    NOTIFY_QUEUE_STATS stats;
+
+    NotifyQueueGetStats(&stats);
+    return stats.depth;
+}
+
+static void test_tx_complete_all(void)
+{
+    while ((test_depth() != 0) || (m_sd_inflight != 0))
+    {
+        test_tx_complete(NQ_HOST_SD_SIZE);
+    }
+}
+
+#define CHECK(cond, ...)                                                                    \
+    do                                                                                      \
+    {                                                                                       \
+        if (!(cond))                                                                        \
+        {                                                                                   \
+            fprintf(stderr, "FAIL %s: ", __func__);                                         \
+            fprintf(stderr, __VA_ARGS__);                                                   \
+            fputc('\n', stderr);                                                            \
+            return false;                                                                   \
+        }                                                                                   \
+    } while (0)
+
+static bool case_arguments(void)
+{
+    uint8_t  data[NOTIFY_QUEUE_DATA_MAX + 1] = {0};
+    uint32_t seq;
+
+    test_reset();
+    CHECK(NotifyQueueSend(NQ_HOST_HANDLE_EVENT, data, 0) == NRF_ERROR_DATA_SIZE, "empty payload");
+    CHECK(NotifyQueueSend(NQ_HOST_HANDLE_EVENT, data, sizeof(data)) == NRF_ERROR_DATA_SIZE, "payload above MTU - 3");
+    CHECK(NotifyQueueSend(NQ_HOST_HANDLE_EVENT, NULL, 1) == NRF_ERROR_DATA_SIZE, "NULL payload");
+    m_conn_handle = BLE_CONN_HANDLE_INVALID;
+    CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &seq) == NRF_ERROR_INVALID_STATE, "not connected");
+    CHECK(m_sent_count == 0, "sent while not connected");
+    return true;
+}
+
+static bool case_immediate(void)
+{
+    uint32_t seq;
+
+    test_reset();
+    CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &seq) == NRF_SUCCESS, "send");
+    CHECK((m_sent_count == 1) && (test_sent(0)->seq == seq), "not sent right away");
+    CHECK(test_depth() == 0, "queued although the SoftDevice had room");
+    return true;
+}
+
+static bool case_enqueue_drain(void)
+{
+    uint32_t first;
+    uint32_t seq;
+    uint32_t i;
+
+    test_reset();
+    for (i = 0; i < NQ_HOST_SD_SIZE; i++)
+    {
+        CHECK(test_send(NQ_HOST_HANDLE_RAW, false, NOTIFY_QUEUE_DATA_MAX, &seq) == NRF_SUCCESS, "fill SoftDevice");
+    }
+    CHECK(test_send(NQ_HOST_HANDLE_RAW, false, NOTIFY_QUEUE_DATA_MAX, &first) == NRF_SUCCESS, "enqueue");
+    CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &seq) == NRF_SUCCESS, "enqueue");
+    CHECK((test_depth() == 2) && (m_sent_count == NQ_HOST_SD_SIZE), "depth %u sent %u", test_depth(), m_sent_count);
+
+    // One TX complete frees one SoftDevice slot: exactly the oldest queued one goes out.
+    test_tx_complete(1);
+    CHECK((m_sent_count == NQ_HOST_SD_SIZE + 1) && (test_sent(NQ_HOST_SD_SIZE)->seq == first), "drain order");
+    CHECK(test_sent(NQ_HOST_SD_SIZE)->len == NOTIFY_QUEUE_DATA_MAX, "payload length not kept");
+    test_tx_complete_all();
+    CHECK((test_depth() == 0) && (test_sent(NQ_HOST_SD_SIZE + 1)->seq == seq), "drain");
+    CHECK(!m_sent_out_of_order, "sent out of order");
+    return true;
+}
+
+static bool case_full(void)
+{
+    NOTIFY_QUEUE_STATS stats;
+    uint32_t           seq;
+    uint32_t           i;
+
+    test_reset();
+    for (i = 0; i < NQ_HOST_SD_SIZE + NOTIFY_QUEUE_SIZE; i++)
+    {
+        CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &seq) == NRF_SUCCESS, "send %u", i);
+    }
+    CHECK(NotifyQueueIsFull(), "not full");
+    CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &seq) == NRF_ERROR_NO_MEM, "full queue accepted");
+    // A latest value does not take the place of a queued event either.
+    CHECK(test_send(NQ_HOST_HANDLE_STATE, true, 4, &seq) == NRF_ERROR_NO_MEM, "full queue accepted latest");
+    NotifyQueueGetStats(&stats);
+    CHECK((stats.drop_full_count == 2) && (stats.depth_max == NOTIFY_QUEUE_SIZE), "stats");
+
+    // The producer backs off; the link drains everything it accepted.
+    test_tx_complete_all();
+    CHECK((test_depth() == 0) && (m_sent_count == NQ_HOST_SD_SIZE + NOTIFY_QUEUE_SIZE), "drain after full");
+    CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &seq) == NRF_SUCCESS, "send after full");
+    CHECK(!m_sent_out_of_order, "sent out of order");
+    return true;
+}
+
+static bool case_coalesce(void)
+{
+    NOTIFY_QUEUE_STATS stats;
+    uint32_t           event_a, event_b;
+    uint32_t           state_1, state_2, state_3;
+    uint32_t           seq;
+    uint32_t           i;
+
+    test_reset();
+    for (i = 0; i < NQ_HOST_SD_SIZE; i++)
+    {
+        CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &seq) == NRF_SUCCESS, "fill SoftDevice");
+    }
+    CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &event_a) == NRF_SUCCESS, "event a");
+    CHECK(test_send(NQ_HOST_HANDLE_STATE, true, 4, &state_1) == NRF_SUCCESS, "state 1");
+    CHECK(test_send(NQ_HOST_HANDLE_STATE, true, 4, &state_2) == NRF_SUCCESS, "state 2");
+    // state 2 replaced state 1 in place; event a is never replaced.
+    CHECK(test_depth() == 2, "depth %u after coalesce", test_depth());
+    CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &event_b) == NRF_SUCCESS, "event b");
+    CHECK(test_send(NQ_HOST_HANDLE_STATE, true, 4, &state_3) == NRF_SUCCESS, "state 3");
+    // state 3 is behind event b, so it does not jump ahead by replacing state 2.
+    CHECK(test_depth() == 4, "depth %u, latest coalesced across an event", test_depth());
+    NotifyQueueGetStats(&stats);
+    CHECK(stats.coalesce_count == 1, "coalesce count %u", stats.coalesce_count);
+
+    test_tx_complete_all();
+    CHECK(m_sent_count == NQ_HOST_SD_SIZE + 4, "sent %u", m_sent_count);
+    CHECK((test_sent(NQ_HOST_SD_SIZE)->seq == event_a) &&
+          (test_sent(NQ_HOST_SD_SIZE + 1)->seq == state_2) &&
+          (test_sent(NQ_HOST_SD_SIZE + 2)->seq == event_b) &&
+          (test_sent(NQ_HOST_SD_SIZE + 3)->seq == state_3), "coalesced order");
+    (void)state_1;
+
+    // The badge status characteristic: events and heartbeats share one handle.
+    test_reset();
+    for (i = 0; i < NQ_HOST_SD_SIZE; i++)
+    {
+        CHECK(test_send(NQ_HOST_HANDLE_STATE, false, 4, &seq) == NRF_SUCCESS, "fill SoftDevice");
+    }
+    CHECK(test_send(NQ_HOST_HANDLE_STATE, false, 4, &event_a) == NRF_SUCCESS, "event on the state handle");
+    CHECK(test_send(NQ_HOST_HANDLE_STATE, true, 4, &state_1) == NRF_SUCCESS, "state after the event");
+    CHECK(test_depth() == 2, "latest value replaced an event of the same handle");
+    test_tx_complete_all();
+    CHECK((test_sent(NQ_HOST_SD_SIZE)->seq == event_a) && (test_sent(NQ_HOST_SD_SIZE + 1)->seq == state_1), "same handle order");
+    return true;
+}
+
+static bool case_hvx_error(void)
+{
+    NOTIFY_QUEUE_STATS stats;
+    uint32_t           lost, kept;
+    uint32_t           seq;
+    uint32_t           i;
+
+    test_reset();
+    for (i = 0; i < NQ_HOST_SD_SIZE; i++)
+    {
+        CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &seq) == NRF_SUCCESS, "fill SoftDevice");
+    }
+    CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &lost) == NRF_SUCCESS, "enqueue");
+    CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &kept) == NRF_SUCCESS, "enqueue");
+
+    // CCCD disabled in the meantime: the head is dropped and traced, the rest still goes out.
+    m_hvx_err = BLE_ERROR_GATTS_SYS_ATTR_MISSING;
+    test_tx_complete(1);
+    NotifyQueueGetStats(&stats);
+    CHECK((stats.drop_err_count == 1) && (m_trace_notify_err == 1), "hvx error not counted");
+    CHECK((m_sent_count == NQ_HOST_SD_SIZE + 1) && (test_sent(NQ_HOST_SD_SIZE)->seq == kept), "queue stalled on error");
+    CHECK(test_depth() == 0, "depth %u", test_depth());
+    (void)lost;
+    return true;
+}
+
+static bool case_clear(void)
+{
+    uint32_t seq;
+    uint32_t i;
+
+    test_reset();
+    for (i = 0; i < NQ_HOST_SD_SIZE + 2; i++)
+    {
+        CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &seq) == NRF_SUCCESS, "send");
+    }
+    // Disconnect: the SoftDevice drops its queue, the notify queue is cleared.
+    m_conn_handle = BLE_CONN_HANDLE_INVALID;
+    m_sd_inflight = 0;
+    NotifyQueueClear();
+    CHECK((test_depth() == 0) && !NotifyQueueIsFull(), "not cleared");
+
+    m_conn_handle = 2;
+    i = m_sent_count;
+    CHECK(test_send(NQ_HOST_HANDLE_EVENT, false, 4, &seq) == NRF_SUCCESS, "send after reconnect");
+    CHECK((m_sent_count == i + 1) && (test_sent(i)->seq == seq), "stale notification sent after reconnect");
+    return true;
+}
+
+/**@brief Random producers (raw, events, latest state) and random TX completes.
+ */
+static bool case_random(uint32_t steps)
+{
+    NOTIFY_QUEUE_STATS stats;
+    uint32_t           accepted = 0;
+    uint32_t           no_mem = 0;
+    uint32_t           seq;
+    uint32_t           step;
+    uint32_t           err;
+
+    test_reset();
+    for (step = 0; step < steps; step++)
+    {
+        uint32_t r = test_rand();
+
+        if ((r % 8) < 5)
+        {
+            uint16_t handle = ((r >> 3) % 3 == 0) ? NQ_HOST_HANDLE_STATE :
+                              ((r >> 3) % 3 == 1) ? NQ_HOST_HANDLE_EVENT : NQ_HOST_HANDLE_RAW;
+            uint16_t len = (uint16_t)(sizeof(uint32_t) + (test_rand() % (NOTIFY_QUEUE_DATA_MAX - sizeof(uint32_t) + 1)));
+
+            err = test_send(handle, handle == NQ_HOST_HANDLE_STATE, len, &seq);
+            if (err == NRF_SUCCESS)
+            {
+                accepted++;
+            }
+            else
+            {
+                CHECK(err == NRF_ERROR_NO_MEM, "step %u: send returned 0x%x", step, err);
+                CHECK(NotifyQueueIsFull(), "step %u: NO_MEM with room in the queue", step);
+                no_mem++;
+            }
+        }
+        else
+        {
+            test_tx_complete(1 + (test_rand() % NQ_HOST_SD_SIZE));
+        }
+        CHECK(!m_sent_out_of_order, "step %u: sent out of order", step);
+    }
+    test_tx_complete_all();
+
+    NotifyQueueGetStats(&stats);
+    CHECK(stats.drop_full_count == no_mem, "drop count %u, NO_MEM returned %u", stats.drop_full_count, no_mem);
+    CHECK(m_sent_count + stats.coalesce_count == accepted,
+          "accepted %u, sent %u + coalesced %u", accepted, m_sent_count, stats.coalesce_count);
+    printf("notify queue steps=%u accepted=%u sent=%u coalesced=%u full=%u depth_max=%u\n",
+           steps, accepted, m_sent_count, stats.coalesce_count, no_mem, stats.depth_max);
+    DebugNotifyQueueStatsLog();
+    return true;
+}
+
+static void usage(const char * p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-n steps] [-s seed]\n"
+            "  -n  steps of the random run (default %u)\n"
+            "  -s  random seed (default 1)\n",
+            p_name, NQ_HOST_STEPS_DEFAULT);
+}
+
+int main(int argc, char * argv[])
+{
+    uint32_t steps = NQ_HOST_STEPS_DEFAULT;
+    bool     ok = true;
+    int      opt;
+
+    while ((opt = getopt(argc, argv, "n:s:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                steps = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                m_rand = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+
+    ok = case_arguments() && ok;
+    ok = case_immediate() && ok;
+    ok = case_enqueue_drain() && ok;
+    ok = case_full() && ok;
+    ok = case_coalesce() && ok;
+    ok = case_hvx_error() && ok;
+    ok = case_clear() && ok;
+    ok = case_random(steps) && ok;
+
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,619 @@
+/**
+  ******************************************************************************************
+  * @file    sdk_host.c
+  * @author  k.tashiro
+  * @version 1.2
+  * @date    2026/10/19
+  * @brief   nRF5 SDK / SoftDevice (Host Build用. lib_hal_posix.cの上で動かす)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         app_error_handlerからapp_error_fault_handlerを呼ぶ (main.cのFault処理を通す)
+  * 1.2            2026/10/19       k.tashiro         Data Length, MTU, Connection Parameter変更, Radio Notificationを追加 (lib_ble_profile)
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdk_host.h"
+#include "lib_hal.h"
+
+/* Definition ------------------------------------------------------------*/
+#define SDK_HOST_DEVICE_ID			(0x5EED0B51U)	/* FICR DEVICEID[0] */
+#define SDK_HOST_RTT_CONSOLE		(0)				/* 標準Errorに出すRTT Channel */
+#define SDK_HOST_ADV_HEADER_SIZE	(2)				/* AD Structure: Length + Type */
+#define SDK_HOST_COMPANY_ID_SIZE	(2)
+
+/* public variables ------------------------------------------------------*/
+NRF_FICR_Type g_sdk_host_ficr = { .DEVICEID = { SDK_HOST_DEVICE_ID, 0 } };
+DWT_Type g_sdk_host_dwt;
+CoreDebug_Type g_sdk_host_core_debug;
+nrf_fstorage_api_t nrf_fstorage_sd;
+
+/* private variables -----------------------------------------------------*/
+static char g_sdk_host_name[BLE_GAP_DEVNAME_MAX_LEN + 1] = "";
+
+/* private functions -----------------------------------------------------*/
+/**
+ * @brief AD Structureを1つ追加
+ * @param p_buf 出力先
+ * @param p_offset 書き込み位置 (更新する)
+ * @param max 出力先のSize
+ * @param type AD Type
+ * @param p_data Data
+ * @param len Data Size
+ * @retval NRF_SUCCESS Success
+ * @retval NRF_ERROR_DATA_SIZE 出力先に入らない
+ */
+static ret_code_t advdata_field_add( uint8_t *p_buf, uint16_t *p_offset, uint16_t max, uint8_t type, const uint8_t *p_data, uint16_t len )
+{
+	if ( ( *p_offset + SDK_HOST_ADV_HEADER_SIZE + len ) > max )
+	{
+		return NRF_ERROR_DATA_SIZE;
+	}
+
+	p_buf[*p_offset] = (uint8_t)( len + 1 );
+	p_buf[*p_offset + 1] = type;
+	memcpy( &p_buf[*p_offset + SDK_HOST_ADV_HEADER_SIZE], p_data, len );
+	*p_offset += (uint16_t)( SDK_HOST_ADV_HEADER_SIZE + len );
+
+	return NRF_SUCCESS;
+}
+
+/* public functions ------------------------------------------------------*/
+/**
+ * @brief Error Handler (APP_ERROR_CHECK). 場所を出力してapp_error_fault_handlerを呼ぶ
+ * @param error_code Error Code
+ * @param line_num 行番号
+ * @param p_file_name File名
+ * @retval None
+ */
+void app_error_handler( uint32_t error_code, uint32_t line_num, const uint8_t *p_file_name )
+{
+	fprintf( stderr, "app_error 0x%08x at %s:%u\n", error_code, (const char *)p_file_name, line_num );
+	app_error_fault_handler( NRF_FAULT_ID_SDK_ERROR, 0, error_code );
+	exit( 1 );
+}
+
+/**
+ * @brief System Reset. Host上では終了する
+ * @param None
+ * @retval None
+ */
+void NVIC_SystemReset( void )
+{
+	fprintf( stderr, "NVIC_SystemReset\n" );
+	exit( 1 );
+}
+
+/* SEGGER_RTT */
+void SEGGER_RTT_Init( void )
+{
+}
+
+int SEGGER_RTT_printf( unsigned buffer_index, const char *p_format, ... )
+{
+	va_list args;
+	int len;
+
+	if ( buffer_index != SDK_HOST_RTT_CONSOLE )
+	{
+		return 0;
+	}
+	va_start( args, p_format );
+	len = vfprintf( stderr, p_format, args );
+	va_end( args );
+
+	return len;
+}
+
+unsigned SEGGER_RTT_Write( unsigned buffer_index, const void *p_buffer, unsigned num_bytes )
+{
+	if ( buffer_index != SDK_HOST_RTT_CONSOLE )
+	{
+		return num_bytes;
+	}
+
+	return (unsigned)fwrite( p_buffer, 1, num_bytes, stderr );
+}
+
+int SEGGER_RTT_ConfigUpBuffer( unsigned buffer_index, const char *p_name, void *p_buffer, unsigned buffer_size, unsigned flags )
+{
+	return 0;
+}
+
+/* app_timer (HalTimer, 1tick = 1/32768s) */
+ret_code_t app_timer_init( void )
+{
+	return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_create( const app_timer_id_t *p_timer_id, app_timer_mode_t mode, app_timer_timeout_handler_t timeout_handler )
+{
+	uint32_t err_code;
+
+	if ( ( p_timer_id == NULL ) || ( *p_timer_id == NULL ) || ( timeout_handler == NULL ) )
+	{
+		return NRF_ERROR_INVALID_PARAM;
+	}
+	if ( (*p_timer_id)->created == true )
+	{
+		return NRF_SUCCESS;
+	}
+
+	err_code = HalTimerCreate( &(*p_timer_id)->id, ( mode == APP_TIMER_MODE_REPEATED ), timeout_handler );
+	if ( err_code == HAL_SUCCESS )
+	{
+		(*p_timer_id)->created = true;
+	}
+
+	return err_code;
+}
+
+ret_code_t app_timer_start( app_timer_id_t timer_id, uint32_t timeout_ticks, void *p_context )
+{
+	uint32_t ms;
+
+	if ( ( timer_id == NULL ) || ( timeout_ticks < APP_TIMER_MIN_TIMEOUT_TICKS ) )
+	{
+		return NRF_ERROR_INVALID_PARAM;
+	}
+	if ( timer_id->created == false )
+	{
+		return NRF_ERROR_INVALID_STATE;
+	}
+
+	ms = (uint32_t)ROUNDED_DIV( (uint64_t)timeout_ticks * 1000, APP_TIMER_CLOCK_FREQ );
+
+	return HalTimerStart( timer_id->id, ( ms > 0 ) ? ms : 1, p_context );
+}
+
+ret_code_t app_timer_stop( app_timer_id_t timer_id )
+{
+	if ( ( timer_id == NULL ) || ( timer_id->created == false ) )
+	{
+		return NRF_ERROR_INVALID_STATE;
+	}
+
+	return HalTimerStop( timer_id->id );
+}
+
+uint32_t app_timer_cnt_get( void )
+{
+	return (uint32_t)( ( (uint64_t)HalTimeMs() * APP_TIMER_CLOCK_FREQ ) / 1000 ) & APP_TIMER_MAX_CNT_VAL;
+}
+
+uint32_t app_timer_cnt_diff_compute( uint32_t ticks_to, uint32_t ticks_from )
+{
+	return ( ticks_to - ticks_from ) & APP_TIMER_MAX_CNT_VAL;
+}
+
+/* nrf_delay */
+void nrf_delay_us( uint32_t us )
+{
+	HalDelayUs( us );
+}
+
+void nrf_delay_ms( uint32_t ms )
+{
+	HalDelayMs( ms );
+}
+
+/* nrf_pwr_mgmt / sd_app_evt_wait (Traceが終わったらSdkHostEndで終了する) */
+ret_code_t nrf_pwr_mgmt_init( void )
+{
+	return NRF_SUCCESS;
+}
+
+void nrf_pwr_mgmt_run( void )
+{
+	if ( HalWaitEvent() == false )
+	{
+		SdkHostEnd();
+	}
+}
+
+uint32_t sd_app_evt_wait( void )
+{
+	nrf_pwr_mgmt_run();
+	return NRF_SUCCESS;
+}
+
+uint32_t sd_nvic_SystemReset( void )
+{
+	fprintf( stderr, "sd_nvic_SystemReset\n" );
+	exit( 1 );
+}
+
+/* nrf_nvic */
+uint32_t sd_nvic_critical_region_enter( uint8_t *p_is_nested_critical_region )
+{
+	HalCriticalEnter( p_is_nested_critical_region );
+	return NRF_SUCCESS;
+}
+
+uint32_t sd_nvic_critical_region_exit( uint8_t is_nested_critical_region )
+{
+	HalCriticalExit( is_nested_critical_region );
+	return NRF_SUCCESS;
+}
+
+/* nrf_sdh */
+bool nrf_sdh_is_enabled( void )
+{
+	return false;
+}
+
+ret_code_t nrf_sdh_enable_request( void )
+{
+	return NRF_SUCCESS;
+}
+
+ret_code_t nrf_sdh_disable_request( void )
+{
+	return NRF_SUCCESS;
+}
+
+ret_code_t nrf_sdh_ble_default_cfg_set( uint8_t conn_cfg_tag, uint32_t *p_ram_start )
+{
+	return NRF_SUCCESS;
+}
+
+ret_code_t nrf_sdh_ble_enable( uint32_t *p_app_ram_start )
+{
+	return NRF_SUCCESS;
+}
+
+/* SoftDevice GAP */
+uint32_t sd_ble_gap_device_name_set( const ble_gap_conn_sec_mode_t *p_write_perm, const uint8_t *p_dev_name, uint16_t len )
+{
+	if ( ( p_dev_name == NULL ) || ( len > BLE_GAP_DEVNAME_MAX_LEN ) )
+	{
+		return NRF_ERROR_INVALID_PARAM;
+	}
+	memcpy( g_sdk_host_name, p_dev_name, len );
+	g_sdk_host_name[len] = '\0';
+
+	return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_ppcp_set( const ble_gap_conn_params_t *p_conn_params )
+{
+	return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_disconnect( uint16_t conn_handle, uint8_t hci_status_code )
+{
+	return NRF_ERROR_INVALID_STATE;
+}
+
+uint32_t sd_ble_gap_phy_update( uint16_t conn_handle, const ble_gap_phys_t *p_gap_phys )
+{
+	return NRF_ERROR_INVALID_STATE;
+}
+
+uint32_t sd_ble_gap_data_length_update( uint16_t conn_handle, const ble_gap_data_length_params_t *p_dl_params, ble_gap_data_length_limitation_t *p_dl_limitation )
+{
+	return NRF_ERROR_INVALID_STATE;
+}
+
+uint32_t sd_ble_gap_conn_param_update( uint16_t conn_handle, const ble_gap_conn_params_t *p_conn_params )
+{
+	return NRF_ERROR_INVALID_STATE;
+}
+
+/* Advertisingの内容はHalAdvInit/HalAdvUpdateで出力する (host/src/badge_host.c) */
+uint32_t sd_ble_gap_adv_set_configure( uint8_t *p_adv_handle, const ble_gap_adv_data_t *p_adv_data, const ble_gap_adv_params_t *p_adv_params )
+{
+	if ( p_adv_handle == NULL )
+	{
+		return NRF_ERROR_NULL;
+	}
+	if ( ( p_adv_data != NULL ) && ( p_adv_data->adv_data.len > BLE_GAP_ADV_SET_DATA_SIZE_MAX ) )
+	{
+		return NRF_ERROR_INVALID_LENGTH;
+	}
+	if ( *p_adv_handle == BLE_GAP_ADV_SET_HANDLE_NOT_SET )
+	{
+		*p_adv_handle = 0;
+	}
+
+	return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_adv_start( uint8_t adv_handle, uint8_t conn_cfg_tag )
+{
+	return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_adv_stop( uint8_t adv_handle )
+{
+	return NRF_SUCCESS;
+}
+
+/* SoftDevice GATTS (未接続のためNotifyはINVALID_STATE) */
+uint32_t sd_ble_uuid_vs_add( const ble_uuid128_t *p_vs_uuid, uint8_t *p_uuid_type )
+{
+	*p_uuid_type = BLE_UUID_TYPE_VENDOR_BEGIN;
+	return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_service_add( uint8_t type, const ble_uuid_t *p_uuid, uint16_t *p_handle )
+{
+	static uint16_t handle = 0;
+
+	*p_handle = ++handle;
+	return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_characteristic_add( uint16_t service_handle, const ble_gatts_char_md_t *p_char_md, const ble_gatts_attr_t *p_attr_char_value, ble_gatts_char_handles_t *p_handles )
+{
+	memset( p_handles, 0, sizeof( *p_handles ) );
+	return NRF_SUCCESS;
+}
+
+uint32_t characteristic_add( uint16_t service_handle, ble_add_char_params_t *p_char_props, ble_gatts_char_handles_t *p_char_handle )
+{
+	return sd_ble_gatts_characteristic_add( service_handle, NULL, NULL, p_char_handle );
+}
+
+uint32_t sd_ble_gatts_hvx( uint16_t conn_handle, const ble_gatts_hvx_params_t *p_hvx_params )
+{
+	return NRF_ERROR_INVALID_STATE;
+}
+
+uint32_t sd_ble_gatts_value_set( uint16_t conn_handle, uint16_t handle, ble_gatts_value_t *p_value )
+{
+	return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_rw_authorize_reply( uint16_t conn_handle, const ble_gatts_rw_authorize_reply_params_t *p_rw_authorize_reply_params )
+{
+	return NRF_ERROR_INVALID_STATE;
+}
+
+uint32_t sd_power_system_off( void )
+{
+	fprintf( stderr, "sd_power_system_off\n" );
+	SdkHostEnd();
+	return NRF_SUCCESS;
+}
+
+/* ble_advdata (Flags, Name, Appearance, Manufacturer Specific Dataだけ) */
+ret_code_t ble_advdata_encode( const ble_advdata_t *p_advdata, uint8_t *p_encoded_data, uint16_t *p_len )
+{
+	static const uint8_t appearance[2] = { 0, 0 };
+	uint8_t manuf[BLE_GAP_ADV_SET_DATA_SIZE_MAX];
+	uint16_t max;
+	uint16_t offset = 0;
+	uint16_t size;
+	ret_code_t err_code = NRF_SUCCESS;
+
+	if ( ( p_advdata == NULL ) || ( p_encoded_data == NULL ) || ( p_len == NULL ) )
+	{
+		return NRF_ERROR_NULL;
+	}
+	max = MIN( *p_len, BLE_GAP_ADV_SET_DATA_SIZE_MAX );
+
+	if ( p_advdata->flags != 0 )
+	{
+		err_code = advdata_field_add( p_encoded_data, &offset, max, BLE_GAP_AD_TYPE_FLAGS, &p_advdata->flags, 1 );
+		VERIFY_SUCCESS( err_code );
+	}
+	if ( p_advdata->name_type != BLE_ADVDATA_NO_NAME )
+	{
+		err_code = advdata_field_add( p_encoded_data, &offset, max, BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME,
+									  (const uint8_t *)g_sdk_host_name, (uint16_t)strlen( g_sdk_host_name ) );
+		VERIFY_SUCCESS( err_code );
+	}
+	if ( p_advdata->include_appearance == true )
+	{
+		err_code = advdata_field_add( p_encoded_data, &offset, max, BLE_GAP_AD_TYPE_APPEARANCE, appearance, sizeof( appearance ) );
+		VERIFY_SUCCESS( err_code );
+	}
+	if ( p_advdata->p_manuf_specific_data != NULL )
+	{
+		size = p_advdata->p_manuf_specific_data->data.size;
+		if ( (size_t)( size + SDK_HOST_COMPANY_ID_SIZE ) > sizeof( manuf ) )
+		{
+			return NRF_ERROR_DATA_SIZE;
+		}
+		manuf[0] = LSB_16( p_advdata->p_manuf_specific_data->company_identifier );
+		manuf[1] = MSB_16( p_advdata->p_manuf_specific_data->company_identifier );
+		memcpy( &manuf[SDK_HOST_COMPANY_ID_SIZE], p_advdata->p_manuf_specific_data->data.p_data, size );
+		err_code = advdata_field_add( p_encoded_data, &offset, max, BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
+									  manuf, (uint16_t)( size + SDK_HOST_COMPANY_ID_SIZE ) );
+		VERIFY_SUCCESS( err_code );
+	}
+
+	*p_len = offset;
+
+	return NRF_SUCCESS;
+}
+
+/* nrf_ble_gatt / nrf_ble_qwr / ble_bas / ble_conn_params */
+ret_code_t nrf_ble_gatt_init( nrf_ble_gatt_t *p_gatt, nrf_ble_gatt_evt_handler_t evt_handler )
+{
+	p_gatt->att_mtu_desired_periph = BLE_GATT_ATT_MTU_DEFAULT;
+	return NRF_SUCCESS;
+}
+
+ret_code_t nrf_ble_gatt_att_mtu_periph_set( nrf_ble_gatt_t *p_gatt, uint16_t desired_mtu )
+{
+	p_gatt->att_mtu_desired_periph = desired_mtu;
+	return NRF_SUCCESS;
+}
+
+ret_code_t nrf_ble_qwr_init( nrf_ble_qwr_t *p_qwr, const nrf_ble_qwr_init_t *p_qwr_init )
+{
+	p_qwr->conn_handle = BLE_CONN_HANDLE_INVALID;
+	return NRF_SUCCESS;
+}
+
+ret_code_t nrf_ble_qwr_conn_handle_assign( nrf_ble_qwr_t *p_qwr, uint16_t conn_handle )
+{
+	p_qwr->conn_handle = conn_handle;
+	return NRF_SUCCESS;
+}
+
+ret_code_t ble_bas_init( ble_bas_t *p_bas, const ble_bas_init_t *p_bas_init )
+{
+	p_bas->battery_level_last = p_bas_init->initial_batt_level;
+	return NRF_SUCCESS;
+}
+
+ret_code_t ble_bas_battery_level_update( ble_bas_t *p_bas, uint8_t battery_level, uint16_t conn_handle )
+{
+	p_bas->battery_level_last = battery_level;
+	return NRF_SUCCESS;
+}
+
+ret_code_t ble_conn_params_init( const ble_conn_params_init_t *p_init )
+{
+	return NRF_SUCCESS;
+}
+
+ret_code_t ble_conn_params_change_conn_params( uint16_t conn_handle, ble_gap_conn_params_t *p_new_params )
+{
+	return sd_ble_gap_conn_param_update( conn_handle, p_new_params );
+}
+
+/* Radio Notification (Host上ではRadio Eventが発生しない) */
+uint32_t ble_radio_notification_init( uint32_t irq_priority, uint8_t distance, ble_radio_notification_evt_handler_t evt_handler )
+{
+	return NRF_SUCCESS;
+}
+
+/* bsp (Button/LEDなし) */
+uint32_t bsp_init( uint32_t type, bsp_event_callback_t callback )
+{
+	return NRF_SUCCESS;
+}
+
+uint32_t bsp_indication_set( bsp_indication_t indicate )
+{
+	return NRF_SUCCESS;
+}
+
+ret_code_t bsp_btn_ble_init( bsp_btn_ble_error_handler_t error_handler, bsp_event_t *p_startup_bsp_evt )
+{
+	if ( p_startup_bsp_evt != NULL )
+	{
+		*p_startup_bsp_evt = BSP_EVENT_NOTHING;
+	}
+	return NRF_SUCCESS;
+}
+
+ret_code_t bsp_btn_ble_sleep_mode_prepare( void )
+{
+	return NRF_SUCCESS;
+}
+
+/* peer_manager (Bondなし) */
+ret_code_t pm_init( void )
+{
+	return NRF_SUCCESS;
+}
+
+ret_code_t pm_sec_params_set( ble_gap_sec_params_t *p_sec_params )
+{
+	return NRF_SUCCESS;
+}
+
+ret_code_t pm_register( pm_evt_handler_t event_handler )
+{
+	return NRF_SUCCESS;
+}
+
+ret_code_t pm_peers_delete( void )
+{
+	return NRF_SUCCESS;
+}
+
+void pm_handler_on_pm_evt( const pm_evt_t *p_pm_evt )
+{
+}
+
+void pm_handler_disconnect_on_sec_failure( const pm_evt_t *p_pm_evt )
+{
+}
+
+void pm_handler_flash_clean( const pm_evt_t *p_pm_evt )
+{
+}
+
+/* nrf_fstorage (HalFlash. 完了Eventはその場で呼ぶ) */
+ret_code_t nrf_fstorage_init( nrf_fstorage_t *p_fs, const nrf_fstorage_api_t *p_api, void *p_param )
+{
+	if ( ( p_fs == NULL ) || ( p_api == NULL ) )
+	{
+		return NRF_ERROR_NULL;
+	}
+	p_fs->p_api = p_api;
+
+	return HalFlashInit();
+}
+
+ret_code_t nrf_fstorage_uninit( nrf_fstorage_t *p_fs, void *p_param )
+{
+	if ( p_fs == NULL )
+	{
+		return NRF_ERROR_NULL;
+	}
+	p_fs->p_api = NULL;
+
+	return NRF_SUCCESS;
+}
+
+ret_code_t nrf_fstorage_read( const nrf_fstorage_t *p_fs, uint32_t src, void *p_dest, uint32_t len )
+{
+	return HalFlashRead( src, p_dest, len );
+}
+
+ret_code_t nrf_fstorage_write( const nrf_fstorage_t *p_fs, uint32_t dest, const void *p_src, uint32_t len, void *p_param )
+{
+	nrf_fstorage_evt_t evt;
+
+	memset( &evt, 0, sizeof( evt ) );
+	evt.id = NRF_FSTORAGE_EVT_WRITE_RESULT;
+	evt.result = HalFlashWrite( dest, p_src, len );
+	evt.addr = dest;
+	evt.p_src = p_src;
+	evt.len = len;
+	evt.p_param = p_param;
+	if ( p_fs->evt_handler != NULL )
+	{
+		p_fs->evt_handler( &evt );
+	}
+
+	return evt.result;
+}
+
+ret_code_t nrf_fstorage_erase( const nrf_fstorage_t *p_fs, uint32_t page_addr, uint32_t len, void *p_param )
+{
+	nrf_fstorage_evt_t evt;
+
+	memset( &evt, 0, sizeof( evt ) );
+	evt.id = NRF_FSTORAGE_EVT_ERASE_RESULT;
+	evt.result = HalFlashErase( page_addr, len );
+	evt.addr = page_addr;
+	evt.len = len;
+	evt.p_param = p_param;
+	if ( p_fs->evt_handler != NULL )
+	{
+		p_fs->evt_handler( &evt );
+	}
+
+	return evt.result;
+}
+
+bool nrf_fstorage_is_busy( const nrf_fstorage_t *p_fs )
+{
+	return false;
+}
@@ -0,0 +1,427 @@
+/**
+ * Trace journal (TraceLogInit/TraceLog/TraceFlush of library/src/lib_trace_log.c)
+ * across resets, on a NOR flash model.
+ *
+ * Every boot runs in a forked child: the retained RAM ring is mapped shared at
+ * its real address (TRACE_LOG_BASE_ADDR) and the two journal pages live in a
+ * shared flash model, so both survive the "reset" while the static state of
+ * lib_trace_log.c does not and the journal has to be mounted again. A boot
+ * logs bursts, flushes between some of them and either flushes at the end or
+ * resets without flushing (what a fault inside an interrupt does); then the
+ * next boot's TraceFlush must still write what the previous one left in RAM.
+ *
+ * The flash model only clears bits (a write over programmed bits fails),
+ * needs word-aligned writes and erases whole pages. After every boot the
+ * journal is read back oldest page first and must be exactly the newest part
+ * of what was flushed (bursts larger than the RAM ring as a
+ * TR_TRACE_JOURNAL_LOST marker), with consecutive sequence numbers and at
+ * least one full page kept once the pages have wrapped.
+ *
+ *     make -C host journal
+ *     ./host/_build/trace_journal_host -b 60 -s 5
+ *
+ * The process exits with 1 on the first mismatch.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "nrf_fstorage.h"
+#include "nrf_fstorage_sd.h"
+#include "definition.h"
+#include "lib_common.h"
+#include "lib_ex_rtc.h"
+#include "lib_trace_log.h"
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE             0x100000
+#endif
+
+#define TEST_FUNC_NO                    0x0123                                  /**< func_no of the test entries (param is the log number). */
+#define TEST_BOOTS_DEFAULT              40
+#define TEST_STEPS_MAX                  6                                       /**< Bursts per boot. */
+#define TEST_BURST_MAX                  (TRACE_LOG_SIZE + 8)                    /**< Larger than the RAM ring: some bursts lose entries. */
+#define TEST_LOG_MAX                    (TEST_BOOTS_DEFAULT * 64 * TEST_STEPS_MAX)
+#define TEST_RAM_PAGE                   0x1000
+#define TEST_FLASH_SIZE                 (TRACE_JOURNAL_PAGE_NUM * TRACE_JOURNAL_PAGE_SIZE)
+
+typedef struct
+{
+    uint8_t  flash[TEST_FLASH_SIZE];
+    uint32_t erase_count;
+    uint32_t write_bytes;
+} test_flash_t;
+
+typedef struct
+{
+    uint16_t func_no;
+    uint16_t param;
+} test_entry_t;
+
+nrf_fstorage_api_t nrf_fstorage_sd;
+
+static test_flash_t * m_flash;                                                  /**< Shared with every boot. */
+static uint32_t       m_rand = 1;
+
+// Model of what the journal must hold (parent only).
+static test_entry_t * m_expect;
+static uint32_t       m_expect_num;
+static uint32_t       m_pending;                                                /**< Logged but not flushed (still in retained RAM). */
+static uint32_t       m_logged;
+static uint32_t       m_lost_markers;
+
+static uint32_t test_rand(void)
+{
+    m_rand = m_rand * 1103515245u + 12345u;
+    return (m_rand >> 16) & 0x7FFF;
+}
+
+/**@brief Journal address -> offset in the flash model (-1: outside).
+ */
+static int32_t flash_offset(uint32_t addr, uint32_t len)
+{
+    if ((addr < TRACE_JOURNAL_START_ADDR) || ((addr - TRACE_JOURNAL_START_ADDR) + len > TEST_FLASH_SIZE))
+    {
+        return -1;
+    }
+    return (int32_t)(addr - TRACE_JOURNAL_START_ADDR);
+}
+
+ret_code_t nrf_fstorage_init(nrf_fstorage_t * p_fs, const nrf_fstorage_api_t * p_api, void * p_param)
+{
+    p_fs->p_api = p_api;
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_fstorage_uninit(nrf_fstorage_t * p_fs, void * p_param)
+{
+    p_fs->p_api = NULL;
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_fstorage_read(const nrf_fstorage_t * p_fs, uint32_t src, void * p_dest, uint32_t len)
+{
+    int32_t offset = flash_offset(src, len);
+
+    if (offset < 0)
+    {
+        fprintf(stderr, "FAIL read 0x%x+%u outside the journal\n", src, len);
+        exit(1);
+    }
+    memcpy(p_dest, &m_flash->flash[offset], len);
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_fstorage_write(const nrf_fstorage_t * p_fs, uint32_t dest, const void * p_src, uint32_t len, void * p_param)
+{
+    const uint8_t * p_data = p_src;
+    int32_t         offset = flash_offset(dest, len);
+
+    if ((offset < 0) || ((dest % 4) != 0) || ((len % 4) != 0) || (p_fs->p_api == NULL))
+    {
+        fprintf(stderr, "FAIL write 0x%x+%u (outside, unaligned or not initialised)\n", dest, len);
+        exit(1);
+    }
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if ((m_flash->flash[offset + i] & p_data[i]) != p_data[i])
+        {
+            fprintf(stderr, "FAIL write 0x%x sets programmed bits (0x%02x -> 0x%02x)\n",
+                    dest + i, m_flash->flash[offset + i], p_data[i]);
+            exit(1);
+        }
+        m_flash->flash[offset + i] &= p_data[i];
+    }
+    m_flash->write_bytes += len;
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_fstorage_erase(const nrf_fstorage_t * p_fs, uint32_t page_addr, uint32_t len, void * p_param)
+{
+    int32_t offset = flash_offset(page_addr, len * TRACE_JOURNAL_PAGE_SIZE);
+
+    if ((offset < 0) || ((page_addr % TRACE_JOURNAL_PAGE_SIZE) != 0) || (p_fs->p_api == NULL))
+    {
+        fprintf(stderr, "FAIL erase 0x%x x%u (outside, unaligned or not initialised)\n", page_addr, len);
+        exit(1);
+    }
+    memset(&m_flash->flash[offset], 0xFF, len * TRACE_JOURNAL_PAGE_SIZE);
+    m_flash->erase_count += len;
+    return NRF_SUCCESS;
+}
+
+bool nrf_fstorage_is_busy(const nrf_fstorage_t * p_fs)
+{
+    return false;
+}
+
+uint32_t sd_nvic_critical_region_enter(uint8_t * p_is_nested_critical_region)
+{
+    *p_is_nested_critical_region = 0;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_nvic_critical_region_exit(uint8_t is_nested_critical_region)
+{
+    return NRF_SUCCESS;
+}
+
+/**@brief Only SetResetReason() reads the RTC; not part of the journal.
+ */
+uint32_t ExRtcGetDateTime(DATE_TIME * pdatetime)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+/**@brief What TraceFlush() must append for the pending entries (same rule as trace_journal_collect()).
+ */
+static void model_flush(void)
+{
+    uint32_t pending = m_pending;
+
+    if (pending > (TRACE_LOG_SIZE - 1))
+    {
+        m_expect[m_expect_num++] = (test_entry_t){ TR_TRACE_JOURNAL_LOST, (uint16_t)(pending - (TRACE_LOG_SIZE - 1)) };
+        m_lost_markers++;
+        pending = TRACE_LOG_SIZE - 1;
+    }
+    for (uint32_t k = m_logged - pending; k != m_logged; k++)
+    {
+        m_expect[m_expect_num++] = (test_entry_t){ TEST_FUNC_NO, (uint16_t)k };
+    }
+    m_pending = 0;
+}
+
+/**@brief One boot: TraceLogInit(), then the bursts; a negative count flushes after the burst.
+ */
+static void boot_run(const int32_t * p_step, uint32_t steps, uint32_t first_log)
+{
+    uint32_t k = first_log;
+
+    TraceLogInit();
+    for (uint32_t i = 0; i < steps; i++)
+    {
+        uint32_t num = (uint32_t)((p_step[i] < 0) ? -p_step[i] : p_step[i]);
+
+        for (uint32_t n = 0; n < num; n++, k++)
+        {
+            TraceLog(TEST_FUNC_NO, (uint16_t)k);
+        }
+        if ((p_step[i] < 0) && (TraceFlush() != NRF_SUCCESS))
+        {
+            fprintf(stderr, "FAIL TraceFlush\n");
+            _exit(1);
+        }
+    }
+    _exit(0);
+}
+
+static uint8_t entry_check(const TRACE_JOURNAL_ENTRY * p_entry)
+{
+    const uint8_t * p_data = (const uint8_t *)p_entry;
+    uint8_t         check = 0;
+
+    for (uint32_t i = 0; i < (TRACE_JOURNAL_ENTRY_SIZE - 1); i++)
+    {
+        check ^= p_data[i];
+    }
+    return (uint8_t)~check;
+}
+
+/**@brief Read the journal back (oldest page first) and compare it with the model.
+ */
+static bool journal_check(uint32_t boot, uint32_t * p_kept)
+{
+    TRACE_JOURNAL_HEADER header[TRACE_JOURNAL_PAGE_NUM];
+    bool                 valid[TRACE_JOURNAL_PAGE_NUM];
+    uint32_t             order[TRACE_JOURNAL_PAGE_NUM];
+    uint32_t             valid_num = 0;
+    uint32_t             kept = 0;
+    uint32_t             next_seq = 0;
+    static test_entry_t  read[TRACE_JOURNAL_PAGE_NUM * TRACE_JOURNAL_ENTRY_NUM];
+
+    for (uint32_t page = 0; page < TRACE_JOURNAL_PAGE_NUM; page++)
+    {
+        memcpy(&header[page], &m_flash->flash[page * TRACE_JOURNAL_PAGE_SIZE], sizeof(header[page]));
+        valid[page] = (header[page].magic == TRACE_JOURNAL_MAGIC) &&
+                      (header[page].check == ~(header[page].magic ^ header[page].page_seq ^ header[page].first_seq));
+        if (valid[page])
+        {
+            // Insert by page_seq (oldest first).
+            uint32_t pos = valid_num++;
+            while ((pos > 0) && ((int32_t)(header[order[pos - 1]].page_seq - header[page].page_seq) > 0))
+            {
+                order[pos] = order[pos - 1];
+                pos--;
+            }
+            order[pos] = page;
+        }
+    }
+
+    for (uint32_t i = 0; i < valid_num; i++)
+    {
+        uint32_t page = order[i];
+        uint32_t slot;
+
+        if ((i > 0) && (header[page].first_seq != next_seq))
+        {
+            fprintf(stderr, "FAIL boot %u: page %u starts at seq %u, previous page ended at %u\n",
+                    boot, page, header[page].first_seq, next_seq);
+            return false;
+        }
+        for (slot = 0; slot < TRACE_JOURNAL_ENTRY_NUM; slot++)
+        {
+            TRACE_JOURNAL_ENTRY entry;
+
+            memcpy(&entry, &m_flash->flash[(page * TRACE_JOURNAL_PAGE_SIZE) + TRACE_JOURNAL_HEADER_SIZE +
+                                           (slot * TRACE_JOURNAL_ENTRY_SIZE)], sizeof(entry));
+            if ((entry.check == 0xFF) && (entry.seq == 0xFFFF))
+            {
+                break;
+            }
+            if ((entry.check != entry_check(&entry)) || (entry.seq != (uint16_t)(header[page].first_seq + slot)))
+            {
+                fprintf(stderr, "FAIL boot %u: page %u slot %u broken (seq %u)\n", boot, page, slot, entry.seq);
+                return false;
+            }
+            read[kept++] = (test_entry_t){ entry.func_no, entry.param };
+        }
+        if ((i + 1 < valid_num) && (slot != TRACE_JOURNAL_ENTRY_NUM))
+        {
+            fprintf(stderr, "FAIL boot %u: page %u rotated before it was full (%u entries)\n", boot, page, slot);
+            return false;
+        }
+        next_seq = header[page].first_seq + slot;
+    }
+
+    if ((kept > m_expect_num) || (kept < m_expect_num && kept < TRACE_JOURNAL_ENTRY_NUM))
+    {
+        fprintf(stderr, "FAIL boot %u: journal keeps %u of %u flushed entries\n", boot, kept, m_expect_num);
+        return false;
+    }
+    for (uint32_t i = 0; i < kept; i++)
+    {
+        const test_entry_t * p_expect = &m_expect[m_expect_num - kept + i];
+
+        if ((read[i].func_no != p_expect->func_no) || (read[i].param != p_expect->param))
+        {
+            fprintf(stderr, "FAIL boot %u: entry %u is 0x%04x/%u, expected 0x%04x/%u\n",
+                    boot, i, read[i].func_no, read[i].param, p_expect->func_no, p_expect->param);
+            return false;
+        }
+    }
+    *p_kept = kept;
+    return true;
+}
+
+static void usage(const char * p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-b boots] [-s seed]\n"
+            "  -b  number of boots (default %u, at most %u)\n"
+            "  -s  random seed (default 1)\n",
+            p_name, TEST_BOOTS_DEFAULT, TEST_BOOTS_DEFAULT * 2);
+}
+
+int main(int argc, char * argv[])
+{
+    uint32_t boots = TEST_BOOTS_DEFAULT;
+    uint32_t kept = 0;
+    uint32_t resets = 0;
+    int      opt;
+    void *   p_ram;
+
+    while ((opt = getopt(argc, argv, "b:s:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+                boots = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                m_rand = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if ((boots == 0) || (boots > TEST_BOOTS_DEFAULT * 2))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // Retained RAM at its device address, shared so it survives the child "reset".
+    p_ram = mmap((void *)(TRACE_LOG_BASE_ADDR & ~(uintptr_t)(TEST_RAM_PAGE - 1)), TEST_RAM_PAGE,
+                 PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    m_flash = mmap(NULL, sizeof(*m_flash), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    m_expect = malloc(sizeof(test_entry_t) * 2 * TEST_LOG_MAX);
+    if ((p_ram == MAP_FAILED) || (p_ram != (void *)(TRACE_LOG_BASE_ADDR & ~(uintptr_t)(TEST_RAM_PAGE - 1))) ||
+        (m_flash == MAP_FAILED) || (m_expect == NULL))
+    {
+        fprintf(stderr, "FAIL cannot map the retained RAM at 0x%08x\n", TRACE_LOG_BASE_ADDR);
+        return 1;
+    }
+    memset(m_flash->flash, 0xFF, sizeof(m_flash->flash));
+
+    for (uint32_t boot = 0; boot < boots; boot++)
+    {
+        int32_t  step[TEST_STEPS_MAX];
+        uint32_t steps = 1 + (test_rand() % TEST_STEPS_MAX);
+        uint32_t first_log = m_logged;
+        int      status;
+        pid_t    pid;
+
+        for (uint32_t i = 0; i < steps; i++)
+        {
+            uint32_t num = 1 + (test_rand() % TEST_BURST_MAX);
+
+            // Flush after about half of the bursts; the last one flushes unless the boot ends in a reset.
+            bool flush = (i + 1 == steps) ? ((test_rand() % 4) != 0) : ((test_rand() % 2) == 0);
+
+            step[i] = flush ? -(int32_t)num : (int32_t)num;
+            m_logged  += num;
+            m_pending += num;
+            if (flush)
+            {
+                model_flush();
+            }
+        }
+        resets += (step[steps - 1] > 0);
+
+        fflush(stdout);
+        pid = fork();
+        if (pid == 0)
+        {
+            boot_run(step, steps, first_log);
+        }
+        if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+        {
+            fprintf(stderr, "FAIL boot %u did not finish\n", boot);
+            return 1;
+        }
+        if (!journal_check(boot, &kept))
+        {
+            return 1;
+        }
+    }
+
+    printf("trace_journal boots=%u resets_unflushed=%u logged=%u flushed=%u lost_markers=%u kept=%u "
+           "erases=%u write_bytes=%u\n",
+           boots, resets, m_logged, m_expect_num, m_lost_markers, kept, m_flash->erase_count, m_flash->write_bytes);
+    if (m_expect_num <= (TRACE_JOURNAL_PAGE_NUM * TRACE_JOURNAL_ENTRY_NUM))
+    {
+        fprintf(stderr, "FAIL the journal never wrapped (%u entries)\n", m_expect_num);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -10,6 +10,8 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/09       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         BLE Profile(Connection Parameter/PHY/DLE)の定義を追加
+  * 1.2            2026/10/19       k.tashiro         Trace Journal(Trace Logの追記型Flash領域)の定義を追加
   ******************************************************************************************
 */
 
@@ -42,9 +44,18 @@ extern "C"{
 
 /* FIFO Settting */
 #define EVT_FIFO_SIZE					(40)		/* Event FIFO Number */
+/* 2026.10.19 Add Event Scheduler Class別のFIFO数(合計EVT_FIFO_SIZE) ++ */
+#define EVT_FIFO_CRITICAL_SIZE			(8)			/* Radio / Timeout Event FIFO Number */
+#define EVT_FIFO_NORMAL_SIZE			(24)		/* BLE Command / Sensor Event FIFO Number */
+#define EVT_FIFO_BULK_SIZE				(EVT_FIFO_SIZE - EVT_FIFO_CRITICAL_SIZE - EVT_FIFO_NORMAL_SIZE)	/* Daily Log Event FIFO Number */
+/* 2026.10.19 Add Event Scheduler Class別のFIFO数(合計EVT_FIFO_SIZE) -- */
 #define ACC_GYRO_FIFO_SIZE    			(40)		/* ACC/Gyro Sensor FIFO Number */
 #define SYSTEM_OFF_ENTERY_RETRY_LIMIT   (10)		/* Standby Entry Retry Limit Count */
 #define BATTERY_VOLT_FIFO_SIZE			(60)		/* Get Battery Voltage from Comparator Count*/
+/* 2026.10.19 Add Notify Queue ++ */
+#define NOTIFY_HVN_TX_QUEUE_SIZE		(4)			/* SoftDevice hvn_tx_queue_size (Default:1) */
+#define NOTIFY_QUEUE_SIZE				NOTIFY_HVN_TX_QUEUE_SIZE	/* SoftDevice Queue Full時に保持するNotify数 */
+/* 2026.10.19 Add Notify Queue -- */
 
 /* Mode Manager Setting */
 #define ULT_DATA_SIZE					(10)
@@ -233,6 +244,27 @@ extern "C"{
 #define SLAVE_LATENCY						(0)									/**< Slave latency. */
 #define FLASH_SLAVE_LATENCY					(1)
 #define CONN_SUP_TIMEOUT					MSEC_TO_UNITS(2500, UNIT_10_MS)		/**< Connection supervisory time-out (2.5 seconds). */
+
+/* 2026.10.19 Add BLE Profile ++ */
+/* Low Power Profile (Daily Mode) : 長いInterval + Slave Latencyで待機電流を下げる */
+#define BLE_PROFILE_LP_MIN_CONN_INTERVAL	MSEC_TO_UNITS(100, UNIT_1_25_MS)
+#define BLE_PROFILE_LP_MAX_CONN_INTERVAL	MSEC_TO_UNITS(150, UNIT_1_25_MS)
+#define BLE_PROFILE_LP_SLAVE_LATENCY		(4)
+#define BLE_PROFILE_LP_CONN_SUP_TIMEOUT		MSEC_TO_UNITS(4000, UNIT_10_MS)		/* (1 + Slave Latency) * Max Interval * 2 以上 */
+/* Realtime Profile (Ult Mode / Calibration) */
+#define BLE_PROFILE_RT_MIN_CONN_INTERVAL	MIN_CONN_INTERVAL
+#define BLE_PROFILE_RT_MAX_CONN_INTERVAL	MSEC_TO_UNITS(30, UNIT_1_25_MS)
+#define BLE_PROFILE_RT_SLAVE_LATENCY		SLAVE_LATENCY
+#define BLE_PROFILE_RT_CONN_SUP_TIMEOUT		CONN_SUP_TIMEOUT
+/* Bulk Profile (Raw Mode / Daily Log転送) : 2M PHY + Data Length Extension */
+#define BLE_PROFILE_BULK_MIN_CONN_INTERVAL	MIN_CONN_INTERVAL
+#define BLE_PROFILE_BULK_MAX_CONN_INTERVAL	MSEC_TO_UNITS(30, UNIT_1_25_MS)
+#define BLE_PROFILE_BULK_SLAVE_LATENCY		SLAVE_LATENCY
+#define BLE_PROFILE_BULK_CONN_SUP_TIMEOUT	CONN_SUP_TIMEOUT
+#define BLE_PROFILE_BULK_DATA_LENGTH		(251)		/* sdk_config.hのNRF_SDH_BLE_GAP_DATA_LENGTHで制限する */
+#define BLE_PROFILE_BULK_MTU_SIZE			(247)		/* sdk_config.hのNRF_SDH_BLE_GATT_MAX_MTU_SIZEで制限する */
+#define BLE_PROFILE_BULK_HOLD_MS			(3000)		/* Daily Log転送後にBulk Profileを維持する時間 3s */
+/* 2026.10.19 Add BLE Profile -- */
 //#define FIRST_CONN_PARAMS_UPDATE_DELAY  APP_TIMER_TICKS(FIRST_CONN_PARAMS_UPDATE_DELAY_10MS) /**< Time from initiating event (connect or start of notification) to first time sd_ble_gap_conn_param_update is called (15 seconds). */
 //#define NEXT_CONN_PARAMS_UPDATE_DELAY   APP_TIMER_TICKS(NEXT_CONN_PARAMS_UPDATE_DELAY_10MS)                   /**< Time between each call to sd_ble_gap_conn_param_update after the first call (5 seconds). */                                  
 
@@ -260,6 +292,11 @@ extern "C"{
 #define PLAYER_AND_PAIRING_ADDR				(0x4D000)			/* Player Data Flash Address */
 #define TRACE_ADDR							(0x4C000)			/* Trace Log Flash Address */
 #define TEST_PAGE_SIZE 						(0x0fff)
+/* 2026.10.19 Add Trace Journal (TRACE_ADDRの手前にTRACE_JOURNAL_PAGE_NUMページ確保) ++ */
+#define TRACE_JOURNAL_ADDR					(0x4A000)			/* Trace Journal Flash Address */
+#define TRACE_JOURNAL_PAGE_NUM				(2)					/* Trace Journal Page数 (2以上) */
+#define TRACE_JOURNAL_PAGE_SIZE				(0x1000)			/* Flash Page Size */
+/* 2026.10.19 Add Trace Journal -- */
 #define PLAYER_DATA_SIZE					(20)
 #define TRACE_SIZE							(256)
 #define CHECK_1ST_DATA						(0xFF000000)
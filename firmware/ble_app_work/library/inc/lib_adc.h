@@ -2,7 +2,7 @@
   ******************************************************************************************
   * @file    lib_adc.h
   * @author  k.tashiro
-  * @version 1.0
+  * @version 1.1
   * @date    2022/01/15
   * @brief   SAADC Control
   ******************************************************************************************
@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2022/01/15       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         電池電圧の常時監視(RTC2 -> PPI -> SAADC EasyDMA)を追加
   ******************************************************************************************
 */
 
@@ -35,6 +36,17 @@ extern "C"{
 #define THRESHOLD_BAT_VOLT	2000
 /* 2022.03.30 Add 電圧値判定処理結果及び閾値 -- */
 
+/* 2026.10.19 Add 電池電圧監視 ++ */
+/*
+ * RTC2のCompare EventをPPIでSAADCのSAMPLE Taskに接続し, CPUを起こさずにSamplingする.
+ * 1回のSAMPLEでBurst + 8x Oversampleした1値をEasyDMAでBufferへ書き込み,
+ * BAT_MON_SAMPLES個たまった時だけ割込みで平均 -> Filter -> 残量推定を行う
+ */
+#define BAT_MON_PERIOD_MS		(2000)		/* Sampling周期 [ms] (125ms単位) */
+#define BAT_MON_SAMPLES			(5)			/* 1回のDMA転送のSample数 (割込み周期 = 周期 x Sample数) */
+#define BAT_MON_INVALID_MV		(0)			/* 未取得 */
+/* 2026.10.19 Add 電池電圧監視 -- */
+
 /* Enum ------------------------------------------------------------------*/
 
 /* Struct ----------------------------------------------------------------*/
@@ -68,8 +80,44 @@ void AnalogUninit( void );
  */
 ret_code_t AnalogStartUpCheck( void );
 
+/**
+ * @brief 電池電圧を取得 (監視中はFilter後の値を返し, SAADCは操作しない)
+ * @param None
+ * @retval 電池電圧 [V]
+ */
 float AnalogVoltageOneshot(void);
 
+/* 2026.10.19 Add 電池電圧監視 ++ */
+/**
+ * @brief 電池電圧の監視開始
+ * @param period_ms Sampling周期 [ms]
+ * @retval NRF_SUCCESS Success
+ * @retval NRF_SUCCESS以外 Failed
+ */
+ret_code_t AnalogMonitorStart( uint32_t period_ms );
+
+/**
+ * @brief 電池電圧の監視停止
+ * @param None
+ * @retval None
+ */
+void AnalogMonitorStop( void );
+
+/**
+ * @brief Filter後の電池電圧を取得 (Blockしない)
+ * @param None
+ * @retval 電池電圧 [mV] (BAT_MON_INVALID_MV:未取得)
+ */
+uint16_t AnalogGetBatteryMv( void );
+
+/**
+ * @brief 電池残量の推定値を取得 (Blockしない)
+ * @param None
+ * @retval 電池残量 [%] (未取得の場合は0)
+ */
+uint8_t AnalogGetBatterySoc( void );
+/* 2026.10.19 Add 電池電圧監視 -- */
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,7 +2,7 @@
   ******************************************************************************************
   * @file    lib_bat.h
   * @author  k.tashiro
-  * @version 1.0
+  * @version 1.1
   * @date    2020/10/29
   * @brief   Battery Control
   ******************************************************************************************
@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/10/29       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         電池電圧は常時監視(lib_adc)の値を返す (SAADCの都度取得を廃止)
   ******************************************************************************************
 */
 
@@ -29,6 +30,7 @@ extern "C"{
 
 /* Definition ------------------------------------------------------------*/
 /* ADC値を10回取得し平均値を算出する */
+/* 2026.10.19 Modify 平均はlib_adcの電池電圧監視で行う (未使用) */
 #define MAX_GET_BAT_VALUE		10
 
 /* Enum ------------------------------------------------------------------*/
@@ -37,9 +39,9 @@ extern "C"{
 
 /* Function prototypes ----------------------------------------------------*/
 /**
- * @brief Get Battery Info from Comparator
+ * @brief Get Battery Info (監視中の電池電圧をRead Authorizeで返す)
  * @param None
- * @retval None
+ * @retval NRF_SUCCESS Success
  */
 uint32_t GetBatteryInfo(void);
 
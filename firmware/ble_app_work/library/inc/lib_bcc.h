@@ -0,0 +1,31 @@
+/**
+  ******************************************************************************************
+  * @file    lib_bcc.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   BCC (Block Check Character)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new (mode_manager.cのbcc_createを移動)
+  ******************************************************************************************
+*/
+
+#ifndef LIB_BCC_H_
+#define LIB_BCC_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Function prototypes -------------------------------------------*/
+/**
+ * @brief BCC Create
+ * @param str 計算するデータ
+ * @param len 計算するデータ長
+ * @retval XORデータ
+ */
+uint8_t BccCreate( const uint8_t *str, uint32_t len );
+
+#endif
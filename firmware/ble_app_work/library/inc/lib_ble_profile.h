@@ -0,0 +1,168 @@
+/**
+  ******************************************************************************************
+  * @file    lib_ble_profile.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   BLE Connection Profile (Connection Parameter / PHY / Data Length / MTU)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Connection Parameter Update処理を登録可能にする (ble_conn_params併用時)
+                                                      definition.hはlib_ble_profile.cでIncludeする (Badge main.cの定義と衝突するため)
+  ******************************************************************************************
+*/
+
+#ifndef LIB_BLE_PROFILE_H_
+#define LIB_BLE_PROFILE_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_gap.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/* Enum ------------------------------------------------------------------*/
+/* BLE Profile */
+typedef enum
+{
+	BLE_PROFILE_LOW_POWER = 0x00,	/* 0x00 Daily Mode (長いInterval + Slave Latency) */
+	BLE_PROFILE_REALTIME,			/* 0x01 Ult Mode / Calibration (短いInterval) */
+	BLE_PROFILE_BULK,				/* 0x02 Raw Mode / Daily Log転送 (短いInterval + 2M PHY + DLE) */
+	BLE_PROFILE_NUM
+} BLE_PROFILE_ID;
+
+/* Struct ----------------------------------------------------------------*/
+/* Profile Parameter */
+typedef struct _ble_profile_param
+{
+	uint16_t min_conn_interval;		/* [1.25ms] */
+	uint16_t max_conn_interval;		/* [1.25ms] */
+	uint16_t slave_latency;
+	uint16_t conn_sup_timeout;		/* [10ms] */
+	uint8_t  phy;					/* BLE_GAP_PHY_xxx */
+	uint8_t  data_length;			/* LL Payload [byte] */
+	uint16_t mtu_size;				/* ATT MTU [byte] */
+} BLE_PROFILE_PARAM, *PBLE_PROFILE_PARAM;
+
+/* Profile別 統計情報 */
+typedef struct _ble_profile_stats
+{
+	uint32_t active_tick;			/* 接続中にProfileが有効だった時間 [app_timer tick] */
+	uint32_t radio_tick;			/* Radio Notification Active -> Inactiveの合計 [app_timer tick] */
+	uint32_t radio_event_count;		/* Radio Event数 */
+	uint32_t tx_bytes;				/* Notify送信Payloadの合計 [byte] */
+	uint32_t switch_count;			/* Profileに切り替えた回数 */
+	uint16_t conn_interval;			/* 最後に確定したConnection Interval [1.25ms] */
+} BLE_PROFILE_STATS, *PBLE_PROFILE_STATS;
+
+/*
+ * Application依存の処理 (BleProfileInitで登録)
+ * 本モジュールはApplicationのBLE管理に依存しないため、Link単位の情報は以下から取得する
+ */
+typedef struct _ble_profile_config
+{
+	void		(*get_conn_handle)( uint16_t *p_conn_handle );	/* 接続中のConnection Handle取得 (未接続時はBLE_CONN_HANDLE_INVALID) */
+	void		(*mtu_update)( uint16_t mtu_size );				/* ATT MTU変更 (NULLの場合はMTUを変更しない) */
+	void		(*bulk_timer_restart)( void );					/* Bulk Hold Timer再開 (NULLの場合はBleProfileBulkReleaseまで維持) */
+	uint32_t	(*get_tx_bytes)( void );						/* Notify送信Payloadの合計 [byte] (NULLの場合は集計しない) */
+	uint32_t	(*conn_param_update)( uint16_t conn_handle, ble_gap_conn_params_t *p_conn_params );	/* Connection Parameter Update (NULLの場合はsd_ble_gap_conn_param_update) */
+} BLE_PROFILE_CONFIG;
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief BLE Profile Initialize (Radio Notificationを有効化)
+ * @param p_config Application依存の処理 (get_conn_handleは必須)
+ * @retval None
+ */
+void BleProfileInit( const BLE_PROFILE_CONFIG *p_config );
+
+/**
+ * @brief Mode Profileを変更 (接続中はすぐにSoftDeviceへ反映)
+ * @param profile BLE_PROFILE_ID
+ * @retval None
+ */
+void BleProfileChange( BLE_PROFILE_ID profile );
+
+/**
+ * @brief Bulk Profileを一時的に有効化 (BLE_PROFILE_BULK_HOLD_MS経過後にMode Profileへ戻す)
+ * @param None
+ * @retval None
+ */
+void BleProfileBulkKick( void );
+
+/**
+ * @brief Bulk Profileの一時有効化を解除 (Bulk Hold Timer Timeout)
+ * @param None
+ * @retval None
+ */
+void BleProfileBulkRelease( void );
+
+/**
+ * @brief 現在有効なProfileを取得
+ * @param None
+ * @retval BLE_PROFILE_ID
+ */
+BLE_PROFILE_ID GetBleProfile( void );
+
+/**
+ * @brief 現在有効なProfileのConnection Parameterを取得
+ * @param flash_op true : Flash Operation中 (Slave LatencyをFLASH_SLAVE_LATENCY以上にする)
+ * @param p_conn_params Connection Parameter格納先
+ * @retval None
+ */
+void GetBleProfileConnParam( bool flash_op, ble_gap_conn_params_t *p_conn_params );
+
+/**
+ * @brief Connection Parameter Update完了 (Parameter Update成功時)
+ * @param flash_op true : Flash Operation中
+ * @retval None
+ */
+void BleProfileReady( bool flash_op );
+
+/**
+ * @brief Flash Operationの開始/終了を通知
+ * @param flash_op true : 開始, false : 終了
+ * @retval None
+ */
+void BleProfileFlashOp( bool flash_op );
+
+/**
+ * @brief BLE_GAP_EVT_CONN_PARAM_UPDATE時の処理 (BUSYで保留していたProfileを反映)
+ * @param p_conn_params 確定したConnection Parameter
+ * @retval None
+ */
+void BleProfileConnParamUpdated( const ble_gap_conn_params_t *p_conn_params );
+
+/**
+ * @brief 切断時の処理
+ * @param None
+ * @retval None
+ */
+void BleProfileDisconnected( void );
+
+/**
+ * @brief Profile別 統計情報を取得
+ * @param profile BLE_PROFILE_ID
+ * @param p_stats 統計情報格納先
+ * @retval None
+ */
+void GetBleProfileStats( BLE_PROFILE_ID profile, BLE_PROFILE_STATS *p_stats );
+
+/**
+ * @brief Profile別 統計情報 Debug Log (Throughput / Radio On Time)
+ * @param None
+ * @retval None
+ */
+void DebugBleProfileStatsLog( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/09       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         SDKに依存しないようにする
   ******************************************************************************************
 */
 
@@ -19,10 +20,7 @@
 /* Includes --------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
-#include "nrf_log.h"
-#include "nrf_log_ctrl.h"
-#include "nrf_log_default_backends.h"
-#include "nrf_delay.h"
+#include <stdbool.h>		/* 2026.10.19 Modify 未使用のnrf_log/nrf_delayを削除 (Host Build対応) */
 
 /* Definition ------------------------------------------------------------*/
 #define COMB_SORT_ELEVEN true
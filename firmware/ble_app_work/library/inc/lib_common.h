@@ -199,6 +199,8 @@ typedef enum
 	ANGLE_FLASH_WRITE_ERR,			/* 0x37 Angle Adjust Flash Write Error */
 	ANGLE_FLASH_ERASE_ERR,			/* 0x37 Angle Adjust Flash Erase Error */
 	ANGLE_FLASH_UNINIT_ERR,			/* 0x38 Angle Adjust Flash Uninit Error */
+	BLE_GATTS_CFG_ERROR,			/* 0x39 SoftDevice GATTS Config(hvn_tx_queue_size) Error */
+	BLE_PROFILE_RADIO_NOTIFY_ERROR,	/* 0x3A BLE Profile Radio Notification Init Error */
 } ERR_PLACE;
 
 
@@ -336,6 +338,20 @@ typedef enum
 	TR_BLE_RSSI_NOTIFY_COMP,
 	TR_BLE_RSSI_NOTIFY_FAILED,
 	/* 2020.12.23 Add RSSI取得テスト -- */
+	/* 2026.10.19 Add BLE Profile ++ */
+	TR_BLE_PROFILE_CHANGE,
+	TR_BLE_PROFILE_APPLY_ERROR,
+	/* 2026.10.19 Add BLE Profile -- */
+	/* 2026.10.19 Add Trace Journal ++ */
+	TR_TRACE_JOURNAL_LOST,			/* Flush前にRAM Ringから溢れたTrace数 (param:欠落数) */
+	/* 2026.10.19 Add Trace Journal -- */
+	/* 2026.10.19 Add ACC Low Power常駐モード ++ */
+	TR_ACC_LP_INIT_CMPL,
+	TR_ACC_LP_INIT_FAIL,			/* param:失敗した設定番号 */
+	/* 2026.10.19 Add ACC Low Power常駐モード -- */
+	/* 2026.10.19 Add Fault時のTrace Journal書き込み ++ */
+	TR_APP_FAULT,					/* param:Fault IDの下位16bit (app_error_fault_handler) */
+	/* 2026.10.19 Add Fault時のTrace Journal書き込み -- */
 
 	TR_OTHER_ERROR_HEADER = 0xE000,
 	
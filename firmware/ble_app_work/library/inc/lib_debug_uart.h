@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/08       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         DebugLogVFormatを追加
   ******************************************************************************************
 */
 
@@ -19,6 +20,7 @@
 /* Includes --------------------------------------------------------------*/
 #include <stdint.h>
 #include <string.h>
+#include <stdarg.h>
 
 /* Definition ------------------------------------------------------------*/
 #define DEBUG_UART_BUFFER_SIZE		(256)		/* Debug Uart Buffer Size */
@@ -68,6 +70,16 @@ uint32_t DebugLogInit(void);
  */
 void DebugLog( int32_t level, const char *format, ... );
 
+/**
+ * @brief Debug Logの書式化 (Level文字列 + 本文 + CR/LF)
+ * @param level Debug Log Level
+ * @param buffer 格納先 (DEBUG_UART_BUFFER_SIZE以上)
+ * @param format Specify format (%d %u %x %X %s %c)
+ * @param va 引数
+ * @retval 書式化したByte数
+ */
+uint32_t DebugLogVFormat( int32_t level, char *buffer, const char *format, va_list va );
+
 /**
  * @brief Debug Log Direct Output UART
  * @param buffer Send Buffer
@@ -0,0 +1,156 @@
+/**
+  ******************************************************************************************
+  * @file    lib_energy_prof.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Energy Profiler (Subsystem/Wake要因毎の動作時間を計測)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+#ifndef LIB_ENERGY_PROF_H_
+#define LIB_ENERGY_PROF_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*
+ * CPUが動作している時間をDWT Cycle Counter (Sleep中は停止) で, 計測期間をRTC1 (app_timer) で測る.
+ * ENERGY_PROF_ENTER/EXITで囲んだ区間の時間をそのSubsystemに加算し (入れ子/割込みは内側を優先),
+ * Sleepから起きてから次のSleepまでの時間を最初に通知されたWake要因に加算する.
+ * 計測期間 - 動作時間 = Sleep時間. 電流値への換算はtools/energy_prof.pyで行う
+ */
+
+/* Definition ------------------------------------------------------------*/
+#ifndef ENERGY_PROF_ENABLED
+#define ENERGY_PROF_ENABLED			(1)			/* 0: 計測Macroを空にする */
+#endif
+#define ENERGY_PROF_VERSION			(1)			/* ENERGY_PROF_REPORTの版数 */
+#define ENERGY_PROF_CPU_MHZ			(64)
+
+#if ENERGY_PROF_ENABLED
+#define ENERGY_PROF_ENTER( sub )	uint8_t _ep_prev = EnergyProfEnter( (sub) )
+#define ENERGY_PROF_EXIT()			EnergyProfExit( _ep_prev )
+#define ENERGY_PROF_WAKE( reason )	EnergyProfWake( (reason) )
+#else
+#define ENERGY_PROF_ENTER( sub )	do { } while(0)
+#define ENERGY_PROF_EXIT()			do { } while(0)
+#define ENERGY_PROF_WAKE( reason )	do { } while(0)
+#endif
+
+/* Enum ------------------------------------------------------------------*/
+/* Subsystem */
+typedef enum
+{
+	EP_SUB_OTHER = 0,			/* 区間外 (Main Loop等) */
+	EP_SUB_SENSOR,				/* Sensor割込み / SPI読み出し / ADC */
+	EP_SUB_ALGO,				/* Algorithm */
+	EP_SUB_FLASH,				/* Flash操作 */
+	EP_SUB_BLE,					/* BLE Event / Advertising / Notify */
+	EP_SUB_LOG,					/* Log出力 */
+	EP_SUB_NUM,
+} EP_SUB;
+
+/* Wake要因 */
+typedef enum
+{
+	EP_WAKE_OTHER = 0,			/* 通知なし */
+	EP_WAKE_TIMER,				/* app_timer */
+	EP_WAKE_SENSOR,				/* Sensor割込み (GPIOTE) */
+	EP_WAKE_BLE,				/* SoftDevice Event */
+	EP_WAKE_ADC,				/* SAADC */
+	EP_WAKE_NUM,
+} EP_WAKE;
+
+/* Struct ----------------------------------------------------------------*/
+/* 計測結果 (GATT/UARTでそのまま送信する, Little Endian) */
+typedef struct __attribute__((packed)) _energy_prof_report
+{
+	uint8_t version;						/* ENERGY_PROF_VERSION */
+	uint8_t sub_num;						/* EP_SUB_NUM */
+	uint8_t wake_num;						/* EP_WAKE_NUM */
+	uint8_t cpu_mhz;						/* ENERGY_PROF_CPU_MHZ */
+	uint32_t window_ms;						/* 計測期間 [ms] */
+	uint32_t active_us[EP_SUB_NUM];			/* Subsystem毎の動作時間 [us] */
+	uint32_t wake_count[EP_WAKE_NUM];		/* Wake要因毎の回数 */
+	uint32_t wake_us[EP_WAKE_NUM];			/* Wake要因毎の動作時間 [us] */
+} ENERGY_PROF_REPORT, *PENERGY_PROF_REPORT;
+
+/* Typedef ---------------------------------------------------------------*/
+/* 出力先 (1行単位で呼び出す) */
+typedef void (*ENERGY_PROF_SINK)( const uint8_t *p_data, uint16_t length );
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief Energy Profiler Initialize (DWT Cycle Counterを有効にして計測開始)
+ * @param None
+ * @retval None
+ */
+void EnergyProfInit( void );
+
+/**
+ * @brief Subsystem区間の開始
+ * @param sub Subsystem
+ * @retval 直前のSubsystem (EnergyProfExitに渡す)
+ */
+uint8_t EnergyProfEnter( EP_SUB sub );
+
+/**
+ * @brief Subsystem区間の終了
+ * @param prev EnergyProfEnterの戻り値
+ * @retval None
+ */
+void EnergyProfExit( uint8_t prev );
+
+/**
+ * @brief Wake要因の通知 (割込みHandlerの先頭で呼ぶ, Sleep後の最初の通知だけ有効)
+ * @param reason Wake要因
+ * @retval None
+ */
+void EnergyProfWake( EP_WAKE reason );
+
+/**
+ * @brief Sleep直前に呼ぶ
+ * @param None
+ * @retval None
+ */
+void EnergyProfSleepEnter( void );
+
+/**
+ * @brief Sleepから戻った直後に呼ぶ
+ * @param None
+ * @retval None
+ */
+void EnergyProfSleepExit( void );
+
+/**
+ * @brief 計測結果を取得
+ * @param p_report 格納先
+ * @param reset true:取得後に計測をやり直す
+ * @retval None
+ */
+void EnergyProfGetReport( ENERGY_PROF_REPORT *p_report, bool reset );
+
+/**
+ * @brief 計測結果を1行のText ("EPROF <Hex>") で出力
+ * @param p_report 計測結果
+ * @param sink 出力先
+ * @retval None
+ */
+void EnergyProfDump( const ENERGY_PROF_REPORT *p_report, ENERGY_PROF_SINK sink );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
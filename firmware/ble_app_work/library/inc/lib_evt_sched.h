@@ -0,0 +1,190 @@
+/**
+  ******************************************************************************************
+  * @file    lib_evt_sched.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Event Scheduler (Priority Class / Coalescing)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         EVT_SCHED_ORDERED(Class間の追い越し禁止)を追加
+  ******************************************************************************************
+*/
+
+#ifndef LIB_EVT_SCHED_H_
+#define LIB_EVT_SCHED_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*
+ * 本モジュールはSDKに依存しない(Host上でビルド可能)
+ * EVT_SCHED_HOST_BUILDを定義した場合はCritical Regionを使用しない
+ */
+#ifndef EVT_SCHED_HOST_BUILD
+#include "app_util_platform.h"
+#endif
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/* Definition ------------------------------------------------------------*/
+#define EVT_SCHED_EVT_MAX			(64)		/* 扱えるEvent IDの最大数 */
+#define EVT_SCHED_PENDING_WORDS		(EVT_SCHED_EVT_MAX / 32)
+#define EVT_SCHED_COALESCE			(0x80)		/* Class Tableに付加: 未処理の同一Eventをまとめる */
+#define EVT_SCHED_ORDERED			(0x40)		/* Class Tableに付加: 先にPushされたORDERED Eventを追い越さない */
+#define EVT_SCHED_CLASS_MASK		(0x3F)
+#define EVT_SCHED_STARVE_LIMIT		(4)			/* 下位Classを飛ばす最大連続回数 */
+
+/* Return Code */
+#define EVT_SCHED_SUCCESS			(0)
+#define EVT_SCHED_COALESCED			(1)			/* 未処理の同一Eventにまとめた */
+#define EVT_SCHED_NO_MEM			(2)			/* Queue Full */
+#define EVT_SCHED_EMPTY				(3)			/* Queue Empty */
+#define EVT_SCHED_INVALID			(4)			/* Parameter Error */
+
+#ifdef EVT_SCHED_HOST_BUILD
+#define EVT_SCHED_CRITICAL_ENTER()
+#define EVT_SCHED_CRITICAL_EXIT()
+#else
+#define EVT_SCHED_CRITICAL_ENTER()	CRITICAL_REGION_ENTER()
+#define EVT_SCHED_CRITICAL_EXIT()	CRITICAL_REGION_EXIT()
+#endif
+
+/* Enum ------------------------------------------------------------------*/
+/* Priority Class (値が小さいほど優先) */
+typedef enum
+{
+	EVT_SCHED_CLASS_CRITICAL = 0x00,	/* 0x00 Radio / Timeout / State遷移 */
+	EVT_SCHED_CLASS_NORMAL,				/* 0x01 BLE Command / Sensor / RTC */
+	EVT_SCHED_CLASS_BULK,				/* 0x02 Daily Log転送 / RSSI */
+	EVT_SCHED_CLASS_NUM
+} EVT_SCHED_CLASS;
+
+/* Struct ----------------------------------------------------------------*/
+/* Class別 統計情報 */
+typedef struct _evt_sched_stats
+{
+	uint32_t push_count;		/* Queueに積んだ数 */
+	uint32_t pop_count;			/* Queueから取り出した数 */
+	uint32_t coalesce_count;	/* まとめた数 */
+	uint32_t drop_count;		/* Queue Fullで破棄した数 */
+	uint32_t latency_sum;		/* Push -> Popまでの合計時間 [tick] */
+	uint32_t latency_max;		/* Push -> Popまでの最大時間 [tick] */
+	uint8_t  depth;				/* 現在のQueue数 */
+	uint8_t  depth_max;			/* 最大Queue数 */
+} EVT_SCHED_STATS, *PEVT_SCHED_STATS;
+
+/* Queue Slot管理情報 */
+typedef struct _evt_sched_slot
+{
+	uint32_t tick;				/* Push時のTick */
+	uint16_t seq;				/* Push順 (EVT_SCHED_ORDEREDの順序判定用) */
+	uint8_t  evt_id;			/* Event ID */
+} EVT_SCHED_SLOT;
+
+/* Class別 Queue */
+typedef struct _evt_sched_queue
+{
+	uint8_t        *p_item;		/* Item格納領域 (item_size * size) */
+	EVT_SCHED_SLOT *p_slot;		/* Slot管理情報 (size) */
+	uint8_t  size;
+	uint8_t  head;
+	uint8_t  count;
+	uint8_t  starve;			/* 上位Classを優先して飛ばされた連続回数 */
+} EVT_SCHED_QUEUE;
+
+/* 初期化パラメータ */
+typedef struct _evt_sched_config
+{
+	uint8_t			*p_item[EVT_SCHED_CLASS_NUM];	/* Class別 Item格納領域 */
+	EVT_SCHED_SLOT	*p_slot[EVT_SCHED_CLASS_NUM];	/* Class別 Slot管理情報 */
+	uint8_t			size[EVT_SCHED_CLASS_NUM];		/* Class別 Queue数 */
+	uint16_t		item_size;						/* 1Itemのサイズ */
+	const uint8_t	*p_class_table;					/* Event ID -> Class | EVT_SCHED_COALESCE | EVT_SCHED_ORDERED */
+	uint8_t			evt_num;						/* Class Tableの要素数 */
+	uint32_t		(*get_tick)(void);				/* Tick取得関数 (NULLの場合は遅延計測しない) */
+	uint32_t		tick_mask;						/* Tick Counterのビット幅 */
+} EVT_SCHED_CONFIG;
+
+/* Scheduler */
+typedef struct _evt_sched
+{
+	EVT_SCHED_QUEUE		queue[EVT_SCHED_CLASS_NUM];
+	EVT_SCHED_STATS		stats[EVT_SCHED_CLASS_NUM];
+	volatile uint32_t	pending[EVT_SCHED_PENDING_WORDS];	/* Coalesce対象EventのPush済みフラグ */
+	uint16_t			item_size;
+	const uint8_t		*p_class_table;
+	uint8_t				evt_num;
+	uint32_t			(*get_tick)(void);
+	uint32_t			tick_mask;
+	uint16_t			seq;								/* 次にPushするEventのPush順 */
+} EVT_SCHED, *PEVT_SCHED;
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief Event Scheduler Initialize
+ * @param p_sched Scheduler
+ * @param p_config Initialize Parameter
+ * @retval EVT_SCHED_SUCCESS Success
+ * @retval EVT_SCHED_INVALID Parameter Error
+ */
+uint32_t EvtSchedInit( EVT_SCHED *p_sched, const EVT_SCHED_CONFIG *p_config );
+
+/**
+ * @brief Event Push (割り込みからも呼び出し可)
+ * @param p_sched Scheduler
+ * @param evt_id Event ID
+ * @param p_item Event Data (item_sizeをコピーする)
+ * @retval EVT_SCHED_SUCCESS Success
+ * @retval EVT_SCHED_COALESCED 未処理の同一Eventにまとめた
+ * @retval EVT_SCHED_NO_MEM Queue Full
+ * @retval EVT_SCHED_INVALID Parameter Error
+ */
+uint32_t EvtSchedPush( EVT_SCHED *p_sched, uint8_t evt_id, const void *p_item );
+
+/**
+ * @brief Event Pop (優先度の高いClassから取り出す)
+ * @remark EVT_SCHED_ORDEREDのEventは、先にPushされたORDERED Eventが
+ *         他のClassに残っている間は取り出さない (Push順を保つ)
+ * @param p_sched Scheduler
+ * @param p_item Event Data格納先
+ * @retval EVT_SCHED_SUCCESS Success
+ * @retval EVT_SCHED_EMPTY Queue Empty
+ */
+uint32_t EvtSchedPop( EVT_SCHED *p_sched, void *p_item );
+
+/**
+ * @brief Queueに積まれているEvent数を取得
+ * @param p_sched Scheduler
+ * @retval 全ClassのEvent数
+ */
+uint16_t EvtSchedDepth( const EVT_SCHED *p_sched );
+
+/**
+ * @brief Class別 統計情報を取得
+ * @param p_sched Scheduler
+ * @param class_id Priority Class
+ * @param p_stats 統計情報格納先
+ * @retval None
+ */
+void EvtSchedGetStats( const EVT_SCHED *p_sched, uint8_t class_id, EVT_SCHED_STATS *p_stats );
+
+/**
+ * @brief 統計情報をクリア (depthは保持)
+ * @param p_sched Scheduler
+ * @retval None
+ */
+void EvtSchedClearStats( EVT_SCHED *p_sched );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -11,6 +11,7 @@
   ******************************************************************************************
   * 1.0            2020/09/10       k.tashiro         create new
   * 1.0            2022/01/11       k.tashiro         BL5372 support
+  * 1.1            2026/10/19       k.tashiro         lib_hal.hに移行 (nRF SDKのHeaderを削除)
   ******************************************************************************************
 */
 
@@ -20,13 +21,9 @@
 
 /* Includes --------------------------------------------------------------*/
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
-#include "nordic_common.h"
-#include "nrf.h"
-#include "nrf_drv_twi.h"
-#include "nrf_gpio.h"
-#include "nrf_delay.h"
-#include "nrfx_gpiote.h"
+#include "lib_hal.h"
 
 /* Definition ------------------------------------------------------------*/
 //#define RTC_DEBUG_ONE_MIN_INT		/* 1分単位で割り込みを発生させるためのデバッグFlag */
@@ -164,7 +161,7 @@ void ExRtcSetDateTime( DATE_TIME *pdatetime );
  * @param pdatetime 取得する日時
  * @retval None
  */
-ret_code_t ExRtcGetDateTime( DATE_TIME *pdatetime );
+uint32_t ExRtcGetDateTime( DATE_TIME *pdatetime );
 
 /**
  * @brief External RTC 
@@ -10,6 +10,8 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/15       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Event FIFOをPriority Class/Coalesce対応に変更
+  * 1.2            2026/10/19       k.tashiro         Notify FIFOをNotify Queue(lib_notify_queue)へ統合
   ******************************************************************************************
 */
 
@@ -22,6 +24,7 @@
 #include "lib_icm42607.h"
 #include "ble_gatts.h"
 #include "lib_bat.h"
+#include "lib_evt_sched.h"
 
 /* Definition -------------------------------------------------------------*/
 #define DEBUG_EVT_FIFO_LOG DebugEvtFifoLog
@@ -65,14 +68,6 @@ uint32_t AccGyroPushFifo(ACC_GYRO_DATA_INFO *p_data);
  */
 uint32_t AccGyroPopFifo(ACC_GYRO_DATA_INFO *p_data);
 
-/**
- * @brief POP Fifo Data(Notifiy用)
- * @param pNotify_param BLE Notify parameter
- * @retval NRF_SUCCESS Success
- * @retval NRF_ERROR_NO_MEM Error
- */
-uint32_t NotifyPopFifo(ble_gatts_hvx_params_t *pNotify_param);
-
 /**
  * @brief Push Fifo Data(FIFO Clear)
  * @param pData FIFO Count Info
@@ -90,18 +85,42 @@ uint32_t FifoClearPushFifo( SENSOR_FIFO_DATA_INFO *p_data );
 uint32_t FifoClearPopFifo( SENSOR_FIFO_DATA_INFO *p_data );
 
 /**
- * @brief Clear Notify FIFO(Notifiy用)
+ * @brief FIFO Event Debug Log
+ * @param err_code Error Code
+ * @param event Event ID
+ * @retval None
+ */
+void DebugEvtFifoLog(uint32_t err_code, uint8_t event);
+
+/* 2026.10.19 Add Event Scheduler 統計情報 ++ */
+/**
+ * @brief Get Event FIFO Statistics
+ * @param class_id Priority Class (EVT_SCHED_CLASS)
+ * @param p_stats Statistics
+ * @retval None
+ */
+void GetEvtFifoStats(uint8_t class_id, EVT_SCHED_STATS *p_stats);
+
+/**
+ * @brief Get Event FIFO Depth
+ * @param None
+ * @retval 全Classに積まれているEvent数
+ */
+uint16_t GetEvtFifoDepth(void);
+
+/**
+ * @brief Clear Event FIFO Statistics
  * @param None
  * @retval None
  */
-void ClearNotifyFifo(void);
+void ClearEvtFifoStats(void);
 
 /**
- * @brief FIFO Event Debug Log
- * @param err_code Error Code
- * @param event Event ID
+ * @brief Event FIFO Statistics Debug Log
+ * @param None
  * @retval None
  */
-void DebugEvtFifoLog(uint32_t err_code, uint8_t event);
+void DebugEvtFifoStatsLog(void);
+/* 2026.10.19 Add Event Scheduler 統計情報 -- */
 
 #endif
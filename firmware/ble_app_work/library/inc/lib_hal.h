@@ -0,0 +1,353 @@
+/**
+  ******************************************************************************************
+  * @file    lib_hal.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Hardware Abstraction Layer (SPI/TWI/GPIO/Flash/Timer/Delay/Debug UART/Notify/Advertising)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Debug UARTを追加
+  * 1.2            2026/10/19       k.tashiro         GPIO Pull/WakeUp/出力, Delayを追加 (lib_icm42607/lib_ex_rtcを移行)
+  ******************************************************************************************
+*/
+
+#ifndef LIB_HAL_H_
+#define LIB_HAL_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*
+ * SDKに依存しない. 実装はBuild時に1つだけLinkする
+ *   lib_hal_nrf.c        : nRF52 (nrf_drv_spi/twi, nrf_gpio, nrfx_gpiote, nrf_delay, nrf_fstorage, app_timer, SoftDevice)
+ *   host/lib_hal_posix.c : Linux (Flash=File, IMU/RTC=記録したTraceの再生, 時間=仮想時間)
+ * このHeaderだけを使うModuleはどちらでもBuildできる
+ */
+
+/* Definition ------------------------------------------------------------*/
+/* 戻り値 (NRF_SUCCESS/NRF_ERROR_xxxと同値) */
+#define HAL_SUCCESS					(0)
+#define HAL_ERROR_INTERNAL			(3)
+#define HAL_ERROR_NO_MEM			(4)
+#define HAL_ERROR_NOT_FOUND			(5)
+#define HAL_ERROR_INVALID_PARAM		(7)
+#define HAL_ERROR_INVALID_STATE		(8)
+#define HAL_ERROR_INVALID_LENGTH	(9)
+#define HAL_ERROR_TIMEOUT			(13)
+#define HAL_ERROR_INVALID_ADDR		(16)
+#define HAL_ERROR_BUSY				(17)
+
+/* SPI (ICM-42607, CSはHAL内で制御) */
+#define HAL_SPI_XFER_MAX			(24)		/* 1回の転送の最大Byte数 (Register Address込み) */
+
+/* Flash (TRACE_JOURNAL_ADDR - DAILY_ADDR2の範囲) */
+#define HAL_FLASH_PAGE_SIZE			(0x1000)
+#define HAL_FLASH_START_ADDR		(0x4A000)
+#define HAL_FLASH_END_ADDR			(0x51000)
+
+/* Timer */
+#define HAL_TIMER_MAX				(8)			/* HalTimerCreateで作成できる数 */
+
+/* Enum ------------------------------------------------------------------*/
+/* GPIO割込みの検出Edge */
+typedef enum
+{
+	HAL_GPIO_EDGE_RISE = 0,
+	HAL_GPIO_EDGE_FALL,
+	HAL_GPIO_EDGE_TOGGLE,
+} HAL_GPIO_EDGE;
+
+/* GPIO入力のPull */
+typedef enum
+{
+	HAL_GPIO_PULL_NONE = 0,
+	HAL_GPIO_PULL_UP,
+	HAL_GPIO_PULL_DOWN,
+} HAL_GPIO_PULL;
+
+/* Typedef ---------------------------------------------------------------*/
+typedef void (*HAL_GPIO_HANDLER)( uint32_t pin );
+typedef void (*HAL_TIMER_HANDLER)( void *p_context );
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief Critical Section開始
+ * @param p_nested 入れ子状態の格納先 (HalCriticalExitに渡す)
+ * @retval None
+ */
+void HalCriticalEnter( uint8_t *p_nested );
+
+/**
+ * @brief Critical Section終了
+ * @param nested HalCriticalEnterで取得した値
+ * @retval None
+ */
+void HalCriticalExit( uint8_t nested );
+
+/**
+ * @brief SPI Initialize (Pin設定 + CS Inactive)
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalSpiInit( void );
+
+/**
+ * @brief SPI Uninitialize
+ * @param None
+ * @retval None
+ */
+void HalSpiUninit( void );
+
+/**
+ * @brief SPI転送 (CS Active -> 転送 -> CS Inactive)
+ * @param p_tx 送信Data
+ * @param tx_len 送信Byte数
+ * @param p_rx 受信Data格納先 (NULL:受信しない)
+ * @param rx_len 受信Byte数 (送信と同時に受信した分を含む)
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalSpiTransfer( const uint8_t *p_tx, uint8_t tx_len, uint8_t *p_rx, uint8_t rx_len );
+
+/**
+ * @brief TWI Initialize
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTwiInit( void );
+
+/**
+ * @brief TWI Uninitialize
+ * @param None
+ * @retval None
+ */
+void HalTwiUninit( void );
+
+/**
+ * @brief TWI書き込み (完了まで待つ)
+ * @param addr Slave Address
+ * @param p_data 書き込むData
+ * @param len Byte数
+ * @param no_stop true:STOPを出さない (続けてHalTwiReadする場合)
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTwiWrite( uint8_t addr, const uint8_t *p_data, uint8_t len, bool no_stop );
+
+/**
+ * @brief TWI読み出し (完了まで待つ)
+ * @param addr Slave Address
+ * @param p_data 格納先
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTwiRead( uint8_t addr, uint8_t *p_data, uint8_t len );
+
+/**
+ * @brief GPIO割込み設定 (入力, 設定後は無効. 設定済みのPinはHandlerごと設定し直す)
+ * @remark Handlerから戻った後にLatchをクリアする
+ * @param pin Pin番号
+ * @param edge 検出Edge
+ * @param pull Pull設定
+ * @param handler 割込みHandler
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalGpioIntInit( uint32_t pin, HAL_GPIO_EDGE edge, HAL_GPIO_PULL pull, HAL_GPIO_HANDLER handler );
+
+/**
+ * @brief GPIO割込み有効 (Latchをクリアしてから有効にする)
+ * @param pin Pin番号
+ * @retval None
+ */
+void HalGpioIntEnable( uint32_t pin );
+
+/**
+ * @brief GPIO割込み無効 (無効にしてからLatchをクリアする)
+ * @param pin Pin番号
+ * @retval None
+ */
+void HalGpioIntDisable( uint32_t pin );
+
+/**
+ * @brief System OFFからの起動要因に設定 (GPIO割込みは解除し, Senseを設定してLatchをクリアする)
+ * @param pin Pin番号
+ * @param pull Pull設定
+ * @param high true:High Levelで起動, false:Low Levelで起動
+ * @retval None
+ */
+void HalGpioWakeUpSet( uint32_t pin, HAL_GPIO_PULL pull, bool high );
+
+/**
+ * @brief System OFFからの起動要因か (起動時のLatch状態)
+ * @param pin Pin番号
+ * @retval true このPinで起動した
+ * @retval false このPinではない
+ */
+bool HalGpioWakeUpCheck( uint32_t pin );
+
+/**
+ * @brief GPIO出力 (出力に設定してLevelを書き込む)
+ * @param pin Pin番号
+ * @param high true:High, false:Low
+ * @retval None
+ */
+void HalGpioWrite( uint32_t pin, bool high );
+
+/**
+ * @brief 待ち (Busy Wait, Hostでは仮想時間を進める)
+ * @param us 時間 [us]
+ * @retval None
+ */
+void HalDelayUs( uint32_t us );
+
+/**
+ * @brief 待ち (Busy Wait, Hostでは仮想時間を進める)
+ * @param ms 時間 [ms]
+ * @retval None
+ */
+void HalDelayMs( uint32_t ms );
+
+/**
+ * @brief Flash Initialize
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashInit( void );
+
+/**
+ * @brief Flash読み出し
+ * @param addr 読み出すAddress
+ * @param p_data 格納先
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashRead( uint32_t addr, void *p_data, uint32_t len );
+
+/**
+ * @brief Flash書き込み (完了まで待つ, 4Byte単位)
+ * @param addr 書き込むAddress
+ * @param p_data 書き込むData (完了まで保持する)
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashWrite( uint32_t addr, const void *p_data, uint32_t len );
+
+/**
+ * @brief Flash消去 (完了まで待つ)
+ * @param addr 消去するPageの先頭Address
+ * @param pages Page数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashErase( uint32_t addr, uint32_t pages );
+
+/**
+ * @brief Timer作成
+ * @param p_id 作成したTimerのID格納先
+ * @param repeated true:周期, false:One Shot
+ * @param handler Timeout Handler
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_ERROR_NO_MEM HAL_TIMER_MAX個作成済み
+ */
+uint32_t HalTimerCreate( uint8_t *p_id, bool repeated, HAL_TIMER_HANDLER handler );
+
+/**
+ * @brief Timer開始 (動作中ならやり直す)
+ * @param id Timer ID
+ * @param ms 周期 [ms]
+ * @param p_context Handlerに渡す値
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTimerStart( uint8_t id, uint32_t ms, void *p_context );
+
+/**
+ * @brief Timer停止
+ * @param id Timer ID
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTimerStop( uint8_t id );
+
+/**
+ * @brief 起動からの時間
+ * @param None
+ * @retval 時間 [ms] (約49日で一周, nRFではRTC1が一周する512秒以内に1回以上呼ぶ)
+ */
+uint32_t HalTimeMs( void );
+
+/**
+ * @brief Debug UART Initialize
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalDebugInit( void );
+
+/**
+ * @brief Debug UART出力 (Blocking)
+ * @param p_data 送信Data
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_ERROR_INVALID_STATE 未初期化 (出力しない)
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalDebugWrite( const char *p_data, uint16_t len );
+
+/**
+ * @brief Notify送信
+ * @param conn_handle Connection Handle
+ * @param value_handle Characteristic Value Handle
+ * @param p_data 送信Data
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed (未接続/Notify無効/送信Buffer不足)
+ */
+uint32_t HalNotify( uint16_t conn_handle, uint16_t value_handle, const uint8_t *p_data, uint16_t len );
+
+/**
+ * @brief Advertising Payloadの登録 (nRFではadvertising_init()でble_adv_schedに登録済みのため確認のみ)
+ * @param p_payload Manufacturer Specific Data (Company IDを除く)
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalAdvInit( const uint8_t *p_payload, uint16_t len );
+
+/**
+ * @brief Advertising Payloadの更新を反映
+ * @param alarm true:Alarm (短い間隔で送信する)
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalAdvUpdate( bool alarm );
+
+/**
+ * @brief 次のEventまで待つ (nRF:Sleep, Host:仮想時間を進めてHandlerを呼ぶ)
+ * @param None
+ * @retval true 継続
+ * @retval false 終了 (HostでTraceの再生が終わった)
+ */
+bool HalWaitEvent( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
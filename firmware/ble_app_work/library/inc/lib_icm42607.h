@@ -10,6 +10,10 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2022/03/04       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Low Power常駐モード(WOM + Register 1 Sample読み出し)を追加
+  * 1.2            2026/10/19       k.tashiro         Low Power常駐モードのODRを50Hzに変更, 生データ読み出しを追加
+  * 1.3            2026/10/19       k.tashiro         FIFO Packet定義をlib_icm42607_fifo.hに分離
+  * 1.4            2026/10/19       k.tashiro         GPIO設定をlib_hal.hの型に変更 (nrf_gpio/nrfx_gpiote依存を削除)
   ******************************************************************************************
 */
 
@@ -17,11 +21,11 @@
 #define LIB_ICM42607_H_
 
 /* Includes --------------------------------------------------------------*/
-#include "nrf_gpio.h"
-#include "nrfx_gpiote.h"
+#include "lib_hal.h"
 
 //#include "state_control.h"
 #include "lib_spi_function.h"
+#include "lib_icm42607_fifo.h"		/* 2026.10.19 Add FIFO Packet定義を分離 */
 //#include "definition.h"
 #include "lib_common.h"
 
@@ -156,7 +160,6 @@
 #define ENABLE_BASIC_INTERRUTS_MASK			(0x80)			/* Enable basic interrupts */
 #define INACT_EN_LOWPOWER					(0x60)			/* Accelerometer ODR to 12.5 Hz gyro power down */
 
-#define ACC_GYRO_FIFO_PACKET_SIZE			(16)			/* FIFO Packet Size */
 #define ACC_GYRO_WTM_COUNT					ACC_GYRO_FIFO_PACKET_SIZE * 4				/* FIFO watermark threshold */
 
 #define ACC_GYRO_SETEUP_ERROR				(0xFF)			/* Acc/Gyro Setup Error */
@@ -165,6 +168,12 @@
 #define WOM_X_AXIS_THR						(0xFF)			/* X-AxisのWake On Motionしきい値(996.1mg) Resolution(1g/256) [255 / 256 = 0.99609] */
 #define WOM_Y_AXIS_THR						(0xFF)			/* Y-AxisのWake On Motionしきい値(996.1mg) Resolution(1g/256) [255 / 256 = 0.99609] */
 #define WOM_Z_AXIS_THR						(0xFF)			/* Z-AxisのWake On Motionしきい値(996.1mg) Resolution(1g/256) [255 / 256 = 0.99609] */
+/* 2026.10.19 Add Low Power常駐モード ++ */
+#define WOM_LP_AXIS_THR						(0x40)			/* Low Power常駐モードのWake On Motionしきい値(250mg) Resolution(1g/256) [64 / 256 = 0.25] */
+#define ACC_INVALID_DATA					((int16_t)0x8000)		/* ACC Invalid Data (Data未更新) */
+#define ACC_LP_SENSITIVITY					(2048.0f)		/* Low Power常駐モードの分解能 16g: 2048 LSB/g */
+#define ACC_LP_ODR							ACC_ODR_50HZ	/* Low Power常駐モードのODR (転倒検出のSampling周期20msに合わせる) */
+/* 2026.10.19 Add Low Power常駐モード -- */
 
 #define ACC_GYRO_TAG_MASK					(0xF8)			/* Output TAG Data Mask */
 
@@ -235,8 +244,6 @@
 #define ACC_GYRO_FIFO_FLUSH					(0x04)			/* FIFO Flush */
 #define ACC_GYRO_FIFO_FLUSH_MASK			ACC_GYRO_FIFO_FLUSH
 
-#define GYRO_INVALID_DATA					((int16_t)0x8000)		/* Gyro Invalid Data */
-
 #define OTP_CONFIG_MASK						(0x0C)			/* OTP Config Mask */
 #define OTP_CTRL7_MASK						(0x0A)			/* OTP CTRL7 Mask */
 
@@ -372,25 +379,6 @@ typedef enum
 	TAG_TEMP		=	0x03,		/* Temperature */
 } TAG_DATA_OUT;
 
-/* 動作モード指定 */
-typedef enum
-{
-	MODE_ACC_ONLY	= 0,		/* Acc Only */
-	MODE_GYRO_TEMP,				/* Gyro/Temp */
-	MODE_BOTH,					/* Acc/Gyro/Temp */
-	MODE_ACC_ONLY_LP,			/* Acc Only Low Power */
-} ACC_GYRO_EXEC_MODE;
-
-typedef enum
-{
-	HEADER_ACC_DATA			= 0x01,		/* Acc Data */
-	HEADER_GYRO_DATA		= 0x02,		/* Gyro Data */
-	HEADER_ACC_GYRO_DATA	= 0x03,		/* Acc/Gyro Data */
-	HEADER_ACC_LP_DATA		= 0x04,		/* Acc LP Mode Data */
-	HEADER_ACC_GYRO			= 0x68,		/* Acc/Gyro Data */
-	HEADER_FIFO_EMPTY		= 0x80,		/* Acc/Gyro Data FIFO Empty */
-} ACC_GYRO_SEND_HEADER;
-
 /* Power Management ACC Mode */
 typedef enum
 {
@@ -444,37 +432,21 @@ typedef enum
 } PWR_MGMT_POWER_RC;
 
 /* Struct ----------------------------------------------------------------*/
-typedef void ( *gpio_handler )( nrfx_gpiote_pin_t, nrf_gpiote_polarity_t );
 typedef struct _gpio_pin_info
 {
 	uint32_t gpio_pin;
-	nrf_gpio_pin_pull_t	pull_config;
-    nrf_gpiote_polarity_t sense_config;
-    gpio_handler handler;
+	HAL_GPIO_PULL pull_config;
+	HAL_GPIO_EDGE sense_config;
+	HAL_GPIO_HANDLER handler;
 } ACC_GYRO_GPIO_PIN_INFO;
 
 typedef struct _gpio_pin_wakeup_info
 {
 	uint32_t gpio_pin;
-	nrf_gpio_pin_pull_t	pull_config;
-    nrf_gpio_pin_sense_t sense_config;
+	HAL_GPIO_PULL pull_config;
+	bool sense_high;				/* true: High Levelで起動 */
 } ACC_GYRO_GPIO_WAKEUP_PIN_INFO;
 
-/* ACC/Gyro Data Information */
-typedef struct _acc_gyro_data_info
-{
-	int16_t acc_x_data;
-	int16_t acc_y_data;
-	int16_t acc_z_data;
-	int16_t gyro_x_data;
-	int16_t gyro_y_data;
-	int16_t gyro_z_data;
-	uint16_t timestamp;
-	uint16_t sid;			/* 2020.12.07 Add */
-	int8_t temperature;
-	uint8_t header;
-} ACC_GYRO_DATA_INFO;
-
 /* Sensor FIFO Data Info */
 typedef struct _sensor_fifo_data_info
 {
@@ -623,5 +595,45 @@ void AccGyroSelfTest( void );
 
 void AccGyroOneshotAcc( float* fax, float* fay, float* faz);
 
+/* 2026.10.19 Add Low Power常駐モード ++ */
+/**
+ * @brief ACC/Gyro Low Power常駐モード開始 (設定済みの場合は何もしない)
+ * @param previous_err 一つ前の処理結果
+ * @retval UTC_SUCCESS Success
+ * @retval UTC_SPI_ERROR Error
+ */
+uint32_t AccGyroLowPowerStart( uint32_t previous_err );
+
+/**
+ * @brief ACC Data Register から1 Sampleを読み出す (Low Power常駐モード, 生データ)
+ * @param x X-Axis [LSB] (ACC_LP_SENSITIVITY LSB/g)
+ * @param y Y-Axis [LSB]
+ * @param z Z-Axis [LSB]
+ * @retval UTC_SUCCESS Success
+ * @retval UTC_ERROR Data未更新 (前回の値を保持)
+ * @retval UTC_SPI_ERROR Error
+ */
+uint32_t AccGyroReadAccRaw( int16_t *x, int16_t *y, int16_t *z );
+
+/**
+ * @brief ACC Data Register から1 Sampleを読み出す (Low Power常駐モード)
+ * @param fax X-Axis [g]
+ * @param fay Y-Axis [g]
+ * @param faz Z-Axis [g]
+ * @retval UTC_SUCCESS Success
+ * @retval UTC_ERROR Data未更新 (前回の値を保持)
+ * @retval UTC_SPI_ERROR Error
+ */
+uint32_t AccGyroReadAccSample( float *fax, float *fay, float *faz );
+
+/**
+ * @brief WOM割り込みの有無を取得してクリア
+ * @param None
+ * @retval true WOM割り込みあり
+ * @retval false WOM割り込みなし
+ */
+bool AccGyroGetWomEvent( void );
+/* 2026.10.19 Add Low Power常駐モード -- */
+
 #endif
 
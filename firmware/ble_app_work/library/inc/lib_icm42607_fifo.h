@@ -0,0 +1,91 @@
+/**
+  ******************************************************************************************
+  * @file    lib_icm42607_fifo.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   ICM42607 FIFO Packet Decode
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new (lib_icm42607から分離)
+  ******************************************************************************************
+*/
+
+#ifndef LIB_ICM42607_FIFO_H_
+#define LIB_ICM42607_FIFO_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*
+ * SDKに依存しない. FIFO Packet (16byte) のLayout
+ *   [0] Header, [1-6] Acc X/Y/Z (Little Endian), [7-12] Gyro X/Y/Z (Little Endian),
+ *   [13] Temperature, [14-15] Timestamp (Big Endian)
+ */
+
+/* Definition ------------------------------------------------------------*/
+#define ACC_GYRO_FIFO_PACKET_SIZE			(16)			/* FIFO Packet Size */
+
+#define GYRO_INVALID_DATA					((int16_t)0x8000)		/* Gyro Invalid Data */
+
+#define ACC_GYRO_DATA_COMPLETE				(1)			/* FIFOへの格納条件 */
+#define ACC_GYRO_DATA_NOT_COMPLETE			(2)			/* FIFOへの格納条件 */
+
+/* Enum ------------------------------------------------------------------*/
+/* 動作モード指定 */
+typedef enum
+{
+	MODE_ACC_ONLY	= 0,		/* Acc Only */
+	MODE_GYRO_TEMP,				/* Gyro/Temp */
+	MODE_BOTH,					/* Acc/Gyro/Temp */
+	MODE_ACC_ONLY_LP,			/* Acc Only Low Power */
+} ACC_GYRO_EXEC_MODE;
+
+typedef enum
+{
+	HEADER_ACC_DATA			= 0x01,		/* Acc Data */
+	HEADER_GYRO_DATA		= 0x02,		/* Gyro Data */
+	HEADER_ACC_GYRO_DATA	= 0x03,		/* Acc/Gyro Data */
+	HEADER_ACC_LP_DATA		= 0x04,		/* Acc LP Mode Data */
+	HEADER_ACC_GYRO			= 0x68,		/* Acc/Gyro Data */
+	HEADER_FIFO_EMPTY		= 0x80,		/* Acc/Gyro Data FIFO Empty */
+} ACC_GYRO_SEND_HEADER;
+
+/* Struct ----------------------------------------------------------------*/
+/* ACC/Gyro Data Information */
+typedef struct _acc_gyro_data_info
+{
+	int16_t acc_x_data;
+	int16_t acc_y_data;
+	int16_t acc_z_data;
+	int16_t gyro_x_data;
+	int16_t gyro_y_data;
+	int16_t gyro_z_data;
+	uint16_t timestamp;
+	uint16_t sid;			/* 2020.12.07 Add */
+	int8_t temperature;
+	uint8_t header;
+} ACC_GYRO_DATA_INFO;
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief FIFO PacketをDecodeする
+ * @param p_fifo FIFO Packet (ACC_GYRO_FIFO_PACKET_SIZE byte)
+ * @param mode 現在の動作モード (ACC_GYRO_EXEC_MODE)
+ * @param acc_gyro_info 格納先 (sidは変更しない)
+ * @retval ACC_GYRO_DATA_COMPLETE 格納するData
+ * @retval 0 格納しない (FIFO Empty/Gyroが無効なData)
+ */
+uint32_t AccGyroFifoDecode( const uint8_t *p_fifo, uint8_t mode, ACC_GYRO_DATA_INFO *acc_gyro_info );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
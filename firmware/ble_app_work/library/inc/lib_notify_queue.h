@@ -0,0 +1,124 @@
+/**
+  ******************************************************************************************
+  * @file    lib_notify_queue.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   BLE Notify Queue (TX Complete駆動の送信Queue)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         送信Byte数の統計情報を追加(BLE Profileで使用)
+  * 1.2            2026/10/19       k.tashiro         Connection Handle取得をInit時に登録, 最新値のみ送信するNotify(Coalesce)を追加
+                                                      definition.hはlib_notify_queue.cでIncludeする (Badge main.cの定義と衝突するため)
+  ******************************************************************************************
+*/
+
+#ifndef LIB_NOTIFY_QUEUE_H_
+#define LIB_NOTIFY_QUEUE_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_gatts.h"
+#include "sdk_config.h"
+
+/* Definition ------------------------------------------------------------*/
+/* 1 Notifyの最大Payload (ATT MTU - ATT Header(3byte)) */
+#define NOTIFY_QUEUE_DATA_MAX		(NRF_SDH_BLE_GATT_MAX_MTU_SIZE - 3)
+
+/* Struct ----------------------------------------------------------------*/
+/* Notify Queue 統計情報 */
+typedef struct _notify_queue_stats
+{
+	uint32_t send_count;		/* SoftDeviceに渡した数 */
+	uint32_t send_bytes;		/* SoftDeviceに渡したPayloadの合計 [byte] */
+	uint32_t queue_count;		/* SoftDevice Queue Fullのため保持した数 */
+	uint32_t coalesce_count;	/* 保持中の最新値Notifyを上書きした数 */
+	uint32_t drop_full_count;	/* Notify Queue Fullで破棄した数 */
+	uint32_t drop_err_count;	/* SoftDeviceがErrorを返したため破棄した数 */
+	uint32_t tx_cmpl_count;		/* TX Completeで送信完了した数 */
+	uint8_t  depth;				/* 現在のQueue数 */
+	uint8_t  depth_max;			/* 最大Queue数 */
+} NOTIFY_QUEUE_STATS, *PNOTIFY_QUEUE_STATS;
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief Notify Queue Initialize
+ * @param get_conn_handle 接続中のConnection Handle取得 (未接続時はBLE_CONN_HANDLE_INVALID)
+ * @retval None
+ */
+void NotifyQueueInit( void (*get_conn_handle)( uint16_t *p_conn_handle ) );
+
+/**
+ * @brief Notify送信 (Payloadはコピーするため呼び出し元のBufferは再利用可)
+ * @remark SoftDevice Queueが空いていればすぐに送信し、Fullの場合はNotify Queueに保持して
+ *         BLE_GATTS_EVT_HVN_TX_COMPLETEで送信する. 送信順序は保持する
+ * @param handle Characteristic Value Handle
+ * @param p_data Payload
+ * @param len Payload Size
+ * @retval NRF_SUCCESS 送信 or Queueに保持した
+ * @retval NRF_ERROR_NO_MEM Queue Full (呼び出し元は送信を控える)
+ * @retval NRF_ERROR_INVALID_STATE 未接続
+ * @retval NRF_ERROR_DATA_SIZE Payload Size Error
+ * @retval その他 sd_ble_gatts_hvxのError
+ */
+uint32_t NotifyQueueSend( uint16_t handle, const uint8_t *p_data, uint16_t len );
+
+/**
+ * @brief Notify送信 (ble_gatts_hvx_params_t指定)
+ * @param p_param Notify Parameter (handle / p_data / p_lenを使用)
+ * @retval NotifyQueueSendと同じ
+ */
+uint32_t NotifyQueueSendParam( const ble_gatts_hvx_params_t *p_param );
+
+/**
+ * @brief 最新値のみ意味を持つNotify送信 (Coalesce)
+ * @remark Queue末尾が同じHandleの本関数で保持したNotifyの場合はPayloadを上書きする.
+ *         NotifyQueueSendで保持したNotifyは上書きしないため, Eventの送信順序と内容は保持する
+ * @param handle Characteristic Value Handle
+ * @param p_data Payload
+ * @param len Payload Size
+ * @retval NotifyQueueSendと同じ
+ */
+uint32_t NotifyQueueSendLatest( uint16_t handle, const uint8_t *p_data, uint16_t len );
+
+/**
+ * @brief Notify QueueをSoftDeviceへ送信 (BLE_GATTS_EVT_HVN_TX_COMPLETE時に呼び出す)
+ * @param tx_count TX Completeで完了した数 (TX Complete以外から呼び出す場合は0)
+ * @retval None
+ */
+void NotifyQueueDrain( uint8_t tx_count );
+
+/**
+ * @brief Notify Queueが一杯かどうかを取得
+ * @param None
+ * @retval true Queue Full
+ * @retval false 空きあり
+ */
+bool NotifyQueueIsFull( void );
+
+/**
+ * @brief Notify Queueをクリア (切断時)
+ * @param None
+ * @retval None
+ */
+void NotifyQueueClear( void );
+
+/**
+ * @brief Notify Queue 統計情報を取得
+ * @param p_stats 統計情報格納先
+ * @retval None
+ */
+void NotifyQueueGetStats( NOTIFY_QUEUE_STATS *p_stats );
+
+/**
+ * @brief Notify Queue 統計情報 Debug Log
+ * @param None
+ * @retval None
+ */
+void DebugNotifyQueueStatsLog( void );
+
+#endif
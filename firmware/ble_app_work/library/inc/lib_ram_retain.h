@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/14       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         walk_algo.hのInclude名を実Fileに合わせる (Host Build)
   ******************************************************************************************
 */
 
@@ -28,7 +29,7 @@
 #include "lib_timer.h"
 #include "lib_ex_rtc.h"
 #include "algo_acc.h"
-#include "Walk_Algo.h"
+#include "walk_algo.h"
 #include "daily_log.h"
 #include "definition.h"
 
@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/28       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         lib_halを使用する (Host Build対応)
   ******************************************************************************************
 */
 
@@ -17,7 +18,8 @@
 #define LIB_SPI_FUNCTION_H_
 
 /* Includes --------------------------------------------------------------*/
-#include "nrf_drv_spi.h"
+#include <stdint.h>
+#include "lib_hal.h"		/* 2026.10.19 Modify nrf_drv_spi -> lib_hal */
 
 #ifdef __cplusplus
 extern "C"{
@@ -34,7 +36,7 @@ extern "C"{
  * @retval NRF_SUCCESS以外 Failed
  */
 //nrfx_err_t spi_init(void);
-nrfx_err_t SpiInit(void);
+uint32_t SpiInit(void);
 
 /**
  * @brief Uninitialize SPI Function
@@ -52,7 +54,7 @@ void SpiUninit(void);
  * @retval None
  */
 //nrfx_err_t spi_IO_write(uint8_t regAddr, uint8_t *pInData, uint8_t dataSize);
-nrfx_err_t SpiIOWrite(uint8_t regAddr, uint8_t *pInData, uint8_t dataSize);
+uint32_t SpiIOWrite(uint8_t regAddr, uint8_t *pInData, uint8_t dataSize);
 
 /**
  * @brief SPI Read
@@ -63,7 +65,7 @@ nrfx_err_t SpiIOWrite(uint8_t regAddr, uint8_t *pInData, uint8_t dataSize);
  * @retval NRF_ERROR_BUSY Busy
  */
 //nrfx_err_t spi_IO_read(uint8_t regAddr, uint8_t *pOutData, uint8_t dataSize);
-nrfx_err_t SpiIORead(uint8_t regAddr, uint8_t *pOutData, uint8_t dataSize);
+uint32_t SpiIORead(uint8_t regAddr, uint8_t *pOutData, uint8_t dataSize);
 
 /**
  * @brief SPI Error Check
@@ -71,7 +73,7 @@ nrfx_err_t SpiIORead(uint8_t regAddr, uint8_t *pOutData, uint8_t dataSize);
  * @param line LINE Number
  * @retval None
  */
-void SpiErrCheck(nrfx_err_t err, uint16_t line);
+void SpiErrCheck(uint32_t err, uint16_t line);
 
 #ifdef __cplusplus
 }
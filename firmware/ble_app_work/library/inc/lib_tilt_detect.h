@@ -0,0 +1,134 @@
+/**
+  ******************************************************************************************
+  * @file    lib_tilt_detect.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Tilt / Fall Detection (Hysteresis + Debounce)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+#ifndef LIB_TILT_DETECT_H_
+#define LIB_TILT_DETECT_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*
+ * SDKに依存しないため, PCでもBuildしてSampleの記録を再生して評価できる
+ *
+ * 傾き判定 : 倒れた時に重力が向く軸(axis)と加速度の向きのcosを直近TILT_DETECT_WINDOW個で平均し,
+ *            tilt_enter以上でTILT, tilt_exit以下でSTAND (Hysteresis).
+ *            判定が変わった状態がdebounce_ms以上続いた時点で確定する
+ * 転倒判定 : freefall_g未満がfreefall_ms以上続いた後, impact_window_ms以内にimpact_gを超えたらFALL.
+ *            FALLはDebounceせずに即時通知する
+ */
+
+/* Definition ------------------------------------------------------------*/
+#define TILT_DETECT_WINDOW			(4)			/* 傾き判定の平均Sample数 */
+#define TILT_DETECT_GAP_MS			(100)		/* これ以上Sample間隔が空いたら平均をやり直す [ms] */
+#define TILT_DETECT_STATIC_MIN_G	(0.5f)		/* 傾き判定に使う加速度の大きさの範囲 (衝撃/落下中は除外) [g] */
+#define TILT_DETECT_STATIC_MAX_G	(1.5f)
+
+/* Enum ------------------------------------------------------------------*/
+/* 傾き状態 */
+typedef enum
+{
+	TILT_STATE_INIT = 0,		/* 未判定 */
+	TILT_STATE_STAND,			/* 正常 */
+	TILT_STATE_TILT,			/* 傾いている(倒れている) */
+} TILT_STATE;
+
+/* 検出Event */
+typedef enum
+{
+	TILT_EVT_NONE = 0,			/* 変化なし */
+	TILT_EVT_STAND,				/* STANDに変化 */
+	TILT_EVT_TILT,				/* TILTに変化 */
+	TILT_EVT_FALL,				/* 落下 + 衝撃を検出 */
+} TILT_EVT;
+
+/* Struct ----------------------------------------------------------------*/
+/* 取付角度補正後の加速度 (AccAngle.hのACC_RESULTと同じ並び) */
+typedef struct _tilt_acc
+{
+	int16_t x;
+	int16_t y;
+	int16_t z;
+} TILT_ACC;
+
+/* 取付角度補正 (AccAngle.cを組み込むBuildではcalc_acc_rotを呼び出す関数を登録する) */
+typedef void (*TILT_ROT_FUNC)( int16_t x, int16_t y, int16_t z, TILT_ACC *p_result );
+
+/* 設定 */
+typedef struct _tilt_detect_config
+{
+	float axis[3];				/* 倒れた時に重力が向く軸 (単位ベクトル) */
+	float tilt_enter;			/* cosがこれ以上でTILT */
+	float tilt_exit;			/* cosがこれ以下でSTAND (tilt_enterより小さくする) */
+	uint16_t debounce_ms;		/* 傾き判定の確定時間 [ms] */
+	uint16_t lsb_per_g;			/* 加速度の分解能 [LSB/g] */
+	float freefall_g;			/* 落下判定 [g] */
+	uint16_t freefall_ms;		/* 落下判定の継続時間 [ms] */
+	float impact_g;				/* 衝撃判定 [g] */
+	uint16_t impact_window_ms;	/* 落下後に衝撃を待つ時間 [ms] */
+	TILT_ROT_FUNC rot_func;		/* 取付角度補正 (NULL:補正なし) */
+} TILT_DETECT_CONFIG, *PTILT_DETECT_CONFIG;
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief 初期設定値を取得
+ * @param p_config 設定格納先
+ * @retval None
+ */
+void TiltDetectGetDefaultConfig( TILT_DETECT_CONFIG *p_config );
+
+/**
+ * @brief Tilt Detect Initialize
+ * @param p_config 設定 (NULLの場合は初期設定値)
+ * @retval None
+ */
+void TiltDetectInit( const TILT_DETECT_CONFIG *p_config );
+
+/**
+ * @brief 加速度Sampleを入力して判定
+ * @param x ACC_X [LSB]
+ * @param y ACC_Y [LSB]
+ * @param z ACC_Z [LSB]
+ * @param time_ms Sample時刻 [ms]
+ * @retval TILT_EVT_NONE 変化なし
+ * @retval TILT_EVT_STAND / TILT_EVT_TILT 傾き状態が確定した
+ * @retval TILT_EVT_FALL 転倒を検出した
+ */
+TILT_EVT TiltDetectInput( int16_t x, int16_t y, int16_t z, uint32_t time_ms );
+
+/**
+ * @brief 現在の傾き状態を取得
+ * @param None
+ * @retval 傾き状態
+ */
+TILT_STATE TiltDetectGetState( void );
+
+/**
+ * @brief 判定途中かどうかを取得 (判定途中はSamplingを続ける)
+ * @param None
+ * @retval true 判定途中 (Debounce中 / 落下中 / 衝撃待ち)
+ * @retval false 判定途中ではない
+ */
+bool TiltDetectIsBusy( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/15       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         BLE Profile Bulk Hold Timerを追加
   ******************************************************************************************
 */
 
@@ -50,8 +51,12 @@ typedef enum
 	ACK_PIN_TIMER_STOP_ERROR,
 	/* 2022.06.03 Add RSSI通知 ++ */
 	RSSI_NOTIFY_TIMER_START_ERROR,
-	RSSI_NOTIFY_TIMER_STOP_ERROR
+	RSSI_NOTIFY_TIMER_STOP_ERROR,
 	/* 2022.06.03 Add RSSI通知 -- */
+	/* 2026.10.19 Add BLE Profile ++ */
+	BLE_PROFILE_TIMER_START_ERROR,
+	BLE_PROFILE_TIMER_STOP_ERROR
+	/* 2026.10.19 Add BLE Profile -- */
 } TIEMR_ERROR_EVENT;
 
 /* Function prototypes ----------------------------------------------------*/
@@ -262,6 +267,15 @@ void StartRssiNotifyTimer(void);
 void StopRssiNotifyTimer(void);
 /* 2022.06.03 Add RSSI通知 -- */
 
+/* 2026.10.19 Add BLE Profile ++ */
+/**
+ * @brief Restart BLE Profile Bulk Hold Timer
+ * @param None
+ * @retval None
+ */
+void RestartBleProfileBulkTimer(void);
+/* 2026.10.19 Add BLE Profile -- */
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************************
+  * @file    lib_token_log.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Token Log (Message ID + 引数だけを記録するBinary Log)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+#ifndef LIB_TOKEN_LOG_H_
+#define LIB_TOKEN_LOG_H_
+
+/* Includes --------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "lib_token_log_msg.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/* Definition ------------------------------------------------------------*/
+#ifndef TOKEN_LOG_ENABLED
+#define TOKEN_LOG_ENABLED			(1)			/* 0: TOKEN_LOGxを空にする */
+#endif
+#ifndef TOKEN_LOG_RING_WORDS
+#define TOKEN_LOG_RING_WORDS		(256)		/* RAM Ring Size [word] (2のべき乗) */
+#endif
+#define TOKEN_LOG_ARG_MAX			(6)			/* 引数の最大数 */
+#define TOKEN_LOG_SYNC				(0xA5U)		/* Record Header下位8bit (Headerが0にならないようにする) */
+#define TOKEN_LOG_HEADER_WORDS		(2)			/* Header + Timestamp */
+#define TOKEN_LOG_FRAME_MAX			( ( ( TOKEN_LOG_HEADER_WORDS + TOKEN_LOG_ARG_MAX ) * 4 ) + 1 )	/* 出力Frame最大Size [byte] */
+
+/*
+ * Record (RAM Ring / 出力Frame共通, Little Endian)
+ *  word0 : [31:16] Message ID, [15:8] 引数の数, [7:0] TOKEN_LOG_SYNC
+ *  word1 : Timestamp (app_timer Counter)
+ *  word2~: 引数
+ * 出力Frameは Record + Checksum(1byte: 全ByteのXOR)
+ */
+#define TOKEN_LOG_HEADER( id, num )	( ( (uint32_t)(id) << 16 ) | ( (uint32_t)(num) << 8 ) | TOKEN_LOG_SYNC )
+
+#if TOKEN_LOG_ENABLED
+#define TOKEN_LOG0( id )							TokenLogWrite( (id), 0, NULL )
+#define TOKEN_LOG1( id, a1 )						\
+	do { const uint32_t _tl_arg[] = { (uint32_t)(a1) }; TokenLogWrite( (id), 1, _tl_arg ); } while(0)
+#define TOKEN_LOG2( id, a1, a2 )					\
+	do { const uint32_t _tl_arg[] = { (uint32_t)(a1), (uint32_t)(a2) }; TokenLogWrite( (id), 2, _tl_arg ); } while(0)
+#define TOKEN_LOG3( id, a1, a2, a3 )				\
+	do { const uint32_t _tl_arg[] = { (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3) }; TokenLogWrite( (id), 3, _tl_arg ); } while(0)
+#define TOKEN_LOG4( id, a1, a2, a3, a4 )			\
+	do { const uint32_t _tl_arg[] = { (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3), (uint32_t)(a4) }; TokenLogWrite( (id), 4, _tl_arg ); } while(0)
+#define TOKEN_LOG5( id, a1, a2, a3, a4, a5 )		\
+	do { const uint32_t _tl_arg[] = { (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3), (uint32_t)(a4), (uint32_t)(a5) }; TokenLogWrite( (id), 5, _tl_arg ); } while(0)
+#define TOKEN_LOG6( id, a1, a2, a3, a4, a5, a6 )	\
+	do { const uint32_t _tl_arg[] = { (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3), (uint32_t)(a4), (uint32_t)(a5), (uint32_t)(a6) }; TokenLogWrite( (id), 6, _tl_arg ); } while(0)
+#else
+#define TOKEN_LOG0( id )							do { } while(0)
+#define TOKEN_LOG1( id, a1 )						do { } while(0)
+#define TOKEN_LOG2( id, a1, a2 )					do { } while(0)
+#define TOKEN_LOG3( id, a1, a2, a3 )				do { } while(0)
+#define TOKEN_LOG4( id, a1, a2, a3, a4 )			do { } while(0)
+#define TOKEN_LOG5( id, a1, a2, a3, a4, a5 )		do { } while(0)
+#define TOKEN_LOG6( id, a1, a2, a3, a4, a5, a6 )	do { } while(0)
+#endif
+
+/* float引数 (%f) はBit列のまま渡す */
+#define TOKEN_LOG_FLOAT( f )		TokenLogFloat( (float)(f) )
+
+/* Typedef ---------------------------------------------------------------*/
+/* 出力先 (Frame単位で呼び出す) */
+typedef void (*TOKEN_LOG_SINK)( const uint8_t *p_data, uint16_t length );
+
+/* Struct ----------------------------------------------------------------*/
+/* Token Log 統計情報 */
+typedef struct _token_log_stats
+{
+	uint32_t write_count;		/* Ringに書き込んだRecord数 */
+	uint32_t drop_count;		/* Ring Fullで破棄したRecord数 */
+	uint32_t out_count;			/* 出力したRecord数 */
+	uint16_t depth_max;			/* Ring使用量の最大 [word] */
+} TOKEN_LOG_STATS, *PTOKEN_LOG_STATS;
+
+/* Function prototypes ----------------------------------------------------*/
+/**
+ * @brief Token Log Initialize
+ * @param sink 出力先 (NULLの場合はTokenLogProcessで破棄する)
+ * @retval None
+ */
+void TokenLogInit( TOKEN_LOG_SINK sink );
+
+/**
+ * @brief Token Log書き込み (割り込みからも呼び出し可. Lockなし)
+ * @remark 書式の整形は行わずMessage IDと引数をRAM Ringへコピーするだけ.
+ *         Ring Fullの場合は破棄して件数を数え, 次回出力時にTL_TOKEN_LOG_DROPとして出力する
+ * @param id Message ID
+ * @param num 引数の数 (TOKEN_LOG_ARG_MAX以下)
+ * @param p_arg 引数
+ * @retval None
+ */
+void TokenLogWrite( uint16_t id, uint8_t num, const uint32_t *p_arg );
+
+/**
+ * @brief RAM RingのRecordを出力先へ送る (Main Loopから呼び出す)
+ * @param None
+ * @retval true 出力した
+ * @retval false 出力するRecordなし
+ */
+bool TokenLogProcess( void );
+
+/**
+ * @brief Token Log 統計情報を取得
+ * @param p_stats 統計情報格納先
+ * @retval None
+ */
+void TokenLogGetStats( TOKEN_LOG_STATS *p_stats );
+
+/**
+ * @brief float引数をBit列に変換
+ * @param value 値
+ * @retval Bit列
+ */
+static inline uint32_t TokenLogFloat( float value )
+{
+	uint32_t bits;
+
+	memcpy( &bits, &value, sizeof( bits ) );
+	return bits;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,56 @@
+/**
+  ******************************************************************************************
+  * @file    lib_token_log_msg.h
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Token Log Message Table
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         TL_ACC_WOM_INTを追加
+  * 1.2            2026/10/19       k.tashiro         TL_ALGO_ACTIVITYを追加
+  ******************************************************************************************
+*/
+
+#ifndef LIB_TOKEN_LOG_MSG_H_
+#define LIB_TOKEN_LOG_MSG_H_
+
+/*
+ * Message ID と Format文字列の対応表
+ *  - Firmwareには Message ID(enum) だけが入り、Format文字列は入らない
+ *  - tools/token_log_decode.py がこのFileを読んで文字列Tableを生成し、PC側で整形する
+ *  - Message IDは並び順で決まるため、追加は末尾に行う (途中への追加/削除は旧Logの解析がずれる)
+ *  - 引数は最大TOKEN_LOG_ARG_MAX個の32bit値. 使用できる書式は %d %u %x %X %c %f (%fはTOKEN_LOG_FLOATで渡す)
+ */
+#define TOKEN_LOG_MSG_TABLE																			\
+	TOKEN_LOG_MSG( TL_TOKEN_LOG_DROP,		"token log drop %u" )										\
+	TOKEN_LOG_MSG( TL_ACC_INT1,				"Interrupt Encountered" )									\
+	TOKEN_LOG_MSG( TL_WALK_TELEP_SAMPLE,	"telep %u, afacc %d, acc %d" )								\
+	TOKEN_LOG_MSG( TL_WALK_SIDE_SAMPLE,		"side  %u, afacc %d, acc %d" )								\
+	TOKEN_LOG_MSG( TL_WALK_DAILY_SAMPLE,	"daily  %u, afacc %d, acc %d" )								\
+	TOKEN_LOG_MSG( TL_WALK_MODE_SAMPLE,		"mode %u, sid %u, afacc %d, acc %d" )						\
+	TOKEN_LOG_MSG( TL_WALK_TAP_SAMPLE,		"tap sid %u, afacc %d, acc %d" )							\
+	TOKEN_LOG_MSG( TL_ALGO_ACC_DATA,		"acc data %d, x %d, y %d, z %d" )							\
+	TOKEN_LOG_MSG( TL_ALGO_ANGLE_ADJUST,	"roll: %f, pitch: %f, yaw: %f" )							\
+	TOKEN_LOG_MSG( TL_ALGO_PRE_SLEEP_ACC,	"acc data %u, x %d, y %d, z %d, %u" )						\
+	TOKEN_LOG_MSG( TL_ALGO_ADV_ACC,			"acc data %u, tm %x, x %d, y %d, z %d, %u" )				\
+	TOKEN_LOG_MSG( TL_ACC_ANGLE_STATE,		"state: %d roll: %f, pitch: %f" )							\
+	TOKEN_LOG_MSG( TL_GW_BLE_EVT,			"ble_evt_handler evt 0x%x" )								\
+	TOKEN_LOG_MSG( TL_GW_ADV_REPORT,		"BLE_GAP_EVT_ADV_REPORT rssi %d len %u" )					\
+	TOKEN_LOG_MSG( TL_GW_SCAN_RESTART_ERR,	"scan restart err=0x%x" )									\
+	TOKEN_LOG_MSG( TL_ACC_WOM_INT,			"Wake On Motion" )											\
+	TOKEN_LOG_MSG( TL_ALGO_ACTIVITY,		"activity sid %u, class %u, energy %d, peak interval %d" )
+
+/* Message ID */
+typedef enum
+{
+#define TOKEN_LOG_MSG( id, fmt )	id,
+	TOKEN_LOG_MSG_TABLE
+#undef TOKEN_LOG_MSG
+	TOKEN_LOG_MSG_NUM
+} TOKEN_LOG_MSG_ID;
+
+#endif
@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/10       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Trace Journal(2ページ循環の追記型Flash Log)を追加
   ******************************************************************************************
 */
 
@@ -18,6 +19,7 @@
 
 /* Includes --------------------------------------------------------------*/
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include "lib_common.h"
 
@@ -36,6 +38,16 @@
 #define RESET_REASON_SIZE			(104)	/* Reset Reason Size */
 #define RESET_REASON_DATA_SIZE		(10)	/* Reset Reason Data Size */
 
+/* 2026.10.19 Add Trace Journal ++ */
+#define TRACE_JOURNAL_START_ADDR	TRACE_JOURNAL_ADDR												/* Start Address */
+#define TRACE_JOURNAL_END_ADDR		( TRACE_JOURNAL_ADDR + ( TRACE_JOURNAL_PAGE_SIZE * TRACE_JOURNAL_PAGE_NUM ) - 1 )	/* End Address */
+#define TRACE_JOURNAL_MAGIC			(0x314A5254U)	/* "TRJ1" */
+#define TRACE_JOURNAL_HEADER_SIZE	(16)			/* Page Header Size */
+#define TRACE_JOURNAL_ENTRY_SIZE	(8)				/* Entry Size */
+#define TRACE_JOURNAL_ENTRY_NUM		( ( TRACE_JOURNAL_PAGE_SIZE - TRACE_JOURNAL_HEADER_SIZE ) / TRACE_JOURNAL_ENTRY_SIZE )	/* 1 PageのEntry数: 510 */
+#define TRACE_JOURNAL_BATCH_SIZE	(TRACE_LOG_SIZE)	/* 1回のFlushで書き込む最大Entry数 (欠落マーカー + RAM Ring) */
+/* 2026.10.19 Add Trace Journal -- */
+
 #define TRACE_DATA_INITIAL_VAL		(0xFF)
 
 #define TRACE_DATA_SIG_PRIMARY		(0xDD)
@@ -71,13 +83,18 @@ typedef struct _trace_log_info {
 	uint16_t param;					/* Param: 2byte */
 } TRACE_LOG_INFO;
 
-/* Trace Data Total: 204byte [2byte + 4byte + 6byte + (6 * 32)byte] */
+/* Trace Data Total: 202byte [2byte + 2byte + 2byte + (6 * 32)byte + 4byte] */
+/* 2026.10.19 Modify DAILY_DATA_RAMSAVE_ADDRESS(0x2000FECC)までの空き(6byte)に収まるようCounterは16bitとする */
 typedef struct _trace_data {
 	uint8_t signiture[SIGNITURE_SIZE];				/* 2byte */
 	uint8_t trace_log_sig[SIGNITURE_SIZE];			/* 2byte */
 	uint8_t trace_log_count;						/* 1byte */
 	uint8_t trace_log_id;							/* 1byte */
 	TRACE_LOG_INFO trace_data[TRACE_LOG_SIZE];		/* 6byte * 32: 192byte */
+	/* 2026.10.19 Add Trace Journal ++ */
+	uint16_t trace_log_total;						/* 2byte: TraceLogした総数 (下位16bit) */
+	uint16_t trace_log_flushed;						/* 2byte: Trace Journalへ書き込んだ総数 (下位16bit) */
+	/* 2026.10.19 Add Trace Journal -- */
 } TRACE_DATA;
 
 /* Trace Data Information */
@@ -85,6 +102,34 @@ typedef struct _trace_data_info {
 	uint32_t trace_index;
 } TRACE_DATA_INFO;
 
+/* 2026.10.19 Add Trace Journal ++ */
+/* Trace Journal Page Header: 16byte (Pageの先頭) */
+typedef struct _trace_journal_header {
+	uint32_t magic;					/* TRACE_JOURNAL_MAGIC */
+	uint32_t page_seq;				/* Page書き込み順 (Rotate毎に+1) */
+	uint32_t first_seq;				/* Pageの先頭EntryのSequence No */
+	uint32_t check;					/* ~( magic ^ page_seq ^ first_seq ) */
+} TRACE_JOURNAL_HEADER;
+
+/* Trace Journal Entry: 8byte (Erase状態(0xFF)はcheck不一致で無効) */
+typedef struct _trace_journal_entry {
+	uint16_t seq;					/* Sequence No (下位16bit) */
+	uint16_t func_no;				/* Function No */
+	uint16_t param;					/* Param */
+	uint8_t nested_interrupt;		/* Nested Interrupt */
+	uint8_t check;					/* ~( 先頭7byteのXOR ) */
+} TRACE_JOURNAL_ENTRY;
+
+/* Trace Journal Information */
+typedef struct _trace_journal_info {
+	bool mounted;					/* Page Scan済み */
+	uint8_t page;					/* 書き込み中のPage */
+	uint16_t slot;					/* 次に書き込むEntry位置 */
+	uint32_t page_seq;				/* 書き込み中PageのPage Seq */
+	uint32_t next_seq;				/* 次に書き込むEntryのSequence No */
+} TRACE_JOURNAL_INFO;
+/* 2026.10.19 Add Trace Journal -- */
+
 
 /* Function prototypes -------------------------------------------*/
 /**
@@ -104,10 +149,13 @@ void TraceLog( uint16_t func_no, uint16_t param );
 
 /**
  * @brief Trace Log Flush
- * @remark FlashへReset Reasonを書き込む
- * @param reason Reset Reason
+ * @remark 前回Flush以降に追加されたTrace LogだけをTrace Journalへ追記する (RTC取得/Page Readなし)
+ *         割り込み中はFlash完了を待てないためNRF_ERROR_INVALID_STATEを返す.
+ *         未書き込みのTrace LogはRetained RAMに残り, Reset後のFlushで書き込まれる
+ * @param None
  * @retval NRF_SUCCESS Success
- * @retval NRF_SUCCESS以外 エラー
+ * @retval NRF_ERROR_INVALID_STATE 割り込み中 or TraceLogInit前
+ * @retval 上記以外 fstorageのエラー
  */
 ret_code_t TraceFlush( void );
 
@@ -2,7 +2,7 @@
   ******************************************************************************************
   * @file    lib_adc.c
   * @author  k.tashiro
-  * @version 1.0
+  * @version 1.2
   * @date    2022/01/15
   * @brief   SAADC Control
   ******************************************************************************************
@@ -10,6 +10,8 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2022/01/15       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         電池電圧の常時監視(RTC2 -> PPI -> SAADC EasyDMA)を追加
+  * 1.2            2026/10/19       k.tashiro         電池電圧監視の割込みをEnergy Profilerに通知
   ******************************************************************************************
 */
 
@@ -20,6 +22,13 @@
 #include "nrf_log_default_backends.h"
 #include "nrf_drv_saadc.h"
 #include "nrfx_saadc.h"
+/* 2026.10.19 Add 電池電圧監視 ++ */
+#include "nrf_drv_ppi.h"
+#include "nrf_drv_rtc.h"
+#include "app_error.h"
+#include "sdk_macros.h"
+#include "lib_energy_prof.h"
+/* 2026.10.19 Add 電池電圧監視 -- */
 //#include "state_control.h"
 //#include "lib_fifo.h"
 //#include "lib_bat.h"
@@ -37,6 +46,16 @@
 
 #define ANALOG_BH_BAT	0
 
+/* 2026.10.19 Add 電池電圧監視 ++ */
+#define BAT_MON_RTC_PRESCALER	(4095)		/* 32768 / 4096 = 8Hz (125ms) */
+#define BAT_MON_RTC_TICK_MS		(125)
+#define BAT_MON_RTC_CC			(0)
+#define BAT_MON_FULL_SCALE_MV	(3600)		/* Gain 1/6, Reference 0.6V */
+#define BAT_MON_ADC_MAX			(4096)		/* 12bit */
+#define BAT_MON_FILTER_SHIFT	(2)			/* IIR係数 1/4 */
+#define BAT_MON_SOC_RECOVER		(10)		/* 残量がこれ以上増えたら電池交換とみなす [%] */
+/* 2026.10.19 Add 電池電圧監視 -- */
+
 /* Private variables ------------------------------------------------------*/
 #if USE_BAT_FIFIO
 volatile nrf_saadc_value_t g_adc_buffer[2][SAMPLES_IN_BUFFER];
@@ -48,6 +67,34 @@ static ret_code_t analog_startup_get_val( int32_t *adc_value );
 
 volatile int32_t bat_level_mv = 0;	
 
+/* 2026.10.19 Add 電池電圧監視 ++ */
+/* 残量推定Table (3V Lithium一次電池, 無負荷に近い電圧) */
+typedef struct _bat_soc_point
+{
+	uint16_t mv;
+	uint8_t soc;
+} BAT_SOC_POINT;
+
+static const BAT_SOC_POINT g_bat_soc_table[] =
+{
+	{ 3000, 100 },
+	{ 2900,  80 },
+	{ 2800,  60 },
+	{ 2700,  40 },
+	{ 2600,  20 },
+	{ 2500,  10 },
+	{ THRESHOLD_BAT_VOLT, 0 },
+};
+
+static const nrf_drv_rtc_t g_bat_mon_rtc = NRF_DRV_RTC_INSTANCE( 2 );
+static nrf_saadc_value_t g_bat_mon_buffer[2][BAT_MON_SAMPLES];
+static nrf_ppi_channel_t g_bat_mon_ppi;
+static bool g_bat_mon_running = false;
+static uint32_t g_bat_mon_filter = 0;					/* Filter後の電圧 [mV << 4] */
+static volatile uint16_t g_bat_mon_mv = BAT_MON_INVALID_MV;
+static volatile uint8_t g_bat_mon_soc = 0;
+/* 2026.10.19 Add 電池電圧監視 -- */
+
 /**
  * @brief SAADC Event Handler
  * @param pAdcEvent SAADC Event Information
@@ -300,6 +347,13 @@ float AnalogVoltageOneshot(void)
 	int32_t bat_volt = 0;
 	float voltage = 0;
 
+	/* 2026.10.19 Add 監視中はSAADCを使用しているためFilter後の値を返す ++ */
+	if ( g_bat_mon_running == true )
+	{
+		return (float)AnalogGetBatteryMv() / 1000.0f;
+	}
+	/* 2026.10.19 Add 監視中はSAADCを使用しているためFilter後の値を返す -- */
+
 	err_code = analog_startup_init();
 	if ( err_code == NRF_SUCCESS )
 	{
@@ -315,3 +369,218 @@ float AnalogVoltageOneshot(void)
 #endif
 }
 
+/* 2026.10.19 Add 電池電圧監視 ++ */
+/**
+ * @brief 電圧から電池残量を推定
+ * @param mv 電池電圧 [mV]
+ * @retval 電池残量 [%]
+ */
+static uint8_t analog_monitor_soc( uint16_t mv )
+{
+	uint8_t i;
+	const BAT_SOC_POINT *p_hi;
+	const BAT_SOC_POINT *p_lo;
+
+	if ( mv >= g_bat_soc_table[0].mv )
+	{
+		return g_bat_soc_table[0].soc;
+	}
+	for ( i = 1; i < ( sizeof( g_bat_soc_table ) / sizeof( g_bat_soc_table[0] ) ); i++ )
+	{
+		if ( mv >= g_bat_soc_table[i].mv )
+		{
+			/* 直線補間 */
+			p_hi = &g_bat_soc_table[i - 1];
+			p_lo = &g_bat_soc_table[i];
+			return (uint8_t)( p_lo->soc + ( ( mv - p_lo->mv ) * ( p_hi->soc - p_lo->soc ) ) / ( p_hi->mv - p_lo->mv ) );
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief 平均電圧をFilterして残量を更新
+ * @param mv 平均電圧 [mV]
+ * @retval None
+ */
+static void analog_monitor_update( uint32_t mv )
+{
+	uint8_t soc;
+	bool first;
+
+	first = ( g_bat_mon_mv == BAT_MON_INVALID_MV );
+	if ( first == true )
+	{
+		/* 初回はそのまま採用 */
+		g_bat_mon_filter = mv << 4;
+	}
+	else
+	{
+		g_bat_mon_filter = g_bat_mon_filter - ( g_bat_mon_filter >> BAT_MON_FILTER_SHIFT ) + ( ( mv << 4 ) >> BAT_MON_FILTER_SHIFT );
+	}
+	g_bat_mon_mv = (uint16_t)( g_bat_mon_filter >> 4 );
+
+	/* 一次電池は回復しないため, 無線送信中の電圧降下などで残量が増減しないよう減少方向のみ反映する */
+	soc = analog_monitor_soc( g_bat_mon_mv );
+	if ( ( soc < g_bat_mon_soc ) || ( soc >= ( g_bat_mon_soc + BAT_MON_SOC_RECOVER ) ) || ( first == true ) )
+	{
+		g_bat_mon_soc = soc;
+	}
+}
+
+/**
+ * @brief 電池電圧監視 SAADC Event Handler (BAT_MON_SAMPLES毎)
+ * @param p_event SAADC Event Information
+ * @retval None
+ */
+static void analog_monitor_evt_handler( nrf_drv_saadc_evt_t const *p_event )
+{
+	int32_t total = 0;
+	uint16_t i;
+	ret_code_t err_code;
+
+	ENERGY_PROF_WAKE( EP_WAKE_ADC );		/* 2026.10.19 Add */
+	if ( p_event->type != NRF_DRV_SAADC_EVT_DONE )
+	{
+		return;
+	}
+	ENERGY_PROF_ENTER( EP_SUB_SENSOR );		/* 2026.10.19 Add */
+
+	for ( i = 0; i < p_event->data.done.size; i++ )
+	{
+		/* GND付近のNoiseで負になった値は0とする */
+		if ( p_event->data.done.p_buffer[i] > 0 )
+		{
+			total += p_event->data.done.p_buffer[i];
+		}
+	}
+	analog_monitor_update( (uint32_t)( total * BAT_MON_FULL_SCALE_MV / ( (int32_t)p_event->data.done.size * BAT_MON_ADC_MAX ) ) );
+
+	/* 使い終わったBufferを次の転送先に登録 */
+	err_code = nrf_drv_saadc_buffer_convert( p_event->data.done.p_buffer, BAT_MON_SAMPLES );
+	APP_ERROR_CHECK( err_code );
+	ENERGY_PROF_EXIT();						/* 2026.10.19 Add */
+}
+
+/**
+ * @brief RTC2 Event Handler (Compare EventはPPIで処理するため割込みは使わない)
+ * @param int_type 割込み種別
+ * @retval None
+ */
+static void analog_monitor_rtc_handler( nrf_drv_rtc_int_type_t int_type )
+{
+	UNUSED_PARAMETER( int_type );
+}
+
+/**
+ * @brief 電池電圧の監視開始
+ * @param period_ms Sampling周期 [ms]
+ * @retval NRF_SUCCESS Success
+ * @retval NRF_SUCCESS以外 Failed
+ */
+ret_code_t AnalogMonitorStart( uint32_t period_ms )
+{
+	ret_code_t err_code;
+	uint32_t ticks;
+	nrf_drv_saadc_config_t config_saadc = NRFX_SAADC_DEFAULT_CONFIG;
+	nrf_saadc_channel_config_t channel_config = NRF_DRV_SAADC_DEFAULT_CHANNEL_CONFIG_SE( NRF_SAADC_INPUT_AIN3 );
+	nrf_drv_rtc_config_t config_rtc = NRF_DRV_RTC_DEFAULT_CONFIG;
+
+	if ( g_bat_mon_running == true )
+	{
+		return NRF_SUCCESS;
+	}
+
+	/* SAADC : 12bit, 8x Oversample, Burst (1回のSAMPLEで8回変換した平均を1値として転送) */
+	config_saadc.resolution = NRF_SAADC_RESOLUTION_12BIT;
+	config_saadc.oversample = NRF_SAADC_OVERSAMPLE_8X;
+	config_saadc.low_power_mode = false;		/* PPIでSAMPLEするためSTARTは常に済ませておく */
+	channel_config.burst = NRF_SAADC_BURST_ENABLED;
+	err_code = nrf_drv_saadc_init( &config_saadc, analog_monitor_evt_handler );
+	VERIFY_SUCCESS( err_code );
+	err_code = nrf_drv_saadc_channel_init( ANALOG_BH_BAT, &channel_config );
+	VERIFY_SUCCESS( err_code );
+	/* Double Buffer */
+	err_code = nrf_drv_saadc_buffer_convert( g_bat_mon_buffer[0], BAT_MON_SAMPLES );
+	VERIFY_SUCCESS( err_code );
+	err_code = nrf_drv_saadc_buffer_convert( g_bat_mon_buffer[1], BAT_MON_SAMPLES );
+	VERIFY_SUCCESS( err_code );
+
+	/* RTC2 : 8Hz, Compare毎にPPIでCLEARしてperiod_ms周期にする */
+	config_rtc.prescaler = BAT_MON_RTC_PRESCALER;
+	err_code = nrf_drv_rtc_init( &g_bat_mon_rtc, &config_rtc, analog_monitor_rtc_handler );
+	VERIFY_SUCCESS( err_code );
+	ticks = period_ms / BAT_MON_RTC_TICK_MS;
+	if ( ticks == 0 )
+	{
+		ticks = 1;
+	}
+	err_code = nrf_drv_rtc_cc_set( &g_bat_mon_rtc, BAT_MON_RTC_CC, ticks, false );
+	VERIFY_SUCCESS( err_code );
+
+	/* PPI : RTC2 COMPARE[0] -> SAADC SAMPLE, Fork -> RTC2 CLEAR */
+	err_code = nrf_drv_ppi_init();
+	if ( ( err_code != NRF_SUCCESS ) && ( err_code != NRF_ERROR_MODULE_ALREADY_INITIALIZED ) )
+	{
+		return err_code;
+	}
+	err_code = nrf_drv_ppi_channel_alloc( &g_bat_mon_ppi );
+	VERIFY_SUCCESS( err_code );
+	err_code = nrf_drv_ppi_channel_assign( g_bat_mon_ppi,
+										   nrf_drv_rtc_event_address_get( &g_bat_mon_rtc, NRF_RTC_EVENT_COMPARE_0 ),
+										   nrf_drv_saadc_sample_task_get() );
+	VERIFY_SUCCESS( err_code );
+	err_code = nrf_drv_ppi_channel_fork_assign( g_bat_mon_ppi,
+												nrf_drv_rtc_task_address_get( &g_bat_mon_rtc, NRF_RTC_TASK_CLEAR ) );
+	VERIFY_SUCCESS( err_code );
+	err_code = nrf_drv_ppi_channel_enable( g_bat_mon_ppi );
+	VERIFY_SUCCESS( err_code );
+
+	nrf_drv_rtc_enable( &g_bat_mon_rtc );
+	g_bat_mon_running = true;
+
+	return NRF_SUCCESS;
+}
+
+/**
+ * @brief 電池電圧の監視停止
+ * @param None
+ * @retval None
+ */
+void AnalogMonitorStop( void )
+{
+	if ( g_bat_mon_running == false )
+	{
+		return;
+	}
+
+	nrf_drv_rtc_disable( &g_bat_mon_rtc );
+	(void)nrf_drv_ppi_channel_disable( g_bat_mon_ppi );
+	(void)nrf_drv_ppi_channel_free( g_bat_mon_ppi );
+	nrf_drv_rtc_uninit( &g_bat_mon_rtc );
+	(void)nrf_drv_saadc_channel_uninit( ANALOG_BH_BAT );
+	nrf_drv_saadc_uninit();
+	g_bat_mon_running = false;
+}
+
+/**
+ * @brief Filter後の電池電圧を取得 (Blockしない)
+ * @param None
+ * @retval 電池電圧 [mV] (BAT_MON_INVALID_MV:未取得)
+ */
+uint16_t AnalogGetBatteryMv( void )
+{
+	return g_bat_mon_mv;
+}
+
+/**
+ * @brief 電池残量の推定値を取得 (Blockしない)
+ * @param None
+ * @retval 電池残量 [%] (未取得の場合は0)
+ */
+uint8_t AnalogGetBatterySoc( void )
+{
+	return g_bat_mon_soc;
+}
+/* 2026.10.19 Add 電池電圧監視 -- */
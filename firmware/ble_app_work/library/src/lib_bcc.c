@@ -0,0 +1,35 @@
+/**
+  ******************************************************************************************
+  * @file    lib_bcc.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   BCC (Block Check Character)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new (mode_manager.cのbcc_createを移動)
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include "lib_bcc.h"
+
+/**
+ * @brief BCC Create
+ * @param str 計算するデータ
+ * @param len 計算するデータ長
+ * @retval XORデータ
+ */
+uint8_t BccCreate( const uint8_t *str, uint32_t len )
+{
+	uint8_t BCC_Val = 0;
+
+	while(len--)
+	{
+		BCC_Val ^= *str;
+		str++;
+	}
+	return BCC_Val;
+}
@@ -10,6 +10,8 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/23       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Notify送信をNotify Queue経由に変更(送信失敗時のResetを廃止)
+  * 1.2            2026/10/19       k.tashiro         BLE Profileの反映/統計情報を追加
   ******************************************************************************************
 */
 
@@ -25,6 +27,8 @@
 #include "definition.h"
 #include "flash_operation.h"
 #include "lib_trace_log.h"
+#include "lib_notify_queue.h"
+#include "lib_ble_profile.h"
 
 /* Definition ------------------------------------------------------------*/
 #define BLE_MTU_SIZE NRF_SDH_BLE_GATT_MAX_MTU_SIZE
@@ -147,6 +151,8 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
 		DEBUG_LOG( LOG_INFO,"max %u, min %u",gGetConParam.max_con_param,gGetConParam.min_con_param );
 		fifo_err = PushFifo(&evt);
 		DEBUG_EVT_FIFO_LOG(fifo_err,evt.evt_id);
+		/* 2026.10.19 Add BUSYで保留していたBLE Profileを反映 */
+		BleProfileConnParamUpdated( &p_ble_evt->evt.gap_evt.params.conn_param_update.conn_params );
 
 		/*update monitor timer start*/
 		StopParamUpdateTimer();
@@ -168,12 +174,18 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
 		set_ble_cnt_handle(BLE_CONN_HANDLE_INVALID);
 		// all timer stop
 		TimerAllStop();
+		/* 2026.10.19 Add Mode変更前にBLE Profileの集計を終了 */
+		BleProfileDisconnected();
 		WalkTimeOutClear();
 		ForceChangeDailyMode();
 		FlashOpForceInit();
 		//New add pincode flag clear.
 		PinCodeCheckFlagClear();
-		ClearNotifyFifo();
+		/* 2026.10.19 Modify 未送信のNotifyを破棄 */
+		DebugNotifyQueueStatsLog();
+		NotifyQueueClear();
+		/* 2026.10.19 Add BLE Profile別のThroughput/Radio On Time */
+		DebugBleProfileStatsLog();
 		
 		//20180911 modify///////////////////
 		ParamUpdateRetryCountClear();
@@ -257,6 +269,8 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
 		break;
 				
 	case BLE_GATTS_EVT_HVN_TX_COMPLETE:
+		/* 2026.10.19 Add SoftDevice Queueが空いたため保持中のNotifyを送信 */
+		NotifyQueueDrain( p_ble_evt->evt.gatts_evt.params.hvn_tx_complete.count );
 		/* 2020.12.08 RAW Mode時にのみACC FIFO INITをPush ++ */
 		GetBleRawExec( &raw_exec );
 		if ( raw_exec == true )
@@ -646,12 +660,16 @@ void BleHvxErrProcess(ret_code_t err_code,ble_gatts_hvx_params_t *pNotify_param)
 	case NRF_ERROR_FORBIDDEN:
 	case NRF_ERROR_DATA_SIZE:
 	case BLE_ERROR_GATTS_SYS_ATTR_MISSING:
-		//up list is force system reset.
-		sd_nvic_SystemReset();
+		/* 2026.10.19 Modify System Resetを廃止. Notify Queueで破棄数をカウント済み */
 		break;
 	case NRF_ERROR_RESOURCES:
 		
 		break;
+	/* 2026.10.19 Add Notify Queue Full ++ */
+	case NRF_ERROR_NO_MEM:
+		//notify queue full. drop
+		break;
+	/* 2026.10.19 Add Notify Queue Full -- */
 	case NRF_ERROR_TIMEOUT:
 		//force change daily mode
 		ForceChangeDailyMode();
@@ -681,28 +699,12 @@ void BleHvxErrProcess(ret_code_t err_code,ble_gatts_hvx_params_t *pNotify_param)
  */
 uint32_t RetryNotify(PEVT_ST pEvent)
 {
-	ble_gatts_hvx_params_t *pNotify_param;
-	ret_code_t ret;
-	uint8_t i;
-	uint16_t cnt_handle = BLE_CONN_HANDLE_INVALID;
 	UNUSED_PARAMETER(*pEvent);
 	
 	DEBUG_LOG(LOG_DEBUG, "retry notify process");
 	
-	for(i = 0; (NRF_ERROR_NULL != NotifyPopFifo(pNotify_param)); i++)
-	{
-		if(pNotify_param != NULL)
-		{
-			GetBleCntHandle(&cnt_handle);
-			ret = sd_ble_gatts_hvx(cnt_handle, pNotify_param);
-			if(ret != NRF_SUCCESS)
-			{
-				DEBUG_LOG(LOG_ERROR,"retry notify failed. force system reset. 0x%x",ret);
-				//retry failed. force system reset.
-				sd_nvic_SystemReset();
-			}
-		}
-	}
+	/* 2026.10.19 Modify 再送はNotify Queueで行う. 送信できなかったものはTX Completeで再送 */
+	NotifyQueueDrain(0);
 	return 0;
 }
 
@@ -855,7 +857,6 @@ void SetBleNotifyCmd(uint16_t uuid_value_handle, uint8_t *pSignal, uint16_t size
 	ret_code_t err_code;
 	ble_gatts_hvx_params_t notify_param;
 	uint16_t dataSize;
-	uint16_t cnt_handle = BLE_CONN_HANDLE_INVALID;
 	
 	dataSize = size;
 	
@@ -866,8 +867,8 @@ void SetBleNotifyCmd(uint16_t uuid_value_handle, uint8_t *pSignal, uint16_t size
 	notify_param.p_len  = &dataSize;
 	
 	DEBUG_LOG(LOG_INFO,"ble notfy up. handler 0x%x. size %u",uuid_value_handle, size);
-	GetBleCntHandle(&cnt_handle);
-	err_code = sd_ble_gatts_hvx(cnt_handle,&notify_param);
+	/* 2026.10.19 Modify Notify Queue経由で送信 */
+	err_code = NotifyQueueSendParam(&notify_param);
 
 //debug test
 #ifdef TEST_NOTIFY_ERROR
@@ -0,0 +1,571 @@
+/**
+  ******************************************************************************************
+  * @file    lib_ble_profile.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   BLE Connection Profile (Connection Parameter / PHY / Data Length / MTU)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Connection Parameter UpdateをBLE_PROFILE_CONFIG経由で実行
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include "lib_ble_profile.h"
+#include "lib_common.h"
+#include "definition.h"
+#include "ble_gatt.h"
+#include "nordic_common.h"
+#include "lib_trace_log.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "ble_radio_notification.h"
+#include "sdk_config.h"
+
+/* Definition ------------------------------------------------------------*/
+#define BLE_PROFILE_PHY_NONE			(0xFF)		/* PHY未設定 */
+#define BLE_PROFILE_RADIO_NOTIFY_US		(800)		/* Radio Notification Distance [us] */
+
+/* sdk_config.hで確保しているSoftDeviceの上限を超えないようにする */
+#define BLE_PROFILE_DATA_LENGTH_LIMIT	(NRF_SDH_BLE_GAP_DATA_LENGTH)
+#define BLE_PROFILE_MTU_SIZE_LIMIT		(NRF_SDH_BLE_GATT_MAX_MTU_SIZE)
+
+/* app_timer tick -> us */
+#define BLE_PROFILE_TICK_TO_US( tick )	( ( (uint64_t)( tick ) * 1000000 * ( APP_TIMER_CONFIG_RTC_FREQUENCY + 1 ) ) / APP_TIMER_CLOCK_FREQ )
+
+/* Private variables -----------------------------------------------------*/
+static const BLE_PROFILE_PARAM g_ble_profile_param[BLE_PROFILE_NUM] =
+{
+	/* BLE_PROFILE_LOW_POWER */
+	{
+		BLE_PROFILE_LP_MIN_CONN_INTERVAL, BLE_PROFILE_LP_MAX_CONN_INTERVAL,
+		BLE_PROFILE_LP_SLAVE_LATENCY, BLE_PROFILE_LP_CONN_SUP_TIMEOUT,
+		BLE_GAP_PHY_1MBPS, BLE_GAP_DATA_LENGTH_DEFAULT, BLE_GATT_ATT_MTU_DEFAULT
+	},
+	/* BLE_PROFILE_REALTIME */
+	{
+		BLE_PROFILE_RT_MIN_CONN_INTERVAL, BLE_PROFILE_RT_MAX_CONN_INTERVAL,
+		BLE_PROFILE_RT_SLAVE_LATENCY, BLE_PROFILE_RT_CONN_SUP_TIMEOUT,
+		BLE_GAP_PHY_2MBPS, BLE_GAP_DATA_LENGTH_DEFAULT, BLE_GATT_ATT_MTU_DEFAULT
+	},
+	/* BLE_PROFILE_BULK */
+	{
+		BLE_PROFILE_BULK_MIN_CONN_INTERVAL, BLE_PROFILE_BULK_MAX_CONN_INTERVAL,
+		BLE_PROFILE_BULK_SLAVE_LATENCY, BLE_PROFILE_BULK_CONN_SUP_TIMEOUT,
+		BLE_GAP_PHY_2MBPS, BLE_PROFILE_BULK_DATA_LENGTH, BLE_PROFILE_BULK_MTU_SIZE
+	},
+};
+
+static BLE_PROFILE_STATS g_ble_profile_stats[BLE_PROFILE_NUM];
+static BLE_PROFILE_CONFIG g_ble_profile_config;
+
+static volatile BLE_PROFILE_ID g_mode_profile  = BLE_PROFILE_LOW_POWER;	/* Mode毎のProfile */
+static volatile BLE_PROFILE_ID g_stats_profile = BLE_PROFILE_LOW_POWER;	/* 統計情報の集計先 */
+static volatile bool g_bulk_hold      = false;		/* Bulk Profileを一時有効化中 */
+static volatile bool g_profile_ready  = false;		/* 接続後のParameter Update完了 */
+static volatile bool g_flash_op       = false;		/* Flash Operation中 (Slave Latency 1) */
+static volatile bool g_apply_pending  = false;		/* BUSYのため反映を保留 */
+static volatile bool g_radio_active   = false;
+
+static uint8_t  g_phy_applied         = BLE_PROFILE_PHY_NONE;
+static uint8_t  g_data_length_applied = BLE_GAP_DATA_LENGTH_DEFAULT;
+static uint16_t g_mtu_size_applied    = BLE_GATT_ATT_MTU_DEFAULT;
+
+static uint32_t g_active_mark = 0;		/* active_tickの集計開始Tick */
+static uint32_t g_radio_mark  = 0;		/* Radio Active時のTick */
+static uint32_t g_tx_mark     = 0;		/* tx_bytesの集計開始時のNotify送信Byte数 */
+
+/**
+ * @brief 現在有効なProfileを取得 (Critical Region内から呼び出す)
+ * @param None
+ * @retval BLE_PROFILE_ID
+ */
+static BLE_PROFILE_ID ble_profile_current( void )
+{
+	return ( g_bulk_hold == true ) ? BLE_PROFILE_BULK : g_mode_profile;
+}
+
+/**
+ * @brief Notify送信Payloadの合計を取得
+ * @param None
+ * @retval 送信Byte数 (get_tx_bytes未登録時は0)
+ */
+static uint32_t ble_profile_tx_bytes( void )
+{
+	return ( g_ble_profile_config.get_tx_bytes != NULL ) ? g_ble_profile_config.get_tx_bytes() : 0;
+}
+
+/**
+ * @brief 有効時間とNotify送信Byte数を集計先Profileに反映 (Critical Region内から呼び出す)
+ * @param None
+ * @retval None
+ */
+static void ble_profile_account( void )
+{
+	uint32_t now;
+	uint32_t diff = 0;
+	uint32_t tx_bytes;
+
+	if ( g_profile_ready == false )
+	{
+		return;
+	}
+
+	now = app_timer_cnt_get();
+	diff = app_timer_cnt_diff_compute( now, g_active_mark );
+	g_ble_profile_stats[g_stats_profile].active_tick += diff;
+	g_active_mark = now;
+
+	tx_bytes = ble_profile_tx_bytes();
+	g_ble_profile_stats[g_stats_profile].tx_bytes += ( tx_bytes - g_tx_mark );
+	g_tx_mark = tx_bytes;
+}
+
+/**
+ * @brief 統計情報の集計先Profileを変更 (Critical Region内から呼び出す)
+ * @param None
+ * @retval true 変更した
+ * @retval false 変更なし
+ */
+static bool ble_profile_switch( void )
+{
+	BLE_PROFILE_ID profile = ble_profile_current();
+
+	if ( profile == g_stats_profile )
+	{
+		return false;
+	}
+
+	ble_profile_account();
+	g_stats_profile = profile;
+	if ( g_profile_ready == true )
+	{
+		g_ble_profile_stats[profile].switch_count++;
+		TRACE_LOG( TR_BLE_PROFILE_CHANGE, (uint16_t)profile );
+	}
+	return true;
+}
+
+/**
+ * @brief PHY / Data Length / MTUを反映
+ * @param cnt_handle Connection Handle
+ * @param p_param Profile Parameter
+ * @retval None
+ */
+static void ble_profile_apply_link( uint16_t cnt_handle, const BLE_PROFILE_PARAM *p_param )
+{
+	uint32_t err_code;
+	uint8_t data_length;
+	uint16_t mtu_size;
+	ble_gap_phys_t phys;
+	ble_gap_data_length_params_t dl_params;
+
+	if ( p_param->phy != g_phy_applied )
+	{
+		phys.tx_phys = p_param->phy;
+		phys.rx_phys = p_param->phy;
+		err_code = sd_ble_gap_phy_update( cnt_handle, &phys );
+		if ( err_code == NRF_SUCCESS )
+		{
+			g_phy_applied = p_param->phy;
+		}
+		else
+		{
+			DEBUG_LOG( LOG_ERROR, "profile phy update err 0x%x", err_code );
+			if ( err_code == NRF_ERROR_BUSY )
+			{
+				g_apply_pending = true;
+			}
+		}
+	}
+
+	data_length = MIN( p_param->data_length, BLE_PROFILE_DATA_LENGTH_LIMIT );
+	if ( data_length != g_data_length_applied )
+	{
+		memset( &dl_params, 0, sizeof( dl_params ) );
+		dl_params.max_tx_octets  = data_length;
+		dl_params.max_rx_octets  = data_length;
+		dl_params.max_tx_time_us = BLE_GAP_DATA_LENGTH_AUTO;
+		dl_params.max_rx_time_us = BLE_GAP_DATA_LENGTH_AUTO;
+		err_code = sd_ble_gap_data_length_update( cnt_handle, &dl_params, NULL );
+		if ( err_code == NRF_SUCCESS )
+		{
+			g_data_length_applied = data_length;
+		}
+		else
+		{
+			DEBUG_LOG( LOG_ERROR, "profile data length update err 0x%x", err_code );
+		}
+	}
+
+	mtu_size = MIN( p_param->mtu_size, BLE_PROFILE_MTU_SIZE_LIMIT );
+	if ( ( mtu_size != g_mtu_size_applied ) && ( g_ble_profile_config.mtu_update != NULL ) )
+	{
+		g_ble_profile_config.mtu_update( mtu_size );
+		g_mtu_size_applied = mtu_size;
+	}
+}
+
+/**
+ * @brief 現在有効なProfileをSoftDeviceへ反映
+ * @param conn_param true : Connection Parameterも反映する
+ * @retval None
+ */
+static void ble_profile_apply( bool conn_param )
+{
+	uint32_t err_code;
+	uint16_t cnt_handle = BLE_CONN_HANDLE_INVALID;
+	BLE_PROFILE_ID profile;
+	ble_gap_conn_params_t con_para;
+
+	if ( ( g_profile_ready == false ) || ( g_ble_profile_config.get_conn_handle == NULL ) )
+	{
+		/* 接続直後のParameter Update中はUpdateParamCheckで反映する */
+		return;
+	}
+	g_ble_profile_config.get_conn_handle( &cnt_handle );
+	if ( cnt_handle == BLE_CONN_HANDLE_INVALID )
+	{
+		return;
+	}
+
+	profile = ble_profile_current();
+	if ( conn_param == true )
+	{
+		GetBleProfileConnParam( g_flash_op, &con_para );
+/* 2026.10.19 Modify ble_conn_params使用時はModule経由でUpdateする ++ */
+		if ( g_ble_profile_config.conn_param_update != NULL )
+		{
+			err_code = g_ble_profile_config.conn_param_update( cnt_handle, &con_para );
+		}
+		else
+		{
+			err_code = sd_ble_gap_conn_param_update( cnt_handle, &con_para );
+		}
+/* 2026.10.19 Modify ble_conn_params使用時はModule経由でUpdateする -- */
+		if ( err_code == NRF_ERROR_BUSY )
+		{
+			/* Parameter Update中. BLE_GAP_EVT_CONN_PARAM_UPDATEで再度反映する */
+			g_apply_pending = true;
+		}
+		else if ( err_code != NRF_SUCCESS )
+		{
+			DEBUG_LOG( LOG_ERROR, "profile %u conn param update err 0x%x", profile, err_code );
+			TRACE_LOG( TR_BLE_PROFILE_APPLY_ERROR, (uint16_t)err_code );
+		}
+		else
+		{
+			DEBUG_LOG( LOG_INFO, "profile %u conn param update. min %u max %u slave %u",
+				profile, con_para.min_conn_interval, con_para.max_conn_interval, con_para.slave_latency );
+		}
+	}
+	ble_profile_apply_link( cnt_handle, &g_ble_profile_param[profile] );
+}
+
+/**
+ * @brief Radio Notification event handler (Radio On Timeを集計)
+ * @param radio_active true : Radio Event開始(BLE_PROFILE_RADIO_NOTIFY_US前), false : 終了
+ * @retval None
+ */
+static void ble_profile_radio_evt_handler( bool radio_active )
+{
+	uint32_t now;
+
+	if ( g_profile_ready == false )
+	{
+		g_radio_active = false;
+		return;
+	}
+
+	now = app_timer_cnt_get();
+	CRITICAL_REGION_ENTER();
+	if ( radio_active == true )
+	{
+		g_radio_mark   = now;
+		g_radio_active = true;
+	}
+	else if ( g_radio_active == true )
+	{
+		g_ble_profile_stats[g_stats_profile].radio_tick += app_timer_cnt_diff_compute( now, g_radio_mark );
+		g_ble_profile_stats[g_stats_profile].radio_event_count++;
+		g_radio_active = false;
+		/* app_timerのCounter(24bit)が一周しないようにRadio Event毎に集計する */
+		ble_profile_account();
+	}
+	CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief BLE Profile Initialize (Radio Notificationを有効化)
+ * @param p_config Application依存の処理 (get_conn_handleは必須)
+ * @retval None
+ */
+void BleProfileInit( const BLE_PROFILE_CONFIG *p_config )
+{
+	uint32_t err_code;
+
+	if ( ( p_config == NULL ) || ( p_config->get_conn_handle == NULL ) )
+	{
+		return;
+	}
+
+	CRITICAL_REGION_ENTER();
+	g_ble_profile_config = *p_config;
+	memset( g_ble_profile_stats, 0, sizeof( g_ble_profile_stats ) );
+	g_mode_profile  = BLE_PROFILE_LOW_POWER;
+	g_stats_profile = BLE_PROFILE_LOW_POWER;
+	g_bulk_hold     = false;
+	g_profile_ready = false;
+	g_flash_op      = false;
+	g_apply_pending = false;
+	CRITICAL_REGION_EXIT();
+
+	err_code = ble_radio_notification_init( APP_IRQ_PRIORITY_LOW, NRF_RADIO_NOTIFICATION_DISTANCE_800US, ble_profile_radio_evt_handler );
+	LIB_ERR_CHECK( err_code, BLE_PROFILE_RADIO_NOTIFY_ERROR, __LINE__ );
+}
+
+/**
+ * @brief Mode Profileを変更 (接続中はすぐにSoftDeviceへ反映)
+ * @param profile BLE_PROFILE_ID
+ * @retval None
+ */
+void BleProfileChange( BLE_PROFILE_ID profile )
+{
+	bool changed;
+
+	if ( profile >= BLE_PROFILE_NUM )
+	{
+		return;
+	}
+
+	CRITICAL_REGION_ENTER();
+	g_mode_profile = profile;
+	changed = ble_profile_switch();
+	CRITICAL_REGION_EXIT();
+
+	if ( changed == true )
+	{
+		DEBUG_LOG( LOG_INFO, "ble profile change %u", ble_profile_current() );
+		ble_profile_apply( true );
+	}
+}
+
+/**
+ * @brief Bulk Profileを一時的に有効化 (BLE_PROFILE_BULK_HOLD_MS経過後にMode Profileへ戻す)
+ * @param None
+ * @retval None
+ */
+void BleProfileBulkKick( void )
+{
+	bool changed;
+
+	CRITICAL_REGION_ENTER();
+	g_bulk_hold = true;
+	changed = ble_profile_switch();
+	CRITICAL_REGION_EXIT();
+
+	if ( g_ble_profile_config.bulk_timer_restart != NULL )
+	{
+		g_ble_profile_config.bulk_timer_restart();
+	}
+	if ( changed == true )
+	{
+		DEBUG_LOG( LOG_INFO, "ble profile bulk start" );
+		ble_profile_apply( true );
+	}
+}
+
+/**
+ * @brief Bulk Profileの一時有効化を解除 (Bulk Hold Timer Timeout)
+ * @param None
+ * @retval None
+ */
+void BleProfileBulkRelease( void )
+{
+	bool changed;
+
+	CRITICAL_REGION_ENTER();
+	g_bulk_hold = false;
+	changed = ble_profile_switch();
+	CRITICAL_REGION_EXIT();
+
+	if ( changed == true )
+	{
+		DEBUG_LOG( LOG_INFO, "ble profile bulk end. return %u", ble_profile_current() );
+		ble_profile_apply( true );
+	}
+}
+
+/**
+ * @brief 現在有効なProfileを取得
+ * @param None
+ * @retval BLE_PROFILE_ID
+ */
+BLE_PROFILE_ID GetBleProfile( void )
+{
+	return ble_profile_current();
+}
+
+/**
+ * @brief 現在有効なProfileのConnection Parameterを取得
+ * @param flash_op true : Flash Operation中 (Slave LatencyをFLASH_SLAVE_LATENCY以上にする)
+ * @param p_conn_params Connection Parameter格納先
+ * @retval None
+ */
+void GetBleProfileConnParam( bool flash_op, ble_gap_conn_params_t *p_conn_params )
+{
+	const BLE_PROFILE_PARAM *p_param;
+
+	if ( p_conn_params == NULL )
+	{
+		return;
+	}
+
+	p_param = &g_ble_profile_param[ble_profile_current()];
+	p_conn_params->min_conn_interval = p_param->min_conn_interval;
+	p_conn_params->max_conn_interval = p_param->max_conn_interval;
+	p_conn_params->slave_latency     = p_param->slave_latency;
+	p_conn_params->conn_sup_timeout  = p_param->conn_sup_timeout;
+	if ( ( flash_op == true ) && ( p_conn_params->slave_latency < FLASH_SLAVE_LATENCY ) )
+	{
+		p_conn_params->slave_latency = FLASH_SLAVE_LATENCY;
+	}
+}
+
+/**
+ * @brief Connection Parameter Update完了 (Parameter Update成功時)
+ * @param flash_op true : Flash Operation中
+ * @retval None
+ */
+void BleProfileReady( bool flash_op )
+{
+	CRITICAL_REGION_ENTER();
+	g_flash_op = flash_op;
+	if ( g_profile_ready == false )
+	{
+		/* 接続後 最初のParameter Update完了から集計する */
+		g_tx_mark       = ble_profile_tx_bytes();
+		g_active_mark   = app_timer_cnt_get();
+		g_stats_profile = ble_profile_current();
+		g_ble_profile_stats[g_stats_profile].switch_count++;
+		g_profile_ready = true;
+	}
+	CRITICAL_REGION_EXIT();
+
+	/* Connection ParameterはUpdateParamCheckで反映済み */
+	ble_profile_apply( false );
+}
+
+/**
+ * @brief Flash Operationの開始/終了を通知
+ * @param flash_op true : 開始, false : 終了
+ * @retval None
+ */
+void BleProfileFlashOp( bool flash_op )
+{
+	g_flash_op = flash_op;
+}
+
+/**
+ * @brief BLE_GAP_EVT_CONN_PARAM_UPDATE時の処理 (BUSYで保留していたProfileを反映)
+ * @param p_conn_params 確定したConnection Parameter
+ * @retval None
+ */
+void BleProfileConnParamUpdated( const ble_gap_conn_params_t *p_conn_params )
+{
+	bool pending;
+
+	CRITICAL_REGION_ENTER();
+	if ( p_conn_params != NULL )
+	{
+		g_ble_profile_stats[g_stats_profile].conn_interval = p_conn_params->max_conn_interval;
+	}
+	pending = g_apply_pending;
+	g_apply_pending = false;
+	CRITICAL_REGION_EXIT();
+
+	if ( pending == true )
+	{
+		ble_profile_apply( true );
+	}
+}
+
+/**
+ * @brief 切断時の処理
+ * @param None
+ * @retval None
+ */
+void BleProfileDisconnected( void )
+{
+	CRITICAL_REGION_ENTER();
+	ble_profile_account();
+	g_profile_ready = false;
+	g_flash_op      = false;
+	g_bulk_hold     = false;
+	g_apply_pending = false;
+	g_radio_active  = false;
+	g_phy_applied         = BLE_PROFILE_PHY_NONE;
+	g_data_length_applied = BLE_GAP_DATA_LENGTH_DEFAULT;
+	g_mtu_size_applied    = BLE_GATT_ATT_MTU_DEFAULT;
+	CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief Profile別 統計情報を取得
+ * @param profile BLE_PROFILE_ID
+ * @param p_stats 統計情報格納先
+ * @retval None
+ */
+void GetBleProfileStats( BLE_PROFILE_ID profile, BLE_PROFILE_STATS *p_stats )
+{
+	if ( ( profile >= BLE_PROFILE_NUM ) || ( p_stats == NULL ) )
+	{
+		return;
+	}
+
+	CRITICAL_REGION_ENTER();
+	ble_profile_account();
+	memcpy( p_stats, &g_ble_profile_stats[profile], sizeof( BLE_PROFILE_STATS ) );
+	CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief Profile別 統計情報 Debug Log (Throughput / Radio On Time)
+ * @param None
+ * @retval None
+ */
+void DebugBleProfileStatsLog( void )
+{
+	BLE_PROFILE_STATS stats;
+	uint8_t profile;
+	uint64_t active_us;
+	uint64_t radio_us;
+	uint64_t radio_offset_us;
+	uint32_t throughput;
+	uint32_t duty;
+
+	for ( profile = 0; profile < BLE_PROFILE_NUM; profile++ )
+	{
+		GetBleProfileStats( (BLE_PROFILE_ID)profile, &stats );
+		active_us = BLE_PROFILE_TICK_TO_US( stats.active_tick );
+		radio_us  = BLE_PROFILE_TICK_TO_US( stats.radio_tick );
+		/* Radio NotificationはRadio Eventの800us前に通知されるため差し引く */
+		radio_offset_us = (uint64_t)stats.radio_event_count * BLE_PROFILE_RADIO_NOTIFY_US;
+		radio_us = ( radio_us > radio_offset_us ) ? ( radio_us - radio_offset_us ) : 0;
+
+		throughput = 0;
+		duty = 0;
+		if ( active_us != 0 )
+		{
+			throughput = (uint32_t)( ( (uint64_t)stats.tx_bytes * 8 * 1000000 ) / active_us );
+			duty       = (uint32_t)( ( radio_us * 1000 ) / active_us );
+		}
+		DEBUG_LOG( LOG_INFO, "PROFILE %u switch %u active %u ms tx %u byte %u bps radio %u ms(%u evt) duty %u permil interval %u",
+			profile, stats.switch_count, (uint32_t)( active_us / 1000 ), stats.tx_bytes, throughput,
+			(uint32_t)( radio_us / 1000 ), stats.radio_event_count, duty, stats.conn_interval );
+	}
+}
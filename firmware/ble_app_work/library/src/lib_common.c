@@ -10,14 +10,22 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/10       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         hvn_tx_queue_sizeの設定を追加
+  * 1.2            2026/10/19       k.tashiro         Reset前にTrace LogをTrace Journalへ書き込む
+  * 1.3            2026/10/19       k.tashiro         nrf_gpio/nrf_delay/nrfx_gpiote を直接Include (lib_ex_rtc.hから削除したため)
   ******************************************************************************************
 */
 
 /* Includes --------------------------------------------------------------*/
+#include "nrf_gpio.h"
+#include "nrf_delay.h"
+#include "nrfx_gpiote.h"
+
 #include "lib_common.h"
 #include "lib_flash.h"
 #include "lib_ram_retain.h"
 #include "lib_wdt.h"
+#include "lib_trace_log.h"
 
 /* Definition ------------------------------------------------------------*/
 #define I2C_BUS_CHECK_FREQ_100KHZ	(10)	// uint[us]
@@ -473,6 +481,7 @@ void NordicSoftDeviceEnable(void)
 {
 	uint32_t err_code;
 	uint32_t ram_start;
+	ble_cfg_t ble_cfg;
 	
 	// softdevice enable.
 	if ( !nrf_sdh_is_enabled() )
@@ -488,6 +497,13 @@ void NordicSoftDeviceEnable(void)
 	//Set the default BLE stack configuration.
 	err_code = nrf_sdh_ble_default_cfg_set(APP_BLE_CONN_CFG_TAG, &ram_start);
 	LIB_ERR_CHECK(err_code, BLE_STACK_DEFA, __LINE__);
+	/* 2026.10.19 Add Notify Queueに合わせてSoftDeviceのhvn_tx_queue_sizeを拡張 ++ */
+	memset(&ble_cfg, 0, sizeof(ble_cfg));
+	ble_cfg.conn_cfg.conn_cfg_tag = APP_BLE_CONN_CFG_TAG;
+	ble_cfg.conn_cfg.params.gatts_conn_cfg.hvn_tx_queue_size = NOTIFY_HVN_TX_QUEUE_SIZE;
+	err_code = sd_ble_cfg_set(BLE_CONN_CFG_GATTS, &ble_cfg, ram_start);
+	LIB_ERR_CHECK(err_code, BLE_GATTS_CFG_ERROR, __LINE__);
+	/* 2026.10.19 Add Notify Queueに合わせてSoftDeviceのhvn_tx_queue_sizeを拡張 -- */
 	//softdevice ble stack enable.
 	err_code = nrf_sdh_ble_enable(&ram_start);
 	DEBUG_LOG(LOG_INFO,"ram s 0x%x",ram_start);
@@ -825,6 +841,8 @@ void LibErrorCheck(uint32_t err_code, uint8_t trace_id, uint16_t line)
 	{
 		DEBUG_LOG( LOG_ERROR, "Reset err, err_code 0x%x, TraceID 0x%x, LINE %u", err_code, trace_id, line );
 		TRACE_LOG( ( TR_OTHER_ERROR_HEADER | trace_id), line );
+		/* 2026.10.19 Add Reset前にTrace Journalへ書き込む (割り込み中はRetained RAMに残り, Reset後に書き込む) */
+		(void)TRACE_LOG_FLUSH();
 		sd_nvic_SystemReset();
 	}
 }
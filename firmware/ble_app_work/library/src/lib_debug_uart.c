@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/08       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         UART出力をlib_halに移動, 書式化をDebugLogVFormatに分離
   ******************************************************************************************
 */
 
@@ -18,7 +19,7 @@
 #include <string.h>
 #include <stdarg.h>
 
-#include "nrf_drv_uart.h"
+#include "lib_hal.h"		/* 2026.10.19 Modify nrf_drv_uart -> lib_hal */
 #include "lib_debug_uart.h"
 
 /* Definition ------------------------------------------------------------*/
@@ -34,9 +35,6 @@
 #define DEF_STR_DEBUG	"[D]"
 #define DEF_STR_ERROR	"[E]"
 
-/* Private variables -----------------------------------------------------*/
-static nrf_drv_uart_t g_uart_inst = NRF_DRV_UART_INSTANCE(0);
-
 /* Private function prototypes -------------------------------------------*/
 /**
  * @brief Setup Debug Level String
@@ -73,14 +71,6 @@ static void convert_str_to_hex( int32_t value, char *store_str, uint32_t *index,
  */
 static uint32_t get_div_10(uint8_t radix, int8_t col);
 
-/**
- * @brief UART Write
- * @param buffer 書き込みバッファ
- * @param length 書き込みバッファサイズ
- * @retval err_code エラーコード
- */
-static uint32_t uart_write( const char *buffer, size_t length );
-
 /**
  * @brief Debug Log Initialize
  * @param None
@@ -88,24 +78,8 @@ static uint32_t uart_write( const char *buffer, size_t length );
  */
 uint32_t DebugLogInit( void )
 {
-	volatile ret_code_t err_code;
-	nrf_drv_uart_config_t uart_config = NRF_DRV_UART_DEFAULT_CONFIG;
-	
-	/* Initialize Uart Config */
-	uart_config.pseltxd  = NRF_LOG_BACKEND_UART_TX_PIN;
-	uart_config.pselrxd  = NRF_UART_PSEL_DISCONNECTED;
-	uart_config.pselcts  = NRF_UART_PSEL_DISCONNECTED;
-	uart_config.pselrts  = NRF_UART_PSEL_DISCONNECTED;
-	uart_config.baudrate = (nrf_uart_baudrate_t)NRF_LOG_BACKEND_UART_BAUDRATE;
-
-	/* Initialize Uart Driver*/
-	err_code = nrf_drv_uart_init(&g_uart_inst, &uart_config, NULL);
-	if ( err_code != NRF_SUCCESS )
-	{
-		return err_code;
-	}
-	
-	return NRF_SUCCESS;
+	/* 2026.10.19 Modify UART設定はlib_hal_nrf.cに移動 */
+	return HalDebugInit();
 }
 
 /**
@@ -118,9 +92,7 @@ void DebugLog( int32_t level, const char *format, ... )
 	va_list va;
 	uint32_t ret;
 	uint32_t index;
-	uint32_t idx;
 	char buffer[DEBUG_UART_BUFFER_SIZE] = {0};
-	char *token;
 	
 	if ( format == NULL )
 	{
@@ -128,7 +100,31 @@ void DebugLog( int32_t level, const char *format, ... )
 	}
 	
 	va_start( va, format );
+	index = DebugLogVFormat( level, buffer, format, va );
+	va_end( va );
+
+	/* Uart Output */
+	ret = HalDebugWrite( buffer, index );
+	if ( ret != HAL_SUCCESS ) { }
 	
+	return ;
+}
+
+/* 2026.10.19 Add DebugLogから書式化部分を分離 (Benchmark/Host Build用) */
+/**
+ * @brief Debug Logの書式化 (Level文字列 + 本文 + CR/LF)
+ * @param level Debug Log Level
+ * @param buffer 格納先 (DEBUG_UART_BUFFER_SIZE以上)
+ * @param format Specify format (%d %u %x %X %s %c)
+ * @param va 引数
+ * @retval 書式化したByte数
+ */
+uint32_t DebugLogVFormat( int32_t level, char *buffer, const char *format, va_list va )
+{
+	uint32_t index;
+	uint32_t idx;
+	char *token;
+
 	index = setup_debug_log(level, buffer);
 	while ( *format != '\0' )
 	{
@@ -174,17 +170,11 @@ void DebugLog( int32_t level, const char *format, ... )
 		}
 	}
 	
-	va_end( va );
-	
 	/* Line feed code */
 	buffer[index++] = '\r';
 	buffer[index++] = '\n';
 
-	/* Uart Output */
-	ret = uart_write(buffer, index);
-	if ( ret != NRF_SUCCESS ) { }
-	
-	return ;
+	return index;
 }
 
 /**
@@ -195,7 +185,7 @@ void DebugLog( int32_t level, const char *format, ... )
  */
 void DebugLogDirect( const char *buffer, uint16_t length )
 {
-	nrf_drv_uart_tx(&g_uart_inst, (uint8_t *)buffer, length);
+	(void)HalDebugWrite( buffer, length );
 }
 
 /**
@@ -214,19 +204,19 @@ static uint32_t setup_debug_log( int32_t level, char *str )
 		switch ( level )
 		{
 		case LOG_ALERT:
-			strncpy( str, DEF_STR_ALERT, sizeof( DEF_STR_ALERT ) );
+			memcpy( str, DEF_STR_ALERT, sizeof( DEF_STR_ALERT ) );
 			break;
 		case LOG_ERROR:
-			strncpy( str, DEF_STR_ERROR, sizeof( DEF_STR_ERROR ) );
+			memcpy( str, DEF_STR_ERROR, sizeof( DEF_STR_ERROR ) );
 			break;
 		case LOG_INFO:
-			strncpy( str, DEF_STR_INFO, sizeof( DEF_STR_INFO ) );
+			memcpy( str, DEF_STR_INFO, sizeof( DEF_STR_INFO ) );
 			break;
 		case LOG_DEBUG:
-			strncpy( str, DEF_STR_DEBUG, sizeof( DEF_STR_DEBUG ) );
+			memcpy( str, DEF_STR_DEBUG, sizeof( DEF_STR_DEBUG ) );
 			break;
 		default:
-			strncpy( str, DEF_STR_DEBUG, sizeof( DEF_STR_DEBUG ) );
+			memcpy( str, DEF_STR_DEBUG, sizeof( DEF_STR_DEBUG ) );
 			break;
 		}
 		len = strlen( str );
@@ -384,18 +374,3 @@ static uint32_t get_div_10(uint8_t radix, int8_t col)
 	}
 	return ret;
 }
-
-/**
- * @brief UART Write
- * @param buffer 書き込みバッファ
- * @param length 書き込みバッファサイズ
- * @retval err_code エラーコード
- */
-static uint32_t uart_write( const char *buffer, size_t length )
-{
-	ret_code_t err_code = NRF_SUCCESS;
-	
-	err_code = nrf_drv_uart_tx(&g_uart_inst, (uint8_t *)buffer, length);
-	
-	return err_code;
-}
@@ -0,0 +1,275 @@
+/**
+  ******************************************************************************************
+  * @file    lib_energy_prof.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Energy Profiler (Subsystem/Wake要因毎の動作時間を計測)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include <string.h>
+
+#include "nrf.h"
+#include "nrf_nvic.h"
+#include "app_timer.h"
+#include "lib_energy_prof.h"
+
+/* Definition ------------------------------------------------------------*/
+#define ENERGY_PROF_LINE_HEADER		"EPROF "
+#define ENERGY_PROF_LINE_MAX		( sizeof( ENERGY_PROF_LINE_HEADER ) - 1 + ( sizeof( ENERGY_PROF_REPORT ) * 2 ) + 2 )
+
+/* Struct ----------------------------------------------------------------*/
+/* 計測状態 */
+typedef struct _energy_prof_info
+{
+	uint64_t sub_cycles[EP_SUB_NUM];		/* Subsystem毎のCycle数 */
+	uint64_t wake_cycles[EP_WAKE_NUM];		/* Wake要因毎のCycle数 */
+	uint32_t wake_count[EP_WAKE_NUM];
+	uint64_t window_ticks;					/* 計測期間 [RTC tick] */
+	uint32_t last_tick;
+	uint32_t last_cycle;
+	uint8_t current;						/* 計測中のSubsystem */
+	uint8_t wake;							/* 今回のWake要因 */
+	bool sleeping;							/* Sleep中 (Wake要因の通知待ち) */
+} ENERGY_PROF_INFO;
+
+/* Private variables -----------------------------------------------------*/
+static ENERGY_PROF_INFO g_energy_prof;
+
+/**
+ * @brief 前回から今回までのCycle数を計測中のSubsystem/Wake要因に加算 (Critical Section内で呼ぶ)
+ * @param None
+ * @retval None
+ */
+static void energy_prof_charge( void )
+{
+	uint32_t now = DWT->CYCCNT;
+	uint32_t diff = now - g_energy_prof.last_cycle;
+
+	g_energy_prof.last_cycle = now;
+	g_energy_prof.sub_cycles[g_energy_prof.current] += diff;
+	if ( g_energy_prof.sleeping == false )
+	{
+		g_energy_prof.wake_cycles[g_energy_prof.wake] += diff;
+	}
+}
+
+/**
+ * @brief 計測期間を更新 (RTC1は512秒で一周するためそれより短い間隔で呼ぶ)
+ * @param None
+ * @retval None
+ */
+static void energy_prof_window_update( void )
+{
+	uint32_t now = app_timer_cnt_get();
+
+	g_energy_prof.window_ticks += app_timer_cnt_diff_compute( now, g_energy_prof.last_tick );
+	g_energy_prof.last_tick = now;
+}
+
+/**
+ * @brief 計測をやり直す (Critical Section内で呼ぶ)
+ * @param None
+ * @retval None
+ */
+static void energy_prof_clear( void )
+{
+	uint8_t current = g_energy_prof.current;
+	uint8_t wake = g_energy_prof.wake;
+	bool sleeping = g_energy_prof.sleeping;
+
+	memset( &g_energy_prof, 0, sizeof( g_energy_prof ) );
+	g_energy_prof.current = current;
+	g_energy_prof.wake = wake;
+	g_energy_prof.sleeping = sleeping;
+	g_energy_prof.last_cycle = DWT->CYCCNT;
+	g_energy_prof.last_tick = app_timer_cnt_get();
+}
+
+/**
+ * @brief Energy Profiler Initialize (DWT Cycle Counterを有効にして計測開始)
+ * @param None
+ * @retval None
+ */
+void EnergyProfInit( void )
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	memset( &g_energy_prof, 0, sizeof( g_energy_prof ) );
+	energy_prof_clear();
+}
+
+/**
+ * @brief Subsystem区間の開始
+ * @param sub Subsystem
+ * @retval 直前のSubsystem (EnergyProfExitに渡す)
+ */
+uint8_t EnergyProfEnter( EP_SUB sub )
+{
+	uint8_t prev;
+	uint8_t critical_sec_ep;
+
+	(void)sd_nvic_critical_region_enter( &critical_sec_ep );
+	energy_prof_charge();
+	prev = g_energy_prof.current;
+	g_energy_prof.current = (uint8_t)sub;
+	(void)sd_nvic_critical_region_exit( critical_sec_ep );
+
+	return prev;
+}
+
+/**
+ * @brief Subsystem区間の終了
+ * @param prev EnergyProfEnterの戻り値
+ * @retval None
+ */
+void EnergyProfExit( uint8_t prev )
+{
+	uint8_t critical_sec_ep;
+
+	(void)sd_nvic_critical_region_enter( &critical_sec_ep );
+	energy_prof_charge();
+	g_energy_prof.current = prev;
+	(void)sd_nvic_critical_region_exit( critical_sec_ep );
+}
+
+/**
+ * @brief Wake要因の通知 (割込みHandlerの先頭で呼ぶ, Sleep後の最初の通知だけ有効)
+ * @param reason Wake要因
+ * @retval None
+ */
+void EnergyProfWake( EP_WAKE reason )
+{
+	uint8_t critical_sec_ep;
+
+	(void)sd_nvic_critical_region_enter( &critical_sec_ep );
+	if ( g_energy_prof.sleeping == true )
+	{
+		/* 起きてからここまでは要因が分からないため区間外のまま */
+		energy_prof_charge();
+		g_energy_prof.sleeping = false;
+		g_energy_prof.wake = (uint8_t)reason;
+		g_energy_prof.wake_count[reason]++;
+	}
+	(void)sd_nvic_critical_region_exit( critical_sec_ep );
+}
+
+/**
+ * @brief Sleep直前に呼ぶ
+ * @param None
+ * @retval None
+ */
+void EnergyProfSleepEnter( void )
+{
+	uint8_t critical_sec_ep;
+
+	(void)sd_nvic_critical_region_enter( &critical_sec_ep );
+	energy_prof_charge();
+	g_energy_prof.sleeping = true;
+	(void)sd_nvic_critical_region_exit( critical_sec_ep );
+}
+
+/**
+ * @brief Sleepから戻った直後に呼ぶ
+ * @param None
+ * @retval None
+ */
+void EnergyProfSleepExit( void )
+{
+	uint8_t critical_sec_ep;
+
+	(void)sd_nvic_critical_region_enter( &critical_sec_ep );
+	if ( g_energy_prof.sleeping == true )
+	{
+		/* 計測対象外の割込み (SoftDevice内部Timer等) */
+		energy_prof_charge();
+		g_energy_prof.sleeping = false;
+		g_energy_prof.wake = EP_WAKE_OTHER;
+		g_energy_prof.wake_count[EP_WAKE_OTHER]++;
+	}
+	energy_prof_window_update();
+	(void)sd_nvic_critical_region_exit( critical_sec_ep );
+}
+
+/**
+ * @brief 計測結果を取得
+ * @param p_report 格納先
+ * @param reset true:取得後に計測をやり直す
+ * @retval None
+ */
+void EnergyProfGetReport( ENERGY_PROF_REPORT *p_report, bool reset )
+{
+	uint8_t critical_sec_ep;
+	uint8_t i;
+
+	if ( p_report == NULL )
+	{
+		return;
+	}
+
+	(void)sd_nvic_critical_region_enter( &critical_sec_ep );
+	energy_prof_charge();
+	energy_prof_window_update();
+
+	p_report->version	= ENERGY_PROF_VERSION;
+	p_report->sub_num	= EP_SUB_NUM;
+	p_report->wake_num	= EP_WAKE_NUM;
+	p_report->cpu_mhz	= ENERGY_PROF_CPU_MHZ;
+	p_report->window_ms	= (uint32_t)( ( g_energy_prof.window_ticks * 1000 ) / APP_TIMER_CLOCK_FREQ );
+	for ( i = 0; i < EP_SUB_NUM; i++ )
+	{
+		p_report->active_us[i] = (uint32_t)( g_energy_prof.sub_cycles[i] / ENERGY_PROF_CPU_MHZ );
+	}
+	for ( i = 0; i < EP_WAKE_NUM; i++ )
+	{
+		p_report->wake_count[i] = g_energy_prof.wake_count[i];
+		p_report->wake_us[i] = (uint32_t)( g_energy_prof.wake_cycles[i] / ENERGY_PROF_CPU_MHZ );
+	}
+
+	if ( reset == true )
+	{
+		energy_prof_clear();
+	}
+	(void)sd_nvic_critical_region_exit( critical_sec_ep );
+}
+
+/**
+ * @brief 計測結果を1行のText ("EPROF <Hex>") で出力
+ * @param p_report 計測結果
+ * @param sink 出力先
+ * @retval None
+ */
+void EnergyProfDump( const ENERGY_PROF_REPORT *p_report, ENERGY_PROF_SINK sink )
+{
+	static const char hex[] = "0123456789abcdef";
+	uint8_t line[ENERGY_PROF_LINE_MAX];
+	const uint8_t *p_data = (const uint8_t *)p_report;
+	uint16_t length;
+	uint16_t i;
+
+	if ( ( p_report == NULL ) || ( sink == NULL ) )
+	{
+		return;
+	}
+
+	length = sizeof( ENERGY_PROF_LINE_HEADER ) - 1;
+	memcpy( line, ENERGY_PROF_LINE_HEADER, length );
+	for ( i = 0; i < sizeof( ENERGY_PROF_REPORT ); i++ )
+	{
+		line[length++] = hex[p_data[i] >> 4];
+		line[length++] = hex[p_data[i] & 0x0F];
+	}
+	line[length++] = '\r';
+	line[length++] = '\n';
+
+	sink( line, length );
+}
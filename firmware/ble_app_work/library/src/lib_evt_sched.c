@@ -0,0 +1,386 @@
+/**
+  ******************************************************************************************
+  * @file    lib_evt_sched.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Event Scheduler (Priority Class / Coalescing)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         EVT_SCHED_ORDERED(Class間の追い越し禁止)を追加
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include "lib_evt_sched.h"
+
+/**
+ * @brief Coalesce対象かどうかを取得
+ * @param p_sched Scheduler
+ * @param evt_id Event ID
+ * @retval true Coalesce対象
+ * @retval false Coalesce対象外
+ */
+static bool evt_sched_is_coalesce( const EVT_SCHED *p_sched, uint8_t evt_id )
+{
+	return ( ( p_sched->p_class_table[evt_id] & EVT_SCHED_COALESCE ) != 0 );
+}
+
+/**
+ * @brief ORDERED対象かどうかを取得
+ * @param p_sched Scheduler
+ * @param evt_id Event ID
+ * @retval true ORDERED対象
+ * @retval false ORDERED対象外
+ */
+static bool evt_sched_is_ordered( const EVT_SCHED *p_sched, uint8_t evt_id )
+{
+	return ( ( p_sched->p_class_table[evt_id] & EVT_SCHED_ORDERED ) != 0 );
+}
+
+/**
+ * @brief Classの中で最も古いORDERED EventのPush順を取得
+ * @param p_sched Scheduler
+ * @param class_id Priority Class
+ * @param p_seq Push順格納先
+ * @retval true ORDERED Eventあり
+ * @retval false ORDERED Eventなし
+ */
+static bool evt_sched_oldest_ordered( const EVT_SCHED *p_sched, uint8_t class_id, uint16_t *p_seq )
+{
+	const EVT_SCHED_QUEUE *p_queue = &p_sched->queue[class_id];
+	uint8_t i;
+	uint8_t pos;
+
+	for ( i = 0; i < p_queue->count; i++ )
+	{
+		pos = (uint8_t)( ( p_queue->head + i ) % p_queue->size );
+		if ( evt_sched_is_ordered( p_sched, p_queue->p_slot[pos].evt_id ) == true )
+		{
+			*p_seq = p_queue->p_slot[pos].seq;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief 選択したClassの先頭がORDERED Eventの場合、より古いORDERED Eventを持つClassに振り替える
+ * @remark 振り替え先は最も古いORDERED Eventを持つClass. そのClassの先頭までは
+ *         ORDERED以外のEventも含めて順に処理する
+ *         (Queueに残るEvent同士のPush順の差はQueue数以下のため、符号付き差分で比較する)
+ * @param p_sched Scheduler
+ * @param select 選択したClass
+ * @retval 取り出すClass
+ */
+static uint8_t evt_sched_select_ordered( const EVT_SCHED *p_sched, uint8_t select )
+{
+	const EVT_SCHED_QUEUE *p_queue = &p_sched->queue[select];
+	uint16_t oldest;
+	uint16_t seq;
+	uint8_t class_id;
+
+	if ( evt_sched_is_ordered( p_sched, p_queue->p_slot[p_queue->head].evt_id ) == false )
+	{
+		return select;
+	}
+
+	oldest = p_queue->p_slot[p_queue->head].seq;
+	for ( class_id = 0; class_id < EVT_SCHED_CLASS_NUM; class_id++ )
+	{
+		if ( ( class_id != select ) &&
+			 ( evt_sched_oldest_ordered( p_sched, class_id, &seq ) == true ) &&
+			 ( (int16_t)( seq - oldest ) < 0 ) )
+		{
+			oldest = seq;
+			select = class_id;
+		}
+	}
+	return select;
+}
+
+/**
+ * @brief Push -> Popまでの時間を統計情報に反映
+ * @param p_sched Scheduler
+ * @param class_id Priority Class
+ * @param tick Push時のTick
+ * @retval None
+ */
+static void evt_sched_update_latency( EVT_SCHED *p_sched, uint8_t class_id, uint32_t tick )
+{
+	uint32_t latency;
+
+	if ( p_sched->get_tick == NULL )
+	{
+		return;
+	}
+
+	latency = ( p_sched->get_tick() - tick ) & p_sched->tick_mask;
+	p_sched->stats[class_id].latency_sum += latency;
+	if ( latency > p_sched->stats[class_id].latency_max )
+	{
+		p_sched->stats[class_id].latency_max = latency;
+	}
+}
+
+/**
+ * @brief 次に取り出すClassを選択
+ * @remark 基本は上位Class優先. ただし下位ClassがEVT_SCHED_STARVE_LIMIT回連続で
+ *         飛ばされた場合は下位Classを1件処理し、Bulk転送が止まらないようにする
+ *         選択したClassの先頭がORDERED Eventの場合はevt_sched_select_ordered()で振り替える
+ * @param p_sched Scheduler
+ * @retval 選択したClass (EVT_SCHED_CLASS_NUMの場合は全Queue Empty)
+ */
+static uint8_t evt_sched_select_class( EVT_SCHED *p_sched )
+{
+	uint8_t class_id;
+	uint8_t select = EVT_SCHED_CLASS_NUM;
+
+	for ( class_id = 0; class_id < EVT_SCHED_CLASS_NUM; class_id++ )
+	{
+		if ( p_sched->queue[class_id].count == 0 )
+		{
+			continue;
+		}
+		if ( select == EVT_SCHED_CLASS_NUM )
+		{
+			select = class_id;
+		}
+		else if ( p_sched->queue[class_id].starve >= EVT_SCHED_STARVE_LIMIT )
+		{
+			select = class_id;
+			break;
+		}
+	}
+
+	if ( select != EVT_SCHED_CLASS_NUM )
+	{
+		select = evt_sched_select_ordered( p_sched, select );
+		for ( class_id = 0; class_id < EVT_SCHED_CLASS_NUM; class_id++ )
+		{
+			if ( class_id == select )
+			{
+				p_sched->queue[class_id].starve = 0;
+			}
+			else if ( p_sched->queue[class_id].count != 0 )
+			{
+				p_sched->queue[class_id].starve++;
+			}
+		}
+	}
+	return select;
+}
+
+/**
+ * @brief Event Scheduler Initialize
+ * @param p_sched Scheduler
+ * @param p_config Initialize Parameter
+ * @retval EVT_SCHED_SUCCESS Success
+ * @retval EVT_SCHED_INVALID Parameter Error
+ */
+uint32_t EvtSchedInit( EVT_SCHED *p_sched, const EVT_SCHED_CONFIG *p_config )
+{
+	uint8_t class_id;
+
+	if ( ( p_sched == NULL ) || ( p_config == NULL ) || ( p_config->p_class_table == NULL ) ||
+		 ( p_config->evt_num > EVT_SCHED_EVT_MAX ) || ( p_config->item_size == 0 ) )
+	{
+		return EVT_SCHED_INVALID;
+	}
+
+	memset( p_sched, 0, sizeof( EVT_SCHED ) );
+	for ( class_id = 0; class_id < EVT_SCHED_CLASS_NUM; class_id++ )
+	{
+		if ( ( p_config->p_item[class_id] == NULL ) || ( p_config->p_slot[class_id] == NULL ) ||
+			 ( p_config->size[class_id] == 0 ) )
+		{
+			return EVT_SCHED_INVALID;
+		}
+		p_sched->queue[class_id].p_item = p_config->p_item[class_id];
+		p_sched->queue[class_id].p_slot = p_config->p_slot[class_id];
+		p_sched->queue[class_id].size   = p_config->size[class_id];
+	}
+	p_sched->item_size     = p_config->item_size;
+	p_sched->p_class_table = p_config->p_class_table;
+	p_sched->evt_num       = p_config->evt_num;
+	p_sched->get_tick      = p_config->get_tick;
+	p_sched->tick_mask     = p_config->tick_mask;
+
+	return EVT_SCHED_SUCCESS;
+}
+
+/**
+ * @brief Event Push (割り込みからも呼び出し可)
+ * @param p_sched Scheduler
+ * @param evt_id Event ID
+ * @param p_item Event Data (item_sizeをコピーする)
+ * @retval EVT_SCHED_SUCCESS Success
+ * @retval EVT_SCHED_COALESCED 未処理の同一Eventにまとめた
+ * @retval EVT_SCHED_NO_MEM Queue Full
+ * @retval EVT_SCHED_INVALID Parameter Error
+ */
+uint32_t EvtSchedPush( EVT_SCHED *p_sched, uint8_t evt_id, const void *p_item )
+{
+	uint32_t ret = EVT_SCHED_SUCCESS;
+	uint32_t bit;
+	uint8_t class_id;
+	uint8_t tail;
+	EVT_SCHED_QUEUE *p_queue;
+	EVT_SCHED_STATS *p_stats;
+
+	if ( ( p_sched == NULL ) || ( p_item == NULL ) || ( evt_id >= p_sched->evt_num ) )
+	{
+		return EVT_SCHED_INVALID;
+	}
+
+	class_id = p_sched->p_class_table[evt_id] & EVT_SCHED_CLASS_MASK;
+	if ( class_id >= EVT_SCHED_CLASS_NUM )
+	{
+		return EVT_SCHED_INVALID;
+	}
+	p_queue = &p_sched->queue[class_id];
+	p_stats = &p_sched->stats[class_id];
+	bit = (uint32_t)1 << ( evt_id & 0x1F );
+
+	EVT_SCHED_CRITICAL_ENTER();
+	if ( ( evt_sched_is_coalesce( p_sched, evt_id ) == true ) &&
+		 ( ( p_sched->pending[evt_id >> 5] & bit ) != 0 ) )
+	{
+		/* 同一Eventが未処理のためまとめる */
+		p_stats->coalesce_count++;
+		ret = EVT_SCHED_COALESCED;
+	}
+	else if ( p_queue->count >= p_queue->size )
+	{
+		p_stats->drop_count++;
+		ret = EVT_SCHED_NO_MEM;
+	}
+	else
+	{
+		tail = (uint8_t)( ( p_queue->head + p_queue->count ) % p_queue->size );
+		memcpy( &p_queue->p_item[tail * p_sched->item_size], p_item, p_sched->item_size );
+		p_queue->p_slot[tail].evt_id = evt_id;
+		p_queue->p_slot[tail].tick   = ( p_sched->get_tick != NULL ) ? p_sched->get_tick() : 0;
+		p_queue->p_slot[tail].seq    = p_sched->seq++;
+		p_queue->count++;
+		if ( evt_sched_is_coalesce( p_sched, evt_id ) == true )
+		{
+			p_sched->pending[evt_id >> 5] |= bit;
+		}
+
+		p_stats->push_count++;
+		p_stats->depth = p_queue->count;
+		if ( p_stats->depth > p_stats->depth_max )
+		{
+			p_stats->depth_max = p_stats->depth;
+		}
+	}
+	EVT_SCHED_CRITICAL_EXIT();
+
+	return ret;
+}
+
+/**
+ * @brief Event Pop (優先度の高いClassから取り出す)
+ * @param p_sched Scheduler
+ * @param p_item Event Data格納先
+ * @retval EVT_SCHED_SUCCESS Success
+ * @retval EVT_SCHED_EMPTY Queue Empty
+ */
+uint32_t EvtSchedPop( EVT_SCHED *p_sched, void *p_item )
+{
+	uint32_t ret = EVT_SCHED_EMPTY;
+	uint8_t class_id;
+	uint8_t evt_id;
+	uint32_t tick;
+	EVT_SCHED_QUEUE *p_queue;
+
+	if ( ( p_sched == NULL ) || ( p_item == NULL ) )
+	{
+		return EVT_SCHED_INVALID;
+	}
+
+	EVT_SCHED_CRITICAL_ENTER();
+	class_id = evt_sched_select_class( p_sched );
+	if ( class_id != EVT_SCHED_CLASS_NUM )
+	{
+		p_queue = &p_sched->queue[class_id];
+		memcpy( p_item, &p_queue->p_item[p_queue->head * p_sched->item_size], p_sched->item_size );
+		evt_id = p_queue->p_slot[p_queue->head].evt_id;
+		tick   = p_queue->p_slot[p_queue->head].tick;
+		p_queue->head = (uint8_t)( ( p_queue->head + 1 ) % p_queue->size );
+		p_queue->count--;
+
+		/* 取り出した時点で再度Push可能にする (処理中に発生したEventは取りこぼさない) */
+		if ( evt_sched_is_coalesce( p_sched, evt_id ) == true )
+		{
+			p_sched->pending[evt_id >> 5] &= ~( (uint32_t)1 << ( evt_id & 0x1F ) );
+		}
+
+		p_sched->stats[class_id].pop_count++;
+		p_sched->stats[class_id].depth = p_queue->count;
+		evt_sched_update_latency( p_sched, class_id, tick );
+		ret = EVT_SCHED_SUCCESS;
+	}
+	EVT_SCHED_CRITICAL_EXIT();
+
+	return ret;
+}
+
+/**
+ * @brief Queueに積まれているEvent数を取得
+ * @param p_sched Scheduler
+ * @retval 全ClassのEvent数
+ */
+uint16_t EvtSchedDepth( const EVT_SCHED *p_sched )
+{
+	uint16_t depth = 0;
+	uint8_t class_id;
+
+	for ( class_id = 0; class_id < EVT_SCHED_CLASS_NUM; class_id++ )
+	{
+		depth += p_sched->queue[class_id].count;
+	}
+	return depth;
+}
+
+/**
+ * @brief Class別 統計情報を取得
+ * @param p_sched Scheduler
+ * @param class_id Priority Class
+ * @param p_stats 統計情報格納先
+ * @retval None
+ */
+void EvtSchedGetStats( const EVT_SCHED *p_sched, uint8_t class_id, EVT_SCHED_STATS *p_stats )
+{
+	if ( ( p_sched == NULL ) || ( p_stats == NULL ) || ( class_id >= EVT_SCHED_CLASS_NUM ) )
+	{
+		return;
+	}
+
+	EVT_SCHED_CRITICAL_ENTER();
+	memcpy( p_stats, &p_sched->stats[class_id], sizeof( EVT_SCHED_STATS ) );
+	EVT_SCHED_CRITICAL_EXIT();
+}
+
+/**
+ * @brief 統計情報をクリア (depthは保持)
+ * @param p_sched Scheduler
+ * @retval None
+ */
+void EvtSchedClearStats( EVT_SCHED *p_sched )
+{
+	uint8_t class_id;
+
+	EVT_SCHED_CRITICAL_ENTER();
+	for ( class_id = 0; class_id < EVT_SCHED_CLASS_NUM; class_id++ )
+	{
+		memset( &p_sched->stats[class_id], 0, sizeof( EVT_SCHED_STATS ) );
+		p_sched->stats[class_id].depth     = p_sched->queue[class_id].count;
+		p_sched->stats[class_id].depth_max = p_sched->queue[class_id].count;
+	}
+	EVT_SCHED_CRITICAL_EXIT();
+}
@@ -10,20 +10,17 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/10       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         lib_hal.hに移行 (nrf_drv_twi/nrf_gpio/nrfx_gpiote/nrf_delayを削除)
   ******************************************************************************************
 */
 
 /* Includes --------------------------------------------------------------*/
-#include "nordic_common.h"
-#include "nrf.h"
-#include "nrf_gpio.h"
-#include "nrfx_gpiote.h"
+#include <stdio.h>
+
 #include "sdk_errors.h"
-#include "app_error.h"
 #include "nrf_log.h"
 #include "nrf_log_ctrl.h"
 #include "nrf_log_default_backends.h"
-#include "nrf_drv_twi.h"
 #include "lib_ex_rtc.h"
 //#include "state_control.h"
 //#include "lib_fifo.h"
@@ -43,51 +40,23 @@
 
 
 /* Definition ------------------------------------------------------------*/
-#define WAIT_EVENT_INTERVAL		(100000)		/* I2Cの応答待ち時間 */
-
-#define I2C_DRV_FREQ_390K		(0x06200000)	/* Errata No.219対応 */
+#define I2C_READ_RETRY			(10)			/* Busyの場合のRead Retry回数 */
 
 /* private variables -----------------------------------------------------*/
-const nrf_drv_twi_t gRtc_twi = NRF_DRV_TWI_INSTANCE(1);		/* SPIMとTWIMはレジスタを共有しているためSPI0とTWI1にする */
-const nrf_drv_twi_config_t twi_config = {
-	.scl				= I2C_CLK_PIN,		/* PIN: P0.14 SCL */
-	.sda				= I2C_SDA_PIN,		/* PIN: P0.15 SDA */
-	.frequency			= (nrf_drv_twi_frequency_t)NRF_DRV_TWI_FREQ_100K,	/* 2022.01.11 Modify 390KHz -> 100KHz */
-	.interrupt_priority	= APP_IRQ_PRIORITY_HIGH,
-	.clear_bus_init		= false
-};
-
-static volatile bool g_event = false;
-static volatile uint16_t g_res_state = 0;
+/* 2026.10.19 Modify TWI (TWI1, 100KHz, 完了待ち) はlib_halに移動 */
 
 /* 2022.05.16 Add 自動接続対応 ++ */
 static volatile bool g_rtc_wakeup = false;
 /* 2022.05.16 Add 自動接続対応 -- */
 
 /* private prototypes ----------------------------------------------------*/
-/**
- * @brief Read/Write Callback function
- * @param p_event event information
- * @param p_context context
- * @retval None
- */
-static void twi_event_handler(nrf_drv_twi_evt_t const * p_event, void * p_context);
-
-/**
- * @brief wait interrupt event
- * @param none
- * @retval true Interrupt Event receive
- * @retval false Interrupt Event non-receive
- */
-static bool wait_event( void );
-
 /**
 * @brief I2C Error Check(Save Trace Log and Set ble read error)
  * @param err error code
  * @param line execution line
  * @retval NRF_SUCCESS Success
  */
-static void i2c_err_check(nrfx_err_t err, uint16_t line)
+static void i2c_err_check(uint32_t err, uint16_t line)
 {
 	if(err != NRF_SUCCESS)
 	{
@@ -103,23 +72,22 @@ static void i2c_err_check(nrfx_err_t err, uint16_t line)
  * @param None
  * @retval NRF_SUCCESS Success
  */
-static ret_code_t i2c_init(void)
+static uint32_t i2c_init(void)
 {
-	ret_code_t err_code;
+	uint32_t err_code;
 
 	/* debug test */
 #ifdef 	TEST_I2C_INIT_ERROR
-	ret_code_t tmp_err_code;
+	uint32_t tmp_err_code;
 	tmp_err_code = NRF_ERROR_BUSY;
 //	SetBleErrReadCmd(UTC_BLE_I2C_INIT_ERROR);
 #endif
-	err_code = nrf_drv_twi_init(&gRtc_twi, &twi_config, twi_event_handler, NULL);
+	err_code = HalTwiInit();
 	if(err_code != NRF_SUCCESS)
 	{
 		TRACE_LOG(TR_I2C_INIT_ERROR, 0);
 //		SetBleErrReadCmd(UTC_BLE_I2C_INIT_ERROR);
 	}
-	nrf_drv_twi_enable(&gRtc_twi);
 	
 	return err_code;
 }
@@ -131,8 +99,7 @@ static ret_code_t i2c_init(void)
  */
 static void i2c_uninit(void)
 {
-	nrf_drv_twi_disable(&gRtc_twi);
-	nrf_drv_twi_uninit(&gRtc_twi);
+	HalTwiUninit();
 }
 
 /**
@@ -143,11 +110,10 @@ static void i2c_uninit(void)
  * @param size 送信データサイズ
  * @retval NRF_SUCCESS Success
  */
-static ret_code_t i2c_write(uint8_t slave_addr, uint8_t reg_addr, uint8_t *ptxdata, uint8_t size)
+static uint32_t i2c_write(uint8_t slave_addr, uint8_t reg_addr, uint8_t *ptxdata, uint8_t size)
 {
-	volatile ret_code_t err_code;
-	volatile uint8_t txbuf[I2C_BUFFER_SIZE];
-	bool event = false;
+	volatile uint32_t err_code;
+	uint8_t txbuf[I2C_BUFFER_SIZE];
 	
 	err_code = NRF_SUCCESS;
 	
@@ -157,28 +123,14 @@ static ret_code_t i2c_write(uint8_t slave_addr, uint8_t reg_addr, uint8_t *ptxda
 		return err_code;
 	}
 	
-	memset((uint8_t*)&txbuf[0],0x00, sizeof(txbuf));
+	memset(&txbuf[0],0x00, sizeof(txbuf));
 	txbuf[0] = reg_addr;
 	
 	if(ptxdata != NULL)
 	{
-		g_event = false;
-		memcpy((uint8_t*)&txbuf[1], ptxdata, size);
-		err_code = nrf_drv_twi_tx(&gRtc_twi, slave_addr, (uint8_t*)&txbuf[0], (size + 1), false);
-		if ( err_code == NRF_SUCCESS )
-		{
-			/* ACK待ち */
-			event = wait_event();
-			if ( event == false )
-			{
-				return NRFX_ERROR_BUSY;
-			}
-			switch ( g_res_state )
-			{
-			case 1:	err_code = NRFX_ERROR_DRV_TWI_ERR_ANACK;	break;
-			case 2: err_code = NRFX_ERROR_DRV_TWI_ERR_DNACK;	break;
-			}
-		}
+		memcpy(&txbuf[1], ptxdata, size);
+		/* 完了(ACK/NACK)まで待つ */
+		err_code = HalTwiWrite(slave_addr, &txbuf[0], (size + 1), false);
 	}
 	return err_code;
 }
@@ -191,12 +143,11 @@ static ret_code_t i2c_write(uint8_t slave_addr, uint8_t reg_addr, uint8_t *ptxda
  * @param size 受信データサイズ
  * @retval NRF_SUCCESS Success
  */
-static ret_code_t i2c_read(uint8_t slave_addr, uint8_t reg_addr, uint8_t *prxdata, uint8_t size)
+static uint32_t i2c_read(uint8_t slave_addr, uint8_t reg_addr, uint8_t *prxdata, uint8_t size)
 {
-	volatile ret_code_t err_code;
-	volatile uint8_t buf;
+	volatile uint32_t err_code;
+	uint8_t buf;
 	uint16_t i;
-	bool event = false;
 	
 	err_code = NRF_ERROR_INVALID_ADDR;
 	
@@ -207,131 +158,31 @@ static ret_code_t i2c_read(uint8_t slave_addr, uint8_t reg_addr, uint8_t *prxdat
 	
 	if(prxdata != NULL)
 	{
-		g_event = false;
-		g_res_state = 0;
-
 		buf = reg_addr;
 		
 		/* 2022.01.26 Add Read Retry ++ */
-		for ( i = 0; i < 10; i++ )
+		for ( i = 0; i < I2C_READ_RETRY; i++ )
 		{
-			err_code = nrf_drv_twi_tx(&gRtc_twi, slave_addr, (uint8_t*)&buf, sizeof(buf), true);
-			if(err_code == NRF_SUCCESS)
+			/* Register Address送信 (STOPなし) -> Read, それぞれ完了(ACK/NACK)まで待つ */
+			err_code = HalTwiWrite(slave_addr, &buf, sizeof(buf), true);
+			if ( err_code == NRF_SUCCESS )
 			{
-				/* ACK待ち */
-				event = wait_event();
-				if ( event == false )
-				{
-					return NRFX_ERROR_BUSY;
-				}
-				switch ( g_res_state )
-				{
-				case 1:	err_code = NRFX_ERROR_DRV_TWI_ERR_ANACK;	break;
-				case 2: err_code = NRFX_ERROR_DRV_TWI_ERR_DNACK;	break;
-				}
-
-				if ( err_code == NRF_SUCCESS )
-				{
-					g_event = false;
-					g_res_state = 0;
-					/* Read */
-					err_code = nrf_drv_twi_rx(&gRtc_twi, slave_addr, prxdata, size);
-					if ( err_code == NRF_SUCCESS )
-					{
-						/* ACK待ち */
-						event = wait_event();
-						if ( event == false )
-						{
-							return NRFX_ERROR_BUSY;
-						}
-						switch ( g_res_state )
-						{
-						case 1:	err_code = NRFX_ERROR_DRV_TWI_ERR_ANACK;	break;
-						case 2: err_code = NRFX_ERROR_DRV_TWI_ERR_DNACK;	break;
-						}
-					}
-				}
+				err_code = HalTwiRead(slave_addr, prxdata, size);
 			}
 			if ( err_code != NRF_ERROR_BUSY )
 			{
 				break;
 			}
-			nrf_delay_us(1);
+			HalDelayUs(1);
 			/* Busyの場合のみ1us待ってから再度実行する */
 		}
 	}
 	return err_code;
 }
-
-/**
- * @brief Read/Write Callback function
- * @param p_event event information
- * @param p_context context
- * @retval None
- */
-static void twi_event_handler(nrf_drv_twi_evt_t const * p_event, void * p_context)
-{
-	switch ( p_event->type )
-	{
-	case NRF_DRV_TWI_EVT_DONE:
-		g_res_state = 0;
-		/* chack xfer type */
-		switch ( p_event->xfer_desc.type )
-		{
-		case NRF_DRV_TWI_XFER_TX:
-			g_event = true;
-			break;
-		case NRF_DRV_TWI_XFER_TXTX:
-			g_event = true;
-			break;
-		case NRF_DRV_TWI_XFER_RX:
-			g_event = true;
-			break;
-		case NRF_DRV_TWI_XFER_TXRX:
-			g_event = true;
-			break;
-		default: break;
-		}
-		break;
-	case NRF_DRV_TWI_EVT_ADDRESS_NACK:
-		g_event = true;
-        g_res_state = 1;
-		break;
-	case NRF_DRV_TWI_EVT_DATA_NACK:
-		g_event = true;
-        g_res_state = 2;
-		break;
-	default:
-		break;
-	}
-}
-
-/**
- * @brief wait interrupt event
- * @param none
- * @retval true Interrupt Event receive
- * @retval false Interrupt Event non-receive
- */
-static bool wait_event( void )
-{
-	uint32_t i;
-	bool event_state = false;
-	
-	for ( i = 0; i < WAIT_EVENT_INTERVAL; i++ )
-	{
-		nrf_delay_us(1);
-		if ( g_event == true )
-		{
-			event_state = true;
-			break;
-		}
-	}
-	return event_state;
-}
 #if 0
 static void register_read_test( void )
 {
-	volatile ret_code_t err_code;
+	volatile uint32_t err_code;
 	volatile uint8_t ctrlreg1 = 0;
 	volatile uint8_t ctrlreg2 = 0;
 	DATE_TIME read_data;
@@ -350,7 +201,7 @@ static void register_read_test( void )
  */
 static void ex_rtc_alarm_flag_clear(void)
 {
-	volatile ret_code_t err_code;
+	volatile uint32_t err_code;
 	volatile uint8_t buf;
 
 	err_code = i2c_read( RTC_SLAVE_ADD, RTC_CTRL_REG2, (uint8_t*)&buf, sizeof( buf ) );
@@ -455,7 +306,7 @@ static void date_dtob_convert(DATE_TIME *pdatetime)
 static uint8_t ex_rtc_os_flag_check(void)
 {
 	uint8_t ret;
-	volatile ret_code_t err_code;
+	volatile uint32_t err_code;
 	volatile uint8_t rxbuf;
 	
 	err_code = i2c_read( RTC_SLAVE_ADD, RTC_CTRL_REG2, (uint8_t*)&rxbuf, sizeof( rxbuf ) );
@@ -473,7 +324,7 @@ static uint8_t ex_rtc_os_flag_check(void)
  */
 static uint8_t ex_rtc_os_flag_clear(void)
 {
-	volatile ret_code_t err_code;
+	volatile uint32_t err_code;
 	volatile uint8_t buf;
 //	volatile uint8_t rtccheck;
 	volatile uint8_t ret;
@@ -500,9 +351,9 @@ static uint8_t ex_rtc_os_flag_clear(void)
  * @retval NRF_SUCCESS Success
  * @retval NRF_SUCCESS以外 Error
  */
-static ret_code_t ex_rtc_alert_set( uint8_t reg )
+static uint32_t ex_rtc_alert_set( uint8_t reg )
 {
-	volatile ret_code_t err_code;
+	volatile uint32_t err_code;
 	volatile uint8_t reg_data = 0;
 //	volatile uint8_t ctrlreg1 = 0;
 	
@@ -520,10 +371,9 @@ static ret_code_t ex_rtc_alert_set( uint8_t reg )
 /**
  * @brief External RTC INT Function
  * @param pin Pin Number
- * @param action Interrupt Action
  * @retval  None
  */
-static void rtc_int_evt_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+static void rtc_int_evt_handler(uint32_t pin)
 {
 	NRF_LOG_INFO("%s", __FUNCTION__);		
 	/*ex rtc Interrupt event handler not use UART*/
@@ -531,7 +381,7 @@ static void rtc_int_evt_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t act
 	EVT_ST evt;
 	uint32_t err_fifo;
 #endif	
-	ret_code_t err_code;
+	uint32_t err_code;
 #if 0
 	bool uart_output_enable;
 
@@ -551,9 +401,8 @@ static void rtc_int_evt_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t act
 		// Alarm flag clear
 		ex_rtc_alarm_flag_clear();
 		/* 2022.01.26 Add GPIOの割り込みを無効に設定 ++ */
-		nrfx_gpiote_in_event_disable( RTC_INT_PIN );
+		HalGpioIntDisable( RTC_INT_PIN );
 		/* 2022.01.26 Add GPIOの割り込みを無効に設定 -- */
-		nrf_gpio_pin_latch_clear(RTC_INT_PIN);
 		i2c_uninit();
 	}
 	else
@@ -578,17 +427,11 @@ static void rtc_int_evt_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t act
  */
 static void ex_rtc_int_set(void)
 {
-//	volatile ret_code_t err_code;
-	nrfx_gpiote_in_config_t rtc_init_config;
-	
-	rtc_init_config.pull  = NRF_GPIO_PIN_PULLUP;
-	rtc_init_config.sense = NRF_GPIOTE_POLARITY_HITOLO;
-	rtc_init_config.is_watcher = 0;
-	rtc_init_config.hi_accuracy = 0;
-	rtc_init_config.skip_gpio_setup = false;
+//	volatile uint32_t err_code;
 	
-//	err_code = nrfx_gpiote_in_init(RTC_INT_PIN, &rtc_init_config, rtc_int_evt_handler);
-	nrfx_gpiote_in_init(RTC_INT_PIN, &rtc_init_config, rtc_int_evt_handler);
+	/* Pull Up, High -> Low */
+//	err_code = HalGpioIntInit(RTC_INT_PIN, HAL_GPIO_EDGE_FALL, HAL_GPIO_PULL_UP, rtc_int_evt_handler);
+	(void)HalGpioIntInit(RTC_INT_PIN, HAL_GPIO_EDGE_FALL, HAL_GPIO_PULL_UP, rtc_int_evt_handler);
 //	LIB_ERR_CHECK(err_code, GPIOTE_INT_RTC_SET, __LINE__);
 }
 
@@ -599,7 +442,7 @@ static void ex_rtc_int_set(void)
  */
 uint32_t ExRtcAlarmDisableClear(uint32_t pre_err)
 {
-	volatile ret_code_t err_code;
+	volatile uint32_t err_code;
 	volatile uint8_t buf;
 	uint32_t device_err = UTC_SUCCESS;
 	
@@ -644,7 +487,7 @@ uint32_t ExRtcAlarmDisableClear(uint32_t pre_err)
  */
 void ExRtcSetDateTime(DATE_TIME *pdatetime)
 {
-	volatile  ret_code_t err_code;
+	volatile  uint32_t err_code;
 	
 	DEBUG_LOG( LOG_INFO, "Set RTC Time. YY %u, MM %u, DD %u, hh %u, mm %u, ss %u", pdatetime->year, pdatetime->month,pdatetime->day, pdatetime->hour, pdatetime->min, pdatetime->sec );
 	
@@ -672,9 +515,9 @@ void ExRtcSetDateTime(DATE_TIME *pdatetime)
  * @param pdatetime 取得する日時
  * @retval None
  */
-ret_code_t ExRtcGetDateTime(DATE_TIME *pdatetime)
+uint32_t ExRtcGetDateTime(DATE_TIME *pdatetime)
 {
-	volatile ret_code_t err_code;
+	volatile uint32_t err_code;
 
 	err_code = i2c_init();
 	if(err_code == NRF_SUCCESS)
@@ -697,7 +540,7 @@ ret_code_t ExRtcGetDateTime(DATE_TIME *pdatetime)
 
 //debug test		
 #ifdef TEST_I2C_ERROR
-		ret_code_t tmp_err_code;
+		uint32_t tmp_err_code;
 		tmp_err_code = NRF_ERROR_BUSY;
 		i2c_err_check(tmp_err_code,__LINE__);
 #endif
@@ -723,7 +566,7 @@ bool ExRtcOscCheck(void)
 {
 	bool osc_stopped_flag;
 	uint8_t rtcOSC;
-	ret_code_t err_code;
+	uint32_t err_code;
 	
 	osc_stopped_flag = true;
 	
@@ -775,8 +618,8 @@ bool ExRtcOscCheck(void)
  */
 uint32_t ExRtcSetUp(uint32_t pre_err)
 {
-	ret_code_t      err;
-	ret_code_t    init_err;
+	uint32_t      err;
+	uint32_t    init_err;
 	uint32_t    rtc_err;
 
 	rtc_err = UTC_SUCCESS;
@@ -806,7 +649,7 @@ uint32_t ExRtcSetUp(uint32_t pre_err)
 			{
 				/* RTC Interrupt Setup */
 				ex_rtc_int_set();
-				nrfx_gpiote_in_event_enable(RTC_INT_PIN, true); 
+				HalGpioIntEnable(RTC_INT_PIN);
 			}
 			
 			//register_read_test();
@@ -842,7 +685,7 @@ uint32_t ExRtcSetUp(uint32_t pre_err)
 void ExRtcSetDefaultDateTime( void )
 {
 	DATE_TIME default_time;
-	ret_code_t err_code;
+	uint32_t err_code;
 
 	/* RTCデフォルト設定 */
 	default_time.year	= DEFAULT_YEAR;
@@ -884,7 +727,7 @@ void ExRtcSetDefaultDateTime( void )
  */
 void ExRtcEnableInterrupt( void )
 {
-	ret_code_t err_code;
+	uint32_t err_code;
 	
 	err_code = i2c_init();
 	if(err_code == NRF_SUCCESS)
@@ -901,7 +744,7 @@ void ExRtcEnableInterrupt( void )
 		i2c_uninit();
 
 		/* RTC Interrupt Setup */
-		nrfx_gpiote_in_event_enable(RTC_INT_PIN, true); 
+		HalGpioIntEnable(RTC_INT_PIN);
 	}
 	else
 	{
@@ -916,7 +759,7 @@ void ExRtcEnableInterrupt( void )
  */
 void ExRtcDisableInterrupt( void )
 {
-	ret_code_t err_code;
+	uint32_t err_code;
 	
 	err_code = i2c_init();
 	if(err_code == NRF_SUCCESS)
@@ -937,7 +780,7 @@ void ExRtcDisableInterrupt( void )
 		TRACE_LOG( TR_RTC_DISABLE_INT_ERROR, 1 );
 	}
 	/* GPIOの割り込みも無効に設定しておく */
-	nrfx_gpiote_in_event_disable( RTC_INT_PIN );
+	HalGpioIntDisable( RTC_INT_PIN );
 }
 /* 2022.01.26 Add RawData送信中のRTC Interrupt抑止処理追加 -- */
 
@@ -949,20 +792,10 @@ void ExRtcDisableInterrupt( void )
  */
 uint32_t ExRtcWakeUpSetting( void )
 {
-	ret_code_t err_code;
+	uint32_t err_code;
 	
-	/* GPIO割込終了処理 */
-	nrfx_gpiote_in_uninit( RTC_INT_PIN );
-	
-	/* Setup GPIO WakeUp */
-	if ( NRF_GPIO->DETECTMODE != 1 )
-	{
-		/* latch enale */
-		NRF_GPIO->DETECTMODE = 1;
-	}
-	nrf_gpio_cfg_input( RTC_INT_PIN, NRF_GPIO_PIN_PULLUP );
-	nrf_gpio_cfg_sense_set( RTC_INT_PIN, NRF_GPIO_PIN_SENSE_LOW );
-	nrf_gpio_pin_latch_clear( RTC_INT_PIN );
+	/* GPIO割込終了処理, Setup GPIO WakeUp (Pull Up, Low Levelで起動) */
+	HalGpioWakeUpSet( RTC_INT_PIN, HAL_GPIO_PULL_UP, false );
 	
 	/* RTC Setting */
 	err_code = i2c_init();
@@ -995,14 +828,14 @@ uint32_t ExRtcWakeUpSetting( void )
  */
 bool ExRtcWakeUpCheck( void )
 {
-	uint32_t read_state = 0;
+	bool read_state;
 	bool state = false;
 	
     NRF_LOG_INFO("%s", __FUNCTION__);  	
 	
 	/* RTC Interrupt確認 */
-	read_state = nrf_gpio_pin_latch_get( RTC_INT_PIN );
-	if ( read_state == 1 )
+	read_state = HalGpioWakeUpCheck( RTC_INT_PIN );
+	if ( read_state == true )
 	{
 		NRF_LOG_INFO( "!!! RTC Int WakeUp !!!" );
 		/* RTC割込での起動 */
@@ -1091,7 +924,7 @@ void ExRtcPrintTime(void)
 {
 	DATE_TIME date_info;
 
-	ret_code_t err_code = ExRtcGetDateTime(&date_info);
+	uint32_t err_code = ExRtcGetDateTime(&date_info);
 	if ( NRF_SUCCESS == err_code )
 	{
     	NRF_LOG_INFO("Datetime %04d-%02d-%02d %02d:%02d:%02d",
@@ -1127,7 +960,7 @@ void ExRtcTest(void)
 
 
 		DATE_TIME date_info;
-		ret_code_t err_code;		
+		uint32_t err_code;		
 		err_code = ExRtcGetDateTime(&date_info);
 		(void) err_code;
 
@@ -1147,7 +980,7 @@ void ExRtcTest(void)
 
 		DATE_TIME date_info;
 	
-		ret_code_t err_code;		
+		uint32_t err_code;		
 		err_code = ExRtcGetDateTime(&date_info);
 //		 ExRtcGetDateTime(&date_info);
 
@@ -1157,7 +990,7 @@ void ExRtcTest(void)
 			return ;
 			}
 
-		nrf_delay_ms( 1000 );
+		HalDelayMs( 1000 );
 //	}		
 #endif
 }
\ No newline at end of file
@@ -10,6 +10,10 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/15       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Event FIFOをPriority Class/Coalesce対応に変更
+  * 1.2            2026/10/19       k.tashiro         Notify FIFOをNotify Queue(lib_notify_queue)へ統合
+  * 1.3            2026/10/19       k.tashiro         Notify QueueにConnection Handle取得(GetBleCntHandle)を登録
+  * 1.4            2026/10/19       k.tashiro         接続/切断/BLE CommandをEVT_SCHED_ORDEREDに変更、Flash完了をNORMALに変更
   ******************************************************************************************
 */
 
@@ -29,19 +33,92 @@
 //#include "definition.h"
 #include "lib_trace_log.h"
 #include "lib_bat.h"
+#include "lib_evt_sched.h"
+#include "app_timer.h"
+#include "lib_notify_queue.h"
+#include "ble_definition.h"
+
+/* Definition -------------------------------------------------------------*/
+#define EVT_SCHED_TICK_MASK		(0x00FFFFFF)		/* app_timer(RTC1) 24bit Counter */
 
 /* Private variables -----------------------------------------------------*/
+/* 2026.10.19 Modify Event FIFOをPriority Class別に分割 ++ */
 // Event fifo buffer
-volatile EVT_ST g_fifo_buffer[EVT_FIFO_SIZE] = {0};
+static EVT_ST g_evt_critical_buffer[EVT_FIFO_CRITICAL_SIZE];
+static EVT_ST g_evt_normal_buffer[EVT_FIFO_NORMAL_SIZE];
+static EVT_ST g_evt_bulk_buffer[EVT_FIFO_BULK_SIZE];
+static EVT_SCHED_SLOT g_evt_critical_slot[EVT_FIFO_CRITICAL_SIZE];
+static EVT_SCHED_SLOT g_evt_normal_slot[EVT_FIFO_NORMAL_SIZE];
+static EVT_SCHED_SLOT g_evt_bulk_slot[EVT_FIFO_BULK_SIZE];
+static EVT_SCHED g_evt_sched;
+
+/*
+ * Event ID -> Priority Class Table
+ *  CRITICAL : 接続/切断/Parameter Update/Timeout等、遅延させると状態遷移が破綻するもの
+ *  NORMAL   : BLE Command / Sensor / RTC
+ *  BULK     : Daily Log転送等、まとめて処理してよいもの
+ *  EVT_SCHED_COALESCEを付加したEventは未処理分があれば1件にまとめる
+ *  (EVT_ACC_FIFO_INTはRunAlgoでSensor FIFOを全て処理するため1件でよい)
+ *  EVT_SCHED_ORDEREDを付加したEventはClassが異なってもPush順に処理する
+ *  (接続/切断がそれ以前に受信したBLE Commandを追い越さないようにする)
+ *  Flash操作の完了とStatus Checkは同一Class(NORMAL)で順序を保つ
+ */
+static const uint8_t g_evt_class_table[MAX_EVT_NUM] =
+{
+	[EVT_INIT_CMPL]					= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_UPDATE_PARAM]				= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_UPDATING_PARAM]			= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_ADV_TO]					= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_NO_WALK_TO]				= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_CNT_CMPL]					= EVT_SCHED_CLASS_CRITICAL | EVT_SCHED_ORDERED,
+	[EVT_CNT_PARAM_UPDATE_CMPL]		= EVT_SCHED_CLASS_CRITICAL | EVT_SCHED_ORDERED,
+	[EVT_CNT_PARAM_UPDATE_ERR]		= EVT_SCHED_CLASS_CRITICAL | EVT_SCHED_ORDERED,
+	[EVT_DISCNT_SUCCESS]			= EVT_SCHED_CLASS_CRITICAL | EVT_SCHED_ORDERED,
+	[EVT_FORCED_TO]					= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_DISCNT_API_CMPL]			= EVT_SCHED_CLASS_CRITICAL | EVT_SCHED_ORDERED,
+	[EVT_UPDATE_TO]					= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_UPDATE_ERR_TO]				= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_FLASH_CNT_PARAM_CHANGE]	= EVT_SCHED_CLASS_NORMAL,
+	[EVT_FLASH_CNT_PARAM_RETURN]	= EVT_SCHED_CLASS_NORMAL,
+	[EVT_ACC_FIFO_INT]				= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_COALESCE,
+	[EVT_RTC_INT]					= EVT_SCHED_CLASS_NORMAL,
+	[EVT_BLE_CMD_INIT]				= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_PLAYER_INFO_SET]	= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_TIME_INFO_SET]		= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_ACCEPT_PINCODE_CHECK]	= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_PINCODE_CHECK]		= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_PINCODE_ERASE]		= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_READ_LOG]			= EVT_SCHED_CLASS_BULK | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_READ_LOG_ONE]		= EVT_SCHED_CLASS_BULK | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_GET_TIME]			= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_GET_BAT]			= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_ADC_READ]					= EVT_SCHED_CLASS_NORMAL,
+	[EVT_BLE_CMD_ERASE_LOG_ONE]		= EVT_SCHED_CLASS_BULK | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_MODE_CHANGE]		= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_ULT_START_TRIG]	= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_ULT_END_TRIG]		= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_BLE_ACK_TO]				= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_ULT_START_TRIG_TO]			= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_ULT_STOP_TRIG_TO]			= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_FLASH_DATA_FORMAT_CREATE]	= EVT_SCHED_CLASS_NORMAL,
+	[EVT_FORCE_SLEEP]				= EVT_SCHED_CLASS_CRITICAL,
+	[EVT_BLE_CMD_ULT_TRIG]			= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_FLASH_OP_STATUS_CHECK]		= EVT_SCHED_CLASS_NORMAL,
+	[EVT_INIT_CMD_START]			= EVT_SCHED_CLASS_NORMAL,
+	[EVT_FLASH_DATA_WRITE_CMPL]		= EVT_SCHED_CLASS_NORMAL,
+	[EVT_FLASH_DATA_ERASE_CMPL]		= EVT_SCHED_CLASS_NORMAL,
+	[EVT_RSSI_NOTIFY]				= EVT_SCHED_CLASS_BULK | EVT_SCHED_COALESCE,
+	[EVT_X_AXIS_ADV]				= EVT_SCHED_CLASS_NORMAL,
+	[EVT_BLE_CMD_GUEST_MODE]		= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+	[EVT_BLE_CMD_ANGLE_ADJUST]		= EVT_SCHED_CLASS_NORMAL | EVT_SCHED_ORDERED,
+};
+/* 2026.10.19 Modify Event FIFOをPriority Class別に分割 -- */
 /* ACC/Gyro fifo buffer 2020.10.26 Modify ACC/Gyroデータに対応 */
 volatile ACC_GYRO_DATA_INFO g_acc_buffer[ACC_GYRO_FIFO_SIZE] = {0};
 
-volatile ble_gatts_hvx_params_t g_notify_buffer[2] = {0};
 volatile SENSOR_FIFO_DATA_INFO g_fifo_clear_info[2] = {0};
 
-volatile nrf_atfifo_t gEvt_fifo;
 volatile nrf_atfifo_t g_acc_gyro_fifo;
-volatile nrf_atfifo_t gNotifyBuf; 
 volatile nrf_atfifo_t g_bat_result_fifo;
 volatile nrf_atfifo_t g_fifo_count_fifo;
 
@@ -53,17 +130,30 @@ volatile nrf_atfifo_t g_fifo_count_fifo;
 void FifoCreate(void)
 {
 	volatile uint32_t err_code;
+	/* 2026.10.19 Modify Event FIFOをScheduler経由に変更 ++ */
+	EVT_SCHED_CONFIG sched_config =
+	{
+		.p_item        = { (uint8_t *)g_evt_critical_buffer, (uint8_t *)g_evt_normal_buffer, (uint8_t *)g_evt_bulk_buffer },
+		.p_slot        = { g_evt_critical_slot, g_evt_normal_slot, g_evt_bulk_slot },
+		.size          = { EVT_FIFO_CRITICAL_SIZE, EVT_FIFO_NORMAL_SIZE, EVT_FIFO_BULK_SIZE },
+		.item_size     = sizeof(EVT_ST),
+		.p_class_table = g_evt_class_table,
+		.evt_num       = MAX_EVT_NUM,
+		.get_tick      = app_timer_cnt_get,
+		.tick_mask     = EVT_SCHED_TICK_MASK,
+	};
 
-	err_code = nrf_atfifo_init((nrf_atfifo_t*)&gEvt_fifo, (void*)&g_fifo_buffer, sizeof(g_fifo_buffer), sizeof(EVT_ST));
+	err_code = EvtSchedInit(&g_evt_sched, &sched_config);
 	LIB_ERR_CHECK(err_code, ATFIFO_CREATE, __LINE__);
+	/* 2026.10.19 Modify Event FIFOをScheduler経由に変更 -- */
 
 	/* 2020.10.26 Modify ACC -> ACC/Gyro/Tempを扱う用に修正 */
 	err_code = nrf_atfifo_init((nrf_atfifo_t*)&g_acc_gyro_fifo,(void*)&g_acc_buffer, sizeof(g_acc_buffer), sizeof(ACC_GYRO_DATA_INFO));
 	LIB_ERR_CHECK(err_code, ATFIFO_CREATE, __LINE__);
 
-	err_code = nrf_atfifo_init((nrf_atfifo_t*)&gNotifyBuf,(void*)&g_notify_buffer,sizeof(g_notify_buffer),sizeof(ble_gatts_hvx_params_t));
-	LIB_ERR_CHECK(err_code, ATFIFO_CREATE, __LINE__);
-	
+	/* 2026.10.19 Modify Notify再送用FIFOはNotify Queueへ統合 */
+	NotifyQueueInit( GetBleCntHandle );
+
 	/* 2020.12.09 Add FIFO Clear ++ */
 	err_code = nrf_atfifo_init((nrf_atfifo_t*)&g_fifo_count_fifo,(void*)&g_fifo_clear_info, sizeof(g_fifo_clear_info), sizeof(SENSOR_FIFO_DATA_INFO));
 	LIB_ERR_CHECK(err_code, ATFIFO_CREATE, __LINE__);
@@ -80,29 +170,24 @@ void FifoCreate(void)
 uint32_t PushFifo(EVT_ST *pEvent)
 {
 	volatile uint32_t err_code;
-	bool bFifo_err;
-	EVT_ST *pPushEvent;
-	nrf_atfifo_item_put_t  evt_put_context;
+	uint32_t sched_ret;
 	
-	bFifo_err = false;
 	err_code = NRF_SUCCESS;
 	
-	pPushEvent = nrf_atfifo_item_alloc((nrf_atfifo_t*)&gEvt_fifo, &evt_put_context);
-	if(pPushEvent != NULL)
-	{
-		memcpy(pPushEvent, pEvent, sizeof(EVT_ST));
-		bFifo_err = nrf_atfifo_item_put((nrf_atfifo_t*)&gEvt_fifo, &evt_put_context);
-		if(bFifo_err != true)
-		{
-			DEBUG_LOG(LOG_ERROR,"push critical evt 0x%x",pEvent->evt_id);
-		}
-	}
-	else
+	/* 2026.10.19 Modify Scheduler経由でPush(同一Eventが未処理の場合はまとめる) ++ */
+	sched_ret = EvtSchedPush(&g_evt_sched, pEvent->evt_id, pEvent);
+	if(sched_ret == EVT_SCHED_NO_MEM)
 	{
 		DEBUG_LOG(LOG_INFO,"evt PushFifo No MEM");
 		err_code = NRF_ERROR_NO_MEM;
 		TRACE_LOG(TR_EVENT_FIFO_ERROR,(uint16_t)(pEvent->evt_id));
 	}
+	else if(sched_ret == EVT_SCHED_INVALID)
+	{
+		DEBUG_LOG(LOG_ERROR,"push invalid evt 0x%x",pEvent->evt_id);
+		err_code = NRF_ERROR_INVALID_PARAM;
+	}
+	/* 2026.10.19 Modify Scheduler経由でPush(同一Eventが未処理の場合はまとめる) -- */
 
 	return err_code;
 
@@ -150,25 +235,11 @@ uint32_t AccGyroPushFifo(ACC_GYRO_DATA_INFO *p_data)
 uint32_t PopFifo(PEVT_ST pEvent)
 {
 	volatile uint32_t err_code;
-	bool bFifo_err;
-	PEVT_ST pRecEvent;
-	nrf_atfifo_item_get_t  evt_get_context;
 	
-	bFifo_err = true;
 	err_code = NRF_SUCCESS;
 
-	pRecEvent = nrf_atfifo_item_get((nrf_atfifo_t*)&gEvt_fifo, &evt_get_context);
-	if(pRecEvent != NULL)
-	{
-		memcpy(pEvent, pRecEvent, sizeof(EVT_ST));
-
-		bFifo_err = nrf_atfifo_item_free((nrf_atfifo_t*)&gEvt_fifo, &evt_get_context);
-		if(bFifo_err != true)
-		{
-			DEBUG_LOG(LOG_DEBUG,"pop critical");
-		}
-	}
-	else
+	/* 2026.10.19 Modify 優先度の高いClassから取り出す */
+	if(EvtSchedPop(&g_evt_sched, pEvent) != EVT_SCHED_SUCCESS)
 	{
 		err_code = NRF_ERROR_NULL;
 	}
@@ -210,69 +281,6 @@ uint32_t AccGyroPopFifo(ACC_GYRO_DATA_INFO *p_data)
 	return err_code;
 }
 
-/**
- * @brief Push Fifo Data(Notifiy用)
- * @param pNotify_param BLE Notify parameter
- * @retval NRF_SUCCESS Success
- * @retval NRF_ERROR_NO_MEM Error
- */
-uint32_t NotifyPushFifo(ble_gatts_hvx_params_t *pNotify_param)
-{
-	volatile uint32_t err_code;
-	bool bFifo_err;
-	ble_gatts_hvx_params_t *pPushNotify_param;
-	nrf_atfifo_item_put_t  notify_put_context;
-	
-	err_code = NRF_SUCCESS;
-	
-	pPushNotify_param = nrf_atfifo_item_alloc((nrf_atfifo_t*)&gNotifyBuf, &notify_put_context);
-	if(pPushNotify_param != NULL)
-	{
-		memcpy(pPushNotify_param, pNotify_param, sizeof(ble_gatts_hvx_params_t));
-		bFifo_err = nrf_atfifo_item_put((nrf_atfifo_t*)&gNotifyBuf, &notify_put_context);
-		if(bFifo_err != true)
-		{
-			DEBUG_LOG(LOG_ERROR,"notify push critical");
-		}
-	}
-	else
-	{
-		DEBUG_LOG(LOG_DEBUG,"notify push fifo NO MEM");
-		err_code = NRF_ERROR_NO_MEM;
-	}
-	return err_code;
-}
-
-/**
- * @brief POP Fifo Data(Notifiy用)
- * @param pNotify_param BLE Notify parameter
- * @retval NRF_SUCCESS Success
- * @retval NRF_ERROR_NO_MEM Error
- */
-uint32_t NotifyPopFifo(ble_gatts_hvx_params_t *pNotify_param)
-{
-	volatile uint32_t err_code;
-	bool bFifo_err;
-	ble_gatts_hvx_params_t *pPopNotify_param;
-	nrf_atfifo_item_get_t notify_get_context;
-
-	pPopNotify_param = nrf_atfifo_item_get((nrf_atfifo_t*)&gNotifyBuf, &notify_get_context);
-	if(pPopNotify_param != NULL)
-	{
-		memcpy(pNotify_param, pPopNotify_param, sizeof(ble_gatts_hvx_params_t));
-		bFifo_err = nrf_atfifo_item_free((nrf_atfifo_t*)&gNotifyBuf, &notify_get_context);
-		if(bFifo_err != true)
-		{
-			DEBUG_LOG(LOG_DEBUG,"notify pop critical");
-		}
-	}
-	else
-	{
-		err_code = NRF_ERROR_NO_MEM;
-	}
-	return err_code;
-}
-
 /**
  * @brief Push Fifo Data(FIFO Clear)
  * @param pData FIFO Count Info
@@ -339,21 +347,6 @@ uint32_t FifoClearPopFifo( SENSOR_FIFO_DATA_INFO *p_data )
 	return err_code;
 }
 
-/**
- * @brief Clear Notify FIFO(Notifiy用)
- * @param None
- * @retval None
- */
-void ClearNotifyFifo(void)
-{
-	ret_code_t err;
-	err = nrf_atfifo_clear((nrf_atfifo_t*)&gNotifyBuf);
-	if(err != NRF_SUCCESS)
-	{
-		DEBUG_LOG(LOG_ERROR,"notify fifo clear err");
-	}
-}
-
 /**
  * @brief FIFO Event Debug Log
  * @param err_code Error Code
@@ -368,4 +361,55 @@ void DebugEvtFifoLog(uint32_t err_code, uint8_t event)
 	}
 }
 
+/* 2026.10.19 Add Event Scheduler 統計情報 ++ */
+/**
+ * @brief Get Event FIFO Statistics
+ * @param class_id Priority Class (EVT_SCHED_CLASS)
+ * @param p_stats Statistics
+ * @retval None
+ */
+void GetEvtFifoStats(uint8_t class_id, EVT_SCHED_STATS *p_stats)
+{
+	EvtSchedGetStats(&g_evt_sched, class_id, p_stats);
+}
+
+/**
+ * @brief Get Event FIFO Depth
+ * @param None
+ * @retval 全Classに積まれているEvent数
+ */
+uint16_t GetEvtFifoDepth(void)
+{
+	return EvtSchedDepth(&g_evt_sched);
+}
+
+/**
+ * @brief Clear Event FIFO Statistics
+ * @param None
+ * @retval None
+ */
+void ClearEvtFifoStats(void)
+{
+	EvtSchedClearStats(&g_evt_sched);
+}
+
+/**
+ * @brief Event FIFO Statistics Debug Log
+ * @param None
+ * @retval None
+ */
+void DebugEvtFifoStatsLog(void)
+{
+	EVT_SCHED_STATS stats;
+	uint8_t class_id;
 
+	for(class_id = 0; class_id < EVT_SCHED_CLASS_NUM; class_id++)
+	{
+		GetEvtFifoStats(class_id, &stats);
+		DEBUG_LOG( LOG_INFO, "EVT FIFO class %u depth %u/%u push %u pop %u coalesce %u drop %u",
+			class_id, stats.depth, stats.depth_max, stats.push_count, stats.pop_count, stats.coalesce_count, stats.drop_count );
+		DEBUG_LOG( LOG_INFO, "EVT FIFO class %u latency max %u avg %u [tick]",
+			class_id, stats.latency_max, ( stats.pop_count != 0 ) ? ( stats.latency_sum / stats.pop_count ) : 0 );
+	}
+}
+/* 2026.10.19 Add Event Scheduler 統計情報 -- */
@@ -0,0 +1,778 @@
+/**
+  ******************************************************************************************
+  * @file    lib_hal_nrf.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Hardware Abstraction Layer (nRF52 + SoftDevice実装)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         Debug UARTを追加 (lib_debug_uartから移動)
+  * 1.2            2026/10/19       k.tashiro         GPIO Pull/WakeUp/出力, Delayを追加 (lib_icm42607/lib_ex_rtcから移動)
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include <string.h>
+
+#include "nrf.h"
+#include "nrf_nvic.h"
+#include "nrf_gpio.h"
+#include "nrf_delay.h"
+#include "nrf_drv_spi.h"
+#include "nrf_drv_twi.h"
+#include "nrf_drv_uart.h"
+#include "nrfx_gpiote.h"
+#include "nrf_fstorage.h"
+#include "nrf_fstorage_sd.h"
+#include "nrf_pwr_mgmt.h"
+#include "app_timer.h"
+#include "ble_gatts.h"
+#include "ble_adv_scheduler.h"
+#include "lib_hal.h"
+#include "lib_energy_prof.h"
+
+#include "pin_config.h"
+
+/* Definition ------------------------------------------------------------*/
+#define HAL_SPI_INSTANCE			(0)
+#define HAL_TWI_INSTANCE			(1)			/* SPIMとTWIMはレジスタを共有しているためSPI0とTWI1にする */
+#define HAL_UART_INSTANCE			(0)
+
+#define HAL_SPI_CS_ON				(0)
+#define HAL_SPI_CS_OFF				(1)
+
+#define HAL_GPIO_INT_MAX			(4)			/* GPIOTE_CONFIG_NUM_OF_LOW_POWER_EVENTS */
+
+#define HAL_TIMER_MIN_TICKS			(5)			/* app_timerの最小Tick数 */
+
+/* Struct ----------------------------------------------------------------*/
+/* GPIO割込み */
+typedef struct _hal_gpio_int
+{
+	uint32_t pin;
+	HAL_GPIO_HANDLER handler;
+} HAL_GPIO_INT;
+
+/* Private variables -----------------------------------------------------*/
+static const nrf_drv_spi_t g_hal_spi = NRF_DRV_SPI_INSTANCE( HAL_SPI_INSTANCE );
+static const nrf_drv_twi_t g_hal_twi = NRF_DRV_TWI_INSTANCE( HAL_TWI_INSTANCE );
+static nrf_drv_uart_t g_hal_uart = NRF_DRV_UART_INSTANCE( HAL_UART_INSTANCE );
+static bool g_hal_uart_init = false;
+
+static HAL_GPIO_INT g_hal_gpio_int[HAL_GPIO_INT_MAX];
+static uint8_t g_hal_gpio_int_num = 0;
+
+static app_timer_t g_hal_timer_data[HAL_TIMER_MAX];
+static app_timer_id_t g_hal_timer_id[HAL_TIMER_MAX];
+static uint8_t g_hal_timer_num = 0;
+
+static uint32_t g_hal_time_last_tick = 0;
+static uint64_t g_hal_time_ticks = 0;
+
+static void hal_fstorage_evt_handler( nrf_fstorage_evt_t *p_evt );
+
+NRF_FSTORAGE_DEF(nrf_fstorage_t hal_fstorage) =
+{
+	.evt_handler	= hal_fstorage_evt_handler,
+	.start_addr		= HAL_FLASH_START_ADDR,
+	.end_addr		= HAL_FLASH_END_ADDR - 1,
+};
+
+/**
+ * @brief fstorage Event Handler (完了はnrf_fstorage_is_busyで待つ)
+ * @param p_evt fstorage event context
+ * @retval None
+ */
+static void hal_fstorage_evt_handler( nrf_fstorage_evt_t *p_evt )
+{
+	(void)p_evt;
+}
+
+/**
+ * @brief fstorageの処理完了待ち
+ * @param None
+ * @retval None
+ */
+static void hal_fstorage_wait( void )
+{
+	do{
+		__NOP();
+	}	while( nrf_fstorage_is_busy( &hal_fstorage ) );
+}
+
+/**
+ * @brief GPIOTE Event Handler (登録したHandlerに振り分ける)
+ * @param pin Pin番号
+ * @param action 検出Edge
+ * @retval None
+ */
+static void hal_gpiote_evt_handler( nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action )
+{
+	uint8_t i;
+
+	(void)action;
+	for ( i = 0; i < g_hal_gpio_int_num; i++ )
+	{
+		if ( g_hal_gpio_int[i].pin == pin )
+		{
+			g_hal_gpio_int[i].handler( pin );
+			/* PORT Event (Sense) は割り込みを無効にせずLatch Clearのみ */
+			nrf_gpio_pin_latch_clear( pin );
+			return;
+		}
+	}
+}
+
+/**
+ * @brief GPIO割込みの登録を探す
+ * @param pin Pin番号
+ * @retval 登録位置 (未登録の場合はg_hal_gpio_int_num)
+ */
+static uint8_t hal_gpio_int_find( uint32_t pin )
+{
+	uint8_t i;
+
+	for ( i = 0; i < g_hal_gpio_int_num; i++ )
+	{
+		if ( g_hal_gpio_int[i].pin == pin )
+		{
+			break;
+		}
+	}
+
+	return i;
+}
+
+/**
+ * @brief Pull設定の変換
+ * @param pull Pull設定
+ * @retval nrf_gpio_pin_pull_t
+ */
+static nrf_gpio_pin_pull_t hal_gpio_pull( HAL_GPIO_PULL pull )
+{
+	switch ( pull )
+	{
+	case HAL_GPIO_PULL_UP:		return NRF_GPIO_PIN_PULLUP;
+	case HAL_GPIO_PULL_DOWN:	return NRF_GPIO_PIN_PULLDOWN;
+	default:					return NRF_GPIO_PIN_NOPULL;
+	}
+}
+
+/**
+ * @brief Critical Section開始
+ * @param p_nested 入れ子状態の格納先 (HalCriticalExitに渡す)
+ * @retval None
+ */
+void HalCriticalEnter( uint8_t *p_nested )
+{
+	(void)sd_nvic_critical_region_enter( p_nested );
+}
+
+/**
+ * @brief Critical Section終了
+ * @param nested HalCriticalEnterで取得した値
+ * @retval None
+ */
+void HalCriticalExit( uint8_t nested )
+{
+	(void)sd_nvic_critical_region_exit( nested );
+}
+
+/**
+ * @brief SPI Initialize (Pin設定 + CS Inactive)
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalSpiInit( void )
+{
+	nrf_drv_spi_config_t spi_config;
+
+	/* CS (Low Active) */
+	nrf_gpio_cfg( SPI_SS_PIN,
+		NRF_GPIO_PIN_DIR_OUTPUT,
+		NRF_GPIO_PIN_INPUT_CONNECT,
+		NRF_GPIO_PIN_PULLUP,
+		NRF_GPIO_PIN_S0S1,
+		NRF_GPIO_PIN_NOSENSE );
+	nrf_gpio_pin_write( SPI_SS_PIN, HAL_SPI_CS_OFF );
+	nrf_gpio_cfg( SPI_SCK_PIN,
+		NRF_GPIO_PIN_DIR_OUTPUT,
+		NRF_GPIO_PIN_INPUT_CONNECT,
+		NRF_GPIO_PIN_PULLUP,
+		NRF_GPIO_PIN_S0S1,
+		NRF_GPIO_PIN_NOSENSE );
+	nrf_gpio_cfg( SPI_MOSI_PIN,
+		NRF_GPIO_PIN_DIR_OUTPUT,
+		NRF_GPIO_PIN_INPUT_DISCONNECT,
+		NRF_GPIO_PIN_PULLDOWN,
+		NRF_GPIO_PIN_S0S1,
+		NRF_GPIO_PIN_NOSENSE );
+	nrf_gpio_cfg( SPI_MISO_PIN,
+		NRF_GPIO_PIN_DIR_INPUT,
+		NRF_GPIO_PIN_INPUT_CONNECT,
+		NRF_GPIO_PIN_PULLUP,
+		NRF_GPIO_PIN_S0S1,
+		NRF_GPIO_PIN_NOSENSE );
+
+	spi_config.sck_pin		= SPI_SCK_PIN;
+	spi_config.mosi_pin		= SPI_MOSI_PIN;
+	spi_config.miso_pin		= SPI_MISO_PIN;
+	spi_config.ss_pin		= NRF_DRV_SPI_PIN_NOT_USED;				/* CSはGPIOで制御 */
+	spi_config.irq_priority	= SPI_DEFAULT_CONFIG_IRQ_PRIORITY;
+	spi_config.orc			= 0xff;
+	spi_config.frequency	= NRF_DRV_SPI_FREQ_8M;
+	spi_config.mode			= NRF_DRV_SPI_MODE_3;					/* sck:active low, trigger trailing edge */
+	spi_config.bit_order	= NRF_DRV_SPI_BIT_ORDER_MSB_FIRST;
+
+	/* Handlerなし (Blocking) */
+	return nrf_drv_spi_init( &g_hal_spi, &spi_config, NULL, NULL );
+}
+
+/**
+ * @brief SPI Uninitialize
+ * @param None
+ * @retval None
+ */
+void HalSpiUninit( void )
+{
+	nrf_drv_spi_uninit( &g_hal_spi );
+}
+
+/**
+ * @brief SPI転送 (CS Active -> 転送 -> CS Inactive)
+ * @param p_tx 送信Data
+ * @param tx_len 送信Byte数
+ * @param p_rx 受信Data格納先 (NULL:受信しない)
+ * @param rx_len 受信Byte数 (送信と同時に受信した分を含む)
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalSpiTransfer( const uint8_t *p_tx, uint8_t tx_len, uint8_t *p_rx, uint8_t rx_len )
+{
+	uint32_t ret;
+
+	nrf_gpio_pin_write( SPI_SS_PIN, HAL_SPI_CS_ON );
+	ret = nrf_drv_spi_transfer( &g_hal_spi, p_tx, tx_len, p_rx, ( p_rx != NULL ) ? rx_len : 0 );
+	nrf_gpio_pin_write( SPI_SS_PIN, HAL_SPI_CS_OFF );
+
+	return ret;
+}
+
+/**
+ * @brief TWI Initialize
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTwiInit( void )
+{
+	uint32_t ret;
+	const nrf_drv_twi_config_t twi_config = {
+		.scl				= I2C_CLK_PIN,
+		.sda				= I2C_SDA_PIN,
+		.frequency			= NRF_DRV_TWI_FREQ_100K,
+		.interrupt_priority	= APP_IRQ_PRIORITY_HIGH,
+		.clear_bus_init		= false
+	};
+
+	/* Handlerなし (Blocking). lib_ex_rtcと同じInstanceのため使う度にInit/Uninitする */
+	ret = nrf_drv_twi_init( &g_hal_twi, &twi_config, NULL, NULL );
+	if ( ret == NRF_SUCCESS )
+	{
+		nrf_drv_twi_enable( &g_hal_twi );
+	}
+
+	return ret;
+}
+
+/**
+ * @brief TWI Uninitialize
+ * @param None
+ * @retval None
+ */
+void HalTwiUninit( void )
+{
+	nrf_drv_twi_disable( &g_hal_twi );
+	nrf_drv_twi_uninit( &g_hal_twi );
+}
+
+/**
+ * @brief TWI書き込み (完了まで待つ)
+ * @param addr Slave Address
+ * @param p_data 書き込むData
+ * @param len Byte数
+ * @param no_stop true:STOPを出さない (続けてHalTwiReadする場合)
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTwiWrite( uint8_t addr, const uint8_t *p_data, uint8_t len, bool no_stop )
+{
+	return nrf_drv_twi_tx( &g_hal_twi, addr, p_data, len, no_stop );
+}
+
+/**
+ * @brief TWI読み出し (完了まで待つ)
+ * @param addr Slave Address
+ * @param p_data 格納先
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTwiRead( uint8_t addr, uint8_t *p_data, uint8_t len )
+{
+	return nrf_drv_twi_rx( &g_hal_twi, addr, p_data, len );
+}
+
+/**
+ * @brief GPIO割込み設定 (入力, 設定後は無効. 設定済みのPinはHandlerごと設定し直す)
+ * @remark Handlerから戻った後にLatchをクリアする
+ * @param pin Pin番号
+ * @param edge 検出Edge
+ * @param pull Pull設定
+ * @param handler 割込みHandler
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalGpioIntInit( uint32_t pin, HAL_GPIO_EDGE edge, HAL_GPIO_PULL pull, HAL_GPIO_HANDLER handler )
+{
+	uint32_t ret;
+	uint8_t idx;
+	nrfx_gpiote_in_config_t config = NRFX_GPIOTE_CONFIG_IN_SENSE_TOGGLE( false );
+
+	if ( handler == NULL )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+	idx = hal_gpio_int_find( pin );
+	if ( idx >= HAL_GPIO_INT_MAX )
+	{
+		return HAL_ERROR_NO_MEM;
+	}
+	if ( !nrfx_gpiote_is_init() )
+	{
+		ret = nrfx_gpiote_init();
+		if ( ret != NRFX_SUCCESS )
+		{
+			return ret;
+		}
+	}
+
+	switch ( edge )
+	{
+	case HAL_GPIO_EDGE_RISE:	config.sense = NRF_GPIOTE_POLARITY_LOTOHI;	break;
+	case HAL_GPIO_EDGE_FALL:	config.sense = NRF_GPIOTE_POLARITY_HITOLO;	break;
+	default:					config.sense = NRF_GPIOTE_POLARITY_TOGGLE;	break;
+	}
+	config.pull = hal_gpio_pull( pull );
+
+	/* PORT Event (Low Power) で使うため, Senseなしの入力にしてLatchをクリアしてから設定する */
+	nrf_gpio_cfg_input( pin, config.pull );
+	nrf_gpio_cfg_sense_set( pin, NRF_GPIO_PIN_NOSENSE );
+	nrf_gpio_pin_latch_clear( pin );
+	if ( idx < g_hal_gpio_int_num )
+	{
+		nrfx_gpiote_in_uninit( pin );
+	}
+
+	ret = nrfx_gpiote_in_init( pin, &config, hal_gpiote_evt_handler );
+	if ( ret == NRFX_SUCCESS )
+	{
+		g_hal_gpio_int[idx].pin = pin;
+		g_hal_gpio_int[idx].handler = handler;
+		if ( idx == g_hal_gpio_int_num )
+		{
+			g_hal_gpio_int_num++;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * @brief GPIO割込み有効 (Latchをクリアしてから有効にする)
+ * @param pin Pin番号
+ * @retval None
+ */
+void HalGpioIntEnable( uint32_t pin )
+{
+	if ( hal_gpio_int_find( pin ) >= g_hal_gpio_int_num )
+	{
+		return;
+	}
+	nrf_gpio_pin_latch_clear( pin );
+	nrfx_gpiote_in_event_enable( pin, true );
+}
+
+/**
+ * @brief GPIO割込み無効 (無効にしてからLatchをクリアする)
+ * @param pin Pin番号
+ * @retval None
+ */
+void HalGpioIntDisable( uint32_t pin )
+{
+	if ( hal_gpio_int_find( pin ) >= g_hal_gpio_int_num )
+	{
+		return;
+	}
+	nrfx_gpiote_in_event_disable( pin );
+	nrf_gpio_pin_latch_clear( pin );
+}
+
+/**
+ * @brief System OFFからの起動要因に設定 (GPIO割込みは解除し, Senseを設定してLatchをクリアする)
+ * @param pin Pin番号
+ * @param pull Pull設定
+ * @param high true:High Levelで起動, false:Low Levelで起動
+ * @retval None
+ */
+void HalGpioWakeUpSet( uint32_t pin, HAL_GPIO_PULL pull, bool high )
+{
+	uint8_t idx = hal_gpio_int_find( pin );
+
+	if ( idx < g_hal_gpio_int_num )
+	{
+		nrfx_gpiote_in_uninit( pin );
+		g_hal_gpio_int_num--;
+		memmove( &g_hal_gpio_int[idx], &g_hal_gpio_int[idx + 1], ( g_hal_gpio_int_num - idx ) * sizeof( HAL_GPIO_INT ) );
+	}
+
+	if ( NRF_GPIO->DETECTMODE != 1 )
+	{
+		/* latch enable */
+		NRF_GPIO->DETECTMODE = 1;
+	}
+	nrf_gpio_cfg_input( pin, hal_gpio_pull( pull ) );
+	nrf_gpio_cfg_sense_set( pin, high ? NRF_GPIO_PIN_SENSE_HIGH : NRF_GPIO_PIN_SENSE_LOW );
+	nrf_gpio_pin_latch_clear( pin );
+}
+
+/**
+ * @brief System OFFからの起動要因か (起動時のLatch状態)
+ * @param pin Pin番号
+ * @retval true このPinで起動した
+ * @retval false このPinではない
+ */
+bool HalGpioWakeUpCheck( uint32_t pin )
+{
+	return ( nrf_gpio_pin_latch_get( pin ) == 1 );
+}
+
+/**
+ * @brief GPIO出力 (出力に設定してLevelを書き込む)
+ * @param pin Pin番号
+ * @param high true:High, false:Low
+ * @retval None
+ */
+void HalGpioWrite( uint32_t pin, bool high )
+{
+	nrf_gpio_cfg_output( pin );
+	nrf_gpio_pin_write( pin, high ? 1 : 0 );
+}
+
+/**
+ * @brief 待ち (Busy Wait, Hostでは仮想時間を進める)
+ * @param us 時間 [us]
+ * @retval None
+ */
+void HalDelayUs( uint32_t us )
+{
+	nrf_delay_us( us );
+}
+
+/**
+ * @brief 待ち (Busy Wait, Hostでは仮想時間を進める)
+ * @param ms 時間 [ms]
+ * @retval None
+ */
+void HalDelayMs( uint32_t ms )
+{
+	nrf_delay_ms( ms );
+}
+
+/**
+ * @brief Flash Initialize
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashInit( void )
+{
+	return nrf_fstorage_init( &hal_fstorage, &nrf_fstorage_sd, NULL );
+}
+
+/**
+ * @brief Flash読み出し
+ * @param addr 読み出すAddress
+ * @param p_data 格納先
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashRead( uint32_t addr, void *p_data, uint32_t len )
+{
+	return nrf_fstorage_read( &hal_fstorage, addr, p_data, len );
+}
+
+/**
+ * @brief Flash書き込み (完了まで待つ, 4Byte単位)
+ * @param addr 書き込むAddress
+ * @param p_data 書き込むData (完了まで保持する)
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashWrite( uint32_t addr, const void *p_data, uint32_t len )
+{
+	uint32_t ret;
+	ENERGY_PROF_ENTER( EP_SUB_FLASH );
+
+	ret = nrf_fstorage_write( &hal_fstorage, addr, p_data, len, NULL );
+	if ( ret == NRF_SUCCESS )
+	{
+		hal_fstorage_wait();
+	}
+
+	ENERGY_PROF_EXIT();
+	return ret;
+}
+
+/**
+ * @brief Flash消去 (完了まで待つ)
+ * @param addr 消去するPageの先頭Address
+ * @param pages Page数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalFlashErase( uint32_t addr, uint32_t pages )
+{
+	uint32_t ret;
+	ENERGY_PROF_ENTER( EP_SUB_FLASH );
+
+	ret = nrf_fstorage_erase( &hal_fstorage, addr, pages, NULL );
+	if ( ret == NRF_SUCCESS )
+	{
+		hal_fstorage_wait();
+	}
+
+	ENERGY_PROF_EXIT();
+	return ret;
+}
+
+/**
+ * @brief Timer作成
+ * @param p_id 作成したTimerのID格納先
+ * @param repeated true:周期, false:One Shot
+ * @param handler Timeout Handler
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_ERROR_NO_MEM HAL_TIMER_MAX個作成済み
+ */
+uint32_t HalTimerCreate( uint8_t *p_id, bool repeated, HAL_TIMER_HANDLER handler )
+{
+	uint32_t ret;
+	uint8_t id;
+
+	if ( ( p_id == NULL ) || ( handler == NULL ) )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+	if ( g_hal_timer_num >= HAL_TIMER_MAX )
+	{
+		return HAL_ERROR_NO_MEM;
+	}
+
+	id = g_hal_timer_num;
+	g_hal_timer_id[id] = &g_hal_timer_data[id];
+	ret = app_timer_create( &g_hal_timer_id[id],
+		( repeated == true ) ? APP_TIMER_MODE_REPEATED : APP_TIMER_MODE_SINGLE_SHOT,
+		handler );
+	if ( ret == NRF_SUCCESS )
+	{
+		g_hal_timer_num++;
+		*p_id = id;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Timer開始 (動作中ならやり直す)
+ * @param id Timer ID
+ * @param ms 周期 [ms]
+ * @param p_context Handlerに渡す値
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTimerStart( uint8_t id, uint32_t ms, void *p_context )
+{
+	uint32_t ticks;
+
+	if ( id >= g_hal_timer_num )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	ticks = APP_TIMER_TICKS( ms );
+	if ( ticks < HAL_TIMER_MIN_TICKS )
+	{
+		ticks = HAL_TIMER_MIN_TICKS;
+	}
+	(void)app_timer_stop( g_hal_timer_id[id] );
+
+	return app_timer_start( g_hal_timer_id[id], ticks, p_context );
+}
+
+/**
+ * @brief Timer停止
+ * @param id Timer ID
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalTimerStop( uint8_t id )
+{
+	if ( id >= g_hal_timer_num )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	return app_timer_stop( g_hal_timer_id[id] );
+}
+
+/**
+ * @brief 起動からの時間
+ * @param None
+ * @retval 時間 [ms] (約49日で一周, nRFではRTC1が一周する512秒以内に1回以上呼ぶ)
+ */
+uint32_t HalTimeMs( void )
+{
+	uint32_t now;
+	uint32_t ms;
+	uint8_t nested;
+
+	HalCriticalEnter( &nested );
+	now = app_timer_cnt_get();
+	g_hal_time_ticks += app_timer_cnt_diff_compute( now, g_hal_time_last_tick );
+	g_hal_time_last_tick = now;
+	ms = (uint32_t)( ( g_hal_time_ticks * 1000 ) / APP_TIMER_CLOCK_FREQ );
+	HalCriticalExit( nested );
+
+	return ms;
+}
+
+/**
+ * @brief Debug UART Initialize
+ * @param None
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalDebugInit( void )
+{
+	uint32_t err_code;
+	nrf_drv_uart_config_t uart_config = NRF_DRV_UART_DEFAULT_CONFIG;
+
+	if ( g_hal_uart_init )
+	{
+		return HAL_SUCCESS;
+	}
+
+	/* Initialize Uart Config */
+	uart_config.pseltxd  = NRF_LOG_BACKEND_UART_TX_PIN;
+	uart_config.pselrxd  = NRF_UART_PSEL_DISCONNECTED;
+	uart_config.pselcts  = NRF_UART_PSEL_DISCONNECTED;
+	uart_config.pselrts  = NRF_UART_PSEL_DISCONNECTED;
+	uart_config.baudrate = (nrf_uart_baudrate_t)NRF_LOG_BACKEND_UART_BAUDRATE;
+
+	/* Initialize Uart Driver (Handler無し = Blocking) */
+	err_code = nrf_drv_uart_init( &g_hal_uart, &uart_config, NULL );
+	if ( err_code == NRF_SUCCESS )
+	{
+		g_hal_uart_init = true;
+	}
+
+	return err_code;
+}
+
+/**
+ * @brief Debug UART出力 (Blocking)
+ * @param p_data 送信Data
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_ERROR_INVALID_STATE 未初期化 (出力しない)
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalDebugWrite( const char *p_data, uint16_t len )
+{
+	if ( !g_hal_uart_init )
+	{
+		return HAL_ERROR_INVALID_STATE;
+	}
+
+	return nrf_drv_uart_tx( &g_hal_uart, (const uint8_t *)p_data, len );
+}
+
+/**
+ * @brief Notify送信
+ * @param conn_handle Connection Handle
+ * @param value_handle Characteristic Value Handle
+ * @param p_data 送信Data
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed (未接続/Notify無効/送信Buffer不足)
+ */
+uint32_t HalNotify( uint16_t conn_handle, uint16_t value_handle, const uint8_t *p_data, uint16_t len )
+{
+	ble_gatts_hvx_params_t hvx_params;
+
+	memset( &hvx_params, 0, sizeof( hvx_params ) );
+	hvx_params.handle	= value_handle;
+	hvx_params.type		= BLE_GATT_HVX_NOTIFICATION;
+	hvx_params.p_len	= &len;
+	hvx_params.p_data	= p_data;
+
+	return sd_ble_gatts_hvx( conn_handle, &hvx_params );
+}
+
+/**
+ * @brief Advertising Payloadの登録 (nRFではadvertising_init()でble_adv_schedに登録済みのため確認のみ)
+ * @param p_payload Manufacturer Specific Data (Company IDを除く)
+ * @param len Byte数
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalAdvInit( const uint8_t *p_payload, uint16_t len )
+{
+	if ( ( p_payload == NULL ) || ( len == 0 ) )
+	{
+		return HAL_ERROR_INVALID_PARAM;
+	}
+
+	return HAL_SUCCESS;
+}
+
+/**
+ * @brief Advertising Payloadの更新を反映
+ * @param alarm true:Alarm (短い間隔で送信する)
+ * @retval HAL_SUCCESS Success
+ * @retval HAL_SUCCESS以外 Failed
+ */
+uint32_t HalAdvUpdate( bool alarm )
+{
+	return ble_adv_sched_payload_update( alarm );
+}
+
+/**
+ * @brief 次のEventまで待つ (nRF:Sleep, Host:仮想時間を進めてHandlerを呼ぶ)
+ * @param None
+ * @retval true 継続
+ * @retval false 終了 (HostでTraceの再生が終わった)
+ */
+bool HalWaitEvent( void )
+{
+	nrf_pwr_mgmt_run();
+
+	return true;
+}
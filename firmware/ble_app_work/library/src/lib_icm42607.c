@@ -10,17 +10,22 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2022/03/04       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         割り込み内のLogをToken Logに変更
+  * 1.2            2026/10/19       k.tashiro         Low Power常駐モード(WOM + Register 1 Sample読み出し)を追加
+  * 1.3            2026/10/19       k.tashiro         Low Power常駐モードのODRを50Hzに変更, 生データ読み出しを追加(傾き/転倒検出用)
+  * 1.4            2026/10/19       k.tashiro         WOM割り込みをEnergy Profilerに通知
+  * 1.5            2026/10/19       k.tashiro         FIFO PacketのDecodeをlib_icm42607_fifo.cに分離
+  * 1.6            2026/10/19       k.tashiro         lib_hal.hに移行 (nrf_gpio/nrfx_gpiote/sd_nvic/nrf_delayを削除)
   ******************************************************************************************
 */
 
 /* Includes --------------------------------------------------------------*/
 #include <math.h>
 
-#include "nrf_gpio.h"
-#include "nrfx_gpiote.h"
-
 #include "lib_icm42607.h"
 #include "lib_debug_uart.h"
+#include "lib_token_log.h"
+#include "lib_energy_prof.h"
 //#include "lib_fifo.h"
 //#include "ble_definition.h"
 //#include "mode_manager.h"
@@ -42,8 +47,7 @@
 #define INT_LATCH_ENABLE			(1)			/* Interrupt Latch Enable */
 #define INT_LATCH_DISABLE			(0)			/* Interrupt Latch Disable */
 
-#define ACC_GYRO_DATA_COMPLETE		(1)			/* FIFOへの格納条件 */
-#define ACC_GYRO_DATA_NOT_COMPLETE	(2)			/* FIFOへの格納条件 */
+/* 2026.10.19 Modify ACC_GYRO_DATA_COMPLETE/NOT_COMPLETEはlib_icm42607_fifo.hに移動 */
 
 #define DEF_GYRO_CONSTANT			(1000)		/* mdpsから変換するための定数 */
 #define DEF_TEMP_CALC_HIGH_POS		(8)			/* Temp Highを計算すためのPosition */
@@ -67,7 +71,7 @@
 #define WAIT_OTP_RELOAD_TIME		(300)		/* OTP Reload Wait Time */
 
 /* 2022.03.24 Test GPIO Output 割り込み時間計測テスト ++ */
-#define GPIO_UART_RX_PIN			NRF_GPIO_PIN_MAP(0, 29)
+#define GPIO_UART_RX_PIN			(29)		/* P0.29 */
 /* 2022.03.24 Test GPIO Output 割り込み時間計測テスト -- */
 
 /* WakeUpのOFS_USR設定計算用種別
@@ -96,9 +100,14 @@ static volatile uint16_t g_send_sid = 0;
 static volatile uint16_t g_fifo_count = 0;
 /* 2020.12.08 Add FIFO Countを設定する -- */
 
+/* 2026.10.19 Add Low Power常駐モード ++ */
+static volatile bool g_acc_gyro_lp_configured = false;		/* true: Low Power常駐モード設定済み */
+static volatile bool g_acc_gyro_wom_event = false;			/* true: WOM割り込みあり (未処理) */
+/* 2026.10.19 Add Low Power常駐モード -- */
+
 
 /* Struct ----------------------------------------------------------------*/
-typedef nrfx_err_t ( *init_func )( void );
+typedef uint32_t ( *init_func )( void );
 typedef struct _acc_gyro_func_table
 {
 	uint8_t		number;		/* Function番号 */
@@ -114,7 +123,7 @@ typedef void ( *calc_func )( ACC_GYRO_DATA_INFO *calc_data );
  * @retval NRF_SUCCESS Success
  * @retval NRF_SUCCESS以外 Failed
  */
-static nrfx_err_t get_acc_gyro_fifo_count( uint16_t *fifo_count );
+static uint32_t get_acc_gyro_fifo_count( uint16_t *fifo_count );
 
 /**
  * @brief ACC/Gyro FIFO Read Data
@@ -131,7 +140,7 @@ static uint32_t reader_acc_gyro_data( ACC_GYRO_DATA_INFO *acc_gyro_info );
  * @param line Execution Line
  * @retval None
  */
-__STATIC_INLINE void register_setup_error_log( uint8_t reg_addr, uint8_t set_val, uint32_t line );
+static inline void register_setup_error_log( uint8_t reg_addr, uint8_t set_val, uint32_t line );
 
 /**
  * @brief ICM42607 MREG Write Processing
@@ -141,7 +150,7 @@ __STATIC_INLINE void register_setup_error_log( uint8_t reg_addr, uint8_t set_val
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_mreg_write( uint8_t blk_sel, uint8_t reg_addr, uint8_t value );
+static uint32_t setup_mreg_write( uint8_t blk_sel, uint8_t reg_addr, uint8_t value );
 
 /**
  * @brief ICM42607 MREG Read Processing
@@ -151,7 +160,7 @@ static nrfx_err_t setup_mreg_write( uint8_t blk_sel, uint8_t reg_addr, uint8_t v
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_mreg_read( uint8_t blk_sel, uint8_t reg_addr, uint8_t *value );
+static uint32_t setup_mreg_read( uint8_t blk_sel, uint8_t reg_addr, uint8_t *value );
 
 /**
  * @brief ACC/Gyro Set Mode
@@ -161,32 +170,18 @@ static nrfx_err_t setup_mreg_read( uint8_t blk_sel, uint8_t reg_addr, uint8_t *v
  */
 static uint32_t set_acc_gyro_mode( uint8_t mode )
 {
-	volatile uint32_t err_code;
-	uint8_t  acc_gyro_mode_session;
-	
-	err_code = sd_nvic_critical_region_enter( &acc_gyro_mode_session );
-	if(err_code == NRF_SUCCESS)
-	{
-		/* Bufferも初期化しておく */
-		memset( (void *)&g_acc_gyro_data, 0, sizeof( g_acc_gyro_data ) );
-		memset( (void *)&g_temp_data, 0, sizeof( g_temp_data ) );
-		g_store_count = 0;
-		g_temp_store_count = 0;
-		g_acc_gyro_mode = mode;
-		acc_gyro_mode_session = 0;
-		err_code = sd_nvic_critical_region_exit( acc_gyro_mode_session );
-		if(err_code != NRF_SUCCESS)
-		{
-			TRACE_LOG( TR_ACC_SET_MODE_FAILED, 0 );
-			DEBUG_LOG( LOG_ERROR, "!!! Set ACC/Gyro Mode critical Exit !!!" );
-		}
-	}
-	else
-	{
-		TRACE_LOG( TR_ACC_SET_MODE_FAILED, 1 );
-		DEBUG_LOG( LOG_ERROR, "!!! Set ACC/Gyro Mode critical Enter !!!" );
-	}
-	return err_code;
+	uint8_t acc_gyro_mode_session;
+	
+	HalCriticalEnter( &acc_gyro_mode_session );
+	/* Bufferも初期化しておく */
+	memset( (void *)&g_acc_gyro_data, 0, sizeof( g_acc_gyro_data ) );
+	memset( (void *)&g_temp_data, 0, sizeof( g_temp_data ) );
+	g_store_count = 0;
+	g_temp_store_count = 0;
+	g_acc_gyro_mode = mode;
+	HalCriticalExit( acc_gyro_mode_session );
+
+	return NRF_SUCCESS;
 }
 
 /**
@@ -197,45 +192,30 @@ static uint32_t set_acc_gyro_mode( uint8_t mode )
  */
 static uint32_t get_acc_gyro_mode( uint8_t *mode )
 {
-	volatile uint32_t err_code;
-	uint8_t  acc_gyro_mode_session;
+	uint8_t acc_gyro_mode_session;
 	
-	err_code = sd_nvic_critical_region_enter( &acc_gyro_mode_session );
-	if(err_code == NRF_SUCCESS)
-	{
-		*mode = g_acc_gyro_mode;
-		acc_gyro_mode_session = 0;
-		err_code = sd_nvic_critical_region_exit( acc_gyro_mode_session );
-		if(err_code != NRF_SUCCESS)
-		{
-			TRACE_LOG( TR_ACC_GET_MODE_FAILED, 0 );
-			DEBUG_LOG( LOG_ERROR, "!!! Get ACC/Gyro Mode critical Exit !!!" );
-		}
-	}
-	else
-	{
-		TRACE_LOG( TR_ACC_GET_MODE_FAILED, 1 );
-		DEBUG_LOG( LOG_ERROR, "!!! Get ACC/Gyro Mode critical Enter !!!" );
-	}
+	HalCriticalEnter( &acc_gyro_mode_session );
+	*mode = g_acc_gyro_mode;
+	HalCriticalExit( acc_gyro_mode_session );
 	
-	return err_code;
+	return NRF_SUCCESS;
 }
 
 /**
  * @brief ACC/Gyro INT1 Handler
  * @param pin Input PIN Number
- * @param action Input PIN action
  * @retval None
  */
-static void acc_gyro_int1_event_handler( nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action )
+static void acc_gyro_int1_event_handler( uint32_t pin )
 {
 #if NO_FIFO_NOW	
 	volatile EVT_ST event_info = {0};
 #endif	
-	volatile nrfx_err_t err_code;
+	volatile uint32_t err_code;
 	volatile ACC_GYRO_DATA_INFO acc_gyro_data_info = {0};
 
-	SEGGER_RTT_printf(0, "Interrupt Encountered \n");	
+	/* 2026.10.19 Modify 割り込み内で書式整形しないようToken Logに変更 */
+	TOKEN_LOG0( TL_ACC_INT1 );
 
 #if NO_FIFO_NOW		
 	volatile uint32_t fifo_err_code = NRF_SUCCESS;
@@ -260,7 +240,7 @@ static void acc_gyro_int1_event_handler( nrfx_gpiote_pin_t pin, nrf_gpiote_polar
 	{
 #if 0
 		/* 2022.03.24 Test GPIO Output 割り込み時間計測テスト ++ */
-		nrf_gpio_pin_set( GPIO_UART_RX_PIN );
+		HalGpioWrite( GPIO_UART_RX_PIN, true );
 		/* 2022.03.24 Test GPIO Output 割り込み時間計測テスト -- */
 #endif
 		/* 現在 FIFOに積まれているデータ数を取得 */
@@ -300,7 +280,7 @@ static void acc_gyro_int1_event_handler( nrfx_gpiote_pin_t pin, nrf_gpiote_polar
 			}
 #if 0
 			/* 2022.03.24 Test GPIO Output 割り込み時間計測テスト ++ */
-			nrf_gpio_pin_clear( GPIO_UART_RX_PIN );
+			HalGpioWrite( GPIO_UART_RX_PIN, false );
 			/* 2022.03.24 Test GPIO Output 割り込み時間計測テスト -- */
 #endif
 		}
@@ -333,9 +313,7 @@ static void acc_gyro_int1_event_handler( nrfx_gpiote_pin_t pin, nrf_gpiote_polar
 	fifo_err = PushFifo( (void *)&event_info );
 	DEBUG_EVT_FIFO_LOG( fifo_err, EVT_ACC_FIFO_INT );
 #endif	
-	/* 2020.12.08 Add 割り込みを無効にするのではなくLatch Clearのみに修正 ++ */
-	nrf_gpio_pin_latch_clear( ACC_INT1_PIN );
-	/* 2020.12.08 Add 割り込みを無効にするのではなくLatch Clearのみに修正 -- */
+	/* 2026.10.19 Modify Latch ClearはHandlerから戻った後にlib_halで行う */
 
 	if ( uart_enable == false )
 	{
@@ -351,9 +329,9 @@ static void acc_gyro_int1_event_handler( nrfx_gpiote_pin_t pin, nrf_gpiote_polar
  * @retval NRF_SUCCESS Success
  * @retval NRF_SUCCESS以外 Failed
  */
-static nrfx_err_t setup_acc_gyro_fifo_mode( uint8_t value )
+static uint32_t setup_acc_gyro_fifo_mode( uint8_t value )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 	
 	ret = SpiIORead( ICM42607_FIFO_CONFIG1, (uint8_t *)&read_data, sizeof( read_data ) );
@@ -380,9 +358,9 @@ static nrfx_err_t setup_acc_gyro_fifo_mode( uint8_t value )
  * @retval NRF_SUCCESS Success
  * @retval NRF_SUCCESS以外 Failed
  */
-static nrfx_err_t setup_acc_gyro_interrupt( uint8_t reg_addr, uint8_t value )
+static uint32_t setup_acc_gyro_interrupt( uint8_t reg_addr, uint8_t value )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 	
 	ret = SpiIORead( reg_addr, (uint8_t *)&read_data, sizeof( read_data ) );
@@ -409,9 +387,9 @@ static nrfx_err_t setup_acc_gyro_interrupt( uint8_t reg_addr, uint8_t value )
  * @retval NRF_SUCCESS Success
  * @retval NRF_SUCCESS以外 Failed
  */
-static nrfx_err_t setup_acc_gyro_wakeup_ths( uint8_t address, uint8_t theshold )
+static uint32_t setup_acc_gyro_wakeup_ths( uint8_t address, uint8_t theshold )
 {
-	volatile nrfx_err_t ret = 0;
+	volatile uint32_t ret = 0;
 	volatile uint8_t read_data = 0;
 
 	/* MREG1 Bankを指定し、データ読み出し */
@@ -439,9 +417,9 @@ static nrfx_err_t setup_acc_gyro_wakeup_ths( uint8_t address, uint8_t theshold )
  * @retval NRF_SUCCESS Success
  * @retval NRF_SUCCESS以外 Failed
  */
-static nrfx_err_t setup_acc_gyro_fifo_wtm( uint16_t wtm )
+static uint32_t setup_acc_gyro_fifo_wtm( uint16_t wtm )
 {
-	volatile nrfx_err_t ret = 0;
+	volatile uint32_t ret = 0;
 	volatile uint8_t set_val = 0;
 #if NO_FIFO_NOW	
 	volatile uint8_t read_data = 0;
@@ -477,9 +455,9 @@ static nrfx_err_t setup_acc_gyro_fifo_wtm( uint16_t wtm )
  * @retval NRF_SUCCESS Success
  * @retval NRF_SUCCESS以外 Failed
  */
-static nrfx_err_t setup_acc_gyro_software_reset( void )
+static uint32_t setup_acc_gyro_software_reset( void )
 {
-	volatile nrfx_err_t ret = 0;
+	volatile uint32_t ret = 0;
 	volatile uint8_t sw_reset = ACC_GYRO_SW_RESET_VAL;
 
 	ret = SpiIOWrite( ICM42607_SIGNAL_PATH_RESET, (uint8_t *)&sw_reset, sizeof( sw_reset ) );
@@ -495,28 +473,15 @@ static nrfx_err_t setup_acc_gyro_software_reset( void )
  */
 static void setup_acc_gyro_gpio_pin_init( void )
 {
-	nrfx_gpiote_in_config_t gpio_config;
 	uint16_t i;
 	const ACC_GYRO_GPIO_PIN_INFO gpio_pin_info[] = {
-		{	ACC_INT1_PIN,	NRF_GPIO_PIN_NOPULL,	NRF_GPIOTE_POLARITY_LOTOHI,	acc_gyro_int1_event_handler	},
+		{	ACC_INT1_PIN,	HAL_GPIO_PULL_NONE,	HAL_GPIO_EDGE_RISE,	acc_gyro_int1_event_handler	},
 	};
 	
 	for ( i = 0; i < sizeof( gpio_pin_info ) / sizeof( ACC_GYRO_GPIO_PIN_INFO ); i++ )
 	{
-		nrf_gpio_cfg_input( gpio_pin_info[i].gpio_pin, gpio_pin_info[i].pull_config );
-		nrf_gpio_cfg_sense_set( gpio_pin_info[i].gpio_pin, NRF_GPIO_PIN_NOSENSE );
-
-		/* latchクリア */
-        nrf_gpio_pin_latch_clear( gpio_pin_info[i].gpio_pin );
-		/* GPIO設定 */
-		gpio_config.pull		= gpio_pin_info[i].pull_config;
-		gpio_config.hi_accuracy	= 0;
-		gpio_config.is_watcher	= 0;
-		gpio_config.sense		= gpio_pin_info[i].sense_config;
-		/* 一度、Uninit */
-		nrfx_gpiote_in_uninit( gpio_pin_info[i].gpio_pin );
-		
-		nrfx_gpiote_in_init(gpio_pin_info[i].gpio_pin, &gpio_config, gpio_pin_info[i].handler );
+		/* Latch Clear後に設定 (設定済みの場合は一度Uninitして設定し直す) */
+		(void)HalGpioIntInit( gpio_pin_info[i].gpio_pin, gpio_pin_info[i].sense_config, gpio_pin_info[i].pull_config, gpio_pin_info[i].handler );
 	}
 }
 
@@ -529,23 +494,53 @@ static void setup_acc_gyro_gpio_pin_wakeup( void )
 {
 	uint16_t i;
 	const ACC_GYRO_GPIO_WAKEUP_PIN_INFO gpio_pin_info[] = {
-		{	ACC_INT1_PIN,	NRF_GPIO_PIN_NOPULL,	NRF_GPIO_PIN_SENSE_HIGH	},
+		{	ACC_INT1_PIN,	HAL_GPIO_PULL_NONE,	true	},
 	};
 
-	if ( NRF_GPIO->DETECTMODE != 1 )
+	/* 起動設定 (Latch有効, Sense設定, Latch Clear) */
+	for ( i = 0; i < sizeof( gpio_pin_info ) / sizeof( ACC_GYRO_GPIO_WAKEUP_PIN_INFO ); i++ )
 	{
-		/* latch enale */
-		NRF_GPIO->DETECTMODE = 1;
+		HalGpioWakeUpSet( gpio_pin_info[i].gpio_pin, gpio_pin_info[i].pull_config, gpio_pin_info[i].sense_high );
 	}
+}
 
-	/* 起動設定 */
-	for ( i = 0; i < sizeof( gpio_pin_info ) / sizeof( ACC_GYRO_GPIO_WAKEUP_PIN_INFO ); i++ )
+/* 2026.10.19 Add Low Power常駐モード ++ */
+/**
+ * @brief ACC/Gyro INT1 Wake On Motion Handler (Low Power常駐モード)
+ * @remark 割り込み内ではSPIアクセスせずFlagのみ立てる. INT_STATUS2はAccGyroReadAccSampleで読み出してクリアする
+ * @param pin Input PIN Number
+ * @retval None
+ */
+static void acc_gyro_wom_event_handler( uint32_t pin )
+{
+	ENERGY_PROF_WAKE( EP_WAKE_SENSOR );
+	ENERGY_PROF_ENTER( EP_SUB_SENSOR );
+
+	TOKEN_LOG0( TL_ACC_WOM_INT );
+	g_acc_gyro_wom_event = true;
+
+	ENERGY_PROF_EXIT();
+}
+
+/**
+ * @brief setup ACC/Gyro INT1 GPIO Pin Wake On Motion Setting (Low Power常駐モード)
+ * @param None
+ * @retval None
+ */
+static void setup_acc_gyro_gpio_pin_wom( void )
+{
+	uint16_t i;
+	const ACC_GYRO_GPIO_PIN_INFO gpio_pin_info[] = {
+		{	ACC_INT1_PIN,	HAL_GPIO_PULL_NONE,	HAL_GPIO_EDGE_RISE,	acc_gyro_wom_event_handler	},
+	};
+
+	for ( i = 0; i < sizeof( gpio_pin_info ) / sizeof( ACC_GYRO_GPIO_PIN_INFO ); i++ )
 	{
-		nrf_gpio_cfg_input( gpio_pin_info[i].gpio_pin, gpio_pin_info[i].pull_config );
-		nrf_gpio_cfg_sense_set( gpio_pin_info[i].gpio_pin, gpio_pin_info[i].sense_config );
-		nrf_gpio_pin_latch_clear( gpio_pin_info[i].gpio_pin );
+		/* PORT Eventを使用しLow Powerにする (設定済みの場合はHandlerごと設定し直す) */
+		(void)HalGpioIntInit( gpio_pin_info[i].gpio_pin, gpio_pin_info[i].sense_config, gpio_pin_info[i].pull_config, gpio_pin_info[i].handler );
 	}
 }
+/* 2026.10.19 Add Low Power常駐モード -- */
 
 /**
  * @brief ACC/Gyro ODR Setting
@@ -555,9 +550,9 @@ static void setup_acc_gyro_gpio_pin_wakeup( void )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_acc_gyro_sensor_odr_fss( uint8_t address, uint8_t odr, uint8_t fss )
+static uint32_t setup_acc_gyro_sensor_odr_fss( uint8_t address, uint8_t odr, uint8_t fss )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 
 	ret = SpiIORead( address, (uint8_t *)&read_data, sizeof( read_data ) );
@@ -583,9 +578,9 @@ static nrfx_err_t setup_acc_gyro_sensor_odr_fss( uint8_t address, uint8_t odr, u
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_acc_gyro_pwr_mgmt0( uint8_t acc_mode, uint8_t gyro_mode )
+static uint32_t setup_acc_gyro_pwr_mgmt0( uint8_t acc_mode, uint8_t gyro_mode )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 
 	ret = SpiIORead( ICM42607_PWR_MGMT0, (uint8_t *)&read_data, sizeof( read_data ) );
@@ -615,9 +610,9 @@ static nrfx_err_t setup_acc_gyro_pwr_mgmt0( uint8_t acc_mode, uint8_t gyro_mode
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_acc_gyro_idle_ctrl( uint8_t enable )
+static uint32_t setup_acc_gyro_idle_ctrl( uint8_t enable )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 
 	ret = SpiIORead( ICM42607_PWR_MGMT0, (uint8_t *)&read_data, sizeof( read_data ) );
@@ -646,9 +641,9 @@ static nrfx_err_t setup_acc_gyro_idle_ctrl( uint8_t enable )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_acc_gyro_fifo_format( void )
+static uint32_t setup_acc_gyro_fifo_format( void )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 	
 	ret = SpiIORead( ICM42607_INTF_CONFIG0, (uint8_t *)&read_data, sizeof( read_data ) );
@@ -675,9 +670,9 @@ static nrfx_err_t setup_acc_gyro_fifo_format( void )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_mreg_write( uint8_t blk_sel, uint8_t reg_addr, uint8_t value )
+static uint32_t setup_mreg_write( uint8_t blk_sel, uint8_t reg_addr, uint8_t value )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t reset_val = BLK_SEL_DEFAULT_ADDR;
 	
 	/* BLK_SEL_Wレジスタへバンクを指定 */
@@ -706,7 +701,7 @@ static nrfx_err_t setup_mreg_write( uint8_t blk_sel, uint8_t reg_addr, uint8_t v
 		return ret;
 	}
 	/* Write完了待ち(10us) */
-	nrf_delay_us( MREG_WAIT_APPLY_TIME );
+	HalDelayUs( MREG_WAIT_APPLY_TIME );
 	
 	/* 書き込み完了後は、BLK_SEL_Wを0x00に戻す */
 	ret = SpiIOWrite( ICM42607_BLK_SEL_W, (uint8_t *)&reset_val, sizeof( reset_val ) );
@@ -727,9 +722,9 @@ static nrfx_err_t setup_mreg_write( uint8_t blk_sel, uint8_t reg_addr, uint8_t v
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_mreg_read( uint8_t blk_sel, uint8_t reg_addr, uint8_t *value )
+static uint32_t setup_mreg_read( uint8_t blk_sel, uint8_t reg_addr, uint8_t *value )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 	volatile uint8_t reset_val = BLK_SEL_DEFAULT_ADDR;
 	
@@ -750,7 +745,7 @@ static nrfx_err_t setup_mreg_read( uint8_t blk_sel, uint8_t reg_addr, uint8_t *v
 		return ret;
 	}
 	/* Write完了待ち(10us) */
-	nrf_delay_us( MREG_WAIT_APPLY_TIME );
+	HalDelayUs( MREG_WAIT_APPLY_TIME );
 
 	/* M_Rレジスタへ書き込みを実行 */
 	ret = SpiIORead( ICM42607_M_R, (uint8_t *)&read_data, sizeof( read_data ) );
@@ -761,7 +756,7 @@ static nrfx_err_t setup_mreg_read( uint8_t blk_sel, uint8_t reg_addr, uint8_t *v
 		return ret;
 	}
 	/* Write完了待ち(10us) */
-	nrf_delay_us( MREG_WAIT_APPLY_TIME );
+	HalDelayUs( MREG_WAIT_APPLY_TIME );
 	
 	if ( value != NULL )
 	{
@@ -786,9 +781,9 @@ static nrfx_err_t setup_mreg_read( uint8_t blk_sel, uint8_t reg_addr, uint8_t *v
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_tmst_config( uint8_t value )
+static uint32_t setup_tmst_config( uint8_t value )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 	
 	/* MREG1 Bankを指定しTMST_CONFIG1からデータ読み出し */
@@ -823,9 +818,9 @@ static nrfx_err_t setup_tmst_config( uint8_t value )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_fifo_config( uint8_t fifo_tmst_fsync_en, uint8_t fifo_acc_en, uint8_t fifo_gyro_en )
+static uint32_t setup_fifo_config( uint8_t fifo_tmst_fsync_en, uint8_t fifo_acc_en, uint8_t fifo_gyro_en )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 	
 	/* MREG1 Bankを指定しTMST_CONFIG1からデータ読み出し */
@@ -852,9 +847,9 @@ static nrfx_err_t setup_fifo_config( uint8_t fifo_tmst_fsync_en, uint8_t fifo_ac
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_acc_gyro_int_pin( void )
+static uint32_t setup_acc_gyro_int_pin( void )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t write_data = 0;
 
 	/* INT1/INT2 Setting Latched Mode and Active high */
@@ -876,9 +871,9 @@ static nrfx_err_t setup_acc_gyro_int_pin( void )
  * @retval NRF_SUCCESS Success
  * @retval NRF_SUCCESS以外 Failed
  */
-static nrfx_err_t setup_acc_gyro_fifo_flush( void )
+static uint32_t setup_acc_gyro_fifo_flush( void )
 {
-	volatile nrfx_err_t ret = 0;
+	volatile uint32_t ret = 0;
 	volatile uint8_t fifo_flush = ACC_GYRO_FIFO_FLUSH;
 	volatile uint8_t read_data = 0;
 	uint8_t i;
@@ -894,7 +889,7 @@ static nrfx_err_t setup_acc_gyro_fifo_flush( void )
 	for ( i = 0; i < WAIT_FIFO_FLUSH_RETRY; i++ )
 	{
 		/* 2us待ち */
-		nrf_delay_us( WAIT_FIFO_FLUSH_INTERVAL );
+		HalDelayUs( WAIT_FIFO_FLUSH_INTERVAL );
 		ret = SpiIORead( ICM42607_SIGNAL_PATH_RESET, (uint8_t *)&read_data, sizeof( read_data ) );
 		SPI_ERR_CHECK( ret, __LINE__ );
 		if ( ret == NRF_SUCCESS )
@@ -925,9 +920,9 @@ static nrfx_err_t setup_acc_gyro_fifo_flush( void )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_acc_gyro_wom_config( uint8_t value )
+static uint32_t setup_acc_gyro_wom_config( uint8_t value )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 
 	ret = SpiIORead( ICM42607_WOM_CONFIG, (uint8_t *)&read_data, sizeof( read_data ) );
@@ -956,9 +951,9 @@ static nrfx_err_t setup_acc_gyro_wom_config( uint8_t value )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_acc_config( uint8_t value )
+static uint32_t setup_acc_config( uint8_t value )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 
 	ret = SpiIORead( ICM42607_ACC_CONFIG1, (uint8_t *)&read_data, sizeof( read_data ) );
@@ -987,9 +982,9 @@ static nrfx_err_t setup_acc_config( uint8_t value )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_otp_config( uint8_t value )
+static uint32_t setup_otp_config( uint8_t value )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 	
 	/* MREG1 Bankを指定しOTP_CONFIGからデータ読み出し */
@@ -1016,9 +1011,9 @@ static nrfx_err_t setup_otp_config( uint8_t value )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t setup_otp_ctrl7( uint8_t value )
+static uint32_t setup_otp_ctrl7( uint8_t value )
 {
-	volatile nrfx_err_t ret;
+	volatile uint32_t ret;
 	volatile uint8_t read_data = 0;
 	
 	/* MREG2 Bankを指定しOTP_CTRL7からデータ読み出し */
@@ -1053,54 +1048,19 @@ static nrfx_err_t setup_otp_ctrl7( uint8_t value )
  */
 static uint32_t reader_acc_gyro_data( ACC_GYRO_DATA_INFO *acc_gyro_info )
 {
-	volatile nrfx_err_t err_code;
-	volatile uint8_t fifo_data[FIFO_OUT_SIZE] = {0};
-	volatile uint8_t current_mode;
+	volatile uint32_t err_code;
+	uint8_t fifo_data[FIFO_OUT_SIZE] = {0};
+	uint8_t current_mode;
 	
 	/* Read Tags + FIFO_OUT_DATA (Tag 1byte + Data 6byte) */
-	err_code = SpiIORead( ICM42607_FIFO_DATA, (uint8_t *)&fifo_data[0], sizeof( fifo_data ) );
+	err_code = SpiIORead( ICM42607_FIFO_DATA, &fifo_data[0], sizeof( fifo_data ) );
 	SPI_ERR_CHECK( err_code, __LINE__ );
 	if ( ( err_code == NRF_SUCCESS ) && ( fifo_data[0] != HEADER_FIFO_EMPTY ) )
 	{
-		acc_gyro_info->acc_x_data	= ( fifo_data[2] << 8 ) | fifo_data[1];
-		acc_gyro_info->acc_y_data	= ( fifo_data[4] << 8 ) | fifo_data[3];
-		acc_gyro_info->acc_z_data	= ( fifo_data[6] << 8 ) | fifo_data[5];
-		acc_gyro_info->gyro_x_data	= ( fifo_data[8] << 8 ) | fifo_data[7];
-		acc_gyro_info->gyro_y_data	= ( fifo_data[10] << 8 ) | fifo_data[9];
-		acc_gyro_info->gyro_z_data	= ( fifo_data[12] << 8 ) | fifo_data[11];
-		/* 2022.03.30 Modify TimestampだけLittle Endianではなくbig endianになっているため修正 */
-		acc_gyro_info->timestamp	= ( fifo_data[15] << 8 ) | fifo_data[14];
-		acc_gyro_info->temperature	= fifo_data[13];
-		acc_gyro_info->header		= fifo_data[0];
 		/* 現在のモードを取得 */
-		get_acc_gyro_mode( (void *)&current_mode );
-		if ( ( current_mode == MODE_GYRO_TEMP ) || ( current_mode == MODE_BOTH ) )
-		{
-			/* ACC Only以外の際にGyroデータを確認する */
-			if ( ( acc_gyro_info->gyro_x_data != GYRO_INVALID_DATA ) &&
-				 ( acc_gyro_info->gyro_y_data != GYRO_INVALID_DATA ) &&
-				 ( acc_gyro_info->gyro_z_data != GYRO_INVALID_DATA ) )
-			{
-				/* GYROデータが正常のデータの場合 */
-				err_code = ACC_GYRO_DATA_COMPLETE;
-			}
-			/* Gyroモードの場合、ACCに無効な値が入っているため0を代入 */
-			if ( current_mode == MODE_GYRO_TEMP )
-			{
-				acc_gyro_info->acc_x_data = 0;
-				acc_gyro_info->acc_y_data = 0;
-				acc_gyro_info->acc_z_data = 0;
-			}
-		}
-		else
-		{
-			/* ACC Onlyの場合は、Gyro Dataを無効な値に設定する */
-			acc_gyro_info->gyro_x_data = 0;
-			acc_gyro_info->gyro_y_data = 0;
-			acc_gyro_info->gyro_z_data = 0;
-			/* ACC Only */
-			err_code = ACC_GYRO_DATA_COMPLETE;
-		}
+		get_acc_gyro_mode( &current_mode );
+		/* 2026.10.19 Modify DecodeはAccGyroFifoDecode (lib_icm42607_fifo.c) に分離 */
+		err_code = AccGyroFifoDecode( &fifo_data[0], current_mode, acc_gyro_info );
 	}
 	
 	return err_code;
@@ -1112,9 +1072,9 @@ static uint32_t reader_acc_gyro_data( ACC_GYRO_DATA_INFO *acc_gyro_info )
  * @retval NRF_SUCCESS Success
  * @retval NRF_SUCCESS以外 Failed
  */
-static nrfx_err_t get_acc_gyro_fifo_count( uint16_t *fifo_count )
+static uint32_t get_acc_gyro_fifo_count( uint16_t *fifo_count )
 {
-	volatile nrfx_err_t err_code = 0;
+	volatile uint32_t err_code = 0;
 	volatile uint8_t read_data[2] = {0};
 	volatile uint16_t temp_data = 0;
 	volatile uint8_t int_status = 0;
@@ -1143,9 +1103,9 @@ static nrfx_err_t get_acc_gyro_fifo_count( uint16_t *fifo_count )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_read_device_id( void )
+static uint32_t acc_gyro_read_device_id( void )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 	uint8_t device_id = 0;
 
 	/* Device ID 読み出し */
@@ -1172,16 +1132,16 @@ static nrfx_err_t acc_gyro_read_device_id( void )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_power_down_mode( void )
+static uint32_t acc_gyro_power_down_mode( void )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 
 	/* ACC/Gyro ODR Power Down */
 	err_code = setup_acc_gyro_pwr_mgmt0( PWR_ACC_TURN_OFF, PWR_GYRO_TURN_OFF );
 	if ( err_code == NRF_SUCCESS )
 	{
 		/* モード変更時には100ms待ち実行 */
-		nrf_delay_ms( WAIT_MODE_CHANGE_INTERVAL );
+		HalDelayMs( WAIT_MODE_CHANGE_INTERVAL );
 	}
 	else
 	{
@@ -1198,9 +1158,9 @@ static nrfx_err_t acc_gyro_power_down_mode( void )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_softreset( void )
+static uint32_t acc_gyro_softreset( void )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 	uint16_t i;
 	uint8_t read_data = 0;
 	
@@ -1216,7 +1176,7 @@ static nrfx_err_t acc_gyro_softreset( void )
 	for ( i = 0; i < WAIT_SW_RESET_RETRY; i++ )
 	{
 		/* 500us待ち */
-		nrf_delay_us( WAIT_SW_RESET_INTERVAL );
+		HalDelayUs( WAIT_SW_RESET_INTERVAL );
 		err_code = SpiIORead( ICM42607_INT_STATUS, &read_data, sizeof( read_data ) );
 		SPI_ERR_CHECK( err_code, __LINE__ );
 		if ( err_code == NRF_SUCCESS )
@@ -1247,9 +1207,9 @@ static nrfx_err_t acc_gyro_softreset( void )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_otp_reload( void )
+static uint32_t acc_gyro_otp_reload( void )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 	
 	/* IDLE状態へ移行させる */
 	err_code = setup_acc_gyro_idle_ctrl( PWR_MGMT_RC_ON );
@@ -1261,7 +1221,7 @@ static nrfx_err_t acc_gyro_otp_reload( void )
 	}
 	
 	/* 10ms wait */
-	nrf_delay_ms( IDLE_WAIT_TIME );
+	HalDelayMs( IDLE_WAIT_TIME );
 
 	/* OTP_CONFIG */
 	err_code = setup_otp_config( OTP_CONFIG_VALUE );
@@ -1280,7 +1240,7 @@ static nrfx_err_t acc_gyro_otp_reload( void )
 	}
 	
 	/* Sleep 300us */
-	nrf_delay_us( WAIT_OTP_RELOAD_TIME );
+	HalDelayUs( WAIT_OTP_RELOAD_TIME );
 
 	/* OTP_CTRL7 Reload */
 	err_code = setup_otp_ctrl7( OTP_CTRL7_RESET_VAL );
@@ -1291,7 +1251,7 @@ static nrfx_err_t acc_gyro_otp_reload( void )
 	}
 
 	/* Sleep 300us */
-	nrf_delay_us( 280 );
+	HalDelayUs( 280 );
 
 	return err_code;
 }
@@ -1302,9 +1262,9 @@ static nrfx_err_t acc_gyro_otp_reload( void )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_odr_fsr( void )
+static uint32_t acc_gyro_odr_fsr( void )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 
 	/* IDLE状態へ移行させる */
 	err_code = setup_acc_gyro_idle_ctrl( PWR_MGMT_RC_ON );
@@ -1316,7 +1276,7 @@ static nrfx_err_t acc_gyro_odr_fsr( void )
 	}
 	
 	/* 10ms wait */
-	nrf_delay_ms( IDLE_WAIT_TIME );
+	HalDelayMs( IDLE_WAIT_TIME );
 
 	/* 割り込みPIN設定 */
 	err_code = setup_acc_gyro_int_pin();
@@ -1361,9 +1321,9 @@ static nrfx_err_t acc_gyro_odr_fsr( void )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_fifo_config( void )
+static uint32_t acc_gyro_fifo_config( void )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 
 	/* FIFO Report Format Setting */
 	err_code = setup_acc_gyro_fifo_format();
@@ -1429,9 +1389,9 @@ static nrfx_err_t acc_gyro_fifo_config( void )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_interrupt_ctrl_set( void )
+static uint32_t acc_gyro_interrupt_ctrl_set( void )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 
 	/* 割り込み設定(INT_SOURCE0) */
 	err_code = setup_acc_gyro_interrupt( ICM42607_INT_SOURCE0, FIFO_THS_INT1_EN | FIFO_FULL_INT1_EN );
@@ -1456,13 +1416,16 @@ static nrfx_err_t acc_gyro_interrupt_ctrl_set( void )
 
 /**
  * @brief ACC/Gyro INT1 Wake On Motion Threshold Setting
- * @param None
+ * @param x_thr X-Axis しきい値 (1g/256)
+ * @param y_thr Y-Axis しきい値 (1g/256)
+ * @param z_thr Z-Axis しきい値 (1g/256)
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_wom_setting( void )
+/* 2026.10.19 Modify Low Power常駐モードと共用するため、しきい値を引数に変更 */
+static uint32_t acc_gyro_wom_setting( uint8_t x_thr, uint8_t y_thr, uint8_t z_thr )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 	
 	/* IDLE状態へ移行させる */
 	err_code = setup_acc_gyro_idle_ctrl( PWR_MGMT_RC_ON );
@@ -1474,24 +1437,24 @@ static nrfx_err_t acc_gyro_wom_setting( void )
 	}
 
 	/* ACCEL_WOM_Y_THR : 1000mg (255/256 = 0.99609g (996.1mg)) */
-	err_code = setup_acc_gyro_wakeup_ths( ICM42607_MREG1_ACCEL_WOM_X_THR, WOM_X_AXIS_THR );
+	err_code = setup_acc_gyro_wakeup_ths( ICM42607_MREG1_ACCEL_WOM_X_THR, x_thr );
 	if ( err_code != NRF_SUCCESS )
 	{
-		register_setup_error_log( ICM42607_MREG1_ACCEL_WOM_Y_THR, WOM_Y_AXIS_THR, __LINE__ );
+		register_setup_error_log( ICM42607_MREG1_ACCEL_WOM_Y_THR, x_thr, __LINE__ );
 		return ACC_GYRO_SETEUP_ERROR;
 	}
 
-	err_code = setup_acc_gyro_wakeup_ths( ICM42607_MREG1_ACCEL_WOM_Y_THR, WOM_Y_AXIS_THR );
+	err_code = setup_acc_gyro_wakeup_ths( ICM42607_MREG1_ACCEL_WOM_Y_THR, y_thr );
 	if ( err_code != NRF_SUCCESS )
 	{
-		register_setup_error_log( ICM42607_MREG1_ACCEL_WOM_Y_THR, WOM_Y_AXIS_THR, __LINE__ );
+		register_setup_error_log( ICM42607_MREG1_ACCEL_WOM_Y_THR, y_thr, __LINE__ );
 		return ACC_GYRO_SETEUP_ERROR;
 	}
 	/* 2022.04.19 Add Z-Axis 閾値追加 ++ */
-	err_code = setup_acc_gyro_wakeup_ths( ICM42607_MREG1_ACCEL_WOM_Z_THR, WOM_Z_AXIS_THR );
+	err_code = setup_acc_gyro_wakeup_ths( ICM42607_MREG1_ACCEL_WOM_Z_THR, z_thr );
 	if ( err_code != NRF_SUCCESS )
 	{
-		register_setup_error_log( ICM42607_MREG1_ACCEL_WOM_Y_THR, WOM_Y_AXIS_THR, __LINE__ );
+		register_setup_error_log( ICM42607_MREG1_ACCEL_WOM_Y_THR, z_thr, __LINE__ );
 		return ACC_GYRO_SETEUP_ERROR;
 	}
 	/* 2022.04.19 Add Z-Axis 閾値追加 -- */
@@ -1533,9 +1496,9 @@ static nrfx_err_t acc_gyro_wom_setting( void )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_exec_mode_set( void )
+static uint32_t acc_gyro_exec_mode_set( void )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 	
 	err_code = setup_acc_gyro_pwr_mgmt0( PWR_ACC_LP_MODE, PWR_GYRO_TURN_OFF );
 	if ( err_code != NRF_SUCCESS )
@@ -1545,7 +1508,7 @@ static nrfx_err_t acc_gyro_exec_mode_set( void )
 	else
 	{
 		/* モード変更時には100ms待ち実行 */
-		nrf_delay_ms( WAIT_MODE_CHANGE_INTERVAL );
+		HalDelayMs( WAIT_MODE_CHANGE_INTERVAL );
 	}
 	
 //    SEGGER_RTT_printf(0, " %s %d Success\n", __FUNCTION__,err_code );	
@@ -1558,9 +1521,9 @@ static nrfx_err_t acc_gyro_exec_mode_set( void )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_poweroff_fifo_config( void )
+static uint32_t acc_gyro_poweroff_fifo_config( void )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 
 	/* FIFO Disable bypassモードに変更 */
 	err_code = setup_acc_gyro_fifo_mode( FIFO_BYPASS );
@@ -1588,14 +1551,19 @@ static nrfx_err_t acc_gyro_poweroff_fifo_config( void )
 }
 
 /**
- * @brief ACC/Gyro PowerOff Wakeup Setting
- * @param None
+ * @brief ACC/Gyro Wake On Motion Low Power Setting (FIFO無効, ACC Low Power 16g)
+ * @param odr ACC ODR
+ * @param int_source INT_SOURCE1 設定値 (WOM X/Y/Z)
+ * @param x_thr X-Axis WOMしきい値
+ * @param y_thr Y-Axis WOMしきい値
+ * @param z_thr Z-Axis WOMしきい値
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_poweroff_wakeup_set( void )
+/* 2026.10.19 Modify Low Power常駐モードと共用するため、割り込み/しきい値を引数に変更 */
+static uint32_t acc_gyro_wom_lp_config( uint8_t odr, uint8_t int_source, uint8_t x_thr, uint8_t y_thr, uint8_t z_thr )
 {
-	nrfx_err_t err_code = 0;
+	uint32_t err_code = 0;
 	
 	/* IDLE状態へ移行させる */
 	err_code = setup_acc_gyro_idle_ctrl( PWR_MGMT_RC_ON );
@@ -1637,25 +1605,25 @@ static nrfx_err_t acc_gyro_poweroff_wakeup_set( void )
 		return ACC_GYRO_SETEUP_ERROR;
 	}
 
-	/* 割り込み設定(INT_SOURCE1) Wake On Motion X or Y */
-	err_code = setup_acc_gyro_interrupt( ICM42607_INT_SOURCE1, INT1_WOM_X_EN | INT1_WOM_Y_EN );
+	/* 割り込み設定(INT_SOURCE1) Wake On Motion */
+	err_code = setup_acc_gyro_interrupt( ICM42607_INT_SOURCE1, int_source );
 	if ( err_code != NRF_SUCCESS )
 	{
 		return ACC_GYRO_SETEUP_ERROR;
 	}
 	/* WOM Threshold Setting */
-	err_code = acc_gyro_wom_setting();
+	err_code = acc_gyro_wom_setting( x_thr, y_thr, z_thr );
 	if ( err_code != NRF_SUCCESS )
 	{
 		return ACC_GYRO_SETEUP_ERROR;
 	}
 
 	/* ODR Setting */
-	/* ACC ODR/full-scale Setting 12.5Hz 16g */
-	err_code = setup_acc_gyro_sensor_odr_fss( ICM42607_ACC_CONFIG0, ACC_ODR_12_5HZ, ACC_FS_SEL_16G );
+	/* ACC ODR/full-scale Setting 16g */
+	err_code = setup_acc_gyro_sensor_odr_fss( ICM42607_ACC_CONFIG0, odr, ACC_FS_SEL_16G );
 	if ( err_code != NRF_SUCCESS )
 	{
-		register_setup_error_log( ICM42607_ACC_CONFIG0, ACC_ODR_12_5HZ | ACC_FS_SEL_16G, __LINE__ );
+		register_setup_error_log( ICM42607_ACC_CONFIG0, odr | ACC_FS_SEL_16G, __LINE__ );
 		return ACC_GYRO_SETEUP_ERROR;
 	}
 
@@ -1677,15 +1645,50 @@ static nrfx_err_t acc_gyro_poweroff_wakeup_set( void )
 	return err_code;
 }
 
+/**
+ * @brief ACC/Gyro PowerOff Wakeup Setting
+ * @param None
+ * @retval NRF_SUCCESS Success
+ * @retval ACC_GYRO_SETEUP_ERROR Setup Error
+ */
+static uint32_t acc_gyro_poweroff_wakeup_set( void )
+{
+	/* Wake On Motion X or Y (12.5Hz) */
+	return acc_gyro_wom_lp_config( ACC_ODR_12_5HZ, INT1_WOM_X_EN | INT1_WOM_Y_EN, WOM_X_AXIS_THR, WOM_Y_AXIS_THR, WOM_Z_AXIS_THR );
+}
+
+/* 2026.10.19 Add Low Power常駐モード ++ */
+/**
+ * @brief ACC/Gyro Low Power常駐モード Setting
+ * @param None
+ * @retval NRF_SUCCESS Success
+ * @retval ACC_GYRO_SETEUP_ERROR Setup Error
+ */
+static uint32_t acc_gyro_lowpower_wom_set( void )
+{
+	uint32_t err_code;
+
+	/* Wake On Motion X or Y or Z (傾きの変化を検出できるよう、しきい値はWakeUpより低くする) */
+	err_code = acc_gyro_wom_lp_config( ACC_LP_ODR, INT1_WOM_X_EN | INT1_WOM_Y_EN | INT1_WOM_Z_EN, WOM_LP_AXIS_THR, WOM_LP_AXIS_THR, WOM_LP_AXIS_THR );
+	if ( err_code == NRF_SUCCESS )
+	{
+		/* Setup INT1 GPIO Interrupt */
+		setup_acc_gyro_gpio_pin_wom();
+	}
+
+	return err_code;
+}
+/* 2026.10.19 Add Low Power常駐モード -- */
+
 /**
  * @brief ACC/Gyro Reconfig Interrupt Setting
  * @param value Interrupt Setting Value
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t acc_gyro_reconfig_interrupt( uint8_t value )
+static uint32_t acc_gyro_reconfig_interrupt( uint8_t value )
 {
-	nrfx_err_t err_code = 0;
+	uint32_t err_code = 0;
 	volatile uint8_t int_status = 0;
 
 	/* 割り込みを設定 */
@@ -1710,9 +1713,9 @@ static nrfx_err_t acc_gyro_reconfig_interrupt( uint8_t value )
  * @retval NRF_SUCCESS Success
  * @retval ACC_GYRO_SETEUP_ERROR Setup Error
  */
-static nrfx_err_t reconfig_operation_mode( uint8_t acc_mode, uint8_t gyro_mode )
+static uint32_t reconfig_operation_mode( uint8_t acc_mode, uint8_t gyro_mode )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 
 	/* ODR Power Down */
 	err_code = acc_gyro_power_down_mode();
@@ -1730,7 +1733,7 @@ static nrfx_err_t reconfig_operation_mode( uint8_t acc_mode, uint8_t gyro_mode )
 	}
 	
 	/* 10ms wait */
-	nrf_delay_ms( IDLE_WAIT_TIME );
+	HalDelayMs( IDLE_WAIT_TIME );
 	
 	/* 割り込みを一度無効に設定 */
 	err_code = acc_gyro_reconfig_interrupt( INT1_NONE );
@@ -1767,7 +1770,7 @@ static nrfx_err_t reconfig_operation_mode( uint8_t acc_mode, uint8_t gyro_mode )
 	if ( err_code == NRF_SUCCESS )
 	{
 		/* Reconfig時は、100ms待ち */
-		nrf_delay_ms( WAIT_RECONFIG_MODE_CHANGE );
+		HalDelayMs( WAIT_RECONFIG_MODE_CHANGE );
 	}
 	else
 	{
@@ -1832,7 +1835,7 @@ static void acc_gyro_calculation( ACC_GYRO_DATA_INFO *calc_data )
  * @param line Execution Line
  * @retval None
  */
-__STATIC_INLINE void register_setup_error_log( uint8_t reg_addr, uint8_t set_val, uint32_t line )
+static inline void register_setup_error_log( uint8_t reg_addr, uint8_t set_val, uint32_t line )
 {
 //	DEBUG_LOG( LOG_ERROR, "register=0x%x val=0x%x line=%d", reg_addr, set_val, line );
 	SEGGER_RTT_printf( 0, "register=0x%x val=0x%x line=%d\n", reg_addr, set_val, line );
@@ -1847,7 +1850,7 @@ __STATIC_INLINE void register_setup_error_log( uint8_t reg_addr, uint8_t set_val
  */
 uint32_t AccGyroRegReset( void )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 	uint32_t ret = UTC_SUCCESS;
 	uint16_t i;
 	const ACC_GYRO_FUNC_TABLE acc_gyro_reg_table[] = {
@@ -1856,6 +1859,9 @@ uint32_t AccGyroRegReset( void )
 		{	2,	&acc_gyro_otp_reload			},			/* OTP Reload */
 	};
 	
+	/* 2026.10.19 Add Low Power常駐モードの設定が消えるため再設定させる */
+	g_acc_gyro_lp_configured = false;
+
 	/* SPI Function Initialize */
 	err_code = SpiInit();
 	if ( err_code == NRF_SUCCESS )
@@ -1899,8 +1905,7 @@ uint32_t AccGyroRegReset( void )
 		TRACE_LOG( TR_ACC_RESET_CMPL, 0 );
 #if 0
 		/* 2022.03.24 Test GPIO Output 割り込み時間計測テスト ++ */
-		nrf_gpio_cfg_output( GPIO_UART_RX_PIN );
-		nrf_gpio_pin_clear( GPIO_UART_RX_PIN );
+		HalGpioWrite( GPIO_UART_RX_PIN, false );
 		/* 2022.03.24 Test GPIO Output 割り込み時間計測テスト -- */
 #endif
 	}
@@ -1916,7 +1921,7 @@ uint32_t AccGyroRegReset( void )
  */
 uint32_t AccGyroInitialize( uint32_t previous_err )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 	uint32_t ret = UTC_SUCCESS;
 	uint16_t i;
 	const ACC_GYRO_FUNC_TABLE acc_gyro_init_table[] = {
@@ -1933,6 +1938,9 @@ uint32_t AccGyroInitialize( uint32_t previous_err )
 		return UTC_THROUGH_ERROR;
 	}
 	
+	/* 2026.10.19 Add Low Power常駐モードの設定が変わるため再設定させる */
+	g_acc_gyro_lp_configured = false;
+
 	/* 2020.12.08 Add Clear FIFO Count ++ */
 	AccGyroClearFifoCount();
 	/* 2020.12.08 Add Clear FIFO Count -- */
@@ -1945,7 +1953,7 @@ uint32_t AccGyroInitialize( uint32_t previous_err )
 		{
 			if ( err_code == NRF_SUCCESS )
 			{
-				nrf_delay_us( 500 );
+				HalDelayUs( 500 );
 				/* Registor Reset関数呼び出し */
 				err_code = acc_gyro_init_table[i].func();
 			}
@@ -1961,8 +1969,8 @@ uint32_t AccGyroInitialize( uint32_t previous_err )
 		if ( ret == UTC_SUCCESS )
 		{
 			/* 割り込み有効化 */
-			nrfx_gpiote_in_event_enable( ACC_INT1_PIN, true );
-			nrfx_gpiote_in_event_enable( ACC_INT2_PIN, true );
+			HalGpioIntEnable( ACC_INT1_PIN );
+			HalGpioIntEnable( ACC_INT2_PIN );
 		}
 	}
 	else
@@ -2005,7 +2013,7 @@ uint32_t AccGyroInitialize( uint32_t previous_err )
  */
 uint32_t AccGyroWakeUpSetting( uint32_t previous_err )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 	uint32_t ret = UTC_SUCCESS;
 	uint16_t i;
 	const ACC_GYRO_FUNC_TABLE acc_gyro_wakeup_table[] = {
@@ -2019,6 +2027,9 @@ uint32_t AccGyroWakeUpSetting( uint32_t previous_err )
 		return UTC_THROUGH_ERROR;
 	}
 
+	/* 2026.10.19 Add Low Power常駐モードの設定が変わるため再設定させる */
+	g_acc_gyro_lp_configured = false;
+
 	/* WakeUp PIN Setting */
 	setup_acc_gyro_gpio_pin_wakeup();
 
@@ -2033,7 +2044,7 @@ uint32_t AccGyroWakeUpSetting( uint32_t previous_err )
 				/* Registor Reset関数呼び出し */
 				err_code = acc_gyro_wakeup_table[i].func();
 				/* レジスタ反映待ち 500us */
-				nrf_delay_us( WAIT_REG_SETUP_TIME );
+				HalDelayUs( WAIT_REG_SETUP_TIME );
 			}
 			else
 			{
@@ -2077,7 +2088,7 @@ uint32_t AccGyroWakeUpSetting( uint32_t previous_err )
  */
 uint32_t AccGyroReadIntSrc( uint8_t *x_int, uint8_t *y_int, uint8_t *z_int )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 	uint32_t ret = UTC_SUCCESS;
 	uint8_t wakeup_src_val = 0;
 	
@@ -2165,7 +2176,7 @@ uint32_t AccGyroReadIntSrc( uint8_t *x_int, uint8_t *y_int, uint8_t *z_int )
  */
 uint32_t AccGyroReconfig( uint8_t mode_number )
 {
-	nrfx_err_t err_code;
+	uint32_t err_code;
 	uint32_t ret = UTC_SUCCESS;
 	uint16_t i;
 	const struct _operaton_mode_info
@@ -2183,6 +2194,9 @@ uint32_t AccGyroReconfig( uint8_t mode_number )
 	/* 割り込みを無効に設定 */
 	AccGyroDisableGpioInt( ACC_INT1_PIN );
 	
+	/* 2026.10.19 Add Low Power常駐モードの設定が変わるため再設定させる */
+	g_acc_gyro_lp_configured = false;
+
 	/* SPI Function Initialize */
 	err_code = SpiInit();
 	if ( err_code == NRF_SUCCESS )
@@ -2274,10 +2288,8 @@ void AccGyroCalcData( ACC_GYRO_DATA_INFO *acc_gyro_info )
  */
 void AccGyroEnableGpioInt( uint32_t pin )
 {
-	/* Latch Clear */
-	nrf_gpio_pin_latch_clear( pin );
-	/* Interrupt Enable */
-	nrfx_gpiote_in_event_enable( pin, true );
+	/* Latch Clear後に割り込み有効 */
+	HalGpioIntEnable( pin );
 }
 
 /**
@@ -2288,9 +2300,7 @@ void AccGyroEnableGpioInt( uint32_t pin )
 void AccGyroDisableGpioInt( uint32_t pin )
 {
 	/* 割り込みを無効にしてLatchをクリアする */
-	nrfx_gpiote_in_event_disable( pin );
-	/* Latch Clear */
-	nrf_gpio_pin_latch_clear( pin );
+	HalGpioIntDisable( pin );
 }
 
 /**
@@ -2300,24 +2310,11 @@ void AccGyroDisableGpioInt( uint32_t pin )
  */
 void AccGyroSetSid( uint16_t sid )
 {
-	volatile uint32_t err_code;
-	uint8_t  acc_gyro_sid_session;
+	uint8_t acc_gyro_sid_session;
 	
-	err_code = sd_nvic_critical_region_enter( &acc_gyro_sid_session );
-	if(err_code == NRF_SUCCESS)
-	{
-		g_send_sid = sid;
-		acc_gyro_sid_session = 0;
-		err_code = sd_nvic_critical_region_exit( acc_gyro_sid_session );
-		if(err_code != NRF_SUCCESS)
-		{
-			DEBUG_LOG( LOG_ERROR, "!!! Set ACC/Gyro SID Clear critical Exit !!!" );
-		}
-	}
-	else
-	{
-		DEBUG_LOG( LOG_ERROR, "!!! Set ACC/Gyro SID Clear critical Enter !!!" );
-	}
+	HalCriticalEnter( &acc_gyro_sid_session );
+	g_send_sid = sid;
+	HalCriticalExit( acc_gyro_sid_session );
 }
 
 /**
@@ -2327,26 +2324,13 @@ void AccGyroSetSid( uint16_t sid )
  */
 uint16_t AccGyroIncSid( void )
 {
-	volatile uint32_t err_code;
 	volatile uint16_t sid;
-	uint8_t  acc_gyro_sid_session;
+	uint8_t acc_gyro_sid_session;
 	
-	err_code = sd_nvic_critical_region_enter( &acc_gyro_sid_session );
-	if(err_code == NRF_SUCCESS)
-	{
-		sid = g_send_sid;
-		g_send_sid++;
-		acc_gyro_sid_session = 0;
-		err_code = sd_nvic_critical_region_exit( acc_gyro_sid_session );
-		if(err_code != NRF_SUCCESS)
-		{
-			DEBUG_LOG( LOG_ERROR, "!!! Get ACC/Gyro Inc critical Exit !!!" );
-		}
-	}
-	else
-	{
-		DEBUG_LOG( LOG_ERROR, "!!! Get ACC/Gyro Inc critical Enter !!!" );
-	}
+	HalCriticalEnter( &acc_gyro_sid_session );
+	sid = g_send_sid;
+	g_send_sid++;
+	HalCriticalExit( acc_gyro_sid_session );
 	
 	return sid;
 }
@@ -2358,24 +2342,11 @@ uint16_t AccGyroIncSid( void )
  */
 void AccGyroClearFifoCount( void )
 {
-	volatile uint32_t err_code;
-	uint8_t  acc_gyro_fifo_count_session;
+	uint8_t acc_gyro_fifo_count_session;
 	
-	err_code = sd_nvic_critical_region_enter( &acc_gyro_fifo_count_session );
-	if(err_code == NRF_SUCCESS)
-	{
-		g_fifo_count = 0;
-		acc_gyro_fifo_count_session = 0;
-		err_code = sd_nvic_critical_region_exit( acc_gyro_fifo_count_session );
-		if(err_code != NRF_SUCCESS)
-		{
-			DEBUG_LOG( LOG_ERROR, "!!! Set ACC/Gyro FIFO Count Clear Exit !!!" );
-		}
-	}
-	else
-	{
-		DEBUG_LOG( LOG_ERROR, "!!! Set ACC/Gyro FIFO Count Clear Enter !!!" );
-	}
+	HalCriticalEnter( &acc_gyro_fifo_count_session );
+	g_fifo_count = 0;
+	HalCriticalExit( acc_gyro_fifo_count_session );
 }
 
 /**
@@ -2385,27 +2356,14 @@ void AccGyroClearFifoCount( void )
  */
 void AccGyroIncFifoCount( void )
 {
-	volatile uint32_t err_code;
-	uint8_t  acc_gyro_fifo_count_session;
+	uint8_t acc_gyro_fifo_count_session;
 	
-	err_code = sd_nvic_critical_region_enter( &acc_gyro_fifo_count_session );
-	if(err_code == NRF_SUCCESS)
-	{
-		if ( g_fifo_count < 40 )
-		{
-			g_fifo_count++;
-		}
-		acc_gyro_fifo_count_session = 0;
-		err_code = sd_nvic_critical_region_exit( acc_gyro_fifo_count_session );
-		if(err_code != NRF_SUCCESS)
-		{
-			DEBUG_LOG( LOG_ERROR, "!!! Get ACC/Gyro FIFO Count critical Exit !!!" );
-		}
-	}
-	else
+	HalCriticalEnter( &acc_gyro_fifo_count_session );
+	if ( g_fifo_count < 40 )
 	{
-		DEBUG_LOG( LOG_ERROR, "!!! Get ACC/Gyro FIFO Count critical Enter !!!" );
+		g_fifo_count++;
 	}
+	HalCriticalExit( acc_gyro_fifo_count_session );
 }
 
 /**
@@ -2415,29 +2373,16 @@ void AccGyroIncFifoCount( void )
  */
 uint16_t AccGyroSubFifoCount( void )
 {
-	volatile uint32_t err_code;
 	volatile uint16_t fifo_count = 0;
-	uint8_t  acc_gyro_fifo_count_session;
+	uint8_t acc_gyro_fifo_count_session;
 	
-	err_code = sd_nvic_critical_region_enter( &acc_gyro_fifo_count_session );
-	if(err_code == NRF_SUCCESS)
+	HalCriticalEnter( &acc_gyro_fifo_count_session );
+	if ( g_fifo_count > 0 )
 	{
-		if ( g_fifo_count > 0 )
-		{
-			g_fifo_count--;
-			fifo_count = g_fifo_count;
-		}
-		acc_gyro_fifo_count_session = 0;
-		err_code = sd_nvic_critical_region_exit( acc_gyro_fifo_count_session );
-		if(err_code != NRF_SUCCESS)
-		{
-			DEBUG_LOG( LOG_ERROR, "!!! Get ACC/Gyro FIFO Count critical Exit !!!" );
-		}
-	}
-	else
-	{
-		DEBUG_LOG( LOG_ERROR, "!!! Get ACC/Gyro FIFO Count critical Enter !!!" );
+		g_fifo_count--;
+		fifo_count = g_fifo_count;
 	}
+	HalCriticalExit( acc_gyro_fifo_count_session );
 	
 	return fifo_count;
 }
@@ -2449,25 +2394,12 @@ uint16_t AccGyroSubFifoCount( void )
  */
 uint16_t AccGyroGetFifoCount( void )
 {
-	volatile uint32_t err_code;
 	volatile uint16_t fifo_count = 0;
-	uint8_t  acc_gyro_fifo_count_session;
+	uint8_t acc_gyro_fifo_count_session;
 	
-	err_code = sd_nvic_critical_region_enter( &acc_gyro_fifo_count_session );
-	if(err_code == NRF_SUCCESS)
-	{
-		fifo_count = g_fifo_count;
-		acc_gyro_fifo_count_session = 0;
-		err_code = sd_nvic_critical_region_exit( acc_gyro_fifo_count_session );
-		if(err_code != NRF_SUCCESS)
-		{
-			DEBUG_LOG( LOG_ERROR, "!!! Get ACC/Gyro FIFO Count critical Exit !!!" );
-		}
-	}
-	else
-	{
-		DEBUG_LOG( LOG_ERROR, "!!! Get ACC/Gyro FIFO Count critical Enter !!!" );
-	}
+	HalCriticalEnter( &acc_gyro_fifo_count_session );
+	fifo_count = g_fifo_count;
+	HalCriticalExit( acc_gyro_fifo_count_session );
 	
 	return fifo_count;
 }
@@ -2673,4 +2605,204 @@ void AccGyroOneshotAcc( float* fax, float* fay, float* faz)
 	}
 	SpiUninit();	
 
-}
\ No newline at end of file
+}
+
+/* 2026.10.19 Add Low Power常駐モード ++ */
+/**
+ * @brief ACC/Gyro Low Power常駐モード開始 (設定済みの場合は何もしない)
+ * @remark ACC Low Power (ACC_LP_ODR) / FIFO無効 / INT1 Wake On Motionに設定し、以降は設定し直さない.
+ *         AccGyroReadAccSampleがErrorを返した場合, または他のモード設定を行った場合のみ再設定する
+ * @param previous_err 一つ前の処理結果
+ * @retval UTC_SUCCESS Success
+ * @retval UTC_SPI_ERROR Error
+ */
+uint32_t AccGyroLowPowerStart( uint32_t previous_err )
+{
+	uint32_t err_code;
+	uint32_t ret = UTC_SUCCESS;
+	uint16_t i = 0;
+	const ACC_GYRO_FUNC_TABLE acc_gyro_lowpower_table[] = {
+		{	0,	&acc_gyro_read_device_id		},			/* WHO_AM_I(0Fh)レジスタ読み出し */
+		{	1,	&acc_gyro_power_down_mode		},			/* ACC/Gyro Power Down Mode設定(PWR_MGMT0) */
+		{	2,	&acc_gyro_softreset				},			/* Software Reset */
+		{	3,	&acc_gyro_lowpower_wom_set		},			/* Low Power + Wake On Motion Setting */
+	};
+
+	if ( previous_err != UTC_SUCCESS )
+	{
+		return UTC_THROUGH_ERROR;
+	}
+
+	if ( g_acc_gyro_lp_configured == true )
+	{
+		return UTC_SUCCESS;
+	}
+
+	/* 設定中のWOM割り込みは受け付けない */
+	AccGyroDisableGpioInt( ACC_INT1_PIN );
+	g_acc_gyro_wom_event = false;
+
+	/* SPI Function Initialize */
+	err_code = SpiInit();
+	if ( err_code == NRF_SUCCESS )
+	{
+		for ( i = 0; i < sizeof( acc_gyro_lowpower_table ) / sizeof( ACC_GYRO_FUNC_TABLE ); i++ )
+		{
+			/* Registor設定関数呼び出し */
+			err_code = acc_gyro_lowpower_table[i].func();
+			if ( err_code != NRF_SUCCESS )
+			{
+				/* エラー時 */
+				ret = UTC_SPI_ERROR;
+				break;
+			}
+			/* レジスタ反映待ち 500us */
+			HalDelayUs( WAIT_REG_SETUP_TIME );
+		}
+		/* 終了処理 */
+		SpiUninit();
+	}
+	else
+	{
+		/* SPI Initialize Error */
+		ret = UTC_SPI_ERROR;
+	}
+
+	if ( ret != UTC_SUCCESS )
+	{
+		DEBUG_LOG( LOG_ERROR, "!!! Acc/Gyro Low Power Setting Error !!!" );
+		TRACE_LOG( TR_ACC_LP_INIT_FAIL, i );
+	}
+	else
+	{
+		set_acc_gyro_mode( MODE_ACC_ONLY_LP );
+		g_acc_gyro_lp_configured = true;
+		/* 割り込み有効化 */
+		HalGpioIntEnable( ACC_INT1_PIN );
+		DEBUG_LOG( LOG_INFO, "!!! Acc/Gyro Low Power Setting Complete !!!" );
+		TRACE_LOG( TR_ACC_LP_INIT_CMPL, 0 );
+	}
+
+	return ret;
+}
+
+/**
+ * @brief ACC Data Register から1 Sampleを読み出す (Low Power常駐モード, 生データ)
+ * @remark FIFOは使用せずACCEL_DATA_X1~Z0を1回のSPI転送で読み出し, INT_STATUS2を読んでWOMをクリアする.
+ *         SPI Errorの場合は次回のAccGyroLowPowerStartで再設定する
+ * @param x X-Axis [LSB] (ACC_LP_SENSITIVITY LSB/g)
+ * @param y Y-Axis [LSB]
+ * @param z Z-Axis [LSB]
+ * @retval UTC_SUCCESS Success
+ * @retval UTC_ERROR Data未更新 (前回の値を保持)
+ * @retval UTC_SPI_ERROR Error
+ */
+uint32_t AccGyroReadAccRaw( int16_t *x, int16_t *y, int16_t *z )
+{
+	uint32_t err_code;
+	uint32_t ret = UTC_SUCCESS;
+	uint8_t acc_data[ICM42607_ACCEL_DATA_Z0 - ICM42607_ACCEL_DATA_X1 + 1] = {0};
+	uint8_t wom_status = 0;
+	int16_t acc_x;
+	int16_t acc_y;
+	int16_t acc_z;
+
+	if ( g_acc_gyro_lp_configured == false )
+	{
+		return UTC_ERROR;
+	}
+
+	/* SPI Function Initialize */
+	err_code = SpiInit();
+	if ( err_code == NRF_SUCCESS )
+	{
+		/* ACCEL_DATA_X1~Z0 (Software Reset後のためBig Endian) */
+		err_code = SpiIORead( ICM42607_ACCEL_DATA_X1, acc_data, sizeof( acc_data ) );
+		SPI_ERR_CHECK( err_code, __LINE__ );
+		if ( err_code == NRF_SUCCESS )
+		{
+			/* WOM割り込みクリア */
+			err_code = SpiIORead( ICM42607_INT_STATUS2, &wom_status, sizeof( wom_status ) );
+			SPI_ERR_CHECK( err_code, __LINE__ );
+		}
+		/* 終了処理 */
+		SpiUninit();
+		if ( err_code != NRF_SUCCESS )
+		{
+			ret = UTC_SPI_ERROR;
+		}
+	}
+	else
+	{
+		/* SPI Initialize Error */
+		ret = UTC_SPI_ERROR;
+	}
+
+	if ( ret != UTC_SUCCESS )
+	{
+		/* 設定が失われている可能性があるため再設定させる */
+		g_acc_gyro_lp_configured = false;
+		TRACE_LOG( TR_ACC_READ_INT_ERROR, 2 );
+		return ret;
+	}
+
+	acc_x = (int16_t)( ( acc_data[0] << 8 ) | acc_data[1] );
+	acc_y = (int16_t)( ( acc_data[2] << 8 ) | acc_data[3] );
+	acc_z = (int16_t)( ( acc_data[4] << 8 ) | acc_data[5] );
+	if ( ( acc_x == ACC_INVALID_DATA ) || ( acc_y == ACC_INVALID_DATA ) || ( acc_z == ACC_INVALID_DATA ) )
+	{
+		/* 起動直後などでDataが未更新 */
+		return UTC_ERROR;
+	}
+
+	*x = acc_x;
+	*y = acc_y;
+	*z = acc_z;
+
+	return ret;
+}
+
+/**
+ * @brief ACC Data Register から1 Sampleを読み出す (Low Power常駐モード)
+ * @param fax X-Axis [g]
+ * @param fay Y-Axis [g]
+ * @param faz Z-Axis [g]
+ * @retval AccGyroReadAccRawと同じ
+ */
+uint32_t AccGyroReadAccSample( float *fax, float *fay, float *faz )
+{
+	uint32_t ret;
+	int16_t acc_x;
+	int16_t acc_y;
+	int16_t acc_z;
+
+	ret = AccGyroReadAccRaw( &acc_x, &acc_y, &acc_z );
+	if ( ret == UTC_SUCCESS )
+	{
+		*fax = (float)acc_x / ACC_LP_SENSITIVITY;
+		*fay = (float)acc_y / ACC_LP_SENSITIVITY;
+		*faz = (float)acc_z / ACC_LP_SENSITIVITY;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief WOM割り込みの有無を取得してクリア
+ * @param None
+ * @retval true WOM割り込みあり
+ * @retval false WOM割り込みなし
+ */
+bool AccGyroGetWomEvent( void )
+{
+	uint8_t acc_gyro_wom_session;
+	bool event;
+
+	HalCriticalEnter( &acc_gyro_wom_session );
+	event = g_acc_gyro_wom_event;
+	g_acc_gyro_wom_event = false;
+	HalCriticalExit( acc_gyro_wom_session );
+
+	return event;
+}
+/* 2026.10.19 Add Low Power常駐モード -- */
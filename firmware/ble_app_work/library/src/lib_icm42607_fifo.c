@@ -0,0 +1,76 @@
+/**
+  ******************************************************************************************
+  * @file    lib_icm42607_fifo.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   ICM42607 FIFO Packet Decode
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new (lib_icm42607のreader_acc_gyro_dataから分離)
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include <stddef.h>
+#include "lib_icm42607_fifo.h"
+
+/**
+ * @brief FIFO PacketをDecodeする
+ * @param p_fifo FIFO Packet (ACC_GYRO_FIFO_PACKET_SIZE byte)
+ * @param mode 現在の動作モード (ACC_GYRO_EXEC_MODE)
+ * @param acc_gyro_info 格納先 (sidは変更しない)
+ * @retval ACC_GYRO_DATA_COMPLETE 格納するData
+ * @retval 0 格納しない (FIFO Empty/Gyroが無効なData)
+ */
+uint32_t AccGyroFifoDecode( const uint8_t *p_fifo, uint8_t mode, ACC_GYRO_DATA_INFO *acc_gyro_info )
+{
+	uint32_t ret = 0;
+
+	if ( ( p_fifo == NULL ) || ( acc_gyro_info == NULL ) || ( p_fifo[0] == HEADER_FIFO_EMPTY ) )
+	{
+		return ret;
+	}
+
+	acc_gyro_info->acc_x_data	= ( p_fifo[2] << 8 ) | p_fifo[1];
+	acc_gyro_info->acc_y_data	= ( p_fifo[4] << 8 ) | p_fifo[3];
+	acc_gyro_info->acc_z_data	= ( p_fifo[6] << 8 ) | p_fifo[5];
+	acc_gyro_info->gyro_x_data	= ( p_fifo[8] << 8 ) | p_fifo[7];
+	acc_gyro_info->gyro_y_data	= ( p_fifo[10] << 8 ) | p_fifo[9];
+	acc_gyro_info->gyro_z_data	= ( p_fifo[12] << 8 ) | p_fifo[11];
+	/* 2022.03.30 Modify TimestampだけLittle Endianではなくbig endianになっているため修正 */
+	acc_gyro_info->timestamp	= ( p_fifo[15] << 8 ) | p_fifo[14];
+	acc_gyro_info->temperature	= p_fifo[13];
+	acc_gyro_info->header		= p_fifo[0];
+	if ( ( mode == MODE_GYRO_TEMP ) || ( mode == MODE_BOTH ) )
+	{
+		/* ACC Only以外の際にGyroデータを確認する */
+		if ( ( acc_gyro_info->gyro_x_data != GYRO_INVALID_DATA ) &&
+			 ( acc_gyro_info->gyro_y_data != GYRO_INVALID_DATA ) &&
+			 ( acc_gyro_info->gyro_z_data != GYRO_INVALID_DATA ) )
+		{
+			/* GYROデータが正常のデータの場合 */
+			ret = ACC_GYRO_DATA_COMPLETE;
+		}
+		/* Gyroモードの場合、ACCに無効な値が入っているため0を代入 */
+		if ( mode == MODE_GYRO_TEMP )
+		{
+			acc_gyro_info->acc_x_data = 0;
+			acc_gyro_info->acc_y_data = 0;
+			acc_gyro_info->acc_z_data = 0;
+		}
+	}
+	else
+	{
+		/* ACC Onlyの場合は、Gyro Dataを無効な値に設定する */
+		acc_gyro_info->gyro_x_data = 0;
+		acc_gyro_info->gyro_y_data = 0;
+		acc_gyro_info->gyro_z_data = 0;
+		/* ACC Only */
+		ret = ACC_GYRO_DATA_COMPLETE;
+	}
+
+	return ret;
+}
@@ -0,0 +1,353 @@
+/**
+  ******************************************************************************************
+  * @file    lib_notify_queue.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   BLE Notify Queue (TX Complete駆動の送信Queue)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         送信Byte数の統計情報を追加(BLE Profileで使用)
+  * 1.2            2026/10/19       k.tashiro         Connection Handle取得をInit時に登録, 最新値のみ送信するNotify(Coalesce)を追加
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include "lib_notify_queue.h"
+#include "lib_common.h"
+#include "definition.h"
+#include "lib_trace_log.h"
+#include "app_util_platform.h"
+
+/* Struct ----------------------------------------------------------------*/
+/* Notify Queue Item (Payloadはコピーして保持する) */
+typedef struct _notify_queue_item
+{
+	uint16_t handle;
+	uint16_t len;
+	bool     latest;			/* true : NotifyQueueSendLatestで保持 (上書き可) */
+	uint8_t  data[NOTIFY_QUEUE_DATA_MAX];
+} NOTIFY_QUEUE_ITEM;
+
+/* Private variables -----------------------------------------------------*/
+static NOTIFY_QUEUE_ITEM g_notify_queue[NOTIFY_QUEUE_SIZE];
+static volatile uint8_t g_notify_queue_head = 0;
+static volatile uint8_t g_notify_queue_count = 0;
+static NOTIFY_QUEUE_STATS g_notify_queue_stats = {0};
+static void (*g_notify_queue_get_conn_handle)( uint16_t *p_conn_handle ) = NULL;
+
+/**
+ * @brief 接続中のConnection Handle取得
+ * @param None
+ * @retval Connection Handle (未接続時はBLE_CONN_HANDLE_INVALID)
+ */
+static uint16_t notify_queue_conn_handle( void )
+{
+	uint16_t cnt_handle = BLE_CONN_HANDLE_INVALID;
+
+	if ( g_notify_queue_get_conn_handle != NULL )
+	{
+		g_notify_queue_get_conn_handle( &cnt_handle );
+	}
+	return cnt_handle;
+}
+
+/**
+ * @brief SoftDeviceへNotifyを渡す
+ * @param handle Characteristic Value Handle
+ * @param p_data Payload
+ * @param len Payload Size
+ * @retval sd_ble_gatts_hvxの戻り値
+ */
+static uint32_t notify_queue_hvx( uint16_t handle, const uint8_t *p_data, uint16_t len )
+{
+	ble_gatts_hvx_params_t notify_param;
+	uint16_t notify_len = len;
+
+	notify_param.handle = handle;
+	notify_param.type   = BLE_GATT_HVX_NOTIFICATION;
+	notify_param.offset = BLE_NOTIFY_OFFSET;
+	notify_param.p_data = p_data;
+	notify_param.p_len  = &notify_len;
+
+	return sd_ble_gatts_hvx( notify_queue_conn_handle(), &notify_param );
+}
+
+/**
+ * @brief SoftDevice Queue Fullかどうか (TX Complete待ちで再送可能なError)
+ * @param err_code sd_ble_gatts_hvxの戻り値
+ * @retval true 再送可能
+ * @retval false 再送不可
+ */
+static bool notify_queue_is_retry_err( uint32_t err_code )
+{
+	return ( ( err_code == NRF_ERROR_RESOURCES ) || ( err_code == NRF_ERROR_BUSY ) );
+}
+
+/**
+ * @brief Notify Queueの末尾に追加 (Critical Region内から呼び出す)
+ * @param handle Characteristic Value Handle
+ * @param p_data Payload
+ * @param len Payload Size
+ * @param latest true : 末尾の同じHandleの最新値Notifyを上書きする
+ * @retval NRF_SUCCESS Success
+ * @retval NRF_ERROR_NO_MEM Queue Full
+ */
+static uint32_t notify_queue_put( uint16_t handle, const uint8_t *p_data, uint16_t len, bool latest )
+{
+	NOTIFY_QUEUE_ITEM *p_item;
+
+	if ( ( latest == true ) && ( g_notify_queue_count != 0 ) )
+	{
+		p_item = &g_notify_queue[( g_notify_queue_head + g_notify_queue_count - 1 ) % NOTIFY_QUEUE_SIZE];
+		if ( ( p_item->latest == true ) && ( p_item->handle == handle ) )
+		{
+			/* 送信待ちの古い値は送らない */
+			p_item->len = len;
+			memcpy( p_item->data, p_data, len );
+			g_notify_queue_stats.coalesce_count++;
+			return NRF_SUCCESS;
+		}
+	}
+
+	if ( g_notify_queue_count >= NOTIFY_QUEUE_SIZE )
+	{
+		g_notify_queue_stats.drop_full_count++;
+		return NRF_ERROR_NO_MEM;
+	}
+
+	p_item = &g_notify_queue[( g_notify_queue_head + g_notify_queue_count ) % NOTIFY_QUEUE_SIZE];
+	p_item->handle = handle;
+	p_item->len    = len;
+	p_item->latest = latest;
+	memcpy( p_item->data, p_data, len );
+	g_notify_queue_count++;
+
+	g_notify_queue_stats.queue_count++;
+	g_notify_queue_stats.depth = g_notify_queue_count;
+	if ( g_notify_queue_stats.depth > g_notify_queue_stats.depth_max )
+	{
+		g_notify_queue_stats.depth_max = g_notify_queue_stats.depth;
+	}
+	return NRF_SUCCESS;
+}
+
+/**
+ * @brief Notify Queueの先頭から順にSoftDeviceへ渡す (Critical Region内から呼び出す)
+ * @param None
+ * @retval None
+ */
+static void notify_queue_flush( void )
+{
+	NOTIFY_QUEUE_ITEM *p_item;
+	uint32_t err_code;
+
+	while ( g_notify_queue_count != 0 )
+	{
+		p_item = &g_notify_queue[g_notify_queue_head];
+		err_code = notify_queue_hvx( p_item->handle, p_item->data, p_item->len );
+		if ( notify_queue_is_retry_err( err_code ) == true )
+		{
+			/* SoftDevice Queue Full. 次のTX Completeで送信する */
+			break;
+		}
+		if ( err_code == NRF_SUCCESS )
+		{
+			g_notify_queue_stats.send_count++;
+			g_notify_queue_stats.send_bytes += p_item->len;
+		}
+		else
+		{
+			/* 再送しても成功しないため破棄してResetはしない */
+			g_notify_queue_stats.drop_err_count++;
+			TRACE_LOG( TR_NOTIFY_ERROR, (uint16_t)err_code );
+		}
+		g_notify_queue_head = ( g_notify_queue_head + 1 ) % NOTIFY_QUEUE_SIZE;
+		g_notify_queue_count--;
+	}
+	g_notify_queue_stats.depth = g_notify_queue_count;
+}
+
+/**
+ * @brief Notify Queue Initialize
+ * @param get_conn_handle 接続中のConnection Handle取得 (未接続時はBLE_CONN_HANDLE_INVALID)
+ * @retval None
+ */
+void NotifyQueueInit( void (*get_conn_handle)( uint16_t *p_conn_handle ) )
+{
+	CRITICAL_REGION_ENTER();
+	g_notify_queue_get_conn_handle = get_conn_handle;
+	g_notify_queue_head  = 0;
+	g_notify_queue_count = 0;
+	memset( &g_notify_queue_stats, 0, sizeof( g_notify_queue_stats ) );
+	CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief Notify送信 (NotifyQueueSend / NotifyQueueSendLatest共通)
+ * @param handle Characteristic Value Handle
+ * @param p_data Payload
+ * @param len Payload Size
+ * @param latest true : 最新値のみ意味を持つNotify (保持中は上書きする)
+ * @retval NotifyQueueSendと同じ
+ */
+static uint32_t notify_queue_send( uint16_t handle, const uint8_t *p_data, uint16_t len, bool latest )
+{
+	uint32_t err_code = NRF_SUCCESS;
+
+	if ( ( p_data == NULL ) || ( len == 0 ) || ( len > NOTIFY_QUEUE_DATA_MAX ) )
+	{
+		return NRF_ERROR_DATA_SIZE;
+	}
+	if ( notify_queue_conn_handle() == BLE_CONN_HANDLE_INVALID )
+	{
+		return NRF_ERROR_INVALID_STATE;
+	}
+
+	CRITICAL_REGION_ENTER();
+	if ( g_notify_queue_count == 0 )
+	{
+		/* 保持中のNotifyが無い場合はすぐに送信 */
+		err_code = notify_queue_hvx( handle, p_data, len );
+		if ( err_code == NRF_SUCCESS )
+		{
+			g_notify_queue_stats.send_count++;
+			g_notify_queue_stats.send_bytes += len;
+		}
+		else if ( notify_queue_is_retry_err( err_code ) == true )
+		{
+			err_code = notify_queue_put( handle, p_data, len, latest );
+		}
+		else
+		{
+			g_notify_queue_stats.drop_err_count++;
+		}
+	}
+	else
+	{
+		/* 送信順序を保つため末尾に追加してから送信 */
+		err_code = notify_queue_put( handle, p_data, len, latest );
+		notify_queue_flush();
+	}
+	CRITICAL_REGION_EXIT();
+
+	return err_code;
+}
+
+/**
+ * @brief Notify送信 (Payloadはコピーするため呼び出し元のBufferは再利用可)
+ * @remark SoftDevice Queueが空いていればすぐに送信し、Fullの場合はNotify Queueに保持して
+ *         BLE_GATTS_EVT_HVN_TX_COMPLETEで送信する. 送信順序は保持する
+ * @param handle Characteristic Value Handle
+ * @param p_data Payload
+ * @param len Payload Size
+ * @retval NRF_SUCCESS 送信 or Queueに保持した
+ * @retval NRF_ERROR_NO_MEM Queue Full (呼び出し元は送信を控える)
+ * @retval NRF_ERROR_INVALID_STATE 未接続
+ * @retval NRF_ERROR_DATA_SIZE Payload Size Error
+ * @retval その他 sd_ble_gatts_hvxのError
+ */
+uint32_t NotifyQueueSend( uint16_t handle, const uint8_t *p_data, uint16_t len )
+{
+	return notify_queue_send( handle, p_data, len, false );
+}
+
+/**
+ * @brief 最新値のみ意味を持つNotify送信 (Coalesce)
+ * @remark Queue末尾が同じHandleの本関数で保持したNotifyの場合はPayloadを上書きする.
+ *         NotifyQueueSendで保持したNotifyは上書きしないため, Eventの送信順序と内容は保持する
+ * @param handle Characteristic Value Handle
+ * @param p_data Payload
+ * @param len Payload Size
+ * @retval NotifyQueueSendと同じ
+ */
+uint32_t NotifyQueueSendLatest( uint16_t handle, const uint8_t *p_data, uint16_t len )
+{
+	return notify_queue_send( handle, p_data, len, true );
+}
+
+/**
+ * @brief Notify送信 (ble_gatts_hvx_params_t指定)
+ * @param p_param Notify Parameter (handle / p_data / p_lenを使用)
+ * @retval NotifyQueueSendと同じ
+ */
+uint32_t NotifyQueueSendParam( const ble_gatts_hvx_params_t *p_param )
+{
+	if ( ( p_param == NULL ) || ( p_param->p_len == NULL ) )
+	{
+		return NRF_ERROR_NULL;
+	}
+	return NotifyQueueSend( p_param->handle, p_param->p_data, *p_param->p_len );
+}
+
+/**
+ * @brief Notify QueueをSoftDeviceへ送信 (BLE_GATTS_EVT_HVN_TX_COMPLETE時に呼び出す)
+ * @param tx_count TX Completeで完了した数 (TX Complete以外から呼び出す場合は0)
+ * @retval None
+ */
+void NotifyQueueDrain( uint8_t tx_count )
+{
+	CRITICAL_REGION_ENTER();
+	g_notify_queue_stats.tx_cmpl_count += tx_count;
+	notify_queue_flush();
+	CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief Notify Queueが一杯かどうかを取得
+ * @param None
+ * @retval true Queue Full
+ * @retval false 空きあり
+ */
+bool NotifyQueueIsFull( void )
+{
+	return ( g_notify_queue_count >= NOTIFY_QUEUE_SIZE );
+}
+
+/**
+ * @brief Notify Queueをクリア (切断時)
+ * @param None
+ * @retval None
+ */
+void NotifyQueueClear( void )
+{
+	CRITICAL_REGION_ENTER();
+	g_notify_queue_head  = 0;
+	g_notify_queue_count = 0;
+	g_notify_queue_stats.depth = 0;
+	CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief Notify Queue 統計情報を取得
+ * @param p_stats 統計情報格納先
+ * @retval None
+ */
+void NotifyQueueGetStats( NOTIFY_QUEUE_STATS *p_stats )
+{
+	if ( p_stats == NULL )
+	{
+		return;
+	}
+	CRITICAL_REGION_ENTER();
+	memcpy( p_stats, &g_notify_queue_stats, sizeof( NOTIFY_QUEUE_STATS ) );
+	CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief Notify Queue 統計情報 Debug Log
+ * @param None
+ * @retval None
+ */
+void DebugNotifyQueueStatsLog( void )
+{
+	NOTIFY_QUEUE_STATS stats;
+
+	NotifyQueueGetStats( &stats );
+	DEBUG_LOG( LOG_INFO, "NOTIFY Q depth %u/%u send %u(%u byte) queue %u coalesce %u cmpl %u drop full %u err %u",
+		stats.depth, stats.depth_max, stats.send_count, stats.send_bytes, stats.queue_count, stats.coalesce_count,
+		stats.tx_cmpl_count, stats.drop_full_count, stats.drop_err_count );
+}
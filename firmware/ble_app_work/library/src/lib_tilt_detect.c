@@ -0,0 +1,279 @@
+/**
+  ******************************************************************************************
+  * @file    lib_tilt_detect.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Tilt / Fall Detection (Hysteresis + Debounce)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include <string.h>
+#include <math.h>
+
+#include "lib_tilt_detect.h"
+
+/* Definition ------------------------------------------------------------*/
+#define TILT_DEFAULT_ENTER			(0.65f)		/* 約49度 */
+#define TILT_DEFAULT_EXIT			(0.55f)		/* 約57度 */
+#define TILT_DEFAULT_DEBOUNCE_MS	(200)
+#define TILT_DEFAULT_LSB_PER_G		(2048)		/* ICM42607 16g */
+#define TILT_DEFAULT_FREEFALL_G		(0.4f)
+#define TILT_DEFAULT_FREEFALL_MS	(60)
+#define TILT_DEFAULT_IMPACT_G		(2.0f)
+#define TILT_DEFAULT_IMPACT_MS		(500)
+
+/* Struct ----------------------------------------------------------------*/
+/* 判定状態 */
+typedef struct _tilt_detect_info
+{
+	TILT_STATE state;					/* 確定した傾き状態 */
+	TILT_STATE pending;					/* 確定待ちの傾き状態 (TILT_STATE_INIT:なし) */
+	uint32_t pending_ms;				/* 確定待ちを開始した時刻 */
+	float window[TILT_DETECT_WINDOW];	/* cosの履歴 */
+	uint8_t window_num;
+	uint8_t window_pos;
+	bool started;						/* 1 Sample以上入力した */
+	uint32_t last_ms;					/* 前回のSample時刻 */
+	bool freefall;						/* 落下中 */
+	uint32_t freefall_ms;				/* 落下開始時刻 */
+	bool impact_wait;					/* 衝撃待ち */
+	uint32_t impact_wait_ms;			/* 衝撃待ち開始時刻 */
+} TILT_DETECT_INFO;
+
+/* Private variables -----------------------------------------------------*/
+static TILT_DETECT_CONFIG g_tilt_config;
+static TILT_DETECT_INFO g_tilt_info;
+
+/**
+ * @brief 落下 -> 衝撃の判定
+ * @param mag 加速度の大きさ [g]
+ * @param time_ms Sample時刻 [ms]
+ * @retval true 転倒を検出
+ * @retval false 検出なし
+ */
+static bool tilt_detect_fall( float mag, uint32_t time_ms )
+{
+	if ( ( g_tilt_info.impact_wait == true ) &&
+		 ( ( time_ms - g_tilt_info.impact_wait_ms ) > g_tilt_config.impact_window_ms ) )
+	{
+		/* 衝撃なし */
+		g_tilt_info.impact_wait = false;
+	}
+
+	if ( mag < g_tilt_config.freefall_g )
+	{
+		if ( g_tilt_info.freefall == false )
+		{
+			g_tilt_info.freefall = true;
+			g_tilt_info.freefall_ms = time_ms;
+		}
+		else if ( ( time_ms - g_tilt_info.freefall_ms ) >= g_tilt_config.freefall_ms )
+		{
+			/* 落下が続いている間は衝撃待ちを延長 */
+			g_tilt_info.impact_wait = true;
+			g_tilt_info.impact_wait_ms = time_ms;
+		}
+		return false;
+	}
+	g_tilt_info.freefall = false;
+
+	if ( ( g_tilt_info.impact_wait == true ) && ( mag > g_tilt_config.impact_g ) )
+	{
+		g_tilt_info.impact_wait = false;
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * @brief 傾きの判定 (Hysteresis + Debounce)
+ * @param cos_axis 倒れた時の軸と加速度の向きのcos
+ * @param time_ms Sample時刻 [ms]
+ * @retval TILT_EVT_NONE 変化なし
+ * @retval TILT_EVT_STAND / TILT_EVT_TILT 確定した
+ */
+static TILT_EVT tilt_detect_state( float cos_axis, uint32_t time_ms )
+{
+	TILT_STATE candidate;
+	float average = 0.0f;
+	uint8_t i;
+
+	g_tilt_info.window[g_tilt_info.window_pos] = cos_axis;
+	g_tilt_info.window_pos = ( g_tilt_info.window_pos + 1 ) % TILT_DETECT_WINDOW;
+	if ( g_tilt_info.window_num < TILT_DETECT_WINDOW )
+	{
+		g_tilt_info.window_num++;
+	}
+	for ( i = 0; i < g_tilt_info.window_num; i++ )
+	{
+		average += g_tilt_info.window[i];
+	}
+	average /= g_tilt_info.window_num;
+
+	if ( g_tilt_info.state == TILT_STATE_INIT )
+	{
+		/* 初回はHysteresisの中間で決める */
+		g_tilt_info.state = ( average >= ( ( g_tilt_config.tilt_enter + g_tilt_config.tilt_exit ) / 2.0f ) ) ? TILT_STATE_TILT : TILT_STATE_STAND;
+		return ( g_tilt_info.state == TILT_STATE_TILT ) ? TILT_EVT_TILT : TILT_EVT_STAND;
+	}
+
+	candidate = g_tilt_info.state;
+	if ( average >= g_tilt_config.tilt_enter )
+	{
+		candidate = TILT_STATE_TILT;
+	}
+	else if ( average <= g_tilt_config.tilt_exit )
+	{
+		candidate = TILT_STATE_STAND;
+	}
+
+	if ( candidate == g_tilt_info.state )
+	{
+		/* 継続しなかったため確定待ちを取り消し */
+		g_tilt_info.pending = TILT_STATE_INIT;
+		return TILT_EVT_NONE;
+	}
+
+	if ( g_tilt_info.pending != candidate )
+	{
+		g_tilt_info.pending = candidate;
+		g_tilt_info.pending_ms = time_ms;
+	}
+	if ( ( time_ms - g_tilt_info.pending_ms ) < g_tilt_config.debounce_ms )
+	{
+		return TILT_EVT_NONE;
+	}
+
+	g_tilt_info.state = candidate;
+	g_tilt_info.pending = TILT_STATE_INIT;
+	return ( candidate == TILT_STATE_TILT ) ? TILT_EVT_TILT : TILT_EVT_STAND;
+}
+
+/**
+ * @brief 初期設定値を取得
+ * @param p_config 設定格納先
+ * @retval None
+ */
+void TiltDetectGetDefaultConfig( TILT_DETECT_CONFIG *p_config )
+{
+	if ( p_config == NULL )
+	{
+		return;
+	}
+	memset( p_config, 0, sizeof( TILT_DETECT_CONFIG ) );
+	p_config->axis[2]			= 1.0f;
+	p_config->tilt_enter		= TILT_DEFAULT_ENTER;
+	p_config->tilt_exit			= TILT_DEFAULT_EXIT;
+	p_config->debounce_ms		= TILT_DEFAULT_DEBOUNCE_MS;
+	p_config->lsb_per_g			= TILT_DEFAULT_LSB_PER_G;
+	p_config->freefall_g		= TILT_DEFAULT_FREEFALL_G;
+	p_config->freefall_ms		= TILT_DEFAULT_FREEFALL_MS;
+	p_config->impact_g			= TILT_DEFAULT_IMPACT_G;
+	p_config->impact_window_ms	= TILT_DEFAULT_IMPACT_MS;
+	p_config->rot_func			= NULL;
+}
+
+/**
+ * @brief Tilt Detect Initialize
+ * @param p_config 設定 (NULLの場合は初期設定値)
+ * @retval None
+ */
+void TiltDetectInit( const TILT_DETECT_CONFIG *p_config )
+{
+	if ( p_config == NULL )
+	{
+		TiltDetectGetDefaultConfig( &g_tilt_config );
+	}
+	else
+	{
+		memcpy( &g_tilt_config, p_config, sizeof( TILT_DETECT_CONFIG ) );
+	}
+	if ( g_tilt_config.lsb_per_g == 0 )
+	{
+		g_tilt_config.lsb_per_g = TILT_DEFAULT_LSB_PER_G;
+	}
+	memset( &g_tilt_info, 0, sizeof( g_tilt_info ) );
+}
+
+/**
+ * @brief 加速度Sampleを入力して判定
+ * @param x ACC_X [LSB]
+ * @param y ACC_Y [LSB]
+ * @param z ACC_Z [LSB]
+ * @param time_ms Sample時刻 [ms]
+ * @retval TILT_EVT_NONE 変化なし
+ * @retval TILT_EVT_STAND / TILT_EVT_TILT 傾き状態が確定した
+ * @retval TILT_EVT_FALL 転倒を検出した
+ */
+TILT_EVT TiltDetectInput( int16_t x, int16_t y, int16_t z, uint32_t time_ms )
+{
+	TILT_ACC acc;
+	float ax;
+	float ay;
+	float az;
+	float mag;
+
+	/* 取付角度補正 */
+	acc.x = x;
+	acc.y = y;
+	acc.z = z;
+	if ( g_tilt_config.rot_func != NULL )
+	{
+		g_tilt_config.rot_func( x, y, z, &acc );
+	}
+	ax = (float)acc.x / g_tilt_config.lsb_per_g;
+	ay = (float)acc.y / g_tilt_config.lsb_per_g;
+	az = (float)acc.z / g_tilt_config.lsb_per_g;
+	mag = sqrtf( ax * ax + ay * ay + az * az );
+
+	if ( ( g_tilt_info.started == true ) && ( ( time_ms - g_tilt_info.last_ms ) > TILT_DETECT_GAP_MS ) )
+	{
+		/* Heartbeatなど間隔が空いたSampleは平均しない (確定待ちは継続) */
+		g_tilt_info.window_num = 0;
+		g_tilt_info.window_pos = 0;
+	}
+	g_tilt_info.started = true;
+	g_tilt_info.last_ms = time_ms;
+
+	if ( tilt_detect_fall( mag, time_ms ) == true )
+	{
+		return TILT_EVT_FALL;
+	}
+
+	if ( ( mag < TILT_DETECT_STATIC_MIN_G ) || ( mag > TILT_DETECT_STATIC_MAX_G ) )
+	{
+		/* 動いている最中の値は傾き判定に使わない */
+		return TILT_EVT_NONE;
+	}
+
+	return tilt_detect_state( ( ax * g_tilt_config.axis[0] + ay * g_tilt_config.axis[1] + az * g_tilt_config.axis[2] ) / mag, time_ms );
+}
+
+/**
+ * @brief 現在の傾き状態を取得
+ * @param None
+ * @retval 傾き状態
+ */
+TILT_STATE TiltDetectGetState( void )
+{
+	return g_tilt_info.state;
+}
+
+/**
+ * @brief 判定途中かどうかを取得 (判定途中はSamplingを続ける)
+ * @param None
+ * @retval true 判定途中 (Debounce中 / 落下中 / 衝撃待ち)
+ * @retval false 判定途中ではない
+ */
+bool TiltDetectIsBusy( void )
+{
+	return ( g_tilt_info.pending != TILT_STATE_INIT ) || ( g_tilt_info.freefall == true ) || ( g_tilt_info.impact_wait == true );
+}
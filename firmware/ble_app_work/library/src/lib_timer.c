@@ -10,6 +10,7 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/15       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         BLE Profile Bulk Hold Timerを追加
   ******************************************************************************************
 */
 
@@ -25,6 +26,7 @@
 #include "lib_fifo.h"
 #include "definition.h"
 #include "lib_trace_log.h"
+#include "lib_ble_profile.h"
 
 /* Definition ------------------------------------------------------------*/
 #define UPDATE_RETRY_COUNT  3
@@ -43,6 +45,10 @@
 #define RSSI_NOTIFY_TIME				APP_TIMER_TICKS( RSSI_NOTIFY_MS )
 /* 2022.06.03 Add RSSI通知 -- */
 
+/* 2026.10.19 Add BLE Profile ++ */
+#define BLE_PROFILE_BULK_HOLD_TIME		APP_TIMER_TICKS( BLE_PROFILE_BULK_HOLD_MS )
+/* 2026.10.19 Add BLE Profile -- */
+
 #define APP_TIMER_ERR_CHECK( err, event )                                                     \
 	do {                                                                                      \
 		if ( err != NRF_SUCCESS )                                                             \
@@ -73,6 +79,10 @@ APP_TIMER_DEF(g_flash_timer);
 APP_TIMER_DEF( g_rssi_notify );
 /* 2022.06.03 Add RSSI通知 -- */
 
+/* 2026.10.19 Add BLE Profile ++ */
+APP_TIMER_DEF( g_ble_profile_bulk );
+/* 2026.10.19 Add BLE Profile -- */
+
 
 /* Private function prototypes -------------------------------------------*/
 /**
@@ -154,6 +164,15 @@ static void get_update_retry_count(uint8_t *pRecCount);
 static void rssi_notify_timer_evt_handler(void);
 /* 2022.06.03 Add RSSI通知 -- */
 
+/* 2026.10.19 Add BLE Profile ++ */
+/**
+ * @brief BLE Profile Bulk Hold Timer event handler
+ * @param None
+ * @retval None
+ */
+static void ble_profile_bulk_timer_evt_handler(void);
+/* 2026.10.19 Add BLE Profile -- */
+
 
 /**
  * @brief app_timer Initialize
@@ -200,6 +219,11 @@ void LibTimersInit(void)
 	err_code = app_timer_create( &g_rssi_notify, APP_TIMER_MODE_REPEATED, (app_timer_timeout_handler_t)rssi_notify_timer_evt_handler );
 	LIB_ERR_CHECK(err_code, APP_TIMER_CREATE, __LINE__);
 	/* 2022.06.03 Add RSSI通知 -- */
+
+	/* 2026.10.19 Add BLE Profile ++ */
+	err_code = app_timer_create( &g_ble_profile_bulk, APP_TIMER_MODE_SINGLE_SHOT, (app_timer_timeout_handler_t)ble_profile_bulk_timer_evt_handler );
+	LIB_ERR_CHECK(err_code, APP_TIMER_CREATE, __LINE__);
+	/* 2026.10.19 Add BLE Profile -- */
 }
 
 /**
@@ -837,6 +861,43 @@ void StopRssiNotifyTimer(void)
 
 /* 2022.06.03 Add RSSI通知 -- */
 
+/* 2026.10.19 Add BLE Profile ++ */
+/**
+ * @brief BLE Profile Bulk Hold Timer event handler
+ * @param None
+ * @retval None
+ */
+static void ble_profile_bulk_timer_evt_handler(void)
+{
+	bool uart_output_enable;
+	
+	uart_output_enable = GetUartOutputStatus();
+	if(uart_output_enable == false)
+	{
+		LibUartEnable();
+	}
+	
+	/* Daily Log転送が終了したためMode Profileへ戻す */
+	BleProfileBulkRelease();
+	
+	if(uart_output_enable == false)
+	{
+		LibUartDisable();
+	}
+}
 
-
-
+/**
+ * @brief Restart BLE Profile Bulk Hold Timer
+ * @param None
+ * @retval None
+ */
+void RestartBleProfileBulkTimer(void)
+{
+	ret_code_t err_code;
+	
+	err_code = app_timer_stop( g_ble_profile_bulk );
+	APP_TIMER_ERR_CHECK( err_code, BLE_PROFILE_TIMER_STOP_ERROR );
+	err_code = app_timer_start( g_ble_profile_bulk, BLE_PROFILE_BULK_HOLD_TIME, NULL );
+	APP_TIMER_ERR_CHECK( err_code, BLE_PROFILE_TIMER_START_ERROR );
+}
+/* 2026.10.19 Add BLE Profile -- */
@@ -0,0 +1,236 @@
+/**
+  ******************************************************************************************
+  * @file    lib_token_log.c
+  * @author  k.tashiro
+  * @version 1.0
+  * @date    2026/10/19
+  * @brief   Token Log (Message ID + 引数だけを記録するBinary Log)
+  ******************************************************************************************
+    Revision:
+    Ver            Date             Revised by        Explanation
+  ******************************************************************************************
+  * 1.0            2026/10/19       k.tashiro         create new
+  ******************************************************************************************
+*/
+
+/* Includes --------------------------------------------------------------*/
+#include "lib_token_log.h"
+#include "nrf.h"
+#include "app_timer.h"
+
+/* Definition ------------------------------------------------------------*/
+#define TOKEN_LOG_RING_MASK			( TOKEN_LOG_RING_WORDS - 1 )
+
+#if ( TOKEN_LOG_RING_WORDS & TOKEN_LOG_RING_MASK ) != 0
+#error "TOKEN_LOG_RING_WORDS must be a power of 2"
+#endif
+
+/* Private variables -----------------------------------------------------*/
+static volatile uint32_t g_token_log_ring[TOKEN_LOG_RING_WORDS];
+static volatile uint32_t g_token_log_head = 0;		/* 書き込み予約済みの位置 (Producer) */
+static volatile uint32_t g_token_log_tail = 0;		/* 出力済みの位置 (Consumer) */
+static volatile uint32_t g_token_log_drop = 0;		/* 未出力の破棄数 */
+static TOKEN_LOG_STATS g_token_log_stats = {0};
+static TOKEN_LOG_SINK g_token_log_sink = NULL;
+
+/**
+ * @brief Atomic加算 (LDREX/STREX)
+ * @param p_value 加算先
+ * @param add 加算値
+ * @retval None
+ */
+static void token_log_atomic_add( volatile uint32_t *p_value, uint32_t add )
+{
+	uint32_t value;
+
+	do
+	{
+		value = __LDREXW( p_value );
+	} while ( __STREXW( value + add, p_value ) != 0 );
+}
+
+/**
+ * @brief Ringの書き込み領域を予約 (LDREX/STREX. 割り込みで中断されても重複しない)
+ * @param words 予約するword数
+ * @param p_pos 予約した先頭位置
+ * @retval true 予約した
+ * @retval false Ring Full
+ */
+static bool token_log_reserve( uint32_t words, uint32_t *p_pos )
+{
+	uint32_t head;
+	uint32_t used;
+
+	do
+	{
+		head = __LDREXW( &g_token_log_head );
+		used = head - g_token_log_tail;
+		if ( ( used + words ) > TOKEN_LOG_RING_WORDS )
+		{
+			__CLREX();
+			return false;
+		}
+	} while ( __STREXW( head + words, &g_token_log_head ) != 0 );
+
+	if ( ( used + words ) > g_token_log_stats.depth_max )
+	{
+		g_token_log_stats.depth_max = (uint16_t)( used + words );
+	}
+	*p_pos = head;
+	return true;
+}
+
+/**
+ * @brief 1 Recordを出力Frameにして出力先へ送る
+ * @param p_word Record
+ * @param words Record Size [word]
+ * @retval None
+ */
+static void token_log_output( const uint32_t *p_word, uint32_t words )
+{
+	uint8_t frame[TOKEN_LOG_FRAME_MAX];
+	uint8_t check = 0;
+	uint16_t length;
+	uint16_t idx;
+
+	length = (uint16_t)( words * 4 );
+	memcpy( frame, p_word, length );
+	for ( idx = 0; idx < length; idx++ )
+	{
+		check ^= frame[idx];
+	}
+	frame[length++] = check;
+
+	if ( g_token_log_sink != NULL )
+	{
+		g_token_log_sink( frame, length );
+	}
+	g_token_log_stats.out_count++;
+}
+
+/**
+ * @brief Token Log Initialize
+ * @param sink 出力先 (NULLの場合はTokenLogProcessで破棄する)
+ * @retval None
+ */
+void TokenLogInit( TOKEN_LOG_SINK sink )
+{
+	memset( (void *)g_token_log_ring, 0, sizeof( g_token_log_ring ) );
+	g_token_log_head = 0;
+	g_token_log_tail = 0;
+	g_token_log_drop = 0;
+	memset( &g_token_log_stats, 0, sizeof( g_token_log_stats ) );
+	g_token_log_sink = sink;
+}
+
+/**
+ * @brief Token Log書き込み (割り込みからも呼び出し可. Lockなし)
+ * @remark 書式の整形は行わずMessage IDと引数をRAM Ringへコピーするだけ.
+ *         Ring Fullの場合は破棄して件数を数え, 次回出力時にTL_TOKEN_LOG_DROPとして出力する
+ * @param id Message ID
+ * @param num 引数の数 (TOKEN_LOG_ARG_MAX以下)
+ * @param p_arg 引数
+ * @retval None
+ */
+void TokenLogWrite( uint16_t id, uint8_t num, const uint32_t *p_arg )
+{
+	uint32_t pos;
+	uint8_t idx;
+
+	if ( num > TOKEN_LOG_ARG_MAX )
+	{
+		num = TOKEN_LOG_ARG_MAX;
+	}
+
+	if ( token_log_reserve( TOKEN_LOG_HEADER_WORDS + num, &pos ) == false )
+	{
+		token_log_atomic_add( &g_token_log_drop, 1 );
+		return;
+	}
+
+	g_token_log_ring[( pos + 1 ) & TOKEN_LOG_RING_MASK] = app_timer_cnt_get();
+	for ( idx = 0; idx < num; idx++ )
+	{
+		g_token_log_ring[( pos + TOKEN_LOG_HEADER_WORDS + idx ) & TOKEN_LOG_RING_MASK] = p_arg[idx];
+	}
+	/* Headerは最後に書き込む (Headerが0以外になった時点でRecord確定) */
+	__DMB();
+	g_token_log_ring[pos & TOKEN_LOG_RING_MASK] = TOKEN_LOG_HEADER( id, num );
+	token_log_atomic_add( &g_token_log_stats.write_count, 1 );
+}
+
+/**
+ * @brief RAM RingのRecordを出力先へ送る (Main Loopから呼び出す)
+ * @remark 予約済みで未確定のRecord(書き込み中に割り込まれた等)があればそこで止め, 次回出力する
+ * @param None
+ * @retval true 出力した
+ * @retval false 出力するRecordなし
+ */
+bool TokenLogProcess( void )
+{
+	uint32_t record[TOKEN_LOG_HEADER_WORDS + TOKEN_LOG_ARG_MAX];
+	uint32_t tail;
+	uint32_t header;
+	uint32_t words;
+	uint32_t drop;
+	uint32_t idx;
+	bool output = false;
+
+	/* 破棄数 */
+	do
+	{
+		drop = __LDREXW( &g_token_log_drop );
+	} while ( __STREXW( 0, &g_token_log_drop ) != 0 );
+	if ( drop != 0 )
+	{
+		g_token_log_stats.drop_count += drop;
+		record[0] = TOKEN_LOG_HEADER( TL_TOKEN_LOG_DROP, 1 );
+		record[1] = app_timer_cnt_get();
+		record[2] = drop;
+		token_log_output( record, TOKEN_LOG_HEADER_WORDS + 1 );
+		output = true;
+	}
+
+	tail = g_token_log_tail;
+	while ( tail != g_token_log_head )
+	{
+		header = g_token_log_ring[tail & TOKEN_LOG_RING_MASK];
+		if ( header == 0 )
+		{
+			/* 書き込み中 */
+			break;
+		}
+		__DMB();
+
+		words = TOKEN_LOG_HEADER_WORDS + ( ( header >> 8 ) & 0xFF );
+		for ( idx = 0; idx < words; idx++ )
+		{
+			record[idx] = g_token_log_ring[( tail + idx ) & TOKEN_LOG_RING_MASK];
+			g_token_log_ring[( tail + idx ) & TOKEN_LOG_RING_MASK] = 0;
+		}
+		/* 0クリアしてから領域を返す */
+		__DMB();
+		tail += words;
+		g_token_log_tail = tail;
+
+		token_log_output( record, words );
+		output = true;
+	}
+
+	return output;
+}
+
+/**
+ * @brief Token Log 統計情報を取得
+ * @param p_stats 統計情報格納先
+ * @retval None
+ */
+void TokenLogGetStats( TOKEN_LOG_STATS *p_stats )
+{
+	if ( p_stats == NULL )
+	{
+		return;
+	}
+	memcpy( p_stats, &g_token_log_stats, sizeof( TOKEN_LOG_STATS ) );
+	p_stats->drop_count += g_token_log_drop;
+}
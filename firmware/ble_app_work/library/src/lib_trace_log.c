@@ -10,6 +10,9 @@
     Ver            Date             Revised by        Explanation
   ******************************************************************************************
   * 1.0            2020/09/10       k.tashiro         create new
+  * 1.1            2026/10/19       k.tashiro         TraceFlushをTrace Journalへの差分追記に変更
+  * 1.2            2026/10/19       k.tashiro         Flash書き込み/消去の時間をEnergy Profilerで計測
+  * 1.3            2026/10/19       k.tashiro         TraceLogInit前のTraceLogは記録しない (g_trace_data未設定)
   ******************************************************************************************
 */
 
@@ -20,16 +23,22 @@
 
 #include "nrf_fstorage.h"
 #include "nrf_fstorage_sd.h"
+#include "app_util_platform.h"
 
 #include "lib_common.h"
 #include "definition.h"
 #include "lib_ex_rtc.h"
 #include "lib_trace_log.h"
+#include "lib_energy_prof.h"
 
 /* Private variables -----------------------------------------------------*/
 TRACE_DATA * g_trace_data;
 TRACE_DATA_INFO g_trace_data_info = {0};
 volatile uint8_t g_trace_log_buffer[TRACE_LOG_BUFFER_SIZE];
+/* 2026.10.19 Add Trace Journal ++ */
+static TRACE_JOURNAL_INFO g_trace_journal = {0};
+static TRACE_JOURNAL_ENTRY g_trace_journal_buffer[TRACE_JOURNAL_BATCH_SIZE];
+/* 2026.10.19 Add Trace Journal -- */
 
 /* Private function prototypes -----------------------------------------------*/
 /**
@@ -41,13 +50,6 @@ volatile uint8_t g_trace_log_buffer[TRACE_LOG_BUFFER_SIZE];
  */
 static void set_trace_log_buffer( uint16_t func_no, uint16_t param, uint8_t nested_int );
 
-/**
- * @brief Setup Trace Log
- * @param date_info Date Information
- * @retval None
- */
-static void setup_trace_log( DATE_TIME *date_info );
-
 /**
  * @brief Setup Reset Reason Write Data
  * @param reason Reset Reason
@@ -94,6 +96,40 @@ static ret_code_t trace_log_flush_read( nrf_fstorage_t *p_fstorage, uint32_t pag
  * @retval NRF_SUCCESS以外 Failed
  */
 static ret_code_t trace_log_flush_write( nrf_fstorage_t *p_fstorage, uint32_t page_addr, uint8_t *buffer, uint32_t len, void *p_context );
+
+/**
+ * @brief Trace Journal Mount (初回のみ全Pageを読み出して書き込み位置を決める)
+ * @param None
+ * @retval NRF_SUCCESS Success
+ * @retval NRF_SUCCESS以外 Failed
+ */
+static ret_code_t trace_journal_mount( void );
+
+/**
+ * @brief Trace Journal Page Format (Erase + Page Header書き込み)
+ * @param page Page
+ * @param page_seq Page Seq
+ * @param first_seq 先頭EntryのSequence No
+ * @retval NRF_SUCCESS Success
+ * @retval NRF_SUCCESS以外 Failed
+ */
+static ret_code_t trace_journal_format( uint8_t page, uint32_t page_seq, uint32_t first_seq );
+
+/**
+ * @brief 未書き込みのTrace LogをRAM RingからTrace Journal Entryへコピー
+ * @param p_total コピー時点のTraceLog総数
+ * @retval コピーしたEntry数
+ */
+static uint16_t trace_journal_collect( uint16_t *p_total );
+
+/**
+ * @brief Trace Journal Entry追記 (Pageが一杯になったら次のPageへRotate)
+ * @param p_entry Entry
+ * @param count Entry数
+ * @retval NRF_SUCCESS Success
+ * @retval NRF_SUCCESS以外 Failed
+ */
+static ret_code_t trace_journal_append( TRACE_JOURNAL_ENTRY *p_entry, uint16_t count );
 	
 
 NRF_FSTORAGE_DEF(nrf_fstorage_t trace_log_ex_fstorage) =
@@ -109,6 +145,15 @@ NRF_FSTORAGE_DEF(nrf_fstorage_t trace_log_ex_fstorage) =
 	.end_addr   = TRACE_LOG_END_ADDR,
 };
 
+/* 2026.10.19 Add Trace Journal ++ */
+NRF_FSTORAGE_DEF(nrf_fstorage_t trace_journal_fstorage) =
+{
+	.evt_handler = fstorage_evt_handler,
+	.start_addr = TRACE_JOURNAL_START_ADDR,
+	.end_addr   = TRACE_JOURNAL_END_ADDR,
+};
+/* 2026.10.19 Add Trace Journal -- */
+
 
 /**
  * @brief Trace Log Initialize
@@ -130,10 +175,22 @@ void TraceLogInit( void )
 		g_trace_data->trace_log_count = 0;
 		g_trace_data->trace_log_id = 0;
 		g_trace_data_info.trace_index = 0;
+		/* 2026.10.19 Add Trace Journal ++ */
+		g_trace_data->trace_log_total = 0;
+		g_trace_data->trace_log_flushed = 0;
+		/* 2026.10.19 Add Trace Journal -- */
 	}
 	else
 	{
 		g_trace_data_info.trace_index = g_trace_data->trace_log_count;
+		/* 2026.10.19 Add Trace Journal ++ */
+		if ( ( g_trace_data->trace_log_total % TRACE_LOG_SIZE ) != g_trace_data->trace_log_count )
+		{
+			/* Counter未設定 (旧Firmwareからの更新等). RAM Ringの位置に合わせ, 未書き込みなしとする */
+			g_trace_data->trace_log_total = g_trace_data->trace_log_count;
+			g_trace_data->trace_log_flushed = g_trace_data->trace_log_total;
+		}
+		/* 2026.10.19 Add Trace Journal -- */
 	}
 }
 
@@ -149,6 +206,12 @@ void TraceLog( uint16_t func_no, uint16_t param )
 	ret_code_t err_code;
 	uint8_t trace_log_nested_critical;
 
+	/* 2026.10.19 Add TraceLogInit前はRetained RAMの位置が未設定のため記録しない */
+	if ( g_trace_data == NULL )
+	{
+		return ;
+	}
+
 	/* Enter Critival Session */
 	err_code = sd_nvic_critical_region_enter( &trace_log_nested_critical );
 	if ( err_code != NRF_SUCCESS ){ }
@@ -172,48 +235,36 @@ void TraceLog( uint16_t func_no, uint16_t param )
  */
 ret_code_t TraceFlush( void )
 {
+	/* 2026.10.19 Modify Trace Journalへの差分追記に変更 (RTC取得/Page Read/Page Eraseを毎回行わない) ++ */
 	ret_code_t err_code;
-	nrf_fstorage_api_t *p_fs_api;
-	nrf_fstorage_t *p_fstorage;
-	uint32_t start_addr;
-	DATE_TIME date_info;
-	
-	/* Get Rtc Data */
-	err_code = ExRtcGetDateTime(&date_info);
-	if ( err_code != NRF_SUCCESS )
+	uint16_t total;
+	uint16_t count;
+
+	/* 割り込み中はSoftDeviceのFlash完了Eventを待てないため, Retained RAMに残して次回書き込む */
+	if ( ( g_trace_data == NULL ) || ( current_int_priority_get() != APP_IRQ_PRIORITY_THREAD ) )
 	{
-		return err_code;
+		return NRF_ERROR_INVALID_STATE;
 	}
 
-	/* Flush Config */
-	p_fs_api = &nrf_fstorage_sd;
-	start_addr = TRACE_LOG_START_ADDR;
-	p_fstorage = &trace_log_ex_fstorage;
-	
-	/* fstorage Initialize */
-	err_code = nrf_fstorage_init( p_fstorage, p_fs_api, NULL );
+	/* Trace Journal Mount */
+	err_code = trace_journal_mount();
 	VALIDETE_RETCODE(err_code, FLASH_INIT_ERROR);
 
-	/* ROM Read */
-	err_code = trace_log_flush_read( p_fstorage, start_addr, TRACE_LOG_BUFFER_SIZE );
-	VALIDETE_RETCODE(err_code, FLASH_READ_ERROR);
-	
-	/* Setup Trace Log Data */
-	setup_trace_log( &date_info );
-	
-	/* ROM erase */
-	err_code = trace_log_flush_erase( p_fstorage, start_addr, 1, NULL );
-	VALIDETE_RETCODE(err_code, FLASH_ERASE_ERROR);
+	/* 前回Flush以降のTrace Log */
+	count = trace_journal_collect( &total );
+	if ( count == 0 )
+	{
+		return NRF_SUCCESS;
+	}
 
 	/* Write ROM */
-	err_code = trace_log_flush_write( p_fstorage, start_addr, (uint8_t *)&g_trace_log_buffer, TRACE_LOG_BUFFER_SIZE, NULL );
+	err_code = trace_journal_append( g_trace_journal_buffer, count );
 	VALIDETE_RETCODE(err_code, FLASH_WRITE_ERROR);
 
-	/* fstorage Uninitialize */
-	err_code = nrf_fstorage_uninit(p_fstorage, NULL);
-	VALIDETE_RETCODE(err_code, FLASH_UNINIT_ERROR);
+	g_trace_data->trace_log_flushed = total;
 	
 	return NRF_SUCCESS;
+	/* 2026.10.19 Modify Trace Journalへの差分追記に変更 -- */
 }
 
 /**
@@ -278,6 +329,7 @@ static void set_trace_log_buffer( uint16_t func_no, uint16_t param, uint8_t nest
 	g_trace_data->trace_data[idx].func_no = func_no;
 	g_trace_data->trace_data[idx].param = param;
 	g_trace_data->trace_data[idx].nested_interrupt = nested_int;
+	g_trace_data->trace_log_total++;		/* 2026.10.19 Add Trace Journal */
 
 	/* Delete oldest data */
 	g_trace_data->trace_log_count = idx = (++g_trace_data_info.trace_index) % TRACE_LOG_SIZE;
@@ -286,51 +338,6 @@ static void set_trace_log_buffer( uint16_t func_no, uint16_t param, uint8_t nest
 	return ;
 }
 
-/**
- * @brief Setup Trace Log
- * @param date_info Date Information
- * @retval None
- */
-static void setup_trace_log( DATE_TIME *date_info )
-{
-	uint32_t idx;
-	uint32_t reset_reason_offset;
-	
-	if ( date_info != NULL )
-	{
-		/* Set signiture */
-		g_trace_log_buffer[RESET_REASON_SIZE] = g_trace_data->signiture[0];
-		g_trace_log_buffer[RESET_REASON_SIZE + 1] = g_trace_data->signiture[1];
-		/* Set Data Counter Signiture */
-		g_trace_log_buffer[RESET_REASON_SIZE + 2] = g_trace_data->trace_log_sig[0];
-		g_trace_log_buffer[RESET_REASON_SIZE + 3] = g_trace_data->trace_log_sig[1];
-		/* Set Data Counter */
-		g_trace_log_buffer[RESET_REASON_SIZE + 4] = g_trace_data->trace_log_count;
-		g_trace_log_buffer[RESET_REASON_SIZE + 5] = g_trace_data->trace_log_id;
-		reset_reason_offset = RESET_REASON_SIZE + 6;
-		
-		/* Set Date */
-		g_trace_log_buffer[reset_reason_offset++] = date_info->year;
-		g_trace_log_buffer[reset_reason_offset++] = date_info->month;
-		g_trace_log_buffer[reset_reason_offset++] = date_info->day;
-		g_trace_log_buffer[reset_reason_offset++] = date_info->hour;
-		g_trace_log_buffer[reset_reason_offset++] = date_info->min;
-		g_trace_log_buffer[reset_reason_offset++] = date_info->sec;
-		
-		for ( idx = 0; idx < TRACE_LOG_SIZE; idx++ )
-		{
-			/* Set Trace Data */
-			g_trace_log_buffer[reset_reason_offset++] = g_trace_data->trace_data[idx].trace_id;
-			g_trace_log_buffer[reset_reason_offset++] = g_trace_data->trace_data[idx].nested_interrupt;
-			g_trace_log_buffer[reset_reason_offset++] = ( g_trace_data->trace_data[idx].func_no & TRACE_DATA_ROM1_MASK ) >> 8;
-			g_trace_log_buffer[reset_reason_offset++] = ( g_trace_data->trace_data[idx].func_no & TRACE_DATA_ROM2_MASK );
-			g_trace_log_buffer[reset_reason_offset++] = ( g_trace_data->trace_data[idx].param & TRACE_DATA_ROM1_MASK ) >> 8;
-			g_trace_log_buffer[reset_reason_offset++] = ( g_trace_data->trace_data[idx].param & TRACE_DATA_ROM2_MASK );
-		}
-	}
-	return ;
-}
-
 /**
  * @brief Setup Reset Reason Write Data
  * @param reason Reset Reason
@@ -397,12 +404,14 @@ static void setup_reason_write_data( uint32_t reason )
 static ret_code_t trace_log_flush_erase( nrf_fstorage_t *p_fstorage, uint32_t page_addr, uint32_t len, void *p_context )
 {
 	ret_code_t err_code;
+	ENERGY_PROF_ENTER( EP_SUB_FLASH );		/* 2026.10.19 Add */
 
 	/* Erase the DATA_STORAGE_PAGE before write operation */
 	err_code = nrf_fstorage_erase( p_fstorage, page_addr, len, p_context );
 	if( err_code != NRF_SUCCESS )
 	{
 		nrf_fstorage_uninit(p_fstorage, NULL);
+		ENERGY_PROF_EXIT();					/* 2026.10.19 Add */
 		return err_code;
 	}
 
@@ -411,6 +420,7 @@ static ret_code_t trace_log_flush_erase( nrf_fstorage_t *p_fstorage, uint32_t pa
 		__NOP();
 	}	while(nrf_fstorage_is_busy(p_fstorage));
 	
+	ENERGY_PROF_EXIT();						/* 2026.10.19 Add */
 	return NRF_SUCCESS;
 }
 
@@ -454,12 +464,14 @@ static ret_code_t trace_log_flush_write(
 	void *p_context )
 {
 	ret_code_t err_code;
+	ENERGY_PROF_ENTER( EP_SUB_FLASH );		/* 2026.10.19 Add */
 	
 	/* Write ROM */
 	err_code = nrf_fstorage_write( p_fstorage, page_addr, (uint8_t*)buffer, len, p_context );
 	if( err_code != NRF_SUCCESS )
 	{
 		nrf_fstorage_uninit(p_fstorage, NULL);
+		ENERGY_PROF_EXIT();					/* 2026.10.19 Add */
 		return err_code;
 	}
 
@@ -468,6 +480,7 @@ static ret_code_t trace_log_flush_write(
 		__NOP();
 	}	while(nrf_fstorage_is_busy(p_fstorage));
 	
+	ENERGY_PROF_EXIT();						/* 2026.10.19 Add */
 	return NRF_SUCCESS;
 }
 
@@ -480,4 +493,287 @@ static void fstorage_evt_handler( nrf_fstorage_evt_t * p_evt )
 {
 }
 
+/* 2026.10.19 Add Trace Journal ++ */
+/**
+ * @brief Trace Journal Page Address
+ * @param page Page
+ * @retval Page Address
+ */
+static uint32_t trace_journal_page_addr( uint8_t page )
+{
+	return TRACE_JOURNAL_START_ADDR + ( (uint32_t)page * TRACE_JOURNAL_PAGE_SIZE );
+}
+
+/**
+ * @brief Page Header Check値
+ * @param p_header Page Header
+ * @retval Check値
+ */
+static uint32_t trace_journal_header_check( const TRACE_JOURNAL_HEADER *p_header )
+{
+	return ~( p_header->magic ^ p_header->page_seq ^ p_header->first_seq );
+}
+
+/**
+ * @brief Entry Check値 (先頭7byteのXORを反転. Erase状態のEntryは不一致となる)
+ * @param p_entry Entry
+ * @retval Check値
+ */
+static uint8_t trace_journal_entry_check( const TRACE_JOURNAL_ENTRY *p_entry )
+{
+	const uint8_t *p_data = (const uint8_t *)p_entry;
+	uint8_t check = 0;
+	uint8_t idx;
+
+	for ( idx = 0; idx < ( TRACE_JOURNAL_ENTRY_SIZE - 1 ); idx++ )
+	{
+		check ^= p_data[idx];
+	}
+	return (uint8_t)~check;
+}
+
+/**
+ * @brief Entryが未書き込み(Erase状態)かどうか
+ * @param p_entry Entry
+ * @retval true 未書き込み
+ * @retval false 書き込み済み (書き込み途中でResetしたEntryを含む)
+ */
+static bool trace_journal_is_erased( const TRACE_JOURNAL_ENTRY *p_entry )
+{
+	const uint32_t *p_word = (const uint32_t *)p_entry;
+
+	return ( ( p_word[0] == 0xFFFFFFFFU ) && ( p_word[1] == 0xFFFFFFFFU ) );
+}
+
+/**
+ * @brief Trace Journal Mount (初回のみ全Pageを読み出して書き込み位置を決める)
+ * @param None
+ * @retval NRF_SUCCESS Success
+ * @retval NRF_SUCCESS以外 Failed
+ */
+static ret_code_t trace_journal_mount( void )
+{
+	ret_code_t err_code;
+	TRACE_JOURNAL_HEADER header;
+	TRACE_JOURNAL_ENTRY entry;
+	bool found = false;
+	uint8_t page;
+	uint16_t slot;
+	uint32_t page_addr;
+
+	if ( g_trace_journal.mounted == true )
+	{
+		return NRF_SUCCESS;
+	}
+
+	/* fstorage Initialize (Mount後はUninitializeしない) */
+	err_code = nrf_fstorage_init( &trace_journal_fstorage, &nrf_fstorage_sd, NULL );
+	if ( err_code != NRF_SUCCESS )
+	{
+		return err_code;
+	}
+
+	/* Page Seqが最も新しいPageを書き込み中のPageとする */
+	for ( page = 0; page < TRACE_JOURNAL_PAGE_NUM; page++ )
+	{
+		err_code = nrf_fstorage_read( &trace_journal_fstorage, trace_journal_page_addr( page ), &header, sizeof( header ) );
+		if ( err_code != NRF_SUCCESS )
+		{
+			return err_code;
+		}
+		if ( ( header.magic != TRACE_JOURNAL_MAGIC ) || ( header.check != trace_journal_header_check( &header ) ) )
+		{
+			continue;
+		}
+		if ( ( found == false ) || ( (int32_t)( header.page_seq - g_trace_journal.page_seq ) > 0 ) )
+		{
+			found = true;
+			g_trace_journal.page = page;
+			g_trace_journal.page_seq = header.page_seq;
+			g_trace_journal.next_seq = header.first_seq;
+		}
+	}
+
+	if ( found == false )
+	{
+		/* Trace Journal未使用 */
+		return trace_journal_format( 0, 0, 0 );
+	}
+
+	/* 書き込み位置 (最初のErase状態のEntry) */
+	page_addr = trace_journal_page_addr( g_trace_journal.page ) + TRACE_JOURNAL_HEADER_SIZE;
+	for ( slot = 0; slot < TRACE_JOURNAL_ENTRY_NUM; slot++ )
+	{
+		err_code = nrf_fstorage_read( &trace_journal_fstorage, page_addr + ( slot * TRACE_JOURNAL_ENTRY_SIZE ), &entry, sizeof( entry ) );
+		if ( err_code != NRF_SUCCESS )
+		{
+			return err_code;
+		}
+		if ( trace_journal_is_erased( &entry ) == true )
+		{
+			break;
+		}
+	}
+	g_trace_journal.slot = slot;
+	g_trace_journal.next_seq += slot;
+	g_trace_journal.mounted = true;
+
+	return NRF_SUCCESS;
+}
+
+/**
+ * @brief Trace Journal Page Format (Erase + Page Header書き込み)
+ * @param page Page
+ * @param page_seq Page Seq
+ * @param first_seq 先頭EntryのSequence No
+ * @retval NRF_SUCCESS Success
+ * @retval NRF_SUCCESS以外 Failed
+ */
+static ret_code_t trace_journal_format( uint8_t page, uint32_t page_seq, uint32_t first_seq )
+{
+	ret_code_t err_code;
+	static TRACE_JOURNAL_HEADER header;		/* 書き込み完了までBufferを保持する */
+	uint32_t page_addr;
+
+	/* 失敗した場合は次回のFlushでMountし直す */
+	g_trace_journal.mounted = false;
+	page_addr = trace_journal_page_addr( page );
+
+	/* ROM erase */
+	err_code = trace_log_flush_erase( &trace_journal_fstorage, page_addr, 1, NULL );
+	if ( err_code != NRF_SUCCESS )
+	{
+		return err_code;
+	}
 
+	/* Page Header */
+	header.magic = TRACE_JOURNAL_MAGIC;
+	header.page_seq = page_seq;
+	header.first_seq = first_seq;
+	header.check = trace_journal_header_check( &header );
+	err_code = trace_log_flush_write( &trace_journal_fstorage, page_addr, (uint8_t *)&header, sizeof( header ), NULL );
+	if ( err_code != NRF_SUCCESS )
+	{
+		return err_code;
+	}
+
+	g_trace_journal.page = page;
+	g_trace_journal.slot = 0;
+	g_trace_journal.page_seq = page_seq;
+	g_trace_journal.next_seq = first_seq;
+	g_trace_journal.mounted = true;
+
+	return NRF_SUCCESS;
+}
+
+/**
+ * @brief Trace Journal Entryを設定
+ * @param p_entry Entry
+ * @param func_no Function Number
+ * @param param parameter
+ * @param nested_int Interrupt
+ * @retval None
+ */
+static void trace_journal_set_entry( TRACE_JOURNAL_ENTRY *p_entry, uint16_t func_no, uint16_t param, uint8_t nested_int )
+{
+	p_entry->seq = 0;
+	p_entry->func_no = func_no;
+	p_entry->param = param;
+	p_entry->nested_interrupt = nested_int;
+	p_entry->check = 0;
+}
+
+/**
+ * @brief 未書き込みのTrace LogをRAM RingからTrace Journal Entryへコピー
+ * @remark RAM Ringは最古の1件を削除済みとして扱うため, 保持できるのはTRACE_LOG_SIZE - 1件.
+ *         それを超えた分は欠落マーカー(TR_TRACE_JOURNAL_LOST)として記録する
+ * @param p_total コピー時点のTraceLog総数
+ * @retval コピーしたEntry数
+ */
+static uint16_t trace_journal_collect( uint16_t *p_total )
+{
+	TRACE_LOG_INFO *p_info;
+	uint16_t total;
+	uint16_t pending;
+	uint16_t num;
+	uint16_t count = 0;
+
+	CRITICAL_REGION_ENTER();
+	total = g_trace_data->trace_log_total;
+	pending = (uint16_t)( total - g_trace_data->trace_log_flushed );
+	if ( pending > ( TRACE_LOG_SIZE - 1 ) )
+	{
+		trace_journal_set_entry( &g_trace_journal_buffer[count++], TR_TRACE_JOURNAL_LOST, pending - ( TRACE_LOG_SIZE - 1 ), 0 );
+		pending = TRACE_LOG_SIZE - 1;
+	}
+	for ( num = (uint16_t)( total - pending ); num != total; num++ )
+	{
+		p_info = &g_trace_data->trace_data[num % TRACE_LOG_SIZE];
+		trace_journal_set_entry( &g_trace_journal_buffer[count++], p_info->func_no, p_info->param, p_info->nested_interrupt );
+	}
+	CRITICAL_REGION_EXIT();
+
+	*p_total = total;
+	return count;
+}
+
+/**
+ * @brief Trace Journal Entry追記 (Pageが一杯になったら次のPageへRotate)
+ * @remark Rotate時は最も古いPageをEraseする. それ以外は書き込み済みEntryの後ろへ追記するだけ
+ * @param p_entry Entry
+ * @param count Entry数
+ * @retval NRF_SUCCESS Success
+ * @retval NRF_SUCCESS以外 Failed
+ */
+static ret_code_t trace_journal_append( TRACE_JOURNAL_ENTRY *p_entry, uint16_t count )
+{
+	ret_code_t err_code;
+	uint16_t num;
+	uint16_t idx;
+	uint32_t write_addr;
+
+	while ( count > 0 )
+	{
+		if ( g_trace_journal.slot >= TRACE_JOURNAL_ENTRY_NUM )
+		{
+			/* Page Full. 次のPageへRotate */
+			err_code = trace_journal_format( ( g_trace_journal.page + 1 ) % TRACE_JOURNAL_PAGE_NUM,
+												g_trace_journal.page_seq + 1, g_trace_journal.next_seq );
+			if ( err_code != NRF_SUCCESS )
+			{
+				return err_code;
+			}
+		}
+
+		num = TRACE_JOURNAL_ENTRY_NUM - g_trace_journal.slot;
+		if ( num > count )
+		{
+			num = count;
+		}
+		for ( idx = 0; idx < num; idx++ )
+		{
+			p_entry[idx].seq = (uint16_t)( g_trace_journal.next_seq + idx );
+			p_entry[idx].check = trace_journal_entry_check( &p_entry[idx] );
+		}
+
+		/* Write ROM (Erase済みの領域へ追記) */
+		write_addr = trace_journal_page_addr( g_trace_journal.page ) + TRACE_JOURNAL_HEADER_SIZE +
+						( g_trace_journal.slot * TRACE_JOURNAL_ENTRY_SIZE );
+		err_code = trace_log_flush_write( &trace_journal_fstorage, write_addr, (uint8_t *)p_entry,
+											num * TRACE_JOURNAL_ENTRY_SIZE, NULL );
+		if ( err_code != NRF_SUCCESS )
+		{
+			/* 書き込み位置が不明なため次回のFlushでMountし直す */
+			g_trace_journal.mounted = false;
+			return err_code;
+		}
+
+		g_trace_journal.slot += num;
+		g_trace_journal.next_seq += num;
+		p_entry += num;
+		count -= num;
+	}
+
+	return NRF_SUCCESS;
+}
+/* 2026.10.19 Add Trace Journal -- */
@@ -62,7 +62,7 @@
 #include "ble_hci.h"
 #include "ble_srv_common.h"
 #include "ble_advdata.h"
-#include "ble_advertising.h"
+#include "ble_adv_scheduler.h"
 #include "ble_conn_params.h"
 #include "nrf_sdh.h"
 #include "nrf_sdh_soc.h"
@@ -77,6 +77,8 @@
 #include "nrf_ble_gatt.h"
 #include "nrf_ble_qwr.h"
 #include "nrf_pwr_mgmt.h"
+#include "nrf_delay.h"
+#include "ble_bas.h"
 
 #include "nrf_log.h"
 #include "nrf_log_ctrl.h"
@@ -92,20 +94,26 @@
 #include "lib_icm42607.h"
 #include "lib_adc.h"
 #include "lib_ex_rtc.h"
+#include "lib_token_log.h"
+#include "lib_trace_log.h"
+#include "lib_tilt_detect.h"
+#include "AccAngle.h"
+#include "lib_energy_prof.h"
+#include "lib_ble_profile.h"
+#include "lib_notify_queue.h"
+
+#if BENCH_ENABLED
+#include "bench.h"
+#endif
 
 #define DEVICE_NAME                     "B51"                       /**< Name of device. Will be included in the advertising data. */
 
 #define MANUFACTURER_NAME               "Chicony"                   /**< Manufacturer. Will be passed to Device Information Service. */
-#define APP_ADV_INTERVAL                300                                     /**< The advertising interval (in units of 0.625 ms. This value corresponds to 187.5 ms). */
-
-#define APP_ADV_DURATION                18000                                   /**< The advertising duration (180 seconds) in units of 10 milliseconds. */
 #define APP_BLE_OBSERVER_PRIO           3                                       /**< Application's BLE observer priority. You shouldn't need to modify this value. */
 #define APP_BLE_CONN_CFG_TAG            1                                       /**< A tag identifying the SoftDevice BLE configuration. */
 
-#define MIN_CONN_INTERVAL               MSEC_TO_UNITS(100, UNIT_1_25_MS)        /**< Minimum acceptable connection interval (0.1 seconds). */
-#define MAX_CONN_INTERVAL               MSEC_TO_UNITS(200, UNIT_1_25_MS)        /**< Maximum acceptable connection interval (0.2 second). */
-#define SLAVE_LATENCY                   0                                       /**< Slave latency. */
-#define CONN_SUP_TIMEOUT                MSEC_TO_UNITS(4000, UNIT_10_MS)         /**< Connection supervisory timeout (4 seconds). */
+// Connection parameters, PHY and data length come from lib_ble_profile (BLE_PROFILE_*
+// of library/inc/definition.h): low power while idle, bulk while the energy report is read.
 
 #define FIRST_CONN_PARAMS_UPDATE_DELAY  APP_TIMER_TICKS(5000)                   /**< Time from initiating event (connect or start of notification) to first time sd_ble_gap_conn_param_update is called (5 seconds). */
 #define NEXT_CONN_PARAMS_UPDATE_DELAY   APP_TIMER_TICKS(30000)                  /**< Time between each call to sd_ble_gap_conn_param_update after the first call (30 seconds). */
@@ -122,28 +130,47 @@
 
 #define DEAD_BEEF                       0xDEADBEEF                              /**< Value used as error code on stack dump, can be used to identify stack location on stack unwind. */
 
-#define HEARTBEAT_INTERVAL APP_TIMER_TICKS(1000)
+// Tilt and fall are detected from wake-on-motion bursts, so the heartbeat
+// only refreshes battery/posture and catches slow tilts below the WOM threshold.
+#define HEARTBEAT_INTERVAL APP_TIMER_TICKS(10000)
+
+#define TILT_SAMPLE_INTERVAL            APP_TIMER_TICKS(20)                     /**< IMU sampling period while motion is being evaluated (matches ACC_LP_ODR). */
+#define TILT_BURST_SAMPLES              100                                     /**< Samples taken after the last wake-on-motion interrupt (2 seconds). */
+#define TILT_MOUNT_CALIB_SAMPLES        500                                     /**< Samples (10 seconds) after power-up in which the upright mounting pose is looked for. */
+#define TILT_MOUNT_ENTER                (-0.76f)                                /**< With the mounting angle: TILT beyond ~40 deg from upright (cos against -z). */
+#define TILT_MOUNT_EXIT                 (-0.83f)                                /**< With the mounting angle: STAND again within ~34 deg of upright. */
+
+#define TOKEN_LOG_RTT_CHANNEL           1                                       /**< RTT up buffer carrying binary token log frames (tools/token_log_decode.py). */
+#define TOKEN_LOG_RTT_BUFFER_SIZE       1024
+
+#define PROFILE_BULK_HOLD               APP_TIMER_TICKS(3000)                   /**< Bulk connection profile kept after the energy report changed. */
+
+#define ENERGY_PROF_HEARTBEATS          6                                       /**< Energy profile window in heartbeats (60 seconds); read with tools/energy_prof.py. */
 
 #define UPSIDE_DOWN 1
 #define SILENCE_RUN 1
 
-enum TRIPOD_STATUS
-{
-    TRIPOD_INIT,
-    TRIPOD_STAND,
-    TRIPOD_TILT
-};
-
 NRF_BLE_GATT_DEF(m_gatt);                                                       /**< GATT module instance. */
 NRF_BLE_QWR_DEF(m_qwr);                                                         /**< Context for the Queued Write module.*/
-BLE_ADVERTISING_DEF(m_advertising);   
+BLE_BAS_DEF(m_bas);                                                             /**< Battery service instance (level from the battery monitor). */
 APP_TIMER_DEF(m_heartbeat_timer);
+APP_TIMER_DEF(m_tilt_sample_timer);
+APP_TIMER_DEF(m_profile_bulk_timer);                                            /**< Ends the bulk profile PROFILE_BULK_HOLD after the last kick. */
 
 static volatile bool m_heartbeat_flag = false;
+static volatile bool m_tilt_sample_flag = false;
+static volatile bool m_profile_bulk_flag = false;                               /**< Bulk hold time is over, back to the low power profile. */
+static uint16_t m_tilt_burst_left = 0;                                          /**< Remaining burst samples (0: burst stopped). */
+static uint32_t m_tilt_last_tick = 0;
+static uint64_t m_tilt_ticks = 0;
+static ACC_ANGLE m_mount_angle;                                                 /**< Mounting angle (AccAngle.c), kept in flash by lib_angle_flash. */
+static uint8_t m_mount_state = ANGLE_ADJUST_DISABLE;                            /**< ANGLE_ADJUST_ENABLE once the mounting angle is known. */
+static uint16_t m_mount_calib_left = 0;                                         /**< Samples left for the mounting calibration after power-up. */
+static uint8_t m_token_log_rtt_buffer[TOKEN_LOG_RTT_BUFFER_SIZE];
 static uint32_t m_heartbeat_cnt = 0;
 
 static uint16_t m_conn_handle = BLE_CONN_HANDLE_INVALID;                        /**< Handle of the current connection. */
-//static ble_motion_t m_motion;
+static ble_motion_t m_motion;
 
 /* YOUR_JOB: Declare all services structure your application is using
  *  BLE_XYZ_DEF(m_xyz);
@@ -151,24 +178,15 @@ static uint16_t m_conn_handle = BLE_CONN_HANDLE_INVALID;
 static motion_adv_mfg_data_t m_custom_adv_payload =
 {
     .app_id =       APP_ID,    
+    .ver =          ADV_PAYLOAD_VERSION,
     .device_id =    DEVICE_ID,
-    .event =        STATUS_ERROR,
- //   .index = 0,
+    .seq =          0,
+    .event =        STATUS_BOOT,
+    .flags =        0,
     .x = 0x10,
     .y = 0x20,
     .z = 0x30,
     .bat = 0x40,    
-
-    .one = 1,
-    .two = 2,
-    .three = 3,
-    .four = 4,         
-};
-
-// YOUR_JOB: Use UUIDs for service(s) used in your application.
-static ble_uuid_t m_adv_uuids[] =                                               /**< Universally unique service identifiers. */
-{
-    {BLE_UUID_DEVICE_INFORMATION_SERVICE, BLE_UUID_TYPE_BLE}
 };
 
 
@@ -204,6 +222,41 @@ void assert_nrf_callback(uint16_t line_num, const uint8_t * p_file_name)
 }
 
 
+/**@brief Fault handler (replaces the weak one of app_error_weak.c).
+ *
+ * @details Appends the trace log to the flash journal before the reset. TraceFlush() waits for
+ *          the SoftDevice flash events, so interrupts stay enabled; from interrupt context it
+ *          refuses and the entries stay in retained RAM for the flush after the reset.
+ */
+void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info)
+{
+    TRACE_LOG(TR_APP_FAULT, (uint16_t)id);
+    (void)TraceFlush();
+
+    NRF_LOG_FINAL_FLUSH();
+#ifdef DEBUG
+    app_error_save_and_stop(id, pc, info);
+#else
+    NVIC_SystemReset();
+#endif
+}
+
+
+/**@brief Error check of the library drivers (LIB_ERR_CHECK).
+ *
+ * @details lib_common.c of the shoes application is not part of the badge, the error is
+ *          traced with its driver id and handled like any other SDK error.
+ */
+void LibErrorCheck(uint32_t err_code, uint8_t trace_id, uint16_t line)
+{
+    if (err_code != NRF_SUCCESS)
+    {
+        TRACE_LOG(TR_OTHER_ERROR_HEADER | trace_id, line);
+        APP_ERROR_HANDLER(err_code);
+    }
+}
+
+
 /**@brief Function for handling Peer Manager events.
  *
  * @param[in] p_evt  Peer Manager event.
@@ -228,12 +281,29 @@ static void pm_evt_handler(pm_evt_t const * p_evt)
 static void heartbeat_timeout_handler(void * p_context)
 {
 //    UNUSED_PARAMETER(p_context);
+    ENERGY_PROF_WAKE(EP_WAKE_TIMER);
 
     m_heartbeat_flag = true;
 
 //	app_status_set(STATUS_HEARTBEAT);
 }
 
+static void tilt_sample_timeout_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    ENERGY_PROF_WAKE(EP_WAKE_TIMER);
+    m_tilt_sample_flag = true;
+}
+
+static void profile_bulk_timeout_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    ENERGY_PROF_WAKE(EP_WAKE_TIMER);
+    m_profile_bulk_flag = true;
+}
+
 /**@brief Function for the Timer initialization.
  *
  * @details Initializes the timer module. This creates and starts application timers.
@@ -249,6 +319,25 @@ static void timers_init(void)
                                 APP_TIMER_MODE_REPEATED,
                                 heartbeat_timeout_handler);
     APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_create(&m_tilt_sample_timer,
+                                APP_TIMER_MODE_REPEATED,
+                                tilt_sample_timeout_handler);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_create(&m_profile_bulk_timer,
+                                APP_TIMER_MODE_SINGLE_SHOT,
+                                profile_bulk_timeout_handler);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Connection handle for the profile and the notify queue (BLE_CONN_HANDLE_INVALID when not connected).
+ */
+static void conn_handle_get(uint16_t * p_conn_handle)
+{
+    // The motion service drops its handle on disconnect, m_conn_handle is kept.
+    *p_conn_handle = m_motion.conn_handle;
 }
 
 
@@ -275,12 +364,9 @@ static void gap_params_init(void)
        err_code = sd_ble_gap_appearance_set(BLE_APPEARANCE_);
        APP_ERROR_CHECK(err_code); */
 
+    // The low power profile is what a new connection is negotiated to.
     memset(&gap_conn_params, 0, sizeof(gap_conn_params));
-
-    gap_conn_params.min_conn_interval = MIN_CONN_INTERVAL;
-    gap_conn_params.max_conn_interval = MAX_CONN_INTERVAL;
-    gap_conn_params.slave_latency     = SLAVE_LATENCY;
-    gap_conn_params.conn_sup_timeout  = CONN_SUP_TIMEOUT;
+    GetBleProfileConnParam(false, &gap_conn_params);
 
     err_code = sd_ble_gap_ppcp_set(&gap_conn_params);
     APP_ERROR_CHECK(err_code);
@@ -341,6 +427,7 @@ static void services_init(void)
 {
     ret_code_t         err_code;
     nrf_ble_qwr_init_t qwr_init = {0};
+    ble_bas_init_t     bas_init;
 
     // Initialize Queued Write Module.
     qwr_init.error_handler = nrf_qwr_error_handler;
@@ -348,6 +435,28 @@ static void services_init(void)
     err_code = nrf_ble_qwr_init(&m_qwr, &qwr_init);
     APP_ERROR_CHECK(err_code);
 
+    // Motion service; carries the energy profile characteristic. Its status
+    // notifications go through the notify queue.
+    err_code = ble_motion_init(&m_motion);
+    APP_ERROR_CHECK(err_code);
+    NotifyQueueInit(conn_handle_get);
+
+    NRF_SDH_BLE_OBSERVER(m_motion_observer, APP_BLE_OBSERVER_PRIO, ble_motion_on_ble_evt, &m_motion);
+
+    // Battery service; the level is the state of charge kept by the battery
+    // monitor (lib_adc), the same value the heartbeat advertises.
+    memset(&bas_init, 0, sizeof(bas_init));
+    bas_init.evt_handler          = NULL;
+    bas_init.support_notification = true;
+    bas_init.p_report_ref         = NULL;
+    bas_init.initial_batt_level   = AnalogGetBatterySoc();
+    bas_init.bl_rd_sec            = SEC_OPEN;
+    bas_init.bl_cccd_wr_sec       = SEC_OPEN;
+    bas_init.bl_report_rd_sec     = SEC_OPEN;
+
+    err_code = ble_bas_init(&m_bas, &bas_init);
+    APP_ERROR_CHECK(err_code);
+
     /* YOUR_JOB: Add code to initialize the services used by the application.
        ble_xxs_init_t                     xxs_init;
        ble_yys_init_t                     yys_init;
@@ -373,6 +482,27 @@ static void services_init(void)
 }
 
 
+/**@brief Update the battery service level from the battery monitor.
+ *
+ * @details Notifies the connected peer when it enabled notifications; the value
+ *          is kept in the attribute table otherwise.
+ */
+static void battery_level_update(void)
+{
+    ret_code_t err_code;
+
+    err_code = ble_bas_battery_level_update(&m_bas, AnalogGetBatterySoc(), BLE_CONN_HANDLE_ALL);
+    if ((err_code != NRF_SUCCESS) &&
+        (err_code != NRF_ERROR_INVALID_STATE) &&
+        (err_code != NRF_ERROR_RESOURCES) &&
+        (err_code != NRF_ERROR_BUSY) &&
+        (err_code != BLE_ERROR_GATTS_SYS_ATTR_MISSING))
+    {
+        APP_ERROR_HANDLER(err_code);
+    }
+}
+
+
 /**@brief Function for handling the Connection Parameters Module.
  *
  * @details This function will be called for all events in the Connection Parameters Module which
@@ -392,6 +522,11 @@ static void on_conn_params_evt(ble_conn_params_evt_t * p_evt)
         err_code = sd_ble_gap_disconnect(m_conn_handle, BLE_HCI_CONN_INTERVAL_UNACCEPTABLE);
         APP_ERROR_CHECK(err_code);
     }
+    else if (p_evt->evt_type == BLE_CONN_PARAMS_EVT_SUCCEEDED)
+    {
+        // The connection runs the low power profile, later profile changes are applied right away.
+        BleProfileReady(false);
+    }
 }
 
 
@@ -428,6 +563,37 @@ static void conn_params_init(void)
 }
 
 
+static void ble_profile_bulk_timer_restart(void)
+{
+    ret_code_t err_code;
+
+    (void)app_timer_stop(m_profile_bulk_timer);
+    err_code = app_timer_start(m_profile_bulk_timer, PROFILE_BULK_HOLD, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for initializing the BLE connection profile.
+ *
+ * @details Connection parameter changes go through the Connection Parameters module so it
+ *          negotiates towards the profile in use. The ATT MTU is left to the GATT module,
+ *          which negotiates NRF_SDH_BLE_GATT_MAX_MTU_SIZE once per connection.
+ */
+static void ble_profile_init(void)
+{
+    BLE_PROFILE_CONFIG const config =
+    {
+        .get_conn_handle    = conn_handle_get,
+        .mtu_update         = NULL,
+        .bulk_timer_restart = ble_profile_bulk_timer_restart,
+        .get_tx_bytes       = NULL,
+        .conn_param_update  = ble_conn_params_change_conn_params,
+    };
+
+    BleProfileInit(&config);
+}
+
+
 /**@brief Function for starting timers.
  */
 static void application_timers_start(void)
@@ -461,34 +627,6 @@ static void sleep_mode_enter(void)
 }
 
 
-/**@brief Function for handling advertising events.
- *
- * @details This function will be called for advertising events which are passed to the application.
- *
- * @param[in] ble_adv_evt  Advertising event.
- */
-static void on_adv_evt(ble_adv_evt_t ble_adv_evt)
-{
-    ret_code_t err_code;
-
-    switch (ble_adv_evt)
-    {
-        case BLE_ADV_EVT_FAST:
-            NRF_LOG_INFO("Fast advertising.");
-            err_code = bsp_indication_set(BSP_INDICATE_ADVERTISING);
-            APP_ERROR_CHECK(err_code);
-            break;
-
-        case BLE_ADV_EVT_IDLE:
-            sleep_mode_enter();
-            break;
-
-        default:
-            break;
-    }
-}
-
-
 /**@brief Function for handling BLE events.
  *
  * @param[in]   p_ble_evt   Bluetooth stack event.
@@ -498,12 +636,18 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
 {
     ret_code_t err_code = NRF_SUCCESS;
 
+    ENERGY_PROF_WAKE(EP_WAKE_BLE);
+    ENERGY_PROF_ENTER(EP_SUB_BLE);
+
     switch (p_ble_evt->header.evt_id)
     {
         case BLE_GAP_EVT_DISCONNECTED:
             NRF_LOG_INFO("Disconnected.");
-			ble_advertising_start(&m_advertising, BLE_ADV_MODE_FAST);
-            // LED indication will be changed when advertising starts.
+            BleProfileDisconnected();
+            (void)app_timer_stop(m_profile_bulk_timer);
+            // Advertising is restarted at the base interval by ble_adv_scheduler.
+            err_code = bsp_indication_set(BSP_INDICATE_ADVERTISING);
+            APP_ERROR_CHECK(err_code);
             break;
 
         case BLE_GAP_EVT_CONNECTED:
@@ -515,6 +659,10 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
             APP_ERROR_CHECK(err_code);
             break;
 
+        case BLE_GAP_EVT_CONN_PARAM_UPDATE:
+            BleProfileConnParamUpdated(&p_ble_evt->evt.gap_evt.params.conn_param_update.conn_params);
+            break;
+
         case BLE_GAP_EVT_PHY_UPDATE_REQUEST:
         {
             NRF_LOG_DEBUG("PHY update request.");
@@ -547,6 +695,8 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
             // No implementation needed.
             break;
     }
+
+    ENERGY_PROF_EXIT();
 }
 
 
@@ -574,7 +724,12 @@ static void ble_stack_init(void)
     APP_ERROR_CHECK(err_code);
 
     // Enable BLE stack.
+    // sd_ble_enable() returns the lowest application RAM start this configuration
+    // (251 byte data length, 247 byte MTU) allows. A linked start below it fails
+    // with NRF_ERROR_NO_MEM, which ends in app_error_fault_handler (TR_APP_FAULT).
+    uint32_t const ram_start_linked = ram_start;
     err_code = nrf_sdh_ble_enable(&ram_start);
+    SEGGER_RTT_printf(0, "SoftDevice RAM start linked %08x required %08x\n", ram_start_linked, ram_start);
     APP_ERROR_CHECK(err_code);
 
     // Register a handler for BLE events.
@@ -652,17 +807,6 @@ static void bsp_event_handler(bsp_event_t event)
             }
             break; // BSP_EVENT_DISCONNECT
 
-        case BSP_EVENT_WHITELIST_OFF:
-            if (m_conn_handle == BLE_CONN_HANDLE_INVALID)
-            {
-                err_code = ble_advertising_restart_without_whitelist(&m_advertising);
-                if (err_code != NRF_ERROR_INVALID_STATE)
-                {
-                    APP_ERROR_CHECK(err_code);
-                }
-            }
-            break; // BSP_EVENT_KEY_0
-
         default:
             break;
     }
@@ -670,39 +814,31 @@ static void bsp_event_handler(bsp_event_t event)
 
 
 /**@brief Function for initializing the Advertising functionality.
+ *
+ * @details The AD structure is encoded once; later changes of m_custom_adv_payload
+ *          are patched in place by ble_adv_sched_payload_update().
  */
 static void advertising_init(void)
 {
-    ret_code_t             err_code;
-    ble_advertising_init_t init;
-    ble_advdata_manuf_data_t manuf_data;    
+    ret_code_t               err_code;
+    ble_advdata_t            advdata;
+    ble_advdata_manuf_data_t manuf_data;
 
-    memset(&init, 0, sizeof(init));
+    memset(&advdata, 0, sizeof(advdata));
 
-    init.advdata.name_type               = BLE_ADVDATA_FULL_NAME;
-    init.advdata.include_appearance      = true;
-    init.advdata.flags                   = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
-    init.advdata.uuids_complete.uuid_cnt = sizeof(m_adv_uuids) / sizeof(m_adv_uuids[0]);
-    init.advdata.uuids_complete.p_uuids  = m_adv_uuids;
+    // The 16-bit UUID list is left out so the manufacturer payload fits in 31 bytes.
+    advdata.name_type               = BLE_ADVDATA_FULL_NAME;
+    advdata.include_appearance      = true;
+    advdata.flags                   = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
 
-    /* ===== 新增：Manufacturer Specific Data ===== */
-    manuf_data.company_identifier = 0xFFFF;   // 測試用 Company ID
+    manuf_data.company_identifier = COMPANY_ID;
     manuf_data.data.p_data        = (uint8_t *)&m_custom_adv_payload;
     manuf_data.data.size          = sizeof(m_custom_adv_payload);
 
-    init.advdata.p_manuf_specific_data = &manuf_data;
-    /* ===== 新增結束 ===== */    
-
-    init.config.ble_adv_fast_enabled  = true;
-    init.config.ble_adv_fast_interval = APP_ADV_INTERVAL;
-    init.config.ble_adv_fast_timeout  = APP_ADV_DURATION;
-
-    init.evt_handler = on_adv_evt;
+    advdata.p_manuf_specific_data = &manuf_data;
 
-    err_code = ble_advertising_init(&m_advertising, &init);
+    err_code = ble_adv_sched_init(&advdata, APP_BLE_CONN_CFG_TAG);
     APP_ERROR_CHECK(err_code);
-
-    ble_advertising_conn_cfg_tag_set(&m_advertising, APP_BLE_CONN_CFG_TAG);
 }
 
 
@@ -725,6 +861,48 @@ static void buttons_leds_init(bool * p_erase_bonds)
 }
 
 
+/**@brief Token log sink, writes one binary frame to the token log RTT channel.
+ */
+static void token_log_rtt_write(const uint8_t * p_data, uint16_t length)
+{
+    (void)SEGGER_RTT_Write(TOKEN_LOG_RTT_CHANNEL, p_data, length);
+}
+
+
+/**@brief Energy profile sink, writes the "EPROF <hex>" line to the debug console.
+ */
+static void energy_prof_write(const uint8_t * p_data, uint16_t length)
+{
+    (void)SEGGER_RTT_Write(0, p_data, length);
+}
+
+
+/**@brief Publish the energy profile of the last window and start a new one.
+ *
+ * @details The report is both readable from the motion service and printed,
+ *          tools/energy_prof.py turns it into an average current breakdown.
+ */
+static void energy_prof_publish(void)
+{
+    ENERGY_PROF_REPORT report;
+    ret_code_t         err_code;
+
+    EnergyProfGetReport(&report, true);
+
+    err_code = ble_motion_energy_set(&m_motion, (uint8_t const *)&report, sizeof(report));
+    APP_ERROR_CHECK(err_code);
+
+    // The central reads the report after it changes, the bulk profile keeps
+    // the Read Blob requests from waiting out the low power slave latency.
+    if (m_motion.conn_handle != BLE_CONN_HANDLE_INVALID)
+    {
+        BleProfileBulkKick();
+    }
+
+    EnergyProfDump(&report, energy_prof_write);
+}
+
+
 /**@brief Function for initializing the nrf log module.
  */
 static void log_init(void)
@@ -735,6 +913,11 @@ static void log_init(void)
     APP_ERROR_CHECK(err_code);
 
     NRF_LOG_DEFAULT_BACKENDS_INIT();
+
+    (void)SEGGER_RTT_ConfigUpBuffer(TOKEN_LOG_RTT_CHANNEL, "TokenLog",
+                                    m_token_log_rtt_buffer, sizeof(m_token_log_rtt_buffer),
+                                    SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    TokenLogInit(token_log_rtt_write);
 }
 
 
@@ -754,9 +937,20 @@ static void power_management_init(void)
  */
 static void idle_state_handle(void)
 {
-    if (NRF_LOG_PROCESS() == false)
+    bool log_pending;
+
+    {
+        ENERGY_PROF_ENTER(EP_SUB_LOG);
+        (void)TokenLogProcess();
+        log_pending = NRF_LOG_PROCESS();
+        ENERGY_PROF_EXIT();
+    }
+
+    if (log_pending == false)
     {
+        EnergyProfSleepEnter();
         nrf_pwr_mgmt_run();
+        EnergyProfSleepExit();
     }
 }
 
@@ -772,9 +966,11 @@ static void advertising_start(bool erase_bonds)
     }
     else
     {
-        ret_code_t err_code = ble_advertising_start(&m_advertising, BLE_ADV_MODE_FAST);
+        ret_code_t err_code = ble_adv_sched_start();
 
         APP_ERROR_CHECK(err_code);
+        err_code = bsp_indication_set(BSP_INDICATE_ADVERTISING);
+        APP_ERROR_CHECK(err_code);
     }
 }
 
@@ -791,41 +987,224 @@ void VerifyRamStart(void)
     APP_ERROR_CHECK(err_code);
 }
 
-static void advertising_update_mfg_data(void)
+/**@brief Advertise the current m_custom_adv_payload.
+ *
+ * @param[in] alarm  true for fall/tilt: the new sequence number (seq) is sent in a short burst.
+ */
+static void advertising_update_mfg_data(bool alarm)
 {
     ret_code_t err_code;
-	
- //   m_custom_adv_payload.event = new_status;
+    ENERGY_PROF_ENTER(EP_SUB_BLE);
 
-    // 1️⃣ 重新設定 advertising data
-    ble_advdata_t advdata;
-    ble_advdata_manuf_data_t manuf_data;
+    err_code = ble_adv_sched_payload_update(alarm);
+    if (err_code != NRF_SUCCESS &&
+        err_code != NRF_ERROR_INVALID_STATE &&
+        err_code != NRF_ERROR_CONN_COUNT)
+    {
+        APP_ERROR_CHECK(err_code);
+    }
 
-    memset(&advdata, 0, sizeof(advdata));
+    ENERGY_PROF_EXIT();
+}
 
-    manuf_data.company_identifier = COMPANY_ID;
-    manuf_data.data.p_data        = (uint8_t *)&m_custom_adv_payload;
-    manuf_data.data.size          = sizeof(m_custom_adv_payload) ;
+/**@brief Milliseconds since boot for the tilt detector (app_timer counter wraps every 512 s).
+ */
+static uint32_t tilt_time_ms(void)
+{
+    uint32_t now = app_timer_cnt_get();
 
-    advdata.name_type               = BLE_ADVDATA_FULL_NAME;
-    advdata.include_appearance      = true;
-    advdata.flags                   = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
-    advdata.p_manuf_specific_data   = &manuf_data;
+    m_tilt_ticks += app_timer_cnt_diff_compute(now, m_tilt_last_tick);
+    m_tilt_last_tick = now;
 
- //   err_code = ble_advdata_set(&advdata, NULL);
-    err_code = ble_advertising_advdata_update(&m_advertising, &advdata, NULL);
-    APP_ERROR_CHECK(err_code);
+    return (uint32_t)((m_tilt_ticks * 1000) / APP_TIMER_CLOCK_FREQ);
+}
 
-    // 2️⃣ 如果目前沒有連線，才重新啟動 advertising
-  //  if (m_motion.conn_handle == BLE_CONN_HANDLE_INVALID)
-  //  {
-        err_code = ble_advertising_start(&m_advertising, BLE_ADV_MODE_FAST);
-        if (err_code != NRF_SUCCESS &&
-            err_code != NRF_ERROR_INVALID_STATE)
+/**@brief Angle adjust storage of SetupAngleAdjust()/SaveAngleAdjust() (AccAngle.c).
+ */
+void SetAngleAdjustInfo(ACC_ANGLE * angle_info)
+{
+    m_mount_angle = *angle_info;
+}
+
+void GetAngleAdjustInfo(ACC_ANGLE * angle_info)
+{
+    *angle_info = m_mount_angle;
+}
+
+void ChangeAngleAdjustState(uint8_t state)
+{
+    m_mount_state = state;
+}
+
+void GetAngleAdjustState(uint8_t * state)
+{
+    *state = m_mount_state;
+}
+
+/**@brief Mounting correction hook of the tilt detector.
+ */
+static void tilt_mount_rot(int16_t x, int16_t y, int16_t z, TILT_ACC * p_result)
+{
+    ACC_RESULT rot;
+
+    calc_acc_rot(x, y, z, &rot);
+    p_result->x = rot.x;
+    p_result->y = rot.y;
+    p_result->z = rot.z;
+}
+
+/**@brief (Re)start the tilt detector for the current mounting angle.
+ *
+ * @details calc_acc_rot() turns the calibrated upright pose into +z, so a tilt
+ *          in any direction moves gravity towards the -z axis of the detector.
+ *          Without a mounting angle the default fallen axis (+z) is used.
+ */
+static void tilt_detect_setup(void)
+{
+    TILT_DETECT_CONFIG config;
+
+    TiltDetectGetDefaultConfig(&config);
+    if (m_mount_state == ANGLE_ADJUST_ENABLE)
+    {
+        config.axis[0]    = 0.0f;
+        config.axis[1]    = 0.0f;
+        config.axis[2]    = -1.0f;
+        config.tilt_enter = TILT_MOUNT_ENTER;
+        config.tilt_exit  = TILT_MOUNT_EXIT;
+        config.rot_func   = tilt_mount_rot;
+    }
+    TiltDetectInit(&config);
+}
+
+/**@brief Look for the upright mounting pose; store it and switch the detector over once found.
+ */
+static void tilt_mount_calib(int16_t x, int16_t y, int16_t z)
+{
+    ACC_ANGLE angle;
+
+    // clac_acc_angle() judges stillness in mg.
+    if (clac_acc_angle((int16_t)((float)x * 1000.0f / ACC_LP_SENSITIVITY),
+                       (int16_t)((float)y * 1000.0f / ACC_LP_SENSITIVITY),
+                       (int16_t)((float)z * 1000.0f / ACC_LP_SENSITIVITY),
+                       &angle) != NRF_SUCCESS)
+    {
+        return;
+    }
+
+    SetAngleAdjustInfo(&angle);
+    ChangeAngleAdjustState(ANGLE_ADJUST_ENABLE);
+    SaveAngleAdjust();
+    tilt_detect_setup();
+    m_mount_calib_left = 0;
+
+    SEGGER_RTT_printf(0, "[Mount] roll %d pitch %d mrad\n",
+                      (int)(angle.roll * 1000.0f), (int)(angle.pitch * 1000.0f));
+}
+
+/**@brief Read one IMU sample, feed the tilt detector and advertise posture changes.
+ *
+ * @details The IMU stays configured in low-power accel + WOM mode; it is only
+ *          set up again after an SPI error. On a failed read the previous
+ *          posture is kept.
+ */
+static void imu_sample_process(void)
+{
+    int16_t x, y, z;
+    TILT_EVT evt;
+    uint32_t err;
+
+    {
+        ENERGY_PROF_ENTER(EP_SUB_SENSOR);
+        err = AccGyroLowPowerStart(UTC_SUCCESS);
+        if (err == UTC_SUCCESS)
         {
-            APP_ERROR_CHECK(err_code);
+            err = AccGyroReadAccRaw(&x, &y, &z);
+        }
+        ENERGY_PROF_EXIT();
+    }
+    if (err != UTC_SUCCESS)
+    {
+        return;
+    }
+#if UPSIDE_DOWN
+    z = -z;
+#endif
+
+    m_custom_adv_payload.x = manu_imu_to_int8((float)x / ACC_LP_SENSITIVITY);
+    m_custom_adv_payload.y = manu_imu_to_int8((float)y / ACC_LP_SENSITIVITY);
+    m_custom_adv_payload.z = manu_imu_to_int8((float)z / ACC_LP_SENSITIVITY);
+
+    if (m_mount_calib_left > 0)
+    {
+        m_mount_calib_left--;
+        tilt_mount_calib(x, y, z);
+    }
+
+    {
+        ENERGY_PROF_ENTER(EP_SUB_ALGO);
+        evt = TiltDetectInput(x, y, z, tilt_time_ms());
+        ENERGY_PROF_EXIT();
+    }
+    switch (evt)
+    {
+        case TILT_EVT_FALL:
+            // Alarm right away; the posture that follows is reported by the tilt state.
+        case TILT_EVT_TILT:
+            // STATUS_ALARM lets the gateway and the host take the alarm fast path.
+            m_custom_adv_payload.flags |= ADV_FLAG_FALLEN;
+            m_custom_adv_payload.event = STATUS_ALARM;
+            break;
+
+        case TILT_EVT_STAND:
+            m_custom_adv_payload.flags &= (uint8_t)~ADV_FLAG_FALLEN;
+            m_custom_adv_payload.event = STATUS_POSTURE;
+            break;
+
+        default:
+            return;
+    }
+
+    // A new seq marks a new payload; receivers drop repeats of the same seq.
+    m_custom_adv_payload.seq ++;
+    advertising_update_mfg_data(evt != TILT_EVT_STAND);
+    // A connected central gets every event in order; not connected or not subscribed is not an error.
+    (void)ble_motion_status_notify(&m_motion, m_custom_adv_payload.event);
+    SEGGER_RTT_printf(0, "[Change] TILT evt %d state %d\n", evt, TiltDetectGetState());
+}
+
+/**@brief Start (or extend) 50 Hz IMU sampling after motion.
+ */
+static void tilt_burst_start(void)
+{
+    ret_code_t err_code;
+
+    if (m_tilt_burst_left == 0)
+    {
+        err_code = app_timer_start(m_tilt_sample_timer, TILT_SAMPLE_INTERVAL, NULL);
+        APP_ERROR_CHECK(err_code);
+    }
+    m_tilt_burst_left = TILT_BURST_SAMPLES;
+}
+
+/**@brief Count down the burst; keep sampling while the detector is still deciding.
+ */
+static void tilt_burst_update(void)
+{
+    if (m_tilt_burst_left > 0)
+    {
+        m_tilt_burst_left--;
+    }
+    if (m_tilt_burst_left == 0)
+    {
+        if (TiltDetectIsBusy() || (m_mount_calib_left > 0))
+        {
+            m_tilt_burst_left = 1;
+        }
+        else
+        {
+            (void)app_timer_stop(m_tilt_sample_timer);
         }
-  //  }
+    }
 }
 
 void PrintFloat(char* message, float value)
@@ -844,12 +1223,18 @@ int main(void)
 {
     SEGGER_RTT_Init();
 
+#if BENCH_ENABLED
+    // Microbenchmark build (armgcc BENCH=1): measure before the SoftDevice,
+    // timers and sensor interrupts can preempt, report over RTT and stop.
+    BenchTargetRun(BenchSuiteBadge());
+    for (;;)
+    {
+        __WFE();
+    }
+#endif
+
     ret_code_t err_code;  
-    float battery;
-    float ax, ay, az;
-    int tilt_value;
-    enum TRIPOD_STATUS tripod_last = TRIPOD_INIT;
-    enum TRIPOD_STATUS tripod_new ;
+    uint16_t battery_mv;
 
     bool erase_bonds;
 	SEGGER_RTT_printf(0, "Hello RTT!\n");
@@ -861,6 +1246,9 @@ int main(void)
 
     // Initialize.
     log_init();
+    // Trace log ring in retained RAM (0x2000FE00, outside the linker RAM region);
+    // must come before the first TRACE_LOG of the drivers.
+    TraceLogInit();
     timers_init();
     buttons_leds_init(&erase_bonds);
     power_management_init();
@@ -876,12 +1264,19 @@ int main(void)
     advertising_init();
     services_init();
     conn_params_init();
+    ble_profile_init();
 
     peer_manager_init();
 
+    // Battery is sampled by RTC2 -> PPI -> SAADC without waking the CPU;
+    // the heartbeat and the battery service only pick up the filtered value.
+    err_code = AnalogMonitorStart(BAT_MON_PERIOD_MS);
+    APP_ERROR_CHECK(err_code);
+
     // Start execution.
     NRF_LOG_INFO("Template example started.");
     application_timers_start();
+    EnergyProfInit();
 
 #if 1 // RTC
     ExRtcTest();
@@ -894,11 +1289,40 @@ int main(void)
     SEGGER_RTT_printf(0, "app_timer_start %d \n", err_code);
 
     nrf_delay_ms(1000);
+
+    // The mounting angle is calibrated once, standing upright after the first power-up.
+    SetupAngleAdjust();
+    tilt_detect_setup();
+    m_tilt_last_tick = app_timer_cnt_get();
+    if (m_mount_state != ANGLE_ADJUST_ENABLE)
+    {
+        m_mount_calib_left = TILT_MOUNT_CALIB_SAMPLES;
+        tilt_burst_start();
+    }
   
 
     // Enter main loop.
     for (;;)
     {
+        // Motion starts a short 50 Hz sampling burst so a fall is advertised
+        // within a few samples instead of at the next heartbeat.
+        if (AccGyroGetWomEvent())
+        {
+            tilt_burst_start();
+        }
+        if (m_tilt_sample_flag)
+        {
+            m_tilt_sample_flag = false;
+            imu_sample_process();
+            tilt_burst_update();
+        }
+
+        if (m_profile_bulk_flag)
+        {
+            m_profile_bulk_flag = false;
+            BleProfileBulkRelease();
+        }
+
         if (m_heartbeat_flag)
         {
             m_heartbeat_flag = false;
@@ -913,44 +1337,24 @@ int main(void)
 
 //            SEGGER_RTT_printf(0, "[HB] Index %d\n", m_custom_adv_payload.event);
 
-            battery = AnalogVoltageOneshot();
+            battery_mv = AnalogGetBatteryMv();
 
- //           SEGGER_RTT_printf(0, "[HB] Voltage mv %d\n", (int) (battery * 1000) );
+ //           SEGGER_RTT_printf(0, "[HB] Voltage mv %d SOC %d\n", battery_mv, AnalogGetBatterySoc());
 
-            m_custom_adv_payload.bat = manu_bat_to_uint8(  battery);
+            if (battery_mv != BAT_MON_INVALID_MV)
+            {
+                m_custom_adv_payload.bat = manu_bat_to_uint8((float)battery_mv / 1000.0f);
+                battery_level_update();
+            }
 
  //           SEGGER_RTT_printf(0, "[HB] Voltage %d\n", m_custom_adv_payload.bat);
-   
-     		AccGyroInitialize(0x00);
-            AccGyroOneshotAcc(&ax,&ay,&az); 
-#if UPSIDE_DOWN              
-            az *= -1;
-#endif            
-#if SILENCE_RUN           
-            ;
-#else            
-            SEGGER_RTT_printf(0, "[HB] AX %d\n", (int)(ax * 100) );     
-            SEGGER_RTT_printf(0, "[HB] AY %d\n", (int)(ay * 100) );  
-            SEGGER_RTT_printf(0, "[HB] AZ %d\n", (int)(az * 100) );  
-#endif
-
-            tilt_value = (az * 100);
-            SEGGER_RTT_printf(0, "Tilt Value %d\n",tilt_value);
 
-            if ( tilt_value < 60 )
+            imu_sample_process();
+            if (TiltDetectIsBusy())
             {
-//                SEGGER_RTT_printf(0, "TRIPOD_STAND\n");                
-                tripod_new =  TRIPOD_STAND;
-            }    
-            else
-            {
-//                SEGGER_RTT_printf(0, "TRIPOD_TILT\n");   
-                tripod_new = TRIPOD_TILT;
+                // A posture change seen by the heartbeat is confirmed at the burst rate.
+                tilt_burst_start();
             }
-     
-            m_custom_adv_payload.x = manu_imu_to_int8(  ax);   
-            m_custom_adv_payload.y = manu_imu_to_int8(  ay); 
-            m_custom_adv_payload.z = manu_imu_to_int8(  az); 
 
 #if SILENCE_RUN           
             ;
@@ -960,16 +1364,16 @@ int main(void)
                 m_custom_adv_payload.y, 
                 m_custom_adv_payload.z);
 #endif
-            if ( tripod_last != tripod_new )    
-            {    
-                m_custom_adv_payload.event ++;
-                advertising_update_mfg_data();
-                SEGGER_RTT_printf(0, "[Change] TRI %d\n", tripod_new); 
-            }               
-
-            tripod_last = tripod_new;
 
             ExRtcPrintTime();
+
+            // Liveness for a connected central; a heartbeat still queued is replaced, not repeated.
+            (void)ble_motion_status_update(&m_motion, STATUS_HEARTBEAT);
+
+            if ((m_heartbeat_cnt % ENERGY_PROF_HEARTBEATS) == 0)
+            {
+                energy_prof_publish();
+            }
         }
           
         idle_state_handle();
@@ -0,0 +1,152 @@
+# activity_synth.py
+"""Write synthetic labelled sessions for the activity classifier (host/activity_host).
+
+Real sessions are recorded on the badge (TOKEN_LOG TL_ALGO_ACC_DATA or the raw
+notify stream, converted to mg) and labelled by hand. These synthetic ones only
+bootstrap the pipeline and keep it runnable without recordings. Their shapes are
+rough: stepping waveforms at walking/running/dashing cadence, and jumps with a
+flight phase and a landing impact.
+
+    python3 activity_synth.py -o ../host/_build/activity
+    python3 activity_synth.py -o /tmp/act --sessions 8 --seconds 60 --seed 7
+
+Each file is t_ms,ax_mg,ay_mg,az_mg,gx_dps,gy_dps,gz_dps,label at 100 Hz,
+in the axes mode_manager logs as TL_ALGO_ACC_DATA (offset corrected, no sign
+flip), so gravity sits mostly on -Y at rest.
+"""
+import argparse
+import math
+import random
+import sys
+from pathlib import Path
+
+ODR_HZ = 100
+ACC_LIMIT_MG = 16000                                    # ACC_FS_SEL_16G
+GYRO_LIMIT_DPS = 2000                                   # GYRO_FSS_2000DPS
+
+# cadence [Hz], vertical/forward/lateral amplitude [mg], gyro amplitude [dps]
+GAIT = {
+    "walk": ((1.5, 2.1), (250, 600), (150, 400), (80, 200), (60, 160)),
+    "run": ((2.4, 3.0), (1100, 1900), (500, 900), (250, 450), (250, 450)),
+    "dash": ((3.1, 3.9), (2200, 3400), (900, 1500), (350, 600), (450, 800)),
+}
+
+
+def clip(value, limit):
+    return max(-limit, min(limit, int(round(value))))
+
+
+class Session:
+    def __init__(self, rng):
+        self.rng = rng
+        self.rows = []
+        # mounting: gravity mostly on -Y, tilted a little per session
+        tilt = rng.uniform(-0.25, 0.25)
+        roll = rng.uniform(-0.25, 0.25)
+        self.gravity = (1000 * math.sin(tilt), -1000 * math.cos(tilt) * math.cos(roll), 1000 * math.sin(roll))
+
+    def emit(self, acc, gyro, label):
+        rng = self.rng
+        t_ms = len(self.rows) * 1000 // ODR_HZ
+        a = [clip(self.gravity[i] + acc[i] + rng.gauss(0, 6), ACC_LIMIT_MG) for i in range(3)]
+        g = [clip(gyro[i] + rng.gauss(0, 1.5), GYRO_LIMIT_DPS) for i in range(3)]
+        self.rows.append("%d,%d,%d,%d,%d,%d,%d,%s" % (t_ms, a[0], a[1], a[2], g[0], g[1], g[2], label))
+
+    def still(self, seconds):
+        for _ in range(int(seconds * ODR_HZ)):
+            self.emit((0, 0, 0), (0, 0, 0), "still")
+
+    def gait(self, label, seconds):
+        rng = self.rng
+        cadence, vert, fwd, lat, gyr = GAIT[label]
+        freq = rng.uniform(*cadence)
+        amp_v = rng.uniform(*vert)
+        amp_f = rng.uniform(*fwd)
+        amp_l = rng.uniform(*lat)
+        amp_g = rng.uniform(*gyr)
+        phase = rng.uniform(0, 2 * math.pi)
+        for n in range(int(seconds * ODR_HZ)):
+            p = phase + 2 * math.pi * freq * n / ODR_HZ
+            # heel strike: a sharp positive pulse once per step on top of the sine
+            strike = max(0.0, math.cos(p)) ** 6
+            v = amp_v * (0.6 * math.sin(p) + 0.8 * strike)
+            f = amp_f * math.sin(p + 1.2)
+            l = amp_l * math.sin(p / 2)
+            g = (amp_g * math.sin(p / 2), amp_g * 0.3 * math.sin(p), amp_g * 0.5 * math.cos(p / 2))
+            self.emit((f, -v, l), g, label)
+
+    def jump(self, seconds):
+        rng = self.rng
+        n = 0
+        total = int(seconds * ODR_HZ)
+        while n < total:
+            crouch = int(rng.uniform(0.15, 0.25) * ODR_HZ)
+            flight = int(rng.uniform(0.25, 0.40) * ODR_HZ)
+            land = int(rng.uniform(0.08, 0.14) * ODR_HZ)
+            rest = int(rng.uniform(0.10, 0.30) * ODR_HZ)
+            push = rng.uniform(1200, 2200)
+            impact = rng.uniform(3000, 5500)
+            for k in range(crouch):
+                s = math.sin(math.pi * k / crouch)
+                self.emit((0, -push * s, 0), (rng.gauss(0, 20), 0, 0), "jump")
+            for _ in range(flight):
+                # free fall: the sensor reads about 0 g
+                self.emit(tuple(-c for c in self.gravity), (rng.gauss(0, 30), rng.gauss(0, 30), 0), "jump")
+            for k in range(land):
+                s = math.sin(math.pi * k / land)
+                self.emit((rng.gauss(0, 200), -impact * s, rng.gauss(0, 150)), (rng.gauss(0, 80), 0, 0), "jump")
+            for _ in range(rest):
+                self.emit((0, 0, 0), (0, 0, 0), "jump")
+            n += crouch + flight + land + rest
+
+    def activity(self, label, seconds):
+        if label == "still":
+            self.still(seconds)
+        elif label == "jump":
+            self.jump(seconds)
+        else:
+            self.gait(label, seconds)
+
+
+def write(path: Path, session: Session, description: str) -> int:
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("# t_ms,ax_mg,ay_mg,az_mg,gx_dps,gy_dps,gz_dps,label\n")
+        f.write("# synthetic (tools/activity_synth.py): %s\n" % description)
+        f.write("\n".join(session.rows))
+        f.write("\n")
+    return 1
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-o", "--out", required=True, type=Path, help="output directory")
+    parser.add_argument("--sessions", type=int, default=4, help="sessions per activity (default 4)")
+    parser.add_argument("--seconds", type=float, default=40.0, help="length of a single-activity session (default 40)")
+    parser.add_argument("--seed", type=int, default=40, help="random seed (default 40)")
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    args.out.mkdir(parents=True, exist_ok=True)
+    labels = ["still", "walk", "run", "dash", "jump"]
+    written = 0
+    for i in range(args.sessions):
+        for label in labels:
+            s = Session(rng)
+            s.activity(label, args.seconds)
+            written += write(args.out / ("%s_%02d.csv" % (label, i)), s, "%s for %.0f s" % (label, args.seconds))
+        # mixed: a daily-life sequence with transitions inside windows
+        s = Session(rng)
+        plan = []
+        for _ in range(6):
+            label = rng.choice(labels)
+            seconds = rng.uniform(4.0, 12.0)
+            plan.append("%s %.1f s" % (label, seconds))
+            s.activity(label, seconds)
+        written += write(args.out / ("mixed_%02d.csv" % i), s, ", ".join(plan))
+
+    print("%d sessions in %s" % (written, args.out))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
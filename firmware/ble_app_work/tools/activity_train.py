@@ -0,0 +1,221 @@
+# activity_train.py
+"""Train the activity decision tree (algorithm/inc/activity_model.h) from labelled sessions.
+
+Features are not recomputed here: every session is replayed through the host
+build of activity_algo.c (host/_build/activity_host -f). The tree is therefore
+trained on exactly the int16 values the badge computes. The tree is a plain
+CART (Gini) with integer thresholds ("feature <= threshold" goes left). It is
+written in preorder, with the left child right after its parent, which is the
+layout ActivityClassify() walks.
+
+    make -C ../host
+    python3 activity_synth.py -o ../host/_build/activity          # or real recordings
+    python3 activity_train.py ../host/_build/activity/*.csv
+    python3 activity_train.py sessions/*.csv --depth 6 --gyro --out /tmp/activity_model.h
+
+Every --test-every'th session (sorted by name) is held out first and reported
+as the test score. The written model is then trained on all sessions.
+By default the gyro columns are ignored (-a), because DAILY mode samples
+the accelerometer only.
+"""
+import argparse
+import csv
+import io
+import subprocess
+import sys
+from collections import Counter
+from pathlib import Path
+
+TOOLS_DIR = Path(__file__).resolve().parent
+DEFAULT_HOST = TOOLS_DIR.parent / "host" / "_build" / "activity_host"
+DEFAULT_OUT = TOOLS_DIR.parent / "algorithm" / "inc" / "activity_model.h"
+
+# activity_algo.h
+CLASSES = ["still", "walk", "run", "dash", "jump"]
+CLASS_ENUM = ["ACTIVITY_STILL", "ACTIVITY_WALK", "ACTIVITY_RUN", "ACTIVITY_DASH", "ACTIVITY_JUMP"]
+FEATURES = ["x_mean", "y_mean", "z_mean", "x_sd", "y_sd", "z_sd", "x_zc", "y_zc", "z_zc",
+            "mag_sd", "energy", "peak_num", "peak_interval", "gyro_sd"]
+NODE_MAX = 255  # ACTIVITY_NODE.next is uint8_t
+
+
+def extract(host: Path, sessions, gyro: bool):
+    """Return [(session, label index, [features])] for the labelled windows."""
+    cmd = [str(host), "-f"] + ([] if gyro else ["-a"]) + [str(s) for s in sessions]
+    out = subprocess.run(cmd, check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    rows = []
+    for rec in csv.DictReader(io.StringIO(out)):
+        rows.append((rec["session"], CLASSES.index(rec["label"]), [int(rec[f]) for f in FEATURES]))
+    return rows
+
+
+def gini(counts, total):
+    return 1.0 - sum((c / total) ** 2 for c in counts.values()) if total else 0.0
+
+
+def best_split(rows, min_leaf):
+    """(feature, threshold, left, right) with the lowest weighted Gini, or None."""
+    total = len(rows)
+    parent = Counter(r[1] for r in rows)
+    best = None
+    best_score = gini(parent, total) - 1e-9
+    for f in range(len(FEATURES)):
+        ordered = sorted(rows, key=lambda r: r[2][f])
+        left = Counter()
+        right = parent.copy()
+        for i in range(total - 1):
+            label = ordered[i][1]
+            left[label] += 1
+            right[label] -= 1
+            value = ordered[i][2][f]
+            if value == ordered[i + 1][2][f] or (i + 1) < min_leaf or (total - i - 1) < min_leaf:
+                continue
+            score = ((i + 1) * gini(left, i + 1) + (total - i - 1) * gini(right, total - i - 1)) / total
+            if score < best_score:
+                best_score = score
+                best = (f, value, ordered[:i + 1], ordered[i + 1:])
+    return best
+
+
+def grow(rows, depth, min_leaf):
+    """Nested tree: ("leaf", class) or ("split", feature, threshold, left, right)."""
+    majority = Counter(r[1] for r in rows).most_common(1)[0][0]
+    if depth == 0 or len(set(r[1] for r in rows)) == 1:
+        return ("leaf", majority)
+    split = best_split(rows, min_leaf)
+    if split is None:
+        return ("leaf", majority)
+    f, threshold, left, right = split
+    lt = grow(left, depth - 1, min_leaf)
+    rt = grow(right, depth - 1, min_leaf)
+    if lt == rt and lt[0] == "leaf":
+        return lt
+    return ("split", f, threshold, lt, rt)
+
+
+def predict(tree, feature):
+    while tree[0] == "split":
+        tree = tree[3] if feature[tree[1]] <= tree[2] else tree[4]
+    return tree[1]
+
+
+def flatten(tree, nodes):
+    """Preorder list of (feature or -1, next or class, threshold, comment)."""
+    idx = len(nodes)
+    if tree[0] == "leaf":
+        nodes.append([-1, tree[1], 0, CLASSES[tree[1]]])
+        return
+    nodes.append([tree[1], 0, tree[2], "%s <= %d" % (FEATURES[tree[1]], tree[2])])
+    flatten(tree[3], nodes)
+    nodes[idx][1] = len(nodes)
+    flatten(tree[4], nodes)
+
+
+def depth_of(tree):
+    return 0 if tree[0] == "leaf" else 1 + max(depth_of(tree[3]), depth_of(tree[4]))
+
+
+def score(tree, rows):
+    confusion = [[0] * len(CLASSES) for _ in CLASSES]
+    for _, label, feature in rows:
+        confusion[label][predict(tree, feature)] += 1
+    correct = sum(confusion[i][i] for i in range(len(CLASSES)))
+    return (correct * 100.0 / len(rows)) if rows else 0.0, confusion
+
+
+def print_confusion(confusion):
+    print("  %-8s" % "label" + "".join(" %6s" % c for c in CLASSES))
+    for i, name in enumerate(CLASSES):
+        print("  %-8s" % name + "".join(" %6d" % v for v in confusion[i]))
+
+
+def write_header(path: Path, nodes, depth, summary):
+    lines = [
+        "/**",
+        "  ******************************************************************************************",
+        "  * @file    activity_model.h",
+        "  * @brief   Activity Classifierの決定木 (tools/activity_train.pyで生成. 手で編集しない)",
+        "  ******************************************************************************************",
+        "*/",
+        "",
+        "/*",
+    ]
+    lines += [" * %s" % s for s in summary]
+    lines += [
+        " */",
+        "",
+        "#ifndef ACTIVITY_MODEL_H_",
+        "#define ACTIVITY_MODEL_H_",
+        "",
+        '#include "activity_algo.h"',
+        "",
+        "#define ACTIVITY_MODEL_NODE_NUM\t\t(%d)" % len(nodes),
+        "#define ACTIVITY_MODEL_DEPTH\t\t(%d)" % depth,
+        "",
+        "/* feature, next (葉: class), threshold */",
+        "static const ACTIVITY_NODE g_activity_model[ACTIVITY_MODEL_NODE_NUM] =",
+        "{",
+    ]
+    for i, (feature, nxt, threshold, comment) in enumerate(nodes):
+        if feature < 0:
+            body = "{ ACTIVITY_NODE_LEAF, %s, 0 }," % CLASS_ENUM[nxt]
+        else:
+            body = "{ %d, %d, %d }," % (feature, nxt, threshold)
+        lines.append("\t%-44s/* %3d: %s */" % (body, i, comment))
+    lines += ["};", "", "#endif /* ACTIVITY_MODEL_H_ */", ""]
+    path.write_text("\n".join(lines), encoding="utf-8")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("sessions", nargs="+", type=Path, help="labelled session CSVs")
+    parser.add_argument("--host", type=Path, default=DEFAULT_HOST, help="activity_host binary")
+    parser.add_argument("--out", type=Path, default=DEFAULT_OUT, help="model header (default algorithm/inc/activity_model.h)")
+    parser.add_argument("--depth", type=int, default=5, help="maximum tree depth (default 5)")
+    parser.add_argument("--min-leaf", type=int, default=4, help="minimum windows per leaf (default 4)")
+    parser.add_argument("--test-every", type=int, default=4, help="hold out every Nth session for the test score (default 4)")
+    parser.add_argument("--gyro", action="store_true", help="use the gyro columns (gyro_sd feature)")
+    args = parser.parse_args()
+
+    sessions = sorted(args.sessions)
+    rows = extract(args.host, sessions, args.gyro)
+    if not rows:
+        print("no labelled windows", file=sys.stderr)
+        return 2
+    print("%d sessions, %d labelled windows: %s" % (
+        len(sessions), len(rows), ", ".join("%s %d" % (CLASSES[k], v) for k, v in sorted(Counter(r[1] for r in rows).items()))))
+
+    test_names = {str(s) for i, s in enumerate(sessions) if args.test_every > 0 and i % args.test_every == args.test_every - 1}
+    train = [r for r in rows if r[0] not in test_names]
+    test = [r for r in rows if r[0] in test_names]
+    if train and test:
+        tree = grow(train, args.depth, args.min_leaf)
+        train_acc, _ = score(tree, train)
+        test_acc, confusion = score(tree, test)
+        print("hold-out: train %.1f %% (%d windows), test %.1f %% (%d windows, %d sessions)"
+              % (train_acc, len(train), test_acc, len(test), len(test_names)))
+        print_confusion(confusion)
+
+    tree = grow(rows, args.depth, args.min_leaf)
+    nodes = []
+    flatten(tree, nodes)
+    if len(nodes) > NODE_MAX:
+        print("%d nodes do not fit ACTIVITY_NODE.next (uint8_t); lower --depth" % len(nodes), file=sys.stderr)
+        return 1
+    all_acc, confusion = score(tree, rows)
+    depth = depth_of(tree)
+    print("model: %d nodes, depth %d, %d bytes, training accuracy %.1f %%" % (len(nodes), depth, len(nodes) * 4, all_acc))
+    print_confusion(confusion)
+
+    summary = [
+        "%d sessions, %d labelled windows, %s" % (len(sessions), len(rows), "acc + gyro" if args.gyro else "acc only"),
+        "depth %d (max %d), min leaf %d, training accuracy %.1f %%" % (depth, args.depth, args.min_leaf, all_acc),
+    ]
+    if train and test:
+        summary.append("hold-out (every %dth session): test accuracy %.1f %%" % (args.test_every, test_acc))
+    write_header(args.out, nodes, depth, summary)
+    print("wrote %s" % args.out)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
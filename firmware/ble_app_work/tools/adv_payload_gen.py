@@ -0,0 +1,290 @@
+# adv_payload_gen.py
+"""Generate the advertisement payload definitions from tools/adv_payload.json.
+
+The badge (main.c), the host build, the gateway (bleadv_formater.c), webdash and
+dashboard all read the same manufacturer payload. They used to carry their own
+copies of the layout, and those copies had drifted apart. Every copy is now
+generated from one schema:
+
+    adv_payload.h                       badge and host build (packed structs, EVENT/FLAG defines)
+    ../ble_app_gateway/adv_payload.h    gateway (same file)
+    ../../webdash/adv_schema.py         struct decoder for Bleak manufacturer_data
+    ../../webdash/static/adv_schema.js  event/flag names for index.html
+    ../../dashboard/adv_schema.py       same decoder as webdash
+
+    python3 adv_payload_gen.py             # rewrite every file
+    python3 adv_payload_gen.py --check     # exit 1 if a file is out of date
+
+Versioned layouts carry a version byte ("ver") and only ever append fields.
+A receiver accepts its own version at its exact size, and decodes the prefix
+it knows of any newer (longer) version. Legacy layouts have no version byte
+and are told apart by their exact length, so a versioned layout must never
+have the size of a legacy one.
+"""
+import argparse
+import json
+import struct
+import sys
+from pathlib import Path
+
+TOOLS_DIR = Path(__file__).resolve().parent
+WORK_DIR = TOOLS_DIR.parent
+REPO_DIR = WORK_DIR.parent.parent
+SCHEMA = TOOLS_DIR / "adv_payload.json"
+
+C_TYPES = {"u8": "uint8_t", "i8": "int8_t", "u16": "uint16_t"}
+PY_FORMATS = {"u8": "B", "i8": "b", "u16": "H"}
+
+
+def load(path: Path):
+    schema = json.loads(path.read_text(encoding="utf-8"))
+    schema["company_id"] = int(schema["company_id"], 0)
+    schema["app_id"] = int(schema["app_id"], 0)
+    schema["flags"] = [(name, int(bit, 0), comment) for name, bit, comment in schema["flags"]]
+    for layout in schema["layouts"]:
+        layout["names"] = [f[0] for f in layout["fields"]]
+        layout["format"] = "<" + "".join(PY_FORMATS[f[1]] for f in layout["fields"])
+        layout["size"] = struct.calcsize(layout["format"])
+        layout["legacy"] = "ver" not in layout["names"]
+    current = layout_of(schema, schema["version"])
+    legacy_sizes = {l["size"] for l in schema["layouts"] if l["legacy"]}
+    for layout in schema["layouts"]:
+        if not layout["legacy"] and layout["size"] in legacy_sizes:
+            raise SystemExit("v%d is %d bytes, the size of a legacy layout" % (layout["version"], layout["size"]))
+    if current["legacy"] or current["names"][:2] != ["app_id", "ver"]:
+        raise SystemExit("v%d must start with app_id, ver" % schema["version"])
+    return schema
+
+
+def layout_of(schema, version: int):
+    for layout in schema["layouts"]:
+        if layout["version"] == version:
+            return layout
+    raise SystemExit("no layout for v%d" % version)
+
+
+def c_header(schema) -> str:
+    current = layout_of(schema, schema["version"])
+    v = schema["version"]
+    off = ver_offset(current)
+    lines = [
+        "/**",
+        "  ******************************************************************************************",
+        "  * @file    adv_payload.h",
+        "  * @brief   BadgeのManufacturer Specific Data (tools/adv_payload_gen.pyで生成. 手で編集しない)",
+        "  ******************************************************************************************",
+        "*/",
+        "",
+        "#ifndef ADV_PAYLOAD_H_",
+        "#define ADV_PAYLOAD_H_",
+        "",
+        "#include <stdint.h>",
+        "",
+        "#define ADV_COMPANY_ID\t\t\t(0x%04X)" % schema["company_id"],
+        "#define ADV_APP_ID\t\t\t\t(0x%04X)" % schema["app_id"],
+        "#define ADV_PAYLOAD_VERSION\t\t(%d)" % schema["version"],
+        "#define ADV_PAYLOAD_INVALID\t\t(-1)",
+        "",
+        "/* event */",
+    ]
+    for name, value, comment in schema["events"]:
+        lines.append("%-32s(%d)\t\t/* %s */" % ("#define ADV_EVENT_" + name, value, comment))
+    lines += ["", "/* flags (bit) */"]
+    for name, bit, comment in schema["flags"]:
+        lines.append("%-32s(0x%02X)\t/* %s */" % ("#define ADV_FLAG_" + name, bit, comment))
+    lines.append("")
+    for layout in schema["layouts"]:
+        lv = layout["version"]
+        lines.append("/* v%d: company_idの後 %d bytes. %s */" % (lv, layout["size"], layout["comment"]))
+        lines.append("typedef struct __attribute__((packed))")
+        lines.append("{")
+        for name, ftype, comment in layout["fields"]:
+            lines.append("\t%-10s%-14s/* %s */" % (C_TYPES[ftype], name + ";", comment))
+        lines.append("} adv_payload_v%d_t;" % lv)
+        lines.append("")
+        lines.append("#define ADV_PAYLOAD_V%d_SIZE\t\t(%d)" % (lv, layout["size"]))
+        lines.append("typedef char adv_payload_v%d_size_check[ ( sizeof( adv_payload_v%d_t ) == ADV_PAYLOAD_V%d_SIZE ) ? 1 : -1 ];"
+                     % (lv, lv, lv))
+        lines.append("")
+    lines += [
+        "/* 送信する版 */",
+        "typedef adv_payload_v%d_t adv_payload_t;" % v,
+        "",
+        "/**",
+        " * @brief company_idの後のpayloadの版を返す",
+        " * @param p_data payload (company_idの後)",
+        " * @param len payload長",
+        " * @retval 版 (ADV_PAYLOAD_INVALID: Badgeではない)",
+        " */",
+        "static inline int adv_payload_version( const uint8_t *p_data, uint8_t len )",
+        "{",
+        "\tif ( len < 2 || (uint16_t)( p_data[0] | ( p_data[1] << 8 ) ) != ADV_APP_ID )",
+        "\t{",
+        "\t\treturn ADV_PAYLOAD_INVALID;",
+        "\t}",
+    ]
+    for layout in schema["layouts"]:
+        if layout["legacy"]:
+            lines += [
+                "\tif ( len == ADV_PAYLOAD_V%d_SIZE )" % layout["version"],
+                "\t{",
+                "\t\treturn %d;" % layout["version"],
+                "\t}",
+            ]
+    lines += [
+        "\t/* 新しい版は後ろにfieldを足すだけ (v%d部分はそのまま読める) */" % v,
+        "\tif ( ( p_data[%d] == ADV_PAYLOAD_VERSION && len == ADV_PAYLOAD_V%d_SIZE ) ||" % (off, v),
+        "\t\t ( p_data[%d] > ADV_PAYLOAD_VERSION && len > ADV_PAYLOAD_V%d_SIZE ) )" % (off, v),
+        "\t{",
+        "\t\treturn p_data[%d];" % off,
+        "\t}",
+        "\treturn ADV_PAYLOAD_INVALID;",
+        "}",
+        "",
+        "#endif /* ADV_PAYLOAD_H_ */",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def ver_offset(layout) -> int:
+    return struct.calcsize(layout["format"][:1 + layout["names"].index("ver")])
+
+
+def py_module(schema) -> str:
+    current = layout_of(schema, schema["version"])
+    v = schema["version"]
+    legacy = [l for l in schema["layouts"] if l["legacy"]]
+    lines = [
+        "# adv_schema.py",
+        '"""',
+        "badge 廣播 manufacturer data 的解碼（firmware/ble_app_work/tools/adv_payload_gen.py 產生，不要手改）。",
+        "",
+        "company_id 之後的 payload → Adv；舊版（v0，沒有版本 byte）以長度判斷，轉成目前的欄位。",
+        "seq 相同的廣播是重複（badge 只在內容變化時 +1）。",
+        "",
+        "    adv = adv_schema.decode(advertisement_data.manufacturer_data.get(adv_schema.COMPANY_ID, b\"\"))",
+        '"""',
+        "import struct",
+        "from typing import NamedTuple",
+        "",
+        "COMPANY_ID = 0x%04X" % schema["company_id"],
+        "APP_ID = 0x%04X" % schema["app_id"],
+        "VERSION = %d" % v,
+        "",
+    ]
+    for name, value, comment in schema["events"]:
+        lines.append("%-24s# %s" % ("EVENT_%s = %d" % (name, value), comment))
+    lines.append("EVENT_NAMES = {%s}" % ", ".join("%d: %r" % (value, name) for name, value, _ in schema["events"]))
+    lines.append("")
+    for name, bit, comment in schema["flags"]:
+        lines.append("%-24s# %s" % ("FLAG_%s = 0x%02X" % (name, bit), comment))
+    lines.append("FLAG_NAMES = {%s}" % ", ".join("0x%02X: %r" % (bit, name) for name, bit, _ in schema["flags"]))
+    lines += ["", ""]
+    lines.append("class Adv(NamedTuple):")
+    for name, ftype, comment in current["fields"]:
+        lines.append("    %-24s# %s" % ("%s: int" % name, comment))
+    lines += ["", ""]
+    lines.append("%-40s# %d bytes" % ("V%d = struct.Struct(%r)" % (v, current["format"]), current["size"]))
+    for layout in legacy:
+        lines.append("%-40s# %d bytes: %s" % ("V%d = struct.Struct(%r)" % (layout["version"], layout["format"]),
+                                               layout["size"], ", ".join(layout["names"])))
+    lines += ["", ""]
+    lines += [
+        "def decode(data: bytes) -> Adv | None:",
+        '    """company_id 之後的 payload → Adv；不是 badge（或長度不對）則 None"""',
+        "    n = len(data)",
+    ]
+    for layout in legacy:
+        lv = layout["version"]
+        lines += [
+            "    if n == V%d.size:" % lv,
+            "        return _decode_v%d(data)" % lv,
+        ]
+    lines += [
+        "    if n < V%d.size:" % v,
+        "        return None",
+        "    ver = data[%d]" % ver_offset(current),
+        "    # 較新的版本只在後面加欄位（v%d 的部分照樣讀）" % v,
+        "    if not ((ver == VERSION and n == V%d.size) or (ver > VERSION and n > V%d.size)):" % (v, v),
+        "        return None",
+        "    adv = Adv._make(V%d.unpack_from(data))" % v,
+        "    return adv if adv.app_id == APP_ID else None",
+        "",
+    ]
+    for layout in legacy:
+        lines += legacy_decoder(layout)
+    lines += [
+        "",
+        "def flag_names(flags: int) -> list[str]:",
+        "    return [name for bit, name in FLAG_NAMES.items() if flags & bit]",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def legacy_decoder(layout) -> list[str]:
+    # v0 是唯一的舊版：event 是姿勢變化的計數（→ seq），one 是姿勢（→ FLAG_FALLEN）
+    if layout["version"] != 0:
+        raise SystemExit("no legacy conversion for v%d" % layout["version"])
+    return [
+        "",
+        "def _decode_v0(data: bytes) -> Adv | None:",
+        "    app_id, device_id, counter, x, y, z, bat, one, _, _, _ = V0.unpack(data)",
+        "    if app_id != APP_ID:",
+        "        return None",
+        "    return Adv(app_id, 0, device_id, counter, EVENT_POSTURE, FLAG_FALLEN if one == 1 else 0, x, y, z, bat)",
+        "",
+    ]
+
+
+def js_module(schema) -> str:
+    events = ", ".join("%d: %s" % (value, json.dumps(name)) for name, value, _ in schema["events"])
+    flags = ", ".join('{ bit: 0x%02X, name: %s }' % (bit, json.dumps(name)) for name, bit, _ in schema["flags"])
+    return "\n".join([
+        "// adv_schema.js",
+        "// badge 廣播的 event / flags 名稱（firmware/ble_app_work/tools/adv_payload_gen.py 產生，不要手改）",
+        "const ADV_VERSION = %d;" % schema["version"],
+        "const ADV_EVENTS = { %s };" % events,
+        "const ADV_FLAGS = [ %s ];" % flags,
+        "",
+    ])
+
+
+def outputs(schema):
+    header = c_header(schema)
+    module = py_module(schema)
+    return [
+        (WORK_DIR / "adv_payload.h", header),
+        (WORK_DIR.parent / "ble_app_gateway" / "adv_payload.h", header),
+        (REPO_DIR / "webdash" / "adv_schema.py", module),
+        (REPO_DIR / "webdash" / "static" / "adv_schema.js", js_module(schema)),
+        (REPO_DIR / "dashboard" / "adv_schema.py", module),
+    ]
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--schema", type=Path, default=SCHEMA)
+    parser.add_argument("--check", action="store_true", help="only compare, exit 1 if a file is out of date")
+    args = parser.parse_args()
+
+    schema = load(args.schema)
+    stale = 0
+    for path, text in outputs(schema):
+        old = path.read_text(encoding="utf-8") if path.exists() else None
+        if old == text:
+            continue
+        stale += 1
+        if args.check:
+            print("out of date: %s" % path)
+        else:
+            path.write_text(text, encoding="utf-8")
+            print("wrote %s" % path)
+    if args.check and stale:
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
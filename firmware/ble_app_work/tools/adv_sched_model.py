@@ -0,0 +1,175 @@
+# adv_sched_model.py
+"""Host model of the adaptive advertising policy (ble_adv_scheduler.c).
+
+Reports how long a gateway needs to see a new payload and how much charge
+the advertiser spends per hour, for a given gateway scan duty cycle. The
+policy timing is read from ble_adv_scheduler.h so the model follows the
+firmware.
+
+    # gateway scanning 30 ms every 100 ms, 4 alarms and 20 changes per hour
+    python3 adv_sched_model.py --scan-interval 100 --scan-window 30 --alarms 4 --changes 20
+    # compare with the old fixed 187.5 ms advertising
+    python3 adv_sched_model.py --scan-interval 100 --scan-window 30 --fixed 187.5
+
+The scanner is passive and moves to the next primary channel every scan
+interval. An advertising event sends the packet on channels 37, 38 and 39
+and is followed by the 0-10 ms advDelay of the link layer.
+"""
+import argparse
+import random
+import re
+import statistics
+import sys
+from pathlib import Path
+
+DEFAULT_HEADER = Path(__file__).resolve().parent.parent / "ble_adv_scheduler.h"
+
+ADV_DELAY_MAX_MS = 10.0
+CHANNEL_SPACING_MS = 0.45  # connectable 31-byte packet plus the radio ramp-up
+PACKET_MS = 0.376          # 47 bytes at 1 Mbps
+
+DEF_RE = re.compile(r"#define\s+BLE_ADV_SCHED_(\w+)\s+(MSEC_TO_UNITS|APP_TIMER_TICKS)\(\s*(\d+)")
+
+
+def load_policy(path: Path) -> dict:
+    """Return the BLE_ADV_SCHED_* timing in ms, e.g. {'BURST_INTERVAL': 20.0, ...}."""
+    text = path.read_text(encoding="utf-8", errors="replace")
+    return {name: float(ms) for name, _, ms in DEF_RE.findall(text)}
+
+
+class Policy:
+    """Interval over time after a payload update, as in sched_timeout_handler()."""
+
+    def __init__(self, p: dict, fixed_ms: float = None):
+        self.p = p
+        self.fixed_ms = fixed_ms
+
+    def interval(self, t: float, alarm: bool) -> float:
+        """Interval [ms] at t ms after an update (alarm or plain change)."""
+        p = self.p
+        if self.fixed_ms:
+            return self.fixed_ms
+        if alarm:
+            if t < p["BURST_DURATION"]:
+                return p["BURST_INTERVAL"]
+            t -= p["BURST_DURATION"]
+        level = p["BASE_INTERVAL"] * 2 ** int(t // p["STEP_DURATION"])
+        return min(level, p["MAX_INTERVAL"])
+
+    def events(self, t_end: float, alarm: bool, rng: random.Random):
+        """Yield adv event start times [ms] in [0, t_end)."""
+        t = 0.0
+        while t < t_end:
+            yield t
+            t += self.interval(t, alarm) + rng.uniform(0.0, ADV_DELAY_MAX_MS)
+
+
+class Scanner:
+    def __init__(self, interval_ms: float, window_ms: float, phase_ms: float, loss: float):
+        self.interval = interval_ms
+        self.window = window_ms
+        self.phase = phase_ms
+        self.loss = loss
+
+    def hears(self, t: float, channel: int, rng: random.Random) -> bool:
+        pos = t + self.phase
+        if (int(pos // self.interval) % 3) != channel:
+            return False
+        if (pos % self.interval) + PACKET_MS > self.window:
+            return False
+        return rng.random() >= self.loss
+
+
+def detect_latency(policy: Policy, scanner_args, alarm: bool, horizon_ms: float, rng: random.Random):
+    """Time from the update until the gateway receives the first packet (None: missed)."""
+    scanner = Scanner(*scanner_args[:2], rng.uniform(0.0, 3 * scanner_args[0]), scanner_args[2])
+    for t in policy.events(horizon_ms, alarm, rng):
+        for ch in range(3):
+            tx = t + ch * CHANNEL_SPACING_MS
+            if scanner.hears(tx, ch, rng):
+                return tx + PACKET_MS
+    return None
+
+
+def events_per_hour(policy: Policy, alarms: float, changes: float, rng: random.Random) -> int:
+    """Adv events in one hour with Poisson alarms and plain changes."""
+    hour = 3600e3
+    updates = []
+    for rate, alarm in ((alarms, True), (changes, False)):
+        t = 0.0
+        while rate > 0:
+            t += rng.expovariate(rate / hour)
+            if t >= hour:
+                break
+            updates.append((t, alarm))
+    updates.sort()
+    # Start idle at the long interval, as after a long time without changes.
+    starts = [(-hour, False)] + updates
+    count = 0
+    for i, (t0, alarm) in enumerate(starts):
+        t1 = starts[i + 1][0] if i + 1 < len(starts) else hour
+        for t in policy.events(t1 - t0, alarm, rng):
+            if t0 + t >= 0.0:
+                count += 1
+    return count
+
+
+def summary(values: list) -> str:
+    if not values:
+        return "no packet received"
+    values = sorted(values)
+    p95 = values[min(len(values) - 1, int(len(values) * 0.95))]
+    return "mean %8.1f ms  p50 %8.1f ms  p95 %8.1f ms" % (
+        statistics.mean(values), statistics.median(values), p95)
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description="Detection latency and charge of the advertising policy")
+    ap.add_argument("--header", type=Path, default=DEFAULT_HEADER, help="ble_adv_scheduler.h")
+    ap.add_argument("--scan-interval", type=float, default=100.0, help="gateway scan interval [ms]")
+    ap.add_argument("--scan-window", type=float, default=30.0, help="gateway scan window [ms]")
+    ap.add_argument("--loss", type=float, default=0.0, help="packet loss probability (collisions, fading)")
+    ap.add_argument("--alarms", type=float, default=4.0, help="alarms per hour")
+    ap.add_argument("--changes", type=float, default=20.0, help="plain payload changes per hour")
+    ap.add_argument("--event-uc", type=float, default=12.0, help="charge per adv event (3 channels) [uC]")
+    ap.add_argument("--sleep-ua", type=float, default=3.0, help="average current between events [uA]")
+    ap.add_argument("--fixed", type=float, help="model a fixed interval [ms] instead of the policy")
+    ap.add_argument("--runs", type=int, default=2000)
+    ap.add_argument("--seed", type=int, default=1)
+    args = ap.parse_args()
+
+    if not 0.0 < args.scan_window <= args.scan_interval:
+        ap.error("scan window must be in (0, scan interval]")
+
+    params = load_policy(args.header)
+    missing = {"BURST_INTERVAL", "BURST_DURATION", "BASE_INTERVAL", "MAX_INTERVAL", "STEP_DURATION"} - set(params)
+    if missing:
+        ap.error("%s: missing %s" % (args.header, ", ".join(sorted(missing))))
+
+    rng = random.Random(args.seed)
+    policy = Policy(params, args.fixed)
+    scanner_args = (args.scan_interval, args.scan_window, args.loss)
+    horizon = 120e3
+
+    print("policy   : %s" % ("fixed %.1f ms" % args.fixed if args.fixed else
+                             ", ".join("%s %.0f ms" % (k.lower(), v) for k, v in sorted(params.items()))))
+    print("gateway  : scan %.0f/%.0f ms (duty %.0f %%), loss %.0f %%" % (
+        args.scan_window, args.scan_interval, 100.0 * args.scan_window / args.scan_interval, 100.0 * args.loss))
+
+    for label, alarm in (("alarm", True), ("change", False)):
+        lat = [detect_latency(policy, scanner_args, alarm, horizon, rng) for _ in range(args.runs)]
+        seen = [v for v in lat if v is not None]
+        print("%-8s : %s  (missed %d/%d)" % (label, summary(seen), len(lat) - len(seen), len(lat)))
+        if alarm and not args.fixed:
+            in_burst = sum(1 for v in seen if v <= params["BURST_DURATION"])
+            print("%-8s   seen within the burst: %.1f %%" % ("", 100.0 * in_burst / len(lat)))
+
+    n = events_per_hour(policy, args.alarms, args.changes, rng)
+    charge_mc = (n * args.event_uc + args.sleep_ua * 3600.0) / 1000.0
+    print("charge   : %d adv events/h -> %.1f mC/h (%.2f uA average, %.0f alarms + %.0f changes/h)" % (
+        n, charge_mc, charge_mc * 1000.0 / 3600.0, args.alarms, args.changes))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,109 @@
+# bench_compare.py
+"""Compare two microbenchmark runs (bench/, one JSON object per line).
+
+Both the host build (bench/_build/badge_bench, ns) and the target builds
+(armgcc BENCH=1, DWT cycles over RTT) print the same lines, so a run is
+either the host output or an RTT/console capture; anything that is not a
+bench JSON line is skipped.
+
+    make -C bench run ARGS="-o /tmp/before.jsonl"
+    # ... change the code ...
+    make -C bench run ARGS="-o /tmp/after.jsonl"
+    python3 bench_compare.py /tmp/before.jsonl /tmp/after.jsonl
+    # target: JLinkRTTLogger capture of channel 0
+    python3 bench_compare.py before_rtt.log after_rtt.log --metric min --threshold 2
+
+A case is a REGRESSION/IMPROVED when the metric moved more than --threshold
+percent, and CHANGED when its check digest differs (the function now computes
+something else for the same input). The exit status is 1 on a regression or a
+changed result (unless --allow-changed), so it can gate a commit.
+"""
+import argparse
+import json
+import sys
+
+METRICS = ("min", "median", "mean", "max")
+
+
+def load(path: str):
+    """Return (meta, {(suite, case): result}) from a capture."""
+    meta = {}
+    cases = {}
+    with open(path, "r", encoding="utf-8", errors="replace") as f:
+        for line in f:
+            start = line.find("{")
+            if start < 0:
+                continue
+            try:
+                obj = json.loads(line[start:])
+            except ValueError:
+                continue
+            if obj.get("meta") == "start":
+                meta = obj
+            elif "suite" in obj and "case" in obj:
+                cases[(obj["suite"], obj["case"])] = obj
+    return meta, cases
+
+
+def describe(meta: dict) -> str:
+    if not meta:
+        return "?"
+    return "%s/%s rev %s" % (meta.get("target", "?"), meta.get("unit", "?"), meta.get("rev", "?"))
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("before", help="baseline capture")
+    parser.add_argument("after", help="capture to compare against the baseline")
+    parser.add_argument("--metric", choices=METRICS, default="median", help="value compared (default median)")
+    parser.add_argument("--threshold", type=float, default=10.0, help="percent change reported (default 10)")
+    parser.add_argument("--allow-changed", action="store_true", help="do not fail on check digest changes")
+    args = parser.parse_args()
+
+    meta_a, before = load(args.before)
+    meta_b, after = load(args.after)
+    if not before or not after:
+        print("no bench lines in %s" % (args.before if not before else args.after), file=sys.stderr)
+        return 2
+
+    print("before: %s" % describe(meta_a))
+    print("after:  %s" % describe(meta_b))
+    for key in ("target", "unit"):
+        if meta_a.get(key) != meta_b.get(key):
+            print("warning: %s differs (%s / %s), numbers are not comparable"
+                  % (key, meta_a.get(key), meta_b.get(key)), file=sys.stderr)
+
+    regressions = 0
+    changed = 0
+    print("\n%-8s %-32s %12s %12s %8s  %s" % ("suite", "case", "before", "after", "diff", ""))
+    for key in sorted(set(before) | set(after)):
+        a = before.get(key)
+        b = after.get(key)
+        if a is None or b is None:
+            print("%-8s %-32s %12s %12s %8s  %s" % (
+                key[0], key[1], "-" if a is None else a[args.metric], "-" if b is None else b[args.metric],
+                "", "ADDED" if a is None else "REMOVED"))
+            continue
+
+        va = a[args.metric]
+        vb = b[args.metric]
+        pct = (vb - va) * 100.0 / va if va else 0.0
+        flags = []
+        if pct > args.threshold:
+            flags.append("REGRESSION")
+            regressions += 1
+        elif pct < -args.threshold:
+            flags.append("IMPROVED")
+        if a.get("check") != b.get("check"):
+            flags.append("CHANGED")
+            changed += 1
+        print("%-8s %-32s %12d %12d %+7.1f%%  %s" % (key[0], key[1], va, vb, pct, " ".join(flags)))
+
+    print("\n%d regression(s) over %.1f %%, %d changed result(s)" % (regressions, args.threshold, changed))
+    if regressions or (changed and not args.allow_changed):
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,168 @@
+# energy_prof.py
+"""Turn energy profiler reports (lib_energy_prof.c) into an average current breakdown.
+
+The firmware only measures time: CPU cycles per subsystem and per wake reason
+(DWT, stops while sleeping) over a window measured with the RTC. This tool
+multiplies those times by a current model and adds the sleep floor, so the
+subsystems can be ranked by how much of the battery they take.
+
+    # RTT channel 0 / debug console capture, "EPROF <hex>" lines
+    python3 energy_prof.py console.log
+    # live from a UART (needs pyserial)
+    python3 energy_prof.py --serial /dev/ttyUSB0 --baud 115200
+    # value read from the motion service energy characteristic (0x1523)
+    python3 energy_prof.py --hex 0106054060ea0000...
+    # other current model
+    python3 energy_prof.py console.log --cpu-ma 7.4 --sleep-ua 2.5
+
+Several reports are summed before the breakdown is printed. The radio is not
+included in the CPU time; use --radio-uc with the number of advertising/
+connection events per hour (tools/adv_sched_model.py) to add it.
+"""
+import argparse
+import re
+import struct
+import sys
+
+# lib_energy_prof.h
+SUB_NAMES = ["other", "sensor", "algo", "flash", "ble", "log"]
+WAKE_NAMES = ["other", "timer", "sensor", "ble", "adc"]
+HEADER = struct.Struct("<BBBBI")
+LINE_RE = re.compile(r"EPROF ([0-9a-fA-F]+)")
+
+# Extra current on top of the CPU while a subsystem is active [mA].
+DEFAULT_EXTRA_MA = {"sensor": 0.5, "flash": 3.0}
+
+
+def parse_report(data: bytes) -> dict:
+    version, sub_num, wake_num, cpu_mhz, window_ms = HEADER.unpack_from(data)
+    if version != 1:
+        raise ValueError("unsupported report version %d" % version)
+    n = sub_num + 2 * wake_num
+    values = struct.unpack_from("<%dI" % n, data, HEADER.size)
+    return {
+        "cpu_mhz": cpu_mhz,
+        "window_ms": window_ms,
+        "active_us": list(values[:sub_num]),
+        "wake_count": list(values[sub_num:sub_num + wake_num]),
+        "wake_us": list(values[sub_num + wake_num:]),
+    }
+
+
+def merge(reports: list) -> dict:
+    total = {k: ([0] * len(v) if isinstance(v, list) else 0) for k, v in reports[0].items()}
+    for r in reports:
+        for k, v in r.items():
+            if isinstance(v, list):
+                total[k] = [a + b for a, b in zip(total[k], v)]
+            elif k == "window_ms":
+                total[k] += v
+            else:
+                total[k] = v
+    return total
+
+
+def name(names: list, idx: int) -> str:
+    return names[idx] if idx < len(names) else "#%d" % idx
+
+
+def breakdown(r: dict, args, out=sys.stdout):
+    window_us = r["window_ms"] * 1000.0
+    if window_us <= 0:
+        print("empty window", file=out)
+        return
+    hours = window_us / 3600e6
+    extra = dict(DEFAULT_EXTRA_MA)
+    for item in args.extra or []:
+        key, _, ma = item.partition("=")
+        extra[key] = float(ma)
+
+    active_us = sum(r["active_us"])
+    sleep_us = max(window_us - active_us, 0.0)
+    rows = []
+    for i, us in enumerate(r["active_us"]):
+        sub = name(SUB_NAMES, i)
+        ua = us / window_us * (args.cpu_ma + extra.get(sub, 0.0)) * 1000.0
+        rows.append((sub, us, ua))
+    sleep_ua = sleep_us / window_us * args.sleep_ua
+    radio_ua = args.radio_events * args.radio_uc / 3600.0
+    total_ua = sum(ua for _, _, ua in rows) + sleep_ua + radio_ua
+
+    print("window %.1f s, CPU active %.3f %% (%.1f ms)" % (
+        window_us / 1e6, 100.0 * active_us / window_us, active_us / 1000.0), file=out)
+    print("\n%-10s %12s %10s %10s %7s" % ("subsystem", "active ms", "duty %", "avg uA", "share"), file=out)
+    entries = rows + [("sleep", sleep_us, sleep_ua)]
+    if radio_ua:
+        entries.append(("radio", 0.0, radio_ua))
+    for sub, us, ua in sorted(entries, key=lambda e: -e[2]):
+        print("%-10s %12.2f %10.4f %10.2f %6.1f%%" % (
+            sub, us / 1000.0, 100.0 * us / window_us, ua, 100.0 * ua / total_ua if total_ua else 0.0), file=out)
+    print("%-10s %12s %10s %10.2f" % ("total", "", "", total_ua), file=out)
+
+    print("\n%-10s %10s %12s %10s" % ("wake", "per hour", "mean us", "avg uA"), file=out)
+    for i, (count, us) in enumerate(zip(r["wake_count"], r["wake_us"])):
+        if not count and not us:
+            continue
+        ua = us / window_us * args.cpu_ma * 1000.0
+        print("%-10s %10.0f %12.1f %10.2f" % (
+            name(WAKE_NAMES, i), count / hours, us / count if count else 0.0, ua), file=out)
+
+
+def read_lines(stream):
+    for line in stream:
+        if isinstance(line, bytes):
+            line = line.decode("utf-8", errors="replace")
+        m = LINE_RE.search(line)
+        if m:
+            yield bytes.fromhex(m.group(1))
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description="Average current breakdown from energy profiler reports")
+    ap.add_argument("input", nargs="?", help="text capture with EPROF lines ('-' for stdin)")
+    ap.add_argument("--serial", help="read EPROF lines from a serial port")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--hex", help="one report as hex (GATT read)")
+    ap.add_argument("--each", action="store_true", help="print every report instead of the sum")
+    ap.add_argument("--cpu-ma", type=float, default=3.7, help="CPU running from flash at 64 MHz [mA] (DCDC)")
+    ap.add_argument("--sleep-ua", type=float, default=3.0, help="System ON sleep incl. RTC and sensor [uA]")
+    ap.add_argument("--extra", action="append", metavar="SUB=MA",
+                    help="extra current while SUB is active (default sensor=0.5 flash=3.0)")
+    ap.add_argument("--radio-uc", type=float, default=12.0, help="charge per radio event [uC]")
+    ap.add_argument("--radio-events", type=float, default=0.0, help="radio events per hour")
+    args = ap.parse_args()
+
+    if args.hex:
+        breakdown(parse_report(bytes.fromhex(args.hex)), args)
+        return 0
+
+    if args.serial:
+        import serial  # pyserial
+        with serial.Serial(args.serial, args.baud, timeout=1.0) as port:
+            try:
+                for data in read_lines(iter(port.readline, None)):
+                    breakdown(parse_report(data), args)
+                    print()
+            except KeyboardInterrupt:
+                return 0
+        return 0
+
+    if not args.input:
+        ap.error("input file, --serial or --hex is required")
+    stream = sys.stdin if args.input == "-" else open(args.input, encoding="utf-8", errors="replace")
+    with stream:
+        reports = [parse_report(d) for d in read_lines(stream)]
+    if not reports:
+        print("no EPROF lines found", file=sys.stderr)
+        return 1
+    if args.each:
+        for r in reports:
+            breakdown(r, args)
+            print()
+    else:
+        breakdown(merge(reports), args)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
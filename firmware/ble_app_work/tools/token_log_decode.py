@@ -0,0 +1,173 @@
+# token_log_decode.py
+"""Decode binary token log frames (lib_token_log.c) on the host.
+
+The firmware never formats token log messages. It writes a message ID, a
+timestamp and raw 32-bit arguments; the format strings only exist in
+library/inc/lib_token_log_msg.h, which this tool reads to build its string
+table.
+
+    # RTT channel 1 captured with JLinkRTTLogger
+    python3 token_log_decode.py rtt_ch1.bin
+    # live from a UART (needs pyserial); text lines are passed through
+    python3 token_log_decode.py --serial /dev/ttyUSB0 --baud 115200
+    # write the string table for other tools
+    python3 token_log_decode.py --gen-table token_table.json
+"""
+import argparse
+import json
+import re
+import struct
+import sys
+from pathlib import Path
+
+DEFAULT_TABLE = Path(__file__).resolve().parent.parent / "library" / "inc" / "lib_token_log_msg.h"
+
+# lib_token_log.h
+TOKEN_LOG_SYNC = 0xA5
+TOKEN_LOG_HEADER_WORDS = 2
+TOKEN_LOG_ARG_MAX = 6
+TICK_MASK = 0xFFFFFF  # app_timer counter (RTC1, 24 bit)
+
+MSG_RE = re.compile(r'TOKEN_LOG_MSG\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+SPEC_RE = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z)?([duxXcf%])")
+
+
+def load_table(path: Path) -> list:
+    """Return [(name, fmt), ...] indexed by message ID."""
+    text = path.read_text(encoding="utf-8", errors="replace")
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return [(name, bytes(fmt, "utf-8").decode("unicode_escape")) for name, fmt in MSG_RE.findall(text)]
+
+
+def format_message(fmt: str, args: list) -> str:
+    it = iter(args)
+
+    def conv(m):
+        flags, kind = m.group(1), m.group(2)
+        if kind == "%":
+            return "%"
+        raw = next(it, None)
+        if raw is None:
+            return "<?>"
+        if kind == "d":
+            value = raw - (1 << 32) if raw & 0x80000000 else raw
+        elif kind == "f":
+            value = struct.unpack("<f", struct.pack("<I", raw))[0]
+        elif kind == "c":
+            value = chr(raw & 0xFF)
+        else:
+            value = raw
+        return ("%" + flags + kind) % value
+
+    return SPEC_RE.sub(conv, fmt)
+
+
+class Decoder:
+    """Stream decoder. Bytes that are not a valid frame are treated as text."""
+
+    def __init__(self, table: list, tick_hz: float, out=sys.stdout):
+        self.table = table
+        self.tick_hz = tick_hz
+        self.out = out
+        self.buf = bytearray()
+        self.text = bytearray()
+        self.last_tick = None
+        self.time = 0.0
+
+    def feed(self, data: bytes):
+        self.buf += data
+        while self.buf:
+            idx = self.buf.find(TOKEN_LOG_SYNC)
+            if idx < 0:
+                self._text(self.buf)
+                self.buf.clear()
+                return
+            if idx:
+                self._text(self.buf[:idx])
+                del self.buf[:idx]
+            if len(self.buf) < 4:
+                return
+            num = self.buf[1]
+            if num > TOKEN_LOG_ARG_MAX:
+                self._text(self.buf[:1])
+                del self.buf[:1]
+                continue
+            size = (TOKEN_LOG_HEADER_WORDS + num) * 4 + 1
+            if len(self.buf) < size:
+                return
+            frame = bytes(self.buf[:size])
+            check = 0
+            for b in frame[:-1]:
+                check ^= b
+            if check != frame[-1]:
+                self._text(self.buf[:1])
+                del self.buf[:1]
+                continue
+            del self.buf[:size]
+            self._frame(frame)
+
+    def _text(self, data):
+        for b in data:
+            if b == 0x0A:
+                line = self.text.decode("utf-8", errors="replace").rstrip("\r")
+                if line:
+                    print(f"{'':>12}  | {line}", file=self.out)
+                self.text.clear()
+            elif b == 0x0D or 0x20 <= b < 0x7F:
+                self.text.append(b)
+
+    def _frame(self, frame: bytes):
+        words = struct.unpack("<%dI" % ((len(frame) - 1) // 4), frame[:-1])
+        header, tick, args = words[0], words[1], list(words[2:])
+        msg_id = header >> 16
+        if self.last_tick is not None:
+            self.time += ((tick - self.last_tick) & TICK_MASK) / self.tick_hz
+        self.last_tick = tick
+        if msg_id < len(self.table):
+            name, fmt = self.table[msg_id]
+            text = format_message(fmt, args)
+        else:
+            name = f"ID_{msg_id}"
+            text = " ".join(f"0x{a:08x}" for a in args)
+        print(f"{self.time:12.6f}  {name:<24s} {text}", file=self.out, flush=True)
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description="Decode binary token log frames")
+    ap.add_argument("input", nargs="?", help="captured byte stream ('-' for stdin)")
+    ap.add_argument("--serial", help="read from a serial port instead of a file")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--table", type=Path, default=DEFAULT_TABLE, help="lib_token_log_msg.h")
+    ap.add_argument("--tick-hz", type=float, default=32768.0, help="app_timer tick rate")
+    ap.add_argument("--gen-table", type=Path, help="write the string table as JSON and exit")
+    args = ap.parse_args()
+
+    table = load_table(args.table)
+    if args.gen_table:
+        args.gen_table.write_text(json.dumps(
+            [{"id": i, "name": n, "fmt": f} for i, (n, f) in enumerate(table)], indent=2))
+        return 0
+
+    dec = Decoder(table, args.tick_hz)
+    if args.serial:
+        import serial  # pyserial
+        with serial.Serial(args.serial, args.baud, timeout=0.1) as port:
+            try:
+                while True:
+                    dec.feed(port.read(256))
+            except KeyboardInterrupt:
+                return 0
+    if not args.input:
+        ap.error("input file or --serial is required")
+    stream = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+    with stream:
+        while True:
+            chunk = stream.read(4096)
+            if not chunk:
+                break
+            dec.feed(chunk)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
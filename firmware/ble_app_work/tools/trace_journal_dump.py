@@ -0,0 +1,183 @@
+# trace_journal_dump.py
+"""Dump the Trace Journal (lib_trace_log.c) from a flash image.
+
+Read the journal pages with e.g.
+    nrfjprog --readcode flash.hex
+and run
+    python3 trace_journal_dump.py flash.hex
+
+A raw binary that starts at the journal address (TRACE_JOURNAL_ADDR) can be
+given with --bin. Trace / error place names are taken from lib_common.h.
+"""
+import argparse
+import re
+import struct
+import sys
+from dataclasses import dataclass
+from pathlib import Path
+
+# definition.h / lib_trace_log.h
+TRACE_JOURNAL_ADDR = 0x4A000
+TRACE_JOURNAL_PAGE_NUM = 2
+TRACE_JOURNAL_PAGE_SIZE = 0x1000
+TRACE_JOURNAL_MAGIC = 0x314A5254
+HEADER_SIZE = 16
+ENTRY_SIZE = 8
+
+TR_OTHER_ERROR_HEADER = 0xE000
+
+DEFAULT_HEADER = Path(__file__).resolve().parent.parent / "library" / "inc" / "lib_common.h"
+
+
+@dataclass
+class Entry:
+    seq: int
+    func_no: int
+    param: int
+    nested: int
+    valid: bool
+
+
+@dataclass
+class Page:
+    index: int
+    page_seq: int
+    first_seq: int
+    entries: list
+
+
+def parse_enum(text: str, name: str) -> dict:
+    """Return {value: identifier} for `typedef enum {...} name;`."""
+    m = re.search(r"typedef\s+enum\s*\{([^{}]*)\}\s*" + name + r"\s*;", text)
+    if not m:
+        return {}
+    body = re.sub(r"/\*.*?\*/|//[^\n]*", "", m.group(1), flags=re.S)
+    names = {}
+    value = -1
+    for item in body.split(","):
+        item = item.strip()
+        if not item:
+            continue
+        if "=" in item:
+            ident, expr = (s.strip() for s in item.split("=", 1))
+            value = int(expr, 0)
+        else:
+            ident = item
+            value += 1
+        names.setdefault(value, ident)
+    return names
+
+
+def load_intel_hex(path: Path) -> dict:
+    """Return {address: byte} from an Intel HEX file."""
+    mem = {}
+    base = 0
+    for line in path.read_text().splitlines():
+        line = line.strip()
+        if not line.startswith(":"):
+            continue
+        raw = bytes.fromhex(line[1:])
+        count, addr, rtype = raw[0], (raw[1] << 8) | raw[2], raw[3]
+        data = raw[4:4 + count]
+        if rtype == 0x00:
+            for i, b in enumerate(data):
+                mem[base + addr + i] = b
+        elif rtype == 0x02:
+            base = ((data[0] << 8) | data[1]) << 4
+        elif rtype == 0x04:
+            base = ((data[0] << 8) | data[1]) << 16
+        elif rtype == 0x01:
+            break
+    return mem
+
+
+def read_region(args) -> bytes:
+    size = TRACE_JOURNAL_PAGE_SIZE * args.pages
+    if args.bin:
+        data = Path(args.image).read_bytes()[:size]
+        return data.ljust(size, b"\xff")
+    mem = load_intel_hex(Path(args.image))
+    return bytes(mem.get(args.addr + i, 0xFF) for i in range(size))
+
+
+def entry_check(raw: bytes) -> int:
+    check = 0
+    for b in raw[:7]:
+        check ^= b
+    return ~check & 0xFF
+
+
+def parse_page(index: int, raw: bytes):
+    magic, page_seq, first_seq, check = struct.unpack_from("<IIII", raw, 0)
+    if magic != TRACE_JOURNAL_MAGIC or check != (~(magic ^ page_seq ^ first_seq) & 0xFFFFFFFF):
+        return None
+    entries = []
+    for off in range(HEADER_SIZE, len(raw) - ENTRY_SIZE + 1, ENTRY_SIZE):
+        chunk = raw[off:off + ENTRY_SIZE]
+        if chunk == b"\xff" * ENTRY_SIZE:
+            break
+        seq, func_no, param, nested, check = struct.unpack("<HHHBB", chunk)
+        entries.append(Entry(seq, func_no, param, nested, check == entry_check(chunk)))
+    return Page(index, page_seq, first_seq, entries)
+
+
+def describe(func_no: int, trace_names: dict, place_names: dict) -> str:
+    if func_no in trace_names:
+        return trace_names[func_no]
+    if func_no & 0xF000 == TR_OTHER_ERROR_HEADER:
+        place = func_no & 0xFF
+        return f"ERROR {place_names.get(place, f'0x{place:02X}')}"
+    return f"0x{func_no:04X}"
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description="Dump the flash Trace Journal")
+    ap.add_argument("image", help="Intel HEX flash dump (or raw binary with --bin)")
+    ap.add_argument("--bin", action="store_true", help="image is a raw binary starting at --addr")
+    ap.add_argument("--addr", type=lambda s: int(s, 0), default=TRACE_JOURNAL_ADDR)
+    ap.add_argument("--pages", type=int, default=TRACE_JOURNAL_PAGE_NUM)
+    ap.add_argument("--header", type=Path, default=DEFAULT_HEADER, help="lib_common.h for ID names")
+    ap.add_argument("--raw", action="store_true", help="print IDs as hex only")
+    args = ap.parse_args()
+
+    trace_names, place_names = {}, {}
+    if not args.raw and args.header.exists():
+        text = args.header.read_text(encoding="utf-8", errors="replace")
+        trace_names = parse_enum(text, "TRACE_LOG_ID")
+        place_names = parse_enum(text, "ERR_PLACE")
+
+    region = read_region(args)
+    pages = []
+    for i in range(args.pages):
+        page = parse_page(i, region[i * TRACE_JOURNAL_PAGE_SIZE:(i + 1) * TRACE_JOURNAL_PAGE_SIZE])
+        if page is not None:
+            pages.append(page)
+    if not pages:
+        print("no trace journal found", file=sys.stderr)
+        return 1
+
+    # oldest page first (page_seq is a wrapping 32-bit counter)
+    newest = max(pages, key=lambda p: p.page_seq)
+    pages.sort(key=lambda p: (newest.page_seq - p.page_seq) & 0xFFFFFFFF, reverse=True)
+
+    total = 0
+    for page in pages:
+        print(f"# page {page.index} page_seq {page.page_seq} first_seq {page.first_seq} entries {len(page.entries)}")
+        for slot, e in enumerate(page.entries):
+            seq = page.first_seq + slot
+            flags = []
+            if not e.valid:
+                flags.append("TORN")
+            elif e.seq != seq & 0xFFFF:
+                flags.append(f"SEQ?{e.seq}")
+            if e.nested:
+                flags.append("NESTED")
+            name = f"0x{e.func_no:04X}" if args.raw else describe(e.func_no, trace_names, place_names)
+            print(f"{seq:8d}  {name:<40s} param 0x{e.param:04X} ({e.param:5d})  {' '.join(flags)}".rstrip())
+            total += 1
+    print(f"# {total} entries")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,69 @@
+# adv_schema.py
+"""
+badge 廣播 manufacturer data 的解碼（firmware/ble_app_work/tools/adv_payload_gen.py 產生，不要手改）。
+
+company_id 之後的 payload → Adv；舊版（v0，沒有版本 byte）以長度判斷，轉成目前的欄位。
+seq 相同的廣播是重複（badge 只在內容變化時 +1）。
+
+    adv = adv_schema.decode(advertisement_data.manufacturer_data.get(adv_schema.COMPANY_ID, b""))
+"""
+import struct
+from typing import NamedTuple
+
+COMPANY_ID = 0xFFFF
+APP_ID = 0x3412
+VERSION = 1
+
+EVENT_ERROR = 0         # error
+EVENT_BOOT = 1          # boot
+EVENT_HEARTBEAT = 2     # heartbeat
+EVENT_BUTTON = 3        # button
+EVENT_POSTURE = 4       # posture change
+EVENT_ALARM = 5         # fall/tilt alarm (sent in the alarm burst; POSTURE without FALLEN clears it)
+EVENT_NAMES = {0: 'ERROR', 1: 'BOOT', 2: 'HEARTBEAT', 3: 'BUTTON', 4: 'POSTURE', 5: 'ALARM'}
+
+FLAG_FALLEN = 0x01      # tilted or fallen (tilt detector)
+FLAG_NAMES = {0x01: 'FALLEN'}
+
+
+class Adv(NamedTuple):
+    app_id: int             # APP_ID
+    ver: int                # payload version
+    device_id: int          # FICR based id
+    seq: int                # +1 for every new payload; a repeat of the same seq is a duplicate
+    event: int              # EVENT_*
+    flags: int              # FLAG_*
+    x: int                  # acc [-2 g, 2 g]
+    y: int                  # acc [-2 g, 2 g]
+    z: int                  # acc [-2 g, 2 g]
+    bat: int                # battery [0 V, 4.2 V]
+
+
+V1 = struct.Struct('<HBHBBBbbbB')       # 12 bytes
+V0 = struct.Struct('<HHBbbbBBBBB')      # 13 bytes: app_id, device_id, event, x, y, z, bat, one, two, three, four
+
+
+def decode(data: bytes) -> Adv | None:
+    """company_id 之後的 payload → Adv；不是 badge（或長度不對）則 None"""
+    n = len(data)
+    if n == V0.size:
+        return _decode_v0(data)
+    if n < V1.size:
+        return None
+    ver = data[2]
+    # 較新的版本只在後面加欄位（v1 的部分照樣讀）
+    if not ((ver == VERSION and n == V1.size) or (ver > VERSION and n > V1.size)):
+        return None
+    adv = Adv._make(V1.unpack_from(data))
+    return adv if adv.app_id == APP_ID else None
+
+
+def _decode_v0(data: bytes) -> Adv | None:
+    app_id, device_id, counter, x, y, z, bat, one, _, _, _ = V0.unpack(data)
+    if app_id != APP_ID:
+        return None
+    return Adv(app_id, 0, device_id, counter, EVENT_POSTURE, FLAG_FALLEN if one == 1 else 0, x, y, z, bat)
+
+
+def flag_names(flags: int) -> list[str]:
+    return [name for bit, name in FLAG_NAMES.items() if flags & bit]
@@ -0,0 +1,220 @@
+# alarms.py
+"""
+跌倒 / 傾倒警報的快速路徑（badge 的 EVENT_ALARM）。
+
+一般的裝置更新經過 ChangeFeed（每個 client 最多每 PUSH_INTERVAL 秒，且等 ack 之後才送下一個 delta），
+警報不等這些:
+- report()：apply_report() 收到新資料（重複的 seq 以外）時在 event loop 上同步呼叫，
+  也就是 Bleak 的 callback / serial 的 read 之內。同一台已經有 open 的警報時只增加 repeat
+  （多個 gateway 都收到、FALL 之後的 TILT）
+- 訂閱者（/ws/alarms 的 client）各有一個 queue，警報直接放進去，送出的 task 馬上被喚醒
+- hooks（sink、webhook）同步呼叫，不可阻塞
+- client 顯示後回 {"seen": id}，操作員確認回 {"ack": id}（或 POST /api/alarms/{id}/ack）。
+  ack 之前警報一直是 open，重新連線的 client 先收到所有 open 的警報
+- badge 站起來（FLAG_FALLEN 清除）只標記 cleared，仍然需要 ack
+
+各 hop 的時間（hops，epoch 秒）:
+  gateway  gateway 送出 UART 的時間（gw_ms 換算，見 serial_ingest.GatewayClock；Bleak 直接收到時為 None）
+  rx       host 收到（apply_report）
+  push     第一個 client 的 send 完成
+  seen     第一個 client 回報已顯示（server 收到的時間）
+  ack      操作員確認
+badge → gateway（無線）這段 badge 沒有同步的時鐘，用 fleet_sim.py 量測。
+
+Frame（JSON text）:
+  server → {"type":"alarms","now":t,"alarms":[...]}        連線時：open 與最近確認的警報
+           {"type":"alarm","now":t,"alarm":{...}}          新的警報與狀態變化（repeat / cleared / acked）
+  client → {"seen": id} / {"ack": id, "by": "..."}
+"""
+import asyncio
+import json
+import sys
+import time
+from collections import OrderedDict, deque
+
+import adv_schema
+
+KEEP_ACKED = 256            # 保留的已確認警報數（/api/alarms 與重新連線時送出）
+LATENCY_SAMPLES = 4096      # 各 hop 保留最近幾筆算百分位
+CLIENT_QUEUE_MAX = 256      # 送不出去的 frame 超過這個數就斷線（重新連線時收到所有 open 的警報）
+
+# (起點, 終點)：latency_ms 的 key 為 "起點_終點"
+HOPS = (("gateway", "rx"), ("rx", "push"), ("push", "seen"), ("rx", "seen"), ("rx", "ack"))
+
+
+class AlarmDesk:
+    def __init__(self, devices: dict):
+        self.devices = devices
+        self.alarms = OrderedDict()           # id -> alarm（wire 格式的 dict），依 id 遞增
+        self.hooks = []                       # hook(event: dict)，在 event loop 上呼叫，不可阻塞
+        self._open = {}                       # address -> id（ack 之前）
+        self._acked = deque()                 # 已確認的 id，超過 KEEP_ACKED 就從 alarms 移除
+        self._next_id = 1
+        self._clients = set()                 # asyncio.Queue：(id, text) 或 None（斷線）
+        self._latency = {"%s_%s" % hop: deque(maxlen=LATENCY_SAMPLES) for hop in HOPS}
+        self.stats = {"raised": 0, "repeat": 0, "cleared": 0, "acked": 0, "client_overflow": 0}
+
+    def report(self, d, t_gw: float | None = None):
+        """apply_report() 的新資料（DeviceState 已更新）"""
+        if d.event == adv_schema.EVENT_ALARM:
+            self._raise(d, t_gw)
+        elif d.address in self._open and not d.flags & adv_schema.FLAG_FALLEN:
+            self._clear(d)
+
+    def _raise(self, d, t_gw: float | None):
+        now = time.time()
+        aid = self._open.get(d.address)
+        if aid is not None:
+            a = self.alarms[aid]
+            a["seq"] = d.seq
+            a["via"] = d.via
+            a["repeat"] += 1
+            a["cleared"] = False
+            self.stats["repeat"] += 1
+            self._push(a, now)
+            return
+        aid = self._next_id
+        self._next_id += 1
+        a = {"id": aid, "address": d.address, "name": d.name, "device_id": d.device_id, "seq": d.seq,
+             "via": d.via, "state": "open", "cleared": False, "repeat": 0, "by": None,
+             "hops": {"gateway": t_gw, "rx": now, "push": None, "seen": None, "ack": None}}
+        self.alarms[aid] = a
+        self._open[d.address] = aid
+        self.stats["raised"] += 1
+        if t_gw is not None:
+            self._latency["gateway_rx"].append(now - t_gw)
+        self._push(a, now)
+        self._emit("alarm", a, now)
+
+    def _clear(self, d):
+        a = self.alarms[self._open[d.address]]
+        if a["cleared"]:
+            return
+        now = time.time()
+        a["cleared"] = True
+        self.stats["cleared"] += 1
+        self._push(a, now)
+        self._emit("alarm_clear", a, now)
+
+    def pushed(self, aid: int):
+        """client 的 send 完成（serve_client 呼叫）"""
+        a = self.alarms.get(aid)
+        if a is not None and a["hops"]["push"] is None:
+            hops = a["hops"]
+            hops["push"] = time.time()
+            self._latency["rx_push"].append(hops["push"] - hops["rx"])
+
+    def seen(self, aid: int):
+        """client 已顯示"""
+        a = self.alarms.get(aid)
+        if a is not None and a["hops"]["seen"] is None:
+            hops = a["hops"]
+            hops["seen"] = time.time()
+            if hops["push"] is not None:
+                self._latency["push_seen"].append(hops["seen"] - hops["push"])
+            self._latency["rx_seen"].append(hops["seen"] - hops["rx"])
+
+    def ack(self, aid: int, by: str | None = None) -> dict | None:
+        """操作員確認；不存在的 id 回傳 None（已確認的照原樣回傳）"""
+        a = self.alarms.get(aid)
+        if a is None or a["state"] != "open":
+            return a
+        now = time.time()
+        a["state"] = "acked"
+        a["by"] = by
+        a["hops"]["ack"] = now
+        self._latency["rx_ack"].append(now - a["hops"]["rx"])
+        if self._open.get(a["address"]) == aid:
+            del self._open[a["address"]]
+        self._acked.append(aid)
+        while len(self._acked) > KEEP_ACKED:
+            self.alarms.pop(self._acked.popleft(), None)
+        self.stats["acked"] += 1
+        self._push(a, now)
+        self._emit("alarm_ack", a, now)
+        return a
+
+    def subscribe(self) -> asyncio.Queue:
+        queue = asyncio.Queue()
+        self._clients.add(queue)
+        return queue
+
+    def unsubscribe(self, queue: asyncio.Queue):
+        self._clients.discard(queue)
+
+    def _push(self, a: dict, now: float):
+        if not self._clients:
+            return
+        text = json.dumps({"type": "alarm", "now": round(now, 3), "alarm": a}, separators=(",", ":"))
+        for queue in list(self._clients):
+            if queue.qsize() >= CLIENT_QUEUE_MAX:
+                # 收不完的 client：斷線，重新連線時從 snapshot 開始
+                self.stats["client_overflow"] += 1
+                self._clients.discard(queue)
+                queue.put_nowait(None)
+                continue
+            queue.put_nowait((a["id"], text))
+
+    def _emit(self, kind: str, a: dict, now: float):
+        event = {"type": kind, "t": round(now, 3), "event": adv_schema.EVENT_ALARM, **a}
+        for hook in self.hooks:
+            try:
+                hook(event)
+            except Exception as e:
+                print("alarm hook: %r" % e, file=sys.stderr)
+
+    def snapshot_text(self) -> str:
+        return json.dumps({"type": "alarms", "now": round(time.time(), 3), "alarms": list(self.alarms.values())},
+                          separators=(",", ":"))
+
+    def status(self) -> dict:
+        latency = {}
+        for key, samples in self._latency.items():
+            if samples:
+                v = sorted(samples)
+                latency[key] = {"n": len(v), "p50": round(v[len(v) // 2] * 1000, 1),
+                                "p99": round(v[min(len(v) - 1, int(len(v) * 0.99))] * 1000, 1),
+                                "max": round(v[-1] * 1000, 1)}
+        return {"open": len(self._open), "clients": len(self._clients), **self.stats, "latency_ms": latency}
+
+
+async def _receive(ws, desk: AlarmDesk, who: str | None, queue: asyncio.Queue):
+    try:
+        while True:
+            try:
+                msg = json.loads(await ws.receive_text())
+                if "seen" in msg:
+                    desk.seen(int(msg["seen"]))
+                if "ack" in msg:
+                    desk.ack(int(msg["ack"]), msg.get("by") or who)
+            except (ValueError, TypeError, AttributeError):
+                continue
+    except Exception:
+        # client disconnected
+        pass
+    finally:
+        # 斷線：送出的迴圈也結束
+        queue.put_nowait(None)
+
+
+async def serve_client(ws, desk: AlarmDesk, who: str | None = None):
+    """
+    一個 /ws/alarms client。ws 只需要 send_text()/receive_text()（app.py、headless.py 與 fleet_sim.py 的假 client 共用）。
+    who：ack 沒有帶 by 時記錄的名稱（client 的位址）。
+    """
+    queue = desk.subscribe()
+    reader = None
+    try:
+        await ws.send_text(desk.snapshot_text())
+        reader = asyncio.create_task(_receive(ws, desk, who, queue))
+        while True:
+            item = await queue.get()
+            if item is None:
+                return
+            aid, text = item
+            await ws.send_text(text)
+            desk.pushed(aid)
+    finally:
+        desk.unsubscribe(queue)
+        if reader is not None:
+            reader.cancel()
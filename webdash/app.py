@@ -1,20 +1,79 @@
 # app.py
 import asyncio
-from fastapi import FastAPI, WebSocket
+import json
+import os
+import urllib.request
+from fastapi import FastAPI, HTTPException, Query, WebSocket
 from fastapi.responses import FileResponse
 from fastapi.staticfiles import StaticFiles
 
-from ble_scanner import scan_forever, snapshot
+from alarms import serve_client as serve_alarms
+from ble_scanner import alarms, feed, history, presence, scan_forever, sinks, snapshot
+from change_feed import serve_client
+import serial_ingest
+from sinks import CsvSink, NdjsonSink, UnixSocketSink, WebSocketSink
+
+# gateway 的 serial port（逗號分隔，例如 "COM5,COM7" 或 "/dev/ttyACM0"）；空白則不接
+SERIAL_PORTS = [p for p in os.environ.get("WEBDASH_SERIAL", "").split(",") if p]
+# 0: 不用本機 Bleak 掃描（只靠 gateway）
+BLE_SCAN = os.environ.get("WEBDASH_BLE", "1") != "0"
+# 歷史資料的 SQLite 檔；空字串則只保留 RAM 內的 ring buffer
+HISTORY_DB = os.environ.get("WEBDASH_HISTORY_DB", "history.db")
+# online/offline 與警報事件的通知先（JSON POST）；空白則只印出
+ALERT_URL = os.environ.get("WEBDASH_ALERT_URL", "")
+# 事件另外輸出的 NDJSON 檔 / CSV 目錄 / Unix socket；空白則不輸出（headless.py 同樣的 sink）
+NDJSON_PATH = os.environ.get("WEBDASH_NDJSON", "")
+CSV_DIR = os.environ.get("WEBDASH_CSV_DIR", "")
+UNIX_SOCKET = os.environ.get("WEBDASH_UNIX_SOCKET", "")
 
 app = FastAPI(title="IOT BLE Web Dashboard")
 
+def _post_alert(event: dict):
+    req = urllib.request.Request(ALERT_URL, data=json.dumps(event).encode("utf-8"),
+                                 headers={"Content-Type": "application/json"})
+    try:
+        urllib.request.urlopen(req, timeout=5).close()
+    except OSError as e:
+        print("alert %s: %s" % (ALERT_URL, e))
+
+def _alert(event: dict):
+    # presence / alarms 的 hook（event loop 上）：HTTP 丟到 thread，不阻塞判定
+    if event["type"] == "online":
+        return
+    print("%s %s %s" % (event["type"], event["name"], event["address"]))
+    if ALERT_URL:
+        asyncio.get_running_loop().run_in_executor(None, _post_alert, event)
+
+presence.hooks.append(_alert)
+alarms.hooks.append(_alert)
+
+# 解碼後的事件 stream（/ws/events）
+events_sink = sinks.add(WebSocketSink())
+if NDJSON_PATH:
+    sinks.add(NdjsonSink(NDJSON_PATH))
+if CSV_DIR:
+    sinks.add(CsvSink(CSV_DIR))
+if UNIX_SOCKET:
+    sinks.add(UnixSocketSink(UNIX_SOCKET))
+
 # 靜態網頁
 app.mount("/static", StaticFiles(directory="static"), name="static")
 
 @app.on_event("startup")
 async def _startup():
     # 背景啟動 BLE 掃描
-    asyncio.create_task(scan_forever())
+    if BLE_SCAN:
+        asyncio.create_task(scan_forever())
+    # gateway UART 上傳，合併進同一張 devices
+    if SERIAL_PORTS:
+        asyncio.create_task(serial_ingest.ingest_forever(SERIAL_PORTS))
+    # offline 判定（期限到的 TICK 內）
+    asyncio.create_task(presence.run())
+    # 歷史資料的批次寫入
+    if HISTORY_DB:
+        asyncio.create_task(history.run(HISTORY_DB))
+    # 事件的 sink（各自的 queue 與寫出 task）
+    asyncio.create_task(sinks.run())
 
 @app.get("/")
 def index():
@@ -24,14 +83,72 @@ def index():
 async def api_devices():
     return await snapshot()
 
+@app.get("/api/devices/{key}/history")
+async def api_history(key: str, from_: float | None = Query(None, alias="from"), to: float | None = None,
+                      step: float = 0):
+    # key: address 或 device_id；from/to 為 epoch 秒（預設最近 10 分鐘），step 秒（0: 每一筆）
+    address = history.resolve(key)
+    if address is None:
+        raise HTTPException(status_code=404, detail="unknown device")
+    return await history.query(address, from_, to, step)
+
+@app.get("/api/history/stats")
+def api_history_stats():
+    return history.stats
+
+@app.get("/api/presence/stats")
+def api_presence_stats():
+    return presence.stats
+
+@app.get("/api/alarms")
+def api_alarms():
+    return list(alarms.alarms.values())
+
+@app.get("/api/alarms/stats")
+def api_alarms_stats():
+    return alarms.status()
+
+@app.post("/api/alarms/{alarm_id}/ack")
+def api_alarm_ack(alarm_id: int, by: str | None = None):
+    a = alarms.ack(alarm_id, by)
+    if a is None:
+        raise HTTPException(status_code=404, detail="unknown alarm")
+    return a
+
+@app.get("/api/gateways")
+def api_gateways():
+    return [g.status() for g in serial_ingest.gateways]
+
+@app.get("/api/sinks")
+def api_sinks():
+    return sinks.status()
+
 @app.websocket("/ws")
-async def ws_devices(ws: WebSocket):
+async def ws_devices(ws: WebSocket, since: int = 0, epoch: int = 0):
+    # 先送 snapshot（或同一個 epoch 內從 since 接續的 delta），之後只送變更的裝置
+    await ws.accept()
+    try:
+        await serve_client(ws, feed, since, epoch)
+    except Exception:
+        # client disconnected
+        pass
+
+@app.websocket("/ws/alarms")
+async def ws_alarms(ws: WebSocket):
+    # 警報：連線時送 open 的警報，之後每個警報馬上送出（不等 /ws 的推送間隔與 ack）
+    await ws.accept()
+    try:
+        await serve_alarms(ws, alarms, ws.client.host if ws.client else None)
+    except Exception:
+        # client disconnected
+        pass
+
+@app.websocket("/ws/events")
+async def ws_events(ws: WebSocket):
+    # 解碼後的每筆事件（report / online / offline / evicted），一個 frame 為一批 NDJSON
     await ws.accept()
     try:
-        while True:
-            data = await snapshot()
-            await ws.send_json(data)
-            await asyncio.sleep(0.25)
+        await events_sink.serve(ws)
     except Exception:
         # client disconnected
         pass
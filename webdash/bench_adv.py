@@ -0,0 +1,140 @@
+# bench_adv.py
+"""
+廣播處理速度的 benchmark（不需要 BLE 裝置與 bleak）。
+
+假的 BLEDevice / AdvertisementData 以 loop.call_soon() 逐一投入 detection callback（與 Bleak 相同，
+一個廣播一個 callback），量測處理完 N 筆所需的時間 = 單一 core 可持續的最大 reports/s。
+apply_report() 內的 feed / presence / history（RAM）也包含在內。
+
+  legacy: 舊版 callback（名稱前綴檢查、index 解析、每個廣播 create_task + lock）
+  sync:   ble_scanner.on_advertisement（struct 解析、在 callback 內直接更新）
+
+    python bench_adv.py
+    python bench_adv.py --devices 2000 --reports 500000
+"""
+import argparse
+import asyncio
+import random
+import sys
+import time
+from types import SimpleNamespace
+
+import adv_schema
+import ble_scanner
+
+CHUNK = 1000              # 一次排進 loop 的 callback 數
+
+
+def make_reports(n_devices: int, rng: random.Random):
+    reports = []
+    for i in range(n_devices):
+        payload = adv_schema.V1.pack(adv_schema.APP_ID, adv_schema.VERSION, 0x0100 + i, rng.randrange(256),
+                                     adv_schema.EVENT_POSTURE, rng.randrange(2),
+                                     rng.randint(-64, 64), rng.randint(-64, 64), rng.randint(-64, 64), 200)
+        device = SimpleNamespace(address="C0:00:00:00:%02X:%02X" % (i >> 8, i & 0xFF), name="BLE Badge %04d" % i)
+        adv = SimpleNamespace(manufacturer_data={ble_scanner.MANUFACTURER_ID: payload}, local_name=device.name,
+                              rssi=rng.randint(-90, -40))
+        reports.append((device, adv))
+    # 其他廠商的廣播（過濾掉的比例）
+    for i in range(n_devices // 4):
+        device = SimpleNamespace(address="D0:00:00:00:%02X:%02X" % (i >> 8, i & 0xFF), name=None)
+        adv = SimpleNamespace(manufacturer_data={0x004C: b"\x02\x15" + bytes(21)}, local_name=None, rssi=-80)
+        reports.append((device, adv))
+    rng.shuffle(reports)
+    return reports
+
+
+def legacy_parse(md):
+    # 舊版 parse_manufacturer_data（4-byte device_id 等，僅比較處理成本）
+    if ble_scanner.MANUFACTURER_ID not in md:
+        return None
+    data = md[ble_scanner.MANUFACTURER_ID]
+    if len(data) < 8:
+        return None
+    app_id = data[0] | (data[1] << 8)
+    if app_id != ble_scanner.APP_ID:
+        return None
+    device_id = int.from_bytes(data[2:6], "little")
+    return device_id, data[6], data[7], data[3]
+
+
+def make_legacy_callback():
+    lock = asyncio.Lock()
+
+    def detection_callback(device, advertisement_data):
+        if not device.name:
+            return
+        if not device.name.startswith(ble_scanner.NAME_PREFIX):
+            return
+        parsed = legacy_parse(advertisement_data.manufacturer_data)
+        if parsed is None:
+            return
+        device_id, event, posture, flags = parsed
+        rssi = advertisement_data.rssi
+
+        async def update():
+            async with lock:
+                ble_scanner.apply_report(device.address, device.name, device_id, event, posture, rssi, flags)
+
+        asyncio.get_running_loop().create_task(update())
+
+    return detection_callback
+
+
+def bench_parse(reports, n: int):
+    out = {}
+    for name, fn in (("legacy", legacy_parse), ("sync", ble_scanner.parse_manufacturer_data)):
+        t0 = time.perf_counter()
+        for i in range(n):
+            fn(reports[i % len(reports)][1].manufacturer_data)
+        out[name] = n / (time.perf_counter() - t0)
+    return out
+
+
+async def saturate(callback, reports, n: int) -> float:
+    """n 筆廣播以 call_soon 投入，等到 apply_report 全部處理完"""
+    loop = asyncio.get_running_loop()
+    t0 = time.perf_counter()
+    for base in range(0, n, CHUNK):
+        for i in range(base, min(base + CHUNK, n)):
+            loop.call_soon(callback, *reports[i % len(reports)])
+        await asyncio.sleep(0)
+    # call_soon 依序執行：done 之前投入的 callback 都已跑完，剩下 legacy 建立的 Task
+    # （重複的 seq 不寫 history，不能再用 history 的筆數判斷）
+    done = loop.create_future()
+    loop.call_soon(done.set_result, None)
+    await done
+    pending = asyncio.all_tasks() - {asyncio.current_task()}
+    if pending:
+        await asyncio.gather(*pending)
+    return n / (time.perf_counter() - t0)
+
+
+async def bench_callback(reports, n: int):
+    out = {}
+    for name in ("legacy", "sync"):
+        callback = make_legacy_callback() if name == "legacy" else ble_scanner.on_advertisement
+        await saturate(callback, reports, min(n, 10000))         # 暖機（裝置建立）
+        out[name] = await saturate(callback, reports, n)
+    return out
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--devices", type=int, default=500, help="badge 數 (default 500)")
+    parser.add_argument("--reports", type=int, default=200000, help="投入的廣播數 (default 200000)")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    reports = make_reports(args.devices, random.Random(args.seed))
+    parse = bench_parse(reports, args.reports)
+    callback = asyncio.run(bench_callback(reports, args.reports))
+    print("devices=%d reports=%d (%.0f%% badge)" % (args.devices, args.reports, 100.0 * args.devices / len(reports)))
+    print("parse     legacy=%9.0f/s  sync=%9.0f/s" % (parse["legacy"], parse["sync"]))
+    print("callback  legacy=%9.0f/s  sync=%9.0f/s  (max sustainable reports/s, one core)"
+          % (callback["legacy"], callback["sync"]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,74 +1,91 @@
 # ble_scanner.py
 import asyncio
-from bleak import BleakScanner
+
+import adv_schema
+from alarms import AlarmDesk
+from change_feed import ChangeFeed
+from history import HistoryStore
 from model import DeviceState
+from presence import PresenceTracker
+from sinks import SinkPipeline
 
 # ====== 依你的協定調整 ======
-MANUFACTURER_ID = 0xFFFF
-APP_ID = 0x3412          # <- 改成你的 2-byte APP_ID
+MANUFACTURER_ID = adv_schema.COMPANY_ID
+APP_ID = adv_schema.APP_ID   # payload 格式在 adv_schema.py（firmware/ble_app_work/tools/adv_payload_gen.py 產生）
 NAME_PREFIX = "BLE Badge"  # <- 裝置名稱前綴
 # ===========================
 
 # 全域裝置表（被 Web 讀取）
 devices: dict[str, DeviceState] = {}
-_devices_lock = asyncio.Lock()
 
-def parse_manufacturer_data(md: dict[int, bytes]):
-    """
-    Manufacturer Data 格式（你目前設計）:
-    [0] APP_ID_L
-    [1] APP_ID_H
-    [2] DEVICE_ID
-    [3] DEVICE_ID
-    [4] DEVICE_ID
-    [5] DEVICE_ID
-    [6] Event
-    [7] Posture
-    [9] FLAGS (可選)
-    """
-    if MANUFACTURER_ID not in md:
-        return None
+# 裝置表的變更記錄（WebSocket 只推送變更的裝置）
+feed = ChangeFeed(devices)
 
-    data = md[MANUFACTURER_ID]
-    if len(data) < 8:
-        return None
+# 每台裝置的歷史（RAM ring + SQLite，寫入由 app.py 啟動的 history.run() 批次處理）
+history = HistoryStore()
 
-    app_id = data[0] | (data[1] << 8)  # little-endian
-    if app_id != APP_ID:
-        return None
+# Online/Offline 的判定與離線裝置的移除（app.py 啟動 presence.run()）
+presence = PresenceTracker(devices, feed, history)
 
-    device_id = int.from_bytes(data[2:6], "little")       
+# 解碼後的事件給其他系統（NDJSON / CSV / Unix socket / WebSocket，sink 由 app.py / headless.py 加入）
+sinks = SinkPipeline()
+presence.hooks.append(sinks.publish)
 
-    event = data[6]
-    posture = data[7]
-    
-    flags = data[3] if len(data) >= 4 else 0
-    return device_id, event, posture, flags
+# 警報的快速路徑：不經過 feed 的推送間隔，直接送給 /ws/alarms 的 client 與 sink
+alarms = AlarmDesk(devices)
+alarms.hooks.append(sinks.publish)
 
-async def scan_forever():
-    def detection_callback(device, advertisement_data):
-        if not device.name:
-            return
-        if not device.name.startswith(NAME_PREFIX):
-            return
+# 同一個 seq 的重複廣播：last_seen / rssi / presence 每次更新，feed 與 history 每台最多每秒一次
+DUPLICATE_PUSH_INTERVAL = 1.0
 
-        parsed = parse_manufacturer_data(advertisement_data.manufacturer_data)
-        if parsed is None:
-            return
+def parse_manufacturer_data(md: dict[int, bytes]) -> adv_schema.Adv | None:
+    """Bleak 的 manufacturer_data（company_id → payload）→ Adv；不是 badge 則 None"""
+    data = md.get(MANUFACTURER_ID)
+    if data is None:
+        return None
+    return adv_schema.decode(data)
 
-        device_id, event, posture, flags = parsed
-        rssi = advertisement_data.rssi  # ✅ Windows/WinRT 正確來源
+def apply_report(address: str, name: str, device_id: int, event: int, posture: int, rssi: int, flags: int,
+                 via: str = "ble", seq: int | None = None, t_gw: float | None = None):
+    """
+    更新 devices 並記錄到 feed（在 event loop 上呼叫；Bleak 與 serial_ingest 共用）。
+    t_gw：gateway 送出的時間（epoch 秒，serial 才有），警報的 hop 延遲用
+    """
+    d = devices.get(address)
+    if d is None:
+        d = devices[address] = DeviceState(address=address, name=name, device_id=device_id)
+    duplicate = seq is not None and seq == d.seq
+    d.touch(event=event, posture=posture, rssi=rssi, flags=flags, via=via, seq=seq)
+    if not duplicate:
+        # 警報在 feed / history / sink 之前
+        alarms.report(d, t_gw)
+    presence.touch(address)
+    if duplicate and d.last_seen - d.pushed < DUPLICATE_PUSH_INTERVAL:
+        return
+    d.pushed = d.last_seen
+    feed.mark(address)
+    history.record(address, d.device_id, d.last_seen, event, posture, rssi, flags)
+    if sinks.listening():
+        sinks.publish({"type": "report", **d.to_wire()})
 
-        async def update():
-            async with _devices_lock:
-                if device.address not in devices:
-                    devices[device.address] = DeviceState(address=device.address, name=device.name, device_id=device_id)
-                devices[device.address].touch(event=event,posture = posture, rssi=rssi, flags=flags)
+def on_advertisement(device, advertisement_data):
+    """
+    Bleak 的 detection callback。Bleak 在 event loop 上呼叫，所以直接同步更新 devices
+    （不為每個廣播建立 Task，也不需要 lock）。先用 manufacturer data 過濾，名稱只用來顯示。
+    """
+    adv = parse_manufacturer_data(advertisement_data.manufacturer_data)
+    if adv is None:
+        return
+    name = device.name or advertisement_data.local_name or "%s %04X" % (NAME_PREFIX, adv.device_id)
+    apply_report(device.address, name, adv.device_id, adv.event, adv.flags & adv_schema.FLAG_FALLEN,
+                 advertisement_data.rssi,  # ✅ Windows/WinRT 正確來源
+                 adv.flags, seq=adv.seq)
 
-        # callback 不能 await，丟回 event loop
-        asyncio.get_running_loop().create_task(update())
+async def scan_forever():
+    # bleak 只在實際掃描時才需要（loadtest_ws.py 等工具不需安裝）
+    from bleak import BleakScanner
 
-    scanner = BleakScanner(detection_callback)
+    scanner = BleakScanner(on_advertisement)
     await scanner.start()
     try:
         while True:
@@ -77,7 +94,5 @@ async def scan_forever():
         await scanner.stop()
 
 async def snapshot():
-    async with _devices_lock:
-        # 依 name/address 穩定排序
-        arr = sorted((d.to_dict() for d in devices.values()), key=lambda x: (x["name"], x["address"]))
-    return arr
+    # 依 name/address 穩定排序
+    return sorted((d.to_dict() for d in devices.values()), key=lambda x: (x["name"], x["address"]))
@@ -0,0 +1,156 @@
+# change_feed.py
+import asyncio
+import json
+import re
+import time
+from collections import OrderedDict, deque
+
+from model import OFFLINE_TIMEOUT
+
+TOMBSTONE_MAX = 4096     # 保留的刪除記錄數，超過時較舊版本的 client 改收 snapshot
+EVENT_LOG_MAX = 1024     # 保留的事件數（同上）
+FRAME_CACHE_TTL = 1.0    # 同一版本的 frame 最多共用幾秒（frame 內的 now 用來校正 client 時鐘）
+PUSH_INTERVAL = 0.25     # 每個 client 最多每 0.25 秒推一次，期間的變更合併成一個 delta
+
+_ACK_RE = re.compile(r'"ack"\s*:\s*(\d+)')
+
+
+class ChangeFeed:
+    """
+    裝置表的版本化變更記錄（只在 event loop 上使用，不需要 lock）。
+
+    - 每次 touch 全域序號 seq +1，並記下該裝置最後一次變更的序號
+    - client 先收 snapshot，之後只收「自己 ack 的版本」之後變更/刪除的裝置
+    - 同一個起點版本的 frame 只序列化一次，所有同版本的 client 共用同一個字串
+
+    Frame（JSON text）:
+      {"type":"snapshot","epoch":e,"v":seq,"now":t,"timeout":15.0,"devices":[...]}
+      {"type":"delta","from":since,"v":seq,"now":t,"changed":[...],"removed":[address...],"events":[...]}
+    events 為 presence.py 的狀態轉換（online / offline / evicted），依發生順序。
+    client 回 {"ack": v} 後才會收到下一個 frame，慢的 client 自然收到合併後的 delta。
+    epoch 在 server 每次啟動時不同，重新連線時 epoch 不符就從 snapshot 開始。
+    """
+
+    def __init__(self, devices: dict):
+        self.devices = devices
+        self.epoch = int(time.time() * 1000)
+        self.seq = 0
+        self.floor = 0                    # since < floor 的 delta 不完整（記錄已丟棄）
+        self._log = OrderedDict()         # address -> (seq, removed)，依 seq 遞增
+        self._tombstones = 0
+        self._events = deque()            # (seq, event)，依 seq 遞增
+        self._frames = {}                 # since -> text，只對 _frames_seq 有效
+        self._frames_seq = -1
+        self._frames_time = 0.0
+        self._event = asyncio.Event()
+        self.stats = {"frames_built": 0, "snapshots_built": 0}
+
+    def mark(self, address: str):
+        """裝置新增或內容變更（scanner 的 touch 之後呼叫）"""
+        self.seq += 1
+        old = self._log.pop(address, None)
+        if old is not None and old[1]:
+            self._tombstones -= 1
+        self._log[address] = (self.seq, False)
+        self._event.set()
+
+    def remove(self, address: str):
+        """裝置從 devices 移除後呼叫"""
+        self.seq += 1
+        old = self._log.pop(address, None)
+        if old is None or not old[1]:
+            self._tombstones += 1
+        self._log[address] = (self.seq, True)
+        while self._tombstones > TOMBSTONE_MAX:
+            _, (seq, removed) = self._log.popitem(last=False)
+            self.floor = seq
+            if removed:
+                self._tombstones -= 1
+        self._event.set()
+
+    def event(self, event: dict):
+        """狀態轉換等事件，只放進 delta（snapshot 已包含目前的狀態）"""
+        self.seq += 1
+        self._events.append((self.seq, event))
+        if len(self._events) > EVENT_LOG_MAX:
+            seq, _ = self._events.popleft()
+            self.floor = max(self.floor, seq)
+        self._event.set()
+
+    async def wait(self, version: int):
+        """等到 seq 超過 version"""
+        while self.seq <= version:
+            event = self._event
+            if event.is_set():
+                # 舊的通知（version 之前的變更），換一個新的 Event 再等
+                event = self._event = asyncio.Event()
+            await event.wait()
+
+    def frame(self, since: int):
+        """
+        回傳 (text, version)：since 之後的 delta，since 無法補齊時回傳 snapshot。
+        """
+        now = time.time()
+        if self._frames_seq != self.seq or now - self._frames_time > FRAME_CACHE_TTL:
+            self._frames.clear()
+            self._frames_seq = self.seq
+            self._frames_time = now
+        text = self._frames.get(since)
+        if text is None:
+            if since <= 0 or since < self.floor or since > self.seq:
+                text = self._snapshot_text(now)
+            else:
+                text = self._delta_text(since, now)
+            self._frames[since] = text
+        return text, self.seq
+
+    def _snapshot_text(self, now: float) -> str:
+        # 依 name/address 穩定排序（與 /api/devices 相同）
+        arr = sorted((d.to_wire() for d in self.devices.values()), key=lambda x: (x["name"], x["address"]))
+        self.stats["snapshots_built"] += 1
+        return json.dumps({"type": "snapshot", "epoch": self.epoch, "v": self.seq, "now": round(now, 3),
+                           "timeout": OFFLINE_TIMEOUT, "devices": arr}, separators=(",", ":"))
+
+    def _delta_text(self, since: int, now: float) -> str:
+        changed = []
+        removed = []
+        # _log 依 seq 遞增，從尾端往回掃到 since 為止：成本只和變更數成正比
+        for address, (seq, gone) in reversed(self._log.items()):
+            if seq <= since:
+                break
+            if gone:
+                removed.append(address)
+            else:
+                changed.append(self.devices[address].to_wire())
+        events = []
+        for seq, event in reversed(self._events):
+            if seq <= since:
+                break
+            events.append(event)
+        events.reverse()
+        self.stats["frames_built"] += 1
+        return json.dumps({"type": "delta", "from": since, "v": self.seq, "now": round(now, 3),
+                           "changed": changed, "removed": removed, "events": events}, separators=(",", ":"))
+
+
+def parse_ack(text: str, current: int) -> int:
+    """client 的 {"ack": v}；格式不對就維持目前版本"""
+    m = _ACK_RE.search(text)
+    return int(m.group(1)) if m else current
+
+
+async def serve_client(ws, feed: ChangeFeed, since: int = 0, epoch: int = 0):
+    """
+    一個 WebSocket client 的推送迴圈。ws 只需要 send_text()/receive_text()，
+    app.py 的 FastAPI WebSocket 與 loadtest_ws.py 的假 client 共用這段。
+    """
+    version = since if epoch == feed.epoch else 0
+    sent = -1
+    while True:
+        if sent >= 0:
+            await feed.wait(version)
+        text, sent = feed.frame(version)
+        await ws.send_text(text)
+        # ack 之前不送下一個 frame；回報的版本決定下一個 delta 的起點
+        version = min(parse_ack(await ws.receive_text(), version), sent)
+        await asyncio.sleep(PUSH_INTERVAL)
@@ -0,0 +1,172 @@
+# fake_gateway.py
+"""
+pty 上的假 nRF gateway（serial_ingest.py 的測試用，POSIX 限定）。
+
+bleadv_packet_output() 格式的記錄寫進 pty master，slave 端的路徑給 serial_ingest.py / app.py 開。
+預設不限速（遠超過 115200 baud），用來測 ingest 的極限；--baud 可模擬實際 UART 速度。
+
+    python fake_gateway.py --ports 2 --devices 500 --rate 20000
+    python fake_gateway.py --replay capture.bin --rate 0            # 重播 serial_ingest.py --capture 錄下的 stream
+    python fake_gateway.py --corrupt 0.01 --seconds 10              # 1% 的記錄破損（截斷/雜訊/缺結尾）
+    python fake_gateway.py --write stream.bin --count 100000        # 不開 pty，只產生 stream 檔
+
+另一個終端機:
+    python serial_ingest.py /dev/pts/5 /dev/pts/6 --seconds 10
+"""
+import argparse
+import os
+import random
+import select
+import sys
+import threading
+import time
+import tty
+
+import adv_schema
+
+UPLOAD_TIME = "2026-01-22T10:30"      # bleadv_packet_output() 目前固定的字串
+CHUNK_RECORDS = 64                    # 一次 write 的記錄數
+
+
+def make_record(rng: random.Random, index: int, device: int, seq: int = 0, flags: int = 0, gw_ms: int = 0) -> bytes:
+    addr = "E4:C6:C6:%02X:%02X:%02X" % ((device >> 16) & 0xFF, (device >> 8) & 0xFF, device & 0xFF)
+    return ("$$$index=%d&x=%d&y=%d&z=%d&gx=0&gy=0&gz=0&bt_addr=%s&user_id=%04x&upload_time=%s&battery=%d&rssi=%d"
+            "&seq=%d&flags=%d&ver=1&gw_ms=%d###"
+            % (index, rng.randint(-120, 120), rng.randint(-120, 120), rng.randint(-120, 120),
+               addr, 0x1000 + device, UPLOAD_TIME, rng.randint(330, 420), rng.randint(-95, -40),
+               seq, flags, gw_ms)).encode("ascii")
+
+
+def corrupt(rng: random.Random, record: bytes) -> bytes:
+    kind = rng.randrange(3)
+    if kind == 0:
+        return record[:rng.randrange(3, len(record) - 3)]                 # 結尾遺失
+    if kind == 1:
+        return bytes(rng.randrange(256) for _ in range(rng.randrange(1, 40))) + record   # 前面有雜訊
+    i = rng.randrange(3, len(record) - 3)
+    return record[:i] + b"\xff" + record[i + 1:]                          # 位元錯誤
+
+
+def generate(rng: random.Random, devices: int, corrupt_p: float):
+    """(bytes, 未破損的記錄數) 的無限序列"""
+    seq = [0] * devices
+    t0 = time.monotonic()
+    while True:
+        chunk = []
+        good = 0
+        gw_ms = int((time.monotonic() - t0) * 1000)
+        for _ in range(CHUNK_RECORDS):
+            device = rng.randrange(devices)
+            # gateway 已經丟掉重複的 seq，所以每筆都是新的 seq（姿勢變化；倒下的是警報）
+            seq[device] = (seq[device] + 1) & 0xFF
+            flags = rng.choice((0, 0, 0, adv_schema.FLAG_FALLEN))
+            event = adv_schema.EVENT_ALARM if flags else adv_schema.EVENT_POSTURE
+            record = make_record(rng, event, device, seq[device], flags, gw_ms)
+            if corrupt_p and rng.random() < corrupt_p:
+                record = corrupt(rng, record)
+            else:
+                good += 1
+            chunk.append(record)
+        yield b"".join(chunk), good
+
+
+def replay(path: str):
+    with open(path, "rb") as f:
+        data = f.read()
+    count = data.count(b"###")
+    while True:
+        for i in range(0, len(data), 8192):
+            part = data[i:i + 8192]
+            yield part, part.count(b"###") if count else 0
+
+
+class Port(threading.Thread):
+    def __init__(self, source, rate: float, baud: int):
+        super().__init__(daemon=True)
+        self.master, slave = os.openpty()
+        tty.setraw(slave)            # 不做 echo / 換行處理
+        os.set_blocking(self.master, False)
+        self.path = os.ttyname(slave)
+        self.slave = slave           # 保持開著，reader 重開時 master 端不會收到 EIO
+        self.source = source
+        self.rate = rate
+        self.baud = baud
+        self.deadline = 0.0
+        self.sent = 0
+        self.bytes = 0
+
+    def run(self):
+        t0 = time.perf_counter()
+        for data, good in self.source:
+            now = time.perf_counter()
+            if now >= self.deadline:
+                break
+            # 記錄數或 baud 的速度限制（任一）
+            wait = 0.0
+            if self.rate > 0:
+                wait = max(wait, (self.sent + good) / self.rate - (now - t0))
+            if self.baud > 0:
+                wait = max(wait, (self.bytes + len(data)) * 10 / self.baud - (now - t0))
+            if wait > 0:
+                time.sleep(wait)
+            view = memoryview(data)
+            while view:
+                # reader 沒在讀時 pty 會塞滿，等到 deadline 為止
+                if not select.select([], [self.master], [], max(self.deadline - time.perf_counter(), 0))[1]:
+                    return
+                try:
+                    view = view[os.write(self.master, view):]
+                except BlockingIOError:
+                    pass
+            self.sent += good
+            self.bytes += len(data)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--ports", type=int, default=1, help="假 gateway 數 (default 1)")
+    parser.add_argument("--devices", type=int, default=200, help="每個 gateway 聽到的 badge 數 (default 200)")
+    parser.add_argument("--rate", type=float, default=5000, help="每個 gateway 每秒的記錄數，0 為不限 (default 5000)")
+    parser.add_argument("--baud", type=int, default=0, help="模擬 UART 速度（例如 115200），0 為不限")
+    parser.add_argument("--corrupt", type=float, default=0.0, help="破損記錄的比例 (default 0)")
+    parser.add_argument("--seconds", type=float, default=30.0, help="執行秒數 (default 30)")
+    parser.add_argument("--replay", help="重播錄下的 stream 檔（取代產生的記錄）")
+    parser.add_argument("--write", help="不開 pty，把產生的 stream 寫進檔案")
+    parser.add_argument("--count", type=int, default=10000, help="--write 的記錄數 (default 10000)")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    if args.write:
+        gen = generate(random.Random(args.seed), args.devices, args.corrupt)
+        written = 0
+        with open(args.write, "wb") as f:
+            while written < args.count:
+                data, _ = next(gen)
+                f.write(data)
+                written += CHUNK_RECORDS
+        print("wrote %d records to %s" % (written, args.write))
+        return 0
+
+    ports = []
+    for i in range(args.ports):
+        source = replay(args.replay) if args.replay else generate(random.Random(args.seed + i), args.devices, args.corrupt)
+        ports.append(Port(source, args.rate, args.baud))
+    print(" ".join(p.path for p in ports), flush=True)
+    # reader 開好 port 之前先等一下（pty 的 buffer 不大，未讀的資料會讓 write 阻塞）
+    time.sleep(1.0)
+    deadline = time.perf_counter() + args.seconds
+    for p in ports:
+        p.deadline = deadline
+        p.start()
+    try:
+        for p in ports:
+            p.join()
+    except KeyboardInterrupt:
+        pass
+    for p in ports:
+        print("%s intact=%d bytes=%d" % (p.path, p.sent, p.bytes), flush=True)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,700 @@
+# fleet_sim.py
+"""
+沒有無線電的 badge fleet 模擬（容量測試用，不需要 bleak / pyserial）。
+
+數千台虛擬 badge 產生實際的廣播：開機（BOOT）、heartbeat、跌倒警報（ALARM + FALLEN，1 秒的 alarm burst，
+一段時間後 POSTURE 站起來）、
+電池慢慢下降、RSSI 的慢變化與 fading、收不到的封包（--loss 與靈敏度以下）、重複收到的封包（--dup）。
+payload 與 badge firmware 相同（adv_schema.V1），每台 --adv-interval 秒廣播一次，內容不變時 seq 也不變。
+
+三種輸出（--mode）:
+  ble   與 Bleak 相同的 detection callback：直接呼叫 ble_scanner.on_advertisement（同一個 process）
+  uart  gateway 的 UART stream（bleadv_packet_output 的格式）寫進 pty。gateway 的 seq_tracker（16 台）與
+        uarte_pusher（512 bytes 與警報的插隊，--baud）也模擬。預設同一個 process 讀 pty 送進 serial_ingest；
+        --external 只印出 pty 路徑（給 app.py / headless.py 開），用 --events 接 headless.py --unix 的 socket 量測
+  raw   bleadv_packet_t（firmware/ble_app_gateway/host 的 gateway_host 的輸入）。--write 寫成檔案；
+        沒有 --write 時每個 gateway 啟動一個 gateway_host，stdout 的 UART stream 送進 serial_ingest
+
+每個新的 (device_id, seq) 從第一次廣播的時間開始計時，各 stage 的 loss:
+  radio      至少一個 copy 被 gateway（ble: 本機）收到
+  gateway    uart: seq_tracker / UART overflow 之後送出（raw: gateway_host 的 SUMMARY）
+  dashboard  apply_report() 之後推給 WebSocket（feed.mark；--events 時為 sink 收到）與延遲的百分位
+警報另外量測送到 /ws/alarms client 的時間（alarms.serve_client 的假 client；--events 時為 sink 的 alarm 事件）。
+
+    python fleet_sim.py --mode ble --devices 5000 --seconds 30
+    python fleet_sim.py --mode uart --gateways 4 --devices 400 --baud 115200
+    python fleet_sim.py --mode uart --external --events /tmp/badge-events.sock      # + headless.py --unix ...
+    python fleet_sim.py --mode raw --devices 200 --seconds 60 --write fleet.bin    # gateway_host fleet.bin
+    python fleet_sim.py --mode ble --devices 1000,2000,5000,10000 --seconds 20     # 逐一執行，找出上限
+"""
+import argparse
+import asyncio
+import heapq
+import json
+import math
+import os
+import random
+import resource
+import struct
+import subprocess
+import sys
+import time
+import tty
+from types import SimpleNamespace
+
+import adv_schema
+
+SENSITIVITY_DBM = -95             # 這以下收不到
+ADV_DELAY_MAX = 0.010             # BLE 的 advDelay（0–10 ms 的亂數）
+TICK = 0.005                      # 產生/送出的間隔 [s]
+DEVICE_NAME = "B51"               # ble_app_work/main.c 的 DEVICE_NAME
+ADDR_TYPE_RANDOM_STATIC = 1
+UPLOAD_TIME = "2026-01-22T10:30"  # bleadv_packet_output() 目前固定的字串
+SEQ_TRACK_MAX_DEVICES = 16        # ble_app_gateway/seq_tracker.c
+SEQ_TRACK_KEEPALIVE_MS = 5000
+UARTE_PUSHER_BUF_SIZE = 512 + 192  # ble_app_gateway/uarte_pusher.c（512 + UARTE_PUSHER_ALARM_MAX）
+UARTE_PUSHER_ALARM_MAX = 192      # ble_app_gateway/uarte_pusher.h（警報的位置，ring 也保留這麼多）
+ALARM_BURST_INTERVAL = 0.020      # ble_app_work/ble_adv_scheduler.h
+ALARM_BURST_DURATION = 1.0
+GATEWAY_HOST = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                            "..", "firmware", "ble_app_gateway", "host", "_build", "gateway_host")
+
+# gateway_host 的輸入：uint32 t_ms + bleadv_packet_t（rssi, addr[6], addr_type, data_len, data[31]）
+RAW_RECORD = struct.Struct("<Ib6sBB31s")
+
+UPRIGHT = (0, 0, 64)              # 約 1 g（[-2 g, 2 g] → int8）
+LYING = (64, 0, 0)
+
+
+def imu_centi(v: int) -> int:
+    # bleadv_manufacturer.c manu_imu_to_float() × 100
+    return int((-2.0 + (v + 128) / 255.0 * 4.0) * 100)
+
+
+def bat_centi(v: int) -> int:
+    # manu_bat_to_float() × 100
+    return int(v / 255.0 * 4.2 * 100)
+
+
+class Badge:
+    __slots__ = ("device_id", "address", "addr_raw", "seq", "event", "flags", "xyz", "bat", "next_hb", "stand_at",
+                 "burst_until", "slow", "rssi_mean", "gateways", "device", "md", "line_head", "line_tail", "raw_data")
+
+    def __init__(self, index: int, rng: random.Random, gateways: list[int]):
+        self.device_id = 0x1000 + index
+        self.addr_raw = bytes((index & 0xFF, (index >> 8) & 0xFF, 0x01, 0xA4, 0x3F, 0xC2))   # LSB first
+        self.address = ":".join("%02X" % b for b in reversed(self.addr_raw))
+        self.seq = -1             # 開機前
+        self.event = adv_schema.EVENT_BOOT
+        self.flags = 0
+        self.xyz = UPRIGHT
+        self.bat = rng.randint(170, 215)
+        self.next_hb = 0.0
+        self.stand_at = 0.0       # 跌倒中：站起來的時間
+        self.burst_until = 0.0    # alarm burst（ALARM_BURST_INTERVAL）的結束時間
+        self.slow = 0.0           # RSSI 的慢變化（人的移動）
+        self.gateways = gateways
+        self.rssi_mean = [rng.uniform(-88, -50) for _ in gateways]
+        self.device = SimpleNamespace(address=self.address, name=DEVICE_NAME)
+
+    def encode(self):
+        """payload 變更時：三種輸出各自的格式先做好"""
+        x, y, z = self.xyz
+        payload = adv_schema.V1.pack(adv_schema.APP_ID, adv_schema.VERSION, self.device_id, self.seq, self.event,
+                                     self.flags, x, y, z, self.bat)
+        self.md = {adv_schema.COMPANY_ID: payload}
+        self.line_head = ("$$$index=%d&x=%d&y=%d&z=%d&gx=0&gy=0&gz=0&bt_addr=%s&user_id=%04x&upload_time=%s"
+                          "&battery=%d&rssi=" % (self.event, imu_centi(x), imu_centi(y), imu_centi(z), self.address,
+                                                 self.device_id, UPLOAD_TIME, bat_centi(self.bat))).encode("ascii")
+        self.line_tail = ("&seq=%u&flags=%u&ver=%u&gw_ms=" % (self.seq, self.flags, adv_schema.VERSION)).encode("ascii")
+        name = DEVICE_NAME.encode("ascii")
+        mfg = struct.pack("<H", adv_schema.COMPANY_ID) + payload
+        self.raw_data = (bytes((2, 0x01, 0x06)) + bytes((len(name) + 1, 0x09)) + name
+                         + bytes((len(mfg) + 1, 0xFF)) + mfg)
+
+
+class Tracker:
+    """新的 (device_id, seq) 各 stage 有沒有到、到達的延遲"""
+
+    ALARM = 1
+
+    def __init__(self):
+        self.pending = {}         # key -> [t_wall, kind, 第一次收到的 t_wall, gateway, latency, 警報的 push latency]
+        self.done = {"generated": [0, 0], "radio": [0, 0], "gateway": [0, 0], "dashboard": [0, 0]}
+        self.latency = ([], [])   # kind 別：從第一次送出
+        self.pipeline = []        # 從第一次被收到（radio 以外的延遲）
+        self.alarm_push = []      # 警報：從第一次送出到 /ws/alarms client 收到
+
+    def new(self, key: int, t_wall: float, kind: int):
+        old = self.pending.pop(key, None)
+        if old is not None:
+            self._finish(old)
+        self.pending[key] = [t_wall, kind, None, False, None, None]
+
+    def radio(self, key: int, t_wall: float):
+        e = self.pending.get(key)
+        if e is not None and e[2] is None:
+            e[2] = t_wall
+
+    def gateway(self, key: int):
+        e = self.pending.get(key)
+        if e is not None:
+            e[3] = True
+
+    def seen(self, key: int, now: float):
+        e = self.pending.get(key)
+        if e is not None and e[4] is None:
+            e[4] = now - e[0]
+
+    def pushed(self, key: int, now: float):
+        e = self.pending.get(key)
+        if e is not None and e[5] is None:
+            e[5] = now - e[0]
+
+    def _finish(self, e):
+        kind = e[1]
+        done = self.done
+        done["generated"][kind] += 1
+        done["radio"][kind] += e[2] is not None
+        done["gateway"][kind] += e[3]
+        if e[4] is not None:
+            done["dashboard"][kind] += 1
+            self.latency[kind].append(e[4])
+            self.pipeline.append(e[4] - (e[2] - e[0]))
+        if e[5] is not None:
+            self.alarm_push.append(e[5])
+
+    def finish(self):
+        for e in self.pending.values():
+            self._finish(e)
+        self.pending.clear()
+
+
+class Fleet:
+    def __init__(self, args, rng: random.Random, tracker: Tracker, wall0: float):
+        self.rng = rng
+        self.args = args
+        self.tracker = tracker
+        self.wall0 = wall0
+        self.p_alarm = args.alarm_rate / 3600.0 * args.adv_interval
+        self.badges = []
+        self.heap = []
+        n_gw = max(args.gateways, 1)
+        for i in range(args.devices):
+            gws = [i % n_gw]
+            if n_gw > 1 and rng.random() < args.overlap:
+                gws.append((i + 1) % n_gw)
+            b = Badge(i, rng, gws)
+            self.badges.append(b)
+            self.heap.append((rng.uniform(0, args.boot_spread), i))
+        heapq.heapify(self.heap)
+        self.stats = {"adv": 0, "copies": 0, "lost": 0, "dup": 0, "boot": 0, "heartbeat": 0, "alarm": 0, "stand": 0}
+
+    def _update(self, b: Badge, t: float):
+        rng = self.rng
+        args = self.args
+        kind = 0
+        if b.seq < 0:
+            event = adv_schema.EVENT_BOOT
+            self.stats["boot"] += 1
+        elif b.stand_at and t >= b.stand_at:
+            b.flags &= ~adv_schema.FLAG_FALLEN
+            b.stand_at = 0.0
+            b.xyz = UPRIGHT
+            event = adv_schema.EVENT_POSTURE
+            self.stats["stand"] += 1
+        elif not b.stand_at and rng.random() < self.p_alarm:
+            b.flags |= adv_schema.FLAG_FALLEN
+            b.stand_at = t + rng.expovariate(1.0 / args.fall_duration)
+            b.xyz = LYING
+            b.burst_until = t + ALARM_BURST_DURATION
+            event = adv_schema.EVENT_ALARM
+            kind = Tracker.ALARM
+            self.stats["alarm"] += 1
+        elif t >= b.next_hb:
+            event = adv_schema.EVENT_HEARTBEAT
+            if rng.random() < args.battery_drift:
+                b.bat = max(b.bat - 1, 0)
+            self.stats["heartbeat"] += 1
+        else:
+            return
+        b.next_hb = t + args.heartbeat
+        b.seq = (b.seq + 1) & 0xFF
+        b.event = event
+        b.encode()
+        self.tracker.new((b.device_id << 8) | b.seq, self.wall0 + t / args.speed, kind)
+
+    def run_until(self, t_end: float, emit):
+        """t_end 為止的廣播（virtual time）：emit(gateway, badge, rssi, t)"""
+        heap = self.heap
+        rng = self.rng
+        args = self.args
+        stats = self.stats
+        tracker = self.tracker
+        gauss = rng.gauss
+        random_ = rng.random
+        while heap and heap[0][0] <= t_end:
+            t, i = heapq.heappop(heap)
+            b = self.badges[i]
+            self._update(b, t)
+            stats["adv"] += 1
+            b.slow = 0.98 * b.slow + gauss(0.0, 1.0)
+            key = (b.device_id << 8) | b.seq
+            for k, gw in enumerate(b.gateways):
+                stats["copies"] += 1
+                rssi = int(b.rssi_mean[k] + b.slow + gauss(0.0, args.fade))
+                if rssi < SENSITIVITY_DBM or random_() < args.loss:
+                    stats["lost"] += 1
+                    continue
+                tracker.radio(key, self.wall0 + t / args.speed)
+                emit(gw, b, rssi, t)
+                if random_() < args.dup:
+                    stats["dup"] += 1
+                    emit(gw, b, rssi, t)
+            interval = ALARM_BURST_INTERVAL if t < b.burst_until else args.adv_interval
+            heapq.heappush(heap, (t + interval + random_() * ADV_DELAY_MAX, i))
+
+
+class GatewayModel:
+    """ble_app_gateway main loop 的 seq_tracker 與 uarte_pusher（UART 的送出時間與警報的插隊也模擬）"""
+
+    def __init__(self, baud: int):
+        self.baud = baud
+        self.table = {}           # device_id -> [last_seq, last_ms, heard_ms]
+        self.busy_until = 0.0     # UART 送完目前 ring 內容的時間（virtual）
+        self.alarm_until = 0.0    # 警報的位置送完的時間
+        self.lines = []           # (送完的時間, bytes)，依時間順序
+        self.stats = {"in": 0, "duplicate": 0, "uart_drop": 0, "out": 0, "out_bytes": 0,
+                      "alarm_out": 0, "alarm_drop": 0}
+
+    def accept(self, device_id: int, seq: int, now_ms: int) -> bool:
+        table = self.table
+        e = table.get(device_id)
+        if e is not None:
+            e[2] = now_ms
+            if e[0] == seq and now_ms - e[1] < SEQ_TRACK_KEEPALIVE_MS:
+                return False
+            e[0] = seq
+            e[1] = now_ms
+            return True
+        if len(table) >= SEQ_TRACK_MAX_DEVICES:
+            del table[min(table, key=lambda k: table[k][2])]
+        table[device_id] = [seq, now_ms, now_ms]
+        return True
+
+    def receive(self, b: Badge, rssi: int, t: float) -> bool:
+        stats = self.stats
+        stats["in"] += 1
+        now_ms = int(t * 1000)
+        if not self.accept(b.device_id, b.seq, now_ms):
+            stats["duplicate"] += 1
+            return False
+        line = b.line_head + str(rssi).encode("ascii") + b.line_tail + b"%d###" % now_ms
+        alarm = b.event == adv_schema.EVENT_ALARM
+        if not self.baud:
+            self.lines.append((t, line))
+        elif alarm and self.alarm_until <= t and len(line) <= UARTE_PUSHER_ALARM_MAX:
+            self._insert_alarm(line, t)
+        else:
+            queued = max(self.busy_until - t, 0.0) * self.baud / 10
+            reserve = 0 if alarm else UARTE_PUSHER_ALARM_MAX
+            if len(line) + reserve > UARTE_PUSHER_BUF_SIZE - 1 - queued:
+                stats["uart_drop"] += 1
+                if alarm:
+                    # seq_tracker_forget()：burst 的下一個 copy 再送
+                    stats["alarm_drop"] += 1
+                    del self.table[b.device_id]
+                return False
+            self.busy_until = max(self.busy_until, t) + len(line) * 10 / self.baud
+            self.lines.append((self.busy_until, line))
+        if alarm:
+            stats["alarm_out"] += 1
+        stats["out"] += 1
+        stats["out_bytes"] += len(line)
+        return True
+
+    def _insert_alarm(self, line: bytes, t: float):
+        """送出中的那一行之後插隊，後面的行延後"""
+        lines = self.lines
+        i = 0
+        while i < len(lines) and lines[i][0] <= t:
+            i += 1
+        duration = len(line) * 10 / self.baud
+        if i < len(lines):
+            done = lines[i][0] + duration
+            i += 1
+            for k in range(i, len(lines)):
+                lines[k] = (lines[k][0] + duration, lines[k][1])
+        else:
+            done = t + duration
+        lines.insert(i, (done, line))
+        self.busy_until = max(self.busy_until, t) + duration
+        self.alarm_until = done
+
+    def take(self, t: float) -> bytes:
+        """t 之前 UART 已送完的行"""
+        lines = self.lines
+        n = 0
+        while n < len(lines) and lines[n][0] <= t:
+            n += 1
+        if not n:
+            return b""
+        out = b"".join(line for _, line in lines[:n])
+        del lines[:n]
+        return out
+
+
+def percentiles(values: list[float]) -> dict:
+    if not values:
+        return {}
+    v = sorted(values)
+    pick = lambda q: round(v[min(len(v) - 1, int(len(v) * q))] * 1000, 2)
+    return {"p50": pick(0.50), "p90": pick(0.90), "p99": pick(0.99), "max": round(v[-1] * 1000, 2)}
+
+
+class Pty:
+    def __init__(self):
+        self.master, self.slave = os.openpty()
+        tty.setraw(self.slave)    # 不做 echo / 換行處理
+        os.set_blocking(self.master, False)
+        self.path = os.ttyname(self.slave)
+        self.backlog = bytearray()
+        self.written = 0
+
+    def write(self, data: bytes):
+        self.backlog += data
+        if not self.backlog:
+            return
+        try:
+            n = os.write(self.master, self.backlog)
+        except BlockingIOError:
+            return
+        del self.backlog[:n]
+        self.written += n
+
+
+async def read_events(path: str, tracker: Tracker, counters: dict):
+    """headless.py --unix 的 stream（sink 收到 = dashboard stage）"""
+    reader, _ = await asyncio.open_unix_connection(path, limit=1 << 20)
+    while True:
+        line = await reader.readline()
+        if not line:
+            return
+        ev = json.loads(line)
+        counters["events"] += 1
+        if ev.get("seq") is None:
+            continue
+        if ev.get("type") == "report":
+            tracker.seen((ev["device_id"] << 8) | ev["seq"], time.perf_counter())
+        elif ev.get("type") == "alarm":
+            tracker.pushed((ev["device_id"] << 8) | ev["seq"], time.perf_counter())
+
+
+class AlarmClient:
+    """/ws/alarms 的假 client（alarms.serve_client 用）：收到新的警報就回 seen 並 ack（下一次跌倒是新的警報）"""
+
+    def __init__(self, tracker: Tracker):
+        self.tracker = tracker
+        self.replies = asyncio.Queue()
+
+    async def send_text(self, text: str):
+        msg = json.loads(text)
+        a = msg.get("alarm")
+        if a is not None and a["hops"]["seen"] is None and a["seq"] is not None:
+            self.tracker.pushed((a["device_id"] << 8) | a["seq"], time.perf_counter())
+            self.replies.put_nowait('{"seen":%d}' % a["id"])
+            self.replies.put_nowait('{"ack":%d,"by":"fleet_sim"}' % a["id"])
+
+    async def receive_text(self) -> str:
+        return await self.replies.get()
+
+
+async def run_live(args) -> dict:
+    import alarms
+    import ble_scanner
+    import serial_ingest
+
+    loop = asyncio.get_running_loop()
+    rng = random.Random(args.seed)
+    tracker = Tracker()
+    wall0 = time.perf_counter() + 0.5
+    fleet = Fleet(args, rng, tracker, wall0)
+    counters = {"events": 0}
+    tasks = []
+    ports = []
+    procs = []
+    pumps = []
+    buffers = []
+    models = []
+
+    if args.events:
+        tasks.append(asyncio.create_task(read_events(args.events, tracker, counters)))
+    else:
+        # 推給 WebSocket 之前（feed.mark）量測
+        devices = ble_scanner.devices
+        mark = ble_scanner.feed.mark
+
+        def probe(address):
+            d = devices[address]
+            if d.seq is not None:
+                tracker.seen((d.device_id << 8) | d.seq, time.perf_counter())
+            mark(address)
+
+        ble_scanner.feed.mark = probe
+        tasks.append(asyncio.create_task(alarms.serve_client(AlarmClient(tracker), ble_scanner.alarms)))
+    tasks.append(asyncio.create_task(ble_scanner.presence.run()))
+
+    if args.mode == "ble":
+        on_advertisement = ble_scanner.on_advertisement
+
+        def emit(gw, b, rssi, t):
+            on_advertisement(b.device, SimpleNamespace(manufacturer_data=b.md, local_name=DEVICE_NAME, rssi=rssi))
+    elif args.mode == "uart":
+        models = [GatewayModel(args.baud) for _ in range(args.gateways)]
+        for i in range(args.gateways):
+            p = Pty()
+            ports.append(p)
+            if not args.external:
+                framer = serial_ingest.GatewayFramer()
+                clock = serial_ingest.GatewayClock()
+
+                def on_readable(fd=p.slave, framer=framer, clock=clock, port=p.path):
+                    try:
+                        data = os.read(fd, 65536)
+                    except BlockingIOError:
+                        return
+                    serial_ingest.apply_records(framer.feed(data), port, clock)
+
+                os.set_blocking(p.slave, False)
+                loop.add_reader(p.slave, on_readable)
+        if args.external:
+            print(" ".join(p.path for p in ports), flush=True)
+
+        def emit(gw, b, rssi, t):
+            if models[gw].receive(b, rssi, t):
+                tracker.gateway((b.device_id << 8) | b.seq)
+    else:
+        if not os.path.exists(args.gateway_host):
+            raise SystemExit("%s not found (make -C firmware/ble_app_gateway/host)" % args.gateway_host)
+        buffers += [bytearray() for _ in range(args.gateways)]
+        for i in range(args.gateways):
+            proc = await asyncio.create_subprocess_exec(args.gateway_host, "-b", str(args.baud),
+                                                        stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                                                        stderr=subprocess.PIPE)
+            procs.append(proc)
+            framer = serial_ingest.GatewayFramer()
+            clock = serial_ingest.GatewayClock()
+
+            async def pump(proc=proc, framer=framer, clock=clock, port="gateway_host%d" % i):
+                while True:
+                    data = await proc.stdout.read(65536)
+                    if not data:
+                        return
+                    serial_ingest.apply_records(framer.feed(data), port, clock)
+
+            pumps.append(asyncio.create_task(pump()))
+
+        def emit(gw, b, rssi, t):
+            buffers[gw] += RAW_RECORD.pack(int(t * 1000), rssi, b.addr_raw, ADDR_TYPE_RANDOM_STATIC,
+                                           len(b.raw_data), b.raw_data)
+
+    usage0 = resource.getrusage(resource.RUSAGE_SELF)
+    behind = 0.0
+    await asyncio.sleep(max(wall0 - time.perf_counter(), 0))
+    end_v = args.seconds
+    drain_until = None
+    while True:
+        now = time.perf_counter()
+        t_v = (now - wall0) * args.speed
+        if t_v < end_v:
+            fleet.run_until(t_v, emit)
+            behind = max(behind, time.perf_counter() - now)
+        elif drain_until is None:
+            drain_until = now + args.drain
+        elif now >= drain_until:
+            break
+        for m, p in zip(models, ports):
+            p.write(m.take(t_v))
+        for proc, buf in zip(procs, buffers):
+            if buf:
+                proc.stdin.write(bytes(buf))
+                buf.clear()
+        await asyncio.sleep(TICK)
+    usage1 = resource.getrusage(resource.RUSAGE_SELF)
+    wall = time.perf_counter() - wall0
+
+    gateway_stats = [m.stats for m in models]
+    for proc, pump in zip(procs, pumps):
+        proc.stdin.close()
+        await pump
+        err = await proc.stderr.read()
+        await proc.wait()
+        summary = [l for l in err.decode(errors="replace").splitlines() if l.startswith("SUMMARY")]
+        if summary:
+            gateway_stats.append(dict(kv.split("=", 1) for kv in summary[0].split()[1:]))
+    for t in tasks:
+        t.cancel()
+
+    tracker.finish()
+    cpu = (usage1.ru_utime - usage0.ru_utime) + (usage1.ru_stime - usage0.ru_stime)
+    result = summarize(args, fleet, tracker, wall)
+    result["cpu_pct"] = round(100.0 * cpu / wall, 1)
+    result["tick_max_ms"] = round(behind * 1000, 2)
+    if gateway_stats:
+        result["gateway_stats"] = gateway_stats
+    if ports:
+        result["pty_backlog"] = sum(len(p.backlog) for p in ports)
+    if args.events:
+        result["events"] = counters["events"]
+    else:
+        result["alarm_hops_ms"] = ble_scanner.alarms.status()["latency_ms"]
+    return result
+
+
+def summarize(args, fleet: Fleet, tracker: Tracker, wall: float) -> dict:
+    done = tracker.done
+    gen = sum(done["generated"])
+
+    def loss(stage: str, base: str) -> float:
+        b = sum(done[base])
+        return round(100.0 * (b - sum(done[stage])) / b, 3) if b else 0.0
+
+    out = {"mode": args.mode, "devices": args.devices, "gateways": args.gateways, "seconds": args.seconds,
+           "adv_per_s": round(fleet.stats["adv"] / max(args.seconds, 1e-9), 1),
+           "new_seq": gen, "alarms": done["generated"][Tracker.ALARM], **fleet.stats,
+           "loss_pct": {"radio": loss("radio", "generated"),
+                        "dashboard": loss("dashboard", "radio"),
+                        "end_to_end": loss("dashboard", "generated")},
+           "latency_ms": percentiles(tracker.latency[0] + tracker.latency[1]),
+           "pipeline_ms": percentiles(tracker.pipeline),
+           "alarm_latency_ms": percentiles(tracker.latency[Tracker.ALARM]),
+           "alarm_push_ms": percentiles(tracker.alarm_push), "alarms_pushed": len(tracker.alarm_push)}
+    if args.mode != "ble":
+        out["loss_pct"]["gateway"] = loss("gateway", "radio") if args.mode == "uart" else None
+        if args.mode == "uart":
+            out["loss_pct"]["dashboard"] = loss("dashboard", "gateway")
+    return out
+
+
+def write_raw(args) -> dict:
+    rng = random.Random(args.seed)
+    tracker = Tracker()
+    fleet = Fleet(args, rng, tracker, 0.0)
+    base, ext = os.path.splitext(args.write)
+    paths = [args.write] if args.gateways == 1 else ["%s.%d%s" % (base, i, ext) for i in range(args.gateways)]
+    files = [open(p, "wb") for p in paths]
+    records = [0] * len(files)
+
+    def emit(gw, b, rssi, t):
+        files[gw].write(RAW_RECORD.pack(int(t * 1000), rssi, b.addr_raw, ADDR_TYPE_RANDOM_STATIC,
+                                        len(b.raw_data), b.raw_data))
+        records[gw] += 1
+
+    fleet.run_until(args.seconds, emit)
+    for f in files:
+        f.close()
+    tracker.finish()
+    return {"mode": "raw", "devices": args.devices, "seconds": args.seconds, "files": dict(zip(paths, records)),
+            "new_seq": sum(tracker.done["generated"]), **fleet.stats,
+            "radio_loss_pct": round(100.0 * (1 - sum(tracker.done["radio"]) / max(sum(tracker.done["generated"]), 1)), 3)}
+
+
+def print_result(r: dict):
+    if "files" in r:
+        for path, n in r["files"].items():
+            print("%s records=%d" % (path, n))
+        print("devices=%d seconds=%g adv=%d copies=%d lost=%d dup=%d new_seq=%d radio_loss=%.3f%%"
+              % (r["devices"], r["seconds"], r["adv"], r["copies"], r["lost"], r["dup"], r["new_seq"],
+                 r["radio_loss_pct"]))
+        return
+    print("mode=%s devices=%d gateways=%d seconds=%g adv/s=%.0f cpu=%.1f%% tick_max=%.1fms"
+          % (r["mode"], r["devices"], r["gateways"], r["seconds"], r["adv_per_s"], r["cpu_pct"], r["tick_max_ms"]))
+    print("traffic  copies=%d lost=%d dup=%d boot=%d heartbeat=%d alarm=%d stand=%d new_seq=%d"
+          % (r["copies"], r["lost"], r["dup"], r["boot"], r["heartbeat"], r["alarm"], r["stand"], r["new_seq"]))
+    print("loss     " + "  ".join("%s=%s%%" % (k, v) for k, v in r["loss_pct"].items() if v is not None))
+    print("latency  from first tx  %s" % (r["latency_ms"] or "-"))
+    print("         alarms         %s" % (r["alarm_latency_ms"] or "-"))
+    print("         alarm push     %s (%d of %d alarms)" % (r["alarm_push_ms"] or "-", r["alarms_pushed"], r["alarms"]))
+    for hop, v in r.get("alarm_hops_ms", {}).items():
+        print("         hop %-10s p50=%sms p99=%sms max=%sms n=%d" % (hop, v["p50"], v["p99"], v["max"], v["n"]))
+    print("         from first rx  %s" % (r["pipeline_ms"] or "-"))
+    for i, g in enumerate(r.get("gateway_stats", [])):
+        print("gateway%d %s" % (i, " ".join("%s=%s" % kv for kv in g.items())))
+    if r.get("pty_backlog"):
+        print("pty backlog %d bytes (nobody reading)" % r["pty_backlog"])
+
+
+def sweep(args, sizes: list[int]) -> int:
+    """每個 fleet size 各自一個 process（devices / feed 的狀態不延續）"""
+    argv = sys.argv[1:]
+    i = argv.index("--devices")
+    rows = []
+    for n in sizes:
+        argv[i + 1] = str(n)
+        out = subprocess.run([sys.executable, os.path.abspath(__file__), *argv, "--json"],
+                             capture_output=True, text=True, check=True).stdout
+        r = json.loads(out.strip().splitlines()[-1])
+        ok = r["loss_pct"]["end_to_end"] - r["loss_pct"]["radio"] <= args.max_loss and \
+            r["pipeline_ms"].get("p99", math.inf) <= args.max_p99
+        rows.append((n, r, ok))
+        print("devices=%6d adv/s=%8.0f cpu=%5.1f%% loss radio=%6.3f%% e2e=%6.3f%% rx->dashboard p50=%8sms p99=%8sms  %s"
+              % (n, r["adv_per_s"], r["cpu_pct"], r["loss_pct"]["radio"], r["loss_pct"]["end_to_end"],
+                 r["pipeline_ms"].get("p50", "-"), r["pipeline_ms"].get("p99", "-"), "ok" if ok else "OVER"),
+              flush=True)
+    passed = [n for n, _, ok in rows if ok]
+    print("ceiling: %s devices (loss beyond radio <= %g%%, p99 <= %g ms)"
+          % (max(passed) if passed else "<%d" % sizes[0], args.max_loss, args.max_p99))
+    return 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--mode", choices=("ble", "uart", "raw"), default="ble")
+    parser.add_argument("--devices", default="1000", help="badge 數；逗號分隔時逐一執行 (default 1000)")
+    parser.add_argument("--gateways", type=int, default=1, help="uart / raw 的 gateway 數 (default 1)")
+    parser.add_argument("--overlap", type=float, default=0.3, help="隔壁的 gateway 也聽得到的比例 (default 0.3)")
+    parser.add_argument("--seconds", type=float, default=30.0, help="模擬的秒數 (default 30)")
+    parser.add_argument("--speed", type=float, default=1.0, help="模擬時間 / 實際時間 (default 1)")
+    parser.add_argument("--adv-interval", type=float, default=1.0, help="廣播間隔 [s] (default 1)")
+    parser.add_argument("--heartbeat", type=float, default=10.0, help="heartbeat 間隔 [s] (default 10)")
+    parser.add_argument("--boot-spread", type=float, default=5.0, help="開機時間的分散 [s] (default 5)")
+    parser.add_argument("--alarm-rate", type=float, default=6.0, help="每台每小時的跌倒次數 (default 6)")
+    parser.add_argument("--fall-duration", type=float, default=20.0, help="跌倒的平均持續時間 [s] (default 20)")
+    parser.add_argument("--drain", type=float, default=2.0, help="停止後等待的秒數 (default 2)")
+    parser.add_argument("--battery-drift", type=float, default=0.05, help="每次 heartbeat 電池 -1 的機率 (default 0.05)")
+    parser.add_argument("--loss", type=float, default=0.05, help="封包遺失率（靈敏度以下另外） (default 0.05)")
+    parser.add_argument("--dup", type=float, default=0.02, help="同一個 copy 重複收到的比例 (default 0.02)")
+    parser.add_argument("--fade", type=float, default=4.0, help="RSSI fading 的標準差 [dB] (default 4)")
+    parser.add_argument("--baud", type=int, default=115200, help="gateway UART 的速度，0 為不限 (default 115200)")
+    parser.add_argument("--external", action="store_true", help="uart: 只開 pty，由 app.py / headless.py 讀")
+    parser.add_argument("--events", help="headless.py --unix 的 socket（dashboard stage 在這裡量測）")
+    parser.add_argument("--gateway-host", default=GATEWAY_HOST, help="raw: gateway_host 的路徑")
+    parser.add_argument("--write", help="raw: 寫成檔案（不即時執行）")
+    parser.add_argument("--max-loss", type=float, default=0.1, help="上限判定：radio 以外的 loss [%%] (default 0.1)")
+    parser.add_argument("--max-p99", type=float, default=500.0,
+                        help="上限判定：第一次收到 → dashboard 的 p99 [ms] (default 500)")
+    parser.add_argument("--json", action="store_true", help="結果以 JSON 一行輸出")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    sizes = [int(n) for n in args.devices.split(",") if n]
+    if len(sizes) > 1:
+        return sweep(args, sizes)
+    args.devices = sizes[0]
+    if args.devices > 0xEFFF:
+        parser.error("--devices: at most %d (device_id 0x1000-0xFFFF)" % 0xEFFF)
+    if args.mode == "raw" and args.write:
+        result = write_raw(args)
+    elif args.write:
+        parser.error("--write is for --mode raw")
+    else:
+        result = asyncio.run(run_live(args))
+    if args.json:
+        print(json.dumps(result))
+    else:
+        print_result(result)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
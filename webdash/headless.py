@@ -0,0 +1,148 @@
+# headless.py
+"""
+沒有網頁的 ingest 專用模式：Bleak 掃描與 gateway serial ingest 解碼後的事件只送進 sink（sinks.py）。
+
+一個場域跑一個 ingest process，其他系統從 NDJSON 檔 / CSV / Unix socket / WebSocket 接收。
+presence（online/offline/evicted）與警報（alarm / alarm_clear / alarm_ack）事件也會送出。每個 sink 有自己的 bounded queue，
+寫不出去的 sink 只會丟自己的事件（dropped），不會拖慢掃描。
+
+    python headless.py --serial /dev/ttyACM0 --no-ble --ndjson events.ndjson
+    python headless.py --csv csv --unix /tmp/badge-events.sock --stats 10
+    python headless.py --serial COM5,COM7 --ws 0.0.0.0:8001          # ws://host:8001/ws/events 與 /ws/alarms（需要 fastapi / uvicorn）
+
+Unix socket 的接收（一行一個 JSON）:
+    nc -U /tmp/badge-events.sock
+"""
+import argparse
+import asyncio
+import sys
+import time
+
+import ble_scanner
+import serial_ingest
+from alarms import serve_client as serve_alarms
+from sinks import CsvSink, NdjsonSink, UnixSocketSink, WebSocketSink
+
+
+async def serve_ws(host: str, port: int, sink: WebSocketSink):
+    # fastapi / uvicorn 只在指定 --ws 時需要
+    import uvicorn
+    from fastapi import FastAPI, WebSocket
+
+    app = FastAPI(title="BLE badge events")
+
+    @app.websocket("/ws/events")
+    async def ws_events(ws: WebSocket):
+        await ws.accept()
+        try:
+            await sink.serve(ws)
+        except Exception:
+            # client disconnected
+            pass
+
+    @app.websocket("/ws/alarms")
+    async def ws_alarms(ws: WebSocket):
+        await ws.accept()
+        try:
+            await serve_alarms(ws, ble_scanner.alarms, ws.client.host if ws.client else None)
+        except Exception:
+            # client disconnected
+            pass
+
+    @app.get("/api/sinks")
+    def api_sinks():
+        return ble_scanner.sinks.status()
+
+    @app.get("/api/alarms/stats")
+    def api_alarms_stats():
+        return ble_scanner.alarms.status()
+
+    server = uvicorn.Server(uvicorn.Config(app, host=host, port=port, log_level="warning"))
+    await server.serve()
+
+
+def print_stats(last: dict):
+    status = ble_scanner.sinks.status()
+    for s in status["sinks"]:
+        lat = s.get("latency_ms", {})
+        prev = last.get(s["name"], 0)
+        print("%-9s %-24s sent=%d (+%d) dropped=%d queued=%d p50=%sms p99=%sms"
+              % (s["kind"], s["name"], s["sent"], s["sent"] - prev, s["dropped"], s["queued"],
+                 lat.get("p50", "-"), lat.get("p99", "-")), flush=True)
+        last[s["name"]] = s["sent"]
+    for g in serial_ingest.gateways:
+        st = g.status()
+        print("gateway   %-24s records=%d bad=%d connected=%s" % (g.port, st["records"], st["bad"], st["connected"]),
+              flush=True)
+    a = ble_scanner.alarms.status()
+    if a["raised"]:
+        print("alarms    open=%d raised=%d acked=%d %s" % (a["open"], a["raised"], a["acked"],
+              " ".join("%s=%s/%sms" % (k, v["p50"], v["p99"]) for k, v in a["latency_ms"].items())), flush=True)
+
+
+async def _main(args) -> int:
+    pipeline = ble_scanner.sinks
+    if args.ndjson:
+        pipeline.add(NdjsonSink(args.ndjson, args.queue))
+    if args.csv:
+        pipeline.add(CsvSink(args.csv, roll_seconds=args.csv_roll, maxsize=args.queue))
+    if args.unix:
+        pipeline.add(UnixSocketSink(args.unix, args.queue))
+    ws_sink = pipeline.add(WebSocketSink("ws", args.queue)) if args.ws else None
+    if not pipeline.sinks:
+        print("no sink (--ndjson / --csv / --unix / --ws)", file=sys.stderr)
+        return 2
+
+    tasks = [asyncio.create_task(pipeline.run()), asyncio.create_task(ble_scanner.presence.run())]
+    if not args.no_ble:
+        tasks.append(asyncio.create_task(ble_scanner.scan_forever()))
+    ports = [p for p in args.serial.split(",") if p]
+    if ports:
+        tasks.append(asyncio.create_task(serial_ingest.ingest_forever(ports, args.baudrate)))
+    if args.history:
+        tasks.append(asyncio.create_task(ble_scanner.history.run(args.history)))
+    if ws_sink is not None:
+        host, _, port = args.ws.rpartition(":")
+        tasks.append(asyncio.create_task(serve_ws(host or "127.0.0.1", int(port), ws_sink)))
+
+    t0 = time.perf_counter()
+    last = {}
+    try:
+        while args.seconds <= 0 or time.perf_counter() - t0 < args.seconds:
+            await asyncio.sleep(args.stats if args.stats > 0 else 1.0)
+            for t in tasks:
+                if t.done() and t.exception() is not None:
+                    raise t.exception()
+            if args.stats > 0:
+                print_stats(last)
+    finally:
+        for t in tasks:
+            t.cancel()
+    if args.stats <= 0:
+        print_stats(last)
+    return 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--serial", default="", help="gateway 的 serial port（逗號分隔）")
+    parser.add_argument("--baudrate", type=int, default=serial_ingest.BAUDRATE)
+    parser.add_argument("--no-ble", action="store_true", help="不用本機 Bleak 掃描（只靠 gateway）")
+    parser.add_argument("--ndjson", help="事件 append 到這個 NDJSON 檔")
+    parser.add_argument("--csv", help="CSV 的目錄（每 --csv-roll 秒換檔）")
+    parser.add_argument("--csv-roll", type=float, default=3600.0, help="CSV 換檔的週期 [s] (default 3600)")
+    parser.add_argument("--unix", help="Unix socket 的路徑")
+    parser.add_argument("--ws", help="WebSocket 的 HOST:PORT（/ws/events）")
+    parser.add_argument("--queue", type=int, default=10000, help="每個 sink 的 queue 上限 (default 10000)")
+    parser.add_argument("--history", help="同時寫入歷史資料的 SQLite 檔（預設不寫）")
+    parser.add_argument("--stats", type=float, default=10.0, help="印出 sink 統計的間隔 [s]（0: 只在結束時）")
+    parser.add_argument("--seconds", type=float, default=0, help="執行秒數（0: 不停止）")
+    args = parser.parse_args()
+    try:
+        return asyncio.run(_main(args))
+    except KeyboardInterrupt:
+        return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,293 @@
+# history.py
+"""
+每台裝置的 event / posture / rssi 歷史。
+
+- RAM：每台裝置一個固定大小的 ring buffer（欄位各自一個 array），保留最近約 RING_SIZE 筆
+- Disk：SQLite（WAL）。raw 表保存最近 RAW_RETENTION 秒的每一筆，
+  較舊的資料每分鐘一次降採樣成 minute 表（每分鐘一列），minute 表保存 MINUTE_RETENTION 秒
+- 寫入：record() 只做 ring 與 list 的 append（在 scan callback 中呼叫也不會阻塞），
+  run() 每 FLUSH_INTERVAL 秒把累積的資料整批交給專用的 thread 寫入 SQLite
+- 查詢：query() 在範圍被 ring 涵蓋時直接從 RAM 回傳，否則合併 SQLite（同一個 thread）與 ring
+
+回傳為欄位式（columnar）:
+  {"address":..., "from":..., "to":..., "step":..., "source":"ram"|"disk",
+   "t":[...], "n":[...], "event":[...], "posture":[...], "flags":[...],
+   "rssi":[...], "rssi_min":[...], "rssi_max":[...]}
+step > 0 時每 step 秒一點（t 為區間開始，event/posture/flags 取區間內最後一筆，rssi 為平均）。
+"""
+import asyncio
+import math
+import sqlite3
+import time
+from array import array
+from concurrent.futures import ThreadPoolExecutor
+
+RING_SIZE = 1024                 # 每台裝置在 RAM 保留的筆數（1 秒 1 筆約 17 分鐘）
+FLUSH_INTERVAL = 0.5             # 寫入 SQLite 的週期 [s]
+QUEUE_MAX = 100000               # 尚未寫入的上限，超過就丟棄（計入 stats["dropped"]）
+RAW_RETENTION = 6 * 3600         # raw 表保留 [s]
+MINUTE_RETENTION = 30 * 86400    # minute 表保留 [s]
+ROLLOVER_INTERVAL = 60.0         # 降採樣/刪除的週期 [s]
+MAX_POINTS = 5000                # 一次查詢最多回傳的點數
+RAW_QUERY_MAX = 500000           # 一次查詢從 raw 表讀出的上限
+
+_NONE_POSTURE = -1               # array 內的 None
+_NONE_RSSI = -128
+
+_SCHEMA = """
+CREATE TABLE IF NOT EXISTS raw (
+    address TEXT NOT NULL, device_id INTEGER, t REAL NOT NULL,
+    event INTEGER, posture INTEGER, rssi INTEGER, flags INTEGER);
+CREATE INDEX IF NOT EXISTS raw_address_t ON raw (address, t);
+CREATE INDEX IF NOT EXISTS raw_t ON raw (t);
+CREATE TABLE IF NOT EXISTS minute (
+    address TEXT NOT NULL, device_id INTEGER, t REAL NOT NULL, n INTEGER,
+    event INTEGER, posture INTEGER, flags INTEGER,
+    rssi_sum INTEGER, rssi_n INTEGER, rssi_min INTEGER, rssi_max INTEGER,
+    PRIMARY KEY (address, t));
+CREATE INDEX IF NOT EXISTS minute_t ON minute (t);
+"""
+
+
+class Ring:
+    """固定大小的欄位式 ring buffer（時間遞增）"""
+
+    __slots__ = ("device_id", "head", "count", "t", "event", "posture", "rssi", "flags")
+
+    def __init__(self, device_id: int, size: int = RING_SIZE):
+        self.device_id = device_id
+        self.head = 0                        # 下一筆寫入的位置
+        self.count = 0
+        self.t = array("d", bytes(8 * size))
+        self.event = array("B", bytes(size))
+        self.posture = array("h", bytes(2 * size))
+        self.rssi = array("b", bytes(size))
+        self.flags = array("B", bytes(size))
+
+    def append(self, t: float, event, posture, rssi, flags: int):
+        i = self.head
+        self.t[i] = t
+        self.event[i] = (event or 0) & 0xFF
+        self.posture[i] = _NONE_POSTURE if posture is None else posture
+        self.rssi[i] = _NONE_RSSI if rssi is None else max(rssi, -127)
+        self.flags[i] = flags & 0xFF
+        self.head = (i + 1) % len(self.t)
+        if self.count < len(self.t):
+            self.count += 1
+
+    @property
+    def oldest(self) -> float:
+        if self.count == 0:
+            return math.inf
+        return self.t[(self.head - self.count) % len(self.t)]
+
+    def rows(self, t_from: float, t_to: float):
+        """[t_from, t_to) 的 raw row（與 SQLite raw 表同格式）"""
+        size = len(self.t)
+        out = []
+        for k in range(self.count):
+            i = (self.head - self.count + k) % size
+            t = self.t[i]
+            if t < t_from:
+                continue
+            if t >= t_to:
+                break
+            posture = self.posture[i]
+            rssi = self.rssi[i]
+            out.append((t, self.event[i], None if posture == _NONE_POSTURE else posture,
+                        None if rssi == _NONE_RSSI else rssi, self.flags[i]))
+        return out
+
+
+def _bucket_rows(rows, step: float):
+    """
+    raw row (t, event, posture, rssi, flags) 或已降採樣的 row
+    (t, n, event, posture, flags, rssi_sum, rssi_n, rssi_min, rssi_max) 合併成每 step 秒一點。
+    step <= 0 時 raw row 原樣輸出。
+    """
+    out = []
+    cur = None
+    for r in rows:
+        if len(r) == 5:
+            t, event, posture, rssi, flags = r
+            n = 1
+            rssi_sum, rssi_n = (rssi, 1) if rssi is not None else (0, 0)
+            rssi_min = rssi_max = rssi
+        else:
+            t, n, event, posture, flags, rssi_sum, rssi_n, rssi_min, rssi_max = r
+        b = math.floor(t / step) * step if step > 0 else t
+        if cur is not None and cur[0] == b:
+            cur[1] += n
+            cur[2], cur[3], cur[4] = event, posture, flags
+            cur[5] += rssi_sum
+            cur[6] += rssi_n
+            if rssi_min is not None:
+                cur[7] = rssi_min if cur[7] is None else min(cur[7], rssi_min)
+                cur[8] = rssi_max if cur[8] is None else max(cur[8], rssi_max)
+        else:
+            cur = [b, n, event, posture, flags, rssi_sum, rssi_n, rssi_min, rssi_max]
+            out.append(cur)
+    return out
+
+
+class HistoryStore:
+    def __init__(self, ring_size: int = RING_SIZE):
+        self.ring_size = ring_size
+        self.rings: dict[str, Ring] = {}
+        self.running = False
+        self._pending = []
+        self._db = None
+        self._executor = ThreadPoolExecutor(max_workers=1, thread_name_prefix="history")
+        self.stats = {"recorded": 0, "written": 0, "dropped": 0, "flushes": 0,
+                      "flush_ms": 0.0, "rolled_up": 0}
+
+    # ---- ingest（event loop 上，不等待 I/O）----
+    def record(self, address: str, device_id: int, t: float, event, posture, rssi, flags: int):
+        ring = self.rings.get(address)
+        if ring is None:
+            ring = self.rings[address] = Ring(device_id, self.ring_size)
+        ring.append(t, event, posture, rssi, flags)
+        self.stats["recorded"] += 1
+        if self.running:
+            if len(self._pending) < QUEUE_MAX:
+                self._pending.append((address, device_id, t, event, posture, rssi, flags))
+            else:
+                self.stats["dropped"] += 1
+
+    def forget(self, address: str):
+        """裝置從 devices 移除時釋放 ring（disk 上的資料保留）"""
+        self.rings.pop(address, None)
+
+    # ---- 批次寫入 ----
+    async def run(self, path: str):
+        loop = asyncio.get_running_loop()
+        await loop.run_in_executor(self._executor, self._open, path)
+        self.running = True
+        next_rollover = 0.0
+        try:
+            while True:
+                await asyncio.sleep(FLUSH_INTERVAL)
+                if self._pending:
+                    batch, self._pending = self._pending, []
+                    await loop.run_in_executor(self._executor, self._write, batch)
+                now = time.time()
+                if now >= next_rollover:
+                    next_rollover = now + ROLLOVER_INTERVAL
+                    await loop.run_in_executor(self._executor, self._rollover, now)
+        finally:
+            self.running = False
+            if self._pending:
+                batch, self._pending = self._pending, []
+                await loop.run_in_executor(self._executor, self._write, batch)
+
+    def _open(self, path: str):
+        db = sqlite3.connect(path, check_same_thread=False)
+        db.execute("PRAGMA journal_mode=WAL")
+        db.execute("PRAGMA synchronous=NORMAL")
+        db.executescript(_SCHEMA)
+        self._db = db
+
+    def _write(self, batch):
+        t0 = time.perf_counter()
+        with self._db:
+            self._db.executemany("INSERT INTO raw VALUES (?, ?, ?, ?, ?, ?, ?)", batch)
+        self.stats["written"] += len(batch)
+        self.stats["flushes"] += 1
+        self.stats["flush_ms"] = round((time.perf_counter() - t0) * 1000, 2)
+
+    def _rollover(self, now: float):
+        """RAW_RETENTION 以前的 raw 降採樣成 minute，並刪除超過保留期間的資料"""
+        db = self._db
+        cutoff = math.floor((now - RAW_RETENTION) / 60) * 60
+        with db:
+            cur = db.execute("SELECT address, device_id, t, event, posture, rssi, flags FROM raw "
+                             "WHERE t < ? ORDER BY address, t", (cutoff,))
+            minute_rows = []
+            address = None
+            device_id = None
+            group = []
+
+            def flush_group():
+                for b in _bucket_rows(group, 60):
+                    minute_rows.append((address, device_id, *b))
+
+            for address_r, device_id_r, t, event, posture, rssi, flags in cur:
+                if address_r != address:
+                    if group:
+                        flush_group()
+                    address, device_id, group = address_r, device_id_r, []
+                group.append((t, event, posture, rssi, flags))
+            if group:
+                flush_group()
+            # 同一分鐘已經有列（例如 rollover 之間重新啟動）時合併
+            db.executemany(
+                "INSERT INTO minute VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?) "
+                "ON CONFLICT (address, t) DO UPDATE SET n = n + excluded.n, event = excluded.event, "
+                "posture = excluded.posture, flags = excluded.flags, rssi_sum = rssi_sum + excluded.rssi_sum, "
+                "rssi_n = rssi_n + excluded.rssi_n, "
+                "rssi_min = MIN(IFNULL(rssi_min, excluded.rssi_min), IFNULL(excluded.rssi_min, rssi_min)), "
+                "rssi_max = MAX(IFNULL(rssi_max, excluded.rssi_max), IFNULL(excluded.rssi_max, rssi_max))",
+                minute_rows)
+            db.execute("DELETE FROM raw WHERE t < ?", (cutoff,))
+            db.execute("DELETE FROM minute WHERE t < ?", (now - MINUTE_RETENTION,))
+        self.stats["rolled_up"] += len(minute_rows)
+
+    # ---- 查詢 ----
+    def resolve(self, key: str) -> str | None:
+        """
+        address（含 ':'）或 device_id（10 進位或 0x 開頭的 16 進位）→ address。
+        device_id 只查 RAM 內的裝置；已移除的裝置請用 address 查。
+        """
+        if ":" in key:
+            return key.upper()
+        try:
+            device_id = int(key, 0)
+        except ValueError:
+            return None
+        for address, ring in self.rings.items():
+            if ring.device_id == device_id:
+                return address
+        return None
+
+    def _disk_rows(self, address: str, t_from: float, t_to: float):
+        if self._db is None:
+            return []
+        minute = self._db.execute(
+            "SELECT t, n, event, posture, flags, rssi_sum, rssi_n, rssi_min, rssi_max FROM minute "
+            "WHERE address = ? AND t >= ? AND t < ? ORDER BY t", (address, math.floor(t_from / 60) * 60, t_to)).fetchall()
+        raw = self._db.execute(
+            "SELECT t, event, posture, rssi, flags FROM raw WHERE address = ? AND t >= ? AND t < ? ORDER BY t LIMIT ?",
+            (address, t_from, t_to, RAW_QUERY_MAX)).fetchall()
+        return minute + raw
+
+    async def query(self, address: str, t_from: float | None, t_to: float | None, step: float = 0) -> dict:
+        t_to = time.time() if t_to is None else t_to
+        t_from = t_to - 600 if t_from is None else t_from
+        if step > 0 and (t_to - t_from) / step > MAX_POINTS:
+            step = math.ceil((t_to - t_from) / MAX_POINTS)
+        ring = self.rings.get(address)
+        oldest = ring.oldest if ring is not None else math.inf
+        rows = ring.rows(t_from, t_to) if ring is not None else []
+        source = "ram"
+        if t_from < oldest and self._db is not None:
+            # ring 沒涵蓋的前段從 disk 讀（寫入與查詢共用同一個 thread，不會讀到寫一半的批次）
+            loop = asyncio.get_running_loop()
+            disk = await loop.run_in_executor(self._executor, self._disk_rows, address, t_from, min(t_to, oldest))
+            if disk:
+                rows = disk + rows
+                source = "disk"
+        points = _bucket_rows(rows, step)
+        truncated = len(points) > MAX_POINTS
+        points = points[-MAX_POINTS:]
+        return {
+            "address": address, "from": t_from, "to": t_to, "step": step, "source": source,
+            "truncated": truncated,
+            "t": [round(p[0], 3) for p in points],
+            "n": [p[1] for p in points],
+            "event": [p[2] for p in points],
+            "posture": [p[3] for p in points],
+            "flags": [p[4] for p in points],
+            "rssi": [round(p[5] / p[6], 1) if p[6] else None for p in points],
+            "rssi_min": [p[7] for p in points],
+            "rssi_max": [p[8] for p in points],
+        }
@@ -0,0 +1,135 @@
+# loadtest_ws.py
+"""
+WebSocket 推送的負載測試（不需要 BLE、FastAPI）。
+
+N 台模擬裝置以固定的廣播頻率經 ble_scanner.apply_report() 更新裝置表，
+M 個假 client 走與 app.py 相同的 change_feed.serve_client()，
+量測 server 側的 CPU 使用率與送出的 bytes/s。
+--mode snapshot 則模擬舊版（每 0.25 秒對每個 client 序列化整個裝置表）做比較。
+
+    python loadtest_ws.py
+    python loadtest_ws.py --devices 1000 --clients 8 --rate 0.5 --seconds 20
+    python loadtest_ws.py --mode delta
+"""
+import argparse
+import asyncio
+import json
+import random
+import sys
+import time
+
+import ble_scanner
+from change_feed import ChangeFeed, serve_client
+
+SNAPSHOT_INTERVAL = 0.25   # 舊版 ws_devices 的推送週期
+TICK = 0.01                # 模擬廣播的批次週期 [s]
+
+
+class FakeClient:
+    """只計數的 WebSocket：change feed 的 frame 立刻 ack（取 "v" 不做完整 JSON 解析）"""
+
+    def __init__(self):
+        self.bytes = 0
+        self.frames = 0
+        self._ack = None
+
+    async def send_text(self, text: str):
+        self.bytes += len(text.encode("utf-8"))
+        self.frames += 1
+        head = text[:80]
+        i = head.find('"v":')
+        if i >= 0:
+            i += 4
+            self._ack = '{"ack":%s}' % head[i:head.index(",", i)]
+
+    async def receive_text(self) -> str:
+        return self._ack
+
+
+async def legacy_client(client: FakeClient):
+    # 舊版：snapshot() + send_json()（starlette 的 send_json 同樣用 json.dumps）
+    while True:
+        data = await ble_scanner.snapshot()
+        await client.send_text(json.dumps(data, separators=(",", ":"), ensure_ascii=False))
+        await asyncio.sleep(SNAPSHOT_INTERVAL)
+
+
+async def advertise(n: int, rate: float, rng: random.Random, stop: asyncio.Event):
+    """n 台裝置，每台平均每秒 rate 次廣播"""
+    names = ["BLE Badge %04d" % i for i in range(n)]
+    addresses = ["C0:00:00:00:%02X:%02X" % (i >> 8, i & 0xFF) for i in range(n)]
+    for i in range(n):
+        ble_scanner.apply_report(addresses[i], names[i], 0x1000 + i, 0x01, 0, -60, 0)
+    budget = 0.0
+    last = time.perf_counter()
+    while not stop.is_set():
+        await asyncio.sleep(TICK)
+        now = time.perf_counter()
+        budget += n * rate * (now - last)
+        last = now
+        while budget >= 1.0:
+            budget -= 1.0
+            i = rng.randrange(n)
+            ble_scanner.apply_report(addresses[i], names[i], 0x1000 + i, 0x02,
+                                     rng.randrange(4), rng.randint(-90, -45), 0)
+
+
+async def run(mode: str, args) -> dict:
+    ble_scanner.devices.clear()
+    ble_scanner.feed = ChangeFeed(ble_scanner.devices)     # mode 之間不共用版本與 Event
+    stop = asyncio.Event()
+    rng = random.Random(args.seed)
+    clients = [FakeClient() for _ in range(args.clients)]
+    producer = asyncio.create_task(advertise(args.devices, args.rate, rng, stop))
+    await asyncio.sleep(0)
+
+    cpu0 = time.process_time()
+    t0 = time.perf_counter()
+    if mode == "delta":
+        tasks = [asyncio.create_task(serve_client(c, ble_scanner.feed)) for c in clients]
+    elif mode == "snapshot":
+        tasks = [asyncio.create_task(legacy_client(c)) for c in clients]
+    else:
+        tasks = []
+    await asyncio.sleep(args.seconds)
+    wall = time.perf_counter() - t0
+    cpu = time.process_time() - cpu0
+
+    stop.set()
+    for t in tasks + [producer]:
+        t.cancel()
+    await asyncio.gather(*tasks, producer, return_exceptions=True)
+
+    sent = sum(c.bytes for c in clients)
+    frames = sum(c.frames for c in clients)
+    return {
+        "mode": mode,
+        "cpu_pct": 100.0 * cpu / wall,
+        "bytes_per_s": sent / wall,
+        "bytes_per_client_s": sent / wall / max(len(clients), 1),
+        "frames_per_s": frames / wall,
+    }
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--devices", type=int, default=500, help="模擬裝置數 (default 500)")
+    parser.add_argument("--clients", type=int, default=4, help="WebSocket client 數 (default 4)")
+    parser.add_argument("--rate", type=float, default=1.0, help="每台裝置每秒的廣播次數 (default 1.0)")
+    parser.add_argument("--seconds", type=float, default=5.0, help="每個 mode 的量測時間 (default 5)")
+    parser.add_argument("--mode", choices=["all", "idle", "snapshot", "delta"], default="all",
+                        help="idle: 只有廣播（基準）, snapshot: 舊版, delta: change feed")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    modes = ["idle", "snapshot", "delta"] if args.mode == "all" else [args.mode]
+    print("devices=%d clients=%d rate=%.2f/s seconds=%.1f" % (args.devices, args.clients, args.rate, args.seconds))
+    for mode in modes:
+        r = asyncio.run(run(mode, args))
+        print("%-8s cpu=%5.1f%%  bytes/s=%10.0f  per_client=%9.0f  frames/s=%6.1f"
+              % (r["mode"], r["cpu_pct"], r["bytes_per_s"], r["bytes_per_client_s"], r["frames_per_s"]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,6 +1,6 @@
 # model.py
 import time
-from dataclasses import dataclass, asdict
+from dataclasses import dataclass, asdict, field
 
 OFFLINE_TIMEOUT = 15.0  # seconds
 
@@ -14,12 +14,17 @@ class DeviceState:
     flags: int = 0
     rssi: int | None = None
     last_seen: float = 0.0
+    via: str = "ble"              # 最後一次的來源："ble"（本機 Bleak）或 gateway 的 serial port
+    seq: int | None = None        # badge 的 payload 序號（相同 = 重複的廣播）
+    pushed: float = field(default=0.0, repr=False)   # 最後一次送進 feed / history 的 last_seen
 
-    def touch(self, event: int,posture: int, rssi: int, flags: int = 0):
+    def touch(self, event: int,posture: int, rssi: int, flags: int = 0, via: str = "ble", seq: int | None = None):
         self.event = event
         self.posture = posture
         self.rssi = rssi
         self.flags = flags
+        self.via = via
+        self.seq = seq
         self.last_seen = time.time()
 
     @property
@@ -30,8 +35,15 @@ class DeviceState:
     def online(self) -> bool:
         return self.age < OFFLINE_TIMEOUT
 
+    def to_wire(self):
+        # WebSocket 用：不含 age/online（會隨時間變化），由 client 用 last_seen 與 frame 的 now 計算
+        return {"address": self.address, "name": self.name, "device_id": self.device_id,
+                "event": self.event, "posture": self.posture, "flags": self.flags,
+                "rssi": self.rssi, "last_seen": self.last_seen, "via": self.via, "seq": self.seq}
+
     def to_dict(self):
         d = asdict(self)
+        del d["pushed"]
         d["age"] = round(self.age, 1)
         d["online"] = self.online
         return d
@@ -0,0 +1,112 @@
+# presence.py
+"""
+Online/Offline 判定與長時間離線裝置的移除（hashed timer wheel）。
+
+- touch()：每次收到廣播時把期限（最後收到 + OFFLINE_TIMEOUT）排進 wheel，O(1)；
+  舊的排程不刪除，到期時發現期限已更新就丟掉（lazy cancel）
+- run()：每 TICK 秒推進 wheel，期限到的裝置在 TICK 內轉為 offline，
+  再過 EVICT_AFTER 秒仍未收到就從 devices / feed / history 的 RAM 移除
+- 狀態轉換（online / offline / evicted）以事件送給 ChangeFeed（WebSocket client）與 hooks（警報）
+"""
+import asyncio
+import sys
+import time
+
+from model import OFFLINE_TIMEOUT
+
+TICK = 0.1                 # wheel 的解析度 [s]，offline 最晚在期限後 TICK 內判定
+WHEEL_SIZE = 512           # slot 數（一圈 51.2 秒；更遠的期限多轉幾圈）
+EVICT_AFTER = 600.0        # offline 後多久移除 [s]
+
+
+class PresenceTracker:
+    def __init__(self, devices: dict, feed, history, timeout: float = OFFLINE_TIMEOUT,
+                 evict_after: float = EVICT_AFTER):
+        self.devices = devices
+        self.feed = feed
+        self.history = history
+        self.timeout_ticks = int(round(timeout / TICK))
+        self.evict_ticks = int(round(evict_after / TICK))
+        self.hooks = []                       # hook(event: dict)，在 event loop 上呼叫，不可阻塞
+        self._wheel = [set() for _ in range(WHEEL_SIZE)]
+        self._due = {}                        # address -> 期限的 tick
+        self._online = {}                     # address -> bool
+        self._tick = int(time.monotonic() / TICK)
+        self.stats = {"online": 0, "offline": 0, "evicted": 0, "late_ms_max": 0.0}
+
+    def _schedule(self, address: str, due: int):
+        self._due[address] = due
+        self._wheel[due % WHEEL_SIZE].add(address)
+
+    def touch(self, address: str):
+        """收到廣播（apply_report 內呼叫）"""
+        due = int(time.monotonic() / TICK) + self.timeout_ticks + 1
+        if self._due.get(address) != due:
+            self._schedule(address, due)
+        if not self._online.get(address):
+            self._online[address] = True
+            self.stats["online"] += 1
+            self._emit("online", address)
+
+    def is_online(self, address: str) -> bool:
+        return self._online.get(address, False)
+
+    async def run(self):
+        while True:
+            await asyncio.sleep(TICK)
+            self.advance(time.monotonic())
+
+    def advance(self, now: float):
+        """now（monotonic）之前到期的 slot 全部處理（event loop 停頓後也會補上）"""
+        target = int(now / TICK)
+        while self._tick < target:
+            self._tick += 1
+            tick = self._tick
+            slot = tick % WHEEL_SIZE
+            bucket = self._wheel[slot]
+            if not bucket:
+                continue
+            keep = set()
+            fired = []
+            for address in bucket:
+                due = self._due.get(address)
+                if due == tick:
+                    fired.append(address)
+                elif due is not None and due > tick and due % WHEEL_SIZE == slot:
+                    keep.add(address)             # 還要再轉幾圈
+                # 其他：期限已更新（lazy cancel）或已移除
+            self._wheel[slot] = keep
+            for address in fired:
+                self._expire(address, tick, now)
+
+    def _expire(self, address: str, tick: int, now: float):
+        late_ms = (now - tick * TICK) * 1000.0
+        if late_ms > self.stats["late_ms_max"]:
+            self.stats["late_ms_max"] = round(late_ms, 1)
+        if self._online.get(address):
+            self._online[address] = False
+            self.stats["offline"] += 1
+            self._emit("offline", address)
+            self._schedule(address, tick + self.evict_ticks)
+            return
+        # offline 後 EVICT_AFTER 秒都沒有收到：移除（disk 上的歷史保留）
+        self._emit("evicted", address)
+        del self._due[address]
+        del self._online[address]
+        self.devices.pop(address, None)
+        self.feed.remove(address)
+        self.history.forget(address)
+        self.stats["evicted"] += 1
+
+    def _emit(self, state: str, address: str):
+        d = self.devices.get(address)
+        event = {"type": state, "address": address, "t": round(time.time(), 3),
+                 "name": d.name if d is not None else None,
+                 "device_id": d.device_id if d is not None else None,
+                 "last_seen": d.last_seen if d is not None else None}
+        self.feed.event(event)
+        for hook in self.hooks:
+            try:
+                hook(event)
+            except Exception as e:
+                print("presence hook: %r" % e, file=sys.stderr)
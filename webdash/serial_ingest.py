@@ -0,0 +1,337 @@
+# serial_ingest.py
+"""
+nRF gateway（firmware/ble_app_gateway）的 UART 上傳資料接收。
+
+gateway 每收到一個 badge 廣播就送出一筆（沒有換行）:
+    $$$index=4&x=61&y=-74&z=-21&gx=0&gy=0&gz=0&bt_addr=E4:C6:C6:A4:7B:CE&user_id=929c&upload_time=...&battery=316&rssi=-67&seq=12&flags=1&ver=1&gw_ms=81234###
+（bleadv_packet_output()，x/y/z 為 1/100 g，battery 為 1/100 V；seq / flags / ver 見 adv_schema.py，舊的 gateway 沒有；
+ gw_ms 為 gateway 開機後的 ms，更舊的 gateway 沒有）
+
+- GatewayFramer: 在同一個 bytearray 上找 $$$ / ###，欄位用 regex 直接在 buffer 上解析（不切出子字串），
+  每次 read 只在最後把用掉的前段刪掉一次；遇到缺結尾、過長、雜訊時丟掉並重新同步
+- SerialGateway: 一個 port 一個，POSIX 用 add_reader（在 event loop 上同步解析並更新 devices），
+  其他平台用 pyserial 的 blocking read 丟到 thread；斷線後自動重開
+- 可同時接多個 gateway，記錄直接合併進 ble_scanner.devices（與 Bleak 掃描共用同一張表）
+- 同一次 read 內的警報（EVENT_ALARM）先處理；gw_ms 由 GatewayClock 換算成 host 時間，給警報的 hop 延遲
+
+    python serial_ingest.py /dev/ttyACM0 /dev/ttyACM1
+    python serial_ingest.py /dev/pts/5 --seconds 10        # 對 fake_gateway.py 的 pty
+    python serial_ingest.py COM5 --capture capture.bin     # 錄下原始 stream（fake_gateway.py --replay 重播）
+"""
+import argparse
+import asyncio
+import os
+import re
+import sys
+import time
+from typing import NamedTuple
+from urllib.parse import unquote_to_bytes
+
+import adv_schema
+import ble_scanner
+
+BAUDRATE = 115200                 # uarte_pusher.c: NRF_UARTE_BAUDRATE_115200
+RECORD_START = b"$$$"
+RECORD_END = b"###"
+RECORD_MAX = 256                  # gateway 的 buffer 為 192 bytes，超過就當作結尾遺失
+READ_SIZE = 4096
+REOPEN_DELAY = 2.0                # 開啟失敗/斷線後重試的間隔 [s]
+CLOCK_DRIFT = 100e-6              # GatewayClock 的 offset 每秒放寬的量（兩邊 crystal 的誤差以上）
+
+_FIELD_RE = re.compile(rb"([a-z_]+)=([^&]*)")
+
+
+class GatewayRecord(NamedTuple):
+    address: str
+    device_id: int
+    event: int
+    rssi: int | None
+    battery: int | None           # 1/100 V
+    acc: tuple[int, int, int]     # 1/100 g
+    seq: int | None = None        # 舊的 gateway firmware 沒有 seq / flags
+    flags: int | None = None
+    gw_ms: int | None = None      # gateway 送出的時間（開機後 ms）
+
+
+class GatewayFramer:
+    """gateway UART stream 的切割與解析（不依賴 I/O，可直接餵 bytes 測試）"""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.stats = {"bytes": 0, "records": 0, "bad": 0, "resync": 0, "dropped": 0}
+
+    def feed(self, data) -> list[GatewayRecord]:
+        buf = self.buf
+        buf += data
+        stats = self.stats
+        stats["bytes"] += len(data)
+        out = []
+        pos = 0
+        n = len(buf)
+        while True:
+            start = buf.find(RECORD_START, pos)
+            if start < 0:
+                # 只保留可能是 "$$" 開頭的最後 2 bytes
+                keep = max(pos, n - 2)
+                stats["dropped"] += keep - pos
+                pos = keep
+                break
+            if start > pos:
+                stats["dropped"] += start - pos
+                stats["resync"] += 1
+            end = buf.find(RECORD_END, start + 3)
+            if end < 0:
+                if n - start > RECORD_MAX:
+                    # 結尾遺失：跳過這個開頭，從下一個 $$$ 重新同步
+                    stats["resync"] += 1
+                    pos = start + 3
+                    continue
+                pos = start
+                break
+            # 記錄中間又出現 $$$：前一筆的結尾遺失，只解析最後一個開頭
+            inner = buf.rfind(RECORD_START, start + 3, end)
+            if inner >= 0:
+                stats["dropped"] += inner - start
+                stats["resync"] += 1
+                start = inner
+            record = self._parse(buf, start + 3, end)
+            if record is None:
+                stats["bad"] += 1
+            else:
+                stats["records"] += 1
+                out.append(record)
+            pos = end + 3
+        if pos:
+            del buf[:pos]
+        return out
+
+    @staticmethod
+    def _parse(buf: bytearray, begin: int, end: int) -> GatewayRecord | None:
+        fields = {}
+        for m in _FIELD_RE.finditer(buf, begin, end):
+            fields[m.group(1)] = m.group(2)
+        try:
+            addr = fields[b"bt_addr"]
+            if b"%" in addr:
+                addr = unquote_to_bytes(addr)
+            rssi = fields.get(b"rssi")
+            battery = fields.get(b"battery")
+            seq = fields.get(b"seq")
+            flags = fields.get(b"flags")
+            gw_ms = fields.get(b"gw_ms")
+            return GatewayRecord(
+                address=addr.decode("ascii").upper(),
+                device_id=int(fields[b"user_id"], 16),
+                event=int(fields[b"index"]),
+                rssi=int(rssi) if rssi is not None else None,
+                battery=int(battery) if battery is not None else None,
+                acc=(int(fields.get(b"x", 0)), int(fields.get(b"y", 0)), int(fields.get(b"z", 0))),
+                seq=int(seq) if seq is not None else None,
+                flags=int(flags) if flags is not None else None,
+                gw_ms=int(gw_ms) if gw_ms is not None else None,
+            )
+        except (KeyError, ValueError, UnicodeDecodeError):
+            return None
+
+
+class GatewayClock:
+    """
+    gateway 的 gw_ms（開機後 ms）→ host 的 epoch 秒（一個 port 一個）。
+    offset 為「host 收到 − gateway 送出」的最小值，也就是 UART 與 read 最快的一次；
+    換算出來的延遲是比最快的一次多花的時間（UART 排隊、event loop 的延遲）。
+    offset 每秒放寬 CLOCK_DRIFT 以跟上 crystal 的誤差，gw_ms 變小（gateway 重開）時重新開始。
+    """
+
+    def __init__(self):
+        self.offset = None
+        self._last_rx = 0.0
+        self._last_gw = 0
+
+    def update(self, gw_ms: int, rx: float):
+        sample = rx - gw_ms / 1000.0
+        if self.offset is None or gw_ms < self._last_gw:
+            self.offset = sample
+        else:
+            self.offset = min(sample, self.offset + CLOCK_DRIFT * (rx - self._last_rx))
+        self._last_rx = rx
+        self._last_gw = gw_ms
+
+    def to_epoch(self, gw_ms: int | None) -> float | None:
+        if gw_ms is None or self.offset is None:
+            return None
+        return gw_ms / 1000.0 + self.offset
+
+
+def apply_records(records: list[GatewayRecord], port: str, clock: GatewayClock, on_record=None):
+    """一次 read 的記錄：警報先處理，其他依序（SerialGateway 與 fleet_sim.py 共用）"""
+    if not records:
+        return
+    on_record = on_record or apply_record
+    # offset 每次 read 只用最後一筆估計（最近送出的，排隊最短）
+    last = records[-1]
+    if last.gw_ms is not None:
+        clock.update(last.gw_ms, time.time())
+    alarm = adv_schema.EVENT_ALARM
+    for record in records:
+        if record.event == alarm:
+            on_record(record, port, clock.to_epoch(record.gw_ms))
+    for record in records:
+        if record.event != alarm:
+            on_record(record, port)
+
+
+def apply_record(record: GatewayRecord, port: str, t_gw: float | None = None):
+    """gateway 記錄合併進 devices（名稱沿用 Bleak 看到的，沒有就用 device_id）"""
+    d = ble_scanner.devices.get(record.address)
+    name = d.name if d is not None else "%s %04X" % (ble_scanner.NAME_PREFIX, record.device_id)
+    if record.flags is not None:
+        flags = record.flags
+        posture = flags & adv_schema.FLAG_FALLEN
+    else:
+        posture = d.posture if d is not None else None
+        flags = d.flags if d is not None else 0
+    ble_scanner.apply_report(record.address, name, record.device_id, record.event, posture,
+                             record.rssi, flags, via=port, seq=record.seq, t_gw=t_gw)
+
+
+class SerialGateway:
+    def __init__(self, port: str, baudrate: int = BAUDRATE, on_record=apply_record, capture=None):
+        self.port = port
+        self.baudrate = baudrate
+        self.on_record = on_record
+        self.capture = capture           # 原始 bytes 的錄製檔（binary file object）
+        self.framer = GatewayFramer()
+        self.clock = GatewayClock()
+        self.connected = False
+        self.opened = 0
+
+    def status(self) -> dict:
+        return {"port": self.port, "connected": self.connected, "opened": self.opened, **self.framer.stats}
+
+    def _handle(self, data: bytes):
+        if self.capture is not None:
+            self.capture.write(data)
+        apply_records(self.framer.feed(data), self.port, self.clock, self.on_record)
+
+    async def run(self):
+        while True:
+            try:
+                if os.name == "posix":
+                    await self._run_posix()
+                else:
+                    await self._run_pyserial()
+            except OSError as e:
+                print("gateway %s: %s" % (self.port, e), file=sys.stderr)
+            self.connected = False
+            await asyncio.sleep(REOPEN_DELAY)
+
+    async def _run_posix(self):
+        import termios
+        import tty
+
+        fd = os.open(self.port, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+        try:
+            if os.isatty(fd):
+                tty.setraw(fd)
+                attr = termios.tcgetattr(fd)
+                speed = getattr(termios, "B%d" % self.baudrate)
+                attr[4] = attr[5] = speed
+                termios.tcsetattr(fd, termios.TCSANOW, attr)
+            loop = asyncio.get_running_loop()
+            closed = loop.create_future()
+
+            def readable():
+                try:
+                    data = os.read(fd, READ_SIZE)
+                except BlockingIOError:
+                    return
+                except OSError as e:
+                    data = b""
+                    if not closed.done():
+                        closed.set_exception(e)
+                if not data:
+                    # EOF：裝置拔除或 pty 對端關閉
+                    loop.remove_reader(fd)
+                    if not closed.done():
+                        closed.set_result(None)
+                    return
+                self._handle(data)
+
+            loop.add_reader(fd, readable)
+            self.connected = True
+            self.opened += 1
+            try:
+                await closed
+            finally:
+                loop.remove_reader(fd)
+        finally:
+            os.close(fd)
+
+    async def _run_pyserial(self):
+        import serial
+
+        ser = serial.Serial(self.port, self.baudrate, timeout=0.1)
+        loop = asyncio.get_running_loop()
+        self.connected = True
+        self.opened += 1
+        try:
+            while True:
+                data = await loop.run_in_executor(None, ser.read, READ_SIZE)
+                if data:
+                    self._handle(data)
+        except serial.SerialException as e:
+            raise OSError(str(e)) from e
+        finally:
+            ser.close()
+
+
+gateways: list[SerialGateway] = []
+
+
+async def ingest_forever(ports: list[str], baudrate: int = BAUDRATE, capture=None):
+    """每個 port 各跑一個 SerialGateway（app.py 的 startup 呼叫）"""
+    gateways.extend(SerialGateway(p, baudrate, capture=capture) for p in ports)
+    await asyncio.gather(*(g.run() for g in gateways))
+
+
+async def _main(args) -> int:
+    capture = open(args.capture, "wb") if args.capture else None
+    task = asyncio.create_task(ingest_forever(args.ports, args.baudrate, capture))
+    t0 = time.perf_counter()
+    cpu0 = time.process_time()
+    last = dict.fromkeys(args.ports, 0)
+    try:
+        while args.seconds <= 0 or time.perf_counter() - t0 < args.seconds:
+            await asyncio.sleep(1.0)
+            for g in gateways:
+                s = g.status()
+                print("%s records=%d (+%d/s) bad=%d resync=%d dropped=%d devices=%d"
+                      % (g.port, s["records"], s["records"] - last[g.port], s["bad"], s["resync"],
+                         s["dropped"], len(ble_scanner.devices)))
+                last[g.port] = s["records"]
+    finally:
+        task.cancel()
+        if capture is not None:
+            capture.close()
+    wall = time.perf_counter() - t0
+    total = sum(g.framer.stats["records"] for g in gateways)
+    print("SUMMARY records=%d records_per_s=%.0f cpu=%.1f%% devices=%d"
+          % (total, total / wall, 100.0 * (time.process_time() - cpu0) / wall, len(ble_scanner.devices)))
+    return 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("ports", nargs="+", help="gateway 的 serial port（可多個）")
+    parser.add_argument("--baudrate", type=int, default=BAUDRATE)
+    parser.add_argument("--seconds", type=float, default=0, help="執行秒數（0: 不停止）")
+    parser.add_argument("--capture", help="把收到的原始 bytes 寫進檔案（多個 port 時混在一起）")
+    args = parser.parse_args()
+    try:
+        return asyncio.run(_main(args))
+    except KeyboardInterrupt:
+        return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
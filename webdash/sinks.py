@@ -0,0 +1,332 @@
+# sinks.py
+"""
+解碼後的事件扇出（fan-out）到多個輸出（sink），給其他系統接收。
+
+- publish()：apply_report() / presence 在 event loop 上同步呼叫。事件只序列化一次（NDJSON 一行），
+  再放進每個 sink 自己的 bounded deque，不等待任何 I/O
+- 每個 sink 一個 task：把 deque 內累積的事件整批寫出。寫得慢的 sink 只會讓自己的 deque 滿，
+  滿了就丟掉最舊的事件（計入 dropped），不會拖慢掃描 / serial ingest 或其他 sink
+- 檔案寫入在 sink 專用的 thread；socket 的 client 各自有上限，慢的 client 只丟自己的資料
+
+事件（NDJSON 一行一個 JSON）:
+  {"type":"report","address":...,"name":...,"device_id":...,"event":...,"posture":...,"flags":...,
+   "rssi":...,"last_seen":...,"via":...,"seq":...}
+  {"type":"online"|"offline"|"evicted","address":...,"t":...,"name":...,"device_id":...,"last_seen":...}
+
+sink:
+  NdjsonSink(path)            一個檔案，持續 append
+  CsvSink(directory)          每小時（或超過 max_bytes）換一個 CSV 檔（欄位 CSV_FIELDS）
+  UnixSocketSink(path)        本機 Unix socket，連上的 client 都收到同樣的 NDJSON stream
+  WebSocketSink()             WebSocket client（app.py / headless.py 的 /ws/events），一個 frame 為一批 NDJSON
+"""
+import asyncio
+import csv
+import io
+import json
+import os
+import sys
+import time
+from collections import deque
+from concurrent.futures import ThreadPoolExecutor
+from typing import NamedTuple
+
+QUEUE_MAX = 10000           # 每個 sink 未寫出的事件上限（超過丟最舊的）
+BATCH_MAX = 2000            # 一次寫出的最多事件數
+CLIENT_BUFFER_MAX = 1 << 20 # socket client 未送出的 bytes 上限（超過就不再送給它，計入 dropped）
+RETRY_DELAY = 2.0           # 開啟/寫入失敗後重試的間隔 [s]
+LATENCY_SAMPLES = 4096      # publish → 寫出完成 的延遲，保留最近幾筆算百分位
+CSV_ROLL_SECONDS = 3600     # CSV 換檔的週期 [s]（整點對齊）
+CSV_MAX_BYTES = 64 << 20    # CSV 一個檔的上限
+CSV_FIELDS = ("t", "type", "address", "device_id", "name", "event", "seq", "flags", "posture", "rssi", "via")
+
+
+class Item(NamedTuple):
+    t: float                # publish 的 perf_counter()
+    event: dict
+    line: bytes             # NDJSON 一行（含換行）
+
+
+class Sink:
+    """bounded deque + 寫出 task 的共通部分；子類別實作 open() / write(batch)"""
+
+    kind = "sink"
+    listening = True            # False 的 sink 不接收（沒有 client 的 WebSocketSink）
+
+    def __init__(self, name: str, maxsize: int = QUEUE_MAX):
+        self.name = name
+        self.queue = deque(maxlen=maxsize)
+        self._wake = asyncio.Event()
+        self._latency = deque(maxlen=LATENCY_SAMPLES)
+        self.stats = {"offered": 0, "sent": 0, "dropped": 0, "batches": 0, "errors": 0}
+
+    def offer(self, item: Item):
+        """event loop 上呼叫，不阻塞；滿了就擠掉最舊的"""
+        queue = self.queue
+        if len(queue) == queue.maxlen:
+            self.stats["dropped"] += 1
+        queue.append(item)
+        self.stats["offered"] += 1
+        self._wake.set()
+
+    async def open(self):
+        pass
+
+    async def write(self, batch: list[Item]):
+        raise NotImplementedError
+
+    async def run(self):
+        while True:
+            try:
+                await self.open()
+                break
+            except OSError as e:
+                self.stats["errors"] += 1
+                print("sink %s: %s" % (self.name, e), file=sys.stderr)
+                await asyncio.sleep(RETRY_DELAY)
+        queue = self.queue
+        while True:
+            await self._wake.wait()
+            self._wake.clear()
+            while queue:
+                batch = [queue.popleft() for _ in range(min(len(queue), BATCH_MAX))]
+                try:
+                    await self.write(batch)
+                except OSError as e:
+                    self.stats["errors"] += 1
+                    self.stats["dropped"] += len(batch)
+                    print("sink %s: %s" % (self.name, e), file=sys.stderr)
+                    await asyncio.sleep(RETRY_DELAY)
+                    continue
+                now = time.perf_counter()
+                self._latency.extend(now - item.t for item in batch)
+                self.stats["sent"] += len(batch)
+                self.stats["batches"] += 1
+
+    def status(self) -> dict:
+        lat = sorted(self._latency)
+        out = {"name": self.name, "kind": self.kind, "queued": len(self.queue), "queue_max": self.queue.maxlen,
+               **self.stats}
+        if lat:
+            out["latency_ms"] = {"p50": round(lat[len(lat) // 2] * 1000, 3),
+                                 "p99": round(lat[min(len(lat) - 1, len(lat) * 99 // 100)] * 1000, 3),
+                                 "max": round(lat[-1] * 1000, 3)}
+        return out
+
+
+class _FileSink(Sink):
+    """檔案寫入在專用的 thread（同一個 sink 的寫入依序執行）"""
+
+    def __init__(self, name: str, maxsize: int = QUEUE_MAX):
+        super().__init__(name, maxsize)
+        self._executor = ThreadPoolExecutor(max_workers=1, thread_name_prefix="sink")
+
+    async def _call(self, fn, *args):
+        return await asyncio.get_running_loop().run_in_executor(self._executor, fn, *args)
+
+
+class NdjsonSink(_FileSink):
+    kind = "ndjson"
+
+    def __init__(self, path: str, maxsize: int = QUEUE_MAX):
+        super().__init__(path, maxsize)
+        self.path = path
+        self._file = None
+
+    async def open(self):
+        self._file = await self._call(open, self.path, "ab")
+
+    async def write(self, batch: list[Item]):
+        await self._call(self._write, b"".join(item.line for item in batch))
+
+    def _write(self, data: bytes):
+        self._file.write(data)
+        self._file.flush()
+
+
+class CsvSink(_FileSink):
+    """<directory>/<prefix>-YYYYmmdd-HHMM[SS].csv（本地時間，每 roll_seconds 一個）；期間內超過 max_bytes 時加 .1, .2 ..."""
+
+    kind = "csv"
+
+    def __init__(self, directory: str, prefix: str = "events", roll_seconds: float = CSV_ROLL_SECONDS,
+                 max_bytes: int = CSV_MAX_BYTES, maxsize: int = QUEUE_MAX):
+        super().__init__(directory, maxsize)
+        self.directory = directory
+        self.prefix = prefix
+        self.roll_seconds = roll_seconds
+        self.max_bytes = max_bytes
+        self.path = None
+        self._file = None
+        self._period = None
+        self._part = 0
+        self.stats["files"] = 0
+
+    async def open(self):
+        await self._call(os.makedirs, self.directory, 0o777, True)
+
+    async def write(self, batch: list[Item]):
+        await self._call(self._write, [item.event for item in batch])
+
+    def _roll(self, now: float):
+        period = int(now // self.roll_seconds)
+        if self._file is not None and period == self._period and self._file.tell() < self.max_bytes:
+            return
+        if self._file is not None:
+            self._file.close()
+        self._part = self._part + 1 if period == self._period else 0
+        self._period = period
+        fmt = "%Y%m%d-%H%M" if self.roll_seconds % 60 == 0 else "%Y%m%d-%H%M%S"
+        name = "%s-%s" % (self.prefix, time.strftime(fmt, time.localtime(period * self.roll_seconds)))
+        if self._part:
+            name += ".%d" % self._part
+        self.path = os.path.join(self.directory, name + ".csv")
+        self._file = open(self.path, "a", newline="", encoding="utf-8")
+        if self._file.tell() == 0:
+            self._file.write(",".join(CSV_FIELDS) + "\r\n")
+        self.stats["files"] += 1
+
+    def _write(self, events: list[dict]):
+        self._roll(time.time())
+        buf = io.StringIO()
+        writer = csv.writer(buf)
+        for ev in events:
+            writer.writerow((ev.get("t", ev.get("last_seen")), ev.get("type"), ev.get("address"), ev.get("device_id"),
+                             ev.get("name"), ev.get("event"), ev.get("seq"), ev.get("flags"), ev.get("posture"),
+                             ev.get("rssi"), ev.get("via")))
+        self._file.write(buf.getvalue())
+        self._file.flush()
+
+
+class _StreamFanout(Sink):
+    """連線中的 client 各自有 buffer 上限；超過的 client 這一批不送（計入它的 dropped）"""
+
+    def __init__(self, name: str, maxsize: int = QUEUE_MAX):
+        super().__init__(name, maxsize)
+        self.clients = {}                 # client -> {"sent": n, "dropped": n}
+        self.stats["clients"] = 0
+
+    def status(self) -> dict:
+        out = super().status()
+        out["client_stats"] = list(self.clients.values())
+        return out
+
+
+class UnixSocketSink(_StreamFanout):
+    kind = "unix"
+
+    def __init__(self, path: str, maxsize: int = QUEUE_MAX):
+        super().__init__(path, maxsize)
+        self.path = path
+        self._server = None
+
+    async def open(self):
+        if os.path.exists(self.path):
+            os.unlink(self.path)
+        self._server = await asyncio.start_unix_server(self._accept, self.path)
+
+    async def _accept(self, reader: asyncio.StreamReader, writer: asyncio.StreamWriter):
+        self.clients[writer] = {"client": len(self.clients), "sent": 0, "dropped": 0}
+        self.stats["clients"] += 1
+        try:
+            await reader.read()          # client 不送資料；EOF = 斷線
+        finally:
+            self.clients.pop(writer, None)
+            writer.close()
+
+    async def write(self, batch: list[Item]):
+        data = b"".join(item.line for item in batch)
+        for writer, st in list(self.clients.items()):
+            transport = writer.transport
+            if transport.is_closing():
+                self.clients.pop(writer, None)
+            elif transport.get_write_buffer_size() > CLIENT_BUFFER_MAX:
+                st["dropped"] += len(batch)
+            else:
+                writer.write(data)
+                st["sent"] += len(batch)
+
+
+class WebSocketSink(_StreamFanout):
+    """
+    serve(ws) 由 WebSocket endpoint 呼叫；一批事件為一個 text frame（NDJSON）。
+    write() 只把 frame 放進每個 client 的佇列（延遲統計到這裡為止），實際送出在各 client 的 serve() 內。
+    """
+
+    kind = "websocket"
+
+    def __init__(self, name: str = "ws", maxsize: int = QUEUE_MAX):
+        super().__init__(name, maxsize)
+        self.listening = False
+
+    async def serve(self, ws):
+        pending = deque()
+        wake = asyncio.Event()
+        st = {"client": self.stats["clients"], "sent": 0, "dropped": 0, "bytes": 0, "pending": pending, "wake": wake}
+        self.clients[ws] = st
+        self.stats["clients"] += 1
+        self.listening = True
+        try:
+            while True:
+                await wake.wait()
+                wake.clear()
+                while pending:
+                    text, n = pending.popleft()
+                    st["bytes"] -= len(text)
+                    await ws.send_text(text)
+                    st["sent"] += n
+        finally:
+            self.clients.pop(ws, None)
+            self.listening = bool(self.clients)
+
+    async def write(self, batch: list[Item]):
+        if not self.clients:
+            return
+        text = b"".join(item.line for item in batch).decode("utf-8")
+        for st in self.clients.values():
+            if st["bytes"] > CLIENT_BUFFER_MAX:
+                st["dropped"] += len(batch)
+                continue
+            st["pending"].append((text, len(batch)))
+            st["bytes"] += len(text)
+            st["wake"].set()
+
+    def status(self) -> dict:
+        out = Sink.status(self)
+        out["client_stats"] = [{k: v for k, v in st.items() if k not in ("pending", "wake")}
+                               for st in self.clients.values()]
+        return out
+
+
+class SinkPipeline:
+    def __init__(self):
+        self.sinks: list[Sink] = []
+        self.stats = {"published": 0}
+
+    def add(self, sink: Sink) -> Sink:
+        self.sinks.append(sink)
+        return sink
+
+    def listening(self) -> bool:
+        """有接收中的 sink（呼叫端可省下組事件的成本）"""
+        for sink in self.sinks:
+            if sink.listening:
+                return True
+        return False
+
+    def publish(self, event: dict):
+        """event loop 上呼叫；沒有接收中的 sink 時不序列化"""
+        item = None
+        for sink in self.sinks:
+            if not sink.listening:
+                continue
+            if item is None:
+                item = Item(time.perf_counter(), event,
+                            (json.dumps(event, separators=(",", ":")) + "\n").encode("utf-8"))
+                self.stats["published"] += 1
+            sink.offer(item)
+
+    async def run(self):
+        await asyncio.gather(*(s.run() for s in self.sinks))
+
+    def status(self) -> dict:
+        return {**self.stats, "sinks": [s.status() for s in self.sinks]}
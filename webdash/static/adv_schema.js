@@ -0,0 +1,5 @@
+// adv_schema.js
+// badge 廣播的 event / flags 名稱（firmware/ble_app_work/tools/adv_payload_gen.py 產生，不要手改）
+const ADV_VERSION = 1;
+const ADV_EVENTS = { 0: "ERROR", 1: "BOOT", 2: "HEARTBEAT", 3: "BUTTON", 4: "POSTURE", 5: "ALARM" };
+const ADV_FLAGS = [ { bit: 0x01, name: "FALLEN" } ];
@@ -0,0 +1,319 @@
+// device_table.js
+// 裝置表的繪製（index.html 與 bench.html 共用，需要先載入 adv_schema.js）。
+// - row 以 address 為 key：只寫入內容有變的 cell（與上次寫入的字串比較）
+// - upsert() / tick() 只記錄變更，DOM 在 requestAnimationFrame 內一次更新（一個 frame 最多一次）
+// - 只有捲動範圍內（+ overscan）的 row 在 DOM 上（virtual scroll），上下用 spacer row 撐出高度
+// - 排序 / 篩選只重排 address 的陣列；畫面上已有的 row 只移動位置，不重建
+
+// event / flags 的值與名稱來自 adv_schema.js（firmware/ble_app_work/tools/adv_payload.json 產生），這裡只決定顏色
+const STATUS_CLASS = { BOOT: "st-boot", HEARTBEAT: "st-hb", BUTTON: "st-btn", POSTURE: "st-btn", ALARM: "lost", ERROR: "lost" };
+const STATUS_MAP = Object.fromEntries(
+  Object.entries(ADV_EVENTS).map(([v, name]) => [v, [name, STATUS_CLASS[name] ?? "mono"]]));
+
+const FLAG_CLASS = { FALLEN: "lost" };
+const FLAG_MAP = ADV_FLAGS.map(f => ({ bit: f.bit, label: f.name, cls: FLAG_CLASS[f.name] ?? "mono" }));
+
+function rssiClass(rssi){
+  if (rssi === null || rssi === undefined) return "";
+  if (rssi > -55) return "rssi-strong";
+  if (rssi > -70) return "rssi-mid";
+  return "rssi-weak";
+}
+
+function eventCell(status){
+  if (status === null || status === undefined) return `<span class="dim">UNKNOWN</span>`;
+  const v = STATUS_MAP[status];
+  if (!v) return `<span class="mono">0x${status.toString(16).padStart(2,"0").toUpperCase()}</span>`;
+  return `<span class="${v[1]}">${v[0]}</span>`;
+}
+
+function postureCell(posture){
+  if (posture === null || posture === undefined) {
+    return `<span class="dim">--</span>`;
+  }
+
+  // 直接顯示十進位整數
+  return `<span class="mono">${posture}</span>`;
+}
+
+function flagsCell(flags){
+  if (flags === null || flags === undefined) {
+    return `<span class="dim">--</span>`;
+  }
+
+  let parts = [];
+  for (const f of FLAG_MAP) {
+    if (flags & f.bit) {
+      parts.push(`<span class="${f.cls}">${f.label}</span>`);
+    }
+  }
+
+  if (parts.length === 0) {
+    return `<span class="dim">NONE</span>`;
+  }
+  return parts.join(" ");
+}
+
+function stateCell(online){
+  return online ? `<span class="ok">ONLINE</span>` : `<span class="lost">LOST</span>`;
+}
+
+function deviceIdText(d){
+  return d.device_id !== undefined && d.device_id !== null ? d.device_id.toString(16).toUpperCase().padStart(8,"0") : "--";
+}
+
+// html(d, age, online) 或 text() + cls()（td 的 class）；sort() 為排序的值；volatile：值一直在變（重排有間隔）
+const DEVICE_COLUMNS = [
+  { key: "name",      label: "Name",          html: d => `<b>${d.name ?? ""}</b>`,                  sort: d => d.name ?? "" },
+  { key: "device_id", label: "Device ID",     text: deviceIdText, cls: () => "mono",                 sort: d => d.device_id ?? -1 },
+  { key: "address",   label: "Address",       text: d => d.address ?? "", cls: () => "mono dim",     sort: d => d.address ?? "" },
+  { key: "event",     label: "Event",         html: d => eventCell(d.event),                         sort: d => d.event ?? -1, volatile: true },
+  { key: "posture",   label: "Posture",       html: d => postureCell(d.posture),                     sort: d => d.posture ?? -1, volatile: true },
+  { key: "flags",     label: "Flags",         html: d => flagsCell(d.flags),                         sort: d => d.flags ?? -1, volatile: true },
+  { key: "rssi",      label: "RSSI",          text: d => `${d.rssi ?? "--"}`, cls: d => `right mono ${rssiClass(d.rssi)}`,
+    sort: d => d.rssi ?? -999, volatile: true, right: true },
+  { key: "age",       label: "Last Seen (s)", text: (d, age) => age.toFixed(1), cls: () => "right mono",
+    sort: d => -(d.last_seen ?? 0), volatile: true, right: true },
+  { key: "state",     label: "State",         html: (d, age, online) => stateCell(online),          sort: (d, online) => online ? 0 : 1, volatile: true },
+];
+
+const RESORT_INTERVAL = 1000;   // 會一直變的欄位（RSSI 等）排序時，順序最多每秒更新一次（row 不會一直跳）
+
+class DeviceTable {
+  constructor(view, tbody, opts = {}) {
+    this.view = view;                     // 捲動的容器（thead 在裡面，sticky）
+    this.tbody = tbody;
+    this.columns = opts.columns ?? DEVICE_COLUMNS;
+    this.overscan = opts.overscan ?? 8;
+    this.rowHeight = opts.rowHeight ?? 37;
+    this.onFrame = opts.onFrame ?? null;  // 每次更新 DOM 後：{ ms, rows, painted, cells, created, moved }
+
+    this.devices = new Map();             // address -> device（server 的 to_wire / to_dict）
+    this.online = new Map();              // address -> 上次 tick 的 online
+    this.rows = new Map();                // address -> DOM 上的 tr
+    this.pool = [];                       // 捲出畫面的 tr（重複使用）
+    this.dirty = new Set();               // 內容變更、還沒畫的 address
+    this.order = [];                      // 篩選 + 排序後的 address
+    this.orderDirty = true;
+    this.resortAt = 0;                    // volatile 欄位的下一次重排
+    this.sortKey = opts.sortKey ?? "name";
+    this.sortDir = 1;
+    this.filter = "";
+    this.now = Date.now() / 1000;
+    this.offlineTimeout = 15.0;
+    this.ticked = false;                  // 時間前進：畫面內的 age / state 要重算
+    this.frame = 0;
+
+    this.top = this._spacer();
+    this.bottom = this._spacer();
+    tbody.replaceChildren(this.top, this.bottom);
+    view.addEventListener("scroll", () => this.schedule(), { passive: true });
+    window.addEventListener("resize", () => this.schedule());
+  }
+
+  get size() { return this.devices.size; }
+  get shown() { return this.order.length; }
+
+  _spacer() {
+    const tr = document.createElement("tr");
+    const td = document.createElement("td");
+    td.colSpan = this.columns.length;
+    td.style.cssText = "height:0;padding:0;border:0";
+    tr.appendChild(td);
+    return tr;
+  }
+
+  _column(key) {
+    return this.columns.find(c => c.key === key);
+  }
+
+  _online(d) {
+    return d.last_seen ? this.now - d.last_seen < this.offlineTimeout : false;
+  }
+
+  _matches(d) {
+    const f = this.filter;
+    if (!f) return true;
+    return (d.name ?? "").toLowerCase().includes(f) || (d.address ?? "").toLowerCase().includes(f) ||
+      deviceIdText(d).toLowerCase().includes(f);
+  }
+
+  _sortValue(d) {
+    const c = this._column(this.sortKey);
+    return c.key === "state" ? c.sort(d, this._online(d)) : c.sort(d);
+  }
+
+  // 畫面需要更新（同一個 frame 內的變更合併）
+  schedule() {
+    if (!this.frame) this.frame = requestAnimationFrame(() => this.flush());
+  }
+
+  upsert(d) {
+    const prev = this.devices.get(d.address);
+    this.devices.set(d.address, d);
+    this.dirty.add(d.address);
+    if (!prev || this._matches(prev) !== this._matches(d)) {
+      this.orderDirty = true;
+    } else if (this._column(this.sortKey).volatile && this._sortValue(prev) !== this._sortValue(d)) {
+      if (!this.resortAt) {
+        this.resortAt = performance.now() + RESORT_INTERVAL;
+        setTimeout(() => this.schedule(), RESORT_INTERVAL);
+      }
+    } else if (this._sortValue(prev) !== this._sortValue(d)) {
+      this.orderDirty = true;
+    }
+    this.schedule();
+  }
+
+  remove(address) {
+    if (this.devices.delete(address)) {
+      this.online.delete(address);
+      this.orderDirty = true;
+      this.schedule();
+    }
+  }
+
+  replaceAll(list) {
+    this.devices.clear();
+    this.online.clear();
+    for (const d of list) this.devices.set(d.address, d);
+    for (const a of this.rows.keys()) this.dirty.add(a);
+    this.orderDirty = true;
+    this.schedule();
+  }
+
+  // 時間前進（server 沒有送資料時 age / state 也要更新）
+  tick(now, offlineTimeout) {
+    this.now = now;
+    this.offlineTimeout = offlineTimeout;
+    this.ticked = true;
+    if (this.sortKey === "state") {
+      // online 有變的才需要重排（age 依 last_seen 排序，時間前進不影響順序）
+      for (const d of this.devices.values()) {
+        const on = this._online(d);
+        if (this.online.get(d.address) !== on) {
+          this.online.set(d.address, on);
+          this.orderDirty = true;
+        }
+      }
+    }
+    this.schedule();
+  }
+
+  setSort(key) {
+    if (!this._column(key)?.sort) return;
+    this.sortDir = key === this.sortKey ? -this.sortDir : 1;
+    this.sortKey = key;
+    this.orderDirty = true;
+    this.schedule();
+  }
+
+  setFilter(text) {
+    this.filter = text.trim().toLowerCase();
+    this.orderDirty = true;
+    this.schedule();
+  }
+
+  _rebuildOrder() {
+    const list = [];
+    for (const d of this.devices.values()) {
+      if (this._matches(d)) list.push(d);
+    }
+    const dir = this.sortDir;
+    const keyed = list.map(d => [this._sortValue(d), d.name ?? "", d.address, d]);
+    keyed.sort((a, b) => (a[0] < b[0] ? -dir : a[0] > b[0] ? dir :
+      a[1] < b[1] ? -1 : a[1] > b[1] ? 1 : a[2] < b[2] ? -1 : a[2] > b[2] ? 1 : 0));
+    this.order = keyed.map(k => k[2]);
+    this.orderDirty = false;
+    this.resortAt = 0;
+  }
+
+  _newRow() {
+    const tr = this.pool.pop();
+    if (tr) return tr;
+    const row = document.createElement("tr");
+    row._td = this.columns.map(() => row.appendChild(document.createElement("td")));
+    row._v = new Array(this.columns.length);
+    row._c = new Array(this.columns.length);
+    return row;
+  }
+
+  // 一個 row：只寫入與上次不同的 cell（回傳寫入的 cell 數）
+  _paint(tr, d) {
+    const online = this._online(d);
+    const age = d.last_seen ? Math.max(this.now - d.last_seen, 0) : 9999.0;
+    let cells = 0;
+    for (let i = 0; i < this.columns.length; i++) {
+      const c = this.columns[i];
+      const td = tr._td[i];
+      if (c.html) {
+        const s = c.html(d, age, online);
+        if (tr._v[i] !== s) { tr._v[i] = s; td.innerHTML = s; cells++; }
+      } else {
+        const s = c.text(d, age, online);
+        if (tr._v[i] !== s) { tr._v[i] = s; td.textContent = s; cells++; }
+        const k = c.cls ? c.cls(d, age, online) : "";
+        if (tr._c[i] !== k) { tr._c[i] = k; td.className = k; }
+      }
+    }
+    return cells;
+  }
+
+  flush() {
+    this.frame = 0;
+    const t0 = performance.now();
+    if (this.resortAt && t0 >= this.resortAt) this.orderDirty = true;
+    if (this.orderDirty) this._rebuildOrder();
+
+    // layout 的讀取全部在寫入 DOM 之前（避免 layout thrash）
+    const view = this.view;
+    const head = view.querySelector("thead")?.offsetHeight ?? 0;
+    const sample = this.rows.values().next().value;
+    if (sample && sample.offsetHeight) this.rowHeight = sample.offsetHeight;
+    const h = this.rowHeight;
+    const n = this.order.length;
+    const first = Math.max(0, Math.floor((view.scrollTop - head) / h) - this.overscan);
+    const last = Math.min(n, Math.ceil((view.scrollTop - head + view.clientHeight) / h) + this.overscan);
+
+    const want = new Set();
+    for (let i = first; i < last; i++) want.add(this.order[i]);
+    for (const [a, tr] of this.rows) {
+      if (!want.has(a)) {
+        tr.remove();
+        tr._v.fill(undefined);
+        this.rows.delete(a);
+        this.pool.push(tr);
+      }
+    }
+
+    let painted = 0, cells = 0, created = 0, moved = 0;
+    let prev = this.top;
+    for (let i = first; i < last; i++) {
+      const a = this.order[i];
+      let tr = this.rows.get(a);
+      const fresh = !tr;
+      if (fresh) {
+        tr = this._newRow();
+        this.rows.set(a, tr);
+        created++;
+      }
+      if (fresh || this.ticked || this.dirty.has(a)) {
+        cells += this._paint(tr, this.devices.get(a));
+        painted++;
+      }
+      if (prev.nextSibling !== tr) {
+        this.tbody.insertBefore(tr, prev.nextSibling);
+        moved++;
+      }
+      prev = tr;
+    }
+    this.top.firstChild.style.height = `${first * h}px`;
+    this.bottom.firstChild.style.height = `${(n - last) * h}px`;
+    this.dirty.clear();
+    this.ticked = false;
+
+    if (this.onFrame) {
+      this.onFrame({ ms: performance.now() - t0, rows: last - first, painted, cells, created, moved });
+    }
+  }
+}